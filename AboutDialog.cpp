@@ -100,10 +100,22 @@ BOOL CAboutDialog::OnInitDialog()
 
    SetDlgItemText(
       IDC_ABOUT_TEXT_LINE2, PUTTYCS_ABOUT_TEXT_LINE2 );
+
+   SetDlgItemText(
+      IDC_ABOUT_STARTUP_TEXT, m_csStartupText );
    
    return TRUE;  
 }
 
+/**
+ * CAboutDialog::setStartupText()
+ */
+
+void CAboutDialog::setStartupText( CString csText )
+{
+   m_csStartupText = csText;
+}
+
 /**
  * CAboutDialog::OnVisitWebSiteButton()
  */
@@ -51,6 +51,8 @@ public:
       // NOTE: the ClassWizard will add data members here
    //}}AFX_DATA
 
+   void setStartupText( CString csText );
+
 
 // Overrides
    // ClassWizard generated virtual function overrides
@@ -70,6 +72,8 @@ protected:
 	afx_msg BOOL OnHelpInfo(HELPINFO* pHelpInfo);
 	//}}AFX_MSG
    DECLARE_MESSAGE_MAP()
+
+   CString m_csStartupText;
 };
 
 //{{AFX_INSERT_LOCATION}}
@@ -37,6 +37,7 @@
 #include "stdafx.h"
 #include "puttycs.h"
 #include "Base64.h"
+#include "Base64Codec.h"
 
 #ifdef _DEBUG
 #undef THIS_FILE
@@ -44,84 +45,40 @@ static char THIS_FILE[]=__FILE__;
 #define new DEBUG_NEW
 #endif
 
-CString CBase64::BASE64_CHARS =
-   _T( "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" );
-
 /**
  * CBase64::encode()
+ *
+ * UNICODE builds encode the UTF-8 of the text, ANSI builds its bytes
  */
 
 CString CBase64::encode( CString csBuffer )
 {
-   CString csValue = "";
+#ifdef _UNICODE
+   int iBytes = ::WideCharToMultiByte( 
+      CP_UTF8, 0, csBuffer, csBuffer.GetLength(), NULL, 0, NULL, NULL );
 
-   TCHAR buffer3[3];
-   TCHAR buffer4[4];
+   std::string sBytes( (iBytes > 0) ? iBytes : 0, '\0' );
 
-   TCHAR* bytes = csBuffer.GetBuffer(0);
-   int pos = csBuffer.GetLength();
-
-   int i = 0;
-   int j = 0;
- 
-   while ( pos-- )
+   if ( iBytes > 0 )
    {
-      buffer3[i++] = *(bytes++);
-
-      if (i == 3) 
-      {
-         buffer4[0] = (buffer3[0] & 0xfc) >> 2;
-
-         buffer4[1] =
-            ((buffer3[0] & 0x03) << 4) +
-            ((buffer3[1] & 0xf0) >> 4);
+      ::WideCharToMultiByte( CP_UTF8, 0, csBuffer, csBuffer.GetLength(), 
+         &sBytes[0], iBytes, NULL, NULL );
+   }
+#else
+   std::string sBytes( (LPCTSTR) csBuffer, csBuffer.GetLength() );
+#endif
 
-         buffer4[2] =
-            ((buffer3[1] & 0x0f) << 2) +
-            ((buffer3[2] & 0xc0) >> 6);
+   size_t iLength = CBase64Codec::GetEncodedLength( sBytes.size() );
 
-         buffer4[3] = buffer3[2] & 0x3f;
+   CString csValue;
 
-         for( i = 0; (i <4) ; i++ )
-         {
-            csValue +=
-               BASE64_CHARS.GetAt( buffer4[i] );
-         }
+   if ( iLength > 0 )
+   {
+      std::string sText( iLength, '\0' );
 
-         i = 0;
-      }
-   }
+      CBase64Codec::Encode( (const unsigned char*) sBytes.data(), sBytes.size(), &sText[0] );
 
-   if (i)
-   {
-      for( j = i; j < 3; j++ )
-      {
-         buffer3[j] = '\0';
-      }
-
-      buffer4[0] =
-         (buffer3[0] & 0xfc) >> 2;
-
-      buffer4[1] =
-         ((buffer3[0] & 0x03) << 4) + 
-         ((buffer3[1] & 0xf0) >> 4);
-
-      buffer4[2] =
-         ((buffer3[1] & 0x0f) << 2) + 
-         ((buffer3[2] & 0xc0) >> 6);
-
-      buffer4[3] = buffer3[2] & 0x3f;
-
-      for ( j = 0; (j < i + 1); j++ )
-      {
-         csValue +=
-            BASE64_CHARS.GetAt( buffer4[j] );
-      }
-
-      while( (i++ < 3) )
-      {
-         csValue += '=';
-      }
+      csValue = CString( sText.c_str(), (int) iLength );
    }
 
    return csValue;
@@ -129,86 +86,64 @@ CString CBase64::encode( CString csBuffer )
 
 /**
  * CBase64::decode()
+ *
+ * Values stored by older UNICODE builds hold the low byte of each
+ * character; those are not valid UTF-8 (unless plain ASCII) and are
+ * read back as Latin-1.
  */
 
 CString CBase64::decode( CString csBuffer )
 {
-   CString csValue = "";
+   std::string sText;
+   sText.reserve( csBuffer.GetLength() );
 
-   TCHAR buffer4[4];
-   TCHAR buffer3[3];
+   for ( int i = 0; i < csBuffer.GetLength(); i++ )
+   {
+      TCHAR ch = csBuffer.GetAt( i );
 
-   int pos = csBuffer.GetLength();
-   int offset = 0;
+      // Anything outside ASCII ends the decode just like an invalid
+      // BASE64 character does
 
-   int i = 0;
-   int j = 0;
+      sText += (char) ((ch > 0 && ch < 0x80) ? ch : '!');
+   }
 
-   while ( (pos--) && (
-      BASE64_CHARS.Find(csBuffer.GetAt(offset)) != -1) )
+   std::string sBytes( CBase64Codec::GetDecodeBufferSize(sText.size()), '\0' );
+
+   sBytes.resize( CBase64Codec::Decode( 
+      sText.data(), sText.size(), (unsigned char*) &sBytes[0]) );
+
+   CString csValue;
+
+   if ( sBytes.empty() )
+   {
+      return csValue;
+   }
+
+#ifdef _UNICODE
+   int iChars = ::MultiByteToWideChar( CP_UTF8, MB_ERR_INVALID_CHARS, 
+      sBytes.data(), (int) sBytes.size(), NULL, 0 );
+
+   if ( iChars > 0 )
    {
-      buffer4[i++] =
-         csBuffer.GetAt(offset++);
-
-      if ( i == 4 )
-      {
-         for ( i = 0; i < 4; i++ )
-         {
-            buffer4[i] =
-               BASE64_CHARS.Find( buffer4[i] );
-         }
-
-         buffer3[0] =
-            (buffer4[0] << 2) +
-            ((buffer4[1] & 0x30) >> 4);
-
-         buffer3[1] =
-            ((buffer4[1] & 0xf) << 4) +
-            ((buffer4[2] & 0x3c) >> 2);
-
-         buffer3[2] =
-            ((buffer4[2] & 0x3) << 6) +
-            buffer4[3];
-
-         for ( i = 0; (i < 3); i++ )
-         {
-            csValue += buffer3[i];
-         }
-
-         i = 0;
-      }
+      ::MultiByteToWideChar( CP_UTF8, 0, sBytes.data(), (int) sBytes.size(), 
+         csValue.GetBuffer(iChars), iChars );
+
+      csValue.ReleaseBuffer( iChars );
+
+      return csValue;
    }
 
-   if (i)
+   LPTSTR pszValue = csValue.GetBuffer( (int) sBytes.size() );
+
+   for ( size_t i = 0; i < sBytes.size(); i++ )
    {
-      for ( j = i; j < 4; j++ )
-      {
-         buffer4[j] = 0;
-      }
-
-      for ( j = 0; j < 4; j++ )
-      {
-         buffer4[j] =
-            BASE64_CHARS.Find( buffer4[j]) ;
-      }
-    
-      buffer3[0] =
-         (buffer4[0] << 2) + 
-         ((buffer4[1] & 0x30) >> 4);
-
-      buffer3[1] =
-         ((buffer4[1] & 0xf) << 4) +
-         ((buffer4[2] & 0x3c) >> 2);
-
-      buffer3[2] =
-         ((buffer4[2] & 0x3) << 6) + 
-         buffer4[3];
-
-      for ( j = 0; (j < i - 1); j++ )
-      {
-         csValue += buffer3[j];
-      }
+      pszValue[i] = (TCHAR) (unsigned char) sBytes[i];
    }
 
+   csValue.ReleaseBuffer( (int) sBytes.size() );
+#else
+   csValue = CString( sBytes.data(), (int) sBytes.size() );
+#endif
+
    return csValue;
 }
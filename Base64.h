@@ -49,9 +49,6 @@ public:
    
    static CString encode( CString csBuffer );
    static CString decode( CString csBuffer );
-
-protected:
-   static CString BASE64_CHARS;
 };
 
 #endif // !defined(AFX_BASE64_H__8D695A8F_54ED_4819_AA0E_33ADC00CDF60__INCLUDED_)
@@ -0,0 +1,643 @@
+/**
+ * CommandChannel.cpp - PuTTYCS local command channel
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "CommandChannel.h"
+#include "SendEngine.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * CCommandChannel::CCommandChannel()
+ */
+
+CCommandChannel::CCommandChannel()
+{
+   m_hWndTarget = NULL;
+   m_lStopping = 0;
+   m_pListenThread = NULL;
+
+   m_hStopEvent = ::CreateEvent( NULL, TRUE, FALSE, NULL );
+
+   ::InitializeCriticalSection( &m_csLock );
+}
+
+/**
+ * CCommandChannel::~CCommandChannel()
+ */
+
+CCommandChannel::~CCommandChannel()
+{
+   Stop();
+
+   ::CloseHandle( m_hStopEvent );
+
+   ::DeleteCriticalSection( &m_csLock );
+}
+
+/**
+ * CCommandChannel::GetPipeName()
+ *
+ * One pipe per logon session, so PuTTYCS instances of different
+ * users on a terminal server do not collide
+ */
+
+CString CCommandChannel::GetPipeName()
+{
+   DWORD dwSessionId = 0;
+   ::ProcessIdToSessionId( ::GetCurrentProcessId(), &dwSessionId );
+
+   CString csName;
+   csName.Format( PUTTYCS_CHANNEL_PIPE_NAME, dwSessionId );
+
+   return csName;
+}
+
+/**
+ * CCommandChannel::CreatePipe()
+ */
+
+HANDLE CCommandChannel::CreatePipe( bool bFirst )
+{
+   return ::CreateNamedPipe( GetPipeName(),
+      PIPE_ACCESS_DUPLEX | (bFirst ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0),
+      PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+      PIPE_UNLIMITED_INSTANCES,
+      PUTTYCS_CHANNEL_BUFFER_SIZE,
+      PUTTYCS_CHANNEL_BUFFER_SIZE,
+      0,
+      NULL );
+}
+
+/**
+ * CCommandChannel::Start()
+ */
+
+bool CCommandChannel::Start( HWND hWndTarget )
+{
+   if ( m_pListenThread )
+   {
+      return true;
+   }
+
+   HANDLE hPipe = CreatePipe( true );
+
+   if ( hPipe == INVALID_HANDLE_VALUE )
+   {
+      return false;
+   }
+
+   m_hWndTarget = hWndTarget;
+   m_lStopping = 0;
+
+   ::ResetEvent( m_hStopEvent );
+
+   CONNECTION* pListen = new CONNECTION;
+   pListen->pChannel = this;
+   pListen->hPipe = hPipe;
+   pListen->pThread = NULL;
+
+   m_pListenThread = 
+      AfxBeginThread( ListenThread, pListen, 
+         THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED );
+
+   m_pListenThread->m_bAutoDelete = FALSE;
+   m_pListenThread->ResumeThread();
+
+   return true;
+}
+
+/**
+ * CCommandChannel::Stop()
+ */
+
+void CCommandChannel::Stop()
+{
+   if ( !m_pListenThread )
+   {
+      return;
+   }
+
+   ::InterlockedExchange( &m_lStopping, 1 );
+   ::SetEvent( m_hStopEvent );
+
+   /**
+    * Unblock ConnectNamedPipe() with a dummy client
+    */
+
+   HANDLE hPipe = Connect( PUTTYCS_CHANNEL_CONNECT_TIMEOUT );
+
+   if ( hPipe != INVALID_HANDLE_VALUE )
+   {
+      ::CloseHandle( hPipe );
+   }
+
+   EndThread( m_pListenThread );
+
+   delete m_pListenThread;
+   m_pListenThread = NULL;
+
+   /**
+    * No connection is added once the listen thread is gone
+    */
+
+   for ( int iLoop = 0; iLoop < m_paConnections.GetSize(); iLoop++ )
+   {
+      CONNECTION* pConnection = (CONNECTION*) m_paConnections.GetAt( iLoop );
+
+      EndThread( pConnection->pThread );
+
+      delete pConnection->pThread;
+      delete pConnection;
+   }
+
+   m_paConnections.RemoveAll();
+
+   /**
+    * Batches posted but not run point into the stacks of the ended
+    * threads
+    */
+
+   MSG msg;
+
+   while ( ::PeekMessage(&msg, m_hWndTarget, WM_USER_CHANNEL_BATCH, WM_USER_CHANNEL_BATCH, PM_REMOVE) )
+   {
+   }
+}
+
+/**
+ * CCommandChannel::EndThread()
+ *
+ * Waits for a channel thread to end, cancelling the pipe I/O it is
+ * blocked in until it does. Its other waits end on m_hStopEvent.
+ */
+
+void CCommandChannel::EndThread( CWinThread* pThread )
+{
+   while ( ::WaitForSingleObject(pThread->m_hThread, PUTTYCS_CHANNEL_STOP_TIMEOUT) == WAIT_TIMEOUT )
+   {
+      ::CancelSynchronousIo( pThread->m_hThread );
+   }
+}
+
+/**
+ * CCommandChannel::ReapConnections()
+ *
+ * Deletes connections whose thread has ended
+ */
+
+void CCommandChannel::ReapConnections()
+{
+   ::EnterCriticalSection( &m_csLock );
+
+   for ( int iLoop = m_paConnections.GetSize() - 1; iLoop >= 0; iLoop-- )
+   {
+      CONNECTION* pOther = (CONNECTION*) m_paConnections.GetAt( iLoop );
+
+      if ( ::WaitForSingleObject(pOther->pThread->m_hThread, 0) == WAIT_OBJECT_0 )
+      {
+         delete pOther->pThread;
+         delete pOther;
+
+         m_paConnections.RemoveAt( iLoop );
+      }
+   }
+
+   ::LeaveCriticalSection( &m_csLock );
+}
+
+/**
+ * CCommandChannel::ListenThread()
+ */
+
+UINT CCommandChannel::ListenThread( LPVOID pParam )
+{
+   CONNECTION* pListen = (CONNECTION*) pParam;
+   CCommandChannel* pChannel = pListen->pChannel;
+
+   HANDLE hPipe = pListen->hPipe;
+
+   delete pListen;
+
+   while ( hPipe != INVALID_HANDLE_VALUE )
+   {
+      BOOL bConnected = ::ConnectNamedPipe( hPipe, NULL ) ? 
+         TRUE : (::GetLastError() == ERROR_PIPE_CONNECTED);
+
+      if ( pChannel->m_lStopping )
+      {
+         ::CloseHandle( hPipe );
+         break;
+      }
+
+      if ( !bConnected )
+      {
+         ::CloseHandle( hPipe );
+      }
+      else
+      {
+         pChannel->ReapConnections();
+
+         CONNECTION* pConnection = new CONNECTION;
+         pConnection->pChannel = pChannel;
+         pConnection->hPipe = hPipe;
+
+         pConnection->pThread = 
+            AfxBeginThread( ConnectionThread, pConnection, 
+               THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED );
+
+         pConnection->pThread->m_bAutoDelete = FALSE;
+
+         ::EnterCriticalSection( &pChannel->m_csLock );
+         pChannel->m_paConnections.Add( pConnection );
+         ::LeaveCriticalSection( &pChannel->m_csLock );
+
+         pConnection->pThread->ResumeThread();
+      }
+
+      hPipe = pChannel->CreatePipe( false );
+   }
+
+   return 0;
+}
+
+/**
+ * CCommandChannel::ConnectionThread()
+ *
+ * Reads whatever is waiting in the pipe, splits it into frames and
+ * dispatches all complete frames as one batch
+ */
+
+UINT CCommandChannel::ConnectionThread( LPVOID pParam )
+{
+   CONNECTION* pConnection = (CONNECTION*) pParam;
+   CCommandChannel* pChannel = pConnection->pChannel;
+
+   HANDLE hPipe = pConnection->hPipe;
+
+   std::string sBuffer;
+   char szChunk[PUTTYCS_CHANNEL_BUFFER_SIZE];
+
+   HANDLE hDone = ::CreateEvent( NULL, TRUE, FALSE, NULL );
+
+   bool bOpen = (hDone != NULL);
+
+   while ( bOpen && !pChannel->m_lStopping )
+   {
+      DWORD dwRead = 0;
+
+      if ( !::ReadFile(hPipe, szChunk, sizeof(szChunk), &dwRead, NULL) || (dwRead == 0) )
+      {
+         break;
+      }
+
+      sBuffer.append( szChunk, dwRead );
+
+      DWORD dwAvailable = 0;
+
+      while ( ::PeekNamedPipe(hPipe, NULL, 0, NULL, &dwAvailable, NULL) && (dwAvailable > 0) )
+      {
+         if ( !::ReadFile(hPipe, szChunk, sizeof(szChunk), &dwRead, NULL) || (dwRead == 0) )
+         {
+            bOpen = false;
+            break;
+         }
+
+         sBuffer.append( szChunk, dwRead );
+      }
+
+      /**
+       * Split frames
+       */
+
+      CChannelBatch batch;
+      size_t iOffset = 0;
+
+      while ( (sBuffer.size() - iOffset) >= 4 )
+      {
+         const unsigned char* pHeader = 
+            (const unsigned char*) sBuffer.data() + iOffset;
+
+         DWORD dwLength = pHeader[0] | (pHeader[1] << 8) | 
+            (pHeader[2] << 16) | ((DWORD) pHeader[3] << 24);
+
+         if ( dwLength > PUTTYCS_CHANNEL_MAX_FRAME )
+         {
+            bOpen = false;
+            break;
+         }
+
+         if ( (sBuffer.size() - iOffset - 4) < dwLength )
+         {
+            break;
+         }
+
+         CHANNELREQUEST request;
+         request.iWindows = 0;
+         request.dElapsedMs = 0;
+
+         if ( !ParseRequest(sBuffer.substr(iOffset + 4, dwLength), request) )
+         {
+            request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+            request.csMessage = PUTTYCS_CHANNEL_MALFORMED;
+         }
+
+         batch.Add( request );
+
+         iOffset += 4 + dwLength;
+      }
+
+      sBuffer.erase( 0, iOffset );
+
+      if ( batch.GetSize() == 0 )
+      {
+         continue;
+      }
+
+      /**
+       * The dialog runs the batch on its own thread. It is not waited
+       * for with SendMessage(): Stop() runs on that thread too.
+       */
+
+      HANDLE ahEvents[2] = { hDone, pChannel->m_hStopEvent };
+
+      ::ResetEvent( hDone );
+
+      if ( pChannel->m_lStopping || 
+           !::PostMessage(pChannel->m_hWndTarget, WM_USER_CHANNEL_BATCH, (WPARAM) hDone, (LPARAM) &batch) ||
+           (::WaitForMultipleObjects(2, ahEvents, FALSE, INFINITE) != WAIT_OBJECT_0) )
+      {
+         for ( int iLoop = 0; iLoop < batch.GetSize(); iLoop++ )
+         {
+            batch[iLoop].csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+            batch[iLoop].csMessage = PUTTYCS_CHANNEL_CLOSING;
+         }
+      }
+
+      std::string sReplies;
+
+      for ( int iLoop = 0; iLoop < batch.GetSize(); iLoop++ )
+      {
+         std::string sReply = FormatReply( batch[iLoop] );
+
+         DWORD dwLength = (DWORD) sReply.size();
+
+         sReplies += (char) (dwLength & 0xFF);
+         sReplies += (char) ((dwLength >> 8) & 0xFF);
+         sReplies += (char) ((dwLength >> 16) & 0xFF);
+         sReplies += (char) ((dwLength >> 24) & 0xFF);
+         sReplies += sReply;
+      }
+
+      DWORD dwWritten = 0;
+
+      if ( !::WriteFile(hPipe, sReplies.data(), (DWORD) sReplies.size(), &dwWritten, NULL) )
+      {
+         break;
+      }
+   }
+
+   if ( hDone )
+   {
+      ::CloseHandle( hDone );
+   }
+
+   ::FlushFileBuffers( hPipe );
+   ::DisconnectNamedPipe( hPipe );
+   ::CloseHandle( hPipe );
+
+   return 0;
+}
+
+/**
+ * CCommandChannel::Connect()
+ */
+
+HANDLE CCommandChannel::Connect( DWORD dwTimeout )
+{
+   CString csName = GetPipeName();
+
+   for ( int iAttempt = 0; iAttempt < 2; iAttempt++ )
+   {
+      HANDLE hPipe = ::CreateFile( csName, GENERIC_READ | GENERIC_WRITE,
+         0, NULL, OPEN_EXISTING, 0, NULL );
+
+      if ( hPipe != INVALID_HANDLE_VALUE )
+      {
+         return hPipe;
+      }
+
+      if ( (::GetLastError() != ERROR_PIPE_BUSY) || 
+           !::WaitNamedPipe(csName, dwTimeout) )
+      {
+         break;
+      }
+   }
+
+   return INVALID_HANDLE_VALUE;
+}
+
+/**
+ * CCommandChannel::ReadFrame()
+ */
+
+bool CCommandChannel::ReadFrame( HANDLE hPipe, std::string& sPayload )
+{
+   unsigned char szHeader[4];
+   DWORD dwTotal = 0;
+
+   while ( dwTotal < sizeof(szHeader) )
+   {
+      DWORD dwRead = 0;
+
+      if ( !::ReadFile(hPipe, szHeader + dwTotal, sizeof(szHeader) - dwTotal, &dwRead, NULL) || 
+           (dwRead == 0) )
+      {
+         return false;
+      }
+
+      dwTotal += dwRead;
+   }
+
+   DWORD dwLength = szHeader[0] | (szHeader[1] << 8) | 
+      (szHeader[2] << 16) | ((DWORD) szHeader[3] << 24);
+
+   if ( dwLength > PUTTYCS_CHANNEL_MAX_FRAME )
+   {
+      return false;
+   }
+
+   sPayload.resize( dwLength );
+   dwTotal = 0;
+
+   while ( dwTotal < dwLength )
+   {
+      DWORD dwRead = 0;
+
+      if ( !::ReadFile(hPipe, &sPayload[dwTotal], dwLength - dwTotal, &dwRead, NULL) || 
+           (dwRead == 0) )
+      {
+         return false;
+      }
+
+      dwTotal += dwRead;
+   }
+
+   return true;
+}
+
+/**
+ * CCommandChannel::WriteFrame()
+ */
+
+bool CCommandChannel::WriteFrame( HANDLE hPipe, const std::string& sPayload )
+{
+   DWORD dwLength = (DWORD) sPayload.size();
+
+   std::string sFrame;
+   sFrame.reserve( dwLength + 4 );
+
+   sFrame += (char) (dwLength & 0xFF);
+   sFrame += (char) ((dwLength >> 8) & 0xFF);
+   sFrame += (char) ((dwLength >> 16) & 0xFF);
+   sFrame += (char) ((dwLength >> 24) & 0xFF);
+   sFrame += sPayload;
+
+   DWORD dwWritten = 0;
+
+   return ::WriteFile( hPipe, sFrame.data(), (DWORD) sFrame.size(), &dwWritten, NULL ) &&
+      (dwWritten == sFrame.size());
+}
+
+/**
+ * CCommandChannel::FromUtf8()
+ */
+
+CString CCommandChannel::FromUtf8( const std::string& sText )
+{
+   return CSendEngine::GetString( sText );
+}
+
+/**
+ * CCommandChannel::FormatRequest()
+ */
+
+std::string CCommandChannel::FormatRequest( const CHANNELREQUEST& request )
+{
+   return CSendEngine::GetUtf8( request.csId ) + '\t' +
+          CSendEngine::GetUtf8( request.csVerb ) + '\t' +
+          CSendEngine::GetUtf8( request.csFilter ) + '\n' +
+          CSendEngine::GetUtf8( request.csBody );
+}
+
+/**
+ * CCommandChannel::ParseRequest()
+ */
+
+bool CCommandChannel::ParseRequest( const std::string& sPayload, CHANNELREQUEST& request )
+{
+   size_t iEnd = sPayload.find( '\n' );
+
+   if ( iEnd == std::string::npos )
+   {
+      return false;
+   }
+
+   size_t iVerb = sPayload.find( '\t' );
+
+   if ( (iVerb == std::string::npos) || (iVerb > iEnd) )
+   {
+      return false;
+   }
+
+   size_t iFilter = sPayload.find( '\t', iVerb + 1 );
+
+   if ( (iFilter == std::string::npos) || (iFilter > iEnd) )
+   {
+      return false;
+   }
+
+   request.csId = FromUtf8( sPayload.substr(0, iVerb) );
+   request.csVerb = FromUtf8( sPayload.substr(iVerb + 1, iFilter - iVerb - 1) );
+   request.csFilter = FromUtf8( sPayload.substr(iFilter + 1, iEnd - iFilter - 1) );
+   request.csBody = FromUtf8( sPayload.substr(iEnd + 1) );
+
+   return true;
+}
+
+/**
+ * CCommandChannel::FormatReply()
+ */
+
+std::string CCommandChannel::FormatReply( const CHANNELREQUEST& request )
+{
+   char szNumbers[64];
+   sprintf( szNumbers, "\t%d\t%.1f\t", request.iWindows, request.dElapsedMs );
+
+   return CSendEngine::GetUtf8( request.csId ) + '\t' +
+          CSendEngine::GetUtf8( request.csStatus ) + szNumbers +
+          CSendEngine::GetUtf8( request.csMessage );
+}
+
+/**
+ * CCommandChannel::ParseReply()
+ */
+
+bool CCommandChannel::ParseReply( const std::string& sPayload, CHANNELREQUEST& request )
+{
+   size_t iFields[4];
+   size_t iStart = 0;
+
+   for ( int iField = 0; iField < 4; iField++ )
+   {
+      iFields[iField] = sPayload.find( '\t', iStart );
+
+      if ( iFields[iField] == std::string::npos )
+      {
+         return false;
+      }
+
+      iStart = iFields[iField] + 1;
+   }
+
+   request.csId = FromUtf8( sPayload.substr(0, iFields[0]) );
+   request.csStatus = FromUtf8( sPayload.substr(iFields[0] + 1, iFields[1] - iFields[0] - 1) );
+   request.iWindows = atoi( sPayload.substr(iFields[1] + 1, iFields[2] - iFields[1] - 1).c_str() );
+   request.dElapsedMs = atof( sPayload.substr(iFields[2] + 1, iFields[3] - iFields[2] - 1).c_str() );
+   request.csMessage = FromUtf8( sPayload.substr(iFields[3] + 1) );
+
+   return true;
+}
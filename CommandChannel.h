@@ -0,0 +1,141 @@
+/**
+ * CommandChannel.h - PuTTYCS local command channel
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(COMMANDCHANNEL_H__INCLUDED_)
+#define COMMANDCHANNEL_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+
+/**
+ * One request received over the command channel, and its reply
+ *
+ * Wire format (both directions): a 4 byte little endian payload
+ * length followed by the UTF-8 payload.
+ *
+ * Request payload:  <id> TAB <verb> TAB <filter> LF <body>
+ * Reply payload:    <id> TAB <status> TAB <windows> TAB <ms> TAB <message>
+ *
+ * Verbs: send (body is a command, CR appended), sendnocr, script
+ * (body is a script path) and tile. An empty filter means the filter
+ * selected in PuTTYCS. Status is ok, nowindows or error.
+ */
+
+struct CHANNELREQUEST
+{
+   CString csId;
+   CString csVerb;
+   CString csFilter;
+   CString csBody;
+
+   CString csStatus;
+   CString csMessage;
+
+   int iWindows;
+   double dElapsedMs;
+};
+
+typedef CArray<CHANNELREQUEST, CHANNELREQUEST&> CChannelBatch;
+
+/**
+ * CCommandChannel
+ *
+ * Named pipe server owned by the running PuTTYCS. Each client
+ * connection is served by its own thread, which reads every frame
+ * already waiting in the pipe and posts them to the dialog as one
+ * batch (WM_USER_CHANNEL_BATCH, the batch in lParam), waits for the
+ * event in wParam that the dialog sets when it is done, then writes
+ * one reply per request. Clients may therefore pipeline requests
+ * without waiting for replies.
+ *
+ * Stop() is called on the dialog's thread. It does not return before
+ * every channel thread has ended, and drops the batches they posted
+ * that the dialog has not run.
+ */
+
+class CCommandChannel
+{
+public:
+
+   CCommandChannel();
+   virtual ~CCommandChannel();
+
+   bool Start( HWND hWndTarget );
+   void Stop();
+
+   static CString GetPipeName();
+
+   static HANDLE Connect( DWORD dwTimeout );
+
+   static bool ReadFrame( HANDLE hPipe, std::string& sPayload );
+   static bool WriteFrame( HANDLE hPipe, const std::string& sPayload );
+
+   static std::string FormatRequest( const CHANNELREQUEST& request );
+   static bool ParseRequest( const std::string& sPayload, CHANNELREQUEST& request );
+
+   static std::string FormatReply( const CHANNELREQUEST& request );
+   static bool ParseReply( const std::string& sPayload, CHANNELREQUEST& request );
+
+protected:
+
+   struct CONNECTION
+   {
+      CCommandChannel* pChannel;
+      HANDLE hPipe;
+      CWinThread* pThread;
+   };
+
+   static UINT ListenThread( LPVOID pParam );
+   static UINT ConnectionThread( LPVOID pParam );
+
+   static void EndThread( CWinThread* pThread );
+
+   HANDLE CreatePipe( bool bFirst );
+   void ReapConnections();
+
+   static CString FromUtf8( const std::string& sText );
+
+   HWND m_hWndTarget;
+
+   volatile LONG m_lStopping;
+   HANDLE m_hStopEvent;
+
+   CWinThread* m_pListenThread;
+
+   CRITICAL_SECTION m_csLock;
+   CPtrArray m_paConnections;
+};
+
+#endif // !defined(COMMANDCHANNEL_H__INCLUDED_)
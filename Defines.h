@@ -78,9 +78,16 @@
 #define PUTTYCS_WINDOW_TITLE_APP                 _T( "PuTTYCS ") PUTTYCS_VERSION 
 
 #define PUTTYCS_WINDOW_TITLE_ABOUT               _T( "About PuTTYCS...")
+#define PUTTYCS_WINDOW_TITLE_EXPORT_TRACE        _T( "Export send trace...")
+#define PUTTYCS_WINDOW_TITLE_LAUNCH_SESSIONS     _T( "Launch sessions...")
+#define PUTTYCS_WINDOW_TITLE_SAVE_LAYOUT         _T( "Save window layout")
+#define PUTTYCS_WINDOW_TITLE_WAIT_STATS          _T( "Wait statistics...")
+#define PUTTYCS_WINDOW_TITLE_RESTORE_LAYOUT      _T( "Restore window layout")
+#define PUTTYCS_WINDOW_TITLE_NO_LAYOUTS          _T( "(none)")
 
 #define PUTTYCS_ABOUT_TEXT_LINE1                 _T( "PuTTY Command Sender ") PUTTYCS_VERSION
 #define PUTTYCS_ABOUT_TEXT_LINE2                 _T( " 2005 - 2008 Millard Software. All rights reserved." )
+#define PUTTYCS_ABOUT_STARTUP_TEXT               _T( "Started in %.0f ms (%.0f ms before the dialog)" )
 
 #define PUTTYCS_WINDOW_TITLE_FILTER_ADD          _T( "Add Filter" )
 #define PUTTYCS_WINDOW_TITLE_FILTER_EDIT         _T( "Edit Filter" )
@@ -94,17 +101,43 @@
 
 #define PUTTYCS_MESSAGEBOX_MISSING_ARGUMENT      _T( "Missing argument for %s or %s option" )
 #define PUTTYCS_MESSAGEBOX_UNKNOWN_OPTION        _T( "Unknown option: %s" )
-#define PUTTYCS_MESSAGEBOX_HELP                  _T( "Usage: puttycs [OPTION]...\n\n-s, --script <path>\n    Send a PuTTYCS script\n\n-h, --help\n    Display this help" )
+#define PUTTYCS_MESSAGEBOX_HELP                  _T( "Usage: puttycs [OPTION]...\n\n-s, --script <path>\n    Send a PuTTYCS script\n\n-t, --trace <path>\n    Write a send trace (Chrome trace JSON) on exit\n\n--send <command> --filter <name> [--no-cr] [--json]\n    Send a command without opening PuTTYCS\n\n-h, --help\n    Display this help" )
 #define PUTTYCS_MESSAGEBOX_LOAD_SCRIPT_ERROR     _T( "Unable to load script.")
+#define PUTTYCS_MESSAGEBOX_EXPORT_TRACE_ERROR    _T( "Unable to write send trace.")
+#define PUTTYCS_MESSAGEBOX_LAUNCH_ERROR          _T( "Unable to read host list.")
+#define PUTTYCS_MESSAGEBOX_LAYOUT_ERROR          _T( "No such window layout.")
+#define PUTTYCS_MESSAGEBOX_LAYOUT_FULL           _T( "Too many window layouts.")
 
 #define PUTTYCS_CMD_SCRIPT                       _T( "-s" )
 #define PUTTYCS_CMD_SCRIPT_LONG                  _T( "--script" )
 
+#define PUTTYCS_CMD_TRACE                        _T( "-t" )
+#define PUTTYCS_CMD_TRACE_LONG                   _T( "--trace" )
+
+#define PUTTYCS_CMD_SEND                         _T( "--send" )
+#define PUTTYCS_CMD_FILTER                       _T( "--filter" )
+#define PUTTYCS_CMD_NO_CR                        _T( "--no-cr" )
+#define PUTTYCS_CMD_JSON                         _T( "--json" )
+
 #define PUTTYCS_CMD_HELP                         _T( "-h" )
 #define PUTTYCS_CMD_HELP_LONG                    _T( "--help" )
         
 #define PUTTYCS_MESSAGEBOX_UPDATE                _T( "A new version of PuTTYCS is available for download.\n\nCurrent version: %s\nLatest version: %s\n\nWould you like to go to the PuTTYCS homepage?" )
 #define PUTTYCS_MESSAGEBOX_NO_UPDATES            _T( "No updates found. PuTTYCS %s is the latest version." )
+#define PUTTYCS_MESSAGEBOX_UPDATE_FAILED         _T( "Unable to check for updates. Please try again later." )
+
+#define PUTTYCS_HEADLESS_MISSING_ARGUMENT        _T( "Missing argument for %s option" )
+#define PUTTYCS_HEADLESS_MISSING_FILTER          _T( "--send requires --filter <name>" )
+#define PUTTYCS_HEADLESS_UNKNOWN_FILTER          _T( "Unknown filter: %s" )
+#define PUTTYCS_HEADLESS_NO_WINDOWS              _T( "No PuTTY windows match filter: %s" )
+#define PUTTYCS_HEADLESS_WINDOW                  _T( "%s\t%s\t%.1f ms\n" )
+#define PUTTYCS_HEADLESS_STATUS_SENT             _T( "sent" )
+#define PUTTYCS_HEADLESS_STATUS_NOT_FOREGROUND   _T( "not foreground" )
+
+#define PUTTYCS_EXIT_SUCCESS                     0
+#define PUTTYCS_EXIT_SEND_FAILED                 1
+#define PUTTYCS_EXIT_USAGE                       2
+#define PUTTYCS_EXIT_NO_WINDOWS                  3
 
 #define PUTTYCS_URL_HOMEPAGE                     _T( "http://www.millardsoftware.com/puttycs?m=h&app=" ) PUTTYCS_APP_NAME _T( "&iv=" ) PUTTYCS_VERSION_INT 
 #define PUTTYCS_URL_DONATION                     _T( "http://www.millardsoftware.com/puttycs?m=d&app=" ) PUTTYCS_APP_NAME _T( "&iv=" ) PUTTYCS_VERSION_INT 
@@ -118,6 +151,8 @@
 #define PUTTYCS_FILTER_EXCLUDE                   _T( '-' )
 #define PUTTYCS_FILTER_SEPARATOR                 _T( ';' )
 
+#define PUTTYCS_PUTTY_TITLE_SUFFIX               _T( " - PuTTY" )
+
 #define PUTTYCS_FONT_MARLETT                     _T( "Marlett" )
 #define PUTTYCS_FONT_SYMBOL                      _T( "Symbol" )
 
@@ -128,6 +163,9 @@
 #define PUTTYCS_PREF_FILTER_ENTRY                _T( "filter%02d" )
 #define PUTTYCS_PREF_FILTER                      _T( "filter" )
 
+#define PUTTYCS_PREF_SNAPSHOT_MAX_SIZE           20
+#define PUTTYCS_PREF_SNAPSHOT_ENTRY              _T( "snapshot%02d" )
+
 #define PUTTYCS_PREF_WINDOW_TOOL                 _T( "toolWindow" )
 #define PUTTYCS_PREF_WINDOW_ALWAYS_ON_TOP        _T( "alwaysOnTop" )
 #define PUTTYCS_PREF_MINIMIZE_TO_SYSTRAY         _T( "minimizeToSysTray" )
@@ -142,6 +180,10 @@
 #define PUTTYCS_PREF_TILE_METHOD_VERTICAL        1
 #define PUTTYCS_PREF_TILE_METHOD_HORIZONTAL      2
 #define PUTTYCS_PREF_TILE_METHOD_CLASSIC         3
+#define PUTTYCS_PREF_TILE_METHOD_TERMINAL        4
+
+#define PUTTYCS_PREF_TILE_CELL_WIDTH             _T( "tileCellWidth" )
+#define PUTTYCS_PREF_TILE_CELL_HEIGHT            _T( "tileCellHeight" )
 
 #define PUTTYCS_PREF_CASCADE_WIDTH               _T( "cascadeWidth" )
 #define PUTTYCS_PREF_CASCADE_HEIGHT              _T( "cascadeHeight" )
@@ -158,27 +200,40 @@
 
 #define PUTTYCS_PREF_WINDOW_TRANSITION           _T( "transition" )
 #define PUTTYCS_PREF_POST_SEND_DELAY             _T( "postSendDelay" )
+#define PUTTYCS_PREF_AUTO_TUNE_DELAYS            _T( "autoTuneDelays" )
+#define PUTTYCS_PREF_AUTO_TUNE_MIN               _T( "autoTuneMin" )
+#define PUTTYCS_PREF_AUTO_TUNE_MAX               _T( "autoTuneMax" )
+
+#define PUTTYCS_PREF_SCRIPT_PROMPT               _T( "scriptPrompt" )
+#define PUTTYCS_PREF_SCRIPT_LINE_TIMEOUT         _T( "scriptLineTimeout" )
+#define PUTTYCS_PREF_SESSION_LOG                 _T( "sessionLog" )
+#define PUTTYCS_PREF_SCRIPT_CACHE                _T( "scriptCache" )
+
+#define PUTTYCS_PREF_INVENTORY_FILE              _T( "inventoryFile" )
+
+#define PUTTYCS_PREF_LAUNCH_COMMAND              _T( "launchCommand" )
+#define PUTTYCS_PREF_LAUNCH_CONCURRENCY          _T( "launchConcurrency" )
+#define PUTTYCS_PREF_LAUNCH_RATE                 _T( "launchRate" )
+#define PUTTYCS_PREF_LAUNCH_WINDOW_TIMEOUT       _T( "launchWindowTimeout" )
 
 #define PUTTYCS_PREF_SAVE_PASSWORD               _T( "savePassword" )
 #define PUTTYCS_PREF_PASSWORD                    _T( "password" )
 
 #define PUTTYCS_PREF_RUN_ON_SYSTEM_STARTUP       _T( "runOnSystemStartup" )
 #define PUTTYCS_PREF_CHECK_FOR_UPDATES           _T( "checkForUpdates" )
+#define PUTTYCS_PREF_LAST_UPDATE_CHECK           _T( "lastUpdateCheck" )
+#define PUTTYCS_PREF_LATEST_VERSION              _T( "latestVersion" )
+#define PUTTYCS_PREF_LATEST_INT_VERSION          _T( "latestIntVersion" )
+#define PUTTYCS_PREF_UPDATE_URL                  _T( "updateUrl" )
 
 #define PUTTYCS_TOKEN_CHAR_TO_STRING             _T( "%c" )
 #define PUTTYCS_TOKEN_INT_TO_STRING              _T( "%d" )
-#define PUTTYCS_TOKEN_ATTRIBUTE_START            _T( "%s=\"" )
-#define PUTTYCS_TOKEN_ATTRIBUTE_END              _T( "\"" )
 
 #define PUTTYCS_TOKEN_INC                        _T( "{%INC%}" )
 #define PUTTYCS_TOKEN_CTRL                       _T( "{%CTRL%}" )
 #define PUTTYCS_TOKEN_CHAR_INC                   0x01
 #define PUTTYCS_TOKEN_CHAR_CTRL                  0x02
 
-#define PUTTYCS_ATTRIBUTE_NAME                   _T( "name" )
-#define PUTTYCS_ATTRIBUTE_VERSION                _T( "version" )
-#define PUTTYCS_ATTRIBUTE_INT_VERSION            _T( "intVersion" )
-
 #define PUTTYCS_SENDKEY_BUTTON_UP                _T( "{UP}" )
 #define PUTTYCS_SENDKEY_BUTTON_DOWN              _T( "{DOWN}" )
 #define PUTTYCS_SENDKEY_BUTTON_RIGHT             _T( "{RIGHT}" )
@@ -229,7 +284,21 @@
 
 #define PUTTYCS_SHELL_EXECUTE_OPEN               _T( "open" )
 
+#define PUTTYCS_CACHE_DIRECTORY                  _T( "\\PuTTYCS" )
+#define PUTTYCS_CACHE_SUBDIRECTORY               _T( "\\Cache" )
+
 #define PUTTYCS_FILE_MODE_READ                   _T( "r" )
+#define PUTTYCS_FILE_MODE_WRITE_BINARY           _T( "wb" )
+
+#define PUTTYCS_TRACE_FILETYPE                   _T( "Chrome Trace Files (*.json)|*.json||" )
+#define PUTTYCS_TRACE_EXTENSION                  _T( "json" )
+
+#define PUTTYCS_HOSTS_FILETYPE                   _T( "Host Lists (*.txt;*.csv;*.tsv)|*.txt;*.csv;*.tsv|All Files (*.*)|*.*||" )
+
+#define PUTTYCS_LAUNCH_COMMAND_DEFAULT           _T( "putty.exe -load \"{%HOST%}\"" )
+#define PUTTYCS_LAUNCH_CONCURRENCY_DEFAULT       8
+#define PUTTYCS_LAUNCH_RATE_DEFAULT              10
+#define PUTTYCS_LAUNCH_WINDOW_TIMEOUT_DEFAULT    30000
 
 #define PUTTYCS_EMPTY_STRING                     _T( "" )
 
@@ -244,6 +313,29 @@
 
 #define PUTTYCS_TILE_METHOD_DEFAULT              PUTTYCS_PREF_TILE_METHOD_CLASSIC
 
+#define PUTTYCS_TILE_CELL_DEFAULT_WIDTH          8
+#define PUTTYCS_TILE_CELL_DEFAULT_HEIGHT         16
+
+#define PUTTYCS_TILE_CELL_MINIMUM                4
+#define PUTTYCS_TILE_CELL_MAXIMUM                64
+
+#define PUTTYCS_TILE_INNER_BORDER                2
+
+#define PUTTYCS_WAIT_TIMEOUT_FACTOR              4
+#define PUTTYCS_WAIT_REDRAW_DELAY                20
+#define PUTTYCS_WAIT_MINIMIZE_DELAY              250
+#define PUTTYCS_WAIT_PROBE_TIMEOUT               100
+
+#define PUTTYCS_CLOSE_TIMEOUT                    1000
+
+#define PUTTYCS_DELAY_MINIMUM                    1
+#define PUTTYCS_DELAY_MAXIMUM                    1500
+
+#define PUTTYCS_SCRIPT_LINE_TIMEOUT_DEFAULT      30000
+
+#define PUTTYCS_WAIT_SUMMARY_EMPTY               _T( "PuTTYCS has not waited on a window yet.\n" )
+#define PUTTYCS_WAIT_SUMMARY_FORMAT              _T( "PuTTYCS wait %s: %lu waits, %.1f ms observed, %.1f ms fixed, %.1f ms saved, %.1f ms max, %lu timeouts, %lu fallbacks\n" )
+
 #define PUTTYCS_OPACITY_MIN                      50
 #define PUTTYCS_OPACITY_MAX                      255
 
@@ -252,5 +344,52 @@
 #define PUTTYCS_WM_COPYDATA_CMD_LINE             1
 
 #define WM_USER_TNI_MESSAGE                      WM_USER + 1
+#define WM_USER_CHANNEL_BATCH                    WM_USER + 2
+#define WM_USER_UPDATE_CHECKED                   WM_USER + 3
+#define WM_USER_DEFERRED_INIT                    WM_USER + 4
+
+#define PUTTYCS_TIMER_LIVE                       1
+#define PUTTYCS_TIMER_LIVE_INTERVAL              250
+#define PUTTYCS_TIMER_SEND_QUEUE                 2
+#define PUTTYCS_TIMER_SEND_QUEUE_INTERVAL        1
+#define PUTTYCS_TIMER_LAUNCH                     3
+
+#define PUTTYCS_SEND_QUEUE_CAPACITY              16
+
+#define PUTTYCS_WINDOW_TITLE_QUEUED_FORMAT       _T( " - %d queued" )
+#define PUTTYCS_WINDOW_TITLE_QUEUE_FULL          _T( " - queue full" )
+#define PUTTYCS_WINDOW_TITLE_LAUNCHING_FORMAT    _T( " - launching %d/%d" )
+
+#define PUTTYCS_PROFILE_SECTION_SIZE             32768
+#define PUTTYCS_PROFILE_SECTION_MAX_SIZE         (1024 * 1024)
+
+#define PUTTYCS_UPDATE_INTERVAL                  (24 * 60 * 60)
+#define PUTTYCS_UPDATE_DEADLINE                  5000
+#define PUTTYCS_UPDATE_MAX_SIZE                  65536
+
+#define PUTTYCS_CHANNEL_PIPE_NAME                _T( "\\\\.\\pipe\\PuTTYCS-%lu" )
+#define PUTTYCS_CHANNEL_BUFFER_SIZE              65536
+#define PUTTYCS_CHANNEL_MAX_FRAME                (16 * 1024 * 1024)
+#define PUTTYCS_CHANNEL_CONNECT_TIMEOUT          1000
+#define PUTTYCS_CHANNEL_STOP_TIMEOUT             2000
+
+#define PUTTYCS_CHANNEL_VERB_SEND                _T( "send" )
+#define PUTTYCS_CHANNEL_VERB_SEND_NO_CR          _T( "sendnocr" )
+#define PUTTYCS_CHANNEL_VERB_SCRIPT              _T( "script" )
+#define PUTTYCS_CHANNEL_VERB_TILE                _T( "tile" )
+#define PUTTYCS_CHANNEL_VERB_PIN                 _T( "pin" )
+#define PUTTYCS_CHANNEL_VERB_UNPIN               _T( "unpin" )
+#define PUTTYCS_CHANNEL_VERB_RELEASE             _T( "release" )
+#define PUTTYCS_CHANNEL_VERB_LAUNCH              _T( "launch" )
+#define PUTTYCS_CHANNEL_VERB_SNAPSHOT            _T( "snapshot" )
+#define PUTTYCS_CHANNEL_VERB_RESTORE             _T( "restore" )
+
+#define PUTTYCS_CHANNEL_STATUS_OK                _T( "ok" )
+#define PUTTYCS_CHANNEL_STATUS_NO_WINDOWS        _T( "nowindows" )
+#define PUTTYCS_CHANNEL_STATUS_ERROR             _T( "error" )
+
+#define PUTTYCS_CHANNEL_MALFORMED                _T( "Malformed request" )
+#define PUTTYCS_CHANNEL_CLOSING                  _T( "PuTTYCS is closing" )
+#define PUTTYCS_CHANNEL_UNKNOWN_VERB             _T( "Unknown request: %s" )
 
 #endif // !defined(DEFINES_H__INCLUDED_)
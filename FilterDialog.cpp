@@ -35,6 +35,7 @@
 #include "stdafx.h"
 #include "puttycs.h"
 #include "FilterDialog.h"
+#include "SendEngine.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -70,6 +71,7 @@ BEGIN_MESSAGE_MAP(CFilterDialog, CDialog)
    //{{AFX_MSG_MAP(CFilterDialog)
    ON_EN_CHANGE(IDC_FILTERNAME_EDIT, OnChangeFilterName)
    ON_EN_CHANGE(IDC_FILTERLIST_EDIT, OnChangeFilterList)
+   ON_EN_CHANGE(IDC_FILTERPROMPT_EDIT, OnChangeFilterPrompt)
    ON_BN_CLICKED(IDC_OK_BUTTON, OnOK)
 	ON_WM_HELPINFO()
 	//}}AFX_MSG_MAP
@@ -103,6 +105,7 @@ BOOL CFilterDialog::OnInitDialog()
 
    SetDlgItemText( IDC_FILTERNAME_EDIT, m_csFilterName );
    SetDlgItemText( IDC_FILTERLIST_EDIT, m_csFilterList );
+   SetDlgItemText( IDC_FILTERPROMPT_EDIT, m_csFilterPrompt );
 
    RefreshDialog();
    
@@ -119,7 +122,8 @@ void CFilterDialog::RefreshDialog()
       (!m_csFilterName.IsEmpty()) && 
        (m_csFilterName.Find(PUTTYCS_FILTER_NAME_SEPARATOR) == -1) &&
       (!m_csFilterList.IsEmpty()) &&
-       (m_csFilterList.Find(PUTTYCS_FILTER_NAME_SEPARATOR) == -1) );      
+       (m_csFilterList.Find(PUTTYCS_FILTER_NAME_SEPARATOR) == -1) &&
+      CSendEngine::IsValidPrompt(m_csFilterPrompt) );      
 }
 
 /**
@@ -167,6 +171,43 @@ void CFilterDialog::setFilterList( CString csFilterList )
    m_csFilterList = csFilterList;
 }
 
+/** 
+ * CFilterDialog::getFilterPrompt()
+ */
+
+CString CFilterDialog::getFilterPrompt( )
+{
+   return m_csFilterPrompt;
+}
+
+/** 
+ * CFilterDialog::setFilterPrompt()
+ */
+
+void CFilterDialog::setFilterPrompt( CString csFilterPrompt )
+{
+   m_csFilterPrompt = csFilterPrompt;
+}
+
+/** 
+ * CFilterDialog::getFilterEntry()
+ *
+ * The filter as stored: name||list, then ||prompt if it has one
+ */
+
+CString CFilterDialog::getFilterEntry( )
+{
+   CString csEntry = 
+      m_csFilterName + PUTTYCS_FILTER_NAME_SEPARATOR + m_csFilterList;
+
+   if ( !m_csFilterPrompt.IsEmpty() )
+   {
+      csEntry += PUTTYCS_FILTER_NAME_SEPARATOR + m_csFilterPrompt;
+   }
+
+   return csEntry;
+}
+
 /**
  * CFilterDialog::OnChangeFilterName()
  */
@@ -193,4 +234,17 @@ void CFilterDialog::OnChangeFilterList()
    m_csFilterList.TrimRight();
 
    RefreshDialog();   
-}
\ No newline at end of file
+}
+
+/**
+ * CFilterDialog::OnChangeFilterPrompt()
+ *
+ * Not trimmed, spaces can be part of a prompt
+ */
+
+void CFilterDialog::OnChangeFilterPrompt() 
+{
+   GetDlgItemText(IDC_FILTERPROMPT_EDIT, m_csFilterPrompt);
+
+   RefreshDialog();   
+}
@@ -58,6 +58,11 @@ public:
    CString getFilterList();   
    void setFilterList( CString csFilterList );
 
+   CString getFilterPrompt();
+   void setFilterPrompt( CString csFilterPrompt );
+
+   CString getFilterEntry();
+
 // Overrides
    // ClassWizard generated virtual function overrides
    //{{AFX_VIRTUAL(CFilterDialog)
@@ -73,12 +78,14 @@ protected:
    virtual BOOL OnInitDialog();
    afx_msg void OnChangeFilterName();
    afx_msg void OnChangeFilterList();   
+   afx_msg void OnChangeFilterPrompt();
 	afx_msg BOOL OnHelpInfo(HELPINFO* pHelpInfo);
 	//}}AFX_MSG
    DECLARE_MESSAGE_MAP()
 
    CString m_csFilterName;
    CString m_csFilterList;
+   CString m_csFilterPrompt;
    
    CString m_csWindowTitle;
 
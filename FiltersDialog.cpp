@@ -36,6 +36,7 @@
 #include "puttycs.h"
 #include "FiltersDialog.h"
 #include "FilterDialog.h"
+#include "SendEngine.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -186,13 +187,10 @@ void CFiltersDialog::RefreshDialog()
    CString csFilter = 
       m_csaFilters.GetAt(index);
 
-   int pos =
-      csFilter.Find( PUTTYCS_FILTER_NAME_SEPARATOR );
-
-   if ( pos != -1 )
+   if ( csFilter.Find(PUTTYCS_FILTER_NAME_SEPARATOR) != -1 )
    {        
      SetDlgItemText( IDC_FILTERLIST_EDIT, 
-         csFilter.Mid(pos + 2) );
+         CSendEngine::GetFilterList(csFilter) );
    }
 
    ((CButton*) GetDlgItem(IDC_ADD_BUTTON))->EnableWindow( 
@@ -235,10 +233,7 @@ void CFiltersDialog::OnAddButton()
    
    if ( pDialog->DoModal() == IDOK )
    {
-      m_csaFilters.Add(
-         pDialog->getFilterName() +
-         PUTTYCS_FILTER_NAME_SEPARATOR + 
-         pDialog->getFilterList() );
+      m_csaFilters.Add( pDialog->getFilterEntry() );
 
       m_bChanges = true;
 
@@ -275,13 +270,12 @@ void CFiltersDialog::OnEditButton()
 
       pDialog->setFilterName( csFilterName );
       pDialog->setFilterList( csFilterList );
+      pDialog->setFilterPrompt( 
+         CSendEngine::GetFilterPrompt(m_csaFilters.GetAt(index)) );
 
       if ( pDialog->DoModal() == IDOK )
       {
-         m_csaFilters.SetAt( index, 
-            pDialog->getFilterName() +
-            PUTTYCS_FILTER_NAME_SEPARATOR + 
-            pDialog->getFilterList() );
+         m_csaFilters.SetAt( index, pDialog->getFilterEntry() );
 
          m_bChanges = true;
 
@@ -321,13 +315,12 @@ void CFiltersDialog::OnCopyButton()
 
       pDialog->setFilterName( csFilterName );
       pDialog->setFilterList( csFilterList );
+      pDialog->setFilterPrompt( 
+         CSendEngine::GetFilterPrompt(m_csaFilters.GetAt(index)) );
    
       if ( pDialog->DoModal() == IDOK )
       {
-         m_csaFilters.Add(
-             pDialog->getFilterName() +
-             PUTTYCS_FILTER_NAME_SEPARATOR + 
-             pDialog->getFilterList() );
+         m_csaFilters.Add( pDialog->getFilterEntry() );
 
          m_bChanges = true;
 
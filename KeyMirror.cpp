@@ -0,0 +1,348 @@
+/**
+ * KeyMirror.cpp - PuTTYCS live keystroke mirror
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "KeyMirror.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * Latency rows shown in the summary, in milliseconds
+ */
+
+static const int g_aiSummaryRows[] = { 1, 2, 4, 8 };
+
+static const int SUMMARY_BAR_WIDTH = 20;
+
+CKeyMirror* CKeyMirror::g_pActive = NULL;
+unsigned long CKeyMirror::g_ulGenerations = 0;
+
+/**
+ * CKeyMirror::CKeyMirror()
+ */
+
+CKeyMirror::CKeyMirror()
+{
+   m_pTrace = NULL;
+   m_ulGeneration = 0;
+
+   Stop();
+}
+
+/**
+ * CKeyMirror::~CKeyMirror()
+ */
+
+CKeyMirror::~CKeyMirror()
+{
+   Stop();
+}
+
+/**
+ * CKeyMirror::Start()
+ *
+ * Resolves the filter once, so a key costs one SendMessageCallback()
+ * per window and no window enumeration
+ */
+
+int CKeyMirror::Start( CString csEntry, CSendEngine* pSendEngine )
+{
+   Stop();
+
+   std::vector<WINDOWINFO> vecWindows;
+   pSendEngine->FindWindows( csEntry, vecWindows );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      m_vecWindows.push_back( CWin32WindowSystem::GetHwnd(vecWindows[iLoop].id) );
+   }
+
+   m_pTrace = &pSendEngine->GetSendTrace();
+
+   // Every start gets a new generation, even on another mirror
+
+   m_ulGeneration = ++g_ulGenerations & MIRROR_GENERATION_MASK;
+
+   g_pActive = this;
+
+   return (int) m_vecWindows.size();
+}
+
+/**
+ * CKeyMirror::Stop()
+ *
+ * Callbacks of deliveries still in flight arrive after this and are
+ * dropped
+ */
+
+void CKeyMirror::Stop()
+{
+   if ( g_pActive == this )
+   {
+      g_pActive = NULL;
+   }
+
+   m_vecWindows.clear();
+
+   memset( m_allStartUs, 0, sizeof(m_allStartUs) );
+   m_ulKeys = 0;
+   m_ulPending = 0;
+   m_ulFailed = 0;
+
+   m_lhLatency = LATENCYHISTOGRAM();
+}
+
+/**
+ * CKeyMirror::IsActive()
+ */
+
+bool CKeyMirror::IsActive() const
+{
+   return g_pActive == this;
+}
+
+/**
+ * CKeyMirror::GetWindowCount()
+ */
+
+int CKeyMirror::GetWindowCount() const
+{
+   return (int) m_vecWindows.size();
+}
+
+/**
+ * CKeyMirror::IsTranslatedKey()
+ *
+ * Keys PuTTY turns into escape sequences itself; everything else
+ * reaches it as WM_CHAR
+ */
+
+bool CKeyMirror::IsTranslatedKey( UINT uiVKey )
+{
+   switch ( uiVKey )
+   {
+      case VK_BACK:
+      case VK_TAB:
+      case VK_RETURN:
+      case VK_ESCAPE:
+      case VK_INSERT:
+      case VK_DELETE:
+         return true;
+   }
+
+   return ((uiVKey >= VK_PRIOR) && (uiVKey <= VK_DOWN))
+       || ((uiVKey >= VK_F1) && (uiVKey <= VK_F12));
+}
+
+/**
+ * CKeyMirror::Forward()
+ *
+ * Called from PreTranslateMessage() for keyboard messages of the
+ * command edit. Returns true when the message was mirrored and must
+ * not reach the edit. Other key downs return false, so
+ * TranslateMessage() produces the WM_CHAR that is mirrored next.
+ * Alt combinations are left to the dialog.
+ */
+
+bool CKeyMirror::Forward( const MSG* pMsg )
+{
+   if ( !IsActive() )
+   {
+      return false;
+   }
+
+   switch ( pMsg->message )
+   {
+      case WM_CHAR:
+         Deliver( WM_CHAR, pMsg->wParam, pMsg->lParam );
+         return true;
+
+      case WM_KEYDOWN:
+         if ( IsTranslatedKey((UINT) pMsg->wParam) )
+         {
+            Deliver( WM_KEYDOWN, pMsg->wParam, pMsg->lParam );
+            return true;
+         }
+
+         return false;
+
+      case WM_KEYUP:
+         return true;
+   }
+
+   return false;
+}
+
+/**
+ * CKeyMirror::Deliver()
+ *
+ * SendMessageCallback() queues the message to each PuTTY thread and
+ * returns at once. Unlike SetForegroundWindow() and SendInput() it
+ * moves neither focus nor the Z order. The sequence number in the
+ * callback data finds the start time again, and the generation
+ * tells the callbacks of an earlier Start() apart.
+ */
+
+void CKeyMirror::Deliver( UINT uiMessage, WPARAM wParam, LPARAM lParam )
+{
+   unsigned long ulSequence = m_ulKeys++;
+
+   m_allStartUs[ulSequence % MIRROR_RING] = (m_pTrace != NULL) ? m_pTrace->Now() : 0;
+
+   ULONG_PTR dwData = ((ULONG_PTR) m_ulGeneration << MIRROR_SEQUENCE_BITS) | 
+      (ulSequence & MIRROR_SEQUENCE_MASK);
+
+   for ( size_t iLoop = 0; iLoop < m_vecWindows.size(); iLoop++ )
+   {
+      if ( ::SendMessageCallback(m_vecWindows[iLoop], uiMessage, wParam, lParam, 
+                                 OnDelivered, dwData) )
+      {
+         m_ulPending++;
+      }
+      else
+      {
+         m_ulFailed++;
+      }
+   }
+}
+
+/**
+ * CKeyMirror::OnDelivered()
+ *
+ * Runs on the UI thread once the PuTTY window procedure returned, the
+ * next time the message loop gets messages. A PuTTY that was slow to
+ * handle a key may answer after live mode was restarted; such a
+ * callback belongs to an earlier generation and is dropped without
+ * touching the pending count or the histogram of the new one.
+ */
+
+VOID CALLBACK CKeyMirror::OnDelivered( HWND hWnd, UINT uiMessage, ULONG_PTR dwData, LRESULT lResult )
+{
+   CKeyMirror* pMirror = g_pActive;
+
+   if ( (pMirror == NULL) || (pMirror->m_pTrace == NULL) || (pMirror->m_ulPending == 0) )
+   {
+      return;
+   }
+
+   if ( ((dwData >> MIRROR_SEQUENCE_BITS) & MIRROR_GENERATION_MASK) != pMirror->m_ulGeneration )
+   {
+      return;
+   }
+
+   unsigned long ulSequence = (unsigned long) (dwData & MIRROR_SEQUENCE_MASK);
+
+   pMirror->m_ulPending--;
+
+   if ( ((pMirror->m_ulKeys - ulSequence) & MIRROR_SEQUENCE_MASK) > MIRROR_RING )
+   {
+      return;
+   }
+
+   long long llStartUs = pMirror->m_allStartUs[ulSequence % MIRROR_RING];
+   long long llEndUs = pMirror->m_pTrace->Now();
+
+   CSendTrace::AddLatency( pMirror->m_lhLatency, llEndUs - llStartUs );
+
+   pMirror->m_pTrace->Record( "mirror", CWin32WindowSystem::GetId(hWnd), llStartUs, llEndUs );
+}
+
+/**
+ * CKeyMirror::GetHistogram()
+ */
+
+const LATENCYHISTOGRAM& CKeyMirror::GetHistogram() const
+{
+   return m_lhLatency;
+}
+
+/**
+ * CKeyMirror::GetSummary()
+ *
+ * Text shown in the command edit while live mode is on
+ */
+
+CString CKeyMirror::GetSummary() const
+{
+   CString csSummary;
+
+   csSummary.Format( _T( "Live: %d windows, %lu keys, %lu delivered, %lu failed\r\n" )
+                     _T( "p50 %.1f  p90 %.1f  p99 %.1f  max %.1f ms\r\n" ),
+                     GetWindowCount(), m_ulKeys, m_lhLatency.ulCount, m_ulFailed,
+                     CSendTrace::GetPercentile( m_lhLatency, 50 ) / 1000.0,
+                     CSendTrace::GetPercentile( m_lhLatency, 90 ) / 1000.0,
+                     CSendTrace::GetPercentile( m_lhLatency, 99 ) / 1000.0,
+                     m_lhLatency.dMaxUs / 1000.0 );
+
+   /**
+    * Bucket i holds latencies below 2^(i+1) us, so the row for n ms
+    * sums the buckets up to 2^i < n * 1000
+    */
+
+   int iRows = sizeof(g_aiSummaryRows) / sizeof(g_aiSummaryRows[0]);
+   int iBucket = 0;
+
+   for ( int iRow = 0; iRow <= iRows; iRow++ )
+   {
+      unsigned long ulRowCount = 0;
+
+      while ( (iBucket < TRACE_HISTOGRAM_BUCKETS) 
+           && ((iRow == iRows) || ((2LL << iBucket) <= g_aiSummaryRows[iRow] * 1000LL)) )
+      {
+         ulRowCount += m_lhLatency.aulBuckets[iBucket++];
+      }
+
+      int iBar = (m_lhLatency.ulCount > 0) 
+         ? (int) ((ulRowCount * SUMMARY_BAR_WIDTH + m_lhLatency.ulCount - 1) / m_lhLatency.ulCount) : 0;
+
+      CString csRow;
+
+      if ( iRow < iRows )
+      {
+         csRow.Format( _T( " <%d ms %5lu %s\r\n" ), g_aiSummaryRows[iRow], ulRowCount,
+                       (LPCTSTR) CString(_T('#'), iBar) );
+      }
+      else
+      {
+         csRow.Format( _T( ">=%d ms %5lu %s" ), g_aiSummaryRows[iRows - 1], ulRowCount,
+                       (LPCTSTR) CString(_T('#'), iBar) );
+      }
+
+      csSummary += csRow;
+   }
+
+   return csSummary;
+}
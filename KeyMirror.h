@@ -0,0 +1,113 @@
+/**
+ * KeyMirror.h - PuTTYCS live keystroke mirror header
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(KEYMIRROR_H__INCLUDED_)
+#define KEYMIRROR_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+
+#include "SendEngine.h"
+
+/**
+ * CKeyMirror
+ *
+ * Live mode: every key typed into the command edit goes straight to
+ * each PuTTY window of the filter, so vi or top can be driven on all
+ * of them at once. Keys are delivered with SendMessageCallback(), so
+ * no window is activated and a hung PuTTY does not hold up the
+ * others. Characters go as WM_CHAR, the keys PuTTY translates itself
+ * (cursor, editing, function keys, Backspace, Tab, Enter, Esc) as
+ * WM_KEYDOWN. The delay from the key press to each PuTTY having
+ * handled it is kept in a histogram.
+ */
+
+class CKeyMirror
+{
+public:
+
+   CKeyMirror();
+   virtual ~CKeyMirror();
+
+   int Start( CString csEntry, CSendEngine* pSendEngine );
+   void Stop();
+
+   bool IsActive() const;
+   int GetWindowCount() const;
+
+   bool Forward( const MSG* pMsg );
+
+   const LATENCYHISTOGRAM& GetHistogram() const;
+   CString GetSummary() const;
+
+   static bool IsTranslatedKey( UINT uiVKey );
+
+protected:
+
+   /**
+    * The callback data of a delivery holds the generation of the
+    * Start() that sent it above the sequence number of the key
+    */
+
+   enum
+   {
+      MIRROR_RING = 256,
+      MIRROR_SEQUENCE_BITS = 24,
+      MIRROR_SEQUENCE_MASK = (1 << MIRROR_SEQUENCE_BITS) - 1,
+      MIRROR_GENERATION_MASK = 0xFF
+   };
+
+   void Deliver( UINT uiMessage, WPARAM wParam, LPARAM lParam );
+
+   static VOID CALLBACK OnDelivered( HWND hWnd, UINT uiMessage, ULONG_PTR dwData, LRESULT lResult );
+
+   std::vector<HWND> m_vecWindows;
+
+   CSendTrace* m_pTrace;
+
+   unsigned long m_ulGeneration;
+
+   long long m_allStartUs[MIRROR_RING];
+   unsigned long m_ulKeys;
+   unsigned long m_ulPending;
+   unsigned long m_ulFailed;
+
+   LATENCYHISTOGRAM m_lhLatency;
+
+   static CKeyMirror* g_pActive;
+   static unsigned long g_ulGenerations;
+};
+
+#endif // !defined(KEYMIRROR_H__INCLUDED_)
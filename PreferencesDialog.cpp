@@ -90,6 +90,9 @@ BEGIN_MESSAGE_MAP(CPreferencesDialog, CDialog)
    ON_BN_CLICKED(IDC_ALWAYSONTOP_CHECKBOX, OnAlwaysOnTopCheckbox)   
    ON_EN_CHANGE(IDC_TRANSITION_EDIT, OnChangeTransition)      
    ON_EN_CHANGE(IDC_POST_SEND_DELAY_EDIT, OnChangePostSendDelay)      
+   ON_BN_CLICKED(IDC_AUTOTUNE_CHECKBOX, OnAutoTuneCheckbox)
+   ON_EN_CHANGE(IDC_AUTOTUNE_MIN_EDIT, OnChangeAutoTuneMin)
+   ON_EN_CHANGE(IDC_AUTOTUNE_MAX_EDIT, OnChangeAutoTuneMax)
    ON_BN_CLICKED(IDC_EMULATECOPYPASTE_CHECKBOX, OnEmulateCopyPasteCheckbox)
    ON_BN_CLICKED(IDC_CMDHISTORYSCROLLTHROUGH_CHECKBOX, OnCmdHistoryScrollThroughCheckbox)
    ON_BN_CLICKED(IDC_TABCOMPLETION_CHECKBOX, OnTabCompletionCheckbox)   
@@ -98,12 +101,15 @@ BEGIN_MESSAGE_MAP(CPreferencesDialog, CDialog)
    ON_BN_CLICKED(IDC_CHECKFORUPDATES_CHECKBOX, OnCheckForUpdatesCheckbox)
 	ON_EN_CHANGE(IDC_CASCADE_HEIGHT_EDIT, OnChangeCascadeHeightEdit)
 	ON_EN_CHANGE(IDC_CASCADE_WIDTH_EDIT, OnChangeCascadeWidthEdit)
+   ON_EN_CHANGE(IDC_TILE_CELL_WIDTH_EDIT, OnChangeTileCellWidthEdit)
+   ON_EN_CHANGE(IDC_TILE_CELL_HEIGHT_EDIT, OnChangeTileCellHeightEdit)
    ON_BN_CLICKED(IDC_AUTOARRANGE_OFF_RADIO, OnAutoArrangeRadio)
    ON_BN_CLICKED(IDC_AUTOARRANGE_CASCADE_RADIO, OnAutoArrangeRadio)   
    ON_BN_CLICKED(IDC_AUTOARRANGE_TILE_RADIO, OnAutoArrangeRadio)
    ON_BN_CLICKED(IDC_TILEMETHOD_VERTICAL_RADIO, OnTileMethodRadio)
    ON_BN_CLICKED(IDC_TILEMETHOD_HORIZONTAL_RADIO, OnTileMethodRadio)   
    ON_BN_CLICKED(IDC_TILEMETHOD_CLASSIC_RADIO, OnTileMethodRadio)
+   ON_BN_CLICKED(IDC_TILEMETHOD_TERMINAL_RADIO, OnTileMethodRadio)
 	ON_BN_CLICKED(IDC_FIND_BUTTON, OnFindButton)
    ON_BN_CLICKED(IDC_OK_BUTTON, OnOKButton)
    ON_WM_HSCROLL()  
@@ -183,6 +189,42 @@ void CPreferencesDialog::setTileMethod( int iTileMethod)
    m_iTileMethod = iTileMethod;
 }
 
+/**
+ * CPreferencesDialog::getTileCellWidth()
+ */
+
+int CPreferencesDialog::getTileCellWidth()
+{
+   return m_iTileCellWidth;
+}
+
+/**
+ * CPreferencesDialog::setTileCellWidth()
+ */
+
+void CPreferencesDialog::setTileCellWidth( int iTileCellWidth )
+{
+   m_iTileCellWidth = iTileCellWidth;
+}
+
+/**
+ * CPreferencesDialog::getTileCellHeight()
+ */
+
+int CPreferencesDialog::getTileCellHeight()
+{
+   return m_iTileCellHeight;
+}
+
+/**
+ * CPreferencesDialog::setTileCellHeight()
+ */
+
+void CPreferencesDialog::setTileCellHeight( int iTileCellHeight )
+{
+   m_iTileCellHeight = iTileCellHeight;
+}
+
 /**
  * CPreferencesDialog::getCascadeWidth()
  */
@@ -399,6 +441,60 @@ void CPreferencesDialog::setPostSendDelay( int iPostSendDelay )
    m_iPostSendDelay = iPostSendDelay;
 }
 
+/**
+ * CPreferencesDialog::getAutoTuneDelays()
+ */
+
+int CPreferencesDialog::getAutoTuneDelays()
+{
+   return m_iAutoTuneDelays;
+}
+
+/**
+ * CPreferencesDialog::setAutoTuneDelays()
+ */
+
+void CPreferencesDialog::setAutoTuneDelays( int iAutoTuneDelays )
+{
+   m_iAutoTuneDelays = iAutoTuneDelays;
+}
+
+/**
+ * CPreferencesDialog::getAutoTuneMin()
+ */
+
+int CPreferencesDialog::getAutoTuneMin()
+{
+   return m_iAutoTuneMin;
+}
+
+/**
+ * CPreferencesDialog::setAutoTuneMin()
+ */
+
+void CPreferencesDialog::setAutoTuneMin( int iAutoTuneMin )
+{
+   m_iAutoTuneMin = iAutoTuneMin;
+}
+
+/**
+ * CPreferencesDialog::getAutoTuneMax()
+ */
+
+int CPreferencesDialog::getAutoTuneMax()
+{
+   return m_iAutoTuneMax;
+}
+
+/**
+ * CPreferencesDialog::setAutoTuneMax()
+ */
+
+void CPreferencesDialog::setAutoTuneMax( int iAutoTuneMax )
+{
+   m_iAutoTuneMax = iAutoTuneMax;
+}
+
 /** 
  * CPreferencesDialog::getSavePassword()
  */
@@ -516,6 +612,15 @@ BOOL CPreferencesDialog::OnInitDialog()
    CheckDlgButton( IDC_TILEMETHOD_CLASSIC_RADIO, 
       (m_iTileMethod == PUTTYCS_PREF_TILE_METHOD_CLASSIC) );
 
+   CheckDlgButton( IDC_TILEMETHOD_TERMINAL_RADIO, 
+      (m_iTileMethod == PUTTYCS_PREF_TILE_METHOD_TERMINAL) );
+
+   SetDlgItemInt( IDC_TILE_CELL_WIDTH_EDIT, 
+      m_iTileCellWidth );
+
+   SetDlgItemInt( IDC_TILE_CELL_HEIGHT_EDIT, 
+      m_iTileCellHeight );
+
    SetDlgItemInt( IDC_CASCADE_WIDTH_EDIT, 
       m_iCascadeWidth );
 
@@ -557,6 +662,15 @@ BOOL CPreferencesDialog::OnInitDialog()
    SetDlgItemInt( IDC_POST_SEND_DELAY_EDIT, 
       m_iPostSendDelay );
 
+   CheckDlgButton( IDC_AUTOTUNE_CHECKBOX, 
+      m_iAutoTuneDelays );
+
+   SetDlgItemInt( IDC_AUTOTUNE_MIN_EDIT, 
+      m_iAutoTuneMin );
+
+   SetDlgItemInt( IDC_AUTOTUNE_MAX_EDIT, 
+      m_iAutoTuneMax );
+
    CheckDlgButton( IDC_RUNONSYSTEMSTARTUP_CHECKBOX, 
       m_iRunOnSystemStartup );
 
@@ -580,16 +694,35 @@ void CPreferencesDialog::UpdateDialog()
    ((CButton*) GetDlgItem(IDC_ARRANGEONSTARTUP_CHECKBOX))->
       EnableWindow( (m_iAutoArrange != 1) );
 
+   ((CEdit*) GetDlgItem(IDC_TILE_CELL_WIDTH_EDIT))->
+      EnableWindow( (m_iTileMethod == PUTTYCS_PREF_TILE_METHOD_TERMINAL) );
+
+   ((CEdit*) GetDlgItem(IDC_TILE_CELL_HEIGHT_EDIT))->
+      EnableWindow( (m_iTileMethod == PUTTYCS_PREF_TILE_METHOD_TERMINAL) );
+
+   ((CEdit*) GetDlgItem(IDC_AUTOTUNE_MIN_EDIT))->
+      EnableWindow( m_iAutoTuneDelays );
+
+   ((CEdit*) GetDlgItem(IDC_AUTOTUNE_MAX_EDIT))->
+      EnableWindow( m_iAutoTuneDelays );
+
    ((CButton*) GetDlgItem(IDC_OK_BUTTON))->
-      EnableWindow( (m_iTransition >= 1) && 
-                    (m_iTransition <= 1500) &&
-                    (m_iPostSendDelay >= 1) &&
-                    (m_iPostSendDelay <= 1500) &&
+      EnableWindow( (m_iTransition >= PUTTYCS_DELAY_MINIMUM) && 
+                    (m_iTransition <= PUTTYCS_DELAY_MAXIMUM) &&
+                    (m_iPostSendDelay >= PUTTYCS_DELAY_MINIMUM) &&
+                    (m_iPostSendDelay <= PUTTYCS_DELAY_MAXIMUM) &&
+                    (m_iAutoTuneMin >= PUTTYCS_DELAY_MINIMUM) &&
+                    (m_iAutoTuneMax <= PUTTYCS_DELAY_MAXIMUM) &&
+                    (m_iAutoTuneMin <= m_iAutoTuneMax) &&
                     (m_iOpacity >= PUTTYCS_OPACITY_MIN) &&
                     (m_iCascadeWidth >= PUTTYCS_CASCADE_MINIMUM_WIDTH) &&
                     (m_iCascadeWidth <= PUTTYCS_CASCADE_MAXIMUM_WIDTH) &&
                     (m_iCascadeHeight >= PUTTYCS_CASCADE_MINIMUM_HEIGHT) &&
-                    (m_iCascadeHeight <= PUTTYCS_CASCADE_MAXIMUM_HEIGHT) ); 
+                    (m_iCascadeHeight <= PUTTYCS_CASCADE_MAXIMUM_HEIGHT) &&
+                    (m_iTileCellWidth >= PUTTYCS_TILE_CELL_MINIMUM) &&
+                    (m_iTileCellWidth <= PUTTYCS_TILE_CELL_MAXIMUM) &&
+                    (m_iTileCellHeight >= PUTTYCS_TILE_CELL_MINIMUM) &&
+                    (m_iTileCellHeight <= PUTTYCS_TILE_CELL_MAXIMUM) ); 
       
    float fPercent = 
       ((float) (m_iOpacity - PUTTYCS_OPACITY_MIN) /
@@ -648,7 +781,9 @@ void CPreferencesDialog::OnTileMethodRadio()
         (((CButton*) GetDlgItem(IDC_TILEMETHOD_HORIZONTAL_RADIO))->
           GetCheck() * PUTTYCS_PREF_TILE_METHOD_HORIZONTAL) +
         (((CButton*) GetDlgItem(IDC_TILEMETHOD_CLASSIC_RADIO))->
-          GetCheck() * PUTTYCS_PREF_TILE_METHOD_CLASSIC) );
+          GetCheck() * PUTTYCS_PREF_TILE_METHOD_CLASSIC) +
+        (((CButton*) GetDlgItem(IDC_TILEMETHOD_TERMINAL_RADIO))->
+          GetCheck() * PUTTYCS_PREF_TILE_METHOD_TERMINAL) );
    
    UpdateDialog();
 }
@@ -701,6 +836,30 @@ void CPreferencesDialog::OnChangeCascadeHeightEdit()
    UpdateDialog();	
 }
 
+/** 
+ * CPreferencesDialog::OnChangeTileCellWidthEdit()
+ */
+
+void CPreferencesDialog::OnChangeTileCellWidthEdit() 
+{
+   m_iTileCellWidth =
+      GetDlgItemInt( IDC_TILE_CELL_WIDTH_EDIT );
+
+   UpdateDialog();
+}
+
+/** 
+ * CPreferencesDialog::OnChangeTileCellHeightEdit()
+ */
+
+void CPreferencesDialog::OnChangeTileCellHeightEdit() 
+{
+   m_iTileCellHeight =
+      GetDlgItemInt( IDC_TILE_CELL_HEIGHT_EDIT );
+
+   UpdateDialog();
+}
+
 /** 
  * CPreferencesDialog::OnFindButton()
  */
@@ -708,19 +867,17 @@ void CPreferencesDialog::OnChangeCascadeHeightEdit()
 void CPreferencesDialog::OnFindButton() 
 {		
    CPuTTYCSDialog* pDialog = (CPuTTYCSDialog*) GetParent();
-   CObArray* pWindows = pDialog->GetAllWindows();
+   const std::vector<WINDOWINFO>& vecWindows = pDialog->GetAllWindows();
 
    int iWidth = 0;
    int iHeight = 0;
 
-   for ( int loop = 0; loop < pWindows->GetSize(); loop++ )
+   for ( size_t loop = 0; loop < vecWindows.size(); loop++ )
    {
-      CWnd* pWnd = (CWnd*) pWindows->GetAt(loop);
-
-      if (pWnd->IsWindowVisible())
+      if (vecWindows[loop].iFlags & WINDOWSTATE_VISIBLE)
       {         
          CRect rect;
-         pWnd->GetClientRect(rect);
+         ::GetClientRect(CWin32WindowSystem::GetHwnd(vecWindows[loop].id), rect);
          
          int iWndWidth = rect.Width();
          int iWndHeight = rect.Height();
@@ -853,6 +1010,42 @@ void CPreferencesDialog::OnChangePostSendDelay()
    UpdateDialog();
 }
 
+/**
+ * CPreferencesDialog::OnAutoTuneCheckbox()
+ */ 
+
+void CPreferencesDialog::OnAutoTuneCheckbox() 
+{
+   m_iAutoTuneDelays =
+      IsDlgButtonChecked( IDC_AUTOTUNE_CHECKBOX );
+
+   UpdateDialog();
+}
+
+/**
+ * CPreferencesDialog::OnChangeAutoTuneMin()
+ */ 
+
+void CPreferencesDialog::OnChangeAutoTuneMin() 
+{
+   m_iAutoTuneMin =
+      GetDlgItemInt( IDC_AUTOTUNE_MIN_EDIT );
+
+   UpdateDialog();
+}
+
+/**
+ * CPreferencesDialog::OnChangeAutoTuneMax()
+ */ 
+
+void CPreferencesDialog::OnChangeAutoTuneMax() 
+{
+   m_iAutoTuneMax =
+      GetDlgItemInt( IDC_AUTOTUNE_MAX_EDIT );
+
+   UpdateDialog();
+}
+
 /**
  * CPreferencesDialog::OnSavePasswordCheckbox()
  */ 
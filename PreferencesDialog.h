@@ -77,6 +77,12 @@ public:
    int getTileMethod(); 
    void setTileMethod( int iTileMethod );
 
+   int getTileCellWidth(); 
+   void setTileCellWidth( int iTileCellWidth );
+
+   int getTileCellHeight(); 
+   void setTileCellHeight( int iTileCellHeight );
+
    int getCascadeWidth(); 
    void setCascadeWidth( int iCascadeWidth );
 
@@ -113,6 +119,15 @@ public:
    int getPostSendDelay();
    void setPostSendDelay( int iPostSendDelay );
 
+   int getAutoTuneDelays();
+   void setAutoTuneDelays( int iAutoTuneDelays );
+
+   int getAutoTuneMin();
+   void setAutoTuneMin( int iAutoTuneMin );
+
+   int getAutoTuneMax();
+   void setAutoTuneMax( int iAutoTuneMax );
+
    int getSavePassword();
    void setSavePassword( int iSavePassword );   
  
@@ -138,6 +153,9 @@ protected:
 
    int m_iTileMethod;
 
+   int m_iTileCellWidth;
+   int m_iTileCellHeight;
+
    int m_iCascadeWidth;
    int m_iCascadeHeight;
    
@@ -153,6 +171,10 @@ protected:
 
    int m_iTransition; 
    int m_iPostSendDelay; 
+
+   int m_iAutoTuneDelays;
+   int m_iAutoTuneMin;
+   int m_iAutoTuneMax;
    
    int m_iSavePassword;   
    int m_iRunOnSystemStartup;
@@ -173,6 +195,9 @@ protected:
    afx_msg void OnTabCompletionCheckbox();
    afx_msg void OnChangeTransition();
    afx_msg void OnChangePostSendDelay();
+   afx_msg void OnAutoTuneCheckbox();
+   afx_msg void OnChangeAutoTuneMin();
+   afx_msg void OnChangeAutoTuneMax();
    afx_msg void OnSavePasswordCheckbox();      
    afx_msg void OnCheckForUpdatesCheckbox();
 	afx_msg void OnRunOnSystemStartupCheckbox();
@@ -182,6 +207,8 @@ protected:
 	afx_msg void OnHScroll(UINT nSBCode, UINT nPos, CScrollBar* pScrollBar);
 	afx_msg void OnChangeCascadeHeightEdit();
 	afx_msg void OnChangeCascadeWidthEdit();
+   afx_msg void OnChangeTileCellWidthEdit();
+   afx_msg void OnChangeTileCellHeightEdit();
    afx_msg void OnFindButton();
 	//}}AFX_MSG
    DECLARE_MESSAGE_MAP()
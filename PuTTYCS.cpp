@@ -61,6 +61,8 @@ END_MESSAGE_MAP()
 
 CPuTTYCSApp::CPuTTYCSApp()
 {
+   m_bHeadless = false;
+   m_iExitCode = PUTTYCS_EXIT_SUCCESS;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -90,6 +92,23 @@ BOOL CPuTTYCSApp::InitInstance()
    g_pSetLayeredWindowAttributes = 
       (lpfn) GetProcAddress(hUser32, "SetLayeredWindowAttributes");
 
+   /**
+    * Headless send, no dialog or running instance involved
+    */
+
+   int iArgc;  
+   LPTSTR* pArgv = CommandLineToArgv(GetCommandLine(), &iArgc);
+
+   if ( pArgv && IsHeadless(iArgc, pArgv) )
+   {
+      m_bHeadless = true;
+      m_iExitCode = RunHeadless(iArgc, pArgv);
+
+      LocalFree(pArgv);
+
+      return FALSE;
+   }
+
    WNDCLASS wndcls;
    memset( &wndcls, 0, sizeof(WNDCLASS) );
    wndcls.style = CS_DBLCLKS | CS_SAVEBITS;
@@ -109,7 +128,11 @@ BOOL CPuTTYCSApp::InitInstance()
 
       CWnd* pAppWnd = CWnd::FindWindow( PUTTYCS_WND_CLASS, NULL );
 
-      if ( pAppWnd )
+      if ( pAppWnd && pArgv && ForwardToChannel(iArgc, pArgv) )
+      {
+         m_bHeadless = true;
+      }
+      else if ( pAppWnd )
       {                  
 		   COPYDATASTRUCT cds;        
          cds.dwData = PUTTYCS_WM_COPYDATA_CMD_LINE;
@@ -126,6 +149,400 @@ BOOL CPuTTYCSApp::InitInstance()
          dialog.DoModal();
       }
    }
+
+   if ( pArgv )
+   {
+      LocalFree(pArgv);
+   }
    
    return FALSE;
 }
+
+/**
+ * CPuTTYCSApp::ForwardToChannel()
+ *
+ * Hands -s/--script arguments to the running instance over its
+ * command channel, all requests pipelined on one connection. Returns
+ * false when the command line holds anything else or the channel is
+ * not available, the caller then falls back to WM_COPYDATA.
+ */
+
+bool CPuTTYCSApp::ForwardToChannel( int iArgc, LPTSTR* pArgv )
+{
+   CChannelBatch batch;
+
+   for ( int iArg = 1; iArg < iArgc; iArg += 2 )
+   {
+      if ( ((_tcscmp(pArgv[iArg], PUTTYCS_CMD_SCRIPT) != 0) &&
+            (_tcscmp(pArgv[iArg], PUTTYCS_CMD_SCRIPT_LONG) != 0)) ||
+           (iArg + 1 >= iArgc) )
+      {
+         return false;
+      }
+
+      /**
+       * The running instance has its own working directory
+       */
+
+      TCHAR szPath[MAX_PATH];
+
+      if ( !::GetFullPathName(pArgv[iArg + 1], MAX_PATH, szPath, NULL) )
+      {
+         return false;
+      }
+
+      CHANNELREQUEST request;
+      request.csId.Format( _T("%d"), batch.GetSize() + 1 );
+      request.csVerb = PUTTYCS_CHANNEL_VERB_SCRIPT;
+      request.csBody = szPath;
+      request.iWindows = 0;
+      request.dElapsedMs = 0.0;
+
+      batch.Add( request );
+   }
+
+   if ( batch.GetSize() == 0 )
+   {
+      return false;
+   }
+
+   HANDLE hPipe = CCommandChannel::Connect( PUTTYCS_CHANNEL_CONNECT_TIMEOUT );
+
+   if ( hPipe == INVALID_HANDLE_VALUE )
+   {
+      return false;
+   }
+
+   bool bWritten = true;
+
+   for ( int iLoop = 0; bWritten && (iLoop < batch.GetSize()); iLoop++ )
+   {
+      bWritten = 
+         CCommandChannel::WriteFrame( hPipe, CCommandChannel::FormatRequest(batch.GetAt(iLoop)) );
+   }
+
+   m_iExitCode = bWritten ? PUTTYCS_EXIT_SUCCESS : PUTTYCS_EXIT_SEND_FAILED;
+
+   for ( int iLoop = 0; bWritten && (iLoop < batch.GetSize()); iLoop++ )
+   {
+      std::string sReply;
+      CHANNELREQUEST reply;
+
+      if ( !CCommandChannel::ReadFrame(hPipe, sReply) ||
+           !CCommandChannel::ParseReply(sReply, reply) )
+      {
+         m_iExitCode = PUTTYCS_EXIT_SEND_FAILED;
+         break;
+      }
+
+      /**
+       * First failure wins
+       */
+
+      if ( (m_iExitCode == PUTTYCS_EXIT_SUCCESS) && 
+           (reply.csStatus != PUTTYCS_CHANNEL_STATUS_OK) )
+      {
+         m_iExitCode = (reply.csStatus == PUTTYCS_CHANNEL_STATUS_NO_WINDOWS) ?
+            PUTTYCS_EXIT_NO_WINDOWS : PUTTYCS_EXIT_SEND_FAILED;
+      }
+   }
+
+   ::CloseHandle( hPipe );
+
+   return true;
+}
+
+/**
+ * CPuTTYCSApp::ExitInstance()
+ */
+
+int CPuTTYCSApp::ExitInstance()
+{
+   int iResult = CWinApp::ExitInstance();
+
+   return m_bHeadless ? m_iExitCode : iResult;
+}
+
+/**
+ * CPuTTYCSApp::IsHeadless()
+ */
+
+bool CPuTTYCSApp::IsHeadless( int iArgc, LPTSTR* pArgv )
+{
+   for ( int iArg = 1; iArg < iArgc; iArg++ )
+   {
+      if ( _tcscmp(pArgv[iArg], PUTTYCS_CMD_SEND) == 0 )
+      {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * CPuTTYCSApp::GetOutputHandle()
+ *
+ * PuTTYCS is a GUI application, so unless the output was redirected
+ * it has no console. Attach to the console of the parent (cmd.exe,
+ * PowerShell) in that case.
+ */
+
+HANDLE CPuTTYCSApp::GetOutputHandle( DWORD dwStdHandle )
+{
+   HANDLE hOutput = ::GetStdHandle( dwStdHandle );
+
+   if ( (hOutput != NULL) && (hOutput != INVALID_HANDLE_VALUE) )
+   {
+      return hOutput;
+   }
+
+   if ( ::AttachConsole(ATTACH_PARENT_PROCESS) || 
+        (::GetLastError() == ERROR_ACCESS_DENIED) )
+   {
+      return ::CreateFile( _T("CONOUT$"), GENERIC_WRITE, FILE_SHARE_WRITE,
+         NULL, OPEN_EXISTING, 0, NULL );
+   }
+
+   return INVALID_HANDLE_VALUE;
+}
+
+/**
+ * CPuTTYCSApp::WriteOutput()
+ */
+
+void CPuTTYCSApp::WriteOutput( HANDLE hOutput, const CString& csText )
+{
+   WriteOutput( hOutput, CSendEngine::GetUtf8(csText) );
+}
+
+/**
+ * CPuTTYCSApp::WriteOutput()
+ */
+
+void CPuTTYCSApp::WriteOutput( HANDLE hOutput, const std::string& sText )
+{
+   if ( (hOutput == NULL) || (hOutput == INVALID_HANDLE_VALUE) )
+   {
+      return;
+   }
+
+   DWORD dwWritten = 0;
+   ::WriteFile( hOutput, sText.data(), (DWORD) sText.size(), &dwWritten, NULL );
+}
+
+/**
+ * CPuTTYCSApp::RunHeadless()
+ *
+ * puttycs --send <command> --filter <name> [--no-cr] [--json]
+ *
+ * <name> is the name of a saved filter, or a filter expression such
+ * as "+web*;-web3" when it starts with + or -. Returns the process
+ * exit code.
+ */
+
+int CPuTTYCSApp::RunHeadless( int iArgc, LPTSTR* pArgv )
+{
+   CString csCommand;
+   CString csFilter;
+   CString csError;
+
+   bool bSendCR = true;
+   bool bJson = false;
+
+   for ( int iArg = 1; iArg < iArgc; iArg++ )
+   {
+      if ( (_tcscmp(pArgv[iArg], PUTTYCS_CMD_SEND) == 0) || 
+           (_tcscmp(pArgv[iArg], PUTTYCS_CMD_FILTER) == 0) )
+      {
+         if ( (iArg + 1) >= iArgc )
+         {
+            csError.Format( PUTTYCS_HEADLESS_MISSING_ARGUMENT, pArgv[iArg] );
+         }
+         else if ( _tcscmp(pArgv[iArg], PUTTYCS_CMD_SEND) == 0 )
+         {
+            csCommand = pArgv[++iArg];
+         }
+         else
+         {
+            csFilter = pArgv[++iArg];
+         }
+      }
+      else if ( _tcscmp(pArgv[iArg], PUTTYCS_CMD_NO_CR) == 0 )
+      {
+         bSendCR = false;
+      }
+      else if ( _tcscmp(pArgv[iArg], PUTTYCS_CMD_JSON) == 0 )
+      {
+         bJson = true;
+      }
+      else
+      {
+         csError.Format( PUTTYCS_MESSAGEBOX_UNKNOWN_OPTION, pArgv[iArg] );
+      }
+   }
+
+   if ( csError.IsEmpty() && csFilter.IsEmpty() )
+   {
+      csError = PUTTYCS_HEADLESS_MISSING_FILTER;
+   }
+
+   /**
+    * Resolve the filter
+    */
+
+   CString csEntry;
+   CStringArray csaFilters;
+
+   if ( csError.IsEmpty() )
+   {
+      for ( int iLoop = 0;
+         iLoop < PUTTYCS_PREF_FILTER_MAX_SIZE; iLoop++ )
+      {     
+         CString csAttribute;
+         csAttribute.Format( PUTTYCS_PREF_FILTER_ENTRY, iLoop );
+
+         CString csValue =
+            GetProfileString( PUTTYCS_APP_NAME, csAttribute, PUTTYCS_EMPTY_STRING );
+
+         if ( !csValue.IsEmpty() )
+         {
+            csaFilters.Add( csValue );
+         }
+      }
+
+      if ( csaFilters.GetSize() == 0 )
+      {
+         csaFilters.Add( PUTTYCS_FILTER_ALL );
+      }
+
+      if ( !CSendEngine::ResolveFilter(csaFilters, csFilter, csEntry) )
+      {
+         csError.Format( PUTTYCS_HEADLESS_UNKNOWN_FILTER, (LPCTSTR) csFilter );
+      }
+   }
+
+   if ( !csError.IsEmpty() )
+   {
+      if ( bJson )
+      {
+         std::string sJson = "{\"exitCode\":2,\"error\":";
+         CSendTrace::AppendJsonString( sJson, CSendEngine::GetUtf8(csError) );
+         sJson += "}\n";
+
+         WriteOutput( GetOutputHandle(STD_OUTPUT_HANDLE), sJson );
+      }
+      else
+      {
+         WriteOutput( GetOutputHandle(STD_ERROR_HANDLE), csError + _T("\n") );
+      }
+
+      return PUTTYCS_EXIT_USAGE;
+   }
+
+   /**
+    * Send
+    */
+
+   CSendEngine engine;
+
+   engine.SetTransition( 
+      GetProfileInt(PUTTYCS_APP_NAME, PUTTYCS_PREF_WINDOW_TRANSITION, 25) );
+
+   engine.SetPostSendDelay( 
+      GetProfileInt(PUTTYCS_APP_NAME, PUTTYCS_PREF_POST_SEND_DELAY, 100) );
+
+   engine.SetSendCR( bSendCR ? 1 : 0 );
+   engine.SetFilters( csaFilters );
+   engine.SetInventory( 
+      GetProfileString(PUTTYCS_APP_NAME, PUTTYCS_PREF_INVENTORY_FILE, PUTTYCS_EMPTY_STRING) );
+
+   long long llStart = engine.GetSendTrace().Now();
+
+   CSendResultArray results;
+   engine.Send( csCommand, csEntry, false, true, &results );
+
+   double dElapsedMs = (engine.GetSendTrace().Now() - llStart) / 1000.0;
+
+   int iExitCode = PUTTYCS_EXIT_SUCCESS;
+
+   if ( results.GetSize() == 0 )
+   {
+      iExitCode = PUTTYCS_EXIT_NO_WINDOWS;
+   }
+
+   for ( int iLoop = 0; iLoop < results.GetSize(); iLoop++ )
+   {
+      if ( !results[iLoop].bForeground )
+      {
+         iExitCode = PUTTYCS_EXIT_SEND_FAILED;
+      }
+   }
+
+   /**
+    * Report
+    */
+
+   HANDLE hOutput = GetOutputHandle( STD_OUTPUT_HANDLE );
+
+   if ( bJson )
+   {
+      char szBuffer[256];
+
+      sprintf( szBuffer, "{\"exitCode\":%d,\"elapsedMs\":%.1f,\"filter\":", 
+         iExitCode, dElapsedMs );
+
+      std::string sJson = szBuffer;
+      CSendTrace::AppendJsonString( sJson, CSendEngine::GetUtf8(csFilter) );
+
+      sJson += ",\"windows\":[";
+
+      for ( int iLoop = 0; iLoop < results.GetSize(); iLoop++ )
+      {
+         const SENDRESULT& result = results[iLoop];
+
+         sprintf( szBuffer, "%s\n{\"hwnd\":\"0x%llx\",\"title\":", 
+            (iLoop > 0) ? "," : "", (unsigned long long) (UINT_PTR) result.hWnd );
+
+         sJson += szBuffer;
+         CSendTrace::AppendJsonString( sJson, CSendEngine::GetUtf8(result.csTitle) );
+
+         sprintf( szBuffer, 
+            ",\"status\":\"%s\",\"activateMs\":%.1f,\"transitionMs\":%.1f,\"sendMs\":%.1f,\"postSendMs\":%.1f,\"totalMs\":%.1f}",
+            result.bForeground ? "sent" : "not foreground",
+            result.dActivateMs, result.dTransitionMs, result.dSendMs, 
+            result.dPostSendMs, result.dTotalMs );
+
+         sJson += szBuffer;
+      }
+
+      sJson += "]}\n";
+
+      WriteOutput( hOutput, sJson );
+   }
+   else
+   {
+      for ( int iLoop = 0; iLoop < results.GetSize(); iLoop++ )
+      {
+         const SENDRESULT& result = results[iLoop];
+
+         CString csLine;
+         csLine.Format( PUTTYCS_HEADLESS_WINDOW, 
+            (LPCTSTR) result.csTitle,
+            result.bForeground ? PUTTYCS_HEADLESS_STATUS_SENT : PUTTYCS_HEADLESS_STATUS_NOT_FOREGROUND,
+            result.dTotalMs );
+
+         WriteOutput( hOutput, csLine );
+      }
+
+      if ( iExitCode == PUTTYCS_EXIT_NO_WINDOWS )
+      {
+         CString csMessage;
+         csMessage.Format( PUTTYCS_HEADLESS_NO_WINDOWS, (LPCTSTR) csFilter );
+
+         WriteOutput( GetOutputHandle(STD_ERROR_HANDLE), csMessage + _T("\n") );
+      }
+   }
+
+   return iExitCode;
+}
@@ -43,6 +43,8 @@
    #error include 'stdafx.h' before including this file for PCH
 #endif
 
+#include <string>
+
 #include "resource.h"      // main symbols
 
 /**
@@ -72,9 +74,25 @@ public:
    //{{AFX_VIRTUAL(CPuTTYCSApp)
    public:
    virtual BOOL InitInstance();
+   virtual int ExitInstance();
    //}}AFX_VIRTUAL
 
 // Implementation
+protected:
+
+   bool m_bHeadless;
+   int m_iExitCode;
+
+   static bool IsHeadless( int iArgc, LPTSTR* pArgv );
+   int RunHeadless( int iArgc, LPTSTR* pArgv );
+
+   bool ForwardToChannel( int iArgc, LPTSTR* pArgv );
+
+   static HANDLE GetOutputHandle( DWORD dwStdHandle );
+   static void WriteOutput( HANDLE hOutput, const CString& csText );
+   static void WriteOutput( HANDLE hOutput, const std::string& sText );
+
+public:
 
    //{{AFX_MSG(CPuTTYCSApp)
       // NOTE - the ClassWizard will add and remove member functions here.
@@ -71,6 +71,10 @@
 #include "FiltersDialog.h"
 #include "AboutDialog.h"
 #include "Base64.h"
+#include "KeyProgramCache.h"
+#include "TileLayout.h"
+#include "WindowActions.h"
+#include "WindowWait.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -83,7 +87,8 @@ static char THIS_FILE[] = __FILE__;
  */
 
 CPuTTYCSDialog::CPuTTYCSDialog(CWnd* pParent /*=NULL*/)
-   : CDialog(CPuTTYCSDialog::IDD, pParent)
+   : CDialog(CPuTTYCSDialog::IDD, pParent),
+     m_slSessionLauncher(&m_psProcessSpawner, &m_seSendEngine.GetBroadcastEngine())
 {      
    //{{AFX_DATA_INIT(CPuTTYCSDialog)
    //}}AFX_DATA_INIT
@@ -94,20 +99,9 @@ CPuTTYCSDialog::CPuTTYCSDialog(CWnd* pParent /*=NULL*/)
     * Fonts
     */
 
-   m_pMarlettNormal = new CFont();
-
-   m_pMarlettNormal->CreatePointFont( 
-      100, PUTTYCS_FONT_MARLETT );
-
-   m_pMarlettSmall = new CFont();
-
-   m_pMarlettSmall->CreatePointFont(
-      80, PUTTYCS_FONT_MARLETT );
-
-   m_pSymbolSmall = new CFont();
-
-   m_pSymbolSmall->CreatePointFont(
-      70, PUTTYCS_FONT_SYMBOL );
+   m_pMarlettNormal = NULL;
+   m_pMarlettSmall = NULL;
+   m_pSymbolSmall = NULL;
 
    /**
     * Taskbar Notification Icon
@@ -121,11 +115,22 @@ CPuTTYCSDialog::CPuTTYCSDialog(CWnd* pParent /*=NULL*/)
     * Context Menu
     */
 
-   m_pMenu = new CMenu();
+   m_pMenu = NULL;
+
+   m_sqSendQueue.SetCapacity( PUTTYCS_SEND_QUEUE_CAPACITY );
 
-   m_pMenu->LoadMenu( IDM_SYSTRAY_MENU );
+   m_bLaunchInteractive = false;
+
+   m_hLayoutMenu = NULL;
 
    m_bDisablePopup = FALSE;   
+   m_bUpdateInteractive = false;
+
+   m_bCmdHistoryLoaded = false;
+   m_bFiltersFilled = false;
+
+   m_spStartupProfile.SetTrace( &m_seSendEngine.GetSendTrace() );
+   m_spStartupProfile.Mark( "constructor" );
 }
 
 /**
@@ -177,6 +182,67 @@ CPuTTYCSDialog::~CPuTTYCSDialog()
    }
 }
 
+/**
+ * CPuTTYCSDialog::CreateLazyFont()
+ */
+
+CFont* CPuTTYCSDialog::CreateLazyFont( CFont*& pFont, int iPointSize, LPCTSTR lpszFaceName )
+{
+   if ( !pFont )
+   {
+      pFont = new CFont();
+
+      pFont->CreatePointFont( iPointSize, lpszFaceName );
+   }
+
+   return pFont;
+}
+
+/**
+ * CPuTTYCSDialog::GetMarlettNormalFont()
+ */
+
+CFont* CPuTTYCSDialog::GetMarlettNormalFont()
+{
+   return CreateLazyFont( m_pMarlettNormal, 100, PUTTYCS_FONT_MARLETT );
+}
+
+/**
+ * CPuTTYCSDialog::GetMarlettSmallFont()
+ */
+
+CFont* CPuTTYCSDialog::GetMarlettSmallFont()
+{
+   return CreateLazyFont( m_pMarlettSmall, 80, PUTTYCS_FONT_MARLETT );
+}
+
+/**
+ * CPuTTYCSDialog::GetSymbolSmallFont()
+ */
+
+CFont* CPuTTYCSDialog::GetSymbolSmallFont()
+{
+   return CreateLazyFont( m_pSymbolSmall, 70, PUTTYCS_FONT_SYMBOL );
+}
+
+/**
+ * CPuTTYCSDialog::GetTrayMenu()
+ *
+ * Loaded on the first right click of the tray icon
+ */
+
+CMenu* CPuTTYCSDialog::GetTrayMenu()
+{
+   if ( !m_pMenu )
+   {
+      m_pMenu = new CMenu();
+
+      m_pMenu->LoadMenu( IDM_SYSTRAY_MENU );
+   }
+
+   return m_pMenu;
+}
+
 /**
  * LoadPreferences()
  */
@@ -187,6 +253,10 @@ void CPuTTYCSDialog::LoadPreferences()
     * PuTTY filters
     */ 
 
+   CMapStringToString mapValues;
+
+   bool bSection = ReadProfileSection( mapValues );
+
    m_csaFilters.RemoveAll();
 
    for ( int iLoop = 0;
@@ -196,10 +266,7 @@ void CPuTTYCSDialog::LoadPreferences()
       csAttribute.Format( PUTTYCS_PREF_FILTER_ENTRY, iLoop );
 
       CString csValue =
-         AfxGetApp()->GetProfileString( 
-            PUTTYCS_APP_NAME, 
-            csAttribute,
-            PUTTYCS_EMPTY_STRING );
+         GetProfileValue( bSection ? &mapValues : NULL, csAttribute );
 
       if ( !csValue.IsEmpty() )
       {
@@ -226,31 +293,37 @@ void CPuTTYCSDialog::LoadPreferences()
       }
    }
 
+   m_seSendEngine.SetFilters( m_csaFilters );
+
    /**
-    * Command history
-    */ 
+    * Window layouts
+    */
 
-   m_csaCmdHistory.RemoveAll();
+   m_csaSnapshots.RemoveAll();
 
    for ( int iLoop = 0;
-      iLoop < PUTTYCS_PREF_CMDHISTORY_MAX_SIZE; iLoop++ )
-   {  
+      iLoop < PUTTYCS_PREF_SNAPSHOT_MAX_SIZE; iLoop++ )
+   {     
       CString csAttribute;
-      csAttribute.Format( PUTTYCS_PREF_CMDHISTORY_ENTRY, iLoop );
+      csAttribute.Format( PUTTYCS_PREF_SNAPSHOT_ENTRY, iLoop );
 
       CString csValue =
-        AfxGetApp()->GetProfileString( 
-           PUTTYCS_APP_NAME, 
-           csAttribute, 
-           PUTTYCS_EMPTY_STRING );
+         GetProfileValue( bSection ? &mapValues : NULL, csAttribute );
 
-      if ( !csValue.IsEmpty() )
+      if ( !CSendEngine::GetSnapshotName(csValue).IsEmpty() )
       {
-         m_csaCmdHistory.Add( csValue );
+         m_csaSnapshots.Add( csValue );
       }
    }
 
-   m_iCmdHistory = m_csaCmdHistory.GetSize();    
+   /**
+    * Command history is loaded on first use [see LoadCmdHistory()]
+    */ 
+
+   m_csaCmdHistory.RemoveAll();
+   m_iCmdHistory = 0;
+
+   m_bCmdHistoryLoaded = false;
 
    /**
     * Window settings
@@ -301,6 +374,14 @@ void CPuTTYCSDialog::LoadPreferences()
       AfxGetApp()->GetProfileInt(
          PUTTYCS_APP_NAME, PUTTYCS_PREF_TILE_METHOD, PUTTYCS_TILE_METHOD_DEFAULT );
 
+   m_iTileCellWidth = 
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_TILE_CELL_WIDTH, PUTTYCS_TILE_CELL_DEFAULT_WIDTH );
+
+   m_iTileCellHeight = 
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_TILE_CELL_HEIGHT, PUTTYCS_TILE_CELL_DEFAULT_HEIGHT );
+
    /**
     * Cascade dimensions
     */   
@@ -379,6 +460,71 @@ void CPuTTYCSDialog::LoadPreferences()
    m_iPostSendDelay =
       AfxGetApp()->GetProfileInt(
          PUTTYCS_APP_NAME, PUTTYCS_PREF_POST_SEND_DELAY, 100 );
+
+   m_iAutoTuneDelays =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_AUTO_TUNE_DELAYS, 1 );
+
+   m_iAutoTuneMin =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_AUTO_TUNE_MIN, 5 );
+
+   m_iAutoTuneMax =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_AUTO_TUNE_MAX, 1000 );
+
+   m_seSendEngine.GetDelayTuner().SetEnabled( m_iAutoTuneDelays ? true : false );
+   m_seSendEngine.GetDelayTuner().SetBounds( m_iAutoTuneMin, m_iAutoTuneMax );
+
+   /**
+    * Script pacing
+    */
+
+   m_csScriptPrompt =
+      AfxGetApp()->GetProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_SCRIPT_PROMPT, PUTTYCS_EMPTY_STRING );
+
+   m_iScriptLineTimeout =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_SCRIPT_LINE_TIMEOUT, PUTTYCS_SCRIPT_LINE_TIMEOUT_DEFAULT );
+
+   m_csSessionLog =
+      AfxGetApp()->GetProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_SESSION_LOG, PUTTYCS_EMPTY_STRING );
+
+   m_iScriptCache =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_SCRIPT_CACHE, 1 );
+
+   /**
+    * Per-host variables
+    */
+
+   m_csInventoryFile =
+      AfxGetApp()->GetProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_INVENTORY_FILE, PUTTYCS_EMPTY_STRING );
+
+   m_seSendEngine.SetInventory( m_csInventoryFile );
+
+   /**
+    * Session launcher
+    */
+
+   m_csLaunchCommand =
+      AfxGetApp()->GetProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LAUNCH_COMMAND, PUTTYCS_LAUNCH_COMMAND_DEFAULT );
+
+   m_iLaunchConcurrency =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LAUNCH_CONCURRENCY, PUTTYCS_LAUNCH_CONCURRENCY_DEFAULT );
+
+   m_iLaunchRate =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LAUNCH_RATE, PUTTYCS_LAUNCH_RATE_DEFAULT );
+
+   m_iLaunchWindowTimeout =
+      AfxGetApp()->GetProfileInt(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LAUNCH_WINDOW_TIMEOUT, PUTTYCS_LAUNCH_WINDOW_TIMEOUT_DEFAULT );
  
 }
 
@@ -412,11 +558,11 @@ void CPuTTYCSDialog::SavePreferences()
       PUTTYCS_APP_NAME, PUTTYCS_PREF_FILTER, m_iFilter );
 
    /**
-    * Command history
+    * Command history, untouched if never loaded
     */ 
 
-   for ( int iLoop = 0;
-      iLoop < PUTTYCS_PREF_CMDHISTORY_MAX_SIZE; iLoop++ )
+   for ( int iLoop = 0; m_bCmdHistoryLoaded &&
+      (iLoop < PUTTYCS_PREF_CMDHISTORY_MAX_SIZE); iLoop++ )
    {
       CString csAttribute;
       csAttribute.Format( PUTTYCS_PREF_CMDHISTORY_ENTRY, iLoop );
@@ -472,6 +618,12 @@ void CPuTTYCSDialog::SavePreferences()
    AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME,
       PUTTYCS_PREF_TILE_METHOD, m_iTileMethod );
 
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME,
+      PUTTYCS_PREF_TILE_CELL_WIDTH, m_iTileCellWidth );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME,
+      PUTTYCS_PREF_TILE_CELL_HEIGHT, m_iTileCellHeight );
+
    /**
     * Cascade dimensions
     */
@@ -537,6 +689,46 @@ void CPuTTYCSDialog::SavePreferences()
 
    AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
       PUTTYCS_PREF_POST_SEND_DELAY, m_iPostSendDelay );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_AUTO_TUNE_DELAYS, m_iAutoTuneDelays );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_AUTO_TUNE_MIN, m_iAutoTuneMin );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_AUTO_TUNE_MAX, m_iAutoTuneMax );
+
+   /**
+    * Script pacing
+    */
+
+   AfxGetApp()->WriteProfileString( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_SCRIPT_PROMPT, m_csScriptPrompt );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_SCRIPT_LINE_TIMEOUT, m_iScriptLineTimeout );
+
+   AfxGetApp()->WriteProfileString( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_SESSION_LOG, m_csSessionLog );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_SCRIPT_CACHE, m_iScriptCache );
+
+   AfxGetApp()->WriteProfileString( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_INVENTORY_FILE, m_csInventoryFile );
+
+   AfxGetApp()->WriteProfileString( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_LAUNCH_COMMAND, m_csLaunchCommand );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_LAUNCH_CONCURRENCY, m_iLaunchConcurrency );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_LAUNCH_RATE, m_iLaunchRate );
+
+   AfxGetApp()->WriteProfileInt( PUTTYCS_APP_NAME, 
+      PUTTYCS_PREF_LAUNCH_WINDOW_TIMEOUT, m_iLaunchWindowTimeout );
 }
 
 /**
@@ -565,6 +757,7 @@ BEGIN_MESSAGE_MAP(CPuTTYCSDialog, CDialog)
    ON_BN_CLICKED(IDC_HIDE_BUTTON, OnHideButton)
    ON_BN_CLICKED(IDC_FILTERS_BUTTON, OnFiltersButton)
    ON_BN_CLICKED(IDC_SENDCR_PUSHBUTTON, OnSendCRPushButton)   
+   ON_BN_CLICKED(IDC_LIVE_PUSHBUTTON, OnLivePushButton)
    ON_BN_CLICKED(IDC_CMDHISTORYUP_BUTTON, OnCmdHistoryUpButton)
    ON_BN_CLICKED(IDC_CMDHISTORYDOWN_BUTTON, OnCmdHistoryDownButton)
    ON_BN_CLICKED(IDC_UP_BUTTON, OnUpButton)
@@ -599,6 +792,12 @@ BEGIN_MESSAGE_MAP(CPuTTYCSDialog, CDialog)
    ON_COMMAND(IDMI_SYSTRAYPREFERENCES_MENUITEM, OnPreferencesButton)   
    ON_COMMAND(IDMI_SYSTRAYEXIT_MENUITEM, OnOK)   	
 	ON_WM_COPYDATA()
+   ON_MESSAGE(WM_USER_CHANNEL_BATCH, OnChannelBatch)
+   ON_MESSAGE(WM_USER_UPDATE_CHECKED, OnUpdateChecked)
+   ON_MESSAGE(WM_USER_DEFERRED_INIT, OnDeferredInit)
+   ON_CBN_DROPDOWN(IDC_FILTERS_COMBOBOX, OnDropDownFiltersCombobox)
+   ON_CBN_SETFOCUS(IDC_FILTERS_COMBOBOX, OnDropDownFiltersCombobox)
+   ON_WM_TIMER()
 	//}}AFX_MSG_MAP
 END_MESSAGE_MAP()
 
@@ -665,6 +864,19 @@ LRESULT CPuTTYCSDialog::WindowProc(UINT message, WPARAM wParam, LPARAM lParam)
 
 BOOL CPuTTYCSDialog::PreTranslateMessage(MSG* pMsg) 
 {
+   /**
+    * In live mode the keys typed into the command edit go to the
+    * PuTTY windows before Esc, Tab and Enter get their dialog meaning
+    */
+
+   if ( m_kmKeyMirror.IsActive() && (pMsg->hwnd == m_cceCommandEdit.GetSafeHwnd()) )
+   {
+      if ( m_kmKeyMirror.Forward(pMsg) )
+      {
+         return TRUE;
+      }
+   }
+
    if ( pMsg->message == WM_KEYDOWN )
    {
       if ( pMsg->wParam == VK_ESCAPE )
@@ -718,25 +930,36 @@ BOOL CPuTTYCSDialog::DestroyWindow()
 {
    m_bIsClosing = true;
 
+   m_ccCommandChannel.Stop();
+   m_ucUpdateCheck.Stop();
+
+   if ( m_kmKeyMirror.IsActive() )
+   {
+      KillTimer( PUTTYCS_TIMER_LIVE );
+
+      m_kmKeyMirror.Stop();
+   }
+
+   KillTimer( PUTTYCS_TIMER_SEND_QUEUE );
+
+   m_sqSendQueue.Clear();
+
+   KillTimer( PUTTYCS_TIMER_LAUNCH );
+
+   m_slSessionLauncher.Cancel();
+
    if ( m_iUnhideOnExit )
    {
-      m_obaWindows.RemoveAll();
+      FindWindows( PUTTYCS_FILTER_ALL, false );
 
-      ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-      SortWindows();
+      CWindowActions::Show( m_vecWindows );
+   }
 
-      for ( int iLoop = 0;
-         iLoop < m_obaWindows.GetSize(); iLoop++ )
-      {
-         CWnd* pWnd =
-            (CWnd*) m_obaWindows.GetAt( iLoop );
-             
-         if ( !pWnd->IsWindowVisible() )
-         { 
-            pWnd->ShowWindow( SW_SHOW );
-         }
-      }
+   ::OutputDebugString( CWindowWait::GetSummary() );
+
+   if ( !m_csTraceFile.IsEmpty() )
+   {
+      ExportTrace( m_csTraceFile );
    }
 	
 	return CDialog::DestroyWindow();
@@ -769,7 +992,6 @@ BOOL CPuTTYCSDialog::OnInitDialog()
    SetIcon(m_hIcon, FALSE);
     
    m_bIsClosing = false;
-   m_bFindAll = false;
 
    /**
     * Preferences
@@ -777,6 +999,8 @@ BOOL CPuTTYCSDialog::OnInitDialog()
 
    LoadPreferences();
 
+   m_spStartupProfile.Mark( "preferences" );
+
    /**
     * Check for updates
     */
@@ -787,53 +1011,19 @@ BOOL CPuTTYCSDialog::OnInitDialog()
    }
 
    /**
-    * PuTTY filters
+    * PuTTY filters, only the selected one until the list is
+    * needed [see FillFiltersCombobox()]
     */
 
-   for ( int iLoop = 0; iLoop < m_csaFilters.GetSize(); iLoop++ )
-   {
-      CString csFilter = m_csaFilters.GetAt(iLoop);
+   CString csFilter = m_csaFilters.GetAt( m_iFilter );
 
-      ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
-         AddString(csFilter.Mid(0, 
-            csFilter.Find( PUTTYCS_FILTER_NAME_SEPARATOR)) );
-   }
+   ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
+      AddString(csFilter.Mid(0, 
+         csFilter.Find( PUTTYCS_FILTER_NAME_SEPARATOR)) );
 
    ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
-      SetCurSel( m_iFilter );            
+      SetCurSel( 0 );            
          
-   /**
-    * Arrows
-    */
-
-   ((CButton*) GetDlgItem(IDC_CMDHISTORYUP_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   ((CButton*) GetDlgItem(IDC_CMDHISTORYDOWN_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   ((CButton*) GetDlgItem(IDC_CMDHISTORYCLEAR_BUTTON))->
-      SetFont( m_pMarlettSmall );
-   
-   ((CButton*) GetDlgItem(IDC_UP_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   ((CButton*) GetDlgItem(IDC_DOWN_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   ((CButton*) GetDlgItem(IDC_LEFT_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   ((CButton*) GetDlgItem(IDC_RIGHT_BUTTON))->
-      SetFont( m_pMarlettNormal );
-
-   /**
-    * Clear button
-    */
-
-   ((CButton*) GetDlgItem(IDC_CLEAR_BUTTON))->
-      SetFont( m_pMarlettSmall );
-
    /**
     * Command edit
     */
@@ -846,9 +1036,6 @@ BOOL CPuTTYCSDialog::OnInitDialog()
     * Send CR
     */
 
-   ((CButton*) GetDlgItem(IDC_SENDCR_PUSHBUTTON))->
-      SetFont( m_pSymbolSmall );
-   
    ((CButton*) GetDlgItem(IDC_SENDCR_PUSHBUTTON))->
       SetCheck( m_iSendCR );
 
@@ -864,6 +1051,25 @@ BOOL CPuTTYCSDialog::OnInitDialog()
 
       pMenu->AppendMenu( MF_SEPARATOR );
 
+      pMenu->AppendMenu( MF_STRING,
+         IDM_LAUNCH_SESSIONS, PUTTYCS_WINDOW_TITLE_LAUNCH_SESSIONS );
+
+      pMenu->AppendMenu( MF_STRING,
+         IDM_SAVE_LAYOUT, PUTTYCS_WINDOW_TITLE_SAVE_LAYOUT );
+
+      m_hLayoutMenu = ::CreatePopupMenu();
+
+      pMenu->AppendMenu( MF_POPUP,
+         (UINT_PTR) m_hLayoutMenu, PUTTYCS_WINDOW_TITLE_RESTORE_LAYOUT );
+
+      UpdateLayoutMenu();
+
+      pMenu->AppendMenu( MF_STRING,
+         IDM_EXPORT_TRACE, PUTTYCS_WINDOW_TITLE_EXPORT_TRACE );
+
+      pMenu->AppendMenu( MF_STRING,
+         IDM_WAIT_STATS, PUTTYCS_WINDOW_TITLE_WAIT_STATS );
+
       pMenu->AppendMenu( MF_STRING,
          IDM_ABOUT_PUTTYCS, PUTTYCS_WINDOW_TITLE_ABOUT );
    }
@@ -877,15 +1083,8 @@ BOOL CPuTTYCSDialog::OnInitDialog()
 
    m_iDialogHeight = dialogRect.Height();
 
-   /**
-    * Auto arrange
-    */
+   m_spStartupProfile.Mark( "controls" );
 
-   if ( m_iArrangeOnStartup )
-   {
-      OnSelChangeFiltersCombobox();
-   }
-   
    /**
     * Minimize to SysTray
     */
@@ -901,60 +1100,389 @@ BOOL CPuTTYCSDialog::OnInitDialog()
 
    UpdateDialog();
 
+   /**
+    * Command channel for later instances and job runners
+    */
+
+   m_ccCommandChannel.Start( m_hWnd );
+
    /**
     * Parse command line options
     */
 
    ParseCmdLineOptions();
 
-   return TRUE;
-}
+   /**
+    * Button fonts, history, filter list and auto arrange after the
+    * first paint
+    */
 
-/**
- * CPuTTYCSDialog::OnSysCommand()
- */
+   PostMessage( WM_USER_DEFERRED_INIT );
 
-void CPuTTYCSDialog::OnSysCommand(UINT nID, LPARAM lParam)
-{
-   UINT nCmd = (nID & 0xFFF0);
+   m_spStartupProfile.Mark( "init dialog" );
 
-   if ( nCmd == IDM_ABOUT_PUTTYCS )
-   {
-      OnAboutButton();
-   }
-   else 
-   {
-      if ( (m_iMinimizeToSysTray) &&
-           ((nCmd == SC_MINIMIZE)     
-         || (nCmd == SC_CLOSE)) )
-      {
-         ShowWindow( SW_HIDE );
-         SetSysTrayTip( PUTTYCS_WINDOW_TITLE_APP );
-      }
-      else
-      {
-         CDialog::OnSysCommand(nID, lParam);
-      }
-   } 
+   return TRUE;
 }
 
 /**
- * CPuTTYCSDialog::OnPaint()
+ * CPuTTYCSDialog::OnDeferredInit()
  */
 
-void CPuTTYCSDialog::OnPaint() 
+LRESULT CPuTTYCSDialog::OnDeferredInit(WPARAM wParam, LPARAM lParam) 
 {
-   if (IsIconic())
-   {
-      CPaintDC dc(this); // device context for painting
+   /**
+    * Arrows
+    */
 
-      SendMessage(WM_ICONERASEBKGND, (WPARAM) dc.GetSafeHdc(), 0);
+   ((CButton*) GetDlgItem(IDC_CMDHISTORYUP_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
 
-      int cxIcon = GetSystemMetrics(SM_CXICON);
-      int cyIcon = GetSystemMetrics(SM_CYICON);
+   ((CButton*) GetDlgItem(IDC_CMDHISTORYDOWN_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
 
-      CRect rect;
-      GetClientRect(&rect);
+   ((CButton*) GetDlgItem(IDC_CMDHISTORYCLEAR_BUTTON))->
+      SetFont( GetMarlettSmallFont() );
+   
+   ((CButton*) GetDlgItem(IDC_UP_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
+
+   ((CButton*) GetDlgItem(IDC_DOWN_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
+
+   ((CButton*) GetDlgItem(IDC_LEFT_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
+
+   ((CButton*) GetDlgItem(IDC_RIGHT_BUTTON))->
+      SetFont( GetMarlettNormalFont() );
+
+   /**
+    * Clear button
+    */
+
+   ((CButton*) GetDlgItem(IDC_CLEAR_BUTTON))->
+      SetFont( GetMarlettSmallFont() );
+
+   /**
+    * Send CR
+    */
+
+   ((CButton*) GetDlgItem(IDC_SENDCR_PUSHBUTTON))->
+      SetFont( GetSymbolSmallFont() );
+
+   LoadCmdHistory();
+   UpdateCmdHistoryButtons();
+
+   FillFiltersCombobox();
+
+   if ( m_iArrangeOnStartup )
+   {
+      OnSelChangeFiltersCombobox();
+   }
+
+   return TRUE;
+}
+
+/**
+ * CPuTTYCSDialog::LoadCmdHistory()
+ */
+
+void CPuTTYCSDialog::LoadCmdHistory()
+{
+   if ( m_bCmdHistoryLoaded )
+   {
+      return;
+   }
+
+   CMapStringToString mapValues;
+
+   bool bSection = ReadProfileSection( mapValues );
+
+   m_csaCmdHistory.RemoveAll();
+
+   for ( int iLoop = 0;
+      iLoop < PUTTYCS_PREF_CMDHISTORY_MAX_SIZE; iLoop++ )
+   {  
+      CString csAttribute;
+      csAttribute.Format( PUTTYCS_PREF_CMDHISTORY_ENTRY, iLoop );
+
+      CString csValue =
+         GetProfileValue( bSection ? &mapValues : NULL, csAttribute );
+
+      if ( !csValue.IsEmpty() )
+      {
+         m_csaCmdHistory.Add( csValue );
+      }
+   }
+
+   m_iCmdHistory = m_csaCmdHistory.GetSize();    
+
+   m_bCmdHistoryLoaded = true;
+}
+
+/**
+ * CPuTTYCSDialog::FillFiltersCombobox()
+ */
+
+void CPuTTYCSDialog::FillFiltersCombobox()
+{
+   CComboBox* pCombobox = 
+      (CComboBox*) GetDlgItem( IDC_FILTERS_COMBOBOX );
+
+   pCombobox->ResetContent();
+
+   for ( int iLoop = 0; iLoop < m_csaFilters.GetSize(); iLoop++ )
+   {
+      CString csFilter = m_csaFilters.GetAt(iLoop);
+
+      pCombobox->AddString(csFilter.Mid(0, 
+         csFilter.Find( PUTTYCS_FILTER_NAME_SEPARATOR)) );
+   }
+
+   pCombobox->SetCurSel( m_iFilter );            
+
+   m_bFiltersFilled = true;
+}
+
+/**
+ * CPuTTYCSDialog::OnDropDownFiltersCombobox()
+ */
+
+void CPuTTYCSDialog::OnDropDownFiltersCombobox()
+{
+   if ( !m_bFiltersFilled )
+   {
+      FillFiltersCombobox();
+   }
+}
+
+/**
+ * CPuTTYCSDialog::ReadProfileSection()
+ *
+ * Reads the whole PuTTYCS section of the INI file at once, instead
+ * of one file read per GetProfileString(). Returns false if the
+ * settings are kept in the registry.
+ */
+
+bool CPuTTYCSDialog::ReadProfileSection( CMapStringToString& mapValues )
+{
+   CWinApp* pApp = AfxGetApp();
+
+   if ( pApp->m_pszRegistryKey || !pApp->m_pszProfileName )
+   {
+      return false;
+   }
+
+   DWORD dwSize = PUTTYCS_PROFILE_SECTION_SIZE;
+
+   while ( true )
+   {
+      CString csSection;
+
+      LPTSTR pszSection = csSection.GetBuffer( dwSize );
+
+      DWORD dwRead = ::GetPrivateProfileSection( 
+         PUTTYCS_APP_NAME, pszSection, dwSize, pApp->m_pszProfileName );
+
+      if ( (dwRead == dwSize - 2) && (dwSize < PUTTYCS_PROFILE_SECTION_MAX_SIZE) )
+      {
+         csSection.ReleaseBuffer( 0 );
+         dwSize *= 2;
+
+         continue;
+      }
+
+      /**
+       * key=value pairs, each NUL terminated
+       */
+
+      for ( LPCTSTR pszEntry = pszSection; *pszEntry; pszEntry += _tcslen(pszEntry) + 1 )
+      {
+         CString csEntry = pszEntry;
+
+         int iEquals = csEntry.Find( _T('=') );
+
+         if ( iEquals > 0 )
+         {
+            CString csKey = csEntry.Left( iEquals );
+            CString csValue = csEntry.Mid( iEquals + 1 );
+
+            csKey.TrimRight();
+            csKey.MakeLower();
+
+            csValue.TrimLeft();
+            csValue.TrimRight();
+
+            /**
+             * GetProfileString() drops surrounding quotes
+             */
+
+            if ( (csValue.GetLength() >= 2) && 
+                 (csValue[0] == _T('"')) && (csValue[csValue.GetLength() - 1] == _T('"')) )
+            {
+               csValue = csValue.Mid( 1, csValue.GetLength() - 2 );
+            }
+
+            mapValues.SetAt( csKey, csValue );
+         }
+      }
+
+      csSection.ReleaseBuffer( 0 );
+
+      return true;
+   }
+}
+
+/**
+ * CPuTTYCSDialog::GetProfileValue()
+ */
+
+CString CPuTTYCSDialog::GetProfileValue( const CMapStringToString* pValues, CString csKey )
+{
+   if ( !pValues )
+   {
+      return AfxGetApp()->GetProfileString( 
+         PUTTYCS_APP_NAME, csKey, PUTTYCS_EMPTY_STRING );
+   }
+
+   CString csValue;
+
+   csKey.MakeLower();
+
+   if ( !pValues->Lookup(csKey, csValue) )
+   {
+      csValue = PUTTYCS_EMPTY_STRING;
+   }
+
+   return csValue;
+}
+
+/**
+ * CPuTTYCSDialog::OnSysCommand()
+ */
+
+void CPuTTYCSDialog::OnSysCommand(UINT nID, LPARAM lParam)
+{
+   UINT nCmd = (nID & 0xFFF0);
+
+   if ( nCmd == IDM_ABOUT_PUTTYCS )
+   {
+      OnAboutButton();
+   }
+   else if ( nCmd == IDM_EXPORT_TRACE )
+   {
+      m_bDisablePopup = TRUE;
+
+      CFileDialog dialog( false, 
+                          PUTTYCS_TRACE_EXTENSION, 
+                          NULL,
+                          OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT, 
+                          PUTTYCS_TRACE_FILETYPE, 
+                          this );
+
+      dialog.m_ofn.lpstrTitle =
+         PUTTYCS_WINDOW_TITLE_EXPORT_TRACE;
+
+      if ( dialog.DoModal() == IDOK )
+      {
+         if ( !ExportTrace(dialog.GetPathName()) )
+         {
+            MessageBox(PUTTYCS_MESSAGEBOX_EXPORT_TRACE_ERROR, PUTTYCS_WINDOW_TITLE_APP, MB_ICONEXCLAMATION | MB_OK );
+         }
+      }
+
+      m_bDisablePopup = FALSE;
+   }
+   else if ( nCmd == IDM_WAIT_STATS )
+   {
+      CString csSummary = CWindowWait::GetSummary();
+
+      m_bDisablePopup = TRUE;
+
+      MessageBox( csSummary.IsEmpty() ? PUTTYCS_WAIT_SUMMARY_EMPTY : csSummary, 
+         PUTTYCS_WINDOW_TITLE_APP, MB_ICONINFORMATION | MB_OK );
+
+      m_bDisablePopup = FALSE;
+   }
+   else if ( nCmd == IDM_SAVE_LAYOUT )
+   {
+      if ( SaveLayout(CSendEngine::GetFilterName(GetFilterEntry())) < 0 )
+      {
+         m_bDisablePopup = TRUE;
+
+         MessageBox(PUTTYCS_MESSAGEBOX_LAYOUT_FULL, PUTTYCS_WINDOW_TITLE_APP, MB_ICONEXCLAMATION | MB_OK );
+
+         m_bDisablePopup = FALSE;
+      }
+   }
+   else if ( (nCmd >= IDM_RESTORE_LAYOUT) && 
+             (nCmd < IDM_RESTORE_LAYOUT + (PUTTYCS_PREF_SNAPSHOT_MAX_SIZE << 4)) )
+   {
+      int iSnapshot = (nCmd - IDM_RESTORE_LAYOUT) >> 4;
+
+      if ( iSnapshot < m_csaSnapshots.GetSize() )
+      {
+         m_seSendEngine.RestoreSnapshot( m_csaSnapshots.GetAt(iSnapshot) );
+
+         RefreshDialog();
+      }
+   }
+   else if ( nCmd == IDM_LAUNCH_SESSIONS )
+   {
+      m_bDisablePopup = TRUE;
+
+      CFileDialog dialog( true, 
+                          NULL, 
+                          NULL,
+                          OFN_HIDEREADONLY, 
+                          PUTTYCS_HOSTS_FILETYPE, 
+                          this );
+
+      dialog.m_ofn.lpstrTitle =
+         PUTTYCS_WINDOW_TITLE_LAUNCH_SESSIONS;
+
+      if ( dialog.DoModal() == IDOK )
+      {
+         if ( LaunchSessions(dialog.GetPathName(), true) < 0 )
+         {
+            MessageBox(PUTTYCS_MESSAGEBOX_LAUNCH_ERROR, PUTTYCS_WINDOW_TITLE_APP, MB_ICONEXCLAMATION | MB_OK );
+         }
+      }
+
+      m_bDisablePopup = FALSE;
+   }
+   else 
+   {
+      if ( (m_iMinimizeToSysTray) &&
+           ((nCmd == SC_MINIMIZE)     
+         || (nCmd == SC_CLOSE)) )
+      {
+         ShowWindow( SW_HIDE );
+         SetSysTrayTip( PUTTYCS_WINDOW_TITLE_APP );
+      }
+      else
+      {
+         CDialog::OnSysCommand(nID, lParam);
+      }
+   } 
+}
+
+/**
+ * CPuTTYCSDialog::OnPaint()
+ */
+
+void CPuTTYCSDialog::OnPaint() 
+{
+   if (IsIconic())
+   {
+      CPaintDC dc(this); // device context for painting
+
+      SendMessage(WM_ICONERASEBKGND, (WPARAM) dc.GetSafeHdc(), 0);
+
+      int cxIcon = GetSystemMetrics(SM_CXICON);
+      int cyIcon = GetSystemMetrics(SM_CYICON);
+
+      CRect rect;
+      GetClientRect(&rect);
 
       int x = (rect.Width() - cxIcon + 1) / 2;
       int y = (rect.Height() - cyIcon + 1) / 2;
@@ -964,6 +1492,14 @@ void CPuTTYCSDialog::OnPaint()
    else
    {
       CDialog::OnPaint();
+
+      if ( !m_spStartupProfile.IsFinished() )
+      {
+         m_spStartupProfile.Mark( "first paint" );
+         m_spStartupProfile.Finish();
+
+         ::OutputDebugStringA( (m_spStartupProfile.GetSummary() + "\n").c_str() );
+      }
    }
 }
 
@@ -1023,6 +1559,18 @@ void CPuTTYCSDialog::ParseCmdLineOptions(LPTSTR pCmdLine)
                   SendScript( pArgv[iArg] );				   
                }
 			   }
+            else if (_tcscmp(pArgv[iArg],PUTTYCS_CMD_TRACE)==0 || _tcscmp(pArgv[iArg],PUTTYCS_CMD_TRACE_LONG)==0) 
+            {
+               if (++iArg >= iArgc)
+               {
+                  sMessage.Format(PUTTYCS_MESSAGEBOX_MISSING_ARGUMENT, PUTTYCS_CMD_TRACE, PUTTYCS_CMD_TRACE_LONG);
+                  MessageBox(sMessage, PUTTYCS_WINDOW_TITLE_APP, MB_OK);
+               }
+               else 
+               {
+                  m_csTraceFile = pArgv[iArg];
+               }
+            }
    		   else if (_tcscmp(pArgv[iArg],PUTTYCS_CMD_HELP)==0 || _tcscmp(pArgv[iArg],PUTTYCS_CMD_HELP_LONG)==0) 
             {		         
                MessageBox(PUTTYCS_MESSAGEBOX_HELP, PUTTYCS_WINDOW_TITLE_APP, MB_OK);
@@ -1050,6 +1598,16 @@ void CPuTTYCSDialog::OnAboutButton()
    m_bDisablePopup = true;
 
    CAboutDialog dialog;
+
+   if ( m_spStartupProfile.IsFinished() )
+   {
+      CString csStartup;
+      csStartup.Format( PUTTYCS_ABOUT_STARTUP_TEXT, 
+         m_spStartupProfile.GetTotalMs(), m_spStartupProfile.GetProcessStartMs() );
+
+      dialog.setStartupText( csStartup );
+   }
+
    dialog.DoModal();
 
    m_bDisablePopup = false;   
@@ -1068,6 +1626,17 @@ void CPuTTYCSDialog::RefreshDialog()
 
    m_cceCommandEdit.SetFocus();
 
+   UpdateCmdHistoryButtons();
+
+   SetForegroundWindow();
+}
+
+/**
+ * CPuTTYCSDialog::UpdateCmdHistoryButtons()
+ */
+
+void CPuTTYCSDialog::UpdateCmdHistoryButtons()
+{
    ((CButton*) GetDlgItem(IDC_CMDHISTORYUP_BUTTON))->
       EnableWindow( m_csaCmdHistory.GetSize() > 0 );
    
@@ -1076,8 +1645,6 @@ void CPuTTYCSDialog::RefreshDialog()
 
    ((CButton*) GetDlgItem(IDC_CMDHISTORYCLEAR_BUTTON))->
       EnableWindow( m_csaCmdHistory.GetSize() > 0 );
-
-   SetForegroundWindow();
 }
 
 /**
@@ -1133,7 +1700,7 @@ void CPuTTYCSDialog::UpdateDialog()
        * window does not redraw correctly
        */
 
-      ::Sleep( 20 );
+      CWindowWait::ForRedraw( m_hWnd, PUTTYCS_WAIT_REDRAW_DELAY );
 
       CPuTTYCSApp::g_pSetLayeredWindowAttributes(
          m_hWnd, 0, m_iOpacity, LWA_ALPHA );
@@ -1168,6 +1735,8 @@ void CPuTTYCSDialog::OnOpenMenuItem()
 
 void CPuTTYCSDialog::OnSelChangeFiltersCombobox() 
 {
+   OnDropDownFiltersCombobox();
+
    m_iFilter =
       ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->GetCurSel();   
 
@@ -1181,8 +1750,16 @@ void CPuTTYCSDialog::OnSelChangeFiltersCombobox()
          m_iFilter = 0;
 
          OnMinimizeButton();
-  
-         ::Sleep( 250 );
+
+         std::vector<HWND> vecMinimized( m_vecWindows.size() );
+
+         for ( size_t iLoop = 0; iLoop < m_vecWindows.size(); iLoop++ )
+         {
+            vecMinimized[iLoop] = CWin32WindowSystem::GetHwnd( m_vecWindows[iLoop].id );
+         }
+
+         CWindowWait::ForMinimized( vecMinimized.data(),
+            (int) vecMinimized.size(), PUTTYCS_WAIT_MINIMIZE_DELAY );
 
          m_iFilter = iFilter;
       }
@@ -1197,6 +1774,11 @@ void CPuTTYCSDialog::OnSelChangeFiltersCombobox()
       }
    }
 
+   if ( m_kmKeyMirror.IsActive() )
+   {
+      m_kmKeyMirror.Start( GetFilterEntry(), &m_seSendEngine );
+   }
+
    RefreshDialog();
 }
 
@@ -1204,19 +1786,11 @@ void CPuTTYCSDialog::OnSelChangeFiltersCombobox()
  * CPuTTYCSDialog::GetAllWindows()
  */ 
 
-CObArray* CPuTTYCSDialog::GetAllWindows()
+const std::vector<WINDOWINFO>& CPuTTYCSDialog::GetAllWindows()
 {
-   m_obaWindows.RemoveAll();
-
-   m_bFindAll = true;
+   FindWindows( PUTTYCS_FILTER_ALL, false );
 
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
-
-   m_bFindAll = false;
-
-   return &m_obaWindows;
+   return m_vecWindows;
 }
 
 /**
@@ -1225,35 +1799,33 @@ CObArray* CPuTTYCSDialog::GetAllWindows()
 
 void CPuTTYCSDialog::OnCascadeButton() 
 {      
-   m_obaWindows.RemoveAll();
-
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
+   FindWindows( GetFilterEntry() );
 
-   int iTotal = m_obaWindows.GetSize();
+   int iTotal = (int) m_vecWindows.size();
 
    if (iTotal > 0) 
    {           
-       RECT rectWorkArea;
+      RECT rectWorkArea;
       ::SystemParametersInfo(SPI_GETWORKAREA, NULL, &rectWorkArea, 0);
- 
-      int iX = rectWorkArea.left;
-      int iY = rectWorkArea.top;
-      
+
+      CTileLayout layout;
+
+      layout.SetWorkArea( rectWorkArea.left, rectWorkArea.top,
+                          rectWorkArea.right - rectWorkArea.left,
+                          rectWorkArea.bottom - rectWorkArea.top );
+
+      layout.Cascade( iTotal, m_iCascadeWidth, m_iCascadeHeight,
+         GetSystemMetrics(SM_CYCAPTION) - GetSystemMetrics(SM_CYFRAME),
+         GetSystemMetrics(SM_CYCAPTION) + GetSystemMetrics(SM_CYFRAME) - 1,
+         GetSystemMetrics(SM_CYCAPTION) );
+
       for ( int iLoop = 0; iLoop < iTotal; iLoop++ )
       {        
-         MovePuttyWnd((CWnd*) m_obaWindows.GetAt(iLoop), iX, iY, m_iCascadeWidth, m_iCascadeHeight);
+         TILERECT rect;
+         layout.GetRect( iLoop, rect );
 
-         iX += GetSystemMetrics(SM_CYCAPTION) - GetSystemMetrics(SM_CYFRAME);
-         iY += GetSystemMetrics(SM_CYCAPTION) + GetSystemMetrics(SM_CYFRAME) - 1;
-
-         if ( ((iX + m_iCascadeWidth) >= rectWorkArea.right) ||
-              ((iY + m_iCascadeHeight + GetSystemMetrics(SM_CYCAPTION)) >= rectWorkArea.bottom) ) 
-         {
-            iX = rectWorkArea.left;
-            iY = rectWorkArea.top;            
-         }               
+         MovePuttyWnd(CWin32WindowSystem::GetHwnd(m_vecWindows[iLoop].id), 
+            rect.iX, rect.iY, rect.iWidth, rect.iHeight);
       }
    }
 
@@ -1266,13 +1838,9 @@ void CPuTTYCSDialog::OnCascadeButton()
 
 void CPuTTYCSDialog::OnTileButton() 
 {
-   m_obaWindows.RemoveAll();
-
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
+   FindWindows( GetFilterEntry() );
 
-   int iTotal = m_obaWindows.GetSize();
+   int iTotal = (int) m_vecWindows.size();
 
    if ( iTotal > 0 )
    {        
@@ -1298,10 +1866,10 @@ void CPuTTYCSDialog::OnTileButton()
 
          for ( iLoop = 0; iLoop < iTotal; iLoop++ )
          {   
-             CWnd* pWnd = (CWnd*) m_obaWindows.GetAt(iLoop);
+             HWND hWnd = CWin32WindowSystem::GetHwnd(m_vecWindows[iLoop].id);
              int posX = (iX + rectWorkArea.left);
              int posY = (iY + rectWorkArea.top);
-            MovePuttyWnd(pWnd, posX ,posY , iSizeX, iSizeY);
+            MovePuttyWnd(hWnd, posX ,posY , iSizeX, iSizeY);
 
             iX += (iSizeX);
          
@@ -1312,6 +1880,59 @@ void CPuTTYCSDialog::OnTileButton()
             }            
          }        
       }
+      else if (m_iTileMethod == PUTTYCS_PREF_TILE_METHOD_TERMINAL)
+      {
+         /**
+          * Frame overhead is taken from the first PuTTY window, falling
+          * back to system metrics when it is minimized or hidden
+          */
+
+         const WINDOWINFO& window = m_vecWindows[0];
+
+         CRect rectWindow;
+         CRect rectClient;
+
+         ::GetWindowRect( CWin32WindowSystem::GetHwnd(window.id), &rectWindow );
+         ::GetClientRect( CWin32WindowSystem::GetHwnd(window.id), &rectClient );
+
+         int iFrameWidth;
+         int iFrameHeight;
+
+         if ( (window.iFlags & WINDOWSTATE_MINIMIZED) || !(window.iFlags & WINDOWSTATE_VISIBLE) || 
+              rectClient.IsRectEmpty() )
+         {
+            iFrameWidth = (GetSystemMetrics(SM_CXFRAME) * 2) + GetSystemMetrics(SM_CXVSCROLL);
+            iFrameHeight = (GetSystemMetrics(SM_CYFRAME) * 2) + GetSystemMetrics(SM_CYCAPTION);
+         }
+         else
+         {
+            iFrameWidth = rectWindow.Width() - rectClient.Width();
+            iFrameHeight = rectWindow.Height() - rectClient.Height();
+         }
+
+         CTileLayout layout;
+
+         layout.SetWorkArea( rectWorkArea.left, rectWorkArea.top,
+                             rectWorkArea.right - rectWorkArea.left,
+                             rectWorkArea.bottom - rectWorkArea.top );
+
+         layout.SetCellSize( m_iTileCellWidth, m_iTileCellHeight );
+
+         layout.SetFrameSize( iFrameWidth + PUTTYCS_TILE_INNER_BORDER,
+                              iFrameHeight + PUTTYCS_TILE_INNER_BORDER );
+
+         if ( layout.Optimize(iTotal) )
+         {
+            for ( iLoop = 0; iLoop < iTotal; iLoop++ )
+            {
+               TILERECT rect;
+               layout.GetRect( iLoop, rect );
+
+               MovePuttyWnd(CWin32WindowSystem::GetHwnd(m_vecWindows[iLoop].id), 
+                  rect.iX, rect.iY, rect.iWidth, rect.iHeight);
+            }
+         }
+      }
       else 
       {
          int iRow;
@@ -1344,7 +1965,7 @@ void CPuTTYCSDialog::OnTileButton()
 
              for (iRow = 1; iRow <= iRows && iWndIndex < iTotal; iRow++, iLoop++)
              {                     
-                MovePuttyWnd((CWnd*) m_obaWindows.GetAt(iWndIndex), iX, iY, iSizeX , iSizeY) ;
+                MovePuttyWnd(CWin32WindowSystem::GetHwnd(m_vecWindows[iWndIndex].id), iX, iY, iSizeX , iSizeY) ;
               
                 iY += iSizeY;
 
@@ -1365,26 +1986,9 @@ void CPuTTYCSDialog::OnTileButton()
 
 void CPuTTYCSDialog::OnMinimizeButton() 
 {
-   m_obaWindows.RemoveAll();
-
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
-
-   for ( int iLoop = 0;
-      iLoop < m_obaWindows.GetSize(); iLoop++ )
-   {
-      CWnd* pWnd =
-         (CWnd*) m_obaWindows.GetAt( iLoop );
-             
-      if ( !pWnd->IsWindowVisible() )
-      {
-         pWnd->ShowWindow( SW_SHOW );
-      }
+   FindWindows( GetFilterEntry() );
 
-      pWnd->
-         SendMessage( WM_SYSCOMMAND, SC_MINIMIZE, 0 );
-   }
+   CWindowActions::Minimize( m_vecWindows );
 
    RefreshDialog();      
 }
@@ -1395,23 +1999,9 @@ void CPuTTYCSDialog::OnMinimizeButton()
 
 void CPuTTYCSDialog::OnHideButton() 
 {
-   m_obaWindows.RemoveAll();
-
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
+   FindWindows( GetFilterEntry() );
 
-   for ( int iLoop = 0;
-      iLoop < m_obaWindows.GetSize(); iLoop++ )
-   {
-      CWnd* pWnd =
-        (CWnd*) m_obaWindows.GetAt( iLoop );
-             
-     if ( pWnd->IsWindowVisible() )
-     {
-        pWnd->ShowWindow(SW_HIDE);
-     }
-   }
+   CWindowActions::Hide( m_vecWindows );
 
    RefreshDialog();      
 }
@@ -1422,13 +2012,9 @@ void CPuTTYCSDialog::OnHideButton()
 
 void CPuTTYCSDialog::OnCloseButton() 
 {
-   m_obaWindows.RemoveAll();
-
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );
-    
-   SortWindows();
+   FindWindows( GetFilterEntry() );
 
-   int iSize = m_obaWindows.GetSize();
+   int iSize = (int) m_vecWindows.size();
 
    if ( iSize > 0 )
    {
@@ -1436,26 +2022,9 @@ void CPuTTYCSDialog::OnCloseButton()
                       PUTTYCS_APP_NAME, 
                       MB_ICONEXCLAMATION | MB_YESNO) == IDYES )
       {
-         for ( int iLoop = 0; iLoop < iSize; iLoop++ )
-         { 
-            CWnd* pWnd =
-               (CWnd*) m_obaWindows.GetAt( iLoop );
-
-            DWORD dwPid;
-            
-            GetWindowThreadProcessId( pWnd->m_hWnd, &dwPid);
-
-            if ( dwPid )
-            {
-               HANDLE hProcess =
-                  OpenProcess( PROCESS_ALL_ACCESS, FALSE, dwPid );
+         CWindowActions::Terminate( m_vecWindows, PUTTYCS_CLOSE_TIMEOUT );
 
-               if ( hProcess )
-               {            
-                  ::TerminateProcess( hProcess, (DWORD) -1 );
-               }
-            }           
-         }
+         RefreshDialog();
       }
    }
 }
@@ -1476,22 +2045,11 @@ void CPuTTYCSDialog::OnFiltersButton()
    
    pDialog->DoModal();
 
-   ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
-      ResetContent();
-
-   for ( int iLoop = 0; iLoop < m_csaFilters.GetSize(); iLoop++)
-   {
-      CString csFilter = m_csaFilters.GetAt(iLoop);
+   m_iFilter = pDialog->getFilter();
 
-      ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
-         AddString( csFilter.Mid(0, 
-            csFilter.Find(PUTTYCS_FILTER_NAME_SEPARATOR)) );
+   m_seSendEngine.SetFilters( m_csaFilters );
 
-      m_iFilter = pDialog->getFilter();
-
-      ((CComboBox*) GetDlgItem(IDC_FILTERS_COMBOBOX))->
-         SetCurSel( m_iFilter );                 
-   }
+   FillFiltersCombobox();
 
    SavePreferences();
 
@@ -1516,12 +2074,109 @@ void CPuTTYCSDialog::OnSendCRPushButton()
    RefreshDialog();    
 }
 
+/**
+ * CPuTTYCSDialog::OnLivePushButton()
+ *
+ * While live mode is on, the command edit is read only and shows
+ * the delivery latency instead of the command being typed
+ */
+
+void CPuTTYCSDialog::OnLivePushButton() 
+{
+   if ( !m_kmKeyMirror.IsActive() )
+   {
+      m_csLiveCommand = m_cceCommandEdit.GetText();
+
+      m_kmKeyMirror.Start( GetFilterEntry(), &m_seSendEngine );
+
+      m_cceCommandEdit.SetReadOnly( TRUE );
+      m_cceCommandEdit.SetWindowText( m_kmKeyMirror.GetSummary() );
+      m_cceCommandEdit.SetFocus();
+
+      SetTimer( PUTTYCS_TIMER_LIVE, PUTTYCS_TIMER_LIVE_INTERVAL, NULL );
+   }
+   else
+   {
+      KillTimer( PUTTYCS_TIMER_LIVE );
+
+      m_kmKeyMirror.Stop();
+
+      m_cceCommandEdit.SetReadOnly( FALSE );
+      m_cceCommandEdit.SetWindowText( m_csLiveCommand );
+   }
+
+   ((CButton*) GetDlgItem(IDC_LIVE_PUSHBUTTON))->
+      SetCheck( m_kmKeyMirror.IsActive() );
+
+   GetDlgItem(IDC_SEND_BUTTON)->EnableWindow( !m_kmKeyMirror.IsActive() );
+   GetDlgItem(IDC_SCRIPT_BUTTON)->EnableWindow( !m_kmKeyMirror.IsActive() );
+
+   RefreshDialog();
+}
+
+/**
+ * CPuTTYCSDialog::OnTimer()
+ */
+
+void CPuTTYCSDialog::OnTimer(UINT_PTR nIDEvent) 
+{
+   if ( (nIDEvent == PUTTYCS_TIMER_LIVE) && m_kmKeyMirror.IsActive() )
+   {
+      m_cceCommandEdit.SetWindowText( m_kmKeyMirror.GetSummary() );
+   }
+   else if ( nIDEvent == PUTTYCS_TIMER_SEND_QUEUE )
+   {
+      /**
+       * WM_TIMER comes after input, so clicks made during the last
+       * fan-out have joined the queue before the next job is taken
+       */
+
+      KillTimer( PUTTYCS_TIMER_SEND_QUEUE );
+
+      sendQueued();
+
+      if ( !m_sqSendQueue.IsEmpty() )
+      {
+         SetTimer( PUTTYCS_TIMER_SEND_QUEUE, PUTTYCS_TIMER_SEND_QUEUE_INTERVAL, NULL );
+      }
+
+      UpdateQueueStatus();
+
+      RefreshDialog();
+   }
+   else if ( nIDEvent == PUTTYCS_TIMER_LAUNCH )
+   {
+      KillTimer( PUTTYCS_TIMER_LAUNCH );
+
+      m_slSessionLauncher.Step();
+
+      UpdateQueueStatus();
+
+      if ( !m_slSessionLauncher.IsFinished() )
+      {
+         SetTimer( PUTTYCS_TIMER_LAUNCH, 
+            max( (UINT) 1, (UINT) m_slSessionLauncher.GetWait() ), NULL );
+      }
+      else if ( m_bLaunchInteractive )
+      {
+         m_bLaunchInteractive = false;
+
+         MessageBox( CSendEngine::GetString(m_slSessionLauncher.GetSummary()), 
+            PUTTYCS_WINDOW_TITLE_APP, MB_ICONINFORMATION | MB_OK );
+      }
+   }
+
+   CDialog::OnTimer(nIDEvent);
+}
+
 /**
  * CPuTTYCSDialog::OnCmdHistoryUpButton()
  */ 
 
 void CPuTTYCSDialog::OnCmdHistoryUpButton() 
 {   
+   LoadCmdHistory();
+
    if ( m_csaCmdHistory.GetSize() > 0 ) 
    {
       m_iCmdHistory--;
@@ -1545,6 +2200,8 @@ void CPuTTYCSDialog::OnCmdHistoryUpButton()
 
 void CPuTTYCSDialog::OnCmdHistoryDownButton() 
 {
+   LoadCmdHistory();
+
    if ( m_csaCmdHistory.GetSize() > 0 ) 
    {
       m_iCmdHistory++;
@@ -1568,6 +2225,8 @@ void CPuTTYCSDialog::OnCmdHistoryDownButton()
 
 void CPuTTYCSDialog::OnCmdHistoryClearButton() 
 {
+   LoadCmdHistory();
+
    if ( m_csaCmdHistory.GetSize() > 0 )
    {
       if ( MessageBox( 
@@ -1791,6 +2450,9 @@ void CPuTTYCSDialog::OnPreferencesButton()
 
    pDialog->setTileMethod( m_iTileMethod );
 
+   pDialog->setTileCellWidth( m_iTileCellWidth );
+   pDialog->setTileCellHeight( m_iTileCellHeight );
+
    /**
     * Cascade dimensions
     */
@@ -1840,6 +2502,15 @@ void CPuTTYCSDialog::OnPreferencesButton()
    pDialog->
       setPostSendDelay( m_iPostSendDelay );
 
+   pDialog->
+      setAutoTuneDelays( m_iAutoTuneDelays );
+
+   pDialog->
+      setAutoTuneMin( m_iAutoTuneMin );
+
+   pDialog->
+      setAutoTuneMax( m_iAutoTuneMax );
+
    /**
     * Miscellaneous
     */
@@ -1879,6 +2550,12 @@ void CPuTTYCSDialog::OnPreferencesButton()
       m_iTileMethod =
          pDialog->getTileMethod();
 
+      m_iTileCellWidth =
+         pDialog->getTileCellWidth();
+
+      m_iTileCellHeight =
+         pDialog->getTileCellHeight();
+
       /**
        * Cascade dimensions
        */
@@ -1955,6 +2632,13 @@ void CPuTTYCSDialog::OnPreferencesButton()
       m_iTransition = pDialog->getTransition();
       m_iPostSendDelay = pDialog->getPostSendDelay();
 
+      m_iAutoTuneDelays = pDialog->getAutoTuneDelays();
+      m_iAutoTuneMin = pDialog->getAutoTuneMin();
+      m_iAutoTuneMax = pDialog->getAutoTuneMax();
+
+      m_seSendEngine.GetDelayTuner().SetEnabled( m_iAutoTuneDelays ? true : false );
+      m_seSendEngine.GetDelayTuner().SetBounds( m_iAutoTuneMin, m_iAutoTuneMax );
+
       /**
        * Miscellaneous
        */
@@ -2044,52 +2728,110 @@ void CPuTTYCSDialog::OnCheckForUpdates()
 
 /**
  * CPuTTYCSDialog::CheckForUpdates()
+ *
+ * Starts the check on a worker thread and returns at once, the
+ * result arrives as WM_USER_UPDATE_CHECKED. Automatic checks run at
+ * most once per PUTTYCS_UPDATE_INTERVAL.
  */
 
 void CPuTTYCSDialog::CheckForUpdates( bool bInteractive ) 
 {	
-   m_bDisablePopup = TRUE;
+   __int64 llNow = (__int64) CTime::GetCurrentTime().GetTime();
 
-   CString csVersion = PUTTYCS_EMPTY_STRING;
+   if ( !bInteractive )
+   {
+      __int64 llLastCheck = _ttoi64(
+         AfxGetApp()->GetProfileString( 
+            PUTTYCS_APP_NAME, PUTTYCS_PREF_LAST_UPDATE_CHECK, PUTTYCS_EMPTY_STRING) );
 
-   TCHAR szTempFile[MAX_PATH]; 
-	
-   HRESULT hr = ::URLDownloadToCacheFile( NULL, 
-                                          PUTTYCS_URL_UPDATES, 
-                                          szTempFile, 
-                                          URLOSTRM_GETNEWESTVERSION, 
-                                          0, 
-                                          NULL );
-   
-   if ( SUCCEEDED(hr) )
-   {           
-      FILE* pFile;
-      
-      if ( (pFile = _tfopen(szTempFile, PUTTYCS_FILE_MODE_READ)) )
-      {         
-         TCHAR szLine[1024];
-    
-         while ( _fgetts(szLine, sizeof( szLine ), pFile) != NULL )       
-         {                             
-            CString app = GetAttributeValue(szLine, PUTTYCS_ATTRIBUTE_NAME);
-       
-            if ( !app.Compare(PUTTYCS_APP_NAME) )
-            {
-			   CString csIntVersion = GetAttributeValue(szLine, PUTTYCS_ATTRIBUTE_INT_VERSION);
+      if ( !CUpdateCheck::IsDue(llLastCheck, llNow) )
+      {
+         return;
+      }
+   }
 
-			   if ((!csIntVersion.IsEmpty()) && (csIntVersion.Compare(PUTTYCS_VERSION_INT) > 0))
-			   {
-                  csVersion = GetAttributeValue(szLine, PUTTYCS_ATTRIBUTE_VERSION);
+   m_bUpdateInteractive = m_bUpdateInteractive || bInteractive;
 
-				  break;
-			   }
-            }
-         }
+   if ( m_ucUpdateCheck.IsRunning() )
+   {
+      return;
+   }
+
+   /**
+    * Stamped before the result is in, so an offline host
+    * does not retry on every start
+    */
+
+   CString csNow;
+   csNow.Format( _T("%I64d"), llNow );
+
+   AfxGetApp()->WriteProfileString(
+      PUTTYCS_APP_NAME, PUTTYCS_PREF_LAST_UPDATE_CHECK, csNow );
+
+   CString csUrl = 
+      AfxGetApp()->GetProfileString( 
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_UPDATE_URL, PUTTYCS_URL_UPDATES );
+
+   m_ucUpdateCheck.Start( m_hWnd, csUrl, PUTTYCS_UPDATE_DEADLINE );
+}
+
+/**
+ * CPuTTYCSDialog::OnUpdateChecked()
+ */
+
+LRESULT CPuTTYCSDialog::OnUpdateChecked(WPARAM wParam, LPARAM lParam) 
+{
+   CString csVersion;
+   CString csIntVersion;
+
+   bool bSucceeded = m_ucUpdateCheck.GetResult( csVersion, csIntVersion );
+
+   if ( bSucceeded )
+   {
+      AfxGetApp()->WriteProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LATEST_VERSION, csVersion );
+
+      AfxGetApp()->WriteProfileString(
+         PUTTYCS_APP_NAME, PUTTYCS_PREF_LATEST_INT_VERSION, csIntVersion );
+   }
+   else if ( m_bUpdateInteractive )
+   {
+      /**
+       * Offline, fall back to what the last good check found
+       */
+
+      csIntVersion = 
+         AfxGetApp()->GetProfileString( 
+            PUTTYCS_APP_NAME, PUTTYCS_PREF_LATEST_INT_VERSION, PUTTYCS_EMPTY_STRING );
+
+      if ( CUpdateCheck::IsNewer(csIntVersion) )
+      {
+         csVersion = 
+            AfxGetApp()->GetProfileString( 
+               PUTTYCS_APP_NAME, PUTTYCS_PREF_LATEST_VERSION, PUTTYCS_EMPTY_STRING );
+      }
+   }
+
+   ShowUpdateResult( csVersion, bSucceeded );
+
+   m_bUpdateInteractive = false;
+
+   return TRUE;
+}
+
+/**
+ * CPuTTYCSDialog::ShowUpdateResult()
+ */
 
-         fclose(pFile);
-      }       
+void CPuTTYCSDialog::ShowUpdateResult( CString csVersion, bool bSucceeded ) 
+{	
+   if ( m_bIsClosing )
+   {
+      return;
    }
 
+   m_bDisablePopup = TRUE;
+
    if ( !csVersion.IsEmpty() )
    {
       CString csMessage;            
@@ -2109,10 +2851,18 @@ void CPuTTYCSDialog::CheckForUpdates( bool bInteractive )
    }
    else 
    {        
-      if ( bInteractive ) 
+      if ( m_bUpdateInteractive ) 
       {
          CString sMessage;            
-         sMessage.Format( PUTTYCS_MESSAGEBOX_NO_UPDATES, PUTTYCS_VERSION );
+
+         if ( bSucceeded )
+         {
+            sMessage.Format( PUTTYCS_MESSAGEBOX_NO_UPDATES, PUTTYCS_VERSION );
+         }
+         else
+         {
+            sMessage = PUTTYCS_MESSAGEBOX_UPDATE_FAILED;
+         }
 
          MessageBox( sMessage, 
                      PUTTYCS_APP_NAME, 
@@ -2160,93 +2910,229 @@ void CPuTTYCSDialog::OnScriptButton()
 
 void CPuTTYCSDialog::SendScript(CString sFilename) 
 {     
-   FILE* pFile;
-   
-   if ( (pFile = _tfopen(sFilename, PUTTYCS_FILE_MODE_READ)) )
-   {
-      CString csBuffer;
-
-         bool capsLock = false;
+   ShowWindow( SW_HIDE );
 
-         if ( ::GetKeyState(VK_CAPITAL) )
-         {
-            capsLock = true;
-
-            csBuffer += PUTTYCS_SENDKEY_BUTTON_CAPSLOCK;
-         }
-
-         bool firstLine = true;
-
-         TCHAR szLine[65536];
-    
-         while ( _fgetts(szLine, sizeof( szLine ), pFile) != NULL )       
-         {
-            if ( !firstLine ) 
-            {
-               csBuffer += PUTTYCS_SENDKEY_BUTTON_ENTER;
-            }
-         
-            csBuffer += szLine; 
-                           
-            firstLine = false;
-         }
-
-         if ( m_iSendCR )
-         {
-            csBuffer += PUTTYCS_SENDKEY_BUTTON_ENTER;
-         }
-
-         if ( capsLock )
-         {
-            csBuffer +=
-               PUTTYCS_SENDKEY_BUTTON_CAPSLOCK;
-         }     
+   int iWindows = RunScript( sFilename, GetFilterEntry() );
 
-         ShowWindow( SW_HIDE );
+   ShowWindow( SW_SHOW );
 
-         sendBuffer( csBuffer );
+   RedrawWindow();
 
-         ShowWindow( SW_SHOW );
-        
-         fclose( pFile );
-   }  
-   else
+   if ( iWindows < 0 )
    {      
       MessageBox(PUTTYCS_MESSAGEBOX_LOAD_SCRIPT_ERROR, PUTTYCS_WINDOW_TITLE_APP, MB_ICONEXCLAMATION | MB_OK );
    }
 }
 
 /**
- * CPuTTYCSDialog::OnSendButton()
+ * CPuTTYCSDialog::RunScript()
+ *
+ * Types the script in one go, or a line at a time when the filter
+ * (or the preferences) give a prompt to wait for and the windows
+ * have session logs to watch it in. Returns the number of windows,
+ * -1 if the script can not be read.
  */
 
-void CPuTTYCSDialog::OnSendButton() 
+int CPuTTYCSDialog::RunScript(CString csFilename, CString csEntry) 
 {
-   CString csCommand;
-   GetDlgItemText(IDC_COMMAND_EDIT, csCommand);
+   flushSendQueue();
 
-   sendCommand( csCommand, false );
-}
+   m_seSendEngine.SetTransition( m_iTransition );
+   m_seSendEngine.SetPostSendDelay( m_iPostSendDelay );
+   m_seSendEngine.SetSendCR( m_iSendCR );
 
-/**
- * CPuTTYCSDialog::OnCtrlButton()
- */
+   CString csPrompt = CSendEngine::GetFilterPrompt( csEntry );
 
-void CPuTTYCSDialog::OnCtrlButton() 
-{
-   m_cceCommandEdit.InsertText( PUTTYCS_TOKEN_CTRL );
+   if ( csPrompt.IsEmpty() )
+   {
+      csPrompt = m_csScriptPrompt;
+   }
 
-   m_cceCommandEdit.SetFocus();
+   CString csCapsLock = ::GetKeyState(VK_CAPITAL) ? 
+      PUTTYCS_SENDKEY_BUTTON_CAPSLOCK : PUTTYCS_EMPTY_STRING;
 
-}
+   /**
+    * A script file whose bytes are unchanged since it ran with the
+    * same options is replayed from its compiled keys, not parsed
+    * again
+    */
 
-/**
- * CPuTTYCSDialog::OnIncButton()
- */
+   CKeyProgramCache kpcCache;
+   CStringArray csaLines;
 
-void CPuTTYCSDialog::OnIncButton() 
-{
-   m_cceCommandEdit.InsertText( PUTTYCS_TOKEN_INC );
+   if ( m_iScriptCache )
+   {
+      unsigned int uiFlags = 
+         (m_iSendCR ? CKeyProgramCache::FLAG_SENDCR : 0) |
+         (csCapsLock.IsEmpty() ? 0 : CKeyProgramCache::FLAG_CAPSLOCK);
+
+      if ( kpcCache.Open(CSendEngine::GetUtf8(CSendEngine::GetCacheDirectory()), 
+              CSendEngine::GetUtf8(csFilename), uiFlags) )
+      {
+         const std::vector<std::string>& vecLines = kpcCache.GetLines();
+
+         for ( size_t iLine = 0; iLine < vecLines.size(); iLine++ )
+         {
+            csaLines.Add( CSendEngine::GetString(vecLines[iLine]) );
+         }
+      }
+   }
+
+   if ( !kpcCache.IsMapped() )
+   {
+      if ( !LoadScript(csFilename, csaLines) )
+      {
+         return -1;
+      }
+
+      if ( m_iScriptCache )
+      {
+         std::vector<std::string> vecLines;
+
+         for ( int iLine = 0; iLine < csaLines.GetSize(); iLine++ )
+         {
+            vecLines.push_back( CSendEngine::GetUtf8(csaLines.GetAt(iLine)) );
+         }
+
+         kpcCache.SetLines( vecLines );
+      }
+   }
+
+   if ( m_iScriptCache )
+   {
+      m_seSendEngine.SetProgramCache( &kpcCache );
+   }
+
+   int iWindows = 0;
+
+   if ( csPrompt.IsEmpty() || m_csSessionLog.IsEmpty() )
+   {
+      CString csBuffer = csCapsLock;
+
+      for ( int iLine = 0; iLine < csaLines.GetSize(); iLine++ )
+      {
+         csBuffer += csaLines.GetAt( iLine );
+      }
+
+      csBuffer += csCapsLock;
+
+      iWindows = m_seSendEngine.Send( csBuffer, csEntry, false, false );
+   }
+   else
+   {
+      CStringArray csaPaced;
+
+      for ( int iLine = 0; iLine < csaLines.GetSize(); iLine++ )
+      {
+         csaPaced.Add( csCapsLock + csaLines.GetAt(iLine) + csCapsLock );
+      }
+
+      iWindows = m_seSendEngine.SendScript( csaPaced, csEntry, csPrompt, 
+         m_csSessionLog, m_iScriptLineTimeout );
+   }
+
+   if ( m_iScriptCache )
+   {
+      m_seSendEngine.SetProgramCache( NULL );
+
+      kpcCache.Save();
+   }
+
+   return iWindows;
+}
+
+/**
+ * CPuTTYCSDialog::LoadScript()
+ *
+ * One buffer per line, each but the last followed by Enter, the
+ * last only when sending CR
+ */
+
+bool CPuTTYCSDialog::LoadScript(CString sFilename, CStringArray& csaLines) 
+{     
+   FILE* pFile;
+   
+   if ( (pFile = _tfopen(sFilename, PUTTYCS_FILE_MODE_READ)) )
+   {
+      csaLines.RemoveAll();
+
+      TCHAR szLine[65536];
+ 
+      while ( _fgetts(szLine, sizeof( szLine ), pFile) != NULL )       
+      {
+         if ( csaLines.GetSize() > 0 ) 
+         {
+            csaLines.ElementAt( csaLines.GetSize() - 1 ) += PUTTYCS_SENDKEY_BUTTON_ENTER;
+         }
+      
+         csaLines.Add( szLine ); 
+      }
+
+      if ( m_iSendCR && (csaLines.GetSize() > 0) )
+      {
+         csaLines.ElementAt( csaLines.GetSize() - 1 ) += PUTTYCS_SENDKEY_BUTTON_ENTER;
+      }
+     
+      fclose( pFile );
+
+      return true;
+   }  
+
+   return false;
+}
+
+/**
+ * CPuTTYCSDialog::ExportTrace()
+ */
+
+bool CPuTTYCSDialog::ExportTrace(CString csFilename) 
+{     
+   FILE* pFile;
+   
+   if ( !(pFile = _tfopen(csFilename, PUTTYCS_FILE_MODE_WRITE_BINARY)) )
+   {
+      return false;
+   }
+
+   std::string sJson = m_seSendEngine.GetSendTrace().ExportChromeTrace();
+
+   bool bResult = 
+      (fwrite( sJson.data(), 1, sJson.size(), pFile ) == sJson.size());
+
+   return (fclose( pFile ) == 0) && bResult;
+}
+
+/**
+ * CPuTTYCSDialog::OnSendButton()
+ */
+
+void CPuTTYCSDialog::OnSendButton() 
+{
+   CString csCommand;
+   GetDlgItemText(IDC_COMMAND_EDIT, csCommand);
+
+   sendCommand( csCommand, false );
+}
+
+/**
+ * CPuTTYCSDialog::OnCtrlButton()
+ */
+
+void CPuTTYCSDialog::OnCtrlButton() 
+{
+   m_cceCommandEdit.InsertText( PUTTYCS_TOKEN_CTRL );
+
+   m_cceCommandEdit.SetFocus();
+
+}
+
+/**
+ * CPuTTYCSDialog::OnIncButton()
+ */
+
+void CPuTTYCSDialog::OnIncButton() 
+{
+   m_cceCommandEdit.InsertText( PUTTYCS_TOKEN_INC );
 
    m_cceCommandEdit.SetFocus();
 }
@@ -2284,7 +3170,7 @@ void CPuTTYCSDialog::OnTrayNotify( WPARAM wParam, LPARAM lParam )
          CPoint pt;	
     	   GetCursorPos(&pt);     
        
-         CMenu* pPopup = m_pMenu->GetSubMenu(0);
+         CMenu* pPopup = GetTrayMenu()->GetSubMenu(0);
 
          pPopup->
             SetDefaultItem( IDMI_SYSTRAYOPEN_MENUITEM, FALSE );	
@@ -2341,12 +3227,203 @@ BOOL CPuTTYCSDialog::OnCopyData(CWnd* pWnd, COPYDATASTRUCT* pCopyDataStruct)
 	return CDialog::OnCopyData(pWnd, pCopyDataStruct);
 }
 
+/**
+ * CPuTTYCSDialog::GetFilterEntry()
+ */
+
+CString CPuTTYCSDialog::GetFilterEntry()
+{
+   return m_csFilterOverride.IsEmpty() ? 
+      m_csaFilters.GetAt(m_iFilter) : m_csFilterOverride;
+}
+
+/**
+ * CPuTTYCSDialog::OnChannelBatch()
+ *
+ * Runs a batch of command channel requests. Consecutive send
+ * requests for the same filter are typed in one pass over the
+ * windows. Posted by a channel thread, which waits for the event in
+ * wParam to write the replies.
+ */
+
+LRESULT CPuTTYCSDialog::OnChannelBatch(WPARAM wParam, LPARAM lParam) 
+{
+   CChannelBatch* pBatch = (CChannelBatch*) lParam;
+
+   flushSendQueue();
+
+   m_seSendEngine.SetTransition( m_iTransition );
+   m_seSendEngine.SetPostSendDelay( m_iPostSendDelay );
+
+   int iLoop = 0;
+
+   while ( iLoop < pBatch->GetSize() )
+   {
+      CHANNELREQUEST& request = pBatch->ElementAt( iLoop );
+
+      if ( !request.csStatus.IsEmpty() )
+      {
+         iLoop++;
+         continue;
+      }
+
+      CString csEntry = m_csaFilters.GetAt( m_iFilter );
+
+      if ( !request.csFilter.IsEmpty() &&
+           !CSendEngine::ResolveFilter(m_csaFilters, request.csFilter, csEntry) )
+      {
+         request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+         request.csMessage.Format( PUTTYCS_HEADLESS_UNKNOWN_FILTER, (LPCTSTR) request.csFilter );
+
+         iLoop++;
+         continue;
+      }
+
+      long long llStart = m_seSendEngine.GetSendTrace().Now();
+
+      int iWindows = 0;
+      int iNext = iLoop + 1;
+
+      if ( (request.csVerb == PUTTYCS_CHANNEL_VERB_SEND) ||
+           (request.csVerb == PUTTYCS_CHANNEL_VERB_SEND_NO_CR) )
+      {
+         CStringArray csaCommands;
+         csaCommands.Add( request.csBody );
+
+         while ( (iNext < pBatch->GetSize()) &&
+                 pBatch->GetAt(iNext).csStatus.IsEmpty() &&
+                 (pBatch->GetAt(iNext).csVerb == request.csVerb) &&
+                 (pBatch->GetAt(iNext).csFilter == request.csFilter) )
+         {
+            csaCommands.Add( pBatch->GetAt(iNext).csBody );
+            iNext++;
+         }
+
+         m_seSendEngine.SetSendCR( (request.csVerb == PUTTYCS_CHANNEL_VERB_SEND) ? 1 : 0 );
+
+         iWindows = m_seSendEngine.Send( csaCommands, csEntry, false, true );
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_SCRIPT )
+      {
+         iWindows = RunScript( request.csBody, csEntry );
+
+         if ( iWindows < 0 )
+         {
+            request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+            request.csMessage = PUTTYCS_MESSAGEBOX_LOAD_SCRIPT_ERROR;
+
+            iLoop++;
+            continue;
+         }
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_TILE )
+      {
+         m_csFilterOverride = csEntry;
+
+         OnTileButton();
+
+         m_csFilterOverride.Empty();
+
+         iWindows = (int) m_vecWindows.size();
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_PIN )
+      {
+         iWindows = m_seSendEngine.PinWindows( csEntry, CWindowIndex::PIN_ADD );
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_UNPIN )
+      {
+         iWindows = m_seSendEngine.PinWindows( csEntry, CWindowIndex::PIN_REMOVE );
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_RELEASE )
+      {
+         iWindows = m_seSendEngine.PinWindows( csEntry, CWindowIndex::PIN_RELEASE );
+      }
+      else if ( (request.csVerb == PUTTYCS_CHANNEL_VERB_SNAPSHOT) ||
+                (request.csVerb == PUTTYCS_CHANNEL_VERB_RESTORE) )
+      {
+         CString csName = request.csBody;
+
+         if ( csName.IsEmpty() )
+         {
+            csName = CSendEngine::GetFilterName( csEntry );
+         }
+
+         if ( request.csVerb == PUTTYCS_CHANNEL_VERB_SNAPSHOT )
+         {
+            iWindows = SaveLayout( csName );
+         }
+         else
+         {
+            iWindows = RestoreLayout( csName );
+         }
+
+         if ( iWindows < 0 )
+         {
+            request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+            request.csMessage = (request.csVerb == PUTTYCS_CHANNEL_VERB_SNAPSHOT) ?
+               PUTTYCS_MESSAGEBOX_LAYOUT_FULL : PUTTYCS_MESSAGEBOX_LAYOUT_ERROR;
+
+            iLoop++;
+            continue;
+         }
+      }
+      else if ( request.csVerb == PUTTYCS_CHANNEL_VERB_LAUNCH )
+      {
+         iWindows = LaunchSessions( request.csBody, false );
+
+         if ( iWindows < 0 )
+         {
+            request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+            request.csMessage = PUTTYCS_MESSAGEBOX_LAUNCH_ERROR;
+
+            iLoop++;
+            continue;
+         }
+      }
+      else
+      {
+         request.csStatus = PUTTYCS_CHANNEL_STATUS_ERROR;
+         request.csMessage.Format( PUTTYCS_CHANNEL_UNKNOWN_VERB, (LPCTSTR) request.csVerb );
+
+         iLoop++;
+         continue;
+      }
+
+      double dElapsedMs = 
+         (m_seSendEngine.GetSendTrace().Now() - llStart) / 1000.0;
+
+      for ( ; iLoop < iNext; iLoop++ )
+      {
+         CHANNELREQUEST& done = pBatch->ElementAt( iLoop );
+
+         done.csStatus = iWindows ? 
+            PUTTYCS_CHANNEL_STATUS_OK : PUTTYCS_CHANNEL_STATUS_NO_WINDOWS;
+
+         done.iWindows = iWindows;
+         done.dElapsedMs = dElapsedMs;
+      }
+   }
+
+   // Sends of the batch chose CR themselves; the dialog's own sends
+   // go on with the preference
+
+   m_seSendEngine.SetSendCR( m_iSendCR );
+
+   RedrawWindow();
+
+   ::SetEvent( (HANDLE) wParam );
+
+   return TRUE;
+}
+
 /**
  * CPuTTYCSDialog::sendCommand( )
  */
 
 void CPuTTYCSDialog::sendCommand( CString csCommand, bool bTab ) 
 {
+   LoadCmdHistory();
+
    if ( m_csaCmdHistory.GetSize() == 
       PUTTYCS_PREF_CMDHISTORY_MAX_SIZE )
    {
@@ -2373,377 +3450,319 @@ void CPuTTYCSDialog::sendCommand( CString csCommand, bool bTab )
 
 /**
  * CPuTTYCSDialog::sendBuffer()
+ *
+ * Queues the buffer for the current filter; the send timer types
+ * it. A click while the queue is full beeps and is dropped.
  */
 
 void CPuTTYCSDialog::sendBuffer( CString csBuffer, bool bTab, bool bParse )
 {   
-   CString csIncToken;
-   csIncToken.Format( PUTTYCS_TOKEN_CHAR_TO_STRING, PUTTYCS_TOKEN_CHAR_INC);
-
-   CString csCtrlToken;
-   csCtrlToken.Format( PUTTYCS_TOKEN_CHAR_TO_STRING, PUTTYCS_TOKEN_CHAR_CTRL);
-   
-   CString csOutput = PUTTYCS_EMPTY_STRING;
-
-   if ( !bParse )
+   if ( m_sqSendQueue.Push(CSendEngine::GetUtf8(csBuffer), 
+           CSendEngine::GetUtf8(GetFilterEntry()), bTab, bParse, m_iSendCR) )
    {
-      csOutput = csBuffer;      
+      SetTimer( PUTTYCS_TIMER_SEND_QUEUE, PUTTYCS_TIMER_SEND_QUEUE_INTERVAL, NULL );
    }
    else
-   {     
-      csBuffer.Replace( PUTTYCS_TOKEN_INC, csIncToken );
-      csBuffer.Replace( PUTTYCS_TOKEN_CTRL, csCtrlToken );   
-      
-      for ( int iLoop = 0; iLoop < csBuffer.GetLength(); iLoop++ )
-      {
-         TCHAR chChar = csBuffer.GetAt(iLoop);
+   {
+      ::MessageBeep( MB_ICONEXCLAMATION );
+   }
 
-         if ( chChar == PUTTYCS_SENDKEY_CHAR_PLUS )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_PLUS;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_AT )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_AT;
-         } 
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_CARET )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_CARET;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_TILDE )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_TILDE;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_LEFTPAREN )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_LEFTPAREN;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_RIGHTPAREN )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_RIGHTPAREN;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_LEFTBRACE )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_LEFTBRACE;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_RIGHTBRACE )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_RIGHTBRACE;
-         }
-         else if ( chChar == PUTTYCS_SENDKEY_CHAR_PERCENT )
-         {
-            csOutput += PUTTYCS_SENDKEY_BUTTON_PERCENT;
-         }
-         else 
-         {
-            csOutput += chChar;
-         }
-      }
+   UpdateQueueStatus();
+}
+
+/**
+ * CPuTTYCSDialog::sendQueued()
+ *
+ * Types the oldest queued job, all its buffers in one activation
+ * per window
+ */
+
+void CPuTTYCSDialog::sendQueued()
+{
+   SENDJOB job;
 
+   if ( !m_sqSendQueue.Pop(job) )
+   {
+      return;
    }
-   
-   m_obaWindows.RemoveAll();
 
-   ::EnumWindows( enumwindowsProc, (LPARAM) this );    
-     
-   SortWindows();
+   m_seSendEngine.SetTransition( m_iTransition );
+   m_seSendEngine.SetPostSendDelay( m_iPostSendDelay );
+   m_seSendEngine.SetSendCR( job.iSendCR );
 
-   if ( m_obaWindows.GetSize() > 0 )
-   {      
-      for (int iLoop = 0; iLoop < m_obaWindows.GetSize(); iLoop++)
-      {
-         CString csInc;
-         csInc.Format( PUTTYCS_TOKEN_INT_TO_STRING, (iLoop + 1) );
+   CStringArray csaBuffers;
 
-         CString csTemp;
-         
-         csTemp += PUTTYCS_SENDKEY_DELAY_0;
-         csTemp += csOutput;
+   for ( size_t iLoop = 0; iLoop < job.vecBuffers.size(); iLoop++ )
+   {
+      csaBuffers.Add( CSendEngine::GetString(job.vecBuffers[iLoop]) );
+   }
 
-         csTemp.Replace( csIncToken, csInc );     
-         
-         if ( bParse )
-         {
-            csTemp.Replace( csCtrlToken, PUTTYCS_SENDKEY_BUTTON_CTRL );
+   m_seSendEngine.Send( csaBuffers, 
+      CSendEngine::GetString(job.sEntry), job.bTab, job.bParse );
 
-            if ( ::GetKeyState(VK_CAPITAL) )
-            {
-               csTemp.Insert(0, PUTTYCS_SENDKEY_BUTTON_CAPSLOCK);
-               csTemp += PUTTYCS_SENDKEY_BUTTON_CAPSLOCK;
-            }
+   RedrawWindow();
+}
 
-            if ( bTab )
-            {
-               csTemp += PUTTYCS_SENDKEY_BUTTON_TAB;
-            }
-            else if ( m_iSendCR )
-            {
-               csTemp += PUTTYCS_SENDKEY_BUTTON_ENTER;    
-            }    
-         }
+/**
+ * CPuTTYCSDialog::flushSendQueue()
+ *
+ * Types everything still queued, so sends that do not go through
+ * the queue keep their order after it
+ */
 
-         CWnd* pWnd =
-            (CWnd*) m_obaWindows.GetAt(iLoop);
+void CPuTTYCSDialog::flushSendQueue()
+{
+   KillTimer( PUTTYCS_TIMER_SEND_QUEUE );
 
-         pWnd->SendMessage(
-            WM_SYSCOMMAND, SC_HOTKEY, (LPARAM) pWnd->m_hWnd );
+   while ( !m_sqSendQueue.IsEmpty() )
+   {
+      sendQueued();
+   }
 
-         pWnd->SendMessage(
-            WM_SYSCOMMAND, SC_RESTORE, (LPARAM) pWnd->m_hWnd );         
+   UpdateQueueStatus();
+}
 
-         pWnd->ShowWindow( SW_SHOW );
+/**
+ * CPuTTYCSDialog::UpdateQueueStatus()
+ *
+ * Shows queued and rejected sends in the title bar
+ */
 
-         pWnd->SetForegroundWindow();
+void CPuTTYCSDialog::UpdateQueueStatus()
+{
+   CString csTitle = m_iToolWindow ? 
+      PUTTYCS_WINDOW_TITLE_TOOL : PUTTYCS_WINDOW_TITLE_APP;
 
-         pWnd->SetFocus();      
+   if ( m_sqSendQueue.IsSaturated() )
+   {
+      csTitle += PUTTYCS_WINDOW_TITLE_QUEUE_FULL;
+   }
+   else if ( m_sqSendQueue.GetPending() > 0 )
+   {
+      CString csQueued;
+      csQueued.Format( PUTTYCS_WINDOW_TITLE_QUEUED_FORMAT, (int) m_sqSendQueue.GetPending() );
 
-         ::Sleep( m_iTransition ); 
+      csTitle += csQueued;
+   }
 
-         m_skSendKeys.SendKeys( (LPCTSTR) csTemp );
-         
-         ::Sleep( m_iPostSendDelay );            
-      }          
+   if ( !m_slSessionLauncher.IsFinished() )
+   {
+      int iHosts = (int) m_slSessionLauncher.GetResults().size();
+
+      CString csLaunching;
+      csLaunching.Format( PUTTYCS_WINDOW_TITLE_LAUNCHING_FORMAT, 
+         iHosts - (int) m_slSessionLauncher.GetCount(CSessionLauncher::LAUNCH_PENDING) - 
+            (int) m_slSessionLauncher.GetCount(CSessionLauncher::LAUNCH_STARTING), 
+         iHosts );
+
+      csTitle += csLaunching;
    }
 
-   RedrawWindow();
+   CString csCurrent;
+   GetWindowText( csCurrent );
+
+   if ( csCurrent != csTitle )
+   {
+      SetWindowText( csTitle );
+   }
 }
 
 /**
- * CPuTTYCSDialog::enumwindowsProc()
+ * CPuTTYCSDialog::SaveLayout()
+ *
+ * Saves the layout of all PuTTY windows as csName, replacing a
+ * layout of that name. Returns the number of windows, or -1 if there
+ * is no room for another layout.
  */
 
-BOOL CALLBACK CPuTTYCSDialog::enumwindowsProc( HWND hwnd, LPARAM lParam )
+int CPuTTYCSDialog::SaveLayout( CString csName )
 {
-   CPuTTYCSDialog* pDialog = (CPuTTYCSDialog*) lParam;
-
-   CObArray* pWindowArray =
-      &pDialog->m_obaWindows;
+   int iSnapshot = FindLayout( csName );
 
-   if ( hwnd == NULL )
+   if ( (iSnapshot < 0) && (m_csaSnapshots.GetSize() >= PUTTYCS_PREF_SNAPSHOT_MAX_SIZE) )
    {
-      return false;
+      return -1;
    }
 
-   TCHAR szClass[300];  
+   CString csSaved;
 
-   ::GetClassName( hwnd, szClass, sizeof(szClass) );
+   int iWindows = m_seSendEngine.SaveSnapshot( csName, csSaved );
 
-   if ( (!_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PUTTY)) 
-     || (!_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PUTTYTEL)) 
-     || (!_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_TUTTY)) 
-     || (!_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PIETTY)) )
+   if ( iWindows == 0 )
+   {
+      return 0;
+   }
 
-   {      
-      TCHAR szTitle[300];  
-      ::GetWindowText(hwnd, szTitle, sizeof(szTitle));
+   if ( iSnapshot < 0 )
+   {
+      m_csaSnapshots.Add( csSaved );
+   }
+   else
+   {
+      m_csaSnapshots.SetAt( iSnapshot, csSaved );
+   }
 
-      CString csEntry =
-         ((pDialog->m_bIsClosing) || (pDialog->m_bFindAll)) ? PUTTYCS_FILTER_ALL :
-         pDialog->m_csaFilters.GetAt(pDialog->m_iFilter);
-     
-      csEntry = csEntry.Mid(
-         csEntry.Find(PUTTYCS_FILTER_NAME_SEPARATOR) + 2 ) +
-            PUTTYCS_FILTER_SEPARATOR;
-                
-      bool bInclude = false;
-      bool bExclude = false;
-      
-      CString csFilter =
-         PUTTYCS_EMPTY_STRING;
+   /**
+    * Written at once, a layout should survive a crash. All slots,
+    * since empty ones were skipped on load.
+    */
 
-      for ( int iLoop = 0; iLoop < csEntry.GetLength(); iLoop++ )
-      {
-         TCHAR ch = csEntry.GetAt(iLoop);
+   for ( int iLoop = 0; iLoop < PUTTYCS_PREF_SNAPSHOT_MAX_SIZE; iLoop++ )
+   {     
+      CString csAttribute;
+      csAttribute.Format( PUTTYCS_PREF_SNAPSHOT_ENTRY, iLoop );
 
-         if ( ch == PUTTYCS_FILTER_SEPARATOR )
-         {
-            if ( !csFilter.IsEmpty() )
-            {
-               csFilter.TrimLeft();
-               csFilter.TrimRight();
-            
-               if ( (csFilter.GetAt(0) == PUTTYCS_FILTER_INCLUDE) || 
-                    (csFilter.GetAt(0) != PUTTYCS_FILTER_EXCLUDE))              
-               {
-                  if ( !bInclude )
-                  {            
-                     if ( csFilter.GetAt(0) == PUTTYCS_FILTER_INCLUDE )
-                     {
-                        csFilter =
-                           csFilter.Right( csFilter.GetLength() - 1 );
-                     }
-            
-                     bInclude =
-                        (wildcmp(szTitle, (LPCTSTR) csFilter ) != 0);               
-                  }                        
-               }
-               else
-               {  
-                  if ( !bExclude )
-                  {
-                     csFilter =
-                        csFilter.Right( csFilter.GetLength() - 1 );
-            
-                     bExclude =
-                        (wildcmp( szTitle, (LPCTSTR) csFilter ) != 0);               
-                  }
-               }
+      CString csValue = PUTTYCS_EMPTY_STRING;
 
-               csFilter =
-                  PUTTYCS_EMPTY_STRING;
-            }
-         }
-         else
-         {
-            csFilter += ch;
-         }
+      if ( iLoop < m_csaSnapshots.GetSize() )
+      {
+         csValue = m_csaSnapshots.GetAt( iLoop );
       }
 
-      if ( bInclude && !bExclude )
-      {    
-         pWindowArray->Add( CWnd::FromHandle(hwnd) );
-      }              
+      AfxGetApp()->WriteProfileString(
+         PUTTYCS_APP_NAME, csAttribute, csValue );
    }
-  
-   return true;
+
+   UpdateLayoutMenu();
+
+   return iWindows;
 }
 
 /**
- * CPuTTYCSDialog::MovePuttyWnd(CWnd* pWnd)
+ * CPuTTYCSDialog::RestoreLayout()
+ *
+ * Returns the number of windows placed, or -1 if there is no layout
+ * named csName
  */
 
-void CPuTTYCSDialog::MovePuttyWnd(CWnd* pWnd, int iX, int iY, int iSizeX, int iSizeY) 
+int CPuTTYCSDialog::RestoreLayout( CString csName )
 {
-   if (pWnd)
-   {
-      HWND hWnd = pWnd->GetSafeHwnd();
+   int iSnapshot = FindLayout( csName );
 
-      if (hWnd)
-      {
-         ::SendMessage(hWnd, WM_SYSCOMMAND, SC_RESTORE, 0);
-         ::ShowWindow(hWnd, SW_HIDE);
-         ::SetWindowPos(hWnd, NULL, iX, iY, iSizeX, iSizeY,NULL);
-         ::SendMessage(hWnd, WM_ENTERSIZEMOVE, 0, 0);
-         ::SendMessage(hWnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(iSizeX, iSizeY));
-         ::SendMessage(hWnd, WM_EXITSIZEMOVE, 0, 0);
-         ::SendMessage(hWnd, WM_SYSCOMMAND, SC_MINIMIZE, 0);
-         ::SendMessage(hWnd, WM_SYSCOMMAND, SC_RESTORE, 0);       
-      }
+   if ( iSnapshot < 0 )
+   {
+      return -1;
    }
+
+   int iWindows = m_seSendEngine.RestoreSnapshot( m_csaSnapshots.GetAt(iSnapshot) );
+
+   RefreshDialog();
+
+   return iWindows;
 }
 
 /**
- * CPuTTYCSDialog::wildcmp()
+ * CPuTTYCSDialog::FindLayout()
  */
 
-int CPuTTYCSDialog::wildcmp( const TCHAR* s1, const TCHAR* wild )
-{  
-   const TCHAR* cp = NULL;
-   const TCHAR* mp = NULL;
-
-   while ( (*s1) && 
-           (*wild != PUTTYCS_WILDCMP_WILDCARD) ) 
+int CPuTTYCSDialog::FindLayout( CString csName )
+{
+   for ( int iLoop = 0; iLoop < m_csaSnapshots.GetSize(); iLoop++ )
    {
-      if ( (*wild != *s1) && 
-           (*wild != PUTTYCS_WILDCMP_ANYCHAR) ) 
+      if ( !CSendEngine::GetSnapshotName(m_csaSnapshots.GetAt(iLoop)).CompareNoCase(csName) )
       {
-         return 0;
+         return iLoop;
       }
-
-      wild++;
-      s1++;
    }
 
-   while ( *s1 ) 
+   return -1;
+}
+
+/**
+ * CPuTTYCSDialog::UpdateLayoutMenu()
+ *
+ * Lists the saved layouts in the Restore window layout submenu of
+ * the system menu
+ */
+
+void CPuTTYCSDialog::UpdateLayoutMenu()
+{
+   if ( !m_hLayoutMenu )
    {
-      if ( *wild == PUTTYCS_WILDCMP_WILDCARD ) 
-      {
-         if ( !*++wild ) 
-         {
-            return 1;
-         }
+      return;
+   }
 
-         mp = wild;
-         cp = s1 + 1;
-      } 
-      else if ( (*wild == *s1) || 
-                (*wild == PUTTYCS_WILDCMP_ANYCHAR) ) 
-      {
-         wild++;
-         s1++;
-      }
-      else 
-      {
-         wild = mp;
-         s1 = cp++;
-      }
+   CMenu* pMenu = CMenu::FromHandle( m_hLayoutMenu );
+
+   while ( pMenu->GetMenuItemCount() > 0 )
+   {
+      pMenu->DeleteMenu( 0, MF_BYPOSITION );
    }
 
-   while ( *wild == PUTTYCS_WILDCMP_WILDCARD ) 
+   for ( int iLoop = 0; iLoop < m_csaSnapshots.GetSize(); iLoop++ )
    {
-      wild++;
+      pMenu->AppendMenu( MF_STRING, IDM_RESTORE_LAYOUT + (iLoop << 4),
+         CSendEngine::GetSnapshotName(m_csaSnapshots.GetAt(iLoop)) );
    }
 
-   return !*wild;
+   if ( m_csaSnapshots.GetSize() == 0 )
+   {
+      pMenu->AppendMenu( MF_STRING | MF_GRAYED, 
+         IDM_RESTORE_LAYOUT, PUTTYCS_WINDOW_TITLE_NO_LAYOUTS );
+   }
 }
 
 /**
- * CPuTTYCSDialog::SortWindows()
+ * CPuTTYCSDialog::LaunchSessions()
+ *
+ * Starts opening a session for each host of a host list or
+ * inventory; the launch timer does the rest. Returns the number of
+ * hosts, or -1 if the file can not be read.
  */
 
-void CPuTTYCSDialog::SortWindows()
+int CPuTTYCSDialog::LaunchSessions( CString csFilename, bool bInteractive )
 {
-   std::sort(
-      m_obaWindows.GetData(),
-      m_obaWindows.GetData() + 
-         m_obaWindows.GetSize(),
-      Compare );
+   std::vector<std::string> vecHosts;
+
+   if ( !CSessionLauncher::ReadHosts(CSendEngine::GetUtf8(csFilename), vecHosts) )
+   {
+      return -1;
+   }
+
+   m_slSessionLauncher.SetCommand( CSendEngine::GetUtf8(m_csLaunchCommand) );
+   m_slSessionLauncher.SetConcurrency( m_iLaunchConcurrency );
+   m_slSessionLauncher.SetRate( m_iLaunchRate );
+   m_slSessionLauncher.SetWindowTimeout( m_iLaunchWindowTimeout );
+
+   int iHosts = m_slSessionLauncher.Start( vecHosts );
+
+   m_bLaunchInteractive = bInteractive;
+
+   SetTimer( PUTTYCS_TIMER_LAUNCH, 1, NULL );
+
+   UpdateQueueStatus();
+
+   return iHosts;
 }
 
 /**
- * CPuTTYCSDialog::Compare()
+ * CPuTTYCSDialog::FindWindows()
+ *
+ * Fills m_vecWindows with the PuTTY windows of a filter
  */
 
-int CPuTTYCSDialog::Compare( const void *pWndS1, const void *pWndS2 )
+int CPuTTYCSDialog::FindWindows( CString csEntry, bool bPins )
 {
-   CWnd* pWnd1 = (CWnd*) pWndS1;
-   CWnd* pWnd2 = (CWnd*) pWndS2;
-
-   CString csS1;
-   ((CWnd*) pWnd1)->GetWindowText( csS1 );
-
-   CString csS2;
-   ((CWnd*) pWnd2)->GetWindowText( csS2 );
-    
-   return ( csS1 < csS2 );
+   return m_seSendEngine.FindWindows( csEntry, m_vecWindows, bPins );
 }
 
 /**
- * CPuTTYCSDialog::GetAttributeValue()
+ * CPuTTYCSDialog::MovePuttyWnd(HWND hWnd)
  */
 
-CString CPuTTYCSDialog::GetAttributeValue( CString csLine, CString csAttribute )
+void CPuTTYCSDialog::MovePuttyWnd(HWND hWnd, int iX, int iY, int iSizeX, int iSizeY) 
 {
-   CString csValue = PUTTYCS_EMPTY_STRING;
-   
-   CString csSearch;
-   csSearch.Format( PUTTYCS_TOKEN_ATTRIBUTE_START, csAttribute );
-   
-   int iIndex = csLine.Find( csSearch );
-
-   if ( iIndex != -1 )
+   if (hWnd)
    {
-      iIndex += csSearch.GetLength();
-
-      int iIndex2 = csLine.Find( PUTTYCS_TOKEN_ATTRIBUTE_END, iIndex );
-
-      if ( iIndex2 != -1 )
-      {
-         csValue = csLine.Mid( iIndex, (iIndex2 - iIndex) );
-      }
+      ::SendMessage(hWnd, WM_SYSCOMMAND, SC_RESTORE, 0);
+      ::ShowWindow(hWnd, SW_HIDE);
+      ::SetWindowPos(hWnd, NULL, iX, iY, iSizeX, iSizeY,NULL);
+      ::SendMessage(hWnd, WM_ENTERSIZEMOVE, 0, 0);
+      ::SendMessage(hWnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(iSizeX, iSizeY));
+      ::SendMessage(hWnd, WM_EXITSIZEMOVE, 0, 0);
+      ::SendMessage(hWnd, WM_SYSCOMMAND, SC_MINIMIZE, 0);
+      ::SendMessage(hWnd, WM_SYSCOMMAND, SC_RESTORE, 0);       
    }
-
-   return csValue;
 }
 
 #ifndef UNICODE
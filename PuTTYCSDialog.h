@@ -72,6 +72,14 @@ LPTSTR *WINAPI CommandLineToArgvT(LPCTSTR lpCmdLine, int *lpArgc);
 #endif
 
 #include "CommandEdit.h"
+#include "SendEngine.h"
+#include "CommandChannel.h"
+#include "UpdateCheck.h"
+#include "StartupProfile.h"
+#include "KeyMirror.h"
+#include "SendQueue.h"
+#include "SessionLauncher.h"
+#include "Win32ProcessSpawner.h"
 
 class CPuTTYCSDialog : public CDialog
 {
@@ -81,7 +89,7 @@ public:
    CPuTTYCSDialog(CWnd* pParent = NULL);   // standard constructor
    ~CPuTTYCSDialog();
       
-   CObArray* GetAllWindows();
+   const std::vector<WINDOWINFO>& GetAllWindows();
    
 // Dialog Data
    //{{AFX_DATA(CPuTTYCSDialog)
@@ -105,7 +113,6 @@ protected:
    HICON m_hIcon;
 
    bool m_bIsClosing;  
-   bool m_bFindAll; 
 
    int m_iDialogHeight;
 
@@ -116,6 +123,13 @@ protected:
    CStringArray m_csaFilters;
    int m_iFilter;
 
+   /**
+    * Window layouts, as saved by CSendEngine::SaveSnapshot()
+    */
+
+   CStringArray m_csaSnapshots;
+   HMENU m_hLayoutMenu;
+
     /**
     * Command history
     */
@@ -147,6 +161,13 @@ protected:
    
    int m_iTileMethod;
 
+   /**
+    * Terminal tile cell size
+    */
+
+   int m_iTileCellWidth;
+   int m_iTileCellHeight;
+
    /**
     * Cascade dimensions
     */ 
@@ -186,6 +207,36 @@ protected:
    int m_iTransition;
    int m_iPostSendDelay;
 
+   int m_iAutoTuneDelays;
+   int m_iAutoTuneMin;
+   int m_iAutoTuneMax;
+
+   /** 
+    * Script pacing
+    */
+
+   CString m_csScriptPrompt;
+   int m_iScriptLineTimeout;
+
+   CString m_csSessionLog;
+
+   int m_iScriptCache;
+
+   /** 
+    * Per-host variables
+    */
+
+   CString m_csInventoryFile;
+
+   /** 
+    * Session launcher
+    */
+
+   CString m_csLaunchCommand;
+   int m_iLaunchConcurrency;
+   int m_iLaunchRate;
+   int m_iLaunchWindowTimeout;
+
    /**
     * Fonts
     */
@@ -193,22 +244,53 @@ protected:
    CFont* m_pMarlettNormal;
    CFont* m_pMarlettSmall;
    CFont* m_pSymbolSmall;
+
+   CFont* GetMarlettNormalFont();
+   CFont* GetMarlettSmallFont();
+   CFont* GetSymbolSmallFont();
+
+   static CFont* CreateLazyFont( CFont*& pFont, int iPointSize, LPCTSTR lpszFaceName );
     
    void sendCommand( CString csCommand, bool bTab );
    void sendBuffer( CString csBuffer, bool bParse = false, bool bTab = false );
+   void sendQueued();
+   void flushSendQueue();
+   void UpdateQueueStatus();
+
+   int LaunchSessions( CString csFilename, bool bInteractive );
    
    void LoadPreferences();
    void SavePreferences();
 
+   void LoadCmdHistory();
+   void UpdateCmdHistoryButtons();
+
+   void FillFiltersCombobox();
+
+   static bool ReadProfileSection( CMapStringToString& mapValues );
+   static CString GetProfileValue( const CMapStringToString* pValues, CString csKey );
+
    void UpdateDialog();
    void RefreshDialog();
 
    void SendScript( CString csFilename );
+   int RunScript( CString csFilename, CString csEntry );
+   bool LoadScript( CString csFilename, CStringArray& csaLines );
+
+   CString GetFilterEntry();
+
+   bool ExportTrace( CString csFilename );
 
-   void MovePuttyWnd(CWnd* pWnd, int iX, int intY, int iSizeX, int iSizeY);
+   int SaveLayout( CString csName );
+   int RestoreLayout( CString csName );
+   int FindLayout( CString csName );
+   void UpdateLayoutMenu();
+
+   void MovePuttyWnd(HWND hWnd, int iX, int intY, int iSizeX, int iSizeY);
 
    void SetRunOnSystemStartup( bool bEnable = true );
    void CheckForUpdates(bool bInteractive = false);
+   void ShowUpdateResult(CString csVersion, bool bSucceeded);
 
    void ParseCmdLineOptions(LPTSTR pCmdLine = NULL);
 
@@ -227,6 +309,7 @@ protected:
    afx_msg void OnHideButton();   
    afx_msg void OnFiltersButton();
    afx_msg void OnSendCRPushButton();      
+   afx_msg void OnLivePushButton();
    afx_msg void OnCmdHistoryUpButton();
    afx_msg void OnCmdHistoryDownButton();   
    afx_msg void OnUpButton();
@@ -255,13 +338,40 @@ protected:
 	afx_msg void OnCtrlDButton();
 	afx_msg void OnCtrlRButton();
 	afx_msg BOOL OnCopyData(CWnd* pWnd, COPYDATASTRUCT* pCopyDataStruct);
+   afx_msg LRESULT OnChannelBatch(WPARAM wParam, LPARAM lParam);
+   afx_msg LRESULT OnUpdateChecked(WPARAM wParam, LPARAM lParam);
+   afx_msg LRESULT OnDeferredInit(WPARAM wParam, LPARAM lParam);
+   afx_msg void OnDropDownFiltersCombobox();
+   afx_msg void OnTimer(UINT_PTR nIDEvent);
 	//}}AFX_MSG
    DECLARE_MESSAGE_MAP()   
 
 private:
 
-   CSendKeys m_skSendKeys;
-   CObArray  m_obaWindows;
+   CSendEngine m_seSendEngine;
+   CCommandChannel m_ccCommandChannel;
+   CUpdateCheck m_ucUpdateCheck;
+
+   bool m_bUpdateInteractive;
+
+   CString m_csFilterOverride;
+
+   CStartupProfile m_spStartupProfile;
+
+   CKeyMirror m_kmKeyMirror;
+   CString m_csLiveCommand;
+
+   CSendQueue m_sqSendQueue;
+
+   CWin32ProcessSpawner m_psProcessSpawner;
+   CSessionLauncher m_slSessionLauncher;
+   bool m_bLaunchInteractive;
+
+   bool m_bCmdHistoryLoaded;
+   bool m_bFiltersFilled;
+
+   CString m_csTraceFile;
+   std::vector<WINDOWINFO> m_vecWindows;   // reused by FindWindows()
 
    UINT m_uiTaskbarMessage;
    BOOL m_bDisablePopup;
@@ -269,14 +379,10 @@ private:
    NOTIFYICONDATA* m_pTNI;
    void SetSysTrayTip( CString csTip = PUTTYCS_EMPTY_STRING );
 
-   static BOOL CALLBACK enumwindowsProc(HWND hwnd, LPARAM lParam); 
-   static int wildcmp(const TCHAR* wild, const TCHAR* string);
-   
-   void SortWindows();
-   static int Compare(const void* pWndS1, const void* pWndS2);
+   int FindWindows( CString csEntry, bool bPins = true );
 
-   static CString GetAttributeValue(const CString, const CString);
    CMenu* m_pMenu;  
+   CMenu* GetTrayMenu();
 };
 
 //{{AFX_INSERT_LOCATION}}
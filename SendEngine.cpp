@@ -0,0 +1,640 @@
+/**
+ * SendEngine.cpp - PuTTYCS send engine
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "SendEngine.h"
+#include "FilterMatch.h"
+#include "KeyProgramCache.h"
+#include "LogTail.h"
+#include "ScriptPacer.h"
+#include "WindowSnapshot.h"
+
+#include <shlobj.h>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * CSendEngine::CSendEngine()
+ */
+
+CSendEngine::CSendEngine() : m_beBroadcastEngine( &m_wsWindowSystem )
+{
+}
+
+/**
+ * CSendEngine::~CSendEngine()
+ */
+
+CSendEngine::~CSendEngine()
+{
+}
+
+/**
+ * CSendEngine::SetTransition()
+ */
+
+void CSendEngine::SetTransition( int iTransition )
+{
+   m_beBroadcastEngine.SetTransition( iTransition );
+}
+
+/**
+ * CSendEngine::SetPostSendDelay()
+ *
+ * The delay is also the floor of every post send wait, which tuning
+ * may raise but not lower
+ */
+
+void CSendEngine::SetPostSendDelay( int iPostSendDelay )
+{
+   m_beBroadcastEngine.SetPostSendDelay( iPostSendDelay );
+   m_wsWindowSystem.SetInputIdleFloor( (iPostSendDelay > 0) ? (unsigned long) iPostSendDelay : 0 );
+}
+
+/**
+ * CSendEngine::SetSendCR()
+ */
+
+void CSendEngine::SetSendCR( int iSendCR )
+{
+   m_beBroadcastEngine.SetSendCR( iSendCR );
+}
+
+/**
+ * CSendEngine::SetProgramCache()
+ *
+ * Sends replay the programs of pCache, NULL to parse the keys again
+ */
+
+void CSendEngine::SetProgramCache( CKeyProgramCache* pCache )
+{
+   m_wsWindowSystem.SetProgramCache( pCache );
+}
+
+/**
+ * CSendEngine::SetFilters()
+ *
+ * The saved filters, so a filter can combine others with +@name,
+ * -@name and &@name
+ */
+
+void CSendEngine::SetFilters( const CStringArray& csaFilters )
+{
+   std::vector<std::string> vecFilters;
+   vecFilters.reserve( csaFilters.GetSize() );
+
+   for ( int iLoop = 0; iLoop < csaFilters.GetSize(); iLoop++ )
+   {
+      vecFilters.push_back( GetUtf8(csaFilters.GetAt(iLoop)) );
+   }
+
+   m_beBroadcastEngine.SetFilters( vecFilters );
+}
+
+/**
+ * CSendEngine::SetInventory()
+ *
+ * The CSV or TSV file of the {%VAR:name%} tokens, read again when
+ * it changes
+ */
+
+void CSendEngine::SetInventory( CString csPath )
+{
+   m_beBroadcastEngine.SetInventory( GetUtf8(csPath) );
+}
+
+/**
+ * CSendEngine::GetDelayTuner()
+ */
+
+CDelayTuner& CSendEngine::GetDelayTuner()
+{
+   return m_beBroadcastEngine.GetDelayTuner();
+}
+
+/**
+ * CSendEngine::GetSendTrace()
+ */
+
+CSendTrace& CSendEngine::GetSendTrace()
+{
+   return m_beBroadcastEngine.GetSendTrace();
+}
+
+/**
+ * CSendEngine::GetBroadcastEngine()
+ */
+
+CBroadcastEngine& CSendEngine::GetBroadcastEngine()
+{
+   return m_beBroadcastEngine;
+}
+
+/**
+ * CSendEngine::GetUtf8()
+ *
+ * ANSI builds hold text in the ANSI code page, which gets to UTF-8
+ * through UTF-16
+ */
+
+std::string CSendEngine::GetUtf8( const CString& csString )
+{
+#ifdef _UNICODE
+   const WCHAR* pszWide = csString;
+   int iWide = csString.GetLength();
+#else
+   int iWide = ::MultiByteToWideChar( 
+      CP_ACP, 0, csString, csString.GetLength(), NULL, 0 );
+
+   std::wstring wsString( (iWide > 0) ? iWide : 0, L'\0' );
+
+   if ( iWide > 0 )
+   {
+      ::MultiByteToWideChar( CP_ACP, 0, csString, csString.GetLength(), 
+         &wsString[0], iWide );
+   }
+
+   const WCHAR* pszWide = wsString.c_str();
+#endif
+
+   int iLength = (iWide > 0) ? ::WideCharToMultiByte( 
+      CP_UTF8, 0, pszWide, iWide, NULL, 0, NULL, NULL ) : 0;
+
+   std::string sString( (iLength > 0) ? iLength : 0, '\0' );
+
+   if ( iLength > 0 )
+   {
+      ::WideCharToMultiByte( CP_UTF8, 0, pszWide, iWide, 
+         &sString[0], iLength, NULL, NULL );
+   }
+
+   return sString;
+}
+
+/**
+ * CSendEngine::GetString()
+ *
+ * Back from UTF-8, to the ANSI code page in ANSI builds
+ */
+
+CString CSendEngine::GetString( const std::string& sUtf8 )
+{
+   CString csString;
+
+   int iWide = ::MultiByteToWideChar( 
+      CP_UTF8, 0, sUtf8.data(), (int) sUtf8.size(), NULL, 0 );
+
+   if ( iWide <= 0 )
+   {
+      return csString;
+   }
+
+#ifdef _UNICODE
+   ::MultiByteToWideChar( CP_UTF8, 0, sUtf8.data(), (int) sUtf8.size(), 
+      csString.GetBuffer(iWide), iWide );
+
+   csString.ReleaseBuffer( iWide );
+#else
+   std::wstring wsString( iWide, L'\0' );
+
+   ::MultiByteToWideChar( CP_UTF8, 0, sUtf8.data(), (int) sUtf8.size(), 
+      &wsString[0], iWide );
+
+   int iLength = ::WideCharToMultiByte( 
+      CP_ACP, 0, wsString.data(), iWide, NULL, 0, NULL, NULL );
+
+   if ( iLength > 0 )
+   {
+      ::WideCharToMultiByte( CP_ACP, 0, wsString.data(), iWide, 
+         csString.GetBuffer(iLength), iLength, NULL, NULL );
+
+      csString.ReleaseBuffer( iLength );
+   }
+#endif
+
+   return csString;
+}
+
+/**
+ * CSendEngine::GetFilterName()
+ */
+
+CString CSendEngine::GetFilterName( CString csEntry )
+{
+   return GetString( CFilterMatch::GetFilterName(GetUtf8(csEntry)) );
+}
+
+/**
+ * CSendEngine::GetFilterList()
+ */
+
+CString CSendEngine::GetFilterList( CString csEntry )
+{
+   return GetString( CFilterMatch::GetFilterList(GetUtf8(csEntry)) );
+}
+
+/**
+ * CSendEngine::GetFilterPrompt()
+ */
+
+CString CSendEngine::GetFilterPrompt( CString csEntry )
+{
+   return GetString( CFilterMatch::GetFilterPrompt(GetUtf8(csEntry)) );
+}
+
+/**
+ * CSendEngine::IsValidPrompt()
+ */
+
+bool CSendEngine::IsValidPrompt( CString csPrompt )
+{
+   return CScriptPacer::IsValidPrompt( GetUtf8(csPrompt) );
+}
+
+/**
+ * CSendEngine::GetSessionLog()
+ *
+ * The log file of the PuTTY window titled csTitle, from a PuTTY log
+ * file name: &H is the title without " - PuTTY", &Y, &M and &D
+ * today's date and && is &
+ */
+
+CString CSendEngine::GetSessionLog( CString csLogPattern, CString csTitle )
+{
+   CString csHost = csTitle;
+
+   int iSuffix = csHost.Find( PUTTYCS_PUTTY_TITLE_SUFFIX );
+
+   if ( (iSuffix != -1) && 
+        (iSuffix + (int) _tcslen(PUTTYCS_PUTTY_TITLE_SUFFIX) == csHost.GetLength()) )
+   {
+      csHost = csHost.Left( iSuffix );
+   }
+
+   CTime ctNow = CTime::GetCurrentTime();
+
+   CString csLog;
+
+   for ( int iLoop = 0; iLoop < csLogPattern.GetLength(); iLoop++ )
+   {
+      TCHAR ch = csLogPattern.GetAt( iLoop );
+
+      if ( (ch != _T('&')) || (iLoop + 1 == csLogPattern.GetLength()) )
+      {
+         csLog += ch;
+         continue;
+      }
+
+      switch ( csLogPattern.GetAt(++iLoop) )
+      {
+      case _T('H'): csLog += csHost; break;
+      case _T('Y'): csLog += ctNow.Format( _T("%Y") ); break;
+      case _T('M'): csLog += ctNow.Format( _T("%m") ); break;
+      case _T('D'): csLog += ctNow.Format( _T("%d") ); break;
+      case _T('&'): csLog += _T('&'); break;
+
+      default:
+         csLog += ch;
+         csLog += csLogPattern.GetAt( iLoop );
+         break;
+      }
+   }
+
+   return csLog;
+}
+
+/**
+ * CSendEngine::GetCacheDirectory()
+ *
+ * Where compiled scripts are kept, PuTTYCS\Cache in the local
+ * application data folder. Empty if there is none.
+ */
+
+CString CSendEngine::GetCacheDirectory()
+{
+   TCHAR szPath[MAX_PATH];
+
+   if ( FAILED(::SHGetFolderPath(NULL, CSIDL_LOCAL_APPDATA | CSIDL_FLAG_CREATE, 
+                                 NULL, SHGFP_TYPE_CURRENT, szPath)) )
+   {
+      return PUTTYCS_EMPTY_STRING;
+   }
+
+   CString csDirectory = szPath;
+   csDirectory += PUTTYCS_CACHE_DIRECTORY;
+
+   ::CreateDirectory( csDirectory, NULL );
+
+   return csDirectory + PUTTYCS_CACHE_SUBDIRECTORY;
+}
+
+/**
+ * CSendEngine::ResolveFilter()
+ *
+ * csName is the name of one of csaFilters, or a filter expression
+ * when it starts with + or -
+ */
+
+bool CSendEngine::ResolveFilter( const CStringArray& csaFilters, CString csName, CString& csEntry )
+{
+   std::vector<std::string> vecFilters;
+   vecFilters.reserve( csaFilters.GetSize() );
+
+   for ( int iLoop = 0; iLoop < csaFilters.GetSize(); iLoop++ )
+   {
+      vecFilters.push_back( GetUtf8(csaFilters.GetAt(iLoop)) );
+   }
+
+   std::string sEntry;
+
+   if ( !CFilterMatch::ResolveFilter(vecFilters, GetUtf8(csName), sEntry) )
+   {
+      return false;
+   }
+
+   csEntry = GetString( sEntry );
+
+   return true;
+}
+
+/**
+ * CSendEngine::Send()
+ *
+ * Returns the number of windows the buffer was typed into
+ */
+
+int CSendEngine::Send( CString csBuffer, CString csEntry, bool bTab, bool bParse,
+                       CSendResultArray* pResults )
+{
+   CStringArray csaBuffers;
+   csaBuffers.Add( csBuffer );
+
+   return Send( csaBuffers, csEntry, bTab, bParse, pResults );
+}
+
+/**
+ * CSendEngine::Send()
+ *
+ * Types several buffers into each window in one activation, so a
+ * batch of commands costs one window switch per window instead of
+ * one per command
+ */
+
+int CSendEngine::Send( const CStringArray& csaBuffers, CString csEntry, bool bTab, bool bParse,
+                       CSendResultArray* pResults )
+{
+   std::vector<std::string> vecBuffers;
+   vecBuffers.reserve( csaBuffers.GetSize() );
+
+   for ( int iBuffer = 0; iBuffer < csaBuffers.GetSize(); iBuffer++ )
+   {
+      vecBuffers.push_back( GetUtf8(csaBuffers.GetAt(iBuffer)) );
+   }
+
+   std::vector<BROADCASTRESULT> vecResults;
+
+   int iWindows = m_beBroadcastEngine.Send( vecBuffers, GetUtf8(csEntry), bTab, bParse, 
+      pResults ? &vecResults : NULL );
+
+   for ( size_t iLoop = 0; iLoop < vecResults.size(); iLoop++ )
+   {
+      const BROADCASTRESULT& broadcast = vecResults[iLoop];
+
+      SENDRESULT result;
+      result.hWnd = CWin32WindowSystem::GetHwnd( broadcast.id );
+      result.csTitle = GetString( broadcast.sTitle );
+      result.bForeground = broadcast.bForeground;
+      result.dActivateMs = broadcast.dActivateMs;
+      result.dTransitionMs = broadcast.dTransitionMs;
+      result.dSendMs = broadcast.dSendMs;
+      result.dPostSendMs = broadcast.dPostSendMs;
+      result.dTotalMs = broadcast.dTotalMs;
+
+      pResults->Add( result );
+   }
+
+   return iWindows;
+}
+
+/**
+ * CSendEngine::SendScript()
+ *
+ * Sends a script a line at a time, each window getting its next line
+ * once its PuTTY session log (see GetSessionLog()) shows csPrompt
+ * again, or after ulLineTimeout ms. Windows without a log get their
+ * lines back to back. Returns the number of windows.
+ */
+
+int CSendEngine::SendScript( const CStringArray& csaLines, CString csEntry, CString csPrompt,
+                             CString csLogPattern, unsigned long ulLineTimeout )
+{
+   std::vector<std::string> vecLines;
+   vecLines.reserve( csaLines.GetSize() );
+
+   for ( int iLine = 0; iLine < csaLines.GetSize(); iLine++ )
+   {
+      vecLines.push_back( GetUtf8(csaLines.GetAt(iLine)) );
+   }
+
+   CScriptPacer spPacer( &m_beBroadcastEngine );
+   spPacer.SetPrompt( GetUtf8(csPrompt) );
+   spPacer.SetLineTimeout( ulLineTimeout );
+
+   int iWindows = spPacer.Start( vecLines, GetUtf8(csEntry), false, false );
+
+   std::vector<WINDOWINFO> vecWindows;
+   spPacer.GetTargets( vecWindows );
+
+   // Open the logs before the first line, so its output is seen
+
+   std::vector<CLogTail> vecLogTails( vecWindows.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      CString csLog = GetSessionLog( csLogPattern, GetString(vecWindows[iLoop].sTitle) );
+
+      if ( csLogPattern.IsEmpty() || !vecLogTails[iLoop].Open(GetUtf8(csLog)) )
+      {
+         spPacer.SetWatched( vecWindows[iLoop].id, false );
+      }
+   }
+
+   spPacer.Run( [&spPacer, &vecWindows, &vecLogTails]( int iTimeoutMs )
+   {
+      ::Sleep( iTimeoutMs );
+
+      for ( size_t iLoop = 0; iLoop < vecLogTails.size(); iLoop++ )
+      {
+         WINDOWID id = vecWindows[iLoop].id;
+
+         vecLogTails[iLoop].Read( [&spPacer, id]( const char* pData, size_t iLength )
+         {
+            spPacer.Output( id, pData, iLength );
+         } );
+      }
+   } );
+
+   return iWindows;
+}
+
+/**
+ * CSendEngine::FindWindows()
+ *
+ * The PuTTY windows of a filter, sorted by title. Without bPins the
+ * pinned and unpinned windows count as the filter says. Keep
+ * vecWindows between calls, its records are reused.
+ */
+
+int CSendEngine::FindWindows( CString csEntry, std::vector<WINDOWINFO>& vecWindows, bool bPins )
+{
+   CWindowSelection selection;
+   m_beBroadcastEngine.SelectWindows( GetUtf8(csEntry), selection, bPins );
+
+   return m_beBroadcastEngine.FindWindows( selection, vecWindows );
+}
+
+/**
+ * CSendEngine::PinWindows()
+ *
+ * iPin is one of CWindowIndex::PIN_ADD, PIN_REMOVE or PIN_RELEASE.
+ * Returns the number of windows of the filter.
+ */
+
+int CSendEngine::PinWindows( CString csEntry, int iPin )
+{
+   return m_beBroadcastEngine.PinWindows( GetUtf8(csEntry), iPin );
+}
+
+/**
+ * CSendEngine::SaveSnapshot()
+ *
+ * Captures the layout of all PuTTY windows as csName, in the form
+ * stored in the preferences. Returns the number of windows.
+ */
+
+int CSendEngine::SaveSnapshot( CString csName, CString& csSaved )
+{
+   CWindowSnapshot wsSnapshot;
+   wsSnapshot.SetName( GetUtf8(csName) );
+
+   int iWindows = (int) wsSnapshot.Capture( &m_wsWindowSystem );
+
+   csSaved = GetString( wsSnapshot.Save() );
+
+   return iWindows;
+}
+
+/**
+ * CSendEngine::RestoreSnapshot()
+ *
+ * Returns the number of windows placed, or -1 if csSaved is not a
+ * snapshot
+ */
+
+int CSendEngine::RestoreSnapshot( CString csSaved )
+{
+   CWindowSnapshot wsSnapshot;
+
+   if ( !wsSnapshot.Load(GetUtf8(csSaved)) )
+   {
+      return -1;
+   }
+
+   return wsSnapshot.Restore( &m_wsWindowSystem );
+}
+
+/**
+ * CSendEngine::GetSnapshotName()
+ */
+
+CString CSendEngine::GetSnapshotName( CString csSaved )
+{
+   return GetString( CWindowSnapshot::GetName(GetUtf8(csSaved)) );
+}
+
+/**
+ * CSendEngine::IsPuttyWindow()
+ */
+
+bool CSendEngine::IsPuttyWindow( HWND hWnd )
+{
+   return GetPuttyClass( hWnd ) >= 0;
+}
+
+/**
+ * CSendEngine::GetPuttyClass()
+ *
+ * WINDOWCLASS_PUTTY, PUTTYTEL, TUTTY or PIETTY, -1 for any other
+ * window
+ */
+
+int CSendEngine::GetPuttyClass( HWND hWnd )
+{
+   TCHAR szClass[300];  
+
+   ::GetClassName( hWnd, szClass, sizeof(szClass) / sizeof(TCHAR) );
+
+   if ( !_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PUTTY) )
+   {
+      return WINDOWCLASS_PUTTY;
+   }
+   else if ( !_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PUTTYTEL) )
+   {
+      return WINDOWCLASS_PUTTYTEL;
+   }
+   else if ( !_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_TUTTY) )
+   {
+      return WINDOWCLASS_TUTTY;
+   }
+   else if ( !_tcscmp(szClass, PUTTYCS_WINDOW_CLASS_PIETTY) )
+   {
+      return WINDOWCLASS_PIETTY;
+   }
+
+   return -1;
+}
+
+/**
+ * CSendEngine::MatchFilter()
+ *
+ * csEntry is a filter as stored in the preferences:
+ * name||+include;-exclude;...
+ */
+
+bool CSendEngine::MatchFilter( LPCTSTR szTitle, CString csEntry )
+{
+   return CFilterMatch::MatchFilter( GetUtf8(szTitle), GetUtf8(csEntry) );
+}
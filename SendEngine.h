@@ -0,0 +1,131 @@
+/**
+ * SendEngine.h - PuTTYCS send engine
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SENDENGINE_H__INCLUDED_)
+#define SENDENGINE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+
+#include "BroadcastEngine.h"
+#include "Win32WindowSystem.h"
+
+/**
+ * Outcome of sending to one PuTTY window
+ */
+
+struct SENDRESULT
+{
+   HWND hWnd;
+   CString csTitle;
+
+   bool bForeground;
+
+   double dActivateMs;
+   double dTransitionMs;
+   double dSendMs;
+   double dPostSendMs;
+   double dTotalMs;
+};
+
+typedef CArray<SENDRESULT, SENDRESULT&> CSendResultArray;
+
+/**
+ * CSendEngine
+ *
+ * Finds the PuTTY windows matching a filter and types a buffer into
+ * each of them. Shared by the dialog and the headless --send mode.
+ * The work is done by the portable CBroadcastEngine on the Win32
+ * window system; this class converts between MFC and UTF-8.
+ */
+
+class CSendEngine
+{
+public:
+
+   CSendEngine();
+   virtual ~CSendEngine();
+
+   void SetTransition( int iTransition );
+   void SetPostSendDelay( int iPostSendDelay );
+   void SetSendCR( int iSendCR );
+   void SetProgramCache( CKeyProgramCache* pCache );
+   void SetFilters( const CStringArray& csaFilters );
+   void SetInventory( CString csPath );
+
+   CDelayTuner& GetDelayTuner();
+   CSendTrace& GetSendTrace();
+   CBroadcastEngine& GetBroadcastEngine();
+
+   int Send( CString csBuffer, CString csEntry, bool bTab, bool bParse,
+             CSendResultArray* pResults = NULL );
+
+   int Send( const CStringArray& csaBuffers, CString csEntry, bool bTab, bool bParse,
+             CSendResultArray* pResults = NULL );
+
+   int SendScript( const CStringArray& csaLines, CString csEntry, CString csPrompt,
+                   CString csLogPattern, unsigned long ulLineTimeout );
+
+   int FindWindows( CString csEntry, std::vector<WINDOWINFO>& vecWindows, bool bPins = true );
+   int PinWindows( CString csEntry, int iPin );
+
+   int SaveSnapshot( CString csName, CString& csSaved );
+   int RestoreSnapshot( CString csSaved );
+
+   static CString GetSnapshotName( CString csSaved );
+
+   static int GetPuttyClass( HWND hWnd );
+   static bool IsPuttyWindow( HWND hWnd );
+   static bool MatchFilter( LPCTSTR szTitle, CString csEntry );
+
+   static CString GetFilterName( CString csEntry );
+   static CString GetFilterList( CString csEntry );
+   static CString GetFilterPrompt( CString csEntry );
+   static bool IsValidPrompt( CString csPrompt );
+
+   static CString GetSessionLog( CString csLogPattern, CString csTitle );
+   static CString GetCacheDirectory();
+   static bool ResolveFilter( const CStringArray& csaFilters, CString csName, CString& csEntry );
+
+   static std::string GetUtf8( const CString& csString );
+   static CString GetString( const std::string& sUtf8 );
+
+protected:
+
+   CWin32WindowSystem m_wsWindowSystem;
+   CBroadcastEngine m_beBroadcastEngine;
+};
+
+#endif // !defined(SENDENGINE_H__INCLUDED_)
@@ -327,7 +327,7 @@ void CSendKeys::SendKey(WORD MKey, WORD NumTimes, bool GenDownMsg)
 }
 
 // Implements a simple binary search to locate special key name strings
-WORD CSendKeys::StringToVKey(LPCTSTR KeyString, int &idx)
+WORD CSendKeys::StringToVKey(const KEYSPAN<TCHAR> &KeyString, int &idx)
 {
   bool Found = false, Collided;
   int  Bottom = 0, 
@@ -340,7 +340,7 @@ WORD CSendKeys::StringToVKey(LPCTSTR KeyString, int &idx)
   do
   {
     Collided = (Bottom == Middle) || (Top == Middle);
-    int cmp = _tcsicmp(KeyNames[Middle].keyName, KeyString);// _tcslen(KeyString));
+    int cmp = -KeyString.CompareNoCase(KeyNames[Middle].keyName);
     if (cmp == 0)
     {
       Found = true;
@@ -381,154 +381,133 @@ void CSendKeys::PopUpShiftKeys()
 }
 
 // Sends a key string
+// Tokens are spans over KeysString, so a {...} of any length is read in place.
+// Returns false if KeysString has a '{' without its '}'; the keys before it are sent.
 bool CSendKeys::SendKeys(LPCTSTR KeysString, bool Wait)
 {
   WORD MKey, NumTimes;
-  TCHAR KeyString[300] = {0};
-  bool retval  = false;
   int  keyIdx;
 
-  LPTSTR pKey = (LPTSTR) KeysString;
-  TCHAR  ch;
+  CKeyTokenizer<TCHAR> Tokens(KeysString);
+  KEYTOKEN<TCHAR> Token;
 
   m_bWait = Wait;
 
   m_bWinDown = m_bShiftDown = m_bControlDown = m_bAltDown = m_bUsingParens = false;
 
-  while (ch = *pKey)
+  while (Tokens.Next(Token))
   {
-    switch (ch)
+    const KEYSPAN<TCHAR> &KeyString = Token.spText;
+
+    switch (Token.iType)
     {
     // begin modifier group
-    case _TXCHAR('('):
+    case KEYTOKEN_GROUP_BEGIN:
       m_bUsingParens = true;
       break;
 
     // end modifier group
-    case _TXCHAR(')'):
+    case KEYTOKEN_GROUP_END:
       m_bUsingParens = false;
       PopUpShiftKeys(); // pop all shift keys when we finish a modifier group close
       break;
 
-    // ALT key
-    case _TXCHAR('%'):
-      m_bAltDown = true;
-      SendKeyDown(VK_MENU, 1, false);
-      break;
-
-    // SHIFT key
-    case _TXCHAR('+'):
-      m_bShiftDown = true;
-      SendKeyDown(VK_SHIFT, 1, false);
-      break;
-
-    // CTRL key
-    case _TXCHAR('^'):
-      m_bControlDown = true;
-      SendKeyDown(VK_CONTROL, 1, false);
-      break;
-
-    // WINKEY (Left-WinKey)
-    case '@':
-      m_bWinDown = true;
-      SendKeyDown(VK_LWIN, 1, false);
+    case KEYTOKEN_MODIFIER:
+      switch (KeyString.pText[0])
+      {
+      // ALT key
+      case _TXCHAR('%'):
+        m_bAltDown = true;
+        SendKeyDown(VK_MENU, 1, false);
+        break;
+
+      // SHIFT key
+      case _TXCHAR('+'):
+        m_bShiftDown = true;
+        SendKeyDown(VK_SHIFT, 1, false);
+        break;
+
+      // CTRL key
+      case _TXCHAR('^'):
+        m_bControlDown = true;
+        SendKeyDown(VK_CONTROL, 1, false);
+        break;
+
+      // WINKEY (Left-WinKey)
+      default:
+        m_bWinDown = true;
+        SendKeyDown(VK_LWIN, 1, false);
+        break;
+      }
       break;
 
     // enter
-    case _TXCHAR('~'):
+    case KEYTOKEN_ENTER:
       SendKeyDown(VK_RETURN, 1, true);
       PopUpShiftKeys();
       break;
 
-    // begin special keys
-    case _TXCHAR('{'):
+    // special keys
+    case KEYTOKEN_SPECIAL:
       {
-        LPTSTR p = pKey+1; // skip past the beginning '{'
-        size_t t;
-
-        // find end of close
-        while (*p && *p != _TXCHAR('}'))
-          p++;
-
-        t = p - pKey;
-        // special key definition too big?
-        if (t > sizeof(KeyString))
-          return false;
-
-        // Take this KeyString into local buffer
-        _tcsncpy(KeyString, pKey+1, t);
-
-        KeyString[t-1] = _TXCHAR('\0');
         keyIdx = -1;
-
-        pKey += t; // skip to next keystring
+        NumTimes = 1;
 
         // Invalidate key
         MKey = INVALIDKEY;
 
         // sending arbitrary vkeys?
-        if (_tcsnicmp(KeyString, _T("VKEY"), 4) == 0)
+        if (KeyString.StartsWithNoCase(_T("VKEY")))
         {
-          p = KeyString + 4;
-          MKey = _ttoi(p);
+          MKey = (WORD) KeyString.ToNumber(4);
         }
-        else if (_tcsnicmp(KeyString, _T("BEEP"), 4) == 0)
+        else if (KeyString.StartsWithNoCase(_T("BEEP")))
         {
-          p = KeyString + 4 + 1;
-          LPTSTR p1 = p;
-          DWORD frequency, delay;
+          size_t Space = KeyString.Find(_TXCHAR(' '), 5);
 
-          if ((p1 = _tcsstr(p, _T(" "))) != NULL)
-          {
-            *p1++ = _TXCHAR('\0');
-            frequency = _ttoi(p);
-            delay = _ttoi(p1);
-            ::Beep(frequency, delay);
-          }
+          if (Space != KEYSPAN<TCHAR>::npos)
+            ::Beep(KeyString.ToNumber(5), KeyString.ToNumber(Space + 1));
         }
         // Should activate a window?
-        else if (_tcsnicmp(KeyString, _T("APPACTIVATE"), 11) == 0)
+        else if (KeyString.StartsWithNoCase(_T("APPACTIVATE")))
         {
-          p = KeyString + 11 + 1;
-          AppActivate(p);
+          // the title is the only part that needs a NUL terminated copy
+          KEYSPAN<TCHAR> Title = KeyString.Mid(12);
+          std::vector<TCHAR> WindowTitle(Title.pText, Title.pText + Title.iLength);
+          WindowTitle.push_back(_TXCHAR('\0'));
+          AppActivate(&WindowTitle[0]);
         }
         // want to send/set delay?
-        else if (_tcsnicmp(KeyString, _T("DELAY"), 5) == 0)
+        else if (KeyString.StartsWithNoCase(_T("DELAY")))
         {
-          // Advance to parameters
-          p = KeyString + 5;
           // set "sleep factor"
-          if (*p == _TXCHAR('='))
-            m_nDelayAlways = _ttoi(p + 1); // Take number after the '=' character
+          if ((KeyString.iLength > 5) && (KeyString.pText[5] == _TXCHAR('=')))
+            m_nDelayAlways = KeyString.ToNumber(6); // Take number after the '=' character
           else
             // set "sleep now"
-            m_nDelayNow = _ttoi(p);
+            m_nDelayNow = KeyString.ToNumber(5);
         }
         // not command special keys, then process as keystring to VKey
         else
         {
           MKey = StringToVKey(KeyString, keyIdx);
-          // Key found in table
-          if (keyIdx != -1)
+
+          // Does the key string have also count specifier?
+          size_t Space = KeyString.ReverseFind(_TXCHAR(' '));
+          if ((keyIdx == -1) && (Space != KEYSPAN<TCHAR>::npos) && (Space > 0))
           {
-            NumTimes = 1;
-
-            // Does the key string have also count specifier?
-            t = _tcslen(KeyNames[keyIdx].keyName);
-            if (_tcslen(KeyString) > t)
-            {
-              p = KeyString + t;
-              // Take the specified number of times
-              NumTimes = _ttoi(p);
-            }
-
-            if (KeyNames[keyIdx].normalkey)
-              MKey = ::VkKeyScan(KeyNames[keyIdx].VKey);
+            MKey = StringToVKey(KeyString.Mid(0, Space), keyIdx);
+            // Take the specified number of times
+            NumTimes = (WORD) KeyString.ToNumber(Space + 1);
           }
+
+          // Key found in table
+          if ((keyIdx != -1) && KeyNames[keyIdx].normalkey)
+            MKey = ::VkKeyScan(KeyNames[keyIdx].VKey);
         }
 
         // A valid key to send?
-        if (MKey != INVALIDKEY)
+        if ((MKey != INVALIDKEY) && (NumTimes > 0))
         {
           SendKey(MKey, NumTimes, true);
           PopUpShiftKeys();
@@ -536,17 +515,88 @@ bool CSendKeys::SendKeys(LPCTSTR KeysString, bool Wait)
       }
       break;
 
-      // a normal key was pressed
+    // normal keys were pressed
     default:
-      // Get the VKey from the key
-      MKey = ::VkKeyScan(ch);
-      SendKey(MKey, 1, true);
-      PopUpShiftKeys();
+      for (size_t i=0;i<KeyString.iLength;i++)
+      {
+        // Get the VKey from the key
+        MKey = ::VkKeyScan(KeyString.pText[i]);
+        SendKey(MKey, 1, true);
+        PopUpShiftKeys();
+      }
     }
-    pKey++;
   }
 
   m_bUsingParens = false;
+  PopUpShiftKeys();
+  return Tokens.GetError() == KEYERROR_NONE;
+}
+
+// Sends keys compiled by CKeyProgram, the same key events SendKeys() makes
+// for the string they were compiled from, without parsing it again
+bool CSendKeys::SendProgram(const std::vector<KEYOP> &Ops, bool Wait)
+{
+  m_bWait = Wait;
+
+  m_bWinDown = m_bShiftDown = m_bControlDown = m_bAltDown = m_bUsingParens = false;
+
+  for (size_t i=0;i<Ops.size();i++)
+  {
+    const KEYOP &op = Ops[i];
+
+    switch (op.iType)
+    {
+    case KEYOP::KEYOP_CHAR:
+      SendKey(::VkKeyScan((TCHAR) op.uiValue), (WORD) op.uiCount, true);
+      break;
+
+    case KEYOP::KEYOP_VKEY:
+      SendKey((WORD) op.uiValue, (WORD) op.uiCount, true);
+      break;
+
+    case KEYOP::KEYOP_MODIFIER:
+      if (op.uiValue == VK_MENU)
+        m_bAltDown = true;
+      else if (op.uiValue == VK_SHIFT)
+        m_bShiftDown = true;
+      else if (op.uiValue == VK_CONTROL)
+        m_bControlDown = true;
+      else
+        m_bWinDown = true;
+      SendKeyDown((BYTE) op.uiValue, 1, false);
+      break;
+
+    // the program already knows where a modifier group ends
+    case KEYOP::KEYOP_RELEASE:
+      PopUpShiftKeys();
+      break;
+
+    case KEYOP::KEYOP_DELAY_ALWAYS:
+      m_nDelayAlways = op.uiValue;
+      break;
+
+    case KEYOP::KEYOP_DELAY_NOW:
+      m_nDelayNow = op.uiValue;
+      break;
+
+    case KEYOP::KEYOP_BEEP:
+      ::Beep(op.uiValue, op.uiParam);
+      break;
+
+    case KEYOP::KEYOP_APPACTIVATE:
+      {
+#ifdef UNICODE
+        std::vector<WCHAR> Title(op.sText.size() + 1);
+        ::MultiByteToWideChar(CP_UTF8, 0, op.sText.c_str(), -1, &Title[0], (int) Title.size());
+        AppActivate(&Title[0]);
+#else
+        AppActivate(op.sText.c_str());
+#endif
+      }
+      break;
+    }
+  }
+
   PopUpShiftKeys();
   return true;
 }
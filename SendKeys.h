@@ -4,6 +4,11 @@
 #include <windows.h>
 #include <tchar.h>
 
+#include <vector>
+
+#include "KeyProgram.h"
+#include "KeyTokenizer.h"
+
 /**
  * SendKeys.h
  *
@@ -71,12 +76,13 @@ private:
   void SendKeyUp(BYTE VKey);
   void SendKeyDown(BYTE VKey, WORD NumTimes, bool GenUpMsg, bool bDelay = false);
   void SendKey(WORD MKey, WORD NumTimes, bool GenDownMsg);
-  static WORD StringToVKey(LPCTSTR KeyString, int &idx);
+  static WORD StringToVKey(const KEYSPAN<TCHAR> &KeyString, int &idx);
   void KeyboardEvent(BYTE VKey, BYTE ScanCode, LONG Flags);
 
 public:
 
   bool SendKeys(LPCTSTR KeysString, bool Wait = false);
+  bool SendProgram(const std::vector<KEYOP> &Ops, bool Wait = false);
   static bool AppActivate(HWND wnd);
   static bool AppActivate(LPCTSTR WindowTitle, LPCTSTR WindowClass = 0);
   void SetDelay(const DWORD delay) { m_nDelayAlways = delay; }
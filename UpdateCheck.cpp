@@ -0,0 +1,303 @@
+/**
+ * UpdateCheck.cpp - PuTTYCS background update check
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "UpdateCheck.h"
+#include "SendEngine.h"
+
+#pragma comment(lib, "wininet.lib")
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * CUpdateCheck::CUpdateCheck()
+ */
+
+CUpdateCheck::CUpdateCheck()
+{
+   m_hSession = NULL;
+   m_lCancelled = 0;
+
+   ::InitializeCriticalSection( &m_csLock );
+
+   m_vcCheck.SetFetcher( this );
+   m_vcCheck.SetApplication( CSendEngine::GetUtf8(PUTTYCS_APP_NAME), 
+      CSendEngine::GetUtf8(PUTTYCS_VERSION_INT) );
+   m_vcCheck.SetMaxSize( PUTTYCS_UPDATE_MAX_SIZE );
+}
+
+/**
+ * CUpdateCheck::~CUpdateCheck()
+ */
+
+CUpdateCheck::~CUpdateCheck()
+{
+   Stop();
+
+   ::DeleteCriticalSection( &m_csLock );
+}
+
+/**
+ * CUpdateCheck::Start()
+ */
+
+bool CUpdateCheck::Start( HWND hWndTarget, CString csUrl, DWORD dwDeadline )
+{
+   return m_vcCheck.Start( CSendEngine::GetUtf8(csUrl), dwDeadline, [hWndTarget]()
+   {
+      ::PostMessage( hWndTarget, WM_USER_UPDATE_CHECKED, 0, 0 );
+   } );
+}
+
+/**
+ * CUpdateCheck::Cancel()
+ */
+
+void CUpdateCheck::Cancel()
+{
+   m_vcCheck.Cancel();
+}
+
+/**
+ * CUpdateCheck::Stop()
+ */
+
+void CUpdateCheck::Stop()
+{
+   m_vcCheck.Stop();
+}
+
+/**
+ * CUpdateCheck::IsRunning()
+ */
+
+bool CUpdateCheck::IsRunning()
+{
+   return m_vcCheck.IsRunning();
+}
+
+/**
+ * CUpdateCheck::GetResult()
+ *
+ * Returns false if the check failed or timed out. csVersion is
+ * empty if there is no newer version.
+ */
+
+bool CUpdateCheck::GetResult( CString& csVersion, CString& csIntVersion )
+{
+   std::string sVersion;
+   std::string sIntVersion;
+
+   bool bSucceeded = m_vcCheck.GetResult( sVersion, sIntVersion );
+
+   csVersion = CSendEngine::GetString( sVersion );
+   csIntVersion = CSendEngine::GetString( sIntVersion );
+
+   return bSucceeded;
+}
+
+/**
+ * CUpdateCheck::IsDue()
+ */
+
+bool CUpdateCheck::IsDue( __int64 llLastCheck, __int64 llNow )
+{
+   return CVersionCheck::IsDue( llLastCheck, llNow, PUTTYCS_UPDATE_INTERVAL );
+}
+
+/**
+ * CUpdateCheck::IsNewer()
+ *
+ * An internal version, as the last check stored it, is newer than
+ * this build
+ */
+
+bool CUpdateCheck::IsNewer( const CString& csIntVersion )
+{
+   return !csIntVersion.IsEmpty() &&
+      (CVersionCheck::CompareVersions(CSendEngine::GetUtf8(csIntVersion), 
+          CSendEngine::GetUtf8(PUTTYCS_VERSION_INT)) > 0);
+}
+
+/**
+ * CUpdateCheck::Abort()
+ *
+ * Closing the session from another thread makes a blocked
+ * InternetOpenUrl() or InternetReadFile() return at once
+ */
+
+void CUpdateCheck::Abort()
+{
+   ::InterlockedExchange( &m_lCancelled, 1 );
+
+   CloseSession();
+}
+
+/**
+ * CUpdateCheck::Reset()
+ */
+
+void CUpdateCheck::Reset()
+{
+   ::InterlockedExchange( &m_lCancelled, 0 );
+}
+
+/**
+ * CUpdateCheck::CloseSession()
+ */
+
+void CUpdateCheck::CloseSession()
+{
+   ::EnterCriticalSection( &m_csLock );
+
+   if ( m_hSession )
+   {
+      ::InternetCloseHandle( m_hSession );
+      m_hSession = NULL;
+   }
+
+   ::LeaveCriticalSection( &m_csLock );
+}
+
+/**
+ * CUpdateCheck::Fetch()
+ *
+ * Runs on the check's worker thread
+ */
+
+bool CUpdateCheck::Fetch( const std::string& sUrl, unsigned long ulTimeoutMs, 
+                          size_t iMaxSize, std::string& sDocument )
+{
+   HINTERNET hSession = 
+      ::InternetOpen( PUTTYCS_APP_NAME, INTERNET_OPEN_TYPE_PRECONFIG, NULL, NULL, 0 );
+
+   if ( !hSession )
+   {
+      return false;
+   }
+
+   ::EnterCriticalSection( &m_csLock );
+
+   if ( m_lCancelled )
+   {
+      ::InternetCloseHandle( hSession );
+      hSession = NULL;
+   }
+
+   m_hSession = hSession;
+
+   ::LeaveCriticalSection( &m_csLock );
+
+   if ( !hSession )
+   {
+      return false;
+   }
+
+   /**
+    * Also bounded by the check's deadline, these only keep a
+    * stalled connection from outliving it
+    */
+
+   DWORD dwTimeout = ulTimeoutMs;
+
+   ::InternetSetOption( hSession, INTERNET_OPTION_CONNECT_TIMEOUT, &dwTimeout, sizeof(dwTimeout) );
+   ::InternetSetOption( hSession, INTERNET_OPTION_SEND_TIMEOUT, &dwTimeout, sizeof(dwTimeout) );
+   ::InternetSetOption( hSession, INTERNET_OPTION_RECEIVE_TIMEOUT, &dwTimeout, sizeof(dwTimeout) );
+
+   bool bResult = false;
+
+   HINTERNET hUrl = ::InternetOpenUrl( hSession, CSendEngine::GetString(sUrl), NULL, 0,
+      INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE | INTERNET_FLAG_NO_UI, 0 );
+
+   if ( hUrl )
+   {
+      DWORD dwStatus = 0;
+      DWORD dwSize = sizeof(dwStatus);
+
+      bool bOk = true;
+
+      if ( ::HttpQueryInfo(hUrl, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, 
+              &dwStatus, &dwSize, NULL) )
+      {
+         bOk = (dwStatus == HTTP_STATUS_OK);
+      }
+
+      char szBuffer[4096];
+      DWORD dwRead = 0;
+
+      while ( bOk && !m_lCancelled )
+      {
+         if ( !::InternetReadFile(hUrl, szBuffer, sizeof(szBuffer), &dwRead) )
+         {
+            bOk = false;
+         }
+         else if ( dwRead == 0 )
+         {
+            bResult = true;
+            break;
+         }
+         else if ( sDocument.size() + dwRead > iMaxSize )
+         {
+            bOk = false;
+         }
+         else
+         {
+            sDocument.append( szBuffer, dwRead );
+         }
+      }
+   }
+
+   /**
+    * hUrl is closed with the session if Abort() got there first
+    */
+
+   ::EnterCriticalSection( &m_csLock );
+
+   if ( m_hSession )
+   {
+      if ( hUrl )
+      {
+         ::InternetCloseHandle( hUrl );
+      }
+
+      ::InternetCloseHandle( m_hSession );
+      m_hSession = NULL;
+   }
+
+   ::LeaveCriticalSection( &m_csLock );
+
+   return bResult && !m_lCancelled;
+}
@@ -0,0 +1,89 @@
+/**
+ * UpdateCheck.h - PuTTYCS background update check
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(UPDATECHECK_H__INCLUDED_)
+#define UPDATECHECK_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <wininet.h>
+
+#include "UpdateFetcher.h"
+#include "VersionCheck.h"
+
+/**
+ * CUpdateCheck
+ *
+ * Runs a CVersionCheck, which owns the worker thread, the deadline
+ * and the parsing, with WinINet as its fetcher. Aborting closes the
+ * WinINet session, which makes a request blocked in connect or
+ * receive return at once. Completion, success or not, is posted to
+ * the owner window as WM_USER_UPDATE_CHECKED.
+ */
+
+class CUpdateCheck : public CUpdateFetcher
+{
+public:
+
+   CUpdateCheck();
+   virtual ~CUpdateCheck();
+
+   bool Start( HWND hWndTarget, CString csUrl, DWORD dwDeadline );
+   void Cancel();
+   void Stop();
+
+   bool IsRunning();
+
+   bool GetResult( CString& csVersion, CString& csIntVersion );
+
+   static bool IsDue( __int64 llLastCheck, __int64 llNow );
+   static bool IsNewer( const CString& csIntVersion );
+
+   virtual bool Fetch( const std::string& sUrl, unsigned long ulTimeoutMs, 
+                       size_t iMaxSize, std::string& sDocument );
+   virtual void Abort();
+   virtual void Reset();
+
+protected:
+
+   void CloseSession();
+
+   CVersionCheck m_vcCheck;
+
+   CRITICAL_SECTION m_csLock;
+   HINTERNET m_hSession;
+   volatile LONG m_lCancelled;
+};
+
+#endif // !defined(UPDATECHECK_H__INCLUDED_)
@@ -0,0 +1,205 @@
+/**
+ * Win32ProcessSpawner.cpp - PuTTYCS Win32 process spawner
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "Win32ProcessSpawner.h"
+#include "SendEngine.h"
+#include "Win32WindowSystem.h"
+
+#include <chrono>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * CWin32ProcessSpawner::CWin32ProcessSpawner()
+ */
+
+CWin32ProcessSpawner::CWin32ProcessSpawner()
+{
+}
+
+/**
+ * CWin32ProcessSpawner::~CWin32ProcessSpawner()
+ */
+
+CWin32ProcessSpawner::~CWin32ProcessSpawner()
+{
+   std::unordered_map<PROCESSID, HANDLE>::iterator it;
+
+   for ( it = m_mapProcesses.begin(); it != m_mapProcesses.end(); ++it )
+   {
+      ::CloseHandle( it->second );
+   }
+}
+
+/**
+ * CWin32ProcessSpawner::Spawn()
+ *
+ * The command is a command line, the program searched for as
+ * CreateProcess() does
+ */
+
+bool CWin32ProcessSpawner::Spawn( const std::string& sCommand, PROCESSID& pid )
+{
+   CString csCommand = CSendEngine::GetString( sCommand );
+
+   STARTUPINFO si;
+   ZeroMemory( &si, sizeof(si) );
+   si.cb = sizeof(si);
+
+   PROCESS_INFORMATION pi;
+   ZeroMemory( &pi, sizeof(pi) );
+
+   // CreateProcess() may write to the command line
+
+   if ( !::CreateProcess(NULL, csCommand.GetBuffer(csCommand.GetLength() + 1), NULL, NULL, 
+           FALSE, 0, NULL, NULL, &si, &pi) )
+   {
+      csCommand.ReleaseBuffer();
+      return false;
+   }
+
+   csCommand.ReleaseBuffer();
+
+   ::CloseHandle( pi.hThread );
+
+   pid = pi.dwProcessId;
+
+   m_mapProcesses[pid] = pi.hProcess;
+
+   return true;
+}
+
+/**
+ * CWin32ProcessSpawner::IsRunning()
+ */
+
+bool CWin32ProcessSpawner::IsRunning( PROCESSID pid )
+{
+   std::unordered_map<PROCESSID, HANDLE>::iterator it = m_mapProcesses.find( pid );
+
+   if ( it == m_mapProcesses.end() )
+   {
+      return false;
+   }
+
+   return ::WaitForSingleObject( it->second, 0 ) == WAIT_TIMEOUT;
+}
+
+/**
+ * CWin32ProcessSpawner::FindWindows()
+ */
+
+void CWin32ProcessSpawner::FindWindows( std::unordered_map<PROCESSID, WINDOWID>& mapWindows )
+{
+   if ( m_mapProcesses.empty() )
+   {
+      return;
+   }
+
+   ENUMPROCESSES ep;
+   ep.pProcesses = &m_mapProcesses;
+   ep.pWindows = &mapWindows;
+
+   ::EnumWindows( enumwindowsProc, (LPARAM) &ep );
+}
+
+/**
+ * CWin32ProcessSpawner::enumwindowsProc()
+ */
+
+BOOL CALLBACK CWin32ProcessSpawner::enumwindowsProc( HWND hwnd, LPARAM lParam )
+{
+   ENUMPROCESSES* pEnum = (ENUMPROCESSES*) lParam;
+
+   if ( hwnd == NULL )
+   {
+      return false;
+   }
+
+   if ( ::IsWindowVisible(hwnd) && CSendEngine::IsPuttyWindow(hwnd) )
+   {
+      DWORD dwProcessId = 0;
+
+      ::GetWindowThreadProcessId( hwnd, &dwProcessId );
+
+      if ( pEnum->pProcesses->count(dwProcessId) )
+      {
+         pEnum->pWindows->insert( 
+            std::make_pair((PROCESSID) dwProcessId, CWin32WindowSystem::GetId(hwnd)) );
+      }
+   }
+
+   return true;
+}
+
+/**
+ * CWin32ProcessSpawner::Release()
+ */
+
+void CWin32ProcessSpawner::Release( PROCESSID pid )
+{
+   std::unordered_map<PROCESSID, HANDLE>::iterator it = m_mapProcesses.find( pid );
+
+   if ( it != m_mapProcesses.end() )
+   {
+      ::CloseHandle( it->second );
+
+      m_mapProcesses.erase( it );
+   }
+}
+
+/**
+ * CWin32ProcessSpawner::GetTime()
+ */
+
+double CWin32ProcessSpawner::GetTime()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * CWin32ProcessSpawner::Wait()
+ */
+
+void CWin32ProcessSpawner::Wait( double dMs )
+{
+   if ( dMs > 0.0 )
+   {
+      ::Sleep( (DWORD) dMs );
+   }
+}
@@ -0,0 +1,82 @@
+/**
+ * Win32ProcessSpawner.h - PuTTYCS Win32 process spawner
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WIN32PROCESSSPAWNER_H__INCLUDED_)
+#define WIN32PROCESSSPAWNER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <unordered_map>
+
+#include "ProcessSpawner.h"
+
+/**
+ * CWin32ProcessSpawner
+ *
+ * Starts processes with CreateProcess() and finds their PuTTY
+ * windows with one EnumWindows() for all of them. The process
+ * handles are kept until the launcher releases them.
+ */
+
+class CWin32ProcessSpawner : public CProcessSpawner
+{
+public:
+
+   CWin32ProcessSpawner();
+   virtual ~CWin32ProcessSpawner();
+
+   virtual bool Spawn( const std::string& sCommand, PROCESSID& pid );
+   virtual bool IsRunning( PROCESSID pid );
+
+   virtual void FindWindows( std::unordered_map<PROCESSID, WINDOWID>& mapWindows );
+
+   virtual void Release( PROCESSID pid );
+
+   virtual double GetTime();
+   virtual void Wait( double dMs );
+
+protected:
+
+   struct ENUMPROCESSES
+   {
+      const std::unordered_map<PROCESSID, HANDLE>* pProcesses;
+      std::unordered_map<PROCESSID, WINDOWID>* pWindows;
+   };
+
+   static BOOL CALLBACK enumwindowsProc( HWND hwnd, LPARAM lParam );
+
+   std::unordered_map<PROCESSID, HANDLE> m_mapProcesses;
+};
+
+#endif // !defined(WIN32PROCESSSPAWNER_H__INCLUDED_)
@@ -0,0 +1,469 @@
+/**
+ * Win32WindowSystem.cpp - PuTTYCS Win32 window system
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "Win32WindowSystem.h"
+#include "KeyProgramCache.h"
+#include "SendEngine.h"
+#include "WindowWait.h"
+
+#include <chrono>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * Longest window title read, in characters
+ */
+
+#define WIN32_TITLE_SIZE   300
+
+/**
+ * CWin32WindowSystem::CWin32WindowSystem()
+ */
+
+CWin32WindowSystem::CWin32WindowSystem()
+{
+   m_pProgramCache = NULL;
+
+   m_ulInputIdleFloor = 0;
+}
+
+/**
+ * CWin32WindowSystem::~CWin32WindowSystem()
+ */
+
+CWin32WindowSystem::~CWin32WindowSystem()
+{
+}
+
+/**
+ * CWin32WindowSystem::GetHwnd()
+ */
+
+HWND CWin32WindowSystem::GetHwnd( WINDOWID id )
+{
+   return (HWND) (UINT_PTR) id;
+}
+
+/**
+ * CWin32WindowSystem::GetId()
+ */
+
+WINDOWID CWin32WindowSystem::GetId( HWND hWnd )
+{
+   return (WINDOWID) (UINT_PTR) hWnd;
+}
+
+/**
+ * CWin32WindowSystem::GetMilliseconds()
+ */
+
+double CWin32WindowSystem::GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * CWin32WindowSystem::EnumTerminalWindows()
+ */
+
+void CWin32WindowSystem::EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows )
+{
+   ENUMWINDOWS ew;
+   ew.pWindows = &vecWindows;
+   ew.iCount = 0;
+
+   ::EnumWindows( enumwindowsProc, (LPARAM) &ew );
+
+   vecWindows.resize( ew.iCount );
+}
+
+/**
+ * CWin32WindowSystem::enumwindowsProc()
+ */
+
+/**
+ * Fills the records of the previous enumeration in place: the title
+ * is converted on the stack and assigned, so a title that fits the
+ * old one's buffer costs no allocation.
+ */
+
+BOOL CALLBACK CWin32WindowSystem::enumwindowsProc( HWND hwnd, LPARAM lParam )
+{
+   ENUMWINDOWS* pEnum = (ENUMWINDOWS*) lParam;
+
+   if ( hwnd == NULL )
+   {
+      return false;
+   }
+
+   int iClass = CSendEngine::GetPuttyClass( hwnd );
+
+   if ( iClass >= 0 )
+   {
+      WCHAR wszTitle[WIN32_TITLE_SIZE];
+      char szTitle[WIN32_TITLE_SIZE * 3];
+
+      int iLength = ::GetWindowTextW( hwnd, wszTitle, WIN32_TITLE_SIZE );
+
+      int iBytes = (iLength > 0) ?
+         ::WideCharToMultiByte( CP_UTF8, 0, wszTitle, iLength, szTitle, sizeof(szTitle), NULL, NULL ) : 0;
+
+      if ( pEnum->iCount == pEnum->pWindows->size() )
+      {
+         pEnum->pWindows->push_back( WINDOWINFO() );
+      }
+
+      WINDOWINFO& window = (*pEnum->pWindows)[pEnum->iCount++];
+
+      window.id = GetId( hwnd );
+      window.sTitle.assign( szTitle, iBytes );
+      window.iClass = iClass;
+
+      window.iFlags = 0;
+
+      if ( ::IsWindowVisible(hwnd) )
+      {
+         window.iFlags |= WINDOWSTATE_VISIBLE;
+      }
+
+      if ( ::IsIconic(hwnd) )
+      {
+         window.iFlags |= WINDOWSTATE_MINIMIZED;
+      }
+      else if ( ::IsZoomed(hwnd) )
+      {
+         window.iFlags |= WINDOWSTATE_MAXIMIZED;
+      }
+   }
+  
+   return true;
+}
+
+/**
+ * CWin32WindowSystem::Activate()
+ */
+
+double CWin32WindowSystem::Activate( WINDOWID id )
+{
+   double dStart = GetMilliseconds();
+
+   HWND hWnd = GetHwnd( id );
+
+   ::SendMessage( hWnd, WM_SYSCOMMAND, SC_HOTKEY, (LPARAM) hWnd );
+   ::SendMessage( hWnd, WM_SYSCOMMAND, SC_RESTORE, (LPARAM) hWnd );
+
+   ::ShowWindow( hWnd, SW_SHOW );
+
+   ::SetForegroundWindow( hWnd );
+
+   ::SetFocus( hWnd );
+
+   return GetMilliseconds() - dStart;
+}
+
+/**
+ * CWin32WindowSystem::IsForeground()
+ */
+
+bool CWin32WindowSystem::IsForeground( WINDOWID id )
+{
+   return ::GetForegroundWindow() == GetHwnd( id );
+}
+
+/**
+ * CWin32WindowSystem::WaitForForeground()
+ */
+
+double CWin32WindowSystem::WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                              int* piOutcome )
+{
+   return CWindowWait::ForForeground( GetHwnd(id), ulFixedMs, piOutcome );
+}
+
+/**
+ * CWin32WindowSystem::SendKeys()
+ *
+ * Keystrokes go to the foreground window
+ */
+
+double CWin32WindowSystem::SendKeys( WINDOWID id, const std::string& sKeys )
+{
+   double dStart = GetMilliseconds();
+
+   if ( m_pProgramCache )
+   {
+      m_skSendKeys.SendProgram( m_pProgramCache->Find(sKeys).GetOps() );
+   }
+   else
+   {
+      CString csKeys = CSendEngine::GetString( sKeys );
+
+      m_skSendKeys.SendKeys( (LPCTSTR) csKeys );
+   }
+
+   return GetMilliseconds() - dStart;
+}
+
+/**
+ * CWin32WindowSystem::SetProgramCache()
+ *
+ * Keys are replayed from the programs in pCache instead of parsed,
+ * NULL to parse them again
+ */
+
+void CWin32WindowSystem::SetProgramCache( CKeyProgramCache* pCache )
+{
+   m_pProgramCache = pCache;
+}
+
+/**
+ * CWin32WindowSystem::SetInputIdleFloor()
+ *
+ * Shortest post send wait, however fast the tuned delay of a window
+ * is (see CWindowWait::ForInputIdle())
+ */
+
+void CWin32WindowSystem::SetInputIdleFloor( unsigned long ulFloorMs )
+{
+   m_ulInputIdleFloor = ulFloorMs;
+}
+
+/**
+ * CWin32WindowSystem::WaitForInputIdle()
+ */
+
+double CWin32WindowSystem::WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                             int* piOutcome )
+{
+   return CWindowWait::ForInputIdle( GetHwnd(id), ulFixedMs, m_ulInputIdleFloor, piOutcome );
+}
+
+/**
+ * CWin32WindowSystem::GetCapsLock()
+ */
+
+bool CWin32WindowSystem::GetCapsLock()
+{
+   return ::GetKeyState( VK_CAPITAL ) != 0;
+}
+
+/**
+ * CWin32WindowSystem::GetWorkspaceOffset()
+ *
+ * WINDOWPLACEMENT is in workspace coordinates, which start at the
+ * work area of the monitor instead of the screen origin
+ */
+
+POINT CWin32WindowSystem::GetWorkspaceOffset( HWND hWnd )
+{
+   POINT ptOffset = { 0, 0 };
+
+   MONITORINFO mi;
+   mi.cbSize = sizeof(mi);
+
+   if ( ::GetMonitorInfo(::MonitorFromWindow(hWnd, MONITOR_DEFAULTTONEAREST), &mi) )
+   {
+      ptOffset.x = mi.rcWork.left - mi.rcMonitor.left;
+      ptOffset.y = mi.rcWork.top - mi.rcMonitor.top;
+   }
+
+   return ptOffset;
+}
+
+/**
+ * CWin32WindowSystem::GetWindowState()
+ */
+
+bool CWin32WindowSystem::GetWindowState( WINDOWID id, WINDOWSTATE& state )
+{
+   HWND hWnd = GetHwnd( id );
+
+   WINDOWPLACEMENT wp;
+   wp.length = sizeof(wp);
+
+   if ( !::IsWindow(hWnd) || !::GetWindowPlacement(hWnd, &wp) )
+   {
+      return false;
+   }
+
+   POINT ptOffset = GetWorkspaceOffset( hWnd );
+
+   state.id = id;
+   state.iX = wp.rcNormalPosition.left + ptOffset.x;
+   state.iY = wp.rcNormalPosition.top + ptOffset.y;
+   state.iWidth = wp.rcNormalPosition.right - wp.rcNormalPosition.left;
+   state.iHeight = wp.rcNormalPosition.bottom - wp.rcNormalPosition.top;
+
+   state.iFlags = 0;
+
+   if ( ::IsWindowVisible(hWnd) )
+   {
+      state.iFlags |= WINDOWSTATE_VISIBLE;
+   }
+
+   if ( ::IsIconic(hWnd) )
+   {
+      state.iFlags |= WINDOWSTATE_MINIMIZED;
+   }
+   else if ( ::IsZoomed(hWnd) )
+   {
+      state.iFlags |= WINDOWSTATE_MAXIMIZED;
+   }
+
+   return true;
+}
+
+/**
+ * CWin32WindowSystem::SetWindowStates()
+ *
+ * Moves, sizes, shows or hides and stacks all windows in one
+ * DeferWindowPos() transaction. Windows that are or become minimized
+ * or maximized get their restored position and show state from
+ * SetWindowPlacement() first, and only their z-order and visibility
+ * from the transaction.
+ */
+
+double CWin32WindowSystem::SetWindowStates( const std::vector<WINDOWSTATE>& vecStates )
+{
+   double dStart = GetMilliseconds();
+
+   for ( size_t iLoop = 0; iLoop < vecStates.size(); iLoop++ )
+   {
+      const WINDOWSTATE& state = vecStates[iLoop];
+
+      HWND hWnd = GetHwnd( state.id );
+
+      if ( !::IsWindow(hWnd) )
+      {
+         continue;
+      }
+
+      if ( !(state.iFlags & (WINDOWSTATE_MINIMIZED | WINDOWSTATE_MAXIMIZED)) &&
+           !::IsIconic(hWnd) && !::IsZoomed(hWnd) )
+      {
+         continue;
+      }
+
+      WINDOWPLACEMENT wp;
+      wp.length = sizeof(wp);
+
+      if ( !::GetWindowPlacement(hWnd, &wp) )
+      {
+         continue;
+      }
+
+      POINT ptOffset = GetWorkspaceOffset( hWnd );
+
+      wp.rcNormalPosition.left = state.iX - ptOffset.x;
+      wp.rcNormalPosition.top = state.iY - ptOffset.y;
+      wp.rcNormalPosition.right = wp.rcNormalPosition.left + state.iWidth;
+      wp.rcNormalPosition.bottom = wp.rcNormalPosition.top + state.iHeight;
+
+      if ( state.iFlags & WINDOWSTATE_MINIMIZED )
+      {
+         wp.showCmd = SW_SHOWMINNOACTIVE;
+      }
+      else if ( state.iFlags & WINDOWSTATE_MAXIMIZED )
+      {
+         wp.showCmd = SW_SHOWMAXIMIZED;
+      }
+      else
+      {
+         wp.showCmd = SW_SHOWNOACTIVATE;
+      }
+
+      ::SetWindowPlacement( hWnd, &wp );
+   }
+
+   HDWP hDwp = ::BeginDeferWindowPos( (int) vecStates.size() );
+
+   HWND hWndAfter = HWND_TOP;
+
+   for ( size_t iLoop = 0; iLoop < vecStates.size(); iLoop++ )
+   {
+      const WINDOWSTATE& state = vecStates[iLoop];
+
+      HWND hWnd = GetHwnd( state.id );
+
+      if ( !::IsWindow(hWnd) )
+      {
+         continue;
+      }
+
+      UINT uFlags = SWP_NOACTIVATE |
+         ((state.iFlags & WINDOWSTATE_VISIBLE) ? SWP_SHOWWINDOW : SWP_HIDEWINDOW);
+
+      if ( state.iFlags & (WINDOWSTATE_MINIMIZED | WINDOWSTATE_MAXIMIZED) )
+      {
+         uFlags |= SWP_NOMOVE | SWP_NOSIZE;
+      }
+
+      if ( hDwp )
+      {
+         hDwp = ::DeferWindowPos( hDwp, hWnd, hWndAfter, 
+            state.iX, state.iY, state.iWidth, state.iHeight, uFlags );
+
+         /**
+          * A failed DeferWindowPos() drops the whole transaction,
+          * start over placing the windows one by one
+          */
+
+         if ( !hDwp )
+         {
+            hWndAfter = HWND_TOP;
+            iLoop = (size_t) -1;
+
+            continue;
+         }
+      }
+      else
+      {
+         ::SetWindowPos( hWnd, hWndAfter, 
+            state.iX, state.iY, state.iWidth, state.iHeight, uFlags );
+      }
+
+      hWndAfter = hWnd;
+   }
+
+   if ( hDwp )
+   {
+      ::EndDeferWindowPos( hDwp );
+   }
+
+   return GetMilliseconds() - dStart;
+}
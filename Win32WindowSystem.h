@@ -0,0 +1,102 @@
+/**
+ * Win32WindowSystem.h - PuTTYCS Win32 window system
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WIN32WINDOWSYSTEM_H__INCLUDED_)
+#define WIN32WINDOWSYSTEM_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "WindowSystem.h"
+
+class CKeyProgramCache;
+
+/**
+ * CWin32WindowSystem
+ *
+ * The desktop: PuTTY windows found with EnumWindows(), activated the
+ * way PuTTYCS always has, typed into with CSendKeys and waited for
+ * with CWindowWait.
+ */
+
+class CWin32WindowSystem : public CWindowSystem
+{
+public:
+
+   CWin32WindowSystem();
+   virtual ~CWin32WindowSystem();
+
+   virtual void EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows );
+
+   virtual double Activate( WINDOWID id );
+   virtual bool IsForeground( WINDOWID id );
+
+   virtual double WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                     int* piOutcome );
+
+   virtual double SendKeys( WINDOWID id, const std::string& sKeys );
+
+   virtual double WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                    int* piOutcome );
+
+   virtual bool GetCapsLock();
+
+   virtual bool GetWindowState( WINDOWID id, WINDOWSTATE& state );
+   virtual double SetWindowStates( const std::vector<WINDOWSTATE>& vecStates );
+
+   void SetProgramCache( CKeyProgramCache* pCache );
+   void SetInputIdleFloor( unsigned long ulFloorMs );
+
+   static HWND GetHwnd( WINDOWID id );
+   static WINDOWID GetId( HWND hWnd );
+
+protected:
+
+   struct ENUMWINDOWS
+   {
+      std::vector<WINDOWINFO>* pWindows;
+      size_t iCount;
+   };
+
+   static BOOL CALLBACK enumwindowsProc( HWND hwnd, LPARAM lParam );
+   static double GetMilliseconds();
+   static POINT GetWorkspaceOffset( HWND hWnd );
+
+   CSendKeys m_skSendKeys;
+
+   CKeyProgramCache* m_pProgramCache;
+
+   unsigned long m_ulInputIdleFloor;
+};
+
+#endif // !defined(WIN32WINDOWSYSTEM_H__INCLUDED_)
@@ -0,0 +1,178 @@
+/**
+ * WindowActions.cpp - PuTTYCS bulk window actions
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "WindowActions.h"
+#include "Win32WindowSystem.h"
+
+#include <unordered_set>
+#include <vector>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * CWindowActions::Minimize()
+ *
+ * Hidden windows are shown minimized. Returns the number of windows.
+ */
+
+int CWindowActions::Minimize( const std::vector<WINDOWINFO>& vecWindows )
+{
+   return ShowAsync( vecWindows, SW_SHOWMINNOACTIVE, true );
+}
+
+/**
+ * CWindowActions::Hide()
+ *
+ * Returns the number of windows that were visible
+ */
+
+int CWindowActions::Hide( const std::vector<WINDOWINFO>& vecWindows )
+{
+   return ShowAsync( vecWindows, SW_HIDE, false );
+}
+
+/**
+ * CWindowActions::Show()
+ *
+ * Returns the number of windows that were hidden
+ */
+
+int CWindowActions::Show( const std::vector<WINDOWINFO>& vecWindows )
+{
+   return ShowAsync( vecWindows, SW_SHOWNA, true );
+}
+
+/**
+ * CWindowActions::ShowAsync()
+ *
+ * Posts iCmdShow to every window that is not already in that state:
+ * hidden ones if bVisible, visible ones otherwise. Minimize is
+ * posted to every window that is not iconic.
+ */
+
+int CWindowActions::ShowAsync( const std::vector<WINDOWINFO>& vecWindows, int iCmdShow, bool bVisible )
+{
+   int iWindows = 0;
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      HWND hWnd = CWin32WindowSystem::GetHwnd( vecWindows[iLoop].id );
+
+      bool bChange = (iCmdShow == SW_SHOWMINNOACTIVE) ? 
+         !::IsIconic( hWnd ) || !::IsWindowVisible( hWnd ) :
+         ((::IsWindowVisible( hWnd ) != FALSE) != bVisible);
+
+      if ( bChange && ::ShowWindowAsync(hWnd, iCmdShow) )
+      {
+         iWindows++;
+      }
+   }
+
+   return iWindows;
+}
+
+/**
+ * CWindowActions::Terminate()
+ *
+ * Terminates the process of every window, each process once, and
+ * waits at most dwTimeout ms for them all to exit. PuTTYCS itself is
+ * never terminated. Returns the number of processes terminated.
+ */
+
+int CWindowActions::Terminate( const std::vector<WINDOWINFO>& vecWindows, DWORD dwTimeout )
+{
+   std::unordered_set<DWORD> setPids;
+   std::vector<HANDLE> vecProcesses;
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      HWND hWnd = CWin32WindowSystem::GetHwnd( vecWindows[iLoop].id );
+
+      DWORD dwPid = 0;
+      ::GetWindowThreadProcessId( hWnd, &dwPid );
+
+      if ( !dwPid || (dwPid == ::GetCurrentProcessId()) || !setPids.insert(dwPid).second )
+      {
+         continue;
+      }
+
+      HANDLE hProcess =
+         ::OpenProcess( PROCESS_TERMINATE | SYNCHRONIZE, FALSE, dwPid );
+
+      if ( !hProcess )
+      {
+         continue;
+      }
+
+      /**
+       * TerminateProcess() only starts the termination, all
+       * processes wind down at the same time
+       */
+
+      if ( ::TerminateProcess(hProcess, (DWORD) -1) )
+      {
+         vecProcesses.push_back( hProcess );
+      }
+      else
+      {
+         ::CloseHandle( hProcess );
+      }
+   }
+
+   DWORD dwStart = ::GetTickCount();
+
+   for ( size_t iFirst = 0; iFirst < vecProcesses.size(); iFirst += MAXIMUM_WAIT_OBJECTS )
+   {
+      DWORD dwElapsed = ::GetTickCount() - dwStart;
+
+      if ( dwElapsed >= dwTimeout )
+      {
+         break;
+      }
+
+      DWORD dwCount = (DWORD) min( vecProcesses.size() - iFirst, (size_t) MAXIMUM_WAIT_OBJECTS );
+
+      ::WaitForMultipleObjects( dwCount, &vecProcesses[iFirst], TRUE, dwTimeout - dwElapsed );
+   }
+
+   for ( size_t iLoop = 0; iLoop < vecProcesses.size(); iLoop++ )
+   {
+      ::CloseHandle( vecProcesses[iLoop] );
+   }
+
+   return (int) vecProcesses.size();
+}
@@ -0,0 +1,69 @@
+/**
+ * WindowActions.h - PuTTYCS bulk window actions
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WINDOWACTIONS_H__INCLUDED_)
+#define WINDOWACTIONS_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+
+#include "WindowSystem.h"
+
+/**
+ * CWindowActions
+ *
+ * Minimizes, hides, shows or closes all windows of a selection
+ * without waiting on any of them in turn. Show state changes are
+ * posted with ShowWindowAsync(), so a hung PuTTY does not hold up
+ * the others. Closing terminates each process once, however many
+ * windows it has, and then waits for all of them together.
+ */
+
+class CWindowActions
+{
+public:
+
+   static int Minimize( const std::vector<WINDOWINFO>& vecWindows );
+   static int Hide( const std::vector<WINDOWINFO>& vecWindows );
+   static int Show( const std::vector<WINDOWINFO>& vecWindows );
+
+   static int Terminate( const std::vector<WINDOWINFO>& vecWindows, DWORD dwTimeout );
+
+protected:
+
+   static int ShowAsync( const std::vector<WINDOWINFO>& vecWindows, int iCmdShow, bool bVisible );
+};
+
+#endif // !defined(WINDOWACTIONS_H__INCLUDED_)
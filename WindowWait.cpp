@@ -0,0 +1,432 @@
+/**
+ * WindowWait.cpp - PuTTYCS condition based window waits
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "stdafx.h"
+#include "WindowWait.h"
+
+#include <mmsystem.h>
+
+#pragma comment(lib, "winmm.lib")
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/**
+ * dwmapi.dll is loaded at run time, like SetLayeredWindowAttributes,
+ * so PuTTYCS still starts on systems without it
+ */
+
+typedef HRESULT (WINAPI *lpfnDwmFlush) ( void );
+
+WAITSTATS CWindowWait::g_wsStats[CWindowWait::SITE_COUNT];
+
+static const TCHAR* g_szSiteNames[CWindowWait::SITE_COUNT] =
+{
+   _T( "transition" ),
+   _T( "post send" ),
+   _T( "minimize" ),
+   _T( "redraw" )
+};
+
+/**
+ * CWindowWait::GetMilliseconds()
+ */
+
+double CWindowWait::GetMilliseconds()
+{
+   static LARGE_INTEGER liFrequency = { 0 };
+
+   if ( liFrequency.QuadPart == 0 )
+   {
+      ::QueryPerformanceFrequency( &liFrequency );
+   }
+
+   LARGE_INTEGER liCounter;
+   ::QueryPerformanceCounter( &liCounter );
+
+   return ((double) liCounter.QuadPart * 1000.0) / (double) liFrequency.QuadPart;
+}
+
+/**
+ * CWindowWait::FlushComposition()
+ *
+ * Blocks until the desktop compositor has presented a frame.
+ * Returns false when there is no compositor to wait for.
+ */
+
+bool CWindowWait::FlushComposition()
+{
+   static bool bLoaded = false;
+   static lpfnDwmFlush pDwmFlush = NULL;
+
+   if ( !bLoaded )
+   {
+      HMODULE hDwmApi = ::LoadLibrary( _T("DWMAPI.DLL") );
+
+      if ( hDwmApi )
+      {
+         pDwmFlush = (lpfnDwmFlush) ::GetProcAddress( hDwmApi, "DwmFlush" );
+      }
+
+      bLoaded = true;
+   }
+
+   if ( pDwmFlush )
+   {
+      return SUCCEEDED( pDwmFlush() );
+   }
+
+   return false;
+}
+
+/**
+ * CWindowWait::IsForeground()
+ *
+ * The window is active and owns keyboard focus in its thread.
+ */
+
+int CWindowWait::IsForeground( const HWND* phWnds, int iCount )
+{
+   HWND hWnd = phWnds[0];
+
+   if ( ::GetForegroundWindow() != hWnd )
+   {
+      return CONDITION_NOT_MET;
+   }
+
+   GUITHREADINFO gti;
+   ZeroMemory( &gti, sizeof(gti) );
+   gti.cbSize = sizeof(gti);
+
+   if ( !::GetGUIThreadInfo( ::GetWindowThreadProcessId(hWnd, NULL), &gti ) )
+   {
+      return CONDITION_UNOBSERVABLE;
+   }
+
+   return ((gti.hwndFocus == hWnd) || (gti.hwndActive == hWnd)) ?
+      CONDITION_MET : CONDITION_NOT_MET;
+}
+
+/**
+ * CWindowWait::IsInputHandled()
+ *
+ * Every window's thread answers a WM_NULL sent after the keys were
+ * typed, so it is not hung and is pumping messages. That does not
+ * mean the keys were read: GetMessage() dispatches sent messages
+ * before it looks at posted and input messages, so the WM_NULL is
+ * answered while keystrokes are still queued. Other threads' input
+ * queues can not be inspected, so ForInputIdle() keeps a floor under
+ * this wait. WaitForInputIdle() can not tell even this much: it
+ * returns at once for any process that was idle once.
+ */
+
+int CWindowWait::IsInputHandled( const HWND* phWnds, int iCount )
+{
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      if ( !::IsWindow(phWnds[iLoop]) )
+      {
+         return CONDITION_UNOBSERVABLE;
+      }
+
+      DWORD_PTR dwResult = 0;
+
+      if ( !::SendMessageTimeout(phWnds[iLoop], WM_NULL, 0, 0, SMTO_ABORTIFHUNG, 
+              PUTTYCS_WAIT_PROBE_TIMEOUT, &dwResult) )
+      {
+         return (::GetLastError() == ERROR_TIMEOUT) ? 
+            CONDITION_NOT_MET : CONDITION_UNOBSERVABLE;
+      }
+   }
+
+   return CONDITION_MET;
+}
+
+/**
+ * CWindowWait::IsMinimized()
+ *
+ * Every window is iconic and has processed its pending input.
+ */
+
+int CWindowWait::IsMinimized( const HWND* phWnds, int iCount )
+{
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      if ( ::IsWindow(phWnds[iLoop]) && !::IsIconic(phWnds[iLoop]) )
+      {
+         return CONDITION_NOT_MET;
+      }
+   }
+
+   return IsInputHandled( phWnds, iCount );
+}
+
+/**
+ * CWindowWait::IsRedrawn()
+ *
+ * The window has no invalid region left and the compositor has
+ * presented it.
+ */
+
+int CWindowWait::IsRedrawn( const HWND* phWnds, int iCount )
+{
+   HWND hWnd = phWnds[0];
+
+   ::UpdateWindow( hWnd );
+
+   if ( ::GetUpdateRect(hWnd, NULL, FALSE) )
+   {
+      return CONDITION_NOT_MET;
+   }
+
+   return FlushComposition() ? 
+      CONDITION_MET : CONDITION_UNOBSERVABLE;
+}
+
+/**
+ * CWindowWait::WaitFor()
+ *
+ * Polls the condition at 1 ms resolution. A condition must hold on
+ * two consecutive polls, because injected keystrokes reach the
+ * target's queue slightly after keybd_event() returns.
+ */
+
+double CWindowWait::WaitFor( int iSite, PFNCONDITION pfnCondition,
+                             const HWND* phWnds, int iCount, DWORD dwFixed,
+                             DWORD dwFloor, int* piOutcome )
+{
+   double dStart = GetMilliseconds();
+   double dTimeout = (double) (dwFixed * PUTTYCS_WAIT_TIMEOUT_FACTOR);
+
+   WAITSTATS& stats = g_wsStats[iSite];
+
+   int iMet = 0;
+   int iResult = CONDITION_NOT_MET;
+
+   if ( iCount > 0 )
+   {
+      ::timeBeginPeriod( 1 );
+
+      while ( true )
+      {
+         iResult = pfnCondition( phWnds, iCount );
+
+         if ( iResult == CONDITION_UNOBSERVABLE )
+         {
+            break;
+         }
+
+         iMet = (iResult == CONDITION_MET) ? (iMet + 1) : 0;
+
+         if ( iMet >= 2 )
+         {
+            break;
+         }
+
+         if ( (GetMilliseconds() - dStart) >= dTimeout )
+         {
+            stats.dwTimeouts++;
+            break;
+         }
+
+         ::Sleep( 1 );
+      }
+
+      ::timeEndPeriod( 1 );
+   }
+   else
+   {
+      iResult = CONDITION_UNOBSERVABLE;
+   }
+
+   if ( iResult == CONDITION_UNOBSERVABLE )
+   {
+      double dRemaining = dwFixed - (GetMilliseconds() - dStart);
+
+      if ( dRemaining > 0 )
+      {
+         ::Sleep( (DWORD) dRemaining );
+      }
+
+      stats.dwFallbacks++;
+   }
+
+   double dFloor = dwFloor - (GetMilliseconds() - dStart);
+
+   if ( dFloor > 0 )
+   {
+      ::Sleep( (DWORD) ceil(dFloor) );
+   }
+
+   if ( piOutcome )
+   {
+      if ( iMet >= 2 )
+      {
+         *piOutcome = WAITOUTCOME_MET;
+      }
+      else
+      {
+         *piOutcome = (iResult == CONDITION_UNOBSERVABLE) ? 
+            WAITOUTCOME_FIXED : WAITOUTCOME_TIMEOUT;
+      }
+   }
+
+   double dObserved = GetMilliseconds() - dStart;
+
+   stats.dwCount++;
+   stats.dObservedMs += dObserved;
+   stats.dFixedMs += dwFixed;
+
+   if ( dObserved > stats.dMaxMs )
+   {
+      stats.dMaxMs = dObserved;
+   }
+
+   return dObserved;
+}
+
+/**
+ * CWindowWait::ForForeground()
+ */
+
+double CWindowWait::ForForeground( HWND hWnd, DWORD dwFixed, int* piOutcome )
+{
+   return WaitFor( SITE_TRANSITION, IsForeground, &hWnd, 1, dwFixed, 0, piOutcome );
+}
+
+/**
+ * CWindowWait::ForInputIdle()
+ *
+ * Takes at least dwFloor ms, the configured post send delay: the
+ * condition only shows that the window's thread answers, not that
+ * the keys left its queue (see IsInputHandled()). Without the floor
+ * a tuned delay of a few ms let the next activation take the keys
+ * still queued into another window.
+ */
+
+double CWindowWait::ForInputIdle( HWND hWnd, DWORD dwFixed, DWORD dwFloor, int* piOutcome )
+{
+   return WaitFor( SITE_POST_SEND, IsInputHandled, &hWnd, 1, dwFixed, dwFloor, piOutcome );
+}
+
+/**
+ * CWindowWait::ForMinimized()
+ *
+ * The minimize animation itself can not be observed, so when it is
+ * enabled one composed frame is awaited after the windows are iconic.
+ */
+
+double CWindowWait::ForMinimized( const HWND* phWnds, int iCount, DWORD dwFixed )
+{
+   double dObserved = WaitFor( SITE_MINIMIZE, IsMinimized, phWnds, iCount, dwFixed, 0 );
+
+   ANIMATIONINFO ai;
+   ai.cbSize = sizeof(ai);
+
+   if ( ::SystemParametersInfo(SPI_GETANIMATION, sizeof(ai), &ai, 0) && ai.iMinAnimate )
+   {
+      double dStart = GetMilliseconds();
+
+      FlushComposition();
+
+      double dFlush = GetMilliseconds() - dStart;
+
+      g_wsStats[SITE_MINIMIZE].dObservedMs += dFlush;
+      dObserved += dFlush;
+   }
+
+   return dObserved;
+}
+
+/**
+ * CWindowWait::ForRedraw()
+ */
+
+double CWindowWait::ForRedraw( HWND hWnd, DWORD dwFixed )
+{
+   return WaitFor( SITE_REDRAW, IsRedrawn, &hWnd, 1, dwFixed, 0 );
+}
+
+/**
+ * CWindowWait::GetStats()
+ */
+
+const WAITSTATS& CWindowWait::GetStats( int iSite )
+{
+   return g_wsStats[iSite];
+}
+
+/**
+ * CWindowWait::GetSummary()
+ */
+
+CString CWindowWait::GetSummary()
+{
+   CString csSummary;
+
+   for ( int iSite = 0; iSite < SITE_COUNT; iSite++ )
+   {
+      const WAITSTATS& stats = g_wsStats[iSite];
+
+      if ( stats.dwCount == 0 )
+      {
+         continue;
+      }
+
+      CString csLine;
+      csLine.Format( PUTTYCS_WAIT_SUMMARY_FORMAT,
+                     g_szSiteNames[iSite],
+                     stats.dwCount,
+                     stats.dObservedMs,
+                     stats.dFixedMs,
+                     stats.dFixedMs - stats.dObservedMs,
+                     stats.dMaxMs,
+                     stats.dwTimeouts,
+                     stats.dwFallbacks );
+
+      csSummary += csLine;
+   }
+
+   return csSummary;
+}
+
+/**
+ * CWindowWait::ResetStats()
+ */
+
+void CWindowWait::ResetStats()
+{
+   ZeroMemory( g_wsStats, sizeof(g_wsStats) );
+}
@@ -0,0 +1,117 @@
+/**
+ * WindowWait.h - PuTTYCS condition based window waits header
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WINDOWWAIT_H__INCLUDED_)
+#define WINDOWWAIT_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "WindowSystem.h"
+
+/**
+ * Observed time spent in one wait site compared to the fixed
+ * delay it replaces
+ */
+
+struct WAITSTATS
+{
+   DWORD dwCount;
+   DWORD dwTimeouts;
+   DWORD dwFallbacks;
+
+   double dObservedMs;
+   double dFixedMs;
+   double dMaxMs;
+};
+
+/**
+ * CWindowWait
+ *
+ * Blocks until an observable window condition holds instead of
+ * sleeping for a fixed time. Every wait is capped at a multiple of
+ * the fixed delay it replaces. When a condition can not be observed
+ * (e.g. the target process can not be opened) the fixed delay is
+ * used as before.
+ */
+
+class CWindowWait
+{
+public:
+
+   enum
+   {
+      SITE_TRANSITION = 0,
+      SITE_POST_SEND,
+      SITE_MINIMIZE,
+      SITE_REDRAW,
+      SITE_COUNT
+   };
+
+   static double ForForeground( HWND hWnd, DWORD dwFixed, int* piOutcome = NULL );
+   static double ForInputIdle( HWND hWnd, DWORD dwFixed, DWORD dwFloor, int* piOutcome = NULL );
+   static double ForMinimized( const HWND* phWnds, int iCount, DWORD dwFixed );
+   static double ForRedraw( HWND hWnd, DWORD dwFixed );
+
+   static const WAITSTATS& GetStats( int iSite );
+   static CString GetSummary();
+   static void ResetStats();
+
+protected:
+
+   enum
+   {
+      CONDITION_NOT_MET = 0,
+      CONDITION_MET,
+      CONDITION_UNOBSERVABLE
+   };
+
+   typedef int (*PFNCONDITION)( const HWND* phWnds, int iCount );
+
+   static double WaitFor( int iSite, PFNCONDITION pfnCondition,
+                          const HWND* phWnds, int iCount, DWORD dwFixed,
+                          DWORD dwFloor, int* piOutcome = NULL );
+
+   static int IsForeground( const HWND* phWnds, int iCount );
+   static int IsInputHandled( const HWND* phWnds, int iCount );
+   static int IsMinimized( const HWND* phWnds, int iCount );
+   static int IsRedrawn( const HWND* phWnds, int iCount );
+
+   static bool FlushComposition();
+
+   static double GetMilliseconds();
+
+   static WAITSTATS g_wsStats[SITE_COUNT];
+};
+
+#endif // !defined(WINDOWWAIT_H__INCLUDED_)
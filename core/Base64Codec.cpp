@@ -0,0 +1,585 @@
+/**
+ * Base64Codec.cpp - PuTTYCS BASE64 encoder/decoder
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "Base64Codec.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BASE64_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BASE64_TARGET(x)
+#else
+#define BASE64_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+static const char BASE64_CHARS[] =
+   "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const unsigned char BASE64_INVALID = 0xFF;
+
+/**
+ * Character to 6 bit value, BASE64_INVALID outside the alphabet
+ */
+
+static const unsigned char BASE64_DECODE[256] =
+{
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,   62, 0xFF, 0xFF, 0xFF,   63,
+     52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+     15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+     41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+int CBase64Codec::m_iKernel = CBase64Codec::KERNEL_AUTO;
+
+/**
+ * CBase64Codec::IsKernelSupported()
+ */
+
+bool CBase64Codec::IsKernelSupported( int iKernel )
+{
+   if ( iKernel == KERNEL_SCALAR )
+   {
+      return true;
+   }
+
+#if defined(BASE64_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+   int aiInfo[4];
+
+   __cpuid( aiInfo, 0 );
+
+   int iMaxLeaf = aiInfo[0];
+
+   __cpuid( aiInfo, 1 );
+
+   bool bSsse3 = (aiInfo[2] & (1 << 9)) != 0;
+   bool bOsYmm = ((aiInfo[2] & (1 << 27)) != 0) && ((_xgetbv(0) & 6) == 6);
+
+   bool bAvx2 = false;
+
+   if ( bOsYmm && (iMaxLeaf >= 7) )
+   {
+      __cpuidex( aiInfo, 7, 0 );
+
+      bAvx2 = (aiInfo[1] & (1 << 5)) != 0;
+   }
+#else
+   __builtin_cpu_init();
+
+   bool bSsse3 = __builtin_cpu_supports( "ssse3" ) != 0;
+   bool bAvx2 = __builtin_cpu_supports( "avx2" ) != 0;
+#endif
+
+   if ( iKernel == KERNEL_SSSE3 )
+   {
+      return bSsse3;
+   }
+
+   if ( iKernel == KERNEL_AVX2 )
+   {
+      return bAvx2;
+   }
+#endif
+
+   return false;
+}
+
+/**
+ * CBase64Codec::SetKernel()
+ *
+ * Forces a kernel, for benchmarks and checks. Returns the kernel in
+ * use, which is the best supported one for KERNEL_AUTO or when the
+ * CPU lacks the requested one.
+ */
+
+int CBase64Codec::SetKernel( int iKernel )
+{
+   if ( (iKernel == KERNEL_AUTO) || !IsKernelSupported(iKernel) )
+   {
+      iKernel = IsKernelSupported( KERNEL_AVX2 ) ? KERNEL_AVX2 :
+                IsKernelSupported( KERNEL_SSSE3 ) ? KERNEL_SSSE3 : KERNEL_SCALAR;
+   }
+
+   m_iKernel = iKernel;
+
+   return m_iKernel;
+}
+
+/**
+ * CBase64Codec::GetKernel()
+ */
+
+int CBase64Codec::GetKernel()
+{
+   if ( m_iKernel == KERNEL_AUTO )
+   {
+      SetKernel( KERNEL_AUTO );
+   }
+
+   return m_iKernel;
+}
+
+/**
+ * CBase64Codec::GetEncodedLength()
+ */
+
+size_t CBase64Codec::GetEncodedLength( size_t iBytes )
+{
+   return ((iBytes + 2) / 3) * 4;
+}
+
+/**
+ * CBase64Codec::GetDecodeBufferSize()
+ *
+ * Room for the bytes of iChars characters plus the stores of the
+ * vector kernels, which write up to 8 bytes past their output
+ */
+
+size_t CBase64Codec::GetDecodeBufferSize( size_t iChars )
+{
+   return (iChars / 4) * 3 + 2 + 8;
+}
+
+/**
+ * CBase64Codec::Encode()
+ */
+
+std::string CBase64Codec::Encode( const std::string& sBytes )
+{
+   std::string sValue( GetEncodedLength(sBytes.size()), '\0' );
+
+   if ( !sValue.empty() )
+   {
+      Encode( (const unsigned char*) sBytes.data(), sBytes.size(), &sValue[0] );
+   }
+
+   return sValue;
+}
+
+/**
+ * CBase64Codec::Decode()
+ */
+
+std::string CBase64Codec::Decode( const std::string& sText )
+{
+   std::string sValue( GetDecodeBufferSize(sText.size()), '\0' );
+
+   sValue.resize( Decode(sText.data(), sText.size(), (unsigned char*) &sValue[0]) );
+
+   return sValue;
+}
+
+/**
+ * CBase64Codec::Encode()
+ *
+ * pszOut receives GetEncodedLength(iLength) characters, no NUL.
+ * Returns the number of characters.
+ */
+
+size_t CBase64Codec::Encode( const unsigned char* pbyIn, size_t iLength, char* pszOut )
+{
+   size_t iDone = 0;
+
+   int iKernel = GetKernel();
+
+   if ( iKernel == KERNEL_AVX2 )
+   {
+      iDone = EncodeAvx2( pbyIn, iLength, pszOut );
+   }
+
+   if ( iKernel >= KERNEL_SSSE3 )
+   {
+      iDone += EncodeSsse3( pbyIn + iDone, iLength - iDone, pszOut + (iDone / 3) * 4 );
+   }
+
+   return (iDone / 3) * 4 + EncodeScalar( pbyIn + iDone, iLength - iDone, pszOut + (iDone / 3) * 4 );
+}
+
+/**
+ * CBase64Codec::Decode()
+ *
+ * pbyOut must hold GetDecodeBufferSize(iLength) bytes. Returns the
+ * number of bytes decoded.
+ */
+
+size_t CBase64Codec::Decode( const char* pszIn, size_t iLength, unsigned char* pbyOut )
+{
+   size_t iDone = 0;
+
+   int iKernel = GetKernel();
+
+   if ( iKernel == KERNEL_AVX2 )
+   {
+      iDone = DecodeAvx2( pszIn, iLength, pbyOut );
+   }
+
+   if ( iKernel >= KERNEL_SSSE3 )
+   {
+      iDone += DecodeSsse3( pszIn + iDone, iLength - iDone, pbyOut + (iDone / 4) * 3 );
+   }
+
+   return (iDone / 4) * 3 + DecodeScalar( pszIn + iDone, iLength - iDone, pbyOut + (iDone / 4) * 3 );
+}
+
+/**
+ * CBase64Codec::EncodeScalar()
+ *
+ * Returns the number of characters written
+ */
+
+size_t CBase64Codec::EncodeScalar( const unsigned char* pbyIn, size_t iLength, char* pszOut )
+{
+   char* pszStart = pszOut;
+
+   for ( ; iLength >= 3; iLength -= 3, pbyIn += 3 )
+   {
+      unsigned long ulGroup = 
+         ((unsigned long) pbyIn[0] << 16) | ((unsigned long) pbyIn[1] << 8) | pbyIn[2];
+
+      *pszOut++ = BASE64_CHARS[(ulGroup >> 18) & 0x3F];
+      *pszOut++ = BASE64_CHARS[(ulGroup >> 12) & 0x3F];
+      *pszOut++ = BASE64_CHARS[(ulGroup >> 6) & 0x3F];
+      *pszOut++ = BASE64_CHARS[ulGroup & 0x3F];
+   }
+
+   if ( iLength > 0 )
+   {
+      unsigned long ulGroup = (unsigned long) pbyIn[0] << 16;
+
+      if ( iLength > 1 )
+      {
+         ulGroup |= (unsigned long) pbyIn[1] << 8;
+      }
+
+      *pszOut++ = BASE64_CHARS[(ulGroup >> 18) & 0x3F];
+      *pszOut++ = BASE64_CHARS[(ulGroup >> 12) & 0x3F];
+      *pszOut++ = (iLength > 1) ? BASE64_CHARS[(ulGroup >> 6) & 0x3F] : '=';
+      *pszOut++ = '=';
+   }
+
+   return pszOut - pszStart;
+}
+
+/**
+ * CBase64Codec::DecodeScalar()
+ *
+ * Returns the number of bytes written
+ */
+
+size_t CBase64Codec::DecodeScalar( const char* pszIn, size_t iLength, unsigned char* pbyOut )
+{
+   const unsigned char* pbyIn = (const unsigned char*) pszIn;
+
+   unsigned char* pbyStart = pbyOut;
+
+   for ( ; iLength >= 4; iLength -= 4, pbyIn += 4 )
+   {
+      unsigned char by0 = BASE64_DECODE[pbyIn[0]];
+      unsigned char by1 = BASE64_DECODE[pbyIn[1]];
+      unsigned char by2 = BASE64_DECODE[pbyIn[2]];
+      unsigned char by3 = BASE64_DECODE[pbyIn[3]];
+
+      if ( (by0 | by1 | by2 | by3) & 0x80 )
+      {
+         break;
+      }
+
+      *pbyOut++ = (unsigned char) ((by0 << 2) | (by1 >> 4));
+      *pbyOut++ = (unsigned char) ((by1 << 4) | (by2 >> 2));
+      *pbyOut++ = (unsigned char) ((by2 << 6) | by3);
+   }
+
+   // A partial group, or the group holding the first invalid character
+
+   unsigned char abyGroup[4];
+   size_t iValid = 0;
+
+   while ( (iValid < iLength) && (iValid < 4) && 
+           ((abyGroup[iValid] = BASE64_DECODE[pbyIn[iValid]]) != BASE64_INVALID) )
+   {
+      iValid++;
+   }
+
+   if ( iValid > 1 )
+   {
+      *pbyOut++ = (unsigned char) ((abyGroup[0] << 2) | (abyGroup[1] >> 4));
+   }
+
+   if ( iValid > 2 )
+   {
+      *pbyOut++ = (unsigned char) ((abyGroup[1] << 4) | (abyGroup[2] >> 2));
+   }
+
+   return pbyOut - pbyStart;
+}
+
+#if defined(BASE64_X86)
+
+/**
+ * The vector kernels follow W. Mula and D. Lemire, "Faster Base64
+ * Encoding and Decoding Using AVX2 Instructions". Each returns the
+ * number of input bytes it consumed: whole blocks, stopping before
+ * the first block that holds a character outside the alphabet.
+ */
+
+/**
+ * CBase64Codec::EncodeSsse3()
+ */
+
+BASE64_TARGET("ssse3")
+size_t CBase64Codec::EncodeSsse3( const unsigned char* pbyIn, size_t iLength, char* pszOut )
+{
+   const __m128i shuffle = _mm_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 );
+   const __m128i offsets = _mm_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 );
+
+   size_t iDone = 0;
+
+   // 16 bytes are read for every 12 used
+
+   for ( ; iLength - iDone >= 16; iDone += 12, pszOut += 16 )
+   {
+      __m128i in = _mm_shuffle_epi8( _mm_loadu_si128((const __m128i*) (pbyIn + iDone)), shuffle );
+
+      // Split every 3 bytes into four 6 bit values
+
+      __m128i t0 = _mm_mulhi_epu16( _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), 
+                                    _mm_set1_epi32(0x04000040) );
+      __m128i t1 = _mm_mullo_epi16( _mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), 
+                                    _mm_set1_epi32(0x01000010) );
+
+      __m128i values = _mm_or_si128( t0, t1 );
+
+      // Offset of each value's range in the alphabet
+
+      __m128i indices = _mm_subs_epu8( values, _mm_set1_epi8(51) );
+      indices = _mm_sub_epi8( indices, _mm_cmpgt_epi8(values, _mm_set1_epi8(25)) );
+
+      _mm_storeu_si128( (__m128i*) pszOut, 
+         _mm_add_epi8(values, _mm_shuffle_epi8(offsets, indices)) );
+   }
+
+   return iDone;
+}
+
+/**
+ * CBase64Codec::DecodeSsse3()
+ */
+
+BASE64_TARGET("ssse3")
+size_t CBase64Codec::DecodeSsse3( const char* pszIn, size_t iLength, unsigned char* pbyOut )
+{
+   const __m128i lutLo = _mm_setr_epi8( 
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A );
+   const __m128i lutHi = _mm_setr_epi8( 
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+   const __m128i lutRoll = _mm_setr_epi8( 
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 );
+   const __m128i pack = _mm_setr_epi8( 
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 );
+   const __m128i mask2F = _mm_set1_epi8( 0x2F );
+
+   size_t iDone = 0;
+
+   // 16 bytes are stored for every 12 decoded
+
+   for ( ; iLength - iDone >= 16; iDone += 16, pbyOut += 12 )
+   {
+      __m128i in = _mm_loadu_si128( (const __m128i*) (pszIn + iDone) );
+
+      __m128i hiNibbles = _mm_and_si128( _mm_srli_epi32(in, 4), mask2F );
+      __m128i loNibbles = _mm_and_si128( in, mask2F );
+
+      __m128i invalid = _mm_and_si128( _mm_shuffle_epi8(lutLo, loNibbles), 
+                                       _mm_shuffle_epi8(lutHi, hiNibbles) );
+
+      if ( _mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())) )
+      {
+         break;
+      }
+
+      __m128i roll = _mm_shuffle_epi8( lutRoll, 
+         _mm_add_epi8(_mm_cmpeq_epi8(in, mask2F), hiNibbles) );
+
+      __m128i values = _mm_add_epi8( in, roll );
+
+      // Join four 6 bit values into 3 bytes
+
+      __m128i merged = _mm_madd_epi16( 
+         _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000) );
+
+      _mm_storeu_si128( (__m128i*) pbyOut, _mm_shuffle_epi8(merged, pack) );
+   }
+
+   return iDone;
+}
+
+/**
+ * CBase64Codec::EncodeAvx2()
+ *
+ * Each 128 bit lane does what EncodeSsse3() does
+ */
+
+BASE64_TARGET("avx2")
+size_t CBase64Codec::EncodeAvx2( const unsigned char* pbyIn, size_t iLength, char* pszOut )
+{
+   const __m256i shuffle = _mm256_set_epi8( 
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 );
+   const __m256i offsets = _mm256_setr_epi8( 
+      65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+      65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0 );
+
+   size_t iDone = 0;
+
+   // The second lane reads 16 bytes from 12 in
+
+   for ( ; iLength - iDone >= 28; iDone += 24, pszOut += 32 )
+   {
+      __m256i in = _mm256_inserti128_si256( 
+         _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (pbyIn + iDone))),
+         _mm_loadu_si128((const __m128i*) (pbyIn + iDone + 12)), 1 );
+
+      in = _mm256_shuffle_epi8( in, shuffle );
+
+      __m256i t0 = _mm256_mulhi_epu16( _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), 
+                                       _mm256_set1_epi32(0x04000040) );
+      __m256i t1 = _mm256_mullo_epi16( _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), 
+                                       _mm256_set1_epi32(0x01000010) );
+
+      __m256i values = _mm256_or_si256( t0, t1 );
+
+      __m256i indices = _mm256_subs_epu8( values, _mm256_set1_epi8(51) );
+      indices = _mm256_sub_epi8( indices, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)) );
+
+      _mm256_storeu_si256( (__m256i*) pszOut, 
+         _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, indices)) );
+   }
+
+   return iDone;
+}
+
+/**
+ * CBase64Codec::DecodeAvx2()
+ */
+
+BASE64_TARGET("avx2")
+size_t CBase64Codec::DecodeAvx2( const char* pszIn, size_t iLength, unsigned char* pbyOut )
+{
+   const __m256i lutLo = _mm256_setr_epi8( 
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A );
+   const __m256i lutHi = _mm256_setr_epi8( 
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+   const __m256i lutRoll = _mm256_setr_epi8( 
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 );
+   const __m256i pack = _mm256_setr_epi8( 
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 );
+   const __m256i mask2F = _mm256_set1_epi8( 0x2F );
+
+   size_t iDone = 0;
+
+   // 32 bytes are stored for every 24 decoded
+
+   for ( ; iLength - iDone >= 32; iDone += 32, pbyOut += 24 )
+   {
+      __m256i in = _mm256_loadu_si256( (const __m256i*) (pszIn + iDone) );
+
+      __m256i hiNibbles = _mm256_and_si256( _mm256_srli_epi32(in, 4), mask2F );
+      __m256i loNibbles = _mm256_and_si256( in, mask2F );
+
+      __m256i invalid = _mm256_and_si256( _mm256_shuffle_epi8(lutLo, loNibbles), 
+                                          _mm256_shuffle_epi8(lutHi, hiNibbles) );
+
+      if ( _mm256_movemask_epi8(_mm256_cmpgt_epi8(invalid, _mm256_setzero_si256())) )
+      {
+         break;
+      }
+
+      __m256i roll = _mm256_shuffle_epi8( lutRoll, 
+         _mm256_add_epi8(_mm256_cmpeq_epi8(in, mask2F), hiNibbles) );
+
+      __m256i values = _mm256_add_epi8( in, roll );
+
+      __m256i merged = _mm256_madd_epi16( 
+         _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000) );
+
+      merged = _mm256_shuffle_epi8( merged, pack );
+
+      // Close the 4 byte gap between the lanes
+
+      _mm256_storeu_si256( (__m256i*) pbyOut, 
+         _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)) );
+   }
+
+   return iDone;
+}
+
+#else
+
+size_t CBase64Codec::EncodeSsse3( const unsigned char*, size_t, char* )
+{
+   return 0;
+}
+
+size_t CBase64Codec::DecodeSsse3( const char*, size_t, unsigned char* )
+{
+   return 0;
+}
+
+size_t CBase64Codec::EncodeAvx2( const unsigned char*, size_t, char* )
+{
+   return 0;
+}
+
+size_t CBase64Codec::DecodeAvx2( const char*, size_t, unsigned char* )
+{
+   return 0;
+}
+
+#endif // BASE64_X86
@@ -0,0 +1,95 @@
+/**
+ * Base64Codec.h - PuTTYCS BASE64 encoder/decoder
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(BASE64CODEC_H__INCLUDED_)
+#define BASE64CODEC_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+
+/**
+ * CBase64Codec
+ *
+ * BASE64 (RFC 4648) on bytes. Decoding stops at the first character
+ * outside the BASE64 alphabet (padding included) and keeps the
+ * complete bytes of a trailing partial group, as CBase64 always did.
+ *
+ * Inputs are run through an AVX2 or SSSE3 kernel where the CPU has
+ * one, 24 or 12 bytes at a time, and the table driven scalar code
+ * handles the tail and any block with a character outside the
+ * alphabet.
+ */
+
+class CBase64Codec
+{
+public:
+
+   enum
+   {
+      KERNEL_SCALAR = 0,
+      KERNEL_SSSE3,
+      KERNEL_AVX2,
+      KERNEL_AUTO
+   };
+
+   static std::string Encode( const std::string& sBytes );
+   static std::string Decode( const std::string& sText );
+
+   static size_t Encode( const unsigned char* pbyIn, size_t iLength, char* pszOut );
+   static size_t Decode( const char* pszIn, size_t iLength, unsigned char* pbyOut );
+
+   static size_t GetEncodedLength( size_t iBytes );
+   static size_t GetDecodeBufferSize( size_t iChars );
+
+   static int SetKernel( int iKernel );
+   static int GetKernel();
+
+   static bool IsKernelSupported( int iKernel );
+
+protected:
+
+   static size_t EncodeScalar( const unsigned char* pbyIn, size_t iLength, char* pszOut );
+   static size_t DecodeScalar( const char* pszIn, size_t iLength, unsigned char* pbyOut );
+
+   static size_t EncodeSsse3( const unsigned char* pbyIn, size_t iLength, char* pszOut );
+   static size_t DecodeSsse3( const char* pszIn, size_t iLength, unsigned char* pbyOut );
+
+   static size_t EncodeAvx2( const unsigned char* pbyIn, size_t iLength, char* pszOut );
+   static size_t DecodeAvx2( const char* pszIn, size_t iLength, unsigned char* pbyOut );
+
+   static int m_iKernel;
+};
+
+#endif // !defined(BASE64CODEC_H__INCLUDED_)
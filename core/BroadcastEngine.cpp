@@ -0,0 +1,534 @@
+/**
+ * BroadcastEngine.cpp - PuTTYCS portable broadcast engine
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "BroadcastEngine.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "FilterMatch.h"
+#include "SendTemplate.h"
+
+/**
+ * CBroadcastEngine::CBroadcastEngine()
+ */
+
+CBroadcastEngine::CBroadcastEngine( CWindowSystem* pWindowSystem )
+{
+   m_pWindowSystem = pWindowSystem;
+
+   m_iTransition = 25;
+   m_iPostSendDelay = 100;
+   m_iSendCR = 1;
+}
+
+/**
+ * CBroadcastEngine::~CBroadcastEngine()
+ */
+
+CBroadcastEngine::~CBroadcastEngine()
+{
+}
+
+/**
+ * CBroadcastEngine::SetTransition()
+ */
+
+void CBroadcastEngine::SetTransition( int iTransition )
+{
+   m_iTransition = iTransition;
+}
+
+/**
+ * CBroadcastEngine::SetPostSendDelay()
+ */
+
+void CBroadcastEngine::SetPostSendDelay( int iPostSendDelay )
+{
+   m_iPostSendDelay = iPostSendDelay;
+}
+
+/**
+ * CBroadcastEngine::SetSendCR()
+ */
+
+void CBroadcastEngine::SetSendCR( int iSendCR )
+{
+   m_iSendCR = iSendCR;
+}
+
+/**
+ * CBroadcastEngine::SetFilters()
+ *
+ * The saved filters, for @name references
+ */
+
+void CBroadcastEngine::SetFilters( const std::vector<std::string>& vecFilters )
+{
+   m_wiWindowIndex.SetFilters( vecFilters );
+}
+
+/**
+ * CBroadcastEngine::SetInventory()
+ *
+ * The file of the {%VAR:name%} tokens, empty for none
+ */
+
+void CBroadcastEngine::SetInventory( const std::string& sPath )
+{
+   m_hiInventory.SetPath( sPath );
+}
+
+/**
+ * CBroadcastEngine::GetWindowSystem()
+ */
+
+CWindowSystem* CBroadcastEngine::GetWindowSystem()
+{
+   return m_pWindowSystem;
+}
+
+/**
+ * CBroadcastEngine::GetDelayTuner()
+ */
+
+CDelayTuner& CBroadcastEngine::GetDelayTuner()
+{
+   return m_dtDelayTuner;
+}
+
+/**
+ * CBroadcastEngine::GetSendTrace()
+ */
+
+CSendTrace& CBroadcastEngine::GetSendTrace()
+{
+   return m_stSendTrace;
+}
+
+/**
+ * CBroadcastEngine::GetWindowIndex()
+ */
+
+CWindowIndex& CBroadcastEngine::GetWindowIndex()
+{
+   return m_wiWindowIndex;
+}
+
+/**
+ * CBroadcastEngine::GetInventory()
+ */
+
+CHostInventory& CBroadcastEngine::GetInventory()
+{
+   return m_hiInventory;
+}
+
+/**
+ * CBroadcastEngine::FindWindows()
+ */
+
+int CBroadcastEngine::FindWindows( const std::string& sEntry, std::vector<WINDOWINFO>& vecWindows )
+{
+   CWindowSelection selection;
+
+   SelectWindows( sEntry, selection );
+
+   return FindWindows( selection, vecWindows );
+}
+
+/**
+ * CBroadcastEngine::FindWindows()
+ *
+ * The windows of a selection made since the last enumeration, sorted
+ */
+
+int CBroadcastEngine::FindWindows( const CWindowSelection& selection, std::vector<WINDOWINFO>& vecWindows )
+{
+   m_wiWindowIndex.GetWindows( selection, vecWindows );
+
+   SortWindows( vecWindows );
+
+   return (int) vecWindows.size();
+}
+
+/**
+ * CBroadcastEngine::SelectWindows()
+ *
+ * Enumerates the terminal windows and selects those of a filter.
+ * Returns the number of windows selected.
+ */
+
+int CBroadcastEngine::SelectWindows( const std::string& sEntry, CWindowSelection& selection, bool bPins )
+{
+   m_pWindowSystem->EnumTerminalWindows( m_vecEnumerated );
+
+   m_wiWindowIndex.Update( m_vecEnumerated );
+
+   if ( bPins )
+   {
+      m_wiWindowIndex.Select( sEntry, selection );
+   }
+   else
+   {
+      m_wiWindowIndex.Evaluate( sEntry, selection );
+   }
+
+   return (int) selection.Count();
+}
+
+/**
+ * CBroadcastEngine::PinWindows()
+ *
+ * Pins the windows of a filter into, or out of, every selection
+ * (see CWindowIndex::Pin()). Returns the number of windows.
+ */
+
+int CBroadcastEngine::PinWindows( const std::string& sEntry, int iPin )
+{
+   CWindowSelection selection;
+
+   int iWindows = SelectWindows( sEntry, selection, false );
+
+   m_wiWindowIndex.Pin( selection, iPin );
+
+   return iWindows;
+}
+
+/**
+ * CBroadcastEngine::SetWindowHost()
+ *
+ * Filters match the window by host name as well as by title, and
+ * its {%VAR:name%} tokens are looked up by host name first
+ */
+
+void CBroadcastEngine::SetWindowHost( WINDOWID id, const std::string& sHost )
+{
+   m_wiWindowIndex.SetHost( id, sHost );
+}
+
+/**
+ * CBroadcastEngine::FilterWindows()
+ */
+
+void CBroadcastEngine::FilterWindows( const std::string& sEntry, std::vector<WINDOWINFO>& vecWindows )
+{
+   vecWindows.erase(
+      std::remove_if( vecWindows.begin(), vecWindows.end(), 
+         [&sEntry]( const WINDOWINFO& window ) 
+         { 
+            return !CFilterMatch::MatchFilter( window.sTitle, sEntry ); 
+         } ),
+      vecWindows.end() );
+}
+
+/**
+ * CBroadcastEngine::SortWindows()
+ */
+
+void CBroadcastEngine::SortWindows( std::vector<WINDOWINFO>& vecWindows )
+{
+   std::stable_sort( vecWindows.begin(), vecWindows.end(), Compare );
+}
+
+/**
+ * CBroadcastEngine::Compare()
+ */
+
+bool CBroadcastEngine::Compare( const WINDOWINFO& window1, const WINDOWINFO& window2 )
+{
+   return window1.sTitle < window2.sTitle;
+}
+
+/**
+ * CBroadcastEngine::Send()
+ *
+ * Types all buffers into each window in one activation. Returns the
+ * number of windows they were typed into.
+ */
+
+int CBroadcastEngine::Send( const std::vector<std::string>& vecBuffers, const std::string& sEntry, 
+                            bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults )
+{
+   CTraceSpan spanBroadcast( m_stSendTrace, "broadcast" );
+
+   CWindowSelection selection;
+
+   {
+      CTraceSpan span( m_stSendTrace, "EnumWindows" );
+
+      SelectWindows( sEntry, selection );
+   }
+
+   return SendWindows( vecBuffers, selection, bTab, bParse, pResults );
+}
+
+/**
+ * CBroadcastEngine::Send()
+ *
+ * Types all buffers into each window of a selection made since the
+ * last enumeration
+ */
+
+int CBroadcastEngine::Send( const std::vector<std::string>& vecBuffers, const CWindowSelection& selection, 
+                            bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults )
+{
+   CTraceSpan spanBroadcast( m_stSendTrace, "broadcast" );
+
+   return SendWindows( vecBuffers, selection, bTab, bParse, pResults );
+}
+
+/**
+ * CBroadcastEngine::SendWindows()
+ */
+
+int CBroadcastEngine::SendWindows( const std::vector<std::string>& vecBuffers, const CWindowSelection& selection, 
+                                   bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults )
+{
+   std::vector<std::string> vecOutputs;
+
+   bool bVariables = EscapeBuffers( vecBuffers, bParse, vecOutputs );
+
+   std::vector<WINDOWINFO> vecWindows;
+
+   {
+      CTraceSpan span( m_stSendTrace, "SortWindows" );
+
+      FindWindows( selection, vecWindows );
+   }
+
+   if ( pResults )
+   {
+      pResults->reserve( pResults->size() + vecWindows.size() );
+   }
+
+   bool bCapsLock = m_pWindowSystem->GetCapsLock();
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      BROADCASTRESULT result;
+
+      SendOutputs( vecWindows[iLoop], (int) iLoop, vecOutputs, bTab, bParse, bCapsLock, 
+         bVariables, result );
+
+      if ( pResults )
+      {
+         pResults->push_back( result );
+      }
+   }
+
+   {
+      CTraceSpan span( m_stSendTrace, "flush" );
+
+      m_pWindowSystem->Flush();
+   }
+
+   return (int) vecWindows.size();
+}
+
+/**
+ * CBroadcastEngine::SendWindow()
+ *
+ * Types all buffers into one window, as the window at iIndex of a
+ * broadcast. Returns true if it was in the foreground.
+ */
+
+bool CBroadcastEngine::SendWindow( const WINDOWINFO& window, int iIndex, 
+                                   const std::vector<std::string>& vecBuffers, 
+                                   bool bTab, bool bParse, BROADCASTRESULT* pResult )
+{
+   std::vector<std::string> vecOutputs;
+
+   bool bVariables = EscapeBuffers( vecBuffers, bParse, vecOutputs );
+
+   BROADCASTRESULT result;
+
+   SendOutputs( window, iIndex, vecOutputs, bTab, bParse, 
+      m_pWindowSystem->GetCapsLock(), bVariables, result );
+
+   {
+      CTraceSpan span( m_stSendTrace, "flush" );
+
+      m_pWindowSystem->Flush();
+   }
+
+   if ( pResult )
+   {
+      *pResult = result;
+   }
+
+   return result.bForeground;
+}
+
+/**
+ * CBroadcastEngine::EscapeBuffers()
+ *
+ * Escapes the buffers once for all windows. Returns true if they
+ * hold {%VAR:name%} tokens, the inventory is then brought up to
+ * date.
+ */
+
+bool CBroadcastEngine::EscapeBuffers( const std::vector<std::string>& vecBuffers, bool bParse, 
+                                      std::vector<std::string>& vecOutputs )
+{
+   bool bVariables = false;
+
+   vecOutputs.clear();
+   vecOutputs.reserve( vecBuffers.size() );
+
+   for ( size_t iBuffer = 0; iBuffer < vecBuffers.size(); iBuffer++ )
+   {
+      vecOutputs.push_back( CSendTemplate::Escape(vecBuffers[iBuffer], bParse) );
+
+      bVariables = bVariables || CSendTemplate::HasVariables( vecOutputs.back() );
+   }
+
+   if ( bVariables )
+   {
+      CTraceSpan span( m_stSendTrace, "inventory" );
+
+      m_hiInventory.Refresh();
+   }
+
+   return bVariables;
+}
+
+/**
+ * CBroadcastEngine::SendOutputs()
+ *
+ * Types escaped buffers into the window at iIndex
+ */
+
+void CBroadcastEngine::SendOutputs( const WINDOWINFO& window, int iIndex, 
+                                    const std::vector<std::string>& vecOutputs, 
+                                    bool bTab, bool bParse, bool bCapsLock, bool bVariables,
+                                    BROADCASTRESULT& result )
+{
+   int iRow = -1;
+
+   if ( bVariables )
+   {
+      const std::string& sHost = m_wiWindowIndex.GetHost( window.id );
+
+      iRow = sHost.empty() ? -1 : m_hiInventory.Find( sHost );
+
+      if ( iRow < 0 )
+      {
+         iRow = m_hiInventory.Find( window.sTitle );
+      }
+   }
+
+   std::string sKeys;
+
+   for ( size_t iBuffer = 0; iBuffer < vecOutputs.size(); iBuffer++ )
+   {
+      sKeys += CSendTemplate::Expand( vecOutputs[iBuffer], iIndex, 
+         bTab, bParse, m_iSendCR != 0, bCapsLock, &m_hiInventory, iRow );
+   }
+
+   const void* pKey = (const void*) (uintptr_t) window.id;
+
+   result.id = window.id;
+   result.sTitle = window.sTitle;
+
+   m_stSendTrace.SetWindowLabel( window.id, window.sTitle );
+
+   CTraceSpan spanWindow( m_stSendTrace, "window", window.id );
+
+   {
+      CTraceSpan span( m_stSendTrace, "activate", window.id );
+
+      result.dActivateMs = m_pWindowSystem->Activate( window.id );
+   }
+
+   /**
+    * Wait for each window by its own measured
+    * responsiveness rather than the global delays
+    */
+
+   int iOutcome = WAITOUTCOME_FIXED;
+
+   {
+      CTraceSpan span( m_stSendTrace, "transition wait", window.id );
+
+      result.dTransitionMs = m_pWindowSystem->WaitForForeground( window.id,
+         m_dtDelayTuner.GetDelay( pKey, CDelayTuner::DELAY_TRANSITION, m_iTransition ),
+         &iOutcome );
+   }
+
+   AddSample( pKey, CDelayTuner::DELAY_TRANSITION, iOutcome, result.dTransitionMs );
+
+   result.bForeground = m_pWindowSystem->IsForeground( window.id );
+
+   {
+      CTraceSpan span( m_stSendTrace, "SendKeys", window.id );
+
+      result.dSendMs = m_pWindowSystem->SendKeys( window.id, sKeys );
+   }
+
+   {
+      CTraceSpan span( m_stSendTrace, "post send wait", window.id );
+
+      result.dPostSendMs = m_pWindowSystem->WaitForInputIdle( window.id,
+         m_dtDelayTuner.GetDelay( pKey, CDelayTuner::DELAY_POST_SEND, m_iPostSendDelay ),
+         &iOutcome );
+   }
+
+   AddSample( pKey, CDelayTuner::DELAY_POST_SEND, iOutcome, result.dPostSendMs );
+
+   result.dTotalMs = result.dActivateMs + result.dTransitionMs + 
+      result.dSendMs + result.dPostSendMs;
+
+   m_stSendTrace.AddWindowLatency( window.id, (long long) (result.dTotalMs * 1000.0) );
+}
+
+/**
+ * CBroadcastEngine::AddSample()
+ *
+ * A met wait is a sample of the window. A timed out one only bounds
+ * it from below, but must still count, or a window that got slower
+ * than the timeout would never raise its delay. A fixed delay says
+ * nothing about the window.
+ */
+
+void CBroadcastEngine::AddSample( const void* pKey, int iDelay, int iOutcome, double dMs )
+{
+   if ( iOutcome == WAITOUTCOME_MET )
+   {
+      m_dtDelayTuner.AddSample( pKey, iDelay, dMs );
+   }
+   else if ( iOutcome == WAITOUTCOME_TIMEOUT )
+   {
+      m_dtDelayTuner.AddTimeout( pKey, iDelay, dMs );
+   }
+}
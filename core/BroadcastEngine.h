@@ -0,0 +1,147 @@
+/**
+ * BroadcastEngine.h - PuTTYCS portable broadcast engine
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(BROADCASTENGINE_H__INCLUDED_)
+#define BROADCASTENGINE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+#include "DelayTuner.h"
+#include "HostInventory.h"
+#include "SendTrace.h"
+#include "WindowSelection.h"
+#include "WindowSystem.h"
+
+/**
+ * Outcome of sending to one window. The total is the sum of the
+ * steps as reported by the window system.
+ */
+
+struct BROADCASTRESULT
+{
+   WINDOWID id;
+   std::string sTitle;
+
+   bool bForeground;
+
+   double dActivateMs;
+   double dTransitionMs;
+   double dSendMs;
+   double dPostSendMs;
+   double dTotalMs;
+};
+
+/**
+ * CBroadcastEngine
+ *
+ * Finds the terminal windows matching a filter and types buffers
+ * into each of them through a CWindowSystem, waiting for each window
+ * by its own measured responsiveness. Filters are evaluated into
+ * selections of a CWindowIndex, which also holds the pins. The
+ * {%VAR:name%} tokens are filled in from a CHostInventory file,
+ * read again when it changes. Strings are UTF-8.
+ */
+
+class CBroadcastEngine
+{
+public:
+
+   CBroadcastEngine( CWindowSystem* pWindowSystem );
+   virtual ~CBroadcastEngine();
+
+   void SetTransition( int iTransition );
+   void SetPostSendDelay( int iPostSendDelay );
+   void SetSendCR( int iSendCR );
+   void SetFilters( const std::vector<std::string>& vecFilters );
+   void SetInventory( const std::string& sPath );
+
+   CWindowSystem* GetWindowSystem();
+   CDelayTuner& GetDelayTuner();
+   CSendTrace& GetSendTrace();
+   CWindowIndex& GetWindowIndex();
+   CHostInventory& GetInventory();
+
+   int Send( const std::vector<std::string>& vecBuffers, const std::string& sEntry, 
+             bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults = NULL );
+
+   int Send( const std::vector<std::string>& vecBuffers, const CWindowSelection& selection, 
+             bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults = NULL );
+
+   bool SendWindow( const WINDOWINFO& window, int iIndex, const std::vector<std::string>& vecBuffers,
+                    bool bTab, bool bParse, BROADCASTRESULT* pResult = NULL );
+
+   int FindWindows( const std::string& sEntry, std::vector<WINDOWINFO>& vecWindows );
+   int FindWindows( const CWindowSelection& selection, std::vector<WINDOWINFO>& vecWindows );
+
+   int SelectWindows( const std::string& sEntry, CWindowSelection& selection, bool bPins = true );
+   int PinWindows( const std::string& sEntry, int iPin );
+
+   void SetWindowHost( WINDOWID id, const std::string& sHost );
+
+   static void FilterWindows( const std::string& sEntry, std::vector<WINDOWINFO>& vecWindows );
+   static void SortWindows( std::vector<WINDOWINFO>& vecWindows );
+
+protected:
+
+   int SendWindows( const std::vector<std::string>& vecBuffers, const CWindowSelection& selection, 
+                    bool bTab, bool bParse, std::vector<BROADCASTRESULT>* pResults );
+
+   bool EscapeBuffers( const std::vector<std::string>& vecBuffers, bool bParse, 
+                       std::vector<std::string>& vecOutputs );
+
+   void SendOutputs( const WINDOWINFO& window, int iIndex, const std::vector<std::string>& vecOutputs,
+                     bool bTab, bool bParse, bool bCapsLock, bool bVariables, BROADCASTRESULT& result );
+
+   void AddSample( const void* pKey, int iDelay, int iOutcome, double dMs );
+
+   static bool Compare( const WINDOWINFO& window1, const WINDOWINFO& window2 );
+
+   CWindowSystem* m_pWindowSystem;
+
+   CDelayTuner m_dtDelayTuner;
+   CSendTrace m_stSendTrace;
+   CWindowIndex m_wiWindowIndex;
+   CHostInventory m_hiInventory;
+
+   std::vector<WINDOWINFO> m_vecEnumerated;   // reused by SelectWindows()
+
+   int m_iTransition;
+   int m_iPostSendDelay;
+   int m_iSendCR;
+};
+
+#endif // !defined(BROADCASTENGINE_H__INCLUDED_)
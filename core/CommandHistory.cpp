@@ -0,0 +1,167 @@
+/**
+ * CommandHistory.cpp - PuTTYCS command history
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "CommandHistory.h"
+
+#include <ctype.h>
+
+/**
+ * CCommandHistory::CCommandHistory()
+ */
+
+CCommandHistory::CCommandHistory( size_t iMaxSize )
+{
+   m_iMaxSize = iMaxSize;
+   m_iPosition = 0;
+}
+
+/**
+ * CCommandHistory::Add()
+ *
+ * Blank commands are sent but not remembered
+ */
+
+void CCommandHistory::Add( const std::string& sCommand )
+{
+   bool bBlank = true;
+
+   for ( size_t iLoop = 0; bBlank && (iLoop < sCommand.size()); iLoop++ )
+   {
+      bBlank = isspace( (unsigned char) sCommand[iLoop] ) != 0;
+   }
+
+   if ( !bBlank )
+   {
+      if ( m_vecCommands.size() >= m_iMaxSize )
+      {
+         m_vecCommands.erase( m_vecCommands.begin() );
+      }
+
+      m_vecCommands.push_back( sCommand );
+   }
+
+   ResetPosition();
+}
+
+/**
+ * CCommandHistory::Clear()
+ */
+
+void CCommandHistory::Clear()
+{
+   m_vecCommands.clear();
+   m_iPosition = 0;
+}
+
+/**
+ * CCommandHistory::GetSize()
+ */
+
+size_t CCommandHistory::GetSize() const
+{
+   return m_vecCommands.size();
+}
+
+/**
+ * CCommandHistory::GetAt()
+ */
+
+const std::string& CCommandHistory::GetAt( size_t iIndex ) const
+{
+   return m_vecCommands[iIndex];
+}
+
+/**
+ * CCommandHistory::Find()
+ *
+ * Index of the most recent command containing sText, -1 if none
+ */
+
+int CCommandHistory::Find( const std::string& sText ) const
+{
+   for ( size_t iLoop = m_vecCommands.size(); iLoop > 0; iLoop-- )
+   {
+      if ( m_vecCommands[iLoop - 1].find(sText) != std::string::npos )
+      {
+         return (int) (iLoop - 1);
+      }
+   }
+
+   return -1;
+}
+
+/**
+ * CCommandHistory::Previous()
+ */
+
+bool CCommandHistory::Previous( std::string& sCommand )
+{
+   if ( m_vecCommands.empty() )
+   {
+      return false;
+   }
+
+   m_iPosition = (m_iPosition == 0) ? m_vecCommands.size() - 1 : m_iPosition - 1;
+
+   sCommand = m_vecCommands[m_iPosition];
+
+   return true;
+}
+
+/**
+ * CCommandHistory::Next()
+ */
+
+bool CCommandHistory::Next( std::string& sCommand )
+{
+   if ( m_vecCommands.empty() )
+   {
+      return false;
+   }
+
+   m_iPosition = (m_iPosition + 1 >= m_vecCommands.size()) ? 0 : m_iPosition + 1;
+
+   sCommand = m_vecCommands[m_iPosition];
+
+   return true;
+}
+
+/**
+ * CCommandHistory::ResetPosition()
+ *
+ * Past the newest command, so Previous() returns the newest
+ */
+
+void CCommandHistory::ResetPosition()
+{
+   m_iPosition = m_vecCommands.size();
+}
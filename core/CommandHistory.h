@@ -0,0 +1,78 @@
+/**
+ * CommandHistory.h - PuTTYCS command history
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(COMMANDHISTORY_H__INCLUDED_)
+#define COMMANDHISTORY_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+/**
+ * CCommandHistory
+ *
+ * Sent commands, oldest first, capped at a maximum size. Previous()
+ * and Next() walk the history with wrap around, like the history up
+ * and down buttons.
+ */
+
+class CCommandHistory
+{
+public:
+
+   CCommandHistory( size_t iMaxSize = 100 );
+
+   void Add( const std::string& sCommand );
+   void Clear();
+
+   size_t GetSize() const;
+   const std::string& GetAt( size_t iIndex ) const;
+
+   int Find( const std::string& sText ) const;
+
+   bool Previous( std::string& sCommand );
+   bool Next( std::string& sCommand );
+
+   void ResetPosition();
+
+protected:
+
+   size_t m_iMaxSize;
+   size_t m_iPosition;
+
+   std::vector<std::string> m_vecCommands;
+};
+
+#endif // !defined(COMMANDHISTORY_H__INCLUDED_)
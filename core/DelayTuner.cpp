@@ -0,0 +1,291 @@
+/**
+ * DelayTuner.cpp - PuTTYCS per window delay estimator
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "DelayTuner.h"
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * Weight of a new sample. 1/4 follows a change in link latency within
+ * a handful of sends without jumping on a single outlier.
+ */
+
+static const double DELAY_TUNER_ALPHA = 0.25;
+
+/**
+ * Standard deviations of headroom added to the mean
+ */
+
+static const double DELAY_TUNER_DEVIATIONS = 3.0;
+
+/**
+ * Samples needed before the estimate replaces the global delay
+ */
+
+static const int DELAY_TUNER_WARMUP = 3;
+
+/**
+ * Upper bound on tracked windows; the map is cleared when exceeded
+ * so closed windows do not accumulate
+ */
+
+static const size_t DELAY_TUNER_MAX_WINDOWS = 1024;
+
+/**
+ * CDelayTuner::CDelayTuner()
+ */
+
+CDelayTuner::CDelayTuner()
+{
+   m_bEnabled = false;
+
+   m_iMinimum = 0;
+   m_iMaximum = 0x7FFFFFFF;
+}
+
+/**
+ * CDelayTuner::~CDelayTuner()
+ */
+
+CDelayTuner::~CDelayTuner()
+{
+}
+
+/**
+ * CDelayTuner::SetEnabled()
+ */
+
+void CDelayTuner::SetEnabled( bool bEnabled )
+{
+   m_bEnabled = bEnabled;
+}
+
+/**
+ * CDelayTuner::IsEnabled()
+ */
+
+bool CDelayTuner::IsEnabled()
+{
+   return m_bEnabled;
+}
+
+/**
+ * CDelayTuner::SetBounds()
+ */
+
+void CDelayTuner::SetBounds( int iMinimum, int iMaximum )
+{
+   m_iMinimum = (iMinimum > 0) ? iMinimum : 0;
+   m_iMaximum = (iMaximum > m_iMinimum) ? iMaximum : m_iMinimum;
+}
+
+/**
+ * CDelayTuner::Clamp()
+ */
+
+int CDelayTuner::Clamp( int iDelay )
+{
+   if ( iDelay < m_iMinimum )
+   {
+      return m_iMinimum;
+   }
+
+   if ( iDelay > m_iMaximum )
+   {
+      return m_iMaximum;
+   }
+
+   return iDelay;
+}
+
+/**
+ * CDelayTuner::GetDelay()
+ *
+ * The estimate of the window, clamped to the bounds; until it has
+ * DELAY_TUNER_WARMUP samples, iDefault as it is.
+ */
+
+int CDelayTuner::GetDelay( const void* pKey, int iDelay, int iDefault )
+{
+   if ( !m_bEnabled )
+   {
+      return iDefault;
+   }
+
+   WindowDelayMap::const_iterator it = m_mapWindows.find( pKey );
+
+   if ( it == m_mapWindows.end() )
+   {
+      return iDefault;
+   }
+
+   const DELAYESTIMATE& estimate = it->second.estimates[iDelay];
+
+   if ( estimate.iSamples < DELAY_TUNER_WARMUP )
+   {
+      return iDefault;
+   }
+
+   double dDelay = estimate.dMean +
+      DELAY_TUNER_DEVIATIONS * sqrt( estimate.dVariance );
+
+   return Clamp( (int) ceil(dDelay) );
+}
+
+/**
+ * CDelayTuner::AddSample()
+ *
+ * A wait that ended because its condition was met
+ */
+
+void CDelayTuner::AddSample( const void* pKey, int iDelay, double dMs )
+{
+   if ( !m_bEnabled )
+   {
+      return;
+   }
+
+   Update( FindEstimate(pKey, iDelay), dMs );
+}
+
+/**
+ * CDelayTuner::AddTimeout()
+ *
+ * A wait that gave up after dMs. The window took longer, so dMs is
+ * taken as a sample when it is above the mean: the next timeout is a
+ * multiple of a larger delay, and the estimate climbs until the
+ * waits are met again. Below the mean it tells nothing new.
+ */
+
+void CDelayTuner::AddTimeout( const void* pKey, int iDelay, double dMs )
+{
+   if ( !m_bEnabled )
+   {
+      return;
+   }
+
+   DELAYESTIMATE& estimate = FindEstimate( pKey, iDelay );
+
+   if ( (estimate.iSamples == 0) || (dMs > estimate.dMean) )
+   {
+      Update( estimate, dMs );
+   }
+}
+
+/**
+ * CDelayTuner::FindEstimate()
+ *
+ * The estimate to update, created empty for a new window
+ */
+
+DELAYESTIMATE& CDelayTuner::FindEstimate( const void* pKey, int iDelay )
+{
+   WindowDelayMap::iterator it = m_mapWindows.find( pKey );
+
+   if ( it == m_mapWindows.end() )
+   {
+      if ( m_mapWindows.size() >= DELAY_TUNER_MAX_WINDOWS )
+      {
+         m_mapWindows.clear();
+      }
+
+      WINDOWDELAYS delays;
+      memset( &delays, 0, sizeof(delays) );
+
+      it = m_mapWindows.insert( 
+         WindowDelayMap::value_type(pKey, delays) ).first;
+   }
+
+   return it->second.estimates[iDelay];
+}
+
+/**
+ * CDelayTuner::Update()
+ *
+ * Incremental EWMA of mean and variance (West, 1979)
+ */
+
+void CDelayTuner::Update( DELAYESTIMATE& estimate, double dMs )
+{
+   if ( estimate.iSamples == 0 )
+   {
+      estimate.dMean = dMs;
+      estimate.dVariance = 0;
+   }
+   else
+   {
+      double dDiff = dMs - estimate.dMean;
+
+      estimate.dMean += DELAY_TUNER_ALPHA * dDiff;
+      estimate.dVariance = (1.0 - DELAY_TUNER_ALPHA) *
+         (estimate.dVariance + DELAY_TUNER_ALPHA * dDiff * dDiff);
+   }
+
+   estimate.iSamples++;
+}
+
+/**
+ * CDelayTuner::GetEstimate()
+ */
+
+bool CDelayTuner::GetEstimate( const void* pKey, int iDelay, DELAYESTIMATE& estimate )
+{
+   WindowDelayMap::const_iterator it = m_mapWindows.find( pKey );
+
+   if ( it == m_mapWindows.end() )
+   {
+      return false;
+   }
+
+   estimate = it->second.estimates[iDelay];
+
+   return true;
+}
+
+/**
+ * CDelayTuner::Forget()
+ */
+
+void CDelayTuner::Forget( const void* pKey )
+{
+   m_mapWindows.erase( pKey );
+}
+
+/**
+ * CDelayTuner::Reset()
+ */
+
+void CDelayTuner::Reset()
+{
+   m_mapWindows.clear();
+}
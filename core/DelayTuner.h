@@ -0,0 +1,116 @@
+/**
+ * DelayTuner.h - PuTTYCS per window delay estimator
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(DELAYTUNER_H__INCLUDED_)
+#define DELAYTUNER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <map>
+
+/**
+ * Running estimate of one delay for one window
+ */
+
+struct DELAYESTIMATE
+{
+   int iSamples;
+
+   double dMean;
+   double dVariance;
+};
+
+/**
+ * CDelayTuner
+ *
+ * Keeps an exponentially weighted mean and variance of the observed
+ * transition and post send times of every target window and suggests
+ * a delay of mean + DEVIATIONS standard deviations, clamped to user
+ * bounds. Windows without enough samples get the global delay. A
+ * wait that timed out is a censored sample: the window took at least
+ * the timeout, so the estimate can only rise.
+ */
+
+class CDelayTuner
+{
+public:
+
+   enum
+   {
+      DELAY_TRANSITION = 0,
+      DELAY_POST_SEND,
+      DELAY_COUNT
+   };
+
+   CDelayTuner();
+   virtual ~CDelayTuner();
+
+   void SetEnabled( bool bEnabled );
+   bool IsEnabled();
+
+   void SetBounds( int iMinimum, int iMaximum );
+
+   int GetDelay( const void* pKey, int iDelay, int iDefault );
+   void AddSample( const void* pKey, int iDelay, double dMs );
+   void AddTimeout( const void* pKey, int iDelay, double dMs );
+
+   bool GetEstimate( const void* pKey, int iDelay, DELAYESTIMATE& estimate );
+
+   void Forget( const void* pKey );
+   void Reset();
+
+protected:
+
+   struct WINDOWDELAYS
+   {
+      DELAYESTIMATE estimates[DELAY_COUNT];
+   };
+
+   typedef std::map<const void*, WINDOWDELAYS> WindowDelayMap;
+
+   DELAYESTIMATE& FindEstimate( const void* pKey, int iDelay );
+
+   static void Update( DELAYESTIMATE& estimate, double dMs );
+
+   int Clamp( int iDelay );
+
+   bool m_bEnabled;
+
+   int m_iMinimum;
+   int m_iMaximum;
+
+   WindowDelayMap m_mapWindows;
+};
+
+#endif // !defined(DELAYTUNER_H__INCLUDED_)
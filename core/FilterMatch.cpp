@@ -0,0 +1,332 @@
+/**
+ * FilterMatch.cpp - PuTTYCS window title filters
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "FilterMatch.h"
+#include "WildPattern.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+
+static const char FILTER_NAME_SEPARATOR[] = "||";
+static const char FILTER_INCLUDE = '+';
+static const char FILTER_EXCLUDE = '-';
+static const char FILTER_INTERSECT = '&';
+static const char FILTER_REFERENCE = '@';
+static const char FILTER_SEPARATOR = ';';
+
+/**
+ * CFilterMatch::MatchFilter()
+ *
+ * @name references to other filters are skipped here, only
+ * CWindowIndex can resolve them
+ */
+
+bool CFilterMatch::MatchFilter( const std::string& sTitle, const std::string& sEntry )
+{
+   size_t iStart = sEntry.find( FILTER_NAME_SEPARATOR );
+   size_t iListEnd = sEntry.size();
+
+   if ( iStart == std::string::npos )
+   {
+      iStart = 0;
+   }
+   else
+   {
+      iStart += strlen( FILTER_NAME_SEPARATOR );
+
+      iListEnd = std::min( iListEnd, sEntry.find(FILTER_NAME_SEPARATOR, iStart) );
+   }
+
+   bool bInclude = false;
+   bool bExclude = false;
+   bool bOutside = false;
+
+   while ( iStart <= iListEnd )
+   {
+      size_t iEnd = sEntry.find( FILTER_SEPARATOR, iStart );
+
+      if ( iEnd > iListEnd )
+      {
+         iEnd = iListEnd;
+      }
+
+      std::string sFilter = sEntry.substr( iStart, iEnd - iStart );
+
+      iStart = iEnd + 1;
+
+      Trim( sFilter );
+
+      if ( sFilter.empty() )
+      {
+         continue;
+      }
+
+      char chOperator = FILTER_INCLUDE;
+
+      if ( (sFilter[0] == FILTER_INCLUDE) || (sFilter[0] == FILTER_EXCLUDE) || 
+           (sFilter[0] == FILTER_INTERSECT) )
+      {
+         chOperator = sFilter[0];
+
+         sFilter.erase( 0, 1 );
+      }
+
+      if ( !sFilter.empty() && (sFilter[0] == FILTER_REFERENCE) )
+      {
+         continue;
+      }
+
+      if ( chOperator == FILTER_EXCLUDE )
+      {
+         bExclude = bExclude || WildCompare( sTitle.c_str(), sFilter.c_str() );
+      }
+      else if ( chOperator == FILTER_INTERSECT )
+      {
+         bOutside = bOutside || !WildCompare( sTitle.c_str(), sFilter.c_str() );
+      }
+      else
+      {
+         bInclude = bInclude || WildCompare( sTitle.c_str(), sFilter.c_str() );
+      }
+   }
+
+   return bInclude && !bExclude && !bOutside;
+}
+
+/**
+ * CFilterMatch::GetFilterItems()
+ *
+ * Splits the list of a filter into its patterns and @name
+ * references, each with the operator in front of it (+ if none)
+ */
+
+void CFilterMatch::GetFilterItems( const std::string& sEntry, std::vector<FILTERITEM>& vecItems )
+{
+   vecItems.clear();
+
+   std::string sList = GetFilterList( sEntry );
+
+   size_t iStart = 0;
+
+   while ( iStart <= sList.size() )
+   {
+      size_t iEnd = sList.find( FILTER_SEPARATOR, iStart );
+
+      if ( iEnd == std::string::npos )
+      {
+         iEnd = sList.size();
+      }
+
+      FILTERITEM item;
+      item.chOperator = FILTER_INCLUDE;
+      item.bReference = false;
+      item.sPattern = sList.substr( iStart, iEnd - iStart );
+
+      iStart = iEnd + 1;
+
+      Trim( item.sPattern );
+
+      if ( item.sPattern.empty() )
+      {
+         continue;
+      }
+
+      if ( (item.sPattern[0] == FILTER_INCLUDE) || (item.sPattern[0] == FILTER_EXCLUDE) || 
+           (item.sPattern[0] == FILTER_INTERSECT) )
+      {
+         item.chOperator = item.sPattern[0];
+         item.sPattern.erase( 0, 1 );
+      }
+
+      if ( !item.sPattern.empty() && (item.sPattern[0] == FILTER_REFERENCE) )
+      {
+         item.bReference = true;
+         item.sPattern.erase( 0, 1 );
+      }
+
+      vecItems.push_back( item );
+   }
+}
+
+/**
+ * CFilterMatch::WildCompare()
+ *
+ * The pattern is compiled again only when it changes, into the
+ * storage of the one before, so this does not allocate once warm.
+ * CWildPattern compiles a pattern once for many strings.
+ */
+
+bool CFilterMatch::WildCompare( const char* pszString, const char* pszWild )
+{
+   static thread_local CWildPattern s_wpPattern;
+
+   if ( strcmp(s_wpPattern.GetPattern().c_str(), pszWild) != 0 )
+   {
+      s_wpPattern.Compile( pszWild );
+   }
+
+   return s_wpPattern.Match( pszString );
+}
+
+/**
+ * CFilterMatch::GetFilterName()
+ */
+
+std::string CFilterMatch::GetFilterName( const std::string& sEntry )
+{
+   size_t iIndex = sEntry.find( FILTER_NAME_SEPARATOR );
+
+   return (iIndex != std::string::npos) ? sEntry.substr( 0, iIndex ) : sEntry;
+}
+
+/**
+ * CFilterMatch::GetFilterList()
+ */
+
+std::string CFilterMatch::GetFilterList( const std::string& sEntry )
+{
+   size_t iStart = sEntry.find( FILTER_NAME_SEPARATOR );
+
+   if ( iStart == std::string::npos )
+   {
+      return sEntry;
+   }
+
+   iStart += strlen( FILTER_NAME_SEPARATOR );
+
+   size_t iEnd = sEntry.find( FILTER_NAME_SEPARATOR, iStart );
+
+   return sEntry.substr( iStart, (iEnd == std::string::npos) ? std::string::npos : iEnd - iStart );
+}
+
+/**
+ * CFilterMatch::GetFilterPrompt()
+ *
+ * The prompt pattern scripts wait for, empty if the filter has none
+ */
+
+std::string CFilterMatch::GetFilterPrompt( const std::string& sEntry )
+{
+   size_t iStart = sEntry.find( FILTER_NAME_SEPARATOR );
+
+   if ( iStart == std::string::npos )
+   {
+      return std::string();
+   }
+
+   iStart = sEntry.find( FILTER_NAME_SEPARATOR, iStart + strlen(FILTER_NAME_SEPARATOR) );
+
+   return (iStart == std::string::npos) ? 
+      std::string() : sEntry.substr( iStart + strlen(FILTER_NAME_SEPARATOR) );
+}
+
+/**
+ * CFilterMatch::ResolveFilter()
+ *
+ * sName is the name of one of vecFilters, or a filter expression
+ * when it starts with +, - or &
+ */
+
+bool CFilterMatch::ResolveFilter( const std::vector<std::string>& vecFilters,
+                                  const std::string& sName, std::string& sEntry )
+{
+   if ( sName.empty() )
+   {
+      return false;
+   }
+
+   if ( (sName[0] == FILTER_INCLUDE) || (sName[0] == FILTER_EXCLUDE) || 
+        (sName[0] == FILTER_INTERSECT) )
+   {
+      sEntry = FILTER_NAME_SEPARATOR + sName;
+
+      return true;
+   }
+
+   for ( size_t iLoop = 0; iLoop < vecFilters.size(); iLoop++ )
+   {
+      if ( CompareNoCase(GetFilterName(vecFilters[iLoop]), sName) == 0 )
+      {
+         sEntry = vecFilters[iLoop];
+
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * CFilterMatch::Trim()
+ */
+
+void CFilterMatch::Trim( std::string& sValue )
+{
+   size_t iStart = 0;
+
+   while ( (iStart < sValue.size()) && isspace((unsigned char) sValue[iStart]) )
+   {
+      iStart++;
+   }
+
+   size_t iEnd = sValue.size();
+
+   while ( (iEnd > iStart) && isspace((unsigned char) sValue[iEnd - 1]) )
+   {
+      iEnd--;
+   }
+
+   sValue = sValue.substr( iStart, iEnd - iStart );
+}
+
+/**
+ * CFilterMatch::CompareNoCase()
+ */
+
+int CFilterMatch::CompareNoCase( const std::string& s1, const std::string& s2 )
+{
+   size_t iLength = (s1.size() < s2.size()) ? s1.size() : s2.size();
+
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      int iDiff = tolower( (unsigned char) s1[iLoop] ) - tolower( (unsigned char) s2[iLoop] );
+
+      if ( iDiff != 0 )
+      {
+         return iDiff;
+      }
+   }
+
+   return (int) s1.size() - (int) s2.size();
+}
@@ -0,0 +1,93 @@
+/**
+ * FilterMatch.h - PuTTYCS window title filters
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(FILTERMATCH_H__INCLUDED_)
+#define FILTERMATCH_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+/**
+ * One item of a filter list: a title pattern, or the name of another
+ * filter after @. chOperator is + (union), - (difference) or &
+ * (intersection).
+ */
+
+struct FILTERITEM
+{
+   char chOperator;
+   bool bReference;
+
+   std::string sPattern;
+};
+
+/**
+ * CFilterMatch
+ *
+ * Filters as stored in the preferences: name||+include;-exclude;...
+ * optionally followed by ||prompt, the pattern of the prompt paced
+ * scripts wait for. A title matches if it matches any include
+ * pattern, every &intersect pattern and no exclude pattern. Patterns
+ * use * (any run) and ? (any one character), are case sensitive and
+ * match in time linear in the length of the title (CWildPattern).
+ * +@name, -@name and &@name combine the windows of another filter.
+ * All strings are UTF-8.
+ */
+
+class CFilterMatch
+{
+public:
+
+   static bool MatchFilter( const std::string& sTitle, const std::string& sEntry );
+
+   static bool WildCompare( const char* pszString, const char* pszWild );
+
+   static std::string GetFilterName( const std::string& sEntry );
+   static std::string GetFilterList( const std::string& sEntry );
+   static std::string GetFilterPrompt( const std::string& sEntry );
+
+   static void GetFilterItems( const std::string& sEntry, std::vector<FILTERITEM>& vecItems );
+
+   static bool ResolveFilter( const std::vector<std::string>& vecFilters,
+                              const std::string& sName, std::string& sEntry );
+
+protected:
+
+   static void Trim( std::string& sValue );
+   static int CompareNoCase( const std::string& s1, const std::string& s2 );
+};
+
+#endif // !defined(FILTERMATCH_H__INCLUDED_)
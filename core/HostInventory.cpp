@@ -0,0 +1,782 @@
+/**
+ * HostInventory.cpp - PuTTYCS per-host variables
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "HostInventory.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "WildPattern.h"
+
+static const char INVENTORY_COMMENT = '#';
+static const char INVENTORY_QUOTE = '"';
+static const char INVENTORY_COMMA = ',';
+static const char INVENTORY_TAB = '\t';
+
+static const char INVENTORY_BOM[] = "\xEF\xBB\xBF";
+
+static const size_t INVENTORY_CHUNK_SIZE = 65536;
+
+/**
+ * Host names are ASCII, so is their case folding
+ */
+
+static inline char LowerChar( char chChar )
+{
+   return ((chChar >= 'A') && (chChar <= 'Z')) ? (char) (chChar - 'A' + 'a') : chChar;
+}
+
+/**
+ * CHostInventory::CHostInventory()
+ */
+
+CHostInventory::CHostInventory()
+{
+   m_bStamped = false;
+   m_llSize = 0;
+   m_llTime = 0;
+
+   m_iColumns = 0;
+}
+
+/**
+ * CHostInventory::~CHostInventory()
+ */
+
+CHostInventory::~CHostInventory()
+{
+}
+
+/**
+ * CHostInventory::SetPath()
+ *
+ * The file is read by the next Refresh(). An empty path turns the
+ * inventory off.
+ */
+
+void CHostInventory::SetPath( const std::string& sPath )
+{
+   if ( sPath == m_sPath )
+   {
+      return;
+   }
+
+   m_sPath = sPath;
+
+   Clear();
+}
+
+/**
+ * CHostInventory::GetPath()
+ */
+
+const std::string& CHostInventory::GetPath() const
+{
+   return m_sPath;
+}
+
+/**
+ * CHostInventory::Refresh()
+ *
+ * Reads the file again if it changed since it was last read.
+ * Returns false if there is no file to read, the inventory is then
+ * empty.
+ */
+
+bool CHostInventory::Refresh()
+{
+   long long llSize = 0;
+   long long llTime = 0;
+
+   if ( m_sPath.empty() || !GetFileStamp(m_sPath, llSize, llTime) )
+   {
+      Clear();
+      return false;
+   }
+
+   if ( m_bStamped && (llSize == m_llSize) && (llTime == m_llTime) )
+   {
+      return true;
+   }
+
+   /**
+    * Stamped before reading, a file written meanwhile
+    * is read again next time
+    */
+
+   std::string sContent;
+
+   if ( !ReadFile(m_sPath, sContent) )
+   {
+      Clear();
+      return false;
+   }
+
+   Clear();
+
+   m_sContent.swap( sContent );
+
+   Parse();
+
+   m_bStamped = true;
+   m_llSize = llSize;
+   m_llTime = llTime;
+
+   return true;
+}
+
+/**
+ * CHostInventory::Load()
+ *
+ * Parses the content of an inventory file
+ */
+
+void CHostInventory::Load( const std::string& sContent )
+{
+   Clear();
+
+   m_sContent = sContent;
+
+   Parse();
+}
+
+/**
+ * CHostInventory::Clear()
+ */
+
+void CHostInventory::Clear()
+{
+   m_mapHosts.clear();
+   m_mapLabels.clear();
+   m_vecPatterns.clear();
+   m_mapColumns.clear();
+   m_vecFields.clear();
+
+   m_iColumns = 0;
+
+   m_sContent.clear();
+
+   m_bStamped = false;
+   m_llSize = 0;
+   m_llTime = 0;
+}
+
+/**
+ * CHostInventory::Find()
+ *
+ * The row of a window title: the whole title, then each of its
+ * words and, for a word with dots, its first label as host names
+ * or as the first label of a host name, then the patterns in file
+ * order. Returns -1 if none matches.
+ */
+
+int CHostInventory::Find( const std::string& sTitle ) const
+{
+   if ( m_vecFields.empty() )
+   {
+      return -1;
+   }
+
+   int iRow = FindHost( m_mapHosts, sTitle.data(), sTitle.size() );
+
+   if ( iRow >= 0 )
+   {
+      return iRow;
+   }
+
+   if ( !m_mapHosts.empty() )
+   {
+      const char* psz = sTitle.c_str();
+
+      while ( *psz )
+      {
+         while ( *psz && IsSeparator(*psz) )
+         {
+            psz++;
+         }
+
+         const char* pszWord = psz;
+
+         while ( *psz && !IsSeparator(*psz) )
+         {
+            psz++;
+         }
+
+         size_t iLength = psz - pszWord;
+
+         if ( iLength == 0 )
+         {
+            continue;
+         }
+
+         iRow = FindHost( m_mapHosts, pszWord, iLength );
+
+         if ( iRow >= 0 )
+         {
+            return iRow;
+         }
+
+         const char* pszDot = (const char*) memchr( pszWord, '.', iLength );
+
+         if ( pszDot && (pszDot > pszWord) )
+         {
+            iRow = FindHost( m_mapHosts, pszWord, pszDot - pszWord );
+
+            if ( iRow >= 0 )
+            {
+               return iRow;
+            }
+         }
+
+         iRow = FindHost( m_mapLabels, pszWord, iLength );
+
+         if ( iRow >= 0 )
+         {
+            return iRow;
+         }
+      }
+   }
+
+   for ( size_t iLoop = 0; iLoop < m_vecPatterns.size(); iLoop++ )
+   {
+      if ( m_vecPatterns[iLoop].first.Match(sTitle.c_str()) )
+      {
+         return m_vecPatterns[iLoop].second;
+      }
+   }
+
+   return -1;
+}
+
+/**
+ * CHostInventory::GetValue()
+ *
+ * The value in the column named sName (without case) of a row
+ * returned by Find(). Returns false if there is no such column.
+ */
+
+bool CHostInventory::GetValue( int iRow, const std::string& sName, std::string& sValue ) const
+{
+   sValue.clear();
+
+   if ( (iRow < 0) || ((size_t) iRow >= GetRows()) )
+   {
+      return false;
+   }
+
+   std::string sColumn( sName );
+
+   for ( size_t iLoop = 0; iLoop < sColumn.size(); iLoop++ )
+   {
+      sColumn[iLoop] = LowerChar( sColumn[iLoop] );
+   }
+
+   std::unordered_map<std::string, size_t>::const_iterator it = m_mapColumns.find( sColumn );
+
+   if ( it == m_mapColumns.end() )
+   {
+      return false;
+   }
+
+   sValue = GetField( m_vecFields[(size_t) iRow * m_iColumns + it->second] );
+
+   return true;
+}
+
+/**
+ * CHostInventory::GetHosts()
+ *
+ * The host names in file order, without the patterns
+ */
+
+void CHostInventory::GetHosts( std::vector<std::string>& vecHosts ) const
+{
+   vecHosts.clear();
+
+   for ( size_t iRow = 0; iRow < GetRows(); iRow++ )
+   {
+      const INVENTORYFIELD& field = m_vecFields[iRow * m_iColumns];
+
+      if ( !field.bEscaped && !IsPattern(m_sContent.data() + field.iOffset, field.iLength) )
+      {
+         vecHosts.push_back( GetField(field) );
+      }
+   }
+}
+
+/**
+ * CHostInventory::GetRows()
+ */
+
+size_t CHostInventory::GetRows() const
+{
+   return m_iColumns ? (m_vecFields.size() / m_iColumns) : 0;
+}
+
+/**
+ * CHostInventory::GetColumns()
+ */
+
+size_t CHostInventory::GetColumns() const
+{
+   return m_iColumns;
+}
+
+/**
+ * CHostInventory::Parse()
+ *
+ * One pass over m_sContent. The delimiter is a tab if the header
+ * line holds one, a comma otherwise. Fields may be quoted with ",
+ * a quoted field may hold delimiters, line breaks and "" for ".
+ */
+
+void CHostInventory::Parse()
+{
+   const char* pszBegin = m_sContent.data();
+   const char* pszEnd = pszBegin + m_sContent.size();
+   const char* psz = pszBegin;
+
+   if ( (m_sContent.size() >= 3) && (memcmp(psz, INVENTORY_BOM, 3) == 0) )
+   {
+      psz += 3;
+   }
+
+   // One row per line at most, rehashing would cost more than the parse
+
+   size_t iLines = std::count( psz, pszEnd, '\n' ) + 1;
+
+   m_mapHosts.reserve( iLines );
+   m_mapLabels.reserve( iLines );
+
+   const char* pszLine = NULL;
+
+   char chDelimiter = 0;
+
+   std::vector<INVENTORYFIELD> vecFields;
+
+   while ( psz < pszEnd )
+   {
+      if ( (*psz == INVENTORY_COMMENT) || (*psz == '\r') || (*psz == '\n') )
+      {
+         pszLine = (const char*) memchr( psz, '\n', pszEnd - psz );
+         psz = pszLine ? (pszLine + 1) : pszEnd;
+         continue;
+      }
+
+      if ( !chDelimiter )
+      {
+         pszLine = (const char*) memchr( psz, '\n', pszEnd - psz );
+
+         chDelimiter = memchr( psz, INVENTORY_TAB, (pszLine ? pszLine : pszEnd) - psz ) ? 
+            INVENTORY_TAB : INVENTORY_COMMA;
+      }
+
+      vecFields.clear();
+
+      bool bLineEnd = false;
+
+      while ( !bLineEnd )
+      {
+         while ( (psz < pszEnd) && (*psz == ' ') )
+         {
+            psz++;
+         }
+
+         INVENTORYFIELD field;
+         field.bEscaped = false;
+
+         if ( (psz < pszEnd) && (*psz == INVENTORY_QUOTE) )
+         {
+            const char* pszField = ++psz;
+
+            while ( psz < pszEnd )
+            {
+               if ( *psz == INVENTORY_QUOTE )
+               {
+                  if ( ((psz + 1) < pszEnd) && (psz[1] == INVENTORY_QUOTE) )
+                  {
+                     field.bEscaped = true;
+                     psz += 2;
+                     continue;
+                  }
+
+                  break;
+               }
+
+               psz++;
+            }
+
+            field.iOffset = pszField - pszBegin;
+            field.iLength = psz - pszField;
+
+            // Anything between the closing quote and the delimiter is dropped
+
+            while ( (psz < pszEnd) && (*psz != chDelimiter) && (*psz != '\n') )
+            {
+               psz++;
+            }
+         }
+         else
+         {
+            const char* pszField = psz;
+
+            while ( (psz < pszEnd) && (*psz != chDelimiter) && (*psz != '\n') )
+            {
+               psz++;
+            }
+
+            const char* pszFieldEnd = psz;
+
+            while ( (pszFieldEnd > pszField) && 
+                    ((pszFieldEnd[-1] == ' ') || (pszFieldEnd[-1] == '\r')) )
+            {
+               pszFieldEnd--;
+            }
+
+            field.iOffset = pszField - pszBegin;
+            field.iLength = pszFieldEnd - pszField;
+         }
+
+         vecFields.push_back( field );
+
+         if ( (psz < pszEnd) && (*psz == chDelimiter) )
+         {
+            psz++;
+         }
+         else
+         {
+            bLineEnd = true;
+
+            if ( psz < pszEnd )
+            {
+               psz++;
+            }
+         }
+      }
+
+      if ( m_iColumns == 0 )
+      {
+         m_iColumns = vecFields.size();
+
+         for ( size_t iLoop = 0; iLoop < vecFields.size(); iLoop++ )
+         {
+            std::string sColumn = GetField( vecFields[iLoop] );
+
+            for ( size_t iChar = 0; iChar < sColumn.size(); iChar++ )
+            {
+               sColumn[iChar] = LowerChar( sColumn[iChar] );
+            }
+
+            // The first of two columns with the same name wins
+
+            m_mapColumns.insert( std::make_pair(sColumn, iLoop) );
+         }
+      }
+      else
+      {
+         AddRow( vecFields );
+      }
+   }
+}
+
+/**
+ * CHostInventory::AddRow()
+ *
+ * Rows are padded or cut to the columns of the header. The first
+ * row of a host name wins.
+ */
+
+void CHostInventory::AddRow( const std::vector<INVENTORYFIELD>& vecFields )
+{
+   const INVENTORYFIELD& fieldKey = vecFields[0];
+
+   if ( fieldKey.iLength == 0 )
+   {
+      return;
+   }
+
+   int iRow = (int) GetRows();
+
+   const char* pszKey = m_sContent.data() + fieldKey.iOffset;
+
+   if ( fieldKey.bEscaped || IsPattern(pszKey, fieldKey.iLength) )
+   {
+      m_vecPatterns.push_back( std::make_pair(CWildPattern(GetField(fieldKey).c_str()), iRow) );
+   }
+   else
+   {
+      INVENTORYKEY key;
+      key.psz = pszKey;
+      key.iLength = fieldKey.iLength;
+
+      m_mapHosts.insert( std::make_pair(key, iRow) );
+
+      const char* pszDot = (const char*) memchr( pszKey, '.', fieldKey.iLength );
+
+      if ( pszDot && (pszDot > pszKey) )
+      {
+         key.iLength = pszDot - pszKey;
+
+         m_mapLabels.insert( std::make_pair(key, iRow) );
+      }
+   }
+
+   for ( size_t iLoop = 0; iLoop < m_iColumns; iLoop++ )
+   {
+      if ( iLoop < vecFields.size() )
+      {
+         m_vecFields.push_back( vecFields[iLoop] );
+      }
+      else
+      {
+         INVENTORYFIELD field;
+         field.iOffset = 0;
+         field.iLength = 0;
+         field.bEscaped = false;
+
+         m_vecFields.push_back( field );
+      }
+   }
+}
+
+/**
+ * CHostInventory::FindHost()
+ */
+
+int CHostInventory::FindHost( const HostMap& mapHosts, const char* psz, size_t iLength ) const
+{
+   INVENTORYKEY key;
+   key.psz = psz;
+   key.iLength = iLength;
+
+   HostMap::const_iterator it = mapHosts.find( key );
+
+   return (it != mapHosts.end()) ? it->second : -1;
+}
+
+/**
+ * CHostInventory::GetField()
+ */
+
+std::string CHostInventory::GetField( const INVENTORYFIELD& field ) const
+{
+   const char* psz = m_sContent.data() + field.iOffset;
+
+   if ( !field.bEscaped )
+   {
+      return std::string( psz, field.iLength );
+   }
+
+   std::string sField;
+   sField.reserve( field.iLength );
+
+   for ( size_t iLoop = 0; iLoop < field.iLength; iLoop++ )
+   {
+      sField += psz[iLoop];
+
+      if ( (psz[iLoop] == INVENTORY_QUOTE) && ((iLoop + 1) < field.iLength) && 
+           (psz[iLoop + 1] == INVENTORY_QUOTE) )
+      {
+         iLoop++;
+      }
+   }
+
+   return sField;
+}
+
+/**
+ * CHostInventory::ReadFile()
+ */
+
+bool CHostInventory::ReadFile( const std::string& sPath, std::string& sContent )
+{
+#if defined(_WIN32)
+   // Paths are UTF-8, fopen() would take them as the ANSI code page
+
+   int iLength = ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, NULL, 0 );
+
+   std::wstring sWidePath( iLength > 0 ? iLength : 1, L'\0' );
+   ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, &sWidePath[0], iLength );
+
+   FILE* pFile = _wfopen( sWidePath.c_str(), L"rb" );
+#else
+   FILE* pFile = fopen( sPath.c_str(), "rb" );
+#endif
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   sContent.clear();
+
+   char szBuffer[INVENTORY_CHUNK_SIZE];
+   size_t iRead;
+
+   while ( (iRead = fread(szBuffer, 1, sizeof(szBuffer), pFile)) > 0 )
+   {
+      sContent.append( szBuffer, iRead );
+   }
+
+   bool bRead = !ferror( pFile );
+
+   fclose( pFile );
+
+   return bRead;
+}
+
+/**
+ * CHostInventory::GetFileStamp()
+ *
+ * The size and modification time of a file, to tell when it changed
+ */
+
+bool CHostInventory::GetFileStamp( const std::string& sPath, long long& llSize, long long& llTime )
+{
+#if defined(_WIN32)
+   int iLength = ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, NULL, 0 );
+
+   std::wstring sWidePath( iLength > 0 ? iLength : 1, L'\0' );
+   ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, &sWidePath[0], iLength );
+
+   WIN32_FILE_ATTRIBUTE_DATA fad;
+
+   if ( !::GetFileAttributesExW(sWidePath.c_str(), GetFileExInfoStandard, &fad) )
+   {
+      return false;
+   }
+
+   llSize = ((long long) fad.nFileSizeHigh << 32) | fad.nFileSizeLow;
+   llTime = ((long long) fad.ftLastWriteTime.dwHighDateTime << 32) | fad.ftLastWriteTime.dwLowDateTime;
+#else
+   struct stat st;
+
+   if ( stat(sPath.c_str(), &st) != 0 )
+   {
+      return false;
+   }
+
+   llSize = (long long) st.st_size;
+   llTime = (long long) st.st_mtime * 1000000000LL;
+
+#if defined(__linux__)
+   llTime += st.st_mtim.tv_nsec;
+#endif
+#endif
+
+   return true;
+}
+
+/**
+ * CHostInventory::IsPattern()
+ */
+
+bool CHostInventory::IsPattern( const char* psz, size_t iLength )
+{
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      if ( (psz[iLoop] == '*') || (psz[iLoop] == '?') )
+      {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * CHostInventory::IsSeparator()
+ *
+ * Characters around the host name in usual PuTTY titles, such as
+ * user@host: ~ and host - PuTTY
+ */
+
+bool CHostInventory::IsSeparator( char chChar )
+{
+   switch ( chChar )
+   {
+   case ' ': case '\t': case '@': case ':': case '[': case ']': 
+   case '(': case ')': case ',': case ';': case '/': case '"': case '\'':
+      return true;
+   }
+
+   return false;
+}
+
+/**
+ * CHostInventory::INVENTORYKEYHASH::operator()
+ *
+ * FNV-1a of the lower case key
+ */
+
+size_t CHostInventory::INVENTORYKEYHASH::operator()( const INVENTORYKEY& key ) const
+{
+   unsigned long long ullHash = 14695981039346656037ULL;
+
+   for ( size_t iLoop = 0; iLoop < key.iLength; iLoop++ )
+   {
+      ullHash ^= (unsigned char) LowerChar( key.psz[iLoop] );
+      ullHash *= 1099511628211ULL;
+   }
+
+   return (size_t) ullHash;
+}
+
+/**
+ * CHostInventory::INVENTORYKEYEQUAL::operator()
+ */
+
+bool CHostInventory::INVENTORYKEYEQUAL::operator()( const INVENTORYKEY& key1, const INVENTORYKEY& key2 ) const
+{
+   if ( key1.iLength != key2.iLength )
+   {
+      return false;
+   }
+
+   for ( size_t iLoop = 0; iLoop < key1.iLength; iLoop++ )
+   {
+      if ( LowerChar(key1.psz[iLoop]) != LowerChar(key2.psz[iLoop]) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
@@ -0,0 +1,157 @@
+/**
+ * HostInventory.h - PuTTYCS per-host variables
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(HOSTINVENTORY_H__INCLUDED_)
+#define HOSTINVENTORY_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "WildPattern.h"
+
+/**
+ * CHostInventory
+ *
+ * The per-host variables of the {%VAR:name%} token, from a CSV or
+ * TSV file. The first line names the columns; the first column of
+ * every other line is a host name, a whole window title, or a
+ * pattern with * and ? matched against the title. Lines starting
+ * with # are comments.
+ *
+ * The file is read into one buffer and parsed in place: fields are
+ * offsets into the buffer and the host names are hashed where they
+ * lie, so Find() costs a few hash lookups per window whatever the
+ * size of the inventory. Patterns are only tried for titles no host
+ * name matched. A host name with dots also stands for its first
+ * label, after the host names themselves. Refresh() reads the file
+ * again only when its size or modification time changed. Strings
+ * are UTF-8.
+ */
+
+class CHostInventory
+{
+public:
+
+   CHostInventory();
+   virtual ~CHostInventory();
+
+   void SetPath( const std::string& sPath );
+   const std::string& GetPath() const;
+
+   bool Refresh();
+   void Load( const std::string& sContent );
+   void Clear();
+
+   int Find( const std::string& sTitle ) const;
+   bool GetValue( int iRow, const std::string& sName, std::string& sValue ) const;
+   void GetHosts( std::vector<std::string>& vecHosts ) const;
+
+   size_t GetRows() const;
+   size_t GetColumns() const;
+
+protected:
+
+   /**
+    * A field of the buffer. Quoted fields holding "" are unescaped
+    * when their value is asked for.
+    */
+
+   struct INVENTORYFIELD
+   {
+      size_t iOffset;
+      size_t iLength;
+      bool bEscaped;
+   };
+
+   /**
+    * A host name as it lies in the buffer, compared without case
+    */
+
+   struct INVENTORYKEY
+   {
+      const char* psz;
+      size_t iLength;
+   };
+
+   struct INVENTORYKEYHASH
+   {
+      size_t operator()( const INVENTORYKEY& key ) const;
+   };
+
+   struct INVENTORYKEYEQUAL
+   {
+      bool operator()( const INVENTORYKEY& key1, const INVENTORYKEY& key2 ) const;
+   };
+
+   typedef std::unordered_map<INVENTORYKEY, int, INVENTORYKEYHASH, INVENTORYKEYEQUAL> HostMap;
+
+   // The host keys point into m_sContent
+
+   CHostInventory( const CHostInventory& ) = delete;
+   CHostInventory& operator=( const CHostInventory& ) = delete;
+
+   void Parse();
+   void AddRow( const std::vector<INVENTORYFIELD>& vecFields );
+
+   int FindHost( const HostMap& mapHosts, const char* psz, size_t iLength ) const;
+   std::string GetField( const INVENTORYFIELD& field ) const;
+
+   static bool ReadFile( const std::string& sPath, std::string& sContent );
+   static bool GetFileStamp( const std::string& sPath, long long& llSize, long long& llTime );
+   static bool IsPattern( const char* psz, size_t iLength );
+   static bool IsSeparator( char chChar );
+
+   std::string m_sPath;
+   std::string m_sContent;
+
+   bool m_bStamped;
+   long long m_llSize;
+   long long m_llTime;
+
+   size_t m_iColumns;
+
+   std::vector<INVENTORYFIELD> m_vecFields;
+   std::unordered_map<std::string, size_t> m_mapColumns;
+
+   HostMap m_mapHosts;
+   HostMap m_mapLabels;
+   std::vector<std::pair<CWildPattern, int> > m_vecPatterns;
+};
+
+#endif // !defined(HOSTINVENTORY_H__INCLUDED_)
@@ -0,0 +1,641 @@
+/**
+ * KeyProgram.cpp - PuTTYCS SendKeys compiler
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "KeyProgram.h"
+
+/**
+ * Key names of CSendKeys, sorted for the binary search
+ */
+
+struct KEYNAME
+{
+   const char* pszName;
+   unsigned char ucVKey;
+   bool bNormalKey;
+};
+
+static const KEYNAME g_aKeyNames[] =
+{
+   { "ADD", 0x6B, false },
+   { "APPS", 0x5D, false },
+   { "AT", '@', true },
+   { "BACKSPACE", 0x08, false },
+   { "BKSP", 0x08, false },
+   { "BREAK", 0x03, false },
+   { "BS", 0x08, false },
+   { "CAPSLOCK", 0x14, false },
+   { "CARET", '^', true },
+   { "CLEAR", 0x0C, false },
+   { "DECIMAL", 0x6E, false },
+   { "DEL", 0x2E, false },
+   { "DELETE", 0x2E, false },
+   { "DIVIDE", 0x6F, false },
+   { "DOWN", 0x28, false },
+   { "END", 0x23, false },
+   { "ENTER", 0x0D, false },
+   { "ESC", 0x1B, false },
+   { "ESCAPE", 0x1B, false },
+   { "F1", 0x70, false },
+   { "F10", 0x79, false },
+   { "F11", 0x7A, false },
+   { "F12", 0x7B, false },
+   { "F13", 0x7C, false },
+   { "F14", 0x7D, false },
+   { "F15", 0x7E, false },
+   { "F16", 0x7F, false },
+   { "F2", 0x71, false },
+   { "F3", 0x72, false },
+   { "F4", 0x73, false },
+   { "F5", 0x74, false },
+   { "F6", 0x75, false },
+   { "F7", 0x76, false },
+   { "F8", 0x77, false },
+   { "F9", 0x78, false },
+   { "HELP", 0x2F, false },
+   { "HOME", 0x24, false },
+   { "INS", 0x2D, false },
+   { "LEFT", 0x25, false },
+   { "LEFTBRACE", '{', true },
+   { "LEFTPAREN", '(', true },
+   { "LWIN", 0x5B, false },
+   { "MULTIPLY", 0x6A, false },
+   { "NUMLOCK", 0x90, false },
+   { "NUMPAD0", 0x60, false },
+   { "NUMPAD1", 0x61, false },
+   { "NUMPAD2", 0x62, false },
+   { "NUMPAD3", 0x63, false },
+   { "NUMPAD4", 0x64, false },
+   { "NUMPAD5", 0x65, false },
+   { "NUMPAD6", 0x66, false },
+   { "NUMPAD7", 0x67, false },
+   { "NUMPAD8", 0x68, false },
+   { "NUMPAD9", 0x69, false },
+   { "PERCENT", '%', true },
+   { "PGDN", 0x22, false },
+   { "PGUP", 0x21, false },
+   { "PLUS", '+', true },
+   { "PRTSC", 0x2A, false },
+   { "RIGHT", 0x27, false },
+   { "RIGHTBRACE", '}', true },
+   { "RIGHTPAREN", ')', true },
+   { "RWIN", 0x5C, false },
+   { "SCROLL", 0x91, false },
+   { "SEPARATOR", 0x6C, false },
+   { "SNAPSHOT", 0x2C, false },
+   { "SUBTRACT", 0x6D, false },
+   { "TAB", 0x09, false },
+   { "TILDE", '~', true },
+   { "UP", 0x26, false },
+   { "WIN", 0x5B, false }
+};
+
+/**
+ * CKeyProgram::CKeyProgram()
+ */
+
+CKeyProgram::CKeyProgram()
+{
+   Clear();
+}
+
+/**
+ * CKeyProgram::Clear()
+ */
+
+void CKeyProgram::Clear()
+{
+   m_vecOps.clear();
+
+   m_iKeystrokes = 0;
+
+   m_iError = KEYERROR_NONE;
+   m_iErrorPosition = 0;
+
+   m_bGroup = false;
+   m_bModifiers = false;
+}
+
+/**
+ * CKeyProgram::Assign()
+ *
+ * Takes over ops compiled earlier, leaving vecOps empty
+ */
+
+void CKeyProgram::Assign( std::vector<KEYOP>& vecOps, size_t iKeystrokes )
+{
+   Clear();
+
+   m_vecOps.swap( vecOps );
+
+   m_iKeystrokes = iKeystrokes;
+}
+
+/**
+ * CKeyProgram::GetOps()
+ */
+
+const std::vector<KEYOP>& CKeyProgram::GetOps() const
+{
+   return m_vecOps;
+}
+
+/**
+ * CKeyProgram::GetKeystrokes()
+ *
+ * Key presses the program makes, modifiers included
+ */
+
+size_t CKeyProgram::GetKeystrokes() const
+{
+   return m_iKeystrokes;
+}
+
+/**
+ * CKeyProgram::GetError()
+ *
+ * KEYERROR_NONE if the last Compile() parsed all of its keys
+ */
+
+int CKeyProgram::GetError() const
+{
+   return m_iError;
+}
+
+/**
+ * CKeyProgram::GetErrorPosition()
+ *
+ * Byte offset in the keys where the last Compile() stopped on error
+ */
+
+size_t CKeyProgram::GetErrorPosition() const
+{
+   return m_iErrorPosition;
+}
+
+/**
+ * CKeyProgram::LookupKeyName()
+ */
+
+int CKeyProgram::LookupKeyName( const std::string& sName, bool& bNormalKey )
+{
+   KEYSPAN<char> spName;
+   spName.pText = sName.data();
+   spName.iLength = sName.size();
+
+   return LookupKeyName( spName, bNormalKey );
+}
+
+/**
+ * CKeyProgram::LookupKeyName()
+ *
+ * Returns the virtual key (or the character if bNormalKey) of a
+ * {NAME}, -1 if unknown
+ */
+
+int CKeyProgram::LookupKeyName( const KEYSPAN<char>& spName, bool& bNormalKey )
+{
+   int iBottom = 0;
+   int iTop = (int) (sizeof(g_aKeyNames) / sizeof(g_aKeyNames[0])) - 1;
+
+   while ( iBottom <= iTop )
+   {
+      int iMiddle = (iBottom + iTop) / 2;
+
+      int iCompare = -spName.CompareNoCase( g_aKeyNames[iMiddle].pszName );
+
+      if ( iCompare == 0 )
+      {
+         bNormalKey = g_aKeyNames[iMiddle].bNormalKey;
+
+         return g_aKeyNames[iMiddle].ucVKey;
+      }
+
+      if ( iCompare < 0 )
+      {
+         iBottom = iMiddle + 1;
+      }
+      else
+      {
+         iTop = iMiddle - 1;
+      }
+   }
+
+   return -1;
+}
+
+/**
+ * CKeyProgram::AddOp()
+ */
+
+void CKeyProgram::AddOp( int iType, unsigned int uiValue, unsigned int uiCount, 
+                         unsigned int uiParam )
+{
+   KEYOP op;
+   op.iType = iType;
+   op.uiValue = uiValue;
+   op.uiCount = uiCount;
+   op.uiParam = uiParam;
+
+   m_vecOps.push_back( op );
+}
+
+/**
+ * CKeyProgram::AddKey()
+ *
+ * A key press, after which held modifiers are released unless
+ * inside a ( ) group
+ */
+
+void CKeyProgram::AddKey( int iType, unsigned int uiValue, unsigned int uiCount )
+{
+   AddOp( iType, uiValue, uiCount );
+
+   m_iKeystrokes += uiCount;
+
+   PopModifiers();
+}
+
+/**
+ * CKeyProgram::PopModifiers()
+ */
+
+void CKeyProgram::PopModifiers()
+{
+   if ( !m_bGroup && m_bModifiers )
+   {
+      AddOp( KEYOP::KEYOP_RELEASE, 0, 0 );
+
+      m_bModifiers = false;
+   }
+}
+
+/**
+ * CKeyProgram::DecodeChar()
+ *
+ * Next UTF-8 character, invalid bytes are taken as Latin-1
+ */
+
+unsigned int CKeyProgram::DecodeChar( const KEYSPAN<char>& spText, size_t& iPos )
+{
+   unsigned char ucLead = (unsigned char) spText.pText[iPos++];
+
+   int iExtra = (ucLead >= 0xF0) ? 3 : (ucLead >= 0xE0) ? 2 : (ucLead >= 0xC0) ? 1 : 0;
+
+   if ( (iExtra == 0) || (iPos + iExtra > spText.iLength) )
+   {
+      return ucLead;
+   }
+
+   unsigned int uiChar = ucLead & (0x3F >> iExtra);
+
+   for ( int iLoop = 0; iLoop < iExtra; iLoop++ )
+   {
+      unsigned char ucNext = (unsigned char) spText.pText[iPos + iLoop];
+
+      if ( (ucNext & 0xC0) != 0x80 )
+      {
+         return ucLead;
+      }
+
+      uiChar = (uiChar << 6) | (ucNext & 0x3F);
+   }
+
+   iPos += iExtra;
+
+   return uiChar;
+}
+
+/**
+ * CKeyProgram::Compile()
+ */
+
+bool CKeyProgram::Compile( const std::string& sKeys )
+{
+   Clear();
+
+   CKeyTokenizer<char> ktTokens( sKeys.data(), sKeys.size() );
+
+   KEYTOKEN<char> token;
+
+   while ( ktTokens.Next(token) )
+   {
+      switch ( token.iType )
+      {
+      case KEYTOKEN_GROUP_BEGIN:
+         m_bGroup = true;
+         break;
+
+      case KEYTOKEN_GROUP_END:
+         m_bGroup = false;
+         PopModifiers();
+         break;
+
+      case KEYTOKEN_MODIFIER:
+         {
+            char ch = token.spText.pText[0];
+
+            AddOp( KEYOP::KEYOP_MODIFIER, 
+               (ch == '%') ? VK_MENU : (ch == '+') ? VK_SHIFT : (ch == '^') ? VK_CONTROL : VK_LWIN );
+
+            m_iKeystrokes++;
+            m_bModifiers = true;
+         }
+         break;
+
+      case KEYTOKEN_ENTER:
+         AddKey( KEYOP::KEYOP_VKEY, VK_RETURN, 1 );
+         break;
+
+      case KEYTOKEN_SPECIAL:
+         CompileSpecial( token.spText );
+         break;
+
+      default:
+         CompileText( token.spText );
+         break;
+      }
+   }
+
+   m_bGroup = false;
+   PopModifiers();
+
+   m_iError = ktTokens.GetError();
+
+   if ( m_iError != KEYERROR_NONE )
+   {
+      m_iErrorPosition = ktTokens.GetPosition();
+
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * CKeyProgram::CompileText()
+ *
+ * A key for each character
+ */
+
+void CKeyProgram::CompileText( const KEYSPAN<char>& spText )
+{
+   size_t iPos = 0;
+
+   while ( iPos < spText.iLength )
+   {
+      AddKey( KEYOP::KEYOP_CHAR, DecodeChar(spText, iPos), 1 );
+   }
+}
+
+/**
+ * CKeyProgram::CompileSpecial()
+ *
+ * The text between { and }
+ */
+
+void CKeyProgram::CompileSpecial( const KEYSPAN<char>& spKeyString )
+{
+   if ( spKeyString.StartsWithNoCase("VKEY") )
+   {
+      AddKey( KEYOP::KEYOP_VKEY, spKeyString.ToNumber(4), 1 );
+   }
+   else if ( spKeyString.StartsWithNoCase("BEEP") )
+   {
+      size_t iSpace = spKeyString.Find( ' ', 5 );
+
+      if ( iSpace != KEYSPAN<char>::npos )
+      {
+         AddOp( KEYOP::KEYOP_BEEP, spKeyString.ToNumber(5), 1, spKeyString.ToNumber(iSpace + 1) );
+      }
+   }
+   else if ( spKeyString.StartsWithNoCase("APPACTIVATE") )
+   {
+      AddOp( KEYOP::KEYOP_APPACTIVATE, 0 );
+
+      KEYSPAN<char> spTitle = spKeyString.Mid( 12 );
+
+      m_vecOps.back().sText.assign( spTitle.pText, spTitle.iLength );
+   }
+   else if ( spKeyString.StartsWithNoCase("DELAY") )
+   {
+      if ( (spKeyString.iLength > 5) && (spKeyString.pText[5] == '=') )
+      {
+         AddOp( KEYOP::KEYOP_DELAY_ALWAYS, spKeyString.ToNumber(6) );
+      }
+      else
+      {
+         AddOp( KEYOP::KEYOP_DELAY_NOW, spKeyString.ToNumber(5) );
+      }
+   }
+   else
+   {
+      bool bNormalKey = false;
+
+      unsigned int uiCount = 1;
+
+      int iKey = LookupKeyName( spKeyString, bNormalKey );
+
+      // {NAME n} types the key n times
+
+      size_t iSpace = spKeyString.ReverseFind( ' ' );
+
+      if ( (iKey == -1) && (iSpace != KEYSPAN<char>::npos) && (iSpace > 0) )
+      {
+         iKey = LookupKeyName( spKeyString.Mid(0, iSpace), bNormalKey );
+         uiCount = spKeyString.ToNumber( iSpace + 1 );
+      }
+
+      if ( (iKey != -1) && (uiCount > 0) )
+      {
+         AddKey( bNormalKey ? KEYOP::KEYOP_CHAR : KEYOP::KEYOP_VKEY, 
+            (unsigned int) iKey, uiCount );
+      }
+   }
+}
+
+/**
+ * CKeyProgram::AppendUtf8()
+ */
+
+void CKeyProgram::AppendUtf8( std::string& sText, unsigned int uiChar )
+{
+   if ( uiChar < 0x80 )
+   {
+      sText += (char) uiChar;
+   }
+   else if ( uiChar < 0x800 )
+   {
+      sText += (char) (0xC0 | (uiChar >> 6));
+      sText += (char) (0x80 | (uiChar & 0x3F));
+   }
+   else if ( uiChar < 0x10000 )
+   {
+      sText += (char) (0xE0 | (uiChar >> 12));
+      sText += (char) (0x80 | ((uiChar >> 6) & 0x3F));
+      sText += (char) (0x80 | (uiChar & 0x3F));
+   }
+   else
+   {
+      sText += (char) (0xF0 | (uiChar >> 18));
+      sText += (char) (0x80 | ((uiChar >> 12) & 0x3F));
+      sText += (char) (0x80 | ((uiChar >> 6) & 0x3F));
+      sText += (char) (0x80 | (uiChar & 0x3F));
+   }
+}
+
+/**
+ * CKeyProgram::GetTerminalBytes()
+ *
+ * What a terminal with PuTTY's default keyboard settings sends to
+ * the host for the program: UTF-8 text, Ctrl+key as a control
+ * character, Alt+key prefixed by ESC, Backspace as DEL and the
+ * cursor and editing keys as escape sequences. Delays, beeps, Caps
+ * Lock and window activation have no bytes.
+ */
+
+std::string CKeyProgram::GetTerminalBytes() const
+{
+   std::string sBytes;
+   sBytes.reserve( m_iKeystrokes );
+
+   bool bControl = false;
+   bool bShift = false;
+   bool bAlt = false;
+
+   for ( size_t iOp = 0; iOp < m_vecOps.size(); iOp++ )
+   {
+      const KEYOP& op = m_vecOps[iOp];
+
+      if ( op.iType == KEYOP::KEYOP_MODIFIER )
+      {
+         bControl = bControl || (op.uiValue == VK_CONTROL);
+         bShift = bShift || (op.uiValue == VK_SHIFT);
+         bAlt = bAlt || (op.uiValue == VK_MENU);
+
+         continue;
+      }
+
+      if ( op.iType == KEYOP::KEYOP_RELEASE )
+      {
+         bControl = false;
+         bShift = false;
+         bAlt = false;
+
+         continue;
+      }
+
+      if ( (op.iType != KEYOP::KEYOP_CHAR) && (op.iType != KEYOP::KEYOP_VKEY) )
+      {
+         continue;
+      }
+
+      std::string sKey;
+
+      unsigned int uiChar = op.uiValue;
+
+      if ( op.iType == KEYOP::KEYOP_VKEY )
+      {
+         switch ( uiChar )
+         {
+         case VK_RETURN: sKey = "\r"; break;
+         case VK_TAB:    sKey = "\t"; break;
+         case VK_BACK:   sKey = "\x7f"; break;
+         case VK_ESCAPE: sKey = "\x1b"; break;
+         case 0x21:      sKey = "\x1b[5~"; break;      // PGUP
+         case 0x22:      sKey = "\x1b[6~"; break;      // PGDN
+         case 0x23:      sKey = "\x1b[4~"; break;      // END
+         case 0x24:      sKey = "\x1b[1~"; break;      // HOME
+         case 0x25:      sKey = "\x1b[D"; break;       // LEFT
+         case 0x26:      sKey = "\x1b[A"; break;       // UP
+         case 0x27:      sKey = "\x1b[C"; break;       // RIGHT
+         case 0x28:      sKey = "\x1b[B"; break;       // DOWN
+         case 0x2D:      sKey = "\x1b[2~"; break;      // INS
+         case 0x2E:      sKey = "\x1b[3~"; break;      // DEL
+
+         default:
+            if ( ((uiChar >= 'A') && (uiChar <= 'Z')) || ((uiChar >= '0') && (uiChar <= '9')) )
+            {
+               uiChar = ((uiChar >= 'A') && !bShift) ? uiChar + ('a' - 'A') : uiChar;
+            }
+            else if ( (uiChar >= 0x70) && (uiChar <= 0x7B) )
+            {
+               static const char* s_apszFunctionKeys[] =
+               {
+                  "11", "12", "13", "14", "15", "17", "18", "19", "20", "21", "23", "24"
+               };
+
+               sKey = std::string( "\x1b[" ) + s_apszFunctionKeys[uiChar - 0x70] + "~";
+            }
+            else
+            {
+               uiChar = 0;
+            }
+            break;
+         }
+      }
+
+      if ( sKey.empty() && (uiChar != 0) )
+      {
+         if ( bControl && (uiChar >= 0x40) && (uiChar < 0x80) )
+         {
+            uiChar &= 0x1F;
+         }
+         else if ( bControl && (uiChar == ' ') )
+         {
+            uiChar = 0;
+         }
+         else if ( bShift && (uiChar >= 'a') && (uiChar <= 'z') )
+         {
+            uiChar -= 'a' - 'A';
+         }
+
+         AppendUtf8( sKey, uiChar );
+      }
+
+      if ( sKey.empty() )
+      {
+         continue;
+      }
+
+      for ( unsigned int uiLoop = 0; uiLoop < op.uiCount; uiLoop++ )
+      {
+         if ( bAlt )
+         {
+            sBytes += '\x1b';
+         }
+
+         sBytes += sKey;
+      }
+   }
+
+   return sBytes;
+}
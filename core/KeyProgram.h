@@ -0,0 +1,142 @@
+/**
+ * KeyProgram.h - PuTTYCS SendKeys compiler
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(KEYPROGRAM_H__INCLUDED_)
+#define KEYPROGRAM_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+#include "KeyTokenizer.h"
+
+/**
+ * One step of a compiled SendKeys string. Virtual key codes use the
+ * Win32 VK_ values, so a Win32 backend can replay them directly.
+ */
+
+struct KEYOP
+{
+   enum
+   {
+      KEYOP_CHAR = 0,         // uiValue: Unicode character
+      KEYOP_VKEY,             // uiValue: virtual key (+ VkKeyScan shift state)
+      KEYOP_MODIFIER,         // uiValue: VK_SHIFT, VK_CONTROL, VK_MENU or VK_LWIN held down
+      KEYOP_RELEASE,          // release all held modifiers
+      KEYOP_DELAY_ALWAYS,     // uiValue: ms before every following key
+      KEYOP_DELAY_NOW,        // uiValue: ms before the next key
+      KEYOP_BEEP,             // uiValue: frequency, uiParam: duration
+      KEYOP_APPACTIVATE       // sText: window title
+   };
+
+   int iType;
+
+   unsigned int uiValue;
+   unsigned int uiCount;
+   unsigned int uiParam;
+
+   std::string sText;
+};
+
+/**
+ * CKeyProgram
+ *
+ * Compiles the SendKeys syntax used by CSendKeys (modifiers + ^ % @,
+ * groups ( ), ~ for Enter and {NAME}, {NAME n}, {VKEY n}, {DELAY n},
+ * {DELAY=n}, {BEEP f d}, {APPACTIVATE title}) into a flat list of
+ * KEYOPs, with the same modifier release rules as
+ * CSendKeys::SendKeys(). A { without its } stops the compile there,
+ * GetError() and GetErrorPosition() tell what and where.
+ */
+
+class CKeyProgram
+{
+public:
+
+   enum
+   {
+      VK_BACK = 0x08,
+      VK_TAB = 0x09,
+      VK_RETURN = 0x0D,
+      VK_SHIFT = 0x10,
+      VK_CONTROL = 0x11,
+      VK_MENU = 0x12,
+      VK_ESCAPE = 0x1B,
+      VK_LWIN = 0x5B
+   };
+
+   CKeyProgram();
+
+   bool Compile( const std::string& sKeys );
+   void Assign( std::vector<KEYOP>& vecOps, size_t iKeystrokes );
+   void Clear();
+
+   const std::vector<KEYOP>& GetOps() const;
+   size_t GetKeystrokes() const;
+
+   int GetError() const;
+   size_t GetErrorPosition() const;
+
+   std::string GetTerminalBytes() const;
+
+   static int LookupKeyName( const std::string& sName, bool& bNormalKey );
+   static int LookupKeyName( const KEYSPAN<char>& spName, bool& bNormalKey );
+   static void AppendUtf8( std::string& sText, unsigned int uiChar );
+
+protected:
+
+   void AddOp( int iType, unsigned int uiValue, unsigned int uiCount = 1, 
+               unsigned int uiParam = 0 );
+
+   void AddKey( int iType, unsigned int uiValue, unsigned int uiCount );
+   void PopModifiers();
+
+   void CompileText( const KEYSPAN<char>& spText );
+   void CompileSpecial( const KEYSPAN<char>& spKeyString );
+
+   static unsigned int DecodeChar( const KEYSPAN<char>& spText, size_t& iPos );
+
+   std::vector<KEYOP> m_vecOps;
+
+   size_t m_iKeystrokes;
+
+   int m_iError;
+   size_t m_iErrorPosition;
+
+   bool m_bGroup;
+   bool m_bModifiers;
+};
+
+#endif // !defined(KEYPROGRAM_H__INCLUDED_)
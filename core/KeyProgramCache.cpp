@@ -0,0 +1,971 @@
+/**
+ * KeyProgramCache.cpp - PuTTYCS compiled script cache
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "KeyProgramCache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The cache file: a header, the programs, their ops, the script's
+ * lines, then the key strings, window titles and lines the records
+ * point into. Integers are in
+ * the byte order of the machine that wrote it; the magic number does
+ * not match on another. The checksum covers everything after the
+ * header.
+ */
+
+static const unsigned int KEYCACHE_MAGIC = 0x314B4350;   // "PCK1"
+static const unsigned int KEYCACHE_VERSION = 4;        // 4: checked by the script's bytes
+
+static const size_t KEYCACHE_NONE = (size_t) -1;
+
+struct KEYCACHEHEADER
+{
+   unsigned int uiMagic;
+   unsigned int uiVersion;
+   unsigned int uiFlags;
+   unsigned int uiLines;
+   unsigned long long ullPathHash;
+   unsigned long long ullSourceHash;
+   unsigned long long ullSourceSize;
+   unsigned int uiPrograms;
+   unsigned int uiOps;
+   unsigned int uiTextBytes;
+   unsigned int uiReserved;
+   unsigned long long ullChecksum;
+};
+
+struct KEYCACHEPROGRAM
+{
+   unsigned int uiKeysOffset;
+   unsigned int uiKeysLength;
+   unsigned int uiFirstOp;
+   unsigned int uiOps;
+   unsigned int uiKeystrokes;
+};
+
+/**
+ * A KEYOP. Only KEYOP_APPACTIVATE has text and it has no value or
+ * parameter, so they hold the offset and length of its title.
+ */
+
+struct KEYCACHEOP
+{
+   unsigned int uiType;
+   unsigned int uiValue;
+   unsigned int uiCount;
+   unsigned int uiParam;
+};
+
+struct KEYCACHELINE
+{
+   unsigned int uiOffset;
+   unsigned int uiLength;
+};
+
+#if defined(_WIN32)
+
+/**
+ * Paths are UTF-8, the ANSI file functions would take them as the
+ * ANSI code page
+ */
+
+static std::wstring GetWidePath( const std::string& sPath )
+{
+   std::wstring wsPath;
+
+   int iChars = ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, NULL, 0 );
+
+   if ( iChars > 0 )
+   {
+      wsPath.resize( iChars );
+
+      ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, &wsPath[0], iChars );
+
+      wsPath.resize( iChars - 1 );
+   }
+
+   return wsPath;
+}
+
+#endif
+
+/**
+ * CKeyProgramCache::CKeyProgramCache()
+ */
+
+CKeyProgramCache::CKeyProgramCache()
+{
+   m_ullPathHash = 0;
+   m_ullSourceHash = 0;
+   m_ullSourceSize = 0;
+   m_uiFlags = 0;
+
+   m_pView = NULL;
+   m_iViewSize = 0;
+
+   m_bDirty = false;
+
+   m_iHits = 0;
+   m_iMisses = 0;
+}
+
+/**
+ * CKeyProgramCache::~CKeyProgramCache()
+ */
+
+CKeyProgramCache::~CKeyProgramCache()
+{
+   Close();
+}
+
+/**
+ * CKeyProgramCache::Hash()
+ *
+ * FNV-1a taken 8 bytes at a time, so checking a large file does not
+ * cost more than compiling it. Chained through ullHash.
+ */
+
+unsigned long long CKeyProgramCache::Hash( const void* pData, size_t iLength, 
+                                           unsigned long long ullHash )
+{
+   const unsigned char* pBytes = (const unsigned char*) pData;
+
+   size_t iLoop = 0;
+
+   for ( ; iLoop + 8 <= iLength; iLoop += 8 )
+   {
+      unsigned long long ullWord;
+      memcpy( &ullWord, pBytes + iLoop, sizeof(ullWord) );
+
+      ullHash = (ullHash ^ ullWord) * 1099511628211ULL;
+      ullHash ^= ullHash >> 32;
+   }
+
+   for ( ; iLoop < iLength; iLoop++ )
+   {
+      ullHash = (ullHash ^ pBytes[iLoop]) * 1099511628211ULL;
+   }
+
+   return ullHash;
+}
+
+/**
+ * CKeyProgramCache::HashFile()
+ *
+ * Hash() of a file's bytes, read in blocks of a multiple of 8 bytes
+ * so the chained hash is that of the whole file. Size and time can
+ * not stand in for it: a script rewritten to the same size within
+ * the time resolution of its file system (2 s on FAT), or checked
+ * out with its old time, would replay its old keys.
+ */
+
+bool CKeyProgramCache::HashFile( const std::string& sPath, unsigned long long& ullHash, 
+                                 unsigned long long& ullSize )
+{
+#if defined(_WIN32)
+   FILE* pFile = _wfopen( GetWidePath(sPath).c_str(), L"rb" );
+#else
+   FILE* pFile = fopen( sPath.c_str(), "rb" );
+#endif
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   std::vector<char> vecBlock( 64 * 1024 );
+
+   ullHash = Hash( NULL, 0 );
+   ullSize = 0;
+
+   size_t iRead = 0;
+
+   while ( (iRead = fread(vecBlock.data(), 1, vecBlock.size(), pFile)) > 0 )
+   {
+      ullHash = Hash( vecBlock.data(), iRead, ullHash );
+      ullSize += iRead;
+   }
+
+   bool bRead = !ferror( pFile );
+
+   fclose( pFile );
+
+   return bRead;
+}
+
+/**
+ * CKeyProgramCache::Open()
+ *
+ * Starts the cache of the script file sSource, sent with the FLAG_
+ * options in uiFlags. The script is read once to hash it, which
+ * costs little next to parsing it. Returns true if a file for these
+ * bytes was found, its lines then in GetLines(); without one,
+ * without a directory or when the script can not be read, the
+ * programs are compiled as they are asked for.
+ */
+
+bool CKeyProgramCache::Open( const std::string& sDirectory, const std::string& sSource, 
+                             unsigned int uiFlags )
+{
+   Close();
+
+   m_sSource = sSource;
+   m_ullPathHash = Hash( sSource.data(), sSource.size() );
+   m_uiFlags = uiFlags;
+
+   if ( sDirectory.empty() || !HashFile(sSource, m_ullSourceHash, m_ullSourceSize) )
+   {
+      return false;
+   }
+
+   unsigned long long ullKey = Hash( &uiFlags, sizeof(uiFlags), m_ullPathHash );
+
+   char szName[32];
+   snprintf( szName, sizeof(szName), "%016llx.pkc", ullKey );
+
+   m_sDirectory = sDirectory;
+
+   char chLast = sDirectory[sDirectory.size() - 1];
+
+#if defined(_WIN32)
+   m_sPath = sDirectory + (((chLast == '\\') || (chLast == '/')) ? "" : "\\") + szName;
+#else
+   m_sPath = sDirectory + ((chLast == '/') ? "" : "/") + szName;
+#endif
+
+   if ( !Map() )
+   {
+      return false;
+   }
+
+   if ( !Validate() )
+   {
+      Unmap();
+      return false;
+   }
+
+   const KEYCACHEHEADER* pHeader = (const KEYCACHEHEADER*) m_pView;
+   const KEYCACHEPROGRAM* pPrograms = (const KEYCACHEPROGRAM*) (pHeader + 1);
+   const KEYCACHEOP* pOps = (const KEYCACHEOP*) (pPrograms + pHeader->uiPrograms);
+   const KEYCACHELINE* pLines = (const KEYCACHELINE*) (pOps + pHeader->uiOps);
+   const char* pText = (const char*) m_pView + m_iViewSize - pHeader->uiTextBytes;
+
+   m_vecLines.resize( pHeader->uiLines );
+
+   for ( unsigned int uiLine = 0; uiLine < pHeader->uiLines; uiLine++ )
+   {
+      m_vecLines[uiLine].assign( pText + pLines[uiLine].uiOffset, pLines[uiLine].uiLength );
+   }
+
+   for ( unsigned int uiProgram = 0; uiProgram < pHeader->uiPrograms; uiProgram++ )
+   {
+      const KEYCACHEPROGRAM& program = pPrograms[uiProgram];
+
+      m_deqEntries.push_back( CACHEENTRY() );
+
+      CACHEENTRY& entry = m_deqEntries.back();
+      entry.iMapped = uiProgram;
+      entry.bLoaded = false;
+
+      m_mapIndex.insert( EntryIndex::value_type(
+         Hash(pText + program.uiKeysOffset, program.uiKeysLength), m_deqEntries.size() - 1) );
+   }
+
+   return true;
+}
+
+/**
+ * CKeyProgramCache::Close()
+ *
+ * Drops the programs without saving them
+ */
+
+void CKeyProgramCache::Close()
+{
+   Unmap();
+
+   m_deqEntries.clear();
+   m_mapIndex.clear();
+
+   m_vecLines.clear();
+
+   m_sDirectory.clear();
+   m_sPath.clear();
+   m_sSource.clear();
+
+   m_bDirty = false;
+
+   m_iHits = 0;
+   m_iMisses = 0;
+}
+
+/**
+ * CKeyProgramCache::Map()
+ */
+
+bool CKeyProgramCache::Map()
+{
+#if defined(_WIN32)
+   HANDLE hFile = ::CreateFileW( GetWidePath(m_sPath).c_str(), GENERIC_READ, 
+      FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+   if ( hFile == INVALID_HANDLE_VALUE )
+   {
+      return false;
+   }
+
+   LARGE_INTEGER liSize;
+
+   if ( !::GetFileSizeEx(hFile, &liSize) || (liSize.QuadPart < (LONGLONG) sizeof(KEYCACHEHEADER)) ||
+        (liSize.QuadPart > 0x7FFFFFFF) )
+   {
+      ::CloseHandle( hFile );
+      return false;
+   }
+
+   // The view keeps the mapping and the file open
+
+   HANDLE hMapping = ::CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+   ::CloseHandle( hFile );
+
+   if ( hMapping == NULL )
+   {
+      return false;
+   }
+
+   m_pView = (const unsigned char*) ::MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+   ::CloseHandle( hMapping );
+
+   if ( m_pView == NULL )
+   {
+      return false;
+   }
+
+   m_iViewSize = (size_t) liSize.QuadPart;
+#else
+   int iFd = open( m_sPath.c_str(), O_RDONLY | O_CLOEXEC );
+
+   if ( iFd < 0 )
+   {
+      return false;
+   }
+
+   struct stat st;
+
+   if ( (fstat(iFd, &st) != 0) || (st.st_size < (off_t) sizeof(KEYCACHEHEADER)) ||
+        (st.st_size > 0x7FFFFFFF) )
+   {
+      close( iFd );
+      return false;
+   }
+
+   void* pView = mmap( NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, iFd, 0 );
+
+   close( iFd );
+
+   if ( pView == MAP_FAILED )
+   {
+      return false;
+   }
+
+   m_pView = (const unsigned char*) pView;
+   m_iViewSize = (size_t) st.st_size;
+#endif
+
+   return true;
+}
+
+/**
+ * CKeyProgramCache::Unmap()
+ */
+
+void CKeyProgramCache::Unmap()
+{
+   if ( m_pView )
+   {
+#if defined(_WIN32)
+      ::UnmapViewOfFile( m_pView );
+#else
+      munmap( (void*) m_pView, m_iViewSize );
+#endif
+   }
+
+   m_pView = NULL;
+   m_iViewSize = 0;
+}
+
+/**
+ * CKeyProgramCache::Validate()
+ *
+ * The mapped file is for this script, its bytes and options, and
+ * every offset in it stays inside it
+ */
+
+bool CKeyProgramCache::Validate() const
+{
+   const KEYCACHEHEADER* pHeader = (const KEYCACHEHEADER*) m_pView;
+
+   if ( (pHeader->uiMagic != KEYCACHE_MAGIC) || (pHeader->uiVersion != KEYCACHE_VERSION) ||
+        (pHeader->uiFlags != m_uiFlags) || (pHeader->ullPathHash != m_ullPathHash) ||
+        (pHeader->ullSourceHash != m_ullSourceHash) || (pHeader->ullSourceSize != m_ullSourceSize) )
+   {
+      return false;
+   }
+
+   unsigned long long ullSize = sizeof(KEYCACHEHEADER) + 
+      (unsigned long long) pHeader->uiPrograms * sizeof(KEYCACHEPROGRAM) +
+      (unsigned long long) pHeader->uiOps * sizeof(KEYCACHEOP) + 
+      (unsigned long long) pHeader->uiLines * sizeof(KEYCACHELINE) + pHeader->uiTextBytes;
+
+   if ( ullSize != m_iViewSize )
+   {
+      return false;
+   }
+
+   if ( Hash(m_pView + sizeof(KEYCACHEHEADER), m_iViewSize - sizeof(KEYCACHEHEADER)) != 
+        pHeader->ullChecksum )
+   {
+      return false;
+   }
+
+   const KEYCACHEPROGRAM* pPrograms = (const KEYCACHEPROGRAM*) (pHeader + 1);
+   const KEYCACHEOP* pOps = (const KEYCACHEOP*) (pPrograms + pHeader->uiPrograms);
+   const KEYCACHELINE* pLines = (const KEYCACHELINE*) (pOps + pHeader->uiOps);
+
+   unsigned long long ullText = pHeader->uiTextBytes;
+
+   for ( unsigned int uiProgram = 0; uiProgram < pHeader->uiPrograms; uiProgram++ )
+   {
+      const KEYCACHEPROGRAM& program = pPrograms[uiProgram];
+
+      if ( ((unsigned long long) program.uiKeysOffset + program.uiKeysLength > ullText) ||
+           ((unsigned long long) program.uiFirstOp + program.uiOps > pHeader->uiOps) )
+      {
+         return false;
+      }
+   }
+
+   for ( unsigned int uiOp = 0; uiOp < pHeader->uiOps; uiOp++ )
+   {
+      const KEYCACHEOP& op = pOps[uiOp];
+
+      if ( (op.uiType > KEYOP::KEYOP_APPACTIVATE) ||
+           ((op.uiType == KEYOP::KEYOP_APPACTIVATE) && 
+            ((unsigned long long) op.uiValue + op.uiParam > ullText)) )
+      {
+         return false;
+      }
+   }
+
+   for ( unsigned int uiLine = 0; uiLine < pHeader->uiLines; uiLine++ )
+   {
+      if ( (unsigned long long) pLines[uiLine].uiOffset + pLines[uiLine].uiLength > ullText )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * CKeyProgramCache::GetKeys()
+ *
+ * The key string of an entry, in the mapping or its own
+ */
+
+const char* CKeyProgramCache::GetKeys( const CACHEENTRY& entry, size_t& iLength ) const
+{
+   if ( entry.iMapped == KEYCACHE_NONE )
+   {
+      iLength = entry.sKeys.size();
+
+      return entry.sKeys.data();
+   }
+
+   const KEYCACHEHEADER* pHeader = (const KEYCACHEHEADER*) m_pView;
+   const KEYCACHEPROGRAM& program = ((const KEYCACHEPROGRAM*) (pHeader + 1))[entry.iMapped];
+   const char* pText = (const char*) m_pView + m_iViewSize - pHeader->uiTextBytes;
+
+   iLength = program.uiKeysLength;
+
+   return pText + program.uiKeysOffset;
+}
+
+/**
+ * CKeyProgramCache::LoadEntry()
+ *
+ * Copies a program out of the mapping, no compiling involved
+ */
+
+void CKeyProgramCache::LoadEntry( CACHEENTRY& entry )
+{
+   const KEYCACHEHEADER* pHeader = (const KEYCACHEHEADER*) m_pView;
+   const KEYCACHEPROGRAM* pPrograms = (const KEYCACHEPROGRAM*) (pHeader + 1);
+   const KEYCACHEOP* pOps = (const KEYCACHEOP*) (pPrograms + pHeader->uiPrograms);
+   const char* pText = (const char*) m_pView + m_iViewSize - pHeader->uiTextBytes;
+
+   const KEYCACHEPROGRAM& program = pPrograms[entry.iMapped];
+
+   std::vector<KEYOP> vecOps( program.uiOps );
+
+   for ( unsigned int uiOp = 0; uiOp < program.uiOps; uiOp++ )
+   {
+      const KEYCACHEOP& opMapped = pOps[program.uiFirstOp + uiOp];
+
+      KEYOP& op = vecOps[uiOp];
+      op.iType = (int) opMapped.uiType;
+      op.uiCount = opMapped.uiCount;
+
+      if ( op.iType == KEYOP::KEYOP_APPACTIVATE )
+      {
+         op.uiValue = 0;
+         op.uiParam = 0;
+         op.sText.assign( pText + opMapped.uiValue, opMapped.uiParam );
+      }
+      else
+      {
+         op.uiValue = opMapped.uiValue;
+         op.uiParam = opMapped.uiParam;
+      }
+   }
+
+   entry.kpProgram.Assign( vecOps, program.uiKeystrokes );
+   entry.bLoaded = true;
+}
+
+/**
+ * CKeyProgramCache::Find()
+ *
+ * The program of sKeys, from the file if it has it
+ */
+
+const CKeyProgram& CKeyProgramCache::Find( const std::string& sKeys )
+{
+   unsigned long long ullHash = Hash( sKeys.data(), sKeys.size() );
+
+   std::pair<EntryIndex::iterator, EntryIndex::iterator> range = m_mapIndex.equal_range( ullHash );
+
+   for ( EntryIndex::iterator iter = range.first; iter != range.second; ++iter )
+   {
+      CACHEENTRY& entry = m_deqEntries[iter->second];
+
+      size_t iLength = 0;
+      const char* pKeys = GetKeys( entry, iLength );
+
+      if ( (iLength == sKeys.size()) && !memcmp(pKeys, sKeys.data(), iLength) )
+      {
+         if ( !entry.bLoaded )
+         {
+            LoadEntry( entry );
+         }
+
+         m_iHits++;
+
+         return entry.kpProgram;
+      }
+   }
+
+   m_deqEntries.push_back( CACHEENTRY() );
+
+   CACHEENTRY& entry = m_deqEntries.back();
+   entry.sKeys = sKeys;
+   entry.iMapped = KEYCACHE_NONE;
+   entry.bLoaded = true;
+   entry.kpProgram.Compile( sKeys );
+
+   m_mapIndex.insert( EntryIndex::value_type(ullHash, m_deqEntries.size() - 1) );
+
+   m_bDirty = true;
+   m_iMisses++;
+
+   return entry.kpProgram;
+}
+
+/**
+ * CKeyProgramCache::Save()
+ *
+ * Writes the file if a program was compiled since Open(), through a
+ * temporary file so a reader never maps half of it. A script that
+ * changed since Open() is not saved, its lines may be of either
+ * version.
+ */
+
+bool CKeyProgramCache::Save()
+{
+   if ( m_sPath.empty() )
+   {
+      return false;
+   }
+
+   if ( !m_bDirty )
+   {
+      return true;
+   }
+
+   unsigned long long ullHash = 0;
+   unsigned long long ullSize = 0;
+
+   if ( !HashFile(m_sSource, ullHash, ullSize) || 
+        (ullHash != m_ullSourceHash) || (ullSize != m_ullSourceSize) )
+   {
+      m_bDirty = false;
+
+      return true;
+   }
+
+   std::vector<KEYCACHEPROGRAM> vecPrograms;
+   std::vector<KEYCACHEOP> vecOps;
+   std::string sText;
+
+   vecPrograms.reserve( m_deqEntries.size() );
+
+   for ( size_t iEntry = 0; iEntry < m_deqEntries.size(); iEntry++ )
+   {
+      CACHEENTRY& entry = m_deqEntries[iEntry];
+
+      if ( !entry.bLoaded )
+      {
+         LoadEntry( entry );
+      }
+
+      // The mapping goes away below
+
+      if ( entry.iMapped != KEYCACHE_NONE )
+      {
+         size_t iLength = 0;
+         const char* pKeys = GetKeys( entry, iLength );
+
+         entry.sKeys.assign( pKeys, iLength );
+         entry.iMapped = KEYCACHE_NONE;
+      }
+
+      const std::vector<KEYOP>& vecEntryOps = entry.kpProgram.GetOps();
+
+      KEYCACHEPROGRAM program;
+      program.uiKeysOffset = (unsigned int) sText.size();
+      program.uiKeysLength = (unsigned int) entry.sKeys.size();
+      program.uiFirstOp = (unsigned int) vecOps.size();
+      program.uiOps = (unsigned int) vecEntryOps.size();
+      program.uiKeystrokes = (unsigned int) entry.kpProgram.GetKeystrokes();
+
+      vecPrograms.push_back( program );
+
+      sText += entry.sKeys;
+
+      for ( size_t iOp = 0; iOp < vecEntryOps.size(); iOp++ )
+      {
+         const KEYOP& op = vecEntryOps[iOp];
+
+         KEYCACHEOP opMapped;
+         opMapped.uiType = (unsigned int) op.iType;
+         opMapped.uiValue = op.uiValue;
+         opMapped.uiCount = op.uiCount;
+         opMapped.uiParam = op.uiParam;
+
+         if ( op.iType == KEYOP::KEYOP_APPACTIVATE )
+         {
+            opMapped.uiValue = (unsigned int) sText.size();
+            opMapped.uiParam = (unsigned int) op.sText.size();
+
+            sText += op.sText;
+         }
+
+         vecOps.push_back( opMapped );
+      }
+   }
+
+   std::vector<KEYCACHELINE> vecLines( m_vecLines.size() );
+
+   for ( size_t iLine = 0; iLine < m_vecLines.size(); iLine++ )
+   {
+      vecLines[iLine].uiOffset = (unsigned int) sText.size();
+      vecLines[iLine].uiLength = (unsigned int) m_vecLines[iLine].size();
+
+      sText += m_vecLines[iLine];
+   }
+
+   Unmap();
+
+   KEYCACHEHEADER header;
+   memset( &header, 0, sizeof(header) );
+
+   header.uiMagic = KEYCACHE_MAGIC;
+   header.uiVersion = KEYCACHE_VERSION;
+   header.uiFlags = m_uiFlags;
+   header.uiLines = (unsigned int) vecLines.size();
+   header.ullPathHash = m_ullPathHash;
+   header.ullSourceHash = m_ullSourceHash;
+   header.ullSourceSize = m_ullSourceSize;
+   header.uiPrograms = (unsigned int) vecPrograms.size();
+   header.uiOps = (unsigned int) vecOps.size();
+   header.uiTextBytes = (unsigned int) sText.size();
+
+   std::string sBody;
+   sBody.reserve( vecPrograms.size() * sizeof(KEYCACHEPROGRAM) + 
+      vecOps.size() * sizeof(KEYCACHEOP) + vecLines.size() * sizeof(KEYCACHELINE) + sText.size() );
+
+   sBody.append( (const char*) vecPrograms.data(), vecPrograms.size() * sizeof(KEYCACHEPROGRAM) );
+   sBody.append( (const char*) vecOps.data(), vecOps.size() * sizeof(KEYCACHEOP) );
+   sBody.append( (const char*) vecLines.data(), vecLines.size() * sizeof(KEYCACHELINE) );
+   sBody += sText;
+
+   header.ullChecksum = Hash( sBody.data(), sBody.size() );
+
+   std::string sTempPath = m_sPath + ".tmp";
+
+#if defined(_WIN32)
+   ::CreateDirectoryW( GetWidePath(m_sDirectory).c_str(), NULL );
+
+   FILE* pFile = _wfopen( GetWidePath(sTempPath).c_str(), L"wb" );
+#else
+   mkdir( m_sDirectory.c_str(), 0700 );
+
+   FILE* pFile = fopen( sTempPath.c_str(), "wb" );
+#endif
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   bool bWritten = 
+      (fwrite(&header, sizeof(header), 1, pFile) == 1) &&
+      (sBody.empty() || (fwrite(sBody.data(), 1, sBody.size(), pFile) == sBody.size()));
+
+   bWritten = (fclose(pFile) == 0) && bWritten;
+
+#if defined(_WIN32)
+   bWritten = bWritten && ::MoveFileExW( GetWidePath(sTempPath).c_str(), 
+      GetWidePath(m_sPath).c_str(), MOVEFILE_REPLACE_EXISTING );
+#else
+   bWritten = bWritten && (rename(sTempPath.c_str(), m_sPath.c_str()) == 0);
+#endif
+
+   if ( !bWritten )
+   {
+#if defined(_WIN32)
+      _wremove( GetWidePath(sTempPath).c_str() );
+#else
+      remove( sTempPath.c_str() );
+#endif
+      return false;
+   }
+
+   m_bDirty = false;
+
+   Prune();
+
+   return true;
+}
+
+/**
+ * CKeyProgramCache::Prune()
+ *
+ * An edited script writes over its own file, but a renamed or
+ * deleted one leaves its file behind. Past MAX_FILES files the ones
+ * written longest ago are deleted; they are only compiled again if
+ * their script runs again.
+ */
+
+void CKeyProgramCache::Prune()
+{
+   std::vector<std::pair<long long, std::string> > vecFiles;
+
+   std::string sPrefix = m_sPath.substr( 0, m_sPath.find_last_of("\\/") + 1 );
+
+#if defined(_WIN32)
+   WIN32_FIND_DATAW fdData;
+
+   HANDLE hFind = ::FindFirstFileW( GetWidePath(sPrefix + "*.pkc").c_str(), &fdData );
+
+   if ( hFind == INVALID_HANDLE_VALUE )
+   {
+      return;
+   }
+
+   do
+   {
+      long long llTime = (long long) (((unsigned long long) fdData.ftLastWriteTime.dwHighDateTime << 32) | 
+         fdData.ftLastWriteTime.dwLowDateTime);
+
+      std::wstring wsPath = GetWidePath( sPrefix ) + fdData.cFileName;
+
+      int iBytes = ::WideCharToMultiByte( CP_UTF8, 0, wsPath.c_str(), -1, NULL, 0, NULL, NULL );
+
+      if ( iBytes > 0 )
+      {
+         std::string sPath( iBytes, '\0' );
+         ::WideCharToMultiByte( CP_UTF8, 0, wsPath.c_str(), -1, &sPath[0], iBytes, NULL, NULL );
+         sPath.resize( iBytes - 1 );
+
+         vecFiles.push_back( std::make_pair(llTime, sPath) );
+      }
+   }
+   while ( ::FindNextFileW(hFind, &fdData) );
+
+   ::FindClose( hFind );
+#else
+   DIR* pDir = opendir( sPrefix.c_str() );
+
+   if ( !pDir )
+   {
+      return;
+   }
+
+   while ( struct dirent* pEntry = readdir(pDir) )
+   {
+      size_t iLength = strlen( pEntry->d_name );
+
+      if ( (iLength <= 4) || strcmp(pEntry->d_name + iLength - 4, ".pkc") )
+      {
+         continue;
+      }
+
+      std::string sPath = sPrefix + pEntry->d_name;
+
+      struct stat st;
+
+      if ( stat(sPath.c_str(), &st) == 0 )
+      {
+         vecFiles.push_back( std::make_pair(
+            (long long) st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec, sPath) );
+      }
+   }
+
+   closedir( pDir );
+#endif
+
+   if ( vecFiles.size() <= MAX_FILES )
+   {
+      return;
+   }
+
+   std::sort( vecFiles.begin(), vecFiles.end() );
+
+   size_t iExcess = vecFiles.size() - MAX_FILES;
+
+   for ( size_t iLoop = 0; (iLoop < vecFiles.size()) && (iExcess > 0); iLoop++ )
+   {
+      if ( vecFiles[iLoop].second == m_sPath )
+      {
+         continue;
+      }
+
+#if defined(_WIN32)
+      _wremove( GetWidePath(vecFiles[iLoop].second).c_str() );
+#else
+      remove( vecFiles[iLoop].second.c_str() );
+#endif
+
+      iExcess--;
+   }
+}
+
+/**
+ * CKeyProgramCache::GetLines()
+ *
+ * The script's lines as SetLines() left them, from the file when
+ * Open() found one
+ */
+
+const std::vector<std::string>& CKeyProgramCache::GetLines() const
+{
+   return m_vecLines;
+}
+
+/**
+ * CKeyProgramCache::SetLines()
+ *
+ * The lines read from the script, kept in the file for its next run
+ */
+
+void CKeyProgramCache::SetLines( const std::vector<std::string>& vecLines )
+{
+   m_vecLines = vecLines;
+
+   m_bDirty = true;
+}
+
+/**
+ * CKeyProgramCache::IsMapped()
+ */
+
+bool CKeyProgramCache::IsMapped() const
+{
+   return m_pView != NULL;
+}
+
+/**
+ * CKeyProgramCache::GetPath()
+ */
+
+const std::string& CKeyProgramCache::GetPath() const
+{
+   return m_sPath;
+}
+
+/**
+ * CKeyProgramCache::GetHits()
+ */
+
+size_t CKeyProgramCache::GetHits() const
+{
+   return m_iHits;
+}
+
+/**
+ * CKeyProgramCache::GetMisses()
+ */
+
+size_t CKeyProgramCache::GetMisses() const
+{
+   return m_iMisses;
+}
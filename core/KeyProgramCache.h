@@ -0,0 +1,160 @@
+/**
+ * KeyProgramCache.h - PuTTYCS compiled script cache
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(KEYPROGRAMCACHE_H__INCLUDED_)
+#define KEYPROGRAMCACHE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "KeyProgram.h"
+
+/**
+ * CKeyProgramCache
+ *
+ * Keeps the compiled CKeyProgram of every key string a script sends
+ * in a file, so running the same script again does not parse or
+ * compile it again. The file is named after the script's path and
+ * the send flags and holds a hash of the script's bytes; Open()
+ * hashes the script, maps the file and checks it, its lines come
+ * from GetLines(), and Find() hands out the programs straight from
+ * the mapping, compiling only the key strings it does not hold.
+ * Save() writes the file back when something was compiled, over the
+ * file of the script's earlier contents, and deletes the oldest
+ * files past MAX_FILES. A file that does not match, from another
+ * version or cut short, is ignored and rewritten.
+ *
+ * The keyboard layout is not part of the key: characters are turned
+ * into keys when the program is sent, not when it is compiled.
+ */
+
+class CKeyProgramCache
+{
+public:
+
+   enum
+   {
+      FLAG_SENDCR = 0x01,
+      FLAG_CAPSLOCK = 0x02,
+      FLAG_PARSE = 0x04,
+      FLAG_TAB = 0x08
+   };
+
+   enum
+   {
+      MAX_FILES = 64
+   };
+
+   CKeyProgramCache();
+   virtual ~CKeyProgramCache();
+
+   bool Open( const std::string& sDirectory, const std::string& sSource, 
+              unsigned int uiFlags );
+   void Close();
+
+   const std::vector<std::string>& GetLines() const;
+   void SetLines( const std::vector<std::string>& vecLines );
+
+   bool Save();
+
+   const CKeyProgram& Find( const std::string& sKeys );
+
+   bool IsMapped() const;
+   const std::string& GetPath() const;
+
+   size_t GetHits() const;
+   size_t GetMisses() const;
+
+   static unsigned long long Hash( const void* pData, size_t iLength, 
+                                   unsigned long long ullHash = 14695981039346656037ULL );
+
+protected:
+
+   struct CACHEENTRY
+   {
+      std::string sKeys;
+
+      size_t iMapped;
+
+      bool bLoaded;
+
+      CKeyProgram kpProgram;
+   };
+
+   typedef std::unordered_multimap<unsigned long long, size_t> EntryIndex;
+
+   CKeyProgramCache( const CKeyProgramCache& ) = delete;
+   CKeyProgramCache& operator=( const CKeyProgramCache& ) = delete;
+
+   static bool HashFile( const std::string& sPath, unsigned long long& ullHash, 
+                         unsigned long long& ullSize );
+
+   bool Map();
+   void Unmap();
+   bool Validate() const;
+
+   const char* GetKeys( const CACHEENTRY& entry, size_t& iLength ) const;
+   void LoadEntry( CACHEENTRY& entry );
+
+   void Prune();
+
+   std::string m_sDirectory;
+   std::string m_sPath;
+
+   std::string m_sSource;
+
+   unsigned long long m_ullPathHash;
+   unsigned long long m_ullSourceHash;
+   unsigned long long m_ullSourceSize;
+   unsigned int m_uiFlags;
+
+   const unsigned char* m_pView;
+   size_t m_iViewSize;
+
+   std::deque<CACHEENTRY> m_deqEntries;
+   EntryIndex m_mapIndex;
+
+   std::vector<std::string> m_vecLines;
+
+   bool m_bDirty;
+
+   size_t m_iHits;
+   size_t m_iMisses;
+};
+
+#endif // !defined(KEYPROGRAMCACHE_H__INCLUDED_)
@@ -0,0 +1,432 @@
+/**
+ * KeyTokenizer.h - PuTTYCS SendKeys tokenizer
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(KEYTOKENIZER_H__INCLUDED_)
+#define KEYTOKENIZER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+
+/**
+ * Characters of the string being tokenized, not a copy of them. Not
+ * NUL terminated, so it only lives as long as that string.
+ */
+
+template <class CHAR>
+struct KEYSPAN
+{
+   static const size_t npos = (size_t) -1;
+
+   const CHAR* pText;
+   size_t iLength;
+
+   KEYSPAN Mid( size_t iOffset, size_t iCount = npos ) const;
+
+   size_t Find( CHAR ch, size_t iFrom = 0 ) const;
+   size_t ReverseFind( CHAR ch ) const;
+
+   bool StartsWithNoCase( const CHAR* pszPrefix ) const;
+   int CompareNoCase( const CHAR* psz ) const;
+
+   unsigned int ToNumber( size_t iOffset = 0 ) const;
+
+   static CHAR ToUpper( CHAR ch );
+};
+
+enum
+{
+   KEYTOKEN_TEXT = 0,      // spText: plain characters, a key each
+   KEYTOKEN_GROUP_BEGIN,   // (
+   KEYTOKEN_GROUP_END,     // )
+   KEYTOKEN_MODIFIER,      // spText: one of % + ^ @
+   KEYTOKEN_ENTER,         // ~
+   KEYTOKEN_SPECIAL        // spText: what is between { and }
+};
+
+enum
+{
+   KEYERROR_NONE = 0,
+   KEYERROR_UNTERMINATED   // a { without its }
+};
+
+template <class CHAR>
+struct KEYTOKEN
+{
+   int iType;
+
+   KEYSPAN<CHAR> spText;
+};
+
+/**
+ * CKeyTokenizer
+ *
+ * Splits a SendKeys string into tokens that point into it, without
+ * copying and without a limit on the length of a {...}. Next()
+ * returns false at the end of the string or at the first error,
+ * GetError() tells which and GetPosition() where parsing stopped.
+ * CHAR is char for UTF-8 and TCHAR for CSendKeys.
+ */
+
+template <class CHAR>
+class CKeyTokenizer
+{
+public:
+
+   CKeyTokenizer( const CHAR* pszKeys );
+   CKeyTokenizer( const CHAR* pKeys, size_t iLength );
+
+   bool Next( KEYTOKEN<CHAR>& token );
+
+   int GetError() const;
+   size_t GetPosition() const;
+
+protected:
+
+   static bool IsPlain( CHAR ch );
+
+   const CHAR* m_pKeys;
+   const CHAR* m_pCurrent;
+   const CHAR* m_pEnd;
+
+   int m_iError;
+};
+
+/**
+ * KEYSPAN::Mid()
+ */
+
+template <class CHAR>
+KEYSPAN<CHAR> KEYSPAN<CHAR>::Mid( size_t iOffset, size_t iCount ) const
+{
+   KEYSPAN span;
+   span.pText = pText + ((iOffset < iLength) ? iOffset : iLength);
+   span.iLength = (iOffset < iLength) ? iLength - iOffset : 0;
+
+   if ( iCount < span.iLength )
+   {
+      span.iLength = iCount;
+   }
+
+   return span;
+}
+
+/**
+ * KEYSPAN::Find()
+ */
+
+template <class CHAR>
+size_t KEYSPAN<CHAR>::Find( CHAR ch, size_t iFrom ) const
+{
+   for ( size_t iLoop = iFrom; iLoop < iLength; iLoop++ )
+   {
+      if ( pText[iLoop] == ch )
+      {
+         return iLoop;
+      }
+   }
+
+   return npos;
+}
+
+/**
+ * KEYSPAN::ReverseFind()
+ */
+
+template <class CHAR>
+size_t KEYSPAN<CHAR>::ReverseFind( CHAR ch ) const
+{
+   for ( size_t iLoop = iLength; iLoop > 0; iLoop-- )
+   {
+      if ( pText[iLoop - 1] == ch )
+      {
+         return iLoop - 1;
+      }
+   }
+
+   return npos;
+}
+
+/**
+ * KEYSPAN::ToUpper()
+ *
+ * ASCII only, key names and the {...} commands are
+ */
+
+template <class CHAR>
+CHAR KEYSPAN<CHAR>::ToUpper( CHAR ch )
+{
+   return ((ch >= 'a') && (ch <= 'z')) ? (CHAR) (ch - ('a' - 'A')) : ch;
+}
+
+/**
+ * KEYSPAN::StartsWithNoCase()
+ */
+
+template <class CHAR>
+bool KEYSPAN<CHAR>::StartsWithNoCase( const CHAR* pszPrefix ) const
+{
+   for ( size_t iLoop = 0; pszPrefix[iLoop]; iLoop++ )
+   {
+      if ( (iLoop >= iLength) || (ToUpper(pText[iLoop]) != ToUpper(pszPrefix[iLoop])) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * KEYSPAN::CompareNoCase()
+ *
+ * Like stricmp( span, psz ), for the binary search of key names
+ */
+
+template <class CHAR>
+int KEYSPAN<CHAR>::CompareNoCase( const CHAR* psz ) const
+{
+   for ( size_t iLoop = 0; ; iLoop++ )
+   {
+      int iSpan = (iLoop < iLength) ? (int) ToUpper( pText[iLoop] ) : 0;
+      int iOther = (int) ToUpper( psz[iLoop] );
+
+      if ( (iSpan != iOther) || (iSpan == 0) )
+      {
+         return iSpan - iOther;
+      }
+   }
+}
+
+/**
+ * KEYSPAN::ToNumber()
+ *
+ * atoi() of the span from iOffset on: leading blanks and a sign are
+ * skipped, the number ends at the first non digit
+ */
+
+template <class CHAR>
+unsigned int KEYSPAN<CHAR>::ToNumber( size_t iOffset ) const
+{
+   size_t iPos = iOffset;
+
+   while ( (iPos < iLength) && 
+           ((pText[iPos] == ' ') || ((pText[iPos] >= '\t') && (pText[iPos] <= '\r'))) )
+   {
+      iPos++;
+   }
+
+   bool bNegative = (iPos < iLength) && (pText[iPos] == '-');
+
+   if ( (iPos < iLength) && ((pText[iPos] == '-') || (pText[iPos] == '+')) )
+   {
+      iPos++;
+   }
+
+   unsigned int uiNumber = 0;
+
+   for ( ; (iPos < iLength) && (pText[iPos] >= '0') && (pText[iPos] <= '9'); iPos++ )
+   {
+      uiNumber = uiNumber * 10 + (unsigned int) (pText[iPos] - '0');
+   }
+
+   return bNegative ? 0 - uiNumber : uiNumber;
+}
+
+/**
+ * CKeyTokenizer::CKeyTokenizer()
+ */
+
+template <class CHAR>
+CKeyTokenizer<CHAR>::CKeyTokenizer( const CHAR* pszKeys )
+{
+   const CHAR* pEnd = pszKeys;
+
+   while ( *pEnd )
+   {
+      pEnd++;
+   }
+
+   m_pKeys = pszKeys;
+   m_pCurrent = pszKeys;
+   m_pEnd = pEnd;
+
+   m_iError = KEYERROR_NONE;
+}
+
+/**
+ * CKeyTokenizer::CKeyTokenizer()
+ */
+
+template <class CHAR>
+CKeyTokenizer<CHAR>::CKeyTokenizer( const CHAR* pKeys, size_t iLength )
+{
+   m_pKeys = pKeys;
+   m_pCurrent = pKeys;
+   m_pEnd = pKeys + iLength;
+
+   m_iError = KEYERROR_NONE;
+}
+
+/**
+ * CKeyTokenizer::IsPlain()
+ */
+
+template <class CHAR>
+bool CKeyTokenizer<CHAR>::IsPlain( CHAR ch )
+{
+   // A bit per ASCII character for ( ) % + ^ @ ~ {, so the long runs
+   // of text cost one table test per character
+
+   static const unsigned long long s_aullSpecial[2] =
+   {
+      (1ULL << '%') | (1ULL << '(') | (1ULL << ')') | (1ULL << '+'),
+      (1ULL << ('@' - 64)) | (1ULL << ('^' - 64)) | (1ULL << ('{' - 64)) | (1ULL << ('~' - 64))
+   };
+
+   unsigned int uiChar = (unsigned int) ch;
+
+   return (uiChar >= 128) || !((s_aullSpecial[uiChar >> 6] >> (uiChar & 63)) & 1);
+}
+
+/**
+ * CKeyTokenizer::Next()
+ *
+ * token is only valid when it returns true
+ */
+
+template <class CHAR>
+bool CKeyTokenizer<CHAR>::Next( KEYTOKEN<CHAR>& token )
+{
+   if ( (m_pCurrent == m_pEnd) || (m_iError != KEYERROR_NONE) )
+   {
+      return false;
+   }
+
+   const CHAR* pStart = m_pCurrent;
+
+   token.spText.pText = pStart;
+   token.spText.iLength = 1;
+
+   switch ( *pStart )
+   {
+   case '(':
+      token.iType = KEYTOKEN_GROUP_BEGIN;
+      break;
+
+   case ')':
+      token.iType = KEYTOKEN_GROUP_END;
+      break;
+
+   case '%':
+   case '+':
+   case '^':
+   case '@':
+      token.iType = KEYTOKEN_MODIFIER;
+      break;
+
+   case '~':
+      token.iType = KEYTOKEN_ENTER;
+      break;
+
+   case '{':
+      {
+         const CHAR* pClose = pStart + 1;
+
+         while ( (pClose != m_pEnd) && (*pClose != '}') )
+         {
+            pClose++;
+         }
+
+         if ( pClose == m_pEnd )
+         {
+            m_iError = KEYERROR_UNTERMINATED;
+
+            return false;
+         }
+
+         token.iType = KEYTOKEN_SPECIAL;
+         token.spText.pText = pStart + 1;
+         token.spText.iLength = pClose - pStart - 1;
+
+         m_pCurrent = pClose + 1;
+      }
+      return true;
+
+   default:
+      {
+         const CHAR* pPlain = pStart + 1;
+
+         while ( (pPlain != m_pEnd) && IsPlain(*pPlain) )
+         {
+            pPlain++;
+         }
+
+         token.iType = KEYTOKEN_TEXT;
+         token.spText.iLength = pPlain - pStart;
+
+         m_pCurrent = pPlain;
+      }
+      return true;
+   }
+
+   m_pCurrent++;
+
+   return true;
+}
+
+/**
+ * CKeyTokenizer::GetError()
+ */
+
+template <class CHAR>
+int CKeyTokenizer<CHAR>::GetError() const
+{
+   return m_iError;
+}
+
+/**
+ * CKeyTokenizer::GetPosition()
+ *
+ * Offset of the first character not parsed: the length of the
+ * string at the end, the { of an unterminated {...} on error
+ */
+
+template <class CHAR>
+size_t CKeyTokenizer<CHAR>::GetPosition() const
+{
+   return m_pCurrent - m_pKeys;
+}
+
+#endif // !defined(KEYTOKENIZER_H__INCLUDED_)
@@ -0,0 +1,216 @@
+/**
+ * LogTail.cpp - PuTTYCS session log follower
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "LogTail.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if defined(_WIN32)
+#define LOGTAIL_SEEK _fseeki64
+#define LOGTAIL_TELL _ftelli64
+#else
+#define LOGTAIL_SEEK fseeko
+#define LOGTAIL_TELL ftello
+#endif
+
+static const size_t LOGTAIL_CHUNK_SIZE = 65536;
+
+/**
+ * CLogTail::CLogTail()
+ */
+
+CLogTail::CLogTail()
+{
+   m_pFile = NULL;
+   m_llOffset = 0;
+}
+
+/**
+ * CLogTail::~CLogTail()
+ */
+
+CLogTail::~CLogTail()
+{
+   Close();
+}
+
+/**
+ * CLogTail::Open()
+ *
+ * Reading starts at the end of the file, or at its start with
+ * bFromStart
+ */
+
+bool CLogTail::Open( const std::string& sPath, bool bFromStart )
+{
+   Close();
+
+#if defined(_WIN32)
+   // Paths are UTF-8, fopen() would take them as the ANSI code page
+
+   int iLength = ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, NULL, 0 );
+
+   std::wstring sWidePath( iLength > 0 ? iLength : 1, L'\0' );
+   ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, &sWidePath[0], iLength );
+
+   m_pFile = _wfopen( sWidePath.c_str(), L"rb" );
+#else
+   m_pFile = fopen( sPath.c_str(), "rb" );
+#endif
+
+   if ( !m_pFile )
+   {
+      return false;
+   }
+
+   m_sPath = sPath;
+   m_llOffset = bFromStart ? 0 : GetFileSize( m_pFile );
+
+   return true;
+}
+
+/**
+ * CLogTail::Close()
+ */
+
+void CLogTail::Close()
+{
+   if ( m_pFile )
+   {
+      fclose( m_pFile );
+      m_pFile = NULL;
+   }
+
+   m_llOffset = 0;
+}
+
+/**
+ * CLogTail::IsOpen()
+ */
+
+bool CLogTail::IsOpen() const
+{
+   return m_pFile != NULL;
+}
+
+/**
+ * CLogTail::GetPath()
+ */
+
+const std::string& CLogTail::GetPath() const
+{
+   return m_sPath;
+}
+
+/**
+ * CLogTail::GetOffset()
+ */
+
+long long CLogTail::GetOffset() const
+{
+   return m_llOffset;
+}
+
+/**
+ * CLogTail::GetFileSize()
+ */
+
+long long CLogTail::GetFileSize( FILE* pFile )
+{
+   if ( LOGTAIL_SEEK(pFile, 0, SEEK_END) != 0 )
+   {
+      return 0;
+   }
+
+   return (long long) LOGTAIL_TELL( pFile );
+}
+
+/**
+ * CLogTail::Read()
+ *
+ * Passes up to iMaxBytes appended since the last call to fnOutput.
+ * Returns the number of bytes passed.
+ */
+
+size_t CLogTail::Read( const OutputFunction& fnOutput, size_t iMaxBytes )
+{
+   if ( !m_pFile )
+   {
+      return 0;
+   }
+
+   long long llSize = GetFileSize( m_pFile );
+
+   if ( llSize < m_llOffset )
+   {
+      m_llOffset = 0;
+   }
+
+   if ( (llSize == m_llOffset) || (LOGTAIL_SEEK(m_pFile, m_llOffset, SEEK_SET) != 0) )
+   {
+      return 0;
+   }
+
+   char szBuffer[LOGTAIL_CHUNK_SIZE];
+
+   size_t iTotal = 0;
+
+   while ( iTotal < iMaxBytes )
+   {
+      size_t iWanted = iMaxBytes - iTotal;
+
+      if ( iWanted > sizeof(szBuffer) )
+      {
+         iWanted = sizeof(szBuffer);
+      }
+
+      size_t iRead = fread( szBuffer, 1, iWanted, m_pFile );
+
+      if ( iRead == 0 )
+      {
+         break;
+      }
+
+      m_llOffset += iRead;
+      iTotal += iRead;
+
+      fnOutput( szBuffer, iRead );
+   }
+
+   // Forget the end of file, so the next Read() sees appended data
+
+   clearerr( m_pFile );
+
+   return iTotal;
+}
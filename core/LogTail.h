@@ -0,0 +1,87 @@
+/**
+ * LogTail.h - PuTTYCS session log follower
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(LOGTAIL_H__INCLUDED_)
+#define LOGTAIL_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdio.h>
+
+#include <functional>
+#include <string>
+
+/**
+ * CLogTail
+ *
+ * Follows a log file that another process appends to, such as a
+ * PuTTY session log, like tail -f: Open() starts at the current end
+ * and Read() hands over what was appended since, a chunk at a time,
+ * so memory does not grow with the file. A file that shrank was
+ * rotated or truncated and is read again from the start.
+ */
+
+class CLogTail
+{
+public:
+
+   typedef std::function<void( const char* pData, size_t iLength )> OutputFunction;
+
+   CLogTail();
+   virtual ~CLogTail();
+
+   bool Open( const std::string& sPath, bool bFromStart = false );
+   void Close();
+
+   bool IsOpen() const;
+   const std::string& GetPath() const;
+   long long GetOffset() const;
+
+   size_t Read( const OutputFunction& fnOutput, size_t iMaxBytes = (size_t) -1 );
+
+protected:
+
+   CLogTail( const CLogTail& ) = delete;
+   CLogTail& operator=( const CLogTail& ) = delete;
+
+   static long long GetFileSize( FILE* pFile );
+
+   std::string m_sPath;
+
+   FILE* m_pFile;
+
+   long long m_llOffset;
+};
+
+#endif // !defined(LOGTAIL_H__INCLUDED_)
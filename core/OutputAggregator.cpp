@@ -0,0 +1,516 @@
+/**
+ * OutputAggregator.cpp - PuTTYCS output aggregation
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "OutputAggregator.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+static const unsigned long long FNV_OFFSET = 14695981039346656037ULL;
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+static const size_t SUMMARY_LINE_LENGTH = 60;
+
+static const char GROUP_SEPARATOR[] = "----------------";
+
+/**
+ * COutputAggregator::COutputAggregator()
+ */
+
+COutputAggregator::COutputAggregator( size_t iSampleLimit )
+{
+   m_iSampleLimit = iSampleLimit;
+}
+
+/**
+ * COutputAggregator::SetSampleLimit()
+ */
+
+void COutputAggregator::SetSampleLimit( size_t iSampleLimit )
+{
+   m_iSampleLimit = iSampleLimit;
+}
+
+/**
+ * COutputAggregator::GetSampleLimit()
+ */
+
+size_t COutputAggregator::GetSampleLimit() const
+{
+   return m_iSampleLimit;
+}
+
+/**
+ * COutputAggregator::Begin()
+ *
+ * Starts capturing a target, dropping what it captured before. The
+ * first iSkipLines lines it outputs are ignored.
+ */
+
+void COutputAggregator::Begin( WINDOWID id, const std::string& sName, size_t iSkipLines )
+{
+   std::pair<std::unordered_map<WINDOWID, CAPTURE>::iterator, bool> result = 
+      m_mapCaptures.insert( std::make_pair(id, CAPTURE()) );
+
+   if ( result.second )
+   {
+      m_vecOrder.push_back( id );
+   }
+
+   CAPTURE& capture = result.first->second;
+   capture.sName = sName;
+   capture.ullHash = FNV_OFFSET;
+   capture.iBytes = 0;
+   capture.sSample.clear();
+   capture.tfFilter.Reset();
+   capture.iSkipLines = iSkipLines;
+   capture.bExited = false;
+}
+
+/**
+ * COutputAggregator::SetExited()
+ *
+ * Marks a target that was gone before the send, so it is grouped
+ * apart from the targets that printed nothing
+ */
+
+void COutputAggregator::SetExited( WINDOWID id )
+{
+   std::unordered_map<WINDOWID, CAPTURE>::iterator it = m_mapCaptures.find( id );
+
+   if ( it != m_mapCaptures.end() )
+   {
+      it->second.bExited = true;
+   }
+}
+
+/**
+ * COutputAggregator::Append()
+ *
+ * Output of targets that are not being captured is ignored
+ */
+
+void COutputAggregator::Append( WINDOWID id, const char* pData, size_t iLength )
+{
+   std::unordered_map<WINDOWID, CAPTURE>::iterator it = m_mapCaptures.find( id );
+
+   if ( it == m_mapCaptures.end() )
+   {
+      return;
+   }
+
+   CAPTURE& capture = it->second;
+
+   unsigned long long ullHash = capture.ullHash;
+   size_t iBytes = capture.iBytes;
+
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      unsigned char chChar = (unsigned char) pData[iLoop];
+
+      if ( !capture.tfFilter.Put(chChar) )
+      {
+         continue;
+      }
+
+      if ( capture.iSkipLines > 0 )
+      {
+         if ( chChar == '\n' )
+         {
+            capture.iSkipLines--;
+         }
+
+         continue;
+      }
+
+      ullHash = (ullHash ^ chChar) * FNV_PRIME;
+
+      if ( iBytes++ < m_iSampleLimit )
+      {
+         capture.sSample += (char) chChar;
+      }
+   }
+
+   capture.ullHash = ullHash;
+   capture.iBytes = iBytes;
+}
+
+/**
+ * COutputAggregator::Clear()
+ */
+
+void COutputAggregator::Clear()
+{
+   m_mapCaptures.clear();
+   m_vecOrder.clear();
+}
+
+/**
+ * COutputAggregator::GetTargetCount()
+ */
+
+size_t COutputAggregator::GetTargetCount() const
+{
+   return m_vecOrder.size();
+}
+
+/**
+ * COutputAggregator::GetGroups()
+ *
+ * Largest group first, equal sizes in the order their first target
+ * was begun
+ */
+
+void COutputAggregator::GetGroups( std::vector<OUTPUTGROUP>& vecGroups ) const
+{
+   vecGroups.clear();
+
+   typedef std::tuple<unsigned long long, size_t, bool> GroupKey;
+
+   std::map<GroupKey, size_t> mapGroups;
+
+   for ( size_t iLoop = 0; iLoop < m_vecOrder.size(); iLoop++ )
+   {
+      const CAPTURE& capture = m_mapCaptures.find( m_vecOrder[iLoop] )->second;
+
+      std::pair<std::map<GroupKey, size_t>::iterator, bool> result = 
+         mapGroups.insert( std::make_pair(GroupKey(capture.ullHash, capture.iBytes, capture.bExited), 
+                                          vecGroups.size()) );
+
+      if ( result.second )
+      {
+         OUTPUTGROUP group;
+         group.ullHash = capture.ullHash;
+         group.iBytes = capture.iBytes;
+         group.sSample = capture.sSample;
+         group.bTruncated = capture.iBytes > capture.sSample.size();
+         group.bExited = capture.bExited;
+
+         vecGroups.push_back( group );
+      }
+
+      vecGroups[result.first->second].vecNames.push_back( capture.sName );
+   }
+
+   std::stable_sort( vecGroups.begin(), vecGroups.end(), 
+      []( const OUTPUTGROUP& group1, const OUTPUTGROUP& group2 )
+      {
+         return group1.vecNames.size() > group2.vecNames.size();
+      } );
+}
+
+/**
+ * COutputAggregator::FormatGroups()
+ *
+ * Every group as its targets between separators and its output,
+ * like dshbak -c
+ */
+
+std::string COutputAggregator::FormatGroups() const
+{
+   std::vector<OUTPUTGROUP> vecGroups;
+   GetGroups( vecGroups );
+
+   std::string sText;
+
+   for ( size_t iLoop = 0; iLoop < vecGroups.size(); iLoop++ )
+   {
+      const OUTPUTGROUP& group = vecGroups[iLoop];
+
+      char szCount[64];
+      snprintf( szCount, sizeof(szCount), " (%zu)\n", group.vecNames.size() );
+
+      sText += GROUP_SEPARATOR;
+      sText += "\n";
+      sText += CompressNames( group.vecNames ) + szCount;
+      sText += GROUP_SEPARATOR;
+      sText += "\n";
+      sText += group.sSample;
+
+      if ( group.bExited && group.sSample.empty() )
+      {
+         sText += "(exited)\n";
+      }
+
+      if ( !group.sSample.empty() && (group.sSample[group.sSample.size() - 1] != '\n') )
+      {
+         sText += "\n";
+      }
+
+      if ( group.bTruncated )
+      {
+         char szTruncated[64];
+         snprintf( szTruncated, sizeof(szTruncated), "... (%zu bytes)\n", group.iBytes );
+
+         sText += szTruncated;
+      }
+   }
+
+   return sText;
+}
+
+/**
+ * COutputAggregator::FormatSummary()
+ *
+ * One line: "72 hosts: OK / 8 hosts: error X", each group by the
+ * first line of its output, the groups past iMaxGroups only counted
+ */
+
+std::string COutputAggregator::FormatSummary( size_t iMaxGroups ) const
+{
+   std::vector<OUTPUTGROUP> vecGroups;
+   GetGroups( vecGroups );
+
+   std::string sText;
+
+   for ( size_t iLoop = 0; iLoop < vecGroups.size(); iLoop++ )
+   {
+      if ( iLoop == iMaxGroups )
+      {
+         size_t iTargets = 0;
+
+         for ( size_t iRest = iLoop; iRest < vecGroups.size(); iRest++ )
+         {
+            iTargets += vecGroups[iRest].vecNames.size();
+         }
+
+         char szRest[128];
+         snprintf( szRest, sizeof(szRest), " / %zu more outputs from %zu %s", 
+            vecGroups.size() - iLoop, iTargets, (iTargets == 1) ? "host" : "hosts" );
+
+         sText += szRest;
+         break;
+      }
+
+      const OUTPUTGROUP& group = vecGroups[iLoop];
+
+      char szCount[64];
+      snprintf( szCount, sizeof(szCount), "%zu %s: ", group.vecNames.size(), 
+         (group.vecNames.size() == 1) ? "host" : "hosts" );
+
+      std::string sLine = GetFirstLine( group.sSample );
+
+      if ( sLine.size() > SUMMARY_LINE_LENGTH )
+      {
+         sLine = sLine.substr( 0, SUMMARY_LINE_LENGTH - 3 ) + "...";
+      }
+
+      if ( iLoop > 0 )
+      {
+         sText += " / ";
+      }
+
+      sText += szCount;
+      if ( !sLine.empty() )
+      {
+         sText += sLine;
+      }
+      else
+      {
+         sText += group.bExited ? "(exited)" : "(no output)";
+      }
+   }
+
+   return sText;
+}
+
+/**
+ * COutputAggregator::GetFirstLine()
+ *
+ * The first line that is not blank, trimmed
+ */
+
+std::string COutputAggregator::GetFirstLine( const std::string& sText )
+{
+   size_t iStart = 0;
+
+   while ( iStart < sText.size() )
+   {
+      size_t iEnd = sText.find( '\n', iStart );
+
+      if ( iEnd == std::string::npos )
+      {
+         iEnd = sText.size();
+      }
+
+      size_t iFirst = sText.find_first_not_of( " \t", iStart );
+
+      if ( (iFirst != std::string::npos) && (iFirst < iEnd) )
+      {
+         size_t iLast = sText.find_last_not_of( " \t", iEnd - 1 );
+
+         return sText.substr( iFirst, iLast - iFirst + 1 );
+      }
+
+      iStart = iEnd + 1;
+   }
+
+   return std::string();
+}
+
+/**
+ * COutputAggregator::CompressNames()
+ *
+ * Joins names, folding runs of numbered names into ranges:
+ * web1,web2,web3,web7,db01,db02 gives db[01-02],web[1-3,7]
+ */
+
+std::string COutputAggregator::CompressNames( const std::vector<std::string>& vecNames )
+{
+   // Prefix and width of the number -> numbers, names without a
+   // number under a width of 0
+
+   std::map<std::pair<std::string, size_t>, std::vector<unsigned long long> > mapRuns;
+
+   std::vector<size_t> vecDigits( vecNames.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecNames.size(); iLoop++ )
+   {
+      const std::string& sName = vecNames[iLoop];
+
+      size_t iDigits = sName.size();
+
+      while ( (iDigits > 0) && isdigit((unsigned char) sName[iDigits - 1]) )
+      {
+         iDigits--;
+      }
+
+      vecDigits[iLoop] = iDigits;
+
+      size_t iWidth = sName.size() - iDigits;
+
+      if ( (iWidth == 0) || (iWidth > 18) )
+      {
+         mapRuns[std::make_pair(sName, (size_t) 0)];
+      }
+      else if ( sName[iDigits] == '0' )
+      {
+         mapRuns[std::make_pair(sName.substr(0, iDigits), iWidth)];
+      }
+   }
+
+   // Zero padded numbers keep their width, and take the numbers of
+   // that many digits that need no padding: web09,web10 is one run
+
+   for ( size_t iLoop = 0; iLoop < vecNames.size(); iLoop++ )
+   {
+      const std::string& sName = vecNames[iLoop];
+
+      size_t iDigits = vecDigits[iLoop];
+      size_t iWidth = sName.size() - iDigits;
+
+      if ( (iWidth == 0) || (iWidth > 18) )
+      {
+         continue;
+      }
+
+      std::pair<std::string, size_t> key( sName.substr(0, iDigits), iWidth );
+
+      if ( (sName[iDigits] != '0') && (mapRuns.find(key) == mapRuns.end()) )
+      {
+         key.second = 1;
+      }
+
+      mapRuns[key].push_back( strtoull(sName.c_str() + iDigits, NULL, 10) );
+   }
+
+   std::string sText;
+
+   for ( std::map<std::pair<std::string, size_t>, std::vector<unsigned long long> >::iterator it = mapRuns.begin(); 
+         it != mapRuns.end(); ++it )
+   {
+      if ( !sText.empty() )
+      {
+         sText += ",";
+      }
+
+      sText += it->first.first;
+
+      std::vector<unsigned long long>& vecNumbers = it->second;
+
+      if ( vecNumbers.empty() )
+      {
+         continue;
+      }
+
+      std::sort( vecNumbers.begin(), vecNumbers.end() );
+      vecNumbers.erase( std::unique(vecNumbers.begin(), vecNumbers.end()), vecNumbers.end() );
+
+      int iWidth = (int) it->first.second;
+
+      char szNumber[64];
+
+      if ( vecNumbers.size() == 1 )
+      {
+         snprintf( szNumber, sizeof(szNumber), "%0*llu", iWidth, vecNumbers[0] );
+         sText += szNumber;
+         continue;
+      }
+
+      sText += "[";
+
+      for ( size_t iStart = 0; iStart < vecNumbers.size(); )
+      {
+         size_t iEnd = iStart;
+
+         while ( (iEnd + 1 < vecNumbers.size()) && (vecNumbers[iEnd + 1] == vecNumbers[iEnd] + 1) )
+         {
+            iEnd++;
+         }
+
+         if ( iStart > 0 )
+         {
+            sText += ",";
+         }
+
+         snprintf( szNumber, sizeof(szNumber), "%0*llu", iWidth, vecNumbers[iStart] );
+         sText += szNumber;
+
+         if ( iEnd > iStart )
+         {
+            snprintf( szNumber, sizeof(szNumber), "-%0*llu", iWidth, vecNumbers[iEnd] );
+            sText += szNumber;
+         }
+
+         iStart = iEnd + 1;
+      }
+
+      sText += "]";
+   }
+
+   return sText;
+}
@@ -0,0 +1,124 @@
+/**
+ * OutputAggregator.h - PuTTYCS output aggregation
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(OUTPUTAGGREGATOR_H__INCLUDED_)
+#define OUTPUTAGGREGATOR_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TerminalFilter.h"
+#include "WindowSystem.h"
+
+/**
+ * Targets that produced the same output
+ */
+
+struct OUTPUTGROUP
+{
+   unsigned long long ullHash;
+   size_t iBytes;
+
+   std::vector<std::string> vecNames;
+
+   std::string sSample;       // first GetSampleLimit() bytes
+   bool bTruncated;
+   bool bExited;              // targets that were gone before the send
+};
+
+/**
+ * COutputAggregator
+ *
+ * Captures the output of each target after a send and groups the
+ * targets by identical output, like dshbak. Output is streamed in,
+ * reduced to its text by a CTerminalFilter and hashed as it
+ * arrives, so a target costs its sample and a few counters however
+ * much it prints. Two outputs are the same when their hash and
+ * length are. Begin() can skip the first lines of a target's
+ * output, the echo of the command sent. A target that exited before
+ * the send is still counted, in a group of its own.
+ */
+
+class COutputAggregator
+{
+public:
+
+   COutputAggregator( size_t iSampleLimit = 4096 );
+
+   void SetSampleLimit( size_t iSampleLimit );
+   size_t GetSampleLimit() const;
+
+   void Begin( WINDOWID id, const std::string& sName, size_t iSkipLines = 0 );
+   void SetExited( WINDOWID id );
+   void Append( WINDOWID id, const char* pData, size_t iLength );
+   void Clear();
+
+   size_t GetTargetCount() const;
+
+   void GetGroups( std::vector<OUTPUTGROUP>& vecGroups ) const;
+
+   std::string FormatGroups() const;
+   std::string FormatSummary( size_t iMaxGroups = 5 ) const;
+
+   static std::string CompressNames( const std::vector<std::string>& vecNames );
+
+protected:
+
+   struct CAPTURE
+   {
+      std::string sName;
+
+      unsigned long long ullHash;
+      size_t iBytes;
+
+      std::string sSample;
+
+      CTerminalFilter tfFilter;
+      size_t iSkipLines;
+
+      bool bExited;
+   };
+
+   static std::string GetFirstLine( const std::string& sText );
+
+   size_t m_iSampleLimit;
+
+   std::unordered_map<WINDOWID, CAPTURE> m_mapCaptures;
+   std::vector<WINDOWID> m_vecOrder;
+};
+
+#endif // !defined(OUTPUTAGGREGATOR_H__INCLUDED_)
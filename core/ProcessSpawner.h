@@ -0,0 +1,86 @@
+/**
+ * ProcessSpawner.h - PuTTYCS process spawner interface
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(PROCESSSPAWNER_H__INCLUDED_)
+#define PROCESSSPAWNER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <unordered_map>
+
+#include "WindowSystem.h"
+
+/**
+ * Process id of a process spawner
+ */
+
+typedef unsigned long long PROCESSID;
+
+/**
+ * CProcessSpawner
+ *
+ * What the session launcher needs to start terminal processes and
+ * find their windows. Time is in ms on the spawner's own clock, so a
+ * simulated spawner can run on a virtual one. Strings are UTF-8.
+ */
+
+class CProcessSpawner
+{
+public:
+
+   virtual ~CProcessSpawner() {}
+
+   virtual bool Spawn( const std::string& sCommand, PROCESSID& pid ) = 0;
+   virtual bool IsRunning( PROCESSID pid ) = 0;
+
+   /**
+    * Adds the terminal window of every spawned process that has one
+    * by now. Called once per poll for all processes, so a backend
+    * can find them in one enumeration.
+    */
+
+   virtual void FindWindows( std::unordered_map<PROCESSID, WINDOWID>& mapWindows ) = 0;
+
+   /**
+    * The launcher is done with the process, which keeps running
+    */
+
+   virtual void Release( PROCESSID pid ) = 0;
+
+   virtual double GetTime() = 0;
+   virtual void Wait( double dMs ) = 0;
+};
+
+#endif // !defined(PROCESSSPAWNER_H__INCLUDED_)
@@ -0,0 +1,770 @@
+/**
+ * PtySessionSystem.cpp - PuTTYCS pseudo-terminal sessions
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "PtySessionSystem.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "KeyProgram.h"
+#include "KeyProgramCache.h"
+
+static const int PTY_MAX_EVENTS = 256;
+static const size_t PTY_READ_SIZE = 16384;
+
+static const unsigned long PTY_DEFAULT_FLUSH_TIMEOUT = 5000;
+
+// How long closed sessions get to exit on SIGHUP before SIGKILL
+
+static const int PTY_HANGUP_GRACE_MS = 200;
+
+/**
+ * CPtySessionSystem::CPtySessionSystem()
+ */
+
+CPtySessionSystem::CPtySessionSystem()
+{
+   m_iEpoll = epoll_create1( EPOLL_CLOEXEC );
+
+   m_idNext = 1;
+   m_iPendingBytes = 0;
+   m_ulFlushTimeout = PTY_DEFAULT_FLUSH_TIMEOUT;
+
+   m_pProgramCache = NULL;
+
+   // Writing to a session that just exited must not kill us
+
+   signal( SIGPIPE, SIG_IGN );
+}
+
+/**
+ * CPtySessionSystem::~CPtySessionSystem()
+ */
+
+CPtySessionSystem::~CPtySessionSystem()
+{
+   Clear();
+
+   if ( m_iEpoll >= 0 )
+   {
+      close( m_iEpoll );
+   }
+}
+
+/**
+ * CPtySessionSystem::GetMilliseconds()
+ */
+
+double CPtySessionSystem::GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * CPtySessionSystem::RaiseFileLimit()
+ *
+ * Every session holds a descriptor, so thousands of them need more
+ * than the usual soft limit of 1024
+ */
+
+void CPtySessionSystem::RaiseFileLimit()
+{
+   static bool s_bRaised = false;
+
+   if ( s_bRaised )
+   {
+      return;
+   }
+
+   s_bRaised = true;
+
+   struct rlimit limit;
+
+   if ( (getrlimit(RLIMIT_NOFILE, &limit) == 0) && (limit.rlim_cur < limit.rlim_max) )
+   {
+      limit.rlim_cur = limit.rlim_max;
+
+      setrlimit( RLIMIT_NOFILE, &limit );
+   }
+}
+
+/**
+ * CPtySessionSystem::SetFlushTimeout()
+ */
+
+void CPtySessionSystem::SetFlushTimeout( unsigned long ulTimeoutMs )
+{
+   m_ulFlushTimeout = ulTimeoutMs;
+}
+
+/**
+ * CPtySessionSystem::SetProgramCache()
+ *
+ * Keys are looked up in pCache instead of compiled for every
+ * session, NULL to compile them again
+ */
+
+void CPtySessionSystem::SetProgramCache( CKeyProgramCache* pCache )
+{
+   m_pProgramCache = pCache;
+}
+
+/**
+ * CPtySessionSystem::AddSession()
+ *
+ * Runs vecArgv (searched in PATH) on a new 80x24 pseudo-terminal.
+ * Returns 0 if the pty or the process could not be created.
+ */
+
+WINDOWID CPtySessionSystem::AddSession( const std::string& sName, 
+                                        const std::vector<std::string>& vecArgv )
+{
+   if ( vecArgv.empty() || (m_iEpoll < 0) )
+   {
+      return 0;
+   }
+
+   RaiseFileLimit();
+
+   std::vector<char*> vecArgs;
+
+   for ( size_t iArg = 0; iArg < vecArgv.size(); iArg++ )
+   {
+      vecArgs.push_back( (char*) vecArgv[iArg].c_str() );
+   }
+
+   vecArgs.push_back( NULL );
+
+   struct winsize size;
+   memset( &size, 0, sizeof(size) );
+   size.ws_row = 24;
+   size.ws_col = 80;
+
+   int iFd = -1;
+
+   pid_t pid = forkpty( &iFd, NULL, NULL, &size );
+
+   if ( pid < 0 )
+   {
+      return 0;
+   }
+
+   if ( pid == 0 )
+   {
+      // Like a terminal, start the session with default signals, so
+      // ^C works even when we run with SIGINT ignored
+
+      static const int s_aSignals[] = { SIGHUP, SIGINT, SIGQUIT, SIGPIPE, SIGTERM, SIGTSTP };
+
+      for ( size_t iSignal = 0; iSignal < sizeof(s_aSignals) / sizeof(s_aSignals[0]); iSignal++ )
+      {
+         signal( s_aSignals[iSignal], SIG_DFL );
+      }
+
+      execvp( vecArgs[0], &vecArgs[0] );
+
+      _exit( 127 );
+   }
+
+   fcntl( iFd, F_SETFD, FD_CLOEXEC );
+   fcntl( iFd, F_SETFL, fcntl(iFd, F_GETFL) | O_NONBLOCK );
+
+   PTYSESSION session;
+   session.info.id = m_idNext++;
+   session.info.sTitle = sName;
+   session.info.iClass = WINDOWCLASS_PTY;
+   session.info.iFlags = WINDOWSTATE_VISIBLE;
+   session.iFd = iFd;
+   session.pid = pid;
+   session.bRunning = true;
+   session.iExitStatus = -1;
+   session.iPendingPos = 0;
+   session.bWatchWrites = false;
+
+   struct epoll_event event;
+   memset( &event, 0, sizeof(event) );
+   event.events = EPOLLIN;
+   event.data.u64 = session.info.id;
+
+   if ( epoll_ctl(m_iEpoll, EPOLL_CTL_ADD, iFd, &event) != 0 )
+   {
+      std::vector<PTYSESSION*> vecSessions( 1, &session );
+
+      Reap( vecSessions );
+
+      return 0;
+   }
+
+   m_mapSessions[session.info.id] = session;
+
+   return session.info.id;
+}
+
+/**
+ * CPtySessionSystem::AddShell()
+ *
+ * A local interactive shell, the stand-in for a remote host
+ */
+
+WINDOWID CPtySessionSystem::AddShell( const std::string& sName )
+{
+   std::vector<std::string> vecArgv;
+   vecArgv.push_back( "/bin/sh" );
+   vecArgv.push_back( "-i" );
+
+   return AddSession( sName, vecArgv );
+}
+
+/**
+ * CPtySessionSystem::RemoveSession()
+ */
+
+bool CPtySessionSystem::RemoveSession( WINDOWID id )
+{
+   PTYSESSION* pSession = GetSession( id );
+
+   if ( !pSession )
+   {
+      return false;
+   }
+
+   std::vector<PTYSESSION*> vecSessions( 1, pSession );
+
+   Reap( vecSessions );
+
+   m_mapSessions.erase( id );
+
+   return true;
+}
+
+/**
+ * CPtySessionSystem::Clear()
+ *
+ * All sessions are hung up at once and reaped together, so closing
+ * thousands costs one grace period, not one each
+ */
+
+void CPtySessionSystem::Clear()
+{
+   std::vector<PTYSESSION*> vecSessions;
+   vecSessions.reserve( m_mapSessions.size() );
+
+   for ( PtySessionMap::iterator it = m_mapSessions.begin(); it != m_mapSessions.end(); ++it )
+   {
+      vecSessions.push_back( &it->second );
+   }
+
+   Reap( vecSessions );
+
+   m_mapSessions.clear();
+   m_iPendingBytes = 0;
+}
+
+/**
+ * CPtySessionSystem::Reap()
+ */
+
+void CPtySessionSystem::Reap( std::vector<PTYSESSION*>& vecSessions )
+{
+   for ( size_t iLoop = 0; iLoop < vecSessions.size(); iLoop++ )
+   {
+      CloseSession( *vecSessions[iLoop] );
+
+      if ( vecSessions[iLoop]->pid > 0 )
+      {
+         kill( vecSessions[iLoop]->pid, SIGHUP );
+      }
+   }
+
+   double dDeadline = GetMilliseconds() + PTY_HANGUP_GRACE_MS;
+
+   size_t iLeft = vecSessions.size();
+
+   while ( iLeft > 0 )
+   {
+      bool bKill = GetMilliseconds() >= dDeadline;
+
+      iLeft = 0;
+
+      for ( size_t iLoop = 0; iLoop < vecSessions.size(); iLoop++ )
+      {
+         PTYSESSION& session = *vecSessions[iLoop];
+
+         if ( session.pid <= 0 )
+         {
+            continue;
+         }
+
+         if ( bKill )
+         {
+            kill( session.pid, SIGKILL );
+         }
+
+         int iStatus = 0;
+
+         if ( waitpid(session.pid, &iStatus, bKill ? 0 : WNOHANG) == session.pid )
+         {
+            session.iExitStatus = iStatus;
+            session.pid = 0;
+         }
+         else if ( errno == ECHILD )
+         {
+            session.pid = 0;
+         }
+         else
+         {
+            iLeft++;
+         }
+      }
+
+      if ( iLeft > 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+      }
+   }
+}
+
+/**
+ * CPtySessionSystem::CloseSession()
+ */
+
+void CPtySessionSystem::CloseSession( PTYSESSION& session )
+{
+   if ( session.iFd >= 0 )
+   {
+      epoll_ctl( m_iEpoll, EPOLL_CTL_DEL, session.iFd, NULL );
+
+      close( session.iFd );
+
+      session.iFd = -1;
+   }
+
+   m_iPendingBytes -= session.sPending.size() - session.iPendingPos;
+
+   session.sPending.clear();
+   session.iPendingPos = 0;
+   session.bRunning = false;
+}
+
+/**
+ * CPtySessionSystem::GetSession()
+ */
+
+CPtySessionSystem::PTYSESSION* CPtySessionSystem::GetSession( WINDOWID id )
+{
+   PtySessionMap::iterator it = m_mapSessions.find( id );
+
+   return (it != m_mapSessions.end()) ? &it->second : NULL;
+}
+
+/**
+ * CPtySessionSystem::GetSessionCount()
+ */
+
+size_t CPtySessionSystem::GetSessionCount()
+{
+   return m_mapSessions.size();
+}
+
+/**
+ * CPtySessionSystem::IsRunning()
+ */
+
+bool CPtySessionSystem::IsRunning( WINDOWID id )
+{
+   PTYSESSION* pSession = GetSession( id );
+
+   return pSession && pSession->bRunning;
+}
+
+/**
+ * CPtySessionSystem::GetExitStatus()
+ *
+ * The waitpid() status, once the session's process was reaped
+ */
+
+bool CPtySessionSystem::GetExitStatus( WINDOWID id, int& iStatus )
+{
+   PTYSESSION* pSession = GetSession( id );
+
+   if ( !pSession || (pSession->iExitStatus == -1) )
+   {
+      return false;
+   }
+
+   iStatus = pSession->iExitStatus;
+
+   return true;
+}
+
+/**
+ * CPtySessionSystem::GetPendingBytes()
+ *
+ * Bytes sent that the ptys have not taken yet
+ */
+
+size_t CPtySessionSystem::GetPendingBytes()
+{
+   return m_iPendingBytes;
+}
+
+/**
+ * CPtySessionSystem::Poll()
+ *
+ * Reads output and writes pending input for up to iTimeoutMs (-1
+ * waits for the first event). Returns the number of events.
+ */
+
+int CPtySessionSystem::Poll( int iTimeoutMs )
+{
+   struct epoll_event aEvents[PTY_MAX_EVENTS];
+
+   int iEvents = epoll_wait( m_iEpoll, aEvents, PTY_MAX_EVENTS, iTimeoutMs );
+
+   for ( int iLoop = 0; iLoop < iEvents; iLoop++ )
+   {
+      PTYSESSION* pSession = GetSession( aEvents[iLoop].data.u64 );
+
+      if ( !pSession || (pSession->iFd < 0) )
+      {
+         continue;
+      }
+
+      if ( aEvents[iLoop].events & EPOLLOUT )
+      {
+         WritePending( *pSession );
+      }
+
+      if ( aEvents[iLoop].events & (EPOLLIN | EPOLLHUP | EPOLLERR) )
+      {
+         ReadOutput( *pSession );
+      }
+   }
+
+   return (iEvents > 0) ? iEvents : 0;
+}
+
+/**
+ * CPtySessionSystem::WatchWrites()
+ */
+
+void CPtySessionSystem::WatchWrites( PTYSESSION& session, bool bWatch )
+{
+   if ( (session.bWatchWrites == bWatch) || (session.iFd < 0) )
+   {
+      return;
+   }
+
+   struct epoll_event event;
+   memset( &event, 0, sizeof(event) );
+   event.events = bWatch ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+   event.data.u64 = session.info.id;
+
+   epoll_ctl( m_iEpoll, EPOLL_CTL_MOD, session.iFd, &event );
+
+   session.bWatchWrites = bWatch;
+}
+
+/**
+ * CPtySessionSystem::WritePending()
+ *
+ * Writes as much queued input as the pty takes without blocking.
+ * Returns true when nothing is left.
+ */
+
+bool CPtySessionSystem::WritePending( PTYSESSION& session )
+{
+   while ( session.iPendingPos < session.sPending.size() )
+   {
+      ssize_t iWritten = write( session.iFd, 
+         session.sPending.data() + session.iPendingPos, 
+         session.sPending.size() - session.iPendingPos );
+
+      if ( iWritten > 0 )
+      {
+         session.iPendingPos += iWritten;
+         m_iPendingBytes -= iWritten;
+
+         continue;
+      }
+
+      if ( (iWritten < 0) && (errno == EINTR) )
+      {
+         continue;
+      }
+
+      if ( (iWritten < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) )
+      {
+         WatchWrites( session, true );
+
+         return false;
+      }
+
+      // The session is gone, its input with it
+
+      m_iPendingBytes -= session.sPending.size() - session.iPendingPos;
+      session.iPendingPos = session.sPending.size();
+   }
+
+   session.sPending.clear();
+   session.iPendingPos = 0;
+
+   WatchWrites( session, false );
+
+   return true;
+}
+
+/**
+ * CPtySessionSystem::ReadOutput()
+ */
+
+void CPtySessionSystem::ReadOutput( PTYSESSION& session )
+{
+   char szBuffer[PTY_READ_SIZE];
+
+   while ( session.iFd >= 0 )
+   {
+      ssize_t iRead = read( session.iFd, szBuffer, sizeof(szBuffer) );
+
+      if ( iRead > 0 )
+      {
+         OnOutput( session.info.id, szBuffer, (size_t) iRead );
+
+         continue;
+      }
+
+      if ( (iRead < 0) && (errno == EINTR) )
+      {
+         continue;
+      }
+
+      if ( (iRead < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) )
+      {
+         return;
+      }
+
+      // EOF, or EIO once the last slave descriptor closed
+
+      CloseSession( session );
+
+      int iStatus = 0;
+
+      if ( (session.pid > 0) && (waitpid(session.pid, &iStatus, WNOHANG) == session.pid) )
+      {
+         session.iExitStatus = iStatus;
+         session.pid = 0;
+      }
+
+      OnExit( session.info.id );
+   }
+}
+
+/**
+ * CPtySessionSystem::OnOutput()
+ */
+
+void CPtySessionSystem::OnOutput( WINDOWID, const char*, size_t )
+{
+}
+
+/**
+ * CPtySessionSystem::OnExit()
+ */
+
+void CPtySessionSystem::OnExit( WINDOWID )
+{
+}
+
+/**
+ * CPtySessionSystem::EnumTerminalWindows()
+ *
+ * Sessions that are still running
+ */
+
+void CPtySessionSystem::EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows )
+{
+   size_t iWindow = 0;
+
+   for ( PtySessionMap::iterator it = m_mapSessions.begin(); it != m_mapSessions.end(); ++it )
+   {
+      if ( !it->second.bRunning )
+      {
+         continue;
+      }
+
+      if ( iWindow < vecWindows.size() )
+      {
+         vecWindows[iWindow] = it->second.info;
+      }
+      else
+      {
+         vecWindows.push_back( it->second.info );
+      }
+
+      iWindow++;
+   }
+
+   vecWindows.resize( iWindow );
+}
+
+/**
+ * CPtySessionSystem::Activate()
+ */
+
+double CPtySessionSystem::Activate( WINDOWID )
+{
+   return 0.0;
+}
+
+/**
+ * CPtySessionSystem::IsForeground()
+ *
+ * Every running session takes input, there is no focus
+ */
+
+bool CPtySessionSystem::IsForeground( WINDOWID id )
+{
+   return IsRunning( id );
+}
+
+/**
+ * CPtySessionSystem::WaitForForeground()
+ */
+
+double CPtySessionSystem::WaitForForeground( WINDOWID, unsigned long, int* piOutcome )
+{
+   if ( piOutcome )
+   {
+      *piOutcome = WAITOUTCOME_FIXED;
+   }
+
+   return 0.0;
+}
+
+/**
+ * CPtySessionSystem::SendKeys()
+ *
+ * Queues the terminal bytes of sKeys and writes what the pty takes
+ */
+
+double CPtySessionSystem::SendKeys( WINDOWID id, const std::string& sKeys )
+{
+   double dStart = GetMilliseconds();
+
+   PTYSESSION* pSession = GetSession( id );
+
+   if ( pSession && pSession->bRunning )
+   {
+      std::string sBytes;
+
+      if ( m_pProgramCache )
+      {
+         sBytes = m_pProgramCache->Find( sKeys ).GetTerminalBytes();
+      }
+      else
+      {
+         CKeyProgram kpProgram;
+         kpProgram.Compile( sKeys );
+
+         sBytes = kpProgram.GetTerminalBytes();
+      }
+
+      pSession->sPending += sBytes;
+      m_iPendingBytes += sBytes.size();
+
+      WritePending( *pSession );
+   }
+
+   return GetMilliseconds() - dStart;
+}
+
+/**
+ * CPtySessionSystem::WaitForInputIdle()
+ */
+
+double CPtySessionSystem::WaitForInputIdle( WINDOWID, unsigned long, int* piOutcome )
+{
+   if ( piOutcome )
+   {
+      *piOutcome = WAITOUTCOME_FIXED;
+   }
+
+   return 0.0;
+}
+
+/**
+ * CPtySessionSystem::GetCapsLock()
+ */
+
+bool CPtySessionSystem::GetCapsLock()
+{
+   return false;
+}
+
+/**
+ * CPtySessionSystem::Flush()
+ *
+ * Polls until every session took its input or the flush timeout
+ * expired
+ */
+
+double CPtySessionSystem::Flush()
+{
+   double dStart = GetMilliseconds();
+
+   while ( m_iPendingBytes > 0 )
+   {
+      double dLeft = m_ulFlushTimeout - (GetMilliseconds() - dStart);
+
+      if ( dLeft <= 0 )
+      {
+         break;
+      }
+
+      Poll( (int) dLeft + 1 );
+   }
+
+   return GetMilliseconds() - dStart;
+}
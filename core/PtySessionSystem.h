@@ -0,0 +1,152 @@
+/**
+ * PtySessionSystem.h - PuTTYCS pseudo-terminal sessions
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(PTYSESSIONSYSTEM_H__INCLUDED_)
+#define PTYSESSIONSYSTEM_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <sys/types.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "WindowSystem.h"
+
+class CKeyProgramCache;
+
+/**
+ * CPtySessionSystem
+ *
+ * Delivers broadcasts to child processes on pseudo-terminals (ssh
+ * host, or a local shell) instead of windows: the keys are turned
+ * into the bytes a terminal would send and written to each master,
+ * all masters multiplexed with one epoll set. There is no focus to
+ * switch and nothing to wait for per session, so a send queues the
+ * bytes and Flush() writes whatever the ptys did not take at once.
+ *
+ * Sessions are named; the name is the title filters match. Session
+ * output is read and passed to OnOutput(), which drops it. Linux
+ * only.
+ */
+
+class CPtySessionSystem : public CWindowSystem
+{
+public:
+
+   CPtySessionSystem();
+   virtual ~CPtySessionSystem();
+
+   WINDOWID AddSession( const std::string& sName, const std::vector<std::string>& vecArgv );
+   WINDOWID AddShell( const std::string& sName );
+
+   bool RemoveSession( WINDOWID id );
+   void Clear();
+
+   size_t GetSessionCount();
+   bool IsRunning( WINDOWID id );
+   bool GetExitStatus( WINDOWID id, int& iStatus );
+
+   int Poll( int iTimeoutMs );
+   size_t GetPendingBytes();
+
+   void SetFlushTimeout( unsigned long ulTimeoutMs );
+   void SetProgramCache( CKeyProgramCache* pCache );
+
+   virtual void EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows );
+
+   virtual double Activate( WINDOWID id );
+   virtual bool IsForeground( WINDOWID id );
+
+   virtual double WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                     int* piOutcome );
+
+   virtual double SendKeys( WINDOWID id, const std::string& sKeys );
+
+   virtual double WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                    int* piOutcome );
+
+   virtual bool GetCapsLock();
+
+   virtual double Flush();
+
+protected:
+
+   struct PTYSESSION
+   {
+      WINDOWINFO info;
+
+      int iFd;
+      pid_t pid;
+
+      bool bRunning;
+      int iExitStatus;
+
+      std::string sPending;
+      size_t iPendingPos;
+
+      bool bWatchWrites;
+   };
+
+   typedef std::map<WINDOWID, PTYSESSION> PtySessionMap;
+
+   virtual void OnOutput( WINDOWID id, const char* pData, size_t iLength );
+   virtual void OnExit( WINDOWID id );
+
+   PTYSESSION* GetSession( WINDOWID id );
+
+   bool WritePending( PTYSESSION& session );
+   void ReadOutput( PTYSESSION& session );
+   void CloseSession( PTYSESSION& session );
+   void Reap( std::vector<PTYSESSION*>& vecSessions );
+   void WatchWrites( PTYSESSION& session, bool bWatch );
+
+   static void RaiseFileLimit();
+   static double GetMilliseconds();
+
+   PtySessionMap m_mapSessions;
+
+   int m_iEpoll;
+
+   WINDOWID m_idNext;
+
+   size_t m_iPendingBytes;
+
+   unsigned long m_ulFlushTimeout;
+
+   CKeyProgramCache* m_pProgramCache;
+};
+
+#endif // !defined(PTYSESSIONSYSTEM_H__INCLUDED_)
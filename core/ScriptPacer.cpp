@@ -0,0 +1,374 @@
+/**
+ * ScriptPacer.cpp - PuTTYCS prompt paced scripts
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "ScriptPacer.h"
+
+#include <algorithm>
+#include <chrono>
+
+static const unsigned long SCRIPT_DEFAULT_LINE_TIMEOUT = 30000;
+
+// Only the end of a long line can be a prompt
+
+static const size_t SCRIPT_MAX_LAST_LINE = 1024;
+
+static const int SCRIPT_MAX_POLL_MS = 50;
+
+/**
+ * CScriptPacer::CScriptPacer()
+ */
+
+CScriptPacer::CScriptPacer( CBroadcastEngine* pEngine )
+{
+   m_pEngine = pEngine;
+
+   m_ulLineTimeout = SCRIPT_DEFAULT_LINE_TIMEOUT;
+
+   m_bTab = false;
+   m_bParse = false;
+
+   m_iRemaining = 0;
+   m_iTimeouts = 0;
+}
+
+/**
+ * CScriptPacer::~CScriptPacer()
+ */
+
+CScriptPacer::~CScriptPacer()
+{
+}
+
+/**
+ * CScriptPacer::GetMilliseconds()
+ */
+
+double CScriptPacer::GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * CScriptPacer::IsValidPrompt()
+ */
+
+bool CScriptPacer::IsValidPrompt( const std::string& sPattern )
+{
+   try
+   {
+      std::regex reTest( sPattern );
+   }
+   catch ( const std::regex_error& )
+   {
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * CScriptPacer::SetPrompt()
+ *
+ * Returns false, leaving the prompt unset, if sPattern is not a
+ * valid regular expression
+ */
+
+bool CScriptPacer::SetPrompt( const std::string& sPattern )
+{
+   m_pPrompt.reset();
+
+   try
+   {
+      m_pPrompt.reset( new std::regex(sPattern, std::regex::ECMAScript | std::regex::optimize) );
+   }
+   catch ( const std::regex_error& )
+   {
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * CScriptPacer::SetLineTimeout()
+ */
+
+void CScriptPacer::SetLineTimeout( unsigned long ulTimeoutMs )
+{
+   m_ulLineTimeout = ulTimeoutMs;
+}
+
+/**
+ * CScriptPacer::Start()
+ *
+ * Finds the targets matching sEntry, which get their first line
+ * from the first Step(). Returns the number of targets.
+ */
+
+int CScriptPacer::Start( const std::vector<std::string>& vecLines, const std::string& sEntry, 
+                         bool bTab, bool bParse )
+{
+   m_vecLines = vecLines;
+   m_bTab = bTab;
+   m_bParse = bParse;
+
+   m_vecTargets.clear();
+   m_mapTargets.clear();
+   m_iTimeouts = 0;
+
+   std::vector<WINDOWINFO> vecWindows;
+   m_pEngine->FindWindows( sEntry, vecWindows );
+
+   m_vecTargets.resize( vecWindows.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      TARGET& target = m_vecTargets[iLoop];
+      target.window = vecWindows[iLoop];
+      target.iIndex = (int) iLoop;
+      target.bWatched = true;
+      target.iNextLine = 0;
+      target.dSentMs = 0;
+      target.bPrompt = false;
+
+      m_mapTargets[target.window.id] = iLoop;
+   }
+
+   m_iRemaining = vecLines.empty() ? 0 : m_vecTargets.size();
+
+   return (int) m_vecTargets.size();
+}
+
+/**
+ * CScriptPacer::GetTargets()
+ */
+
+void CScriptPacer::GetTargets( std::vector<WINDOWINFO>& vecWindows ) const
+{
+   vecWindows.clear();
+   vecWindows.reserve( m_vecTargets.size() );
+
+   for ( size_t iLoop = 0; iLoop < m_vecTargets.size(); iLoop++ )
+   {
+      vecWindows.push_back( m_vecTargets[iLoop].window );
+   }
+}
+
+/**
+ * CScriptPacer::SetWatched()
+ *
+ * Targets are watched by default; one whose output cannot be read
+ * gets its lines back to back
+ */
+
+void CScriptPacer::SetWatched( WINDOWID id, bool bWatched )
+{
+   std::unordered_map<WINDOWID, size_t>::iterator it = m_mapTargets.find( id );
+
+   if ( it != m_mapTargets.end() )
+   {
+      m_vecTargets[it->second].bWatched = bWatched;
+   }
+}
+
+/**
+ * CScriptPacer::Output()
+ */
+
+void CScriptPacer::Output( WINDOWID id, const char* pData, size_t iLength )
+{
+   std::unordered_map<WINDOWID, size_t>::iterator it = m_mapTargets.find( id );
+
+   if ( it == m_mapTargets.end() )
+   {
+      return;
+   }
+
+   TARGET& target = m_vecTargets[it->second];
+
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      unsigned char chChar = (unsigned char) pData[iLoop];
+
+      if ( !target.tfFilter.Put(chChar) )
+      {
+         continue;
+      }
+
+      if ( chChar == '\n' )
+      {
+         target.sLastLine.clear();
+         target.bPrompt = false;
+      }
+      else
+      {
+         target.sLastLine += (char) chChar;
+      }
+   }
+
+   if ( target.sLastLine.size() > SCRIPT_MAX_LAST_LINE )
+   {
+      target.sLastLine.erase( 0, target.sLastLine.size() - SCRIPT_MAX_LAST_LINE );
+   }
+
+   if ( m_pPrompt && !target.sLastLine.empty() )
+   {
+      target.bPrompt = std::regex_search( target.sLastLine, *m_pPrompt );
+   }
+}
+
+/**
+ * CScriptPacer::IsReady()
+ */
+
+bool CScriptPacer::IsReady( const TARGET& target, double dNowMs ) const
+{
+   if ( target.iNextLine >= m_vecLines.size() )
+   {
+      return false;
+   }
+
+   return (target.iNextLine == 0) || !target.bWatched || !m_pPrompt || target.bPrompt || 
+      (dNowMs - target.dSentMs >= m_ulLineTimeout);
+}
+
+/**
+ * CScriptPacer::SendLine()
+ */
+
+void CScriptPacer::SendLine( TARGET& target )
+{
+   std::vector<std::string> vecBuffers( 1, m_vecLines[target.iNextLine++] );
+
+   target.sLastLine.clear();
+   target.bPrompt = false;
+
+   m_pEngine->SendWindow( target.window, target.iIndex, vecBuffers, m_bTab, m_bParse );
+
+   target.dSentMs = GetMilliseconds();
+
+   if ( target.iNextLine == m_vecLines.size() )
+   {
+      m_iRemaining--;
+   }
+}
+
+/**
+ * CScriptPacer::Step()
+ *
+ * Sends the next line to every target that is ready for it.
+ * Returns the number of lines sent.
+ */
+
+int CScriptPacer::Step()
+{
+   int iSent = 0;
+
+   for ( size_t iLoop = 0; iLoop < m_vecTargets.size(); iLoop++ )
+   {
+      TARGET& target = m_vecTargets[iLoop];
+
+      double dNowMs = GetMilliseconds();
+
+      if ( !IsReady(target, dNowMs) )
+      {
+         continue;
+      }
+
+      if ( (target.iNextLine > 0) && target.bWatched && m_pPrompt && !target.bPrompt )
+      {
+         m_iTimeouts++;
+      }
+
+      SendLine( target );
+
+      iSent++;
+   }
+
+   return iSent;
+}
+
+/**
+ * CScriptPacer::Run()
+ *
+ * Steps until every target got the whole script. fnPoll waits up
+ * to the time given for output and passes it to Output().
+ */
+
+void CScriptPacer::Run( const PollFunction& fnPoll )
+{
+   while ( !IsFinished() )
+   {
+      if ( Step() > 0 )
+      {
+         continue;
+      }
+
+      // Sleep until output arrives or the next line times out
+
+      double dNowMs = GetMilliseconds();
+      double dWaitMs = SCRIPT_MAX_POLL_MS;
+
+      for ( size_t iLoop = 0; iLoop < m_vecTargets.size(); iLoop++ )
+      {
+         const TARGET& target = m_vecTargets[iLoop];
+
+         if ( target.iNextLine < m_vecLines.size() )
+         {
+            dWaitMs = std::min( dWaitMs, target.dSentMs + m_ulLineTimeout - dNowMs );
+         }
+      }
+
+      fnPoll( std::max(0, (int) dWaitMs + 1) );
+   }
+}
+
+/**
+ * CScriptPacer::IsFinished()
+ */
+
+bool CScriptPacer::IsFinished() const
+{
+   return m_iRemaining == 0;
+}
+
+/**
+ * CScriptPacer::GetTimeouts()
+ *
+ * Lines sent because the prompt did not show in time
+ */
+
+size_t CScriptPacer::GetTimeouts() const
+{
+   return m_iTimeouts;
+}
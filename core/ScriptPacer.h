@@ -0,0 +1,132 @@
+/**
+ * ScriptPacer.h - PuTTYCS prompt paced scripts
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SCRIPTPACER_H__INCLUDED_)
+#define SCRIPTPACER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <functional>
+#include <memory>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "TerminalFilter.h"
+
+/**
+ * CScriptPacer
+ *
+ * Sends a script a line at a time, each target getting its next
+ * line as soon as its output shows the prompt again, or when the
+ * line timeout expires. Fast commands do not wait for padded
+ * delays, and slow ones do not get the rest of the script typed
+ * into their input. Targets progress independently.
+ *
+ * The prompt is a regular expression (ECMAScript) searched for in
+ * the last line of a target's output since its last line was sent,
+ * terminal escape sequences removed. Output is fed to Output() by
+ * whatever reads it, from within the poll function given to Run().
+ * Targets without output to watch get their lines without waiting.
+ */
+
+class CScriptPacer
+{
+public:
+
+   typedef std::function<void( int iTimeoutMs )> PollFunction;
+
+   CScriptPacer( CBroadcastEngine* pEngine );
+   virtual ~CScriptPacer();
+
+   bool SetPrompt( const std::string& sPattern );
+   void SetLineTimeout( unsigned long ulTimeoutMs );
+
+   int Start( const std::vector<std::string>& vecLines, const std::string& sEntry, 
+              bool bTab, bool bParse );
+
+   void GetTargets( std::vector<WINDOWINFO>& vecWindows ) const;
+   void SetWatched( WINDOWID id, bool bWatched );
+
+   void Output( WINDOWID id, const char* pData, size_t iLength );
+
+   int Step();
+   void Run( const PollFunction& fnPoll );
+
+   bool IsFinished() const;
+   size_t GetTimeouts() const;
+
+   static bool IsValidPrompt( const std::string& sPattern );
+
+protected:
+
+   struct TARGET
+   {
+      WINDOWINFO window;
+      int iIndex;
+
+      bool bWatched;
+
+      size_t iNextLine;
+      double dSentMs;
+
+      CTerminalFilter tfFilter;
+      std::string sLastLine;
+      bool bPrompt;
+   };
+
+   bool IsReady( const TARGET& target, double dNowMs ) const;
+   void SendLine( TARGET& target );
+
+   static double GetMilliseconds();
+
+   CBroadcastEngine* m_pEngine;
+
+   std::unique_ptr<std::regex> m_pPrompt;
+   unsigned long m_ulLineTimeout;
+
+   std::vector<std::string> m_vecLines;
+   bool m_bTab;
+   bool m_bParse;
+
+   std::vector<TARGET> m_vecTargets;
+   std::unordered_map<WINDOWID, size_t> m_mapTargets;
+
+   size_t m_iRemaining;
+   size_t m_iTimeouts;
+};
+
+#endif // !defined(SCRIPTPACER_H__INCLUDED_)
@@ -0,0 +1,299 @@
+/**
+ * SendQueue.cpp - PuTTYCS bounded send queue
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SendQueue.h"
+#include "KeyProgram.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * CSendQueue::CSendQueue()
+ */
+
+CSendQueue::CSendQueue( size_t iCapacity )
+{
+   m_iCapacity = (iCapacity > 0) ? iCapacity : 1;
+   m_iPending = 0;
+
+   m_ulCoalesced = 0;
+   m_ulRejected = 0;
+}
+
+/**
+ * CSendQueue::SetCapacity()
+ */
+
+void CSendQueue::SetCapacity( size_t iCapacity )
+{
+   m_iCapacity = (iCapacity > 0) ? iCapacity : 1;
+}
+
+/**
+ * CSendQueue::GetCapacity()
+ */
+
+size_t CSendQueue::GetCapacity() const
+{
+   return m_iCapacity;
+}
+
+/**
+ * CSendQueue::Push()
+ *
+ * Returns false, and drops the request, when the queue is saturated
+ */
+
+bool CSendQueue::Push( const std::string& sBuffer, const std::string& sEntry, 
+                       bool bTab, bool bParse, int iSendCR )
+{
+   if ( IsSaturated() )
+   {
+      m_ulRejected++;
+
+      return false;
+   }
+
+   m_iPending++;
+
+   if ( !m_dqJobs.empty() && (sBuffer.size() <= SMALL_BUFFER) )
+   {
+      SENDJOB& last = m_dqJobs.back();
+
+      if ( (last.sEntry == sEntry) && (last.bTab == bTab) && 
+           (last.bParse == bParse) && (last.iSendCR == iSendCR) )
+      {
+         size_t iBytes = 0;
+
+         for ( size_t iLoop = 0; iLoop < last.vecBuffers.size(); iLoop++ )
+         {
+            iBytes += last.vecBuffers[iLoop].size();
+         }
+
+         if ( iBytes + sBuffer.size() <= MAX_JOB_BYTES )
+         {
+            // Parsed buffers each end in Enter or Tab, so only raw keys repeat
+
+            if ( bParse || !MergeRepeat(last.vecBuffers.back(), sBuffer) )
+            {
+               last.vecBuffers.push_back( sBuffer );
+            }
+
+            last.iRequests++;
+
+            m_ulCoalesced++;
+
+            return true;
+         }
+      }
+   }
+
+   SENDJOB job;
+   job.sEntry = sEntry;
+   job.vecBuffers.push_back( sBuffer );
+   job.bTab = bTab;
+   job.bParse = bParse;
+   job.iSendCR = iSendCR;
+   job.iRequests = 1;
+
+   m_dqJobs.push_back( job );
+
+   return true;
+}
+
+/**
+ * CSendQueue::Pop()
+ */
+
+bool CSendQueue::Pop( SENDJOB& job )
+{
+   if ( m_dqJobs.empty() )
+   {
+      return false;
+   }
+
+   job.sEntry.swap( m_dqJobs.front().sEntry );
+   job.vecBuffers.swap( m_dqJobs.front().vecBuffers );
+   job.bTab = m_dqJobs.front().bTab;
+   job.bParse = m_dqJobs.front().bParse;
+   job.iSendCR = m_dqJobs.front().iSendCR;
+   job.iRequests = m_dqJobs.front().iRequests;
+
+   m_dqJobs.pop_front();
+
+   m_iPending -= job.iRequests;
+
+   return true;
+}
+
+/**
+ * CSendQueue::Clear()
+ */
+
+void CSendQueue::Clear()
+{
+   m_dqJobs.clear();
+
+   m_iPending = 0;
+}
+
+/**
+ * CSendQueue::IsEmpty()
+ */
+
+bool CSendQueue::IsEmpty() const
+{
+   return m_dqJobs.empty();
+}
+
+/**
+ * CSendQueue::IsSaturated()
+ */
+
+bool CSendQueue::IsSaturated() const
+{
+   return m_iPending >= m_iCapacity;
+}
+
+/**
+ * CSendQueue::GetPending()
+ *
+ * Requests accepted and not popped yet
+ */
+
+size_t CSendQueue::GetPending() const
+{
+   return m_iPending;
+}
+
+/**
+ * CSendQueue::GetJobs()
+ *
+ * Fan-outs the pending requests still cost
+ */
+
+size_t CSendQueue::GetJobs() const
+{
+   return m_dqJobs.size();
+}
+
+/**
+ * CSendQueue::GetCoalesced()
+ */
+
+unsigned long CSendQueue::GetCoalesced() const
+{
+   return m_ulCoalesced;
+}
+
+/**
+ * CSendQueue::GetRejected()
+ */
+
+unsigned long CSendQueue::GetRejected() const
+{
+   return m_ulRejected;
+}
+
+/**
+ * CSendQueue::MergeRepeat()
+ *
+ * Folds sNext into sKeys when both are the same named key, with the
+ * {NAME n} repeat count CSendKeys and CKeyProgram understand
+ */
+
+bool CSendQueue::MergeRepeat( std::string& sKeys, const std::string& sNext )
+{
+   std::string sName;
+   std::string sNextName;
+
+   unsigned int uiCount = 0;
+   unsigned int uiNextCount = 0;
+
+   if ( !ParseRepeat(sKeys, sName, uiCount) || !ParseRepeat(sNext, sNextName, uiNextCount) || 
+        (sName != sNextName) )
+   {
+      return false;
+   }
+
+   char szCount[16];
+   snprintf( szCount, sizeof(szCount), " %u", uiCount + uiNextCount );
+
+   sKeys = "{" + sName + szCount + "}";
+
+   return true;
+}
+
+/**
+ * CSendQueue::ParseRepeat()
+ *
+ * sKeys is a single {NAME} or {NAME n}, where NAME is a key name
+ */
+
+bool CSendQueue::ParseRepeat( const std::string& sKeys, std::string& sName, unsigned int& uiCount )
+{
+   if ( (sKeys.size() < 3) || (sKeys[0] != '{') || (sKeys[sKeys.size() - 1] != '}') )
+   {
+      return false;
+   }
+
+   std::string sInner = sKeys.substr( 1, sKeys.size() - 2 );
+
+   if ( sInner.find_first_of("{}") != std::string::npos )
+   {
+      return false;
+   }
+
+   size_t iSpace = sInner.find( ' ' );
+
+   sName = sInner.substr( 0, iSpace );
+   uiCount = 1;
+
+   if ( iSpace != std::string::npos )
+   {
+      const char* pszCount = sInner.c_str() + iSpace + 1;
+      char* pszEnd = NULL;
+
+      unsigned long ulCount = strtoul( pszCount, &pszEnd, 10 );
+
+      if ( (pszEnd == pszCount) || (*pszEnd != '\0') || (ulCount == 0) || (ulCount > 9999) )
+      {
+         return false;
+      }
+
+      uiCount = (unsigned int) ulCount;
+   }
+
+   bool bNormalKey = false;
+
+   return CKeyProgram::LookupKeyName( sName, bNormalKey ) != -1;
+}
@@ -0,0 +1,117 @@
+/**
+ * SendQueue.h - PuTTYCS bounded send queue header
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SENDQUEUE_H__INCLUDED_)
+#define SENDQUEUE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * One fan-out: the buffers are typed into each window of sEntry in
+ * a single activation
+ */
+
+struct SENDJOB
+{
+   std::string sEntry;
+
+   std::vector<std::string> vecBuffers;
+
+   bool bTab;
+   bool bParse;
+   int iSendCR;
+
+   size_t iRequests;
+};
+
+/**
+ * CSendQueue
+ *
+ * Sends waiting for the sender, bounded to a number of requests so
+ * fast clicking cannot buffer seconds of input. A request for the
+ * same filter and flags as the last waiting job joins that job
+ * instead of costing another fan-out: {UP}{UP}{UP} becomes {UP 3},
+ * other small buffers are typed after it in the same activation.
+ * Only the UI thread uses it.
+ */
+
+class CSendQueue
+{
+public:
+
+   enum
+   {
+      SMALL_BUFFER = 256,
+      MAX_JOB_BYTES = 4096
+   };
+
+   CSendQueue( size_t iCapacity = 16 );
+
+   void SetCapacity( size_t iCapacity );
+   size_t GetCapacity() const;
+
+   bool Push( const std::string& sBuffer, const std::string& sEntry, 
+              bool bTab, bool bParse, int iSendCR );
+   bool Pop( SENDJOB& job );
+   void Clear();
+
+   bool IsEmpty() const;
+   bool IsSaturated() const;
+
+   size_t GetPending() const;
+   size_t GetJobs() const;
+
+   unsigned long GetCoalesced() const;
+   unsigned long GetRejected() const;
+
+   static bool MergeRepeat( std::string& sKeys, const std::string& sNext );
+
+protected:
+
+   static bool ParseRepeat( const std::string& sKeys, std::string& sName, unsigned int& uiCount );
+
+   std::deque<SENDJOB> m_dqJobs;
+
+   size_t m_iCapacity;
+   size_t m_iPending;
+
+   unsigned long m_ulCoalesced;
+   unsigned long m_ulRejected;
+};
+
+#endif // !defined(SENDQUEUE_H__INCLUDED_)
@@ -0,0 +1,273 @@
+/**
+ * SendTemplate.cpp - PuTTYCS command escaping and expansion
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SendTemplate.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HostInventory.h"
+
+static const char TOKEN_INC[] = "{%INC%}";
+static const char TOKEN_CTRL[] = "{%CTRL%}";
+static const char TOKEN_VAR_BEGIN[] = "{%VAR:";
+static const char TOKEN_VAR_END[] = "%}";
+
+static const char TOKEN_CHAR_INC = 0x01;
+static const char TOKEN_CHAR_CTRL = 0x02;
+static const char TOKEN_CHAR_VAR = 0x03;
+
+static const char SENDKEY_DELAY_0[] = "{DELAY=0}";
+
+static const char SENDKEY_BUTTON_CTRL[] = "^";
+static const char SENDKEY_BUTTON_CAPSLOCK[] = "{CAPSLOCK}";
+static const char SENDKEY_BUTTON_TAB[] = "{TAB}";
+static const char SENDKEY_BUTTON_ENTER[] = "^m";
+
+/**
+ * Appends a character, escaped if SendKeys would take it as a key
+ */
+
+static void AppendEscaped( std::string& sOutput, char chChar )
+{
+   switch ( chChar )
+   {
+   case '+': sOutput += "{PLUS}"; break;
+   case '@': sOutput += "{AT}"; break;
+   case '^': sOutput += "{CARET}"; break;
+   case '~': sOutput += "{TILDE}"; break;
+   case '(': sOutput += "{LEFTPAREN}"; break;
+   case ')': sOutput += "{RIGHTPAREN}"; break;
+   case '{': sOutput += "{LEFTBRACE}"; break;
+   case '}': sOutput += "{RIGHTBRACE}"; break;
+   case '%': sOutput += "{PERCENT}"; break;
+   default: sOutput += chChar; break;
+   }
+}
+
+/**
+ * The length of the variable name of a {%VAR:name%} token at psz,
+ * 0 if there is no valid token
+ */
+
+static size_t GetVariableName( const char* psz )
+{
+   if ( strncmp(psz, TOKEN_VAR_BEGIN, sizeof(TOKEN_VAR_BEGIN) - 1) != 0 )
+   {
+      return 0;
+   }
+
+   psz += sizeof(TOKEN_VAR_BEGIN) - 1;
+
+   size_t iLength = 0;
+
+   while ( ((psz[iLength] >= 'a') && (psz[iLength] <= 'z')) ||
+           ((psz[iLength] >= 'A') && (psz[iLength] <= 'Z')) ||
+           ((psz[iLength] >= '0') && (psz[iLength] <= '9')) ||
+           (psz[iLength] == '_') || (psz[iLength] == '-') || (psz[iLength] == '.') )
+   {
+      iLength++;
+   }
+
+   if ( strncmp(psz + iLength, TOKEN_VAR_END, sizeof(TOKEN_VAR_END) - 1) != 0 )
+   {
+      return 0;
+   }
+
+   return iLength;
+}
+
+/**
+ * CSendTemplate::Escape()
+ *
+ * {%VAR:name%} becomes the name between two placeholders
+ */
+
+std::string CSendTemplate::Escape( const std::string& sBuffer, bool bParse )
+{
+   if ( !bParse )
+   {
+      return sBuffer;
+   }
+
+   std::string sInput = sBuffer;
+
+   Replace( sInput, TOKEN_INC, std::string(1, TOKEN_CHAR_INC) );
+   Replace( sInput, TOKEN_CTRL, std::string(1, TOKEN_CHAR_CTRL) );
+
+   std::string sOutput;
+   sOutput.reserve( sInput.size() + 16 );
+
+   for ( size_t iLoop = 0; iLoop < sInput.size(); iLoop++ )
+   {
+      size_t iName = (sInput[iLoop] == '{') ? GetVariableName( sInput.c_str() + iLoop ) : 0;
+
+      if ( iName )
+      {
+         sOutput += TOKEN_CHAR_VAR;
+         sOutput.append( sInput, iLoop + sizeof(TOKEN_VAR_BEGIN) - 1, iName );
+         sOutput += TOKEN_CHAR_VAR;
+
+         iLoop += sizeof(TOKEN_VAR_BEGIN) - 1 + iName + sizeof(TOKEN_VAR_END) - 2;
+         continue;
+      }
+
+      AppendEscaped( sOutput, sInput[iLoop] );
+   }
+
+   return sOutput;
+}
+
+/**
+ * CSendTemplate::Expand()
+ *
+ * Builds the keystrokes for the window at iIndex (0 based). The
+ * variables are taken from row iRow of pInventory, a variable it
+ * does not hold is left out.
+ */
+
+std::string CSendTemplate::Expand( const std::string& sOutput, int iIndex,
+                                   bool bTab, bool bParse, bool bSendCR, bool bCapsLock,
+                                   const CHostInventory* pInventory, int iRow )
+{
+   char szInc[16];
+   snprintf( szInc, sizeof(szInc), "%d", iIndex + 1 );
+
+   std::string sTemp = SENDKEY_DELAY_0;
+   sTemp += sOutput;
+
+   Replace( sTemp, std::string(1, TOKEN_CHAR_INC), szInc );
+
+   if ( HasVariables(sTemp) )
+   {
+      ExpandVariables( sTemp, pInventory, iRow );
+   }
+
+   if ( bParse )
+   {
+      Replace( sTemp, std::string(1, TOKEN_CHAR_CTRL), SENDKEY_BUTTON_CTRL );
+
+      if ( bCapsLock )
+      {
+         sTemp.insert( 0, SENDKEY_BUTTON_CAPSLOCK );
+         sTemp += SENDKEY_BUTTON_CAPSLOCK;
+      }
+
+      if ( bTab )
+      {
+         sTemp += SENDKEY_BUTTON_TAB;
+      }
+      else if ( bSendCR )
+      {
+         sTemp += SENDKEY_BUTTON_ENTER;
+      }
+   }
+
+   return sTemp;
+}
+
+/**
+ * CSendTemplate::HasVariables()
+ *
+ * Whether an escaped buffer holds {%VAR:name%} tokens
+ */
+
+bool CSendTemplate::HasVariables( const std::string& sOutput )
+{
+   return sOutput.find( TOKEN_CHAR_VAR ) != std::string::npos;
+}
+
+/**
+ * CSendTemplate::ExpandVariables()
+ */
+
+void CSendTemplate::ExpandVariables( std::string& sText, const CHostInventory* pInventory, int iRow )
+{
+   std::string sExpanded;
+   sExpanded.reserve( sText.size() + 16 );
+
+   std::string sName;
+   std::string sValue;
+
+   size_t iPos = 0;
+   size_t iToken;
+
+   while ( (iToken = sText.find(TOKEN_CHAR_VAR, iPos)) != std::string::npos )
+   {
+      size_t iEnd = sText.find( TOKEN_CHAR_VAR, iToken + 1 );
+
+      if ( iEnd == std::string::npos )
+      {
+         break;
+      }
+
+      sExpanded.append( sText, iPos, iToken - iPos );
+
+      sName.assign( sText, iToken + 1, iEnd - iToken - 1 );
+
+      if ( pInventory && pInventory->GetValue(iRow, sName, sValue) )
+      {
+         for ( size_t iLoop = 0; iLoop < sValue.size(); iLoop++ )
+         {
+            AppendEscaped( sExpanded, sValue[iLoop] );
+         }
+      }
+
+      iPos = iEnd + 1;
+   }
+
+   sExpanded.append( sText, iPos, std::string::npos );
+
+   sText.swap( sExpanded );
+}
+
+/**
+ * CSendTemplate::Replace()
+ */
+
+void CSendTemplate::Replace( std::string& sText, const std::string& sFind, 
+                             const std::string& sReplace )
+{
+   if ( sFind.empty() )
+   {
+      return;
+   }
+
+   size_t iPos = 0;
+
+   while ( (iPos = sText.find(sFind, iPos)) != std::string::npos )
+   {
+      sText.replace( iPos, sFind.size(), sReplace );
+
+      iPos += sReplace.size();
+   }
+}
@@ -0,0 +1,77 @@
+/**
+ * SendTemplate.h - PuTTYCS command escaping and expansion
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SENDTEMPLATE_H__INCLUDED_)
+#define SENDTEMPLATE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+
+#include <string>
+
+class CHostInventory;
+
+/**
+ * CSendTemplate
+ *
+ * Turns a typed command into SendKeys input. Escape() runs once per
+ * command: it escapes the SendKeys special characters and replaces
+ * the {%INC%}, {%CTRL%} and {%VAR:name%} tokens by single character
+ * placeholders. Expand() runs once per window and fills the
+ * placeholders in, the variables from the window's row of a
+ * CHostInventory.
+ */
+
+class CSendTemplate
+{
+public:
+
+   static std::string Escape( const std::string& sBuffer, bool bParse );
+
+   static std::string Expand( const std::string& sOutput, int iIndex,
+                              bool bTab, bool bParse, bool bSendCR, bool bCapsLock,
+                              const CHostInventory* pInventory = NULL, int iRow = -1 );
+
+   static bool HasVariables( const std::string& sOutput );
+
+   static void Replace( std::string& sText, const std::string& sFind, 
+                        const std::string& sReplace );
+
+protected:
+
+   static void ExpandVariables( std::string& sText, const CHostInventory* pInventory, int iRow );
+};
+
+#endif // !defined(SENDTEMPLATE_H__INCLUDED_)
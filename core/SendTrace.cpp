@@ -0,0 +1,434 @@
+/**
+ * SendTrace.cpp - PuTTYCS send pipeline instrumentation
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SendTrace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * CSendTrace::CSendTrace()
+ */
+
+CSendTrace::CSendTrace()
+{
+   m_tpStart = std::chrono::steady_clock::now();
+
+   m_ullNext = 0;
+
+   m_pSlots = new TRACESLOT[TRACE_CAPACITY];
+
+   for ( int iLoop = 0; iLoop < TRACE_CAPACITY; iLoop++ )
+   {
+      m_pSlots[iLoop].ullSequence = 0;
+   }
+}
+
+/**
+ * CSendTrace::~CSendTrace()
+ */
+
+CSendTrace::~CSendTrace()
+{
+   delete [] m_pSlots;
+}
+
+/**
+ * CSendTrace::Now()
+ *
+ * Microseconds since the trace was created
+ */
+
+long long CSendTrace::Now()
+{
+   return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - m_tpStart ).count();
+}
+
+/**
+ * CSendTrace::GetThreadId()
+ *
+ * Small sequential ids read better in trace viewers than
+ * native thread ids.
+ */
+
+unsigned int CSendTrace::GetThreadId()
+{
+   static std::atomic<unsigned int> uiNextThread( 1 );
+   static thread_local unsigned int uiThread = 0;
+
+   if ( uiThread == 0 )
+   {
+      uiThread = uiNextThread++;
+   }
+
+   return uiThread;
+}
+
+/**
+ * CSendTrace::Record()
+ *
+ * The slot sequence is cleared while the event is written and set to
+ * index + 1 afterwards, so readers can detect torn or stale slots.
+ */
+
+void CSendTrace::Record( const char* pszName, unsigned long long ullWindow,
+                         long long llStartUs, long long llEndUs )
+{
+   unsigned long long ullIndex = m_ullNext.fetch_add( 1, std::memory_order_relaxed );
+
+   TRACESLOT& slot = m_pSlots[ullIndex % TRACE_CAPACITY];
+
+   slot.ullSequence.store( 0, std::memory_order_relaxed );
+   std::atomic_thread_fence( std::memory_order_release );
+
+   slot.event.pszName = pszName;
+   slot.event.ullWindow = ullWindow;
+   slot.event.uiThread = GetThreadId();
+   slot.event.llStartUs = llStartUs;
+   slot.event.llDurationUs = llEndUs - llStartUs;
+
+   slot.ullSequence.store( ullIndex + 1, std::memory_order_release );
+}
+
+/**
+ * CSendTrace::Snapshot()
+ *
+ * Copies the retained spans, oldest first
+ */
+
+size_t CSendTrace::Snapshot( std::vector<TRACEEVENT>& vecEvents )
+{
+   vecEvents.clear();
+
+   unsigned long long ullEnd = m_ullNext.load( std::memory_order_acquire );
+   unsigned long long ullBegin = 
+      (ullEnd > TRACE_CAPACITY) ? (ullEnd - TRACE_CAPACITY) : 0;
+
+   vecEvents.reserve( (size_t) (ullEnd - ullBegin) );
+
+   for ( unsigned long long ullIndex = ullBegin; ullIndex < ullEnd; ullIndex++ )
+   {
+      TRACESLOT& slot = m_pSlots[ullIndex % TRACE_CAPACITY];
+
+      if ( slot.ullSequence.load(std::memory_order_acquire) != ullIndex + 1 )
+      {
+         continue;
+      }
+
+      TRACEEVENT event = slot.event;
+
+      std::atomic_thread_fence( std::memory_order_acquire );
+
+      if ( slot.ullSequence.load(std::memory_order_relaxed) == ullIndex + 1 )
+      {
+         vecEvents.push_back( event );
+      }
+   }
+
+   return vecEvents.size();
+}
+
+/**
+ * CSendTrace::SetWindowLabel()
+ */
+
+void CSendTrace::SetWindowLabel( unsigned long long ullWindow, const std::string& sLabel )
+{
+   m_mapLabels[ullWindow] = sLabel;
+}
+
+/**
+ * CSendTrace::AddWindowLatency()
+ */
+
+void CSendTrace::AddWindowLatency( unsigned long long ullWindow, long long llDurationUs )
+{
+   std::map<unsigned long long, LATENCYHISTOGRAM>::iterator it =
+      m_mapHistograms.find( ullWindow );
+
+   if ( it == m_mapHistograms.end() )
+   {
+      LATENCYHISTOGRAM histogram;
+      memset( &histogram, 0, sizeof(histogram) );
+
+      it = m_mapHistograms.insert( 
+         std::make_pair(ullWindow, histogram) ).first;
+   }
+
+   AddLatency( it->second, llDurationUs );
+}
+
+/**
+ * CSendTrace::AddLatency()
+ */
+
+void CSendTrace::AddLatency( LATENCYHISTOGRAM& histogram, long long llDurationUs )
+{
+   int iBucket = 0;
+
+   for ( long long llValue = llDurationUs; 
+         (llValue > 1) && (iBucket < TRACE_HISTOGRAM_BUCKETS - 1); llValue >>= 1 )
+   {
+      iBucket++;
+   }
+
+   histogram.aulBuckets[iBucket]++;
+   histogram.ulCount++;
+   histogram.dTotalUs += (double) llDurationUs;
+
+   if ( llDurationUs > histogram.dMaxUs )
+   {
+      histogram.dMaxUs = (double) llDurationUs;
+   }
+}
+
+/**
+ * CSendTrace::GetHistogram()
+ */
+
+bool CSendTrace::GetHistogram( unsigned long long ullWindow, LATENCYHISTOGRAM& histogram )
+{
+   std::map<unsigned long long, LATENCYHISTOGRAM>::const_iterator it =
+      m_mapHistograms.find( ullWindow );
+
+   if ( it == m_mapHistograms.end() )
+   {
+      return false;
+   }
+
+   histogram = it->second;
+
+   return true;
+}
+
+/**
+ * CSendTrace::GetPercentile()
+ *
+ * Returns the upper edge of the bucket holding the percentile
+ */
+
+double CSendTrace::GetPercentile( const LATENCYHISTOGRAM& histogram, double dPercentile )
+{
+   if ( histogram.ulCount == 0 )
+   {
+      return 0;
+   }
+
+   double dRank = (dPercentile / 100.0) * histogram.ulCount;
+   unsigned long ulSeen = 0;
+
+   for ( int iBucket = 0; iBucket < TRACE_HISTOGRAM_BUCKETS; iBucket++ )
+   {
+      ulSeen += histogram.aulBuckets[iBucket];
+
+      if ( ulSeen >= dRank )
+      {
+         double dEdge = (double) (2ULL << iBucket);
+
+         return (dEdge < histogram.dMaxUs) ? dEdge : histogram.dMaxUs;
+      }
+   }
+
+   return histogram.dMaxUs;
+}
+
+/**
+ * CSendTrace::AppendJsonString()
+ */
+
+void CSendTrace::AppendJsonString( std::string& sJson, const std::string& sValue )
+{
+   sJson += '"';
+
+   for ( size_t iLoop = 0; iLoop < sValue.size(); iLoop++ )
+   {
+      unsigned char chChar = (unsigned char) sValue[iLoop];
+
+      if ( (chChar == '"') || (chChar == '\\') )
+      {
+         sJson += '\\';
+         sJson += (char) chChar;
+      }
+      else if ( chChar < 0x20 )
+      {
+         char szEscape[8];
+         sprintf( szEscape, "\\u%04x", chChar );
+         sJson += szEscape;
+      }
+      else
+      {
+         sJson += (char) chChar;
+      }
+   }
+
+   sJson += '"';
+}
+
+/**
+ * CSendTrace::ExportChromeTrace()
+ *
+ * Complete ("X") events, one per span. Window labels are emitted as
+ * args, the per window histograms under "otherData".
+ */
+
+std::string CSendTrace::ExportChromeTrace()
+{
+   std::vector<TRACEEVENT> vecEvents;
+   Snapshot( vecEvents );
+
+   std::string sJson = "{\"traceEvents\":[";
+
+   char szBuffer[256];
+
+   for ( size_t iLoop = 0; iLoop < vecEvents.size(); iLoop++ )
+   {
+      const TRACEEVENT& event = vecEvents[iLoop];
+
+      if ( iLoop > 0 )
+      {
+         sJson += ',';
+      }
+
+      sJson += "\n{\"name\":";
+      AppendJsonString( sJson, event.pszName );
+
+      sprintf( szBuffer, 
+         ",\"cat\":\"send\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u",
+         event.llStartUs, event.llDurationUs, event.uiThread );
+
+      sJson += szBuffer;
+
+      if ( event.ullWindow )
+      {
+         sprintf( szBuffer, ",\"args\":{\"hwnd\":\"0x%llx\"", event.ullWindow );
+         sJson += szBuffer;
+
+         std::map<unsigned long long, std::string>::const_iterator it =
+            m_mapLabels.find( event.ullWindow );
+
+         if ( it != m_mapLabels.end() )
+         {
+            sJson += ",\"window\":";
+            AppendJsonString( sJson, it->second );
+         }
+
+         sJson += '}';
+      }
+
+      sJson += '}';
+   }
+
+   sJson += "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"windowLatencyUs\":[";
+
+   std::map<unsigned long long, LATENCYHISTOGRAM>::const_iterator it;
+
+   for ( it = m_mapHistograms.begin(); it != m_mapHistograms.end(); ++it )
+   {
+      const LATENCYHISTOGRAM& histogram = it->second;
+
+      if ( it != m_mapHistograms.begin() )
+      {
+         sJson += ',';
+      }
+
+      sprintf( szBuffer, "\n{\"hwnd\":\"0x%llx\",\"window\":", it->first );
+      sJson += szBuffer;
+
+      std::map<unsigned long long, std::string>::const_iterator itLabel =
+         m_mapLabels.find( it->first );
+
+      AppendJsonString( sJson, 
+         (itLabel != m_mapLabels.end()) ? itLabel->second : std::string() );
+
+      sprintf( szBuffer, 
+         ",\"count\":%lu,\"mean\":%.0f,\"p50\":%.0f,\"p90\":%.0f,\"p99\":%.0f,\"max\":%.0f,\"buckets\":[",
+         histogram.ulCount,
+         histogram.ulCount ? (histogram.dTotalUs / histogram.ulCount) : 0.0,
+         GetPercentile( histogram, 50 ),
+         GetPercentile( histogram, 90 ),
+         GetPercentile( histogram, 99 ),
+         histogram.dMaxUs );
+
+      sJson += szBuffer;
+
+      for ( int iBucket = 0; iBucket < TRACE_HISTOGRAM_BUCKETS; iBucket++ )
+      {
+         sprintf( szBuffer, (iBucket > 0) ? ",%lu" : "%lu", histogram.aulBuckets[iBucket] );
+         sJson += szBuffer;
+      }
+
+      sJson += "]}";
+   }
+
+   sJson += "\n]}}\n";
+
+   return sJson;
+}
+
+/**
+ * CSendTrace::ExportChromeTrace()
+ */
+
+bool CSendTrace::ExportChromeTrace( const char* pszPath )
+{
+   FILE* pFile = fopen( pszPath, "wb" );
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   std::string sJson = ExportChromeTrace();
+
+   bool bResult = 
+      (fwrite( sJson.data(), 1, sJson.size(), pFile ) == sJson.size());
+
+   return (fclose( pFile ) == 0) && bResult;
+}
+
+/**
+ * CSendTrace::Clear()
+ */
+
+void CSendTrace::Clear()
+{
+   for ( int iLoop = 0; iLoop < TRACE_CAPACITY; iLoop++ )
+   {
+      m_pSlots[iLoop].ullSequence = 0;
+   }
+
+   m_ullNext = 0;
+
+   m_mapLabels.clear();
+   m_mapHistograms.clear();
+}
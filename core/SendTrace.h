@@ -0,0 +1,183 @@
+/**
+ * SendTrace.h - PuTTYCS send pipeline instrumentation
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SENDTRACE_H__INCLUDED_)
+#define SENDTRACE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * One completed span. Names must be string literals, they are not
+ * copied.
+ */
+
+struct TRACEEVENT
+{
+   const char* pszName;
+
+   unsigned long long ullWindow;
+   unsigned int uiThread;
+
+   long long llStartUs;
+   long long llDurationUs;
+};
+
+/**
+ * Log2 latency histogram in microseconds. Bucket i holds samples in
+ * [2^i, 2^(i+1)) us, bucket 0 also holds samples below 1 us.
+ */
+
+#define TRACE_HISTOGRAM_BUCKETS 32
+
+struct LATENCYHISTOGRAM
+{
+   unsigned long ulCount;
+   unsigned long aulBuckets[TRACE_HISTOGRAM_BUCKETS];
+
+   double dTotalUs;
+   double dMaxUs;
+};
+
+/**
+ * CSendTrace
+ *
+ * Records spans of the send pipeline into a fixed size ring buffer
+ * and exports them as Chrome trace-event JSON (chrome://tracing,
+ * Perfetto). Writers claim a slot with one atomic increment and
+ * publish it with a per slot sequence number, so recording never
+ * blocks or allocates; the oldest spans are overwritten when full.
+ *
+ * Per window histograms are kept by the thread that calls
+ * AddWindowLatency() (the dialog thread).
+ */
+
+class CSendTrace
+{
+public:
+
+   enum
+   {
+      TRACE_CAPACITY = 8192
+   };
+
+   CSendTrace();
+   virtual ~CSendTrace();
+
+   long long Now();
+
+   void Record( const char* pszName, unsigned long long ullWindow,
+                long long llStartUs, long long llEndUs );
+
+   void SetWindowLabel( unsigned long long ullWindow, const std::string& sLabel );
+   void AddWindowLatency( unsigned long long ullWindow, long long llDurationUs );
+
+   bool GetHistogram( unsigned long long ullWindow, LATENCYHISTOGRAM& histogram );
+   static void AddLatency( LATENCYHISTOGRAM& histogram, long long llDurationUs );
+   static double GetPercentile( const LATENCYHISTOGRAM& histogram, double dPercentile );
+
+   size_t Snapshot( std::vector<TRACEEVENT>& vecEvents );
+
+   std::string ExportChromeTrace();
+   bool ExportChromeTrace( const char* pszPath );
+
+   void Clear();
+
+   static void AppendJsonString( std::string& sJson, const std::string& sValue );
+
+protected:
+
+   CSendTrace( const CSendTrace& );
+   CSendTrace& operator=( const CSendTrace& );
+
+   struct TRACESLOT
+   {
+      std::atomic<unsigned long long> ullSequence;
+      TRACEEVENT event;
+   };
+
+   static unsigned int GetThreadId();
+
+   std::chrono::steady_clock::time_point m_tpStart;
+
+   std::atomic<unsigned long long> m_ullNext;
+
+   TRACESLOT* m_pSlots;
+
+   std::map<unsigned long long, std::string> m_mapLabels;
+   std::map<unsigned long long, LATENCYHISTOGRAM> m_mapHistograms;
+};
+
+/**
+ * CTraceSpan
+ *
+ * Records the lifetime of a scope as one span.
+ */
+
+class CTraceSpan
+{
+public:
+
+   CTraceSpan( CSendTrace& trace, const char* pszName, 
+               unsigned long long ullWindow = 0 )
+      : m_trace( trace ), m_pszName( pszName ), m_ullWindow( ullWindow )
+   {
+      m_llStartUs = m_trace.Now();
+   }
+
+   ~CTraceSpan()
+   {
+      m_trace.Record( m_pszName, m_ullWindow, m_llStartUs, m_trace.Now() );
+   }
+
+   long long GetStart() 
+   {
+      return m_llStartUs;
+   }
+
+protected:
+
+   CSendTrace& m_trace;
+
+   const char* m_pszName;
+   unsigned long long m_ullWindow;
+   long long m_llStartUs;
+};
+
+#endif // !defined(SENDTRACE_H__INCLUDED_)
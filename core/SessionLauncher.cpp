@@ -0,0 +1,565 @@
+/**
+ * SessionLauncher.cpp - PuTTYCS bulk session launcher
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SessionLauncher.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "HostInventory.h"
+#include "SendTemplate.h"
+
+static const char LAUNCH_TOKEN_HOST[] = "{%HOST%}";
+
+/**
+ * How often starting processes are checked for their window
+ */
+
+static const double LAUNCH_POLL_MS = 25.0;
+
+/**
+ * CSessionLauncher::CSessionLauncher()
+ */
+
+CSessionLauncher::CSessionLauncher( CProcessSpawner* pSpawner, CBroadcastEngine* pEngine )
+{
+   m_pSpawner = pSpawner;
+   m_pEngine = pEngine;
+
+   m_sCommand = LAUNCH_TOKEN_HOST;
+   m_iConcurrency = 8;
+   m_dRate = 10.0;
+   m_ulWindowTimeout = 30000;
+
+   m_iNext = 0;
+   m_iDone = 0;
+
+   m_dStartMs = 0.0;
+   m_dNextSpawnMs = 0.0;
+   m_dEndMs = 0.0;
+}
+
+/**
+ * CSessionLauncher::~CSessionLauncher()
+ */
+
+CSessionLauncher::~CSessionLauncher()
+{
+   Cancel();
+}
+
+/**
+ * CSessionLauncher::SetCommand()
+ *
+ * {%HOST%} is replaced by the host name, which is appended if the
+ * command has no {%HOST%}
+ */
+
+void CSessionLauncher::SetCommand( const std::string& sCommand )
+{
+   m_sCommand = sCommand;
+}
+
+/**
+ * CSessionLauncher::SetConcurrency()
+ *
+ * The most processes starting at the same time
+ */
+
+void CSessionLauncher::SetConcurrency( int iConcurrency )
+{
+   m_iConcurrency = std::max( 1, iConcurrency );
+}
+
+/**
+ * CSessionLauncher::SetRate()
+ *
+ * The most processes spawned per second, 0 for no limit
+ */
+
+void CSessionLauncher::SetRate( double dRate )
+{
+   m_dRate = std::max( 0.0, dRate );
+}
+
+/**
+ * CSessionLauncher::SetWindowTimeout()
+ *
+ * How long to wait for the window of a process. Commands that have
+ * no window of their own, plink in a console for example, are done
+ * after it.
+ */
+
+void CSessionLauncher::SetWindowTimeout( unsigned long ulTimeoutMs )
+{
+   m_ulWindowTimeout = ulTimeoutMs;
+}
+
+/**
+ * CSessionLauncher::Start()
+ *
+ * Drops what is left of an earlier launch. Returns the number of
+ * hosts.
+ */
+
+int CSessionLauncher::Start( const std::vector<std::string>& vecHosts )
+{
+   Cancel();
+
+   m_vecResults.clear();
+   m_vecResults.reserve( vecHosts.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecHosts.size(); iLoop++ )
+   {
+      LAUNCHRESULT result;
+      result.sHost = vecHosts[iLoop];
+      result.sCommand = GetCommand( m_sCommand, vecHosts[iLoop] );
+      result.iState = LAUNCH_PENDING;
+      result.pid = 0;
+      result.id = 0;
+      result.dSpawnMs = 0.0;
+      result.dStartupMs = 0.0;
+
+      m_vecResults.push_back( result );
+   }
+
+   m_iNext = 0;
+   m_iDone = 0;
+
+   m_dStartMs = m_pSpawner->GetTime();
+   m_dNextSpawnMs = m_dStartMs;
+   m_dEndMs = m_dStartMs;
+
+   return (int) m_vecResults.size();
+}
+
+/**
+ * CSessionLauncher::Step()
+ *
+ * Checks the starting processes for their window, then spawns as
+ * many processes as the concurrency and the rate allow. Returns the
+ * number of hosts whose state changed.
+ */
+
+int CSessionLauncher::Step()
+{
+   size_t iDone = m_iDone;
+
+   double dNowMs = m_pSpawner->GetTime();
+
+   if ( !m_vecStarting.empty() )
+   {
+      Track( dNowMs );
+   }
+
+   int iStarted = 0;
+
+   while ( (m_iNext < m_vecResults.size()) && 
+           ((int) m_vecStarting.size() < m_iConcurrency) &&
+           (dNowMs >= m_dNextSpawnMs) )
+   {
+      LAUNCHRESULT& result = m_vecResults[m_iNext++];
+
+      if ( m_dRate > 0.0 )
+      {
+         m_dNextSpawnMs = std::max( m_dNextSpawnMs, dNowMs ) + 1000.0 / m_dRate;
+      }
+
+      if ( m_pSpawner->Spawn(result.sCommand, result.pid) )
+      {
+         dNowMs = m_pSpawner->GetTime();
+
+         result.iState = LAUNCH_STARTING;
+         result.dSpawnMs = dNowMs - m_dStartMs;
+
+         m_vecStarting.push_back( m_iNext - 1 );
+
+         iStarted++;
+      }
+      else
+      {
+         Finish( result, LAUNCH_FAILED );
+      }
+   }
+
+   if ( IsFinished() )
+   {
+      m_dEndMs = m_pSpawner->GetTime();
+   }
+
+   return iStarted + (int) (m_iDone - iDone);
+}
+
+/**
+ * CSessionLauncher::GetWait()
+ *
+ * The ms until Step() has something to do
+ */
+
+double CSessionLauncher::GetWait()
+{
+   if ( IsFinished() )
+   {
+      return 0.0;
+   }
+
+   double dNowMs = m_pSpawner->GetTime();
+   double dWaitMs = LAUNCH_POLL_MS;
+
+   if ( m_vecStarting.empty() )
+   {
+      dWaitMs = 1000.0;
+   }
+
+   if ( (m_iNext < m_vecResults.size()) && ((int) m_vecStarting.size() < m_iConcurrency) )
+   {
+      dWaitMs = std::min( dWaitMs, m_dNextSpawnMs - dNowMs );
+   }
+
+   return std::max( 0.0, dWaitMs );
+}
+
+/**
+ * CSessionLauncher::Run()
+ */
+
+void CSessionLauncher::Run()
+{
+   while ( !IsFinished() )
+   {
+      Step();
+
+      if ( !IsFinished() )
+      {
+         m_pSpawner->Wait( GetWait() );
+      }
+   }
+}
+
+/**
+ * CSessionLauncher::Cancel()
+ *
+ * Spawns no more processes. Those already spawned keep running,
+ * but are no longer waited for.
+ */
+
+void CSessionLauncher::Cancel()
+{
+   for ( size_t iLoop = 0; iLoop < m_vecStarting.size(); iLoop++ )
+   {
+      Finish( m_vecResults[m_vecStarting[iLoop]], LAUNCH_NO_WINDOW );
+   }
+
+   m_vecStarting.clear();
+
+   m_iNext = m_vecResults.size();
+
+   if ( !m_vecResults.empty() )
+   {
+      m_dEndMs = m_pSpawner->GetTime();
+   }
+}
+
+/**
+ * CSessionLauncher::IsFinished()
+ */
+
+bool CSessionLauncher::IsFinished() const
+{
+   return (m_iNext == m_vecResults.size()) && m_vecStarting.empty();
+}
+
+/**
+ * CSessionLauncher::GetCount()
+ *
+ * The number of hosts in a state
+ */
+
+size_t CSessionLauncher::GetCount( int iState ) const
+{
+   return std::count_if( m_vecResults.begin(), m_vecResults.end(),
+      [iState]( const LAUNCHRESULT& result ) { return result.iState == iState; } );
+}
+
+/**
+ * CSessionLauncher::GetResults()
+ */
+
+const std::vector<LAUNCHRESULT>& CSessionLauncher::GetResults() const
+{
+   return m_vecResults;
+}
+
+/**
+ * CSessionLauncher::GetSummary()
+ *
+ * One line: how many hosts got a window, how long it took, and the
+ * startup latencies
+ */
+
+std::string CSessionLauncher::GetSummary() const
+{
+   std::vector<double> vecStartup;
+
+   for ( size_t iLoop = 0; iLoop < m_vecResults.size(); iLoop++ )
+   {
+      if ( m_vecResults[iLoop].iState == LAUNCH_WINDOW )
+      {
+         vecStartup.push_back( m_vecResults[iLoop].dStartupMs );
+      }
+   }
+
+   std::sort( vecStartup.begin(), vecStartup.end() );
+
+   char szSummary[256];
+
+   int iLength = snprintf( szSummary, sizeof(szSummary), 
+      "%u hosts: %u windows, %u without window, %u exited, %u failed in %.1f s",
+      (unsigned int) m_vecResults.size(), (unsigned int) vecStartup.size(),
+      (unsigned int) GetCount(LAUNCH_NO_WINDOW), (unsigned int) GetCount(LAUNCH_EXITED), 
+      (unsigned int) GetCount(LAUNCH_FAILED), (m_dEndMs - m_dStartMs) / 1000.0 );
+
+   if ( !vecStartup.empty() && (iLength > 0) && (iLength < (int) sizeof(szSummary)) )
+   {
+      snprintf( szSummary + iLength, sizeof(szSummary) - iLength,
+         "; startup p50 %.0f ms, p90 %.0f ms, max %.0f ms",
+         vecStartup[(vecStartup.size() - 1) / 2], 
+         vecStartup[(vecStartup.size() - 1) * 9 / 10],
+         vecStartup.back() );
+   }
+
+   return szSummary;
+}
+
+/**
+ * CSessionLauncher::GetCommand()
+ */
+
+std::string CSessionLauncher::GetCommand( const std::string& sTemplate, const std::string& sHost )
+{
+   std::string sCommand = sTemplate;
+
+   if ( sCommand.find(LAUNCH_TOKEN_HOST) == std::string::npos )
+   {
+      if ( !sCommand.empty() )
+      {
+         sCommand += ' ';
+      }
+
+      sCommand += sHost;
+   }
+   else
+   {
+      CSendTemplate::Replace( sCommand, LAUNCH_TOKEN_HOST, sHost );
+   }
+
+   return sCommand;
+}
+
+/**
+ * CSessionLauncher::ReadHosts()
+ *
+ * Reads a host list or an inventory file (see GetHosts()). Returns
+ * false if it can not be read.
+ */
+
+bool CSessionLauncher::ReadHosts( const std::string& sPath, std::vector<std::string>& vecHosts )
+{
+#if defined(_WIN32)
+   // Paths are UTF-8, fopen() would take them as the ANSI code page
+
+   int iLength = ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, NULL, 0 );
+
+   std::wstring sWidePath( iLength > 0 ? iLength : 1, L'\0' );
+   ::MultiByteToWideChar( CP_UTF8, 0, sPath.c_str(), -1, &sWidePath[0], iLength );
+
+   FILE* pFile = _wfopen( sWidePath.c_str(), L"rb" );
+#else
+   FILE* pFile = fopen( sPath.c_str(), "rb" );
+#endif
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   std::string sContent;
+
+   char szBuffer[4096];
+   size_t iRead;
+
+   while ( (iRead = fread(szBuffer, 1, sizeof(szBuffer), pFile)) > 0 )
+   {
+      sContent.append( szBuffer, iRead );
+   }
+
+   bool bRead = !ferror( pFile );
+
+   fclose( pFile );
+
+   if ( bRead )
+   {
+      GetHosts( sContent, vecHosts );
+   }
+
+   return bRead;
+}
+
+/**
+ * CSessionLauncher::GetHosts()
+ *
+ * A host list has one host per line. A file whose first line holds
+ * a comma or a tab is an inventory (see CHostInventory), whose host
+ * names are taken. Blank lines and lines starting with # are
+ * skipped either way.
+ */
+
+void CSessionLauncher::GetHosts( const std::string& sContent, std::vector<std::string>& vecHosts )
+{
+   vecHosts.clear();
+
+   bool bFirst = true;
+
+   size_t iStart = 0;
+
+   while ( iStart < sContent.size() )
+   {
+      size_t iEnd = sContent.find( '\n', iStart );
+
+      if ( iEnd == std::string::npos )
+      {
+         iEnd = sContent.size();
+      }
+
+      std::string sLine = sContent.substr( iStart, iEnd - iStart );
+
+      iStart = iEnd + 1;
+
+      if ( bFirst && (sLine.compare(0, 3, "\xEF\xBB\xBF") == 0) )
+      {
+         sLine.erase( 0, 3 );
+      }
+
+      size_t iFirst = sLine.find_first_not_of( " \t\r" );
+
+      if ( (iFirst == std::string::npos) || (sLine[iFirst] == '#') )
+      {
+         continue;
+      }
+
+      if ( bFirst && (sLine.find_first_of(",\t", iFirst) != std::string::npos) )
+      {
+         CHostInventory hiInventory;
+         hiInventory.Load( sContent );
+         hiInventory.GetHosts( vecHosts );
+
+         return;
+      }
+
+      bFirst = false;
+
+      size_t iLast = sLine.find_last_not_of( " \t\r" );
+
+      vecHosts.push_back( sLine.substr(iFirst, iLast - iFirst + 1) );
+   }
+}
+
+/**
+ * CSessionLauncher::Track()
+ *
+ * Finds the windows of the starting processes, in one enumeration
+ */
+
+void CSessionLauncher::Track( double dNowMs )
+{
+   m_mapWindows.clear();
+
+   m_pSpawner->FindWindows( m_mapWindows );
+
+   size_t iKept = 0;
+
+   for ( size_t iLoop = 0; iLoop < m_vecStarting.size(); iLoop++ )
+   {
+      LAUNCHRESULT& result = m_vecResults[m_vecStarting[iLoop]];
+
+      std::unordered_map<PROCESSID, WINDOWID>::const_iterator it = m_mapWindows.find( result.pid );
+
+      if ( it != m_mapWindows.end() )
+      {
+         result.id = it->second;
+         result.dStartupMs = dNowMs - m_dStartMs - result.dSpawnMs;
+
+         if ( m_pEngine )
+         {
+            m_pEngine->SetWindowHost( result.id, result.sHost );
+         }
+
+         Finish( result, LAUNCH_WINDOW );
+      }
+      else if ( !m_pSpawner->IsRunning(result.pid) )
+      {
+         Finish( result, LAUNCH_EXITED );
+      }
+      else if ( dNowMs - m_dStartMs - result.dSpawnMs >= m_ulWindowTimeout )
+      {
+         Finish( result, LAUNCH_NO_WINDOW );
+      }
+      else
+      {
+         m_vecStarting[iKept++] = m_vecStarting[iLoop];
+      }
+   }
+
+   m_vecStarting.resize( iKept );
+}
+
+/**
+ * CSessionLauncher::Finish()
+ */
+
+void CSessionLauncher::Finish( LAUNCHRESULT& result, int iState )
+{
+   if ( result.iState == LAUNCH_STARTING )
+   {
+      m_pSpawner->Release( result.pid );
+   }
+
+   result.iState = iState;
+
+   m_iDone++;
+}
@@ -0,0 +1,148 @@
+/**
+ * SessionLauncher.h - PuTTYCS bulk session launcher
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SESSIONLAUNCHER_H__INCLUDED_)
+#define SESSIONLAUNCHER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "ProcessSpawner.h"
+
+/**
+ * What became of the session of one host. Times are in ms, the
+ * spawn time since Start().
+ */
+
+struct LAUNCHRESULT
+{
+   std::string sHost;
+   std::string sCommand;
+
+   int iState;
+
+   PROCESSID pid;
+   WINDOWID id;
+
+   double dSpawnMs;
+   double dStartupMs;
+};
+
+/**
+ * CSessionLauncher
+ *
+ * Opens a terminal session for each host of a list: runs a command
+ * such as putty -load "{%HOST%}" through a CProcessSpawner and waits
+ * for the window of each process. At most SetConcurrency() processes
+ * are starting at any time, and a new one is spawned at most
+ * SetRate() times a second, so a hundred sessions do not all fight
+ * for the CPU and the network at once. Each window found is given
+ * its host name in the broadcast engine, so filters match it by host
+ * before its title says where it is logged in.
+ *
+ * Start() takes the hosts and Step() does what is due; Run() steps
+ * until every host is done, waiting on the spawner's clock in
+ * between.
+ */
+
+class CSessionLauncher
+{
+public:
+
+   enum
+   {
+      LAUNCH_PENDING = 0,
+      LAUNCH_STARTING,
+      LAUNCH_WINDOW,
+      LAUNCH_NO_WINDOW,       // still running, no window within the timeout
+      LAUNCH_EXITED,          // exited before showing a window
+      LAUNCH_FAILED           // could not be spawned
+   };
+
+   CSessionLauncher( CProcessSpawner* pSpawner, CBroadcastEngine* pEngine = NULL );
+   virtual ~CSessionLauncher();
+
+   void SetCommand( const std::string& sCommand );
+   void SetConcurrency( int iConcurrency );
+   void SetRate( double dRate );
+   void SetWindowTimeout( unsigned long ulTimeoutMs );
+
+   int Start( const std::vector<std::string>& vecHosts );
+
+   int Step();
+   double GetWait();
+   void Run();
+
+   void Cancel();
+
+   bool IsFinished() const;
+   size_t GetCount( int iState ) const;
+   const std::vector<LAUNCHRESULT>& GetResults() const;
+
+   std::string GetSummary() const;
+
+   static std::string GetCommand( const std::string& sTemplate, const std::string& sHost );
+   static bool ReadHosts( const std::string& sPath, std::vector<std::string>& vecHosts );
+   static void GetHosts( const std::string& sContent, std::vector<std::string>& vecHosts );
+
+protected:
+
+   void Track( double dNowMs );
+   void Finish( LAUNCHRESULT& result, int iState );
+
+   CProcessSpawner* m_pSpawner;
+   CBroadcastEngine* m_pEngine;
+
+   std::string m_sCommand;
+   int m_iConcurrency;
+   double m_dRate;
+   unsigned long m_ulWindowTimeout;
+
+   std::vector<LAUNCHRESULT> m_vecResults;
+   std::vector<size_t> m_vecStarting;
+   std::unordered_map<PROCESSID, WINDOWID> m_mapWindows;
+
+   size_t m_iNext;
+   size_t m_iDone;
+
+   double m_dStartMs;
+   double m_dNextSpawnMs;
+   double m_dEndMs;
+};
+
+#endif // !defined(SESSIONLAUNCHER_H__INCLUDED_)
@@ -0,0 +1,282 @@
+/**
+ * SimProcessSpawner.cpp - PuTTYCS simulated process spawner
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SimProcessSpawner.h"
+
+#include <algorithm>
+
+static const WINDOWID SIM_SPAWN_WINDOW_BASE = 0x100000;
+
+/**
+ * CSimProcessSpawner::CSimProcessSpawner()
+ */
+
+CSimProcessSpawner::CSimProcessSpawner( CSimWindowSystem* pWindowSystem, unsigned int uiSeed ) : m_rng( uiSeed )
+{
+   m_pWindowSystem = pWindowSystem;
+
+   m_startup.dSpawnMs = 5.0;
+   m_startup.dWindowMs = 400.0;
+   m_startup.dJitter = 0.5;
+   m_startup.dFailure = 0.0;
+
+   m_sTitle = "PuTTY";
+
+   m_pidNext = 1000;
+   m_dTime = 0.0;
+
+   m_iMaxStarting = 0;
+}
+
+/**
+ * CSimProcessSpawner::~CSimProcessSpawner()
+ */
+
+CSimProcessSpawner::~CSimProcessSpawner()
+{
+}
+
+/**
+ * CSimProcessSpawner::SetStartup()
+ */
+
+void CSimProcessSpawner::SetStartup( const SIMSTARTUP& startup )
+{
+   m_startup = startup;
+}
+
+/**
+ * CSimProcessSpawner::GetStartup()
+ */
+
+const SIMSTARTUP& CSimProcessSpawner::GetStartup()
+{
+   return m_startup;
+}
+
+/**
+ * CSimProcessSpawner::SetTitle()
+ *
+ * The title of the windows to come
+ */
+
+void CSimProcessSpawner::SetTitle( const std::string& sTitle )
+{
+   m_sTitle = sTitle;
+}
+
+/**
+ * CSimProcessSpawner::GetSpawned()
+ */
+
+size_t CSimProcessSpawner::GetSpawned()
+{
+   return m_mapProcesses.size();
+}
+
+/**
+ * CSimProcessSpawner::GetMaxStarting()
+ *
+ * The most processes that were starting at the same time, spawned
+ * but neither released nor showing a window
+ */
+
+size_t CSimProcessSpawner::GetMaxStarting()
+{
+   return m_iMaxStarting;
+}
+
+/**
+ * CSimProcessSpawner::GetCommand()
+ */
+
+std::string CSimProcessSpawner::GetCommand( PROCESSID pid )
+{
+   SimProcessMap::iterator it = m_mapProcesses.find( pid );
+
+   return (it != m_mapProcesses.end()) ? it->second.sCommand : std::string();
+}
+
+/**
+ * CSimProcessSpawner::Spawn()
+ */
+
+bool CSimProcessSpawner::Spawn( const std::string& sCommand, PROCESSID& pid )
+{
+   m_dTime += Sample( m_startup.dSpawnMs, m_startup.dJitter );
+
+   std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+
+   SIMPROCESS process;
+   process.sCommand = sCommand;
+   process.dWindowAt = m_dTime + Sample( m_startup.dWindowMs, m_startup.dJitter );
+   process.bFails = distribution( m_rng ) < m_startup.dFailure;
+   process.bReleased = false;
+   process.id = 0;
+
+   pid = m_pidNext++;
+
+   m_mapProcesses[pid] = process;
+   m_vecActive.push_back( pid );
+
+   size_t iStarting = GetStarting();
+
+   if ( iStarting > m_iMaxStarting )
+   {
+      m_iMaxStarting = iStarting;
+   }
+
+   return true;
+}
+
+/**
+ * CSimProcessSpawner::IsRunning()
+ *
+ * A failing process exits when its window would have shown
+ */
+
+bool CSimProcessSpawner::IsRunning( PROCESSID pid )
+{
+   SimProcessMap::iterator it = m_mapProcesses.find( pid );
+
+   if ( it == m_mapProcesses.end() )
+   {
+      return false;
+   }
+
+   return !it->second.bFails || (m_dTime < it->second.dWindowAt);
+}
+
+/**
+ * CSimProcessSpawner::FindWindows()
+ *
+ * The windows of the processes not released
+ */
+
+void CSimProcessSpawner::FindWindows( std::unordered_map<PROCESSID, WINDOWID>& mapWindows )
+{
+   for ( size_t iLoop = 0; iLoop < m_vecActive.size(); iLoop++ )
+   {
+      SimProcessMap::iterator it = m_mapProcesses.find( m_vecActive[iLoop] );
+
+      SIMPROCESS& process = it->second;
+
+      if ( process.bFails || (m_dTime < process.dWindowAt) )
+      {
+         continue;
+      }
+
+      if ( process.id == 0 )
+      {
+         process.id = m_pWindowSystem ? 
+            m_pWindowSystem->AddWindow( m_sTitle ) : (SIM_SPAWN_WINDOW_BASE + it->first);
+      }
+
+      mapWindows[it->first] = process.id;
+   }
+}
+
+/**
+ * CSimProcessSpawner::Release()
+ */
+
+void CSimProcessSpawner::Release( PROCESSID pid )
+{
+   SimProcessMap::iterator it = m_mapProcesses.find( pid );
+
+   if ( (it == m_mapProcesses.end()) || it->second.bReleased )
+   {
+      return;
+   }
+
+   it->second.bReleased = true;
+
+   m_vecActive.erase( std::find(m_vecActive.begin(), m_vecActive.end(), pid) );
+}
+
+/**
+ * CSimProcessSpawner::GetTime()
+ */
+
+double CSimProcessSpawner::GetTime()
+{
+   return m_dTime;
+}
+
+/**
+ * CSimProcessSpawner::Wait()
+ */
+
+void CSimProcessSpawner::Wait( double dMs )
+{
+   if ( dMs > 0.0 )
+   {
+      m_dTime += dMs;
+   }
+}
+
+/**
+ * CSimProcessSpawner::Sample()
+ */
+
+double CSimProcessSpawner::Sample( double dMs, double dJitter )
+{
+   if ( dJitter <= 0.0 )
+   {
+      return dMs;
+   }
+
+   std::uniform_real_distribution<double> distribution( -dJitter, dJitter );
+
+   double dSample = dMs * (1.0 + distribution(m_rng));
+
+   return (dSample > 0.0) ? dSample : 0.0;
+}
+
+/**
+ * CSimProcessSpawner::GetStarting()
+ */
+
+size_t CSimProcessSpawner::GetStarting()
+{
+   size_t iStarting = 0;
+
+   for ( size_t iLoop = 0; iLoop < m_vecActive.size(); iLoop++ )
+   {
+      if ( m_mapProcesses[m_vecActive[iLoop]].id == 0 )
+      {
+         iStarting++;
+      }
+   }
+
+   return iStarting;
+}
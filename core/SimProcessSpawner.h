@@ -0,0 +1,135 @@
+/**
+ * SimProcessSpawner.h - PuTTYCS simulated process spawner
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SIMPROCESSSPAWNER_H__INCLUDED_)
+#define SIMPROCESSSPAWNER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ProcessSpawner.h"
+#include "SimWindowSystem.h"
+
+/**
+ * Startup latencies of a simulated process in ms. Every sample is
+ * varied by up to +/- dJitter (a fraction) of its value.
+ */
+
+struct SIMSTARTUP
+{
+   double dSpawnMs;           // spent in Spawn() itself
+   double dWindowMs;          // from the spawn to the window
+
+   double dJitter;
+   double dFailure;           // probability that the process exits without a window
+};
+
+/**
+ * CSimProcessSpawner
+ *
+ * Spawns no process, but has each command show a window after its
+ * startup latency on a virtual clock, so the session launcher can be
+ * run and timed without a desktop. The windows are added to a
+ * CSimWindowSystem if there is one, with the title a terminal shows
+ * before it logs in. Only processes not yet released are looked
+ * at, so polls cost the same however many were launched before.
+ * Random numbers come from a seeded generator,
+ * so runs repeat.
+ */
+
+class CSimProcessSpawner : public CProcessSpawner
+{
+public:
+
+   CSimProcessSpawner( CSimWindowSystem* pWindowSystem = NULL, unsigned int uiSeed = 1 );
+   virtual ~CSimProcessSpawner();
+
+   void SetStartup( const SIMSTARTUP& startup );
+   const SIMSTARTUP& GetStartup();
+
+   void SetTitle( const std::string& sTitle );
+
+   size_t GetSpawned();
+   size_t GetMaxStarting();
+   std::string GetCommand( PROCESSID pid );
+
+   virtual bool Spawn( const std::string& sCommand, PROCESSID& pid );
+   virtual bool IsRunning( PROCESSID pid );
+
+   virtual void FindWindows( std::unordered_map<PROCESSID, WINDOWID>& mapWindows );
+
+   virtual void Release( PROCESSID pid );
+
+   virtual double GetTime();
+   virtual void Wait( double dMs );
+
+protected:
+
+   struct SIMPROCESS
+   {
+      std::string sCommand;
+
+      double dWindowAt;
+      bool bFails;
+      bool bReleased;
+
+      WINDOWID id;
+   };
+
+   typedef std::map<PROCESSID, SIMPROCESS> SimProcessMap;
+
+   double Sample( double dMs, double dJitter );
+   size_t GetStarting();
+
+   CSimWindowSystem* m_pWindowSystem;
+
+   SimProcessMap m_mapProcesses;
+   std::vector<PROCESSID> m_vecActive;
+
+   SIMSTARTUP m_startup;
+   std::string m_sTitle;
+
+   PROCESSID m_pidNext;
+   double m_dTime;
+
+   size_t m_iMaxStarting;
+
+   std::mt19937 m_rng;
+};
+
+#endif // !defined(SIMPROCESSSPAWNER_H__INCLUDED_)
@@ -0,0 +1,625 @@
+/**
+ * SimWindowSystem.cpp - PuTTYCS simulated window system
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "SimWindowSystem.h"
+
+#include <ctype.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <thread>
+
+#include "KeyProgram.h"
+
+static const unsigned int SIM_VK_CAPITAL = 0x14;
+
+static const double SIM_TIMEOUT_FACTOR = 4.0;
+
+/**
+ * CSimWindowSystem::CSimWindowSystem()
+ */
+
+CSimWindowSystem::CSimWindowSystem( unsigned int uiSeed ) : m_rng( uiSeed )
+{
+   m_latency.dActivateMs = 2.0;
+   m_latency.dForegroundMs = 15.0;
+   m_latency.dKeyMs = 0.5;
+   m_latency.dIdleMs = 20.0;
+   m_latency.dJitter = 0.2;
+   m_latency.dFocusFailure = 0.0;
+
+   m_idNext = 1;
+   m_idForeground = 0;
+
+   m_bRealTime = false;
+   m_bCapsLock = false;
+
+   m_dElapsedMs = 0.0;
+}
+
+/**
+ * CSimWindowSystem::~CSimWindowSystem()
+ */
+
+CSimWindowSystem::~CSimWindowSystem()
+{
+}
+
+/**
+ * CSimWindowSystem::SetLatency()
+ *
+ * Latency of every window without its own
+ */
+
+void CSimWindowSystem::SetLatency( const SIMLATENCY& latency )
+{
+   m_latency = latency;
+}
+
+/**
+ * CSimWindowSystem::SetLatency()
+ */
+
+bool CSimWindowSystem::SetLatency( WINDOWID id, const SIMLATENCY& latency )
+{
+   SIMWINDOW* pWindow = GetWindow( id );
+
+   if ( !pWindow )
+   {
+      return false;
+   }
+
+   pWindow->bOwnLatency = true;
+   pWindow->latency = latency;
+
+   return true;
+}
+
+/**
+ * CSimWindowSystem::GetLatency()
+ */
+
+const SIMLATENCY& CSimWindowSystem::GetLatency()
+{
+   return m_latency;
+}
+
+/**
+ * CSimWindowSystem::GetLatency()
+ */
+
+const SIMLATENCY& CSimWindowSystem::GetLatency( WINDOWID id )
+{
+   SIMWINDOW* pWindow = GetWindow( id );
+
+   return (pWindow && pWindow->bOwnLatency) ? pWindow->latency : m_latency;
+}
+
+/**
+ * CSimWindowSystem::SetRealTime()
+ */
+
+void CSimWindowSystem::SetRealTime( bool bRealTime )
+{
+   m_bRealTime = bRealTime;
+}
+
+/**
+ * CSimWindowSystem::SetCapsLock()
+ */
+
+void CSimWindowSystem::SetCapsLock( bool bCapsLock )
+{
+   m_bCapsLock = bCapsLock;
+}
+
+/**
+ * CSimWindowSystem::GetCapsLock()
+ */
+
+bool CSimWindowSystem::GetCapsLock()
+{
+   return m_bCapsLock;
+}
+
+/**
+ * CSimWindowSystem::GetWindowState()
+ */
+
+bool CSimWindowSystem::GetWindowState( WINDOWID id, WINDOWSTATE& state )
+{
+   SIMWINDOW* pWindow = GetWindow( id );
+
+   if ( !pWindow )
+   {
+      return false;
+   }
+
+   state = pWindow->state;
+
+   return true;
+}
+
+/**
+ * CSimWindowSystem::SetWindowStates()
+ *
+ * Takes no time; the z-order is not simulated
+ */
+
+double CSimWindowSystem::SetWindowStates( const std::vector<WINDOWSTATE>& vecStates )
+{
+   for ( size_t iLoop = 0; iLoop < vecStates.size(); iLoop++ )
+   {
+      SIMWINDOW* pWindow = GetWindow( vecStates[iLoop].id );
+
+      if ( pWindow )
+      {
+         pWindow->state = vecStates[iLoop];
+         pWindow->info.iFlags = vecStates[iLoop].iFlags;
+      }
+   }
+
+   return 0.0;
+}
+
+/**
+ * CSimWindowSystem::AddWindow()
+ */
+
+WINDOWID CSimWindowSystem::AddWindow( const std::string& sTitle, int iClass )
+{
+   SIMWINDOW window;
+   window.info.id = m_idNext++;
+   window.info.sTitle = sTitle;
+   window.info.iClass = iClass;
+   window.info.iFlags = WINDOWSTATE_VISIBLE;
+   window.bOwnLatency = false;
+   window.latency = m_latency;
+   window.iKeystrokes = 0;
+
+   window.state.id = window.info.id;
+   window.state.iX = (int) (window.info.id % 16) * 24;
+   window.state.iY = (int) (window.info.id % 16) * 24;
+   window.state.iWidth = 640;
+   window.state.iHeight = 400;
+   window.state.iFlags = WINDOWSTATE_VISIBLE;
+
+   m_mapWindows[window.info.id] = window;
+
+   return window.info.id;
+}
+
+/**
+ * CSimWindowSystem::AddWindows()
+ *
+ * iCount PuTTY windows titled by pszFormat with a 1 based number
+ */
+
+void CSimWindowSystem::AddWindows( int iCount, const char* pszFormat )
+{
+   char szTitle[256];
+
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      snprintf( szTitle, sizeof(szTitle), pszFormat, iLoop + 1 );
+
+      AddWindow( szTitle );
+   }
+}
+
+/**
+ * CSimWindowSystem::RemoveWindow()
+ */
+
+bool CSimWindowSystem::RemoveWindow( WINDOWID id )
+{
+   if ( m_idForeground == id )
+   {
+      m_idForeground = 0;
+   }
+
+   return m_mapWindows.erase( id ) > 0;
+}
+
+/**
+ * CSimWindowSystem::Clear()
+ */
+
+void CSimWindowSystem::Clear()
+{
+   m_mapWindows.clear();
+
+   m_idForeground = 0;
+   m_dElapsedMs = 0.0;
+}
+
+/**
+ * CSimWindowSystem::GetWindowCount()
+ */
+
+size_t CSimWindowSystem::GetWindowCount()
+{
+   return m_mapWindows.size();
+}
+
+/**
+ * CSimWindowSystem::GetTyped()
+ *
+ * The text a window received, Enter as \r and Ctrl+letter as a
+ * control character
+ */
+
+std::string CSimWindowSystem::GetTyped( WINDOWID id )
+{
+   SIMWINDOW* pWindow = GetWindow( id );
+
+   return pWindow ? pWindow->sTyped : std::string();
+}
+
+/**
+ * CSimWindowSystem::GetKeystrokes()
+ */
+
+size_t CSimWindowSystem::GetKeystrokes( WINDOWID id )
+{
+   SIMWINDOW* pWindow = GetWindow( id );
+
+   return pWindow ? pWindow->iKeystrokes : 0;
+}
+
+/**
+ * CSimWindowSystem::GetElapsedMs()
+ *
+ * Virtual time spent by all steps so far
+ */
+
+double CSimWindowSystem::GetElapsedMs()
+{
+   return m_dElapsedMs;
+}
+
+/**
+ * CSimWindowSystem::ResetTyped()
+ */
+
+void CSimWindowSystem::ResetTyped()
+{
+   for ( SimWindowMap::iterator it = m_mapWindows.begin(); it != m_mapWindows.end(); ++it )
+   {
+      it->second.sTyped.clear();
+      it->second.iKeystrokes = 0;
+   }
+}
+
+/**
+ * CSimWindowSystem::EnumTerminalWindows()
+ */
+
+void CSimWindowSystem::EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows )
+{
+   vecWindows.resize( m_mapWindows.size() );
+
+   size_t iWindow = 0;
+
+   for ( SimWindowMap::iterator it = m_mapWindows.begin(); it != m_mapWindows.end(); ++it )
+   {
+      vecWindows[iWindow++] = it->second.info;
+   }
+}
+
+/**
+ * CSimWindowSystem::Activate()
+ */
+
+double CSimWindowSystem::Activate( WINDOWID id )
+{
+   if ( !GetWindow(id) )
+   {
+      return 0.0;
+   }
+
+   const SIMLATENCY& latency = GetLatency( id );
+
+   std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+
+   if ( distribution(m_rng) >= latency.dFocusFailure )
+   {
+      m_idForeground = id;
+   }
+
+   return Elapse( Sample(latency.dActivateMs, latency.dJitter) );
+}
+
+/**
+ * CSimWindowSystem::IsForeground()
+ */
+
+bool CSimWindowSystem::IsForeground( WINDOWID id )
+{
+   return (id != 0) && (m_idForeground == id);
+}
+
+/**
+ * CSimWindowSystem::WaitForForeground()
+ *
+ * Like CWindowWait: a refused activation is polled until the timeout
+ */
+
+double CSimWindowSystem::WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                            int* piOutcome )
+{
+   double dTimeout = ulFixedMs * SIM_TIMEOUT_FACTOR;
+   double dWait = dTimeout;
+
+   if ( IsForeground(id) )
+   {
+      const SIMLATENCY& latency = GetLatency( id );
+
+      dWait = Sample( latency.dForegroundMs, latency.dJitter );
+
+      if ( dWait > dTimeout )
+      {
+         dWait = dTimeout;
+      }
+   }
+
+   if ( piOutcome )
+   {
+      *piOutcome = (dWait < dTimeout) ? WAITOUTCOME_MET : WAITOUTCOME_TIMEOUT;
+   }
+
+   return Elapse( dWait );
+}
+
+/**
+ * CSimWindowSystem::SendKeys()
+ *
+ * Types into the foreground window, whichever that is
+ */
+
+double CSimWindowSystem::SendKeys( WINDOWID id, const std::string& sKeys )
+{
+   CKeyProgram kpProgram;
+   kpProgram.Compile( sKeys );
+
+   const SIMLATENCY& latency = GetLatency( id );
+
+   SIMWINDOW* pWindow = GetWindow( m_idForeground );
+
+   bool bControl = false;
+   bool bShift = false;
+
+   double dMs = 0.0;
+   double dDelayAlways = 0.0;
+   double dDelayNow = 0.0;
+
+   const std::vector<KEYOP>& vecOps = kpProgram.GetOps();
+
+   for ( size_t iOp = 0; iOp < vecOps.size(); iOp++ )
+   {
+      const KEYOP& op = vecOps[iOp];
+
+      switch ( op.iType )
+      {
+      case KEYOP::KEYOP_CHAR:
+      case KEYOP::KEYOP_VKEY:
+         for ( unsigned int uiLoop = 0; uiLoop < op.uiCount; uiLoop++ )
+         {
+            dMs += Sample( latency.dKeyMs, latency.dJitter ) + dDelayAlways + dDelayNow;
+            dDelayNow = 0.0;
+
+            if ( (op.iType == KEYOP::KEYOP_VKEY) && (op.uiValue == SIM_VK_CAPITAL) )
+            {
+               m_bCapsLock = !m_bCapsLock;
+            }
+            else if ( pWindow )
+            {
+               unsigned int uiChar = op.uiValue;
+
+               if ( op.iType == KEYOP::KEYOP_VKEY )
+               {
+                  // Keys that produce a character in a terminal
+
+                  if ( (uiChar >= 'A') && (uiChar <= 'Z') )
+                  {
+                     uiChar = (bShift != m_bCapsLock) ? uiChar : uiChar + ('a' - 'A');
+                  }
+                  else if ( uiChar == CKeyProgram::VK_RETURN )
+                  {
+                     uiChar = '\r';
+                  }
+                  else if ( (uiChar != CKeyProgram::VK_TAB) && 
+                            (uiChar != CKeyProgram::VK_BACK) && 
+                            (uiChar != CKeyProgram::VK_ESCAPE) && 
+                            ((uiChar < '0') || (uiChar > '9')) )
+                  {
+                     uiChar = 0;
+                  }
+               }
+               else if ( m_bCapsLock && (uiChar < 0x80) && isalpha(uiChar) )
+               {
+                  uiChar ^= 0x20;
+               }
+
+               Type( pWindow, uiChar, bControl, bShift );
+            }
+
+            if ( pWindow )
+            {
+               pWindow->iKeystrokes++;
+            }
+         }
+         break;
+
+      case KEYOP::KEYOP_MODIFIER:
+         bControl = bControl || (op.uiValue == CKeyProgram::VK_CONTROL);
+         bShift = bShift || (op.uiValue == CKeyProgram::VK_SHIFT);
+
+         if ( pWindow )
+         {
+            pWindow->iKeystrokes++;
+         }
+         break;
+
+      case KEYOP::KEYOP_RELEASE:
+         bControl = false;
+         bShift = false;
+         break;
+
+      case KEYOP::KEYOP_DELAY_ALWAYS:
+         dDelayAlways = op.uiValue;
+         break;
+
+      case KEYOP::KEYOP_DELAY_NOW:
+         dDelayNow = op.uiValue;
+         break;
+
+      case KEYOP::KEYOP_BEEP:
+         dMs += op.uiParam;
+         break;
+
+      case KEYOP::KEYOP_APPACTIVATE:
+         for ( SimWindowMap::iterator it = m_mapWindows.begin(); it != m_mapWindows.end(); ++it )
+         {
+            if ( it->second.info.sTitle == op.sText )
+            {
+               m_idForeground = it->first;
+               pWindow = &it->second;
+               break;
+            }
+         }
+         break;
+      }
+   }
+
+   return Elapse( dMs );
+}
+
+/**
+ * CSimWindowSystem::WaitForInputIdle()
+ */
+
+double CSimWindowSystem::WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                           int* piOutcome )
+{
+   double dTimeout = ulFixedMs * SIM_TIMEOUT_FACTOR;
+   double dWait = dTimeout;
+
+   if ( GetWindow(id) )
+   {
+      const SIMLATENCY& latency = GetLatency( id );
+
+      double dIdle = Sample( latency.dIdleMs, latency.dJitter );
+
+      if ( dIdle < dWait )
+      {
+         dWait = dIdle;
+      }
+   }
+
+   if ( piOutcome )
+   {
+      *piOutcome = (dWait < dTimeout) ? WAITOUTCOME_MET : WAITOUTCOME_TIMEOUT;
+   }
+
+   return Elapse( dWait );
+}
+
+/**
+ * CSimWindowSystem::GetWindow()
+ */
+
+CSimWindowSystem::SIMWINDOW* CSimWindowSystem::GetWindow( WINDOWID id )
+{
+   SimWindowMap::iterator it = m_mapWindows.find( id );
+
+   return (it != m_mapWindows.end()) ? &it->second : NULL;
+}
+
+/**
+ * CSimWindowSystem::Sample()
+ */
+
+double CSimWindowSystem::Sample( double dMs, double dJitter )
+{
+   if ( dJitter <= 0.0 )
+   {
+      return dMs;
+   }
+
+   std::uniform_real_distribution<double> distribution( -dJitter, dJitter );
+
+   double dSample = dMs * (1.0 + distribution(m_rng));
+
+   return (dSample > 0.0) ? dSample : 0.0;
+}
+
+/**
+ * CSimWindowSystem::Elapse()
+ *
+ * Advances the virtual clock, and the real one in real time mode
+ */
+
+double CSimWindowSystem::Elapse( double dMs )
+{
+   m_dElapsedMs += dMs;
+
+   if ( m_bRealTime && (dMs > 0.0) )
+   {
+      std::this_thread::sleep_for( std::chrono::duration<double, std::milli>(dMs) );
+   }
+
+   return dMs;
+}
+
+/**
+ * CSimWindowSystem::Type()
+ */
+
+void CSimWindowSystem::Type( SIMWINDOW* pWindow, unsigned int uiChar, bool bControl, bool bShift )
+{
+   if ( uiChar == 0 )
+   {
+      return;
+   }
+
+   if ( bControl && (uiChar < 0x80) && isalpha(uiChar) )
+   {
+      uiChar &= 0x1f;
+   }
+   else if ( bShift && (uiChar >= 'a') && (uiChar <= 'z') )
+   {
+      uiChar -= 'a' - 'A';
+   }
+
+   CKeyProgram::AppendUtf8( pWindow->sTyped, uiChar );
+}
@@ -0,0 +1,159 @@
+/**
+ * SimWindowSystem.h - PuTTYCS simulated window system
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(SIMWINDOWSYSTEM_H__INCLUDED_)
+#define SIMWINDOWSYSTEM_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "WindowSystem.h"
+
+/**
+ * Latencies of a simulated window in ms. Every sample is varied by
+ * up to +/- dJitter (a fraction) of its value.
+ */
+
+struct SIMLATENCY
+{
+   double dActivateMs;
+   double dForegroundMs;
+   double dKeyMs;
+   double dIdleMs;
+
+   double dJitter;
+   double dFocusFailure;      // probability that activation is refused
+};
+
+/**
+ * CSimWindowSystem
+ *
+ * In memory desktop of terminal windows with configurable latencies.
+ * Keystrokes go to the foreground window, as injected input does, and
+ * are interpreted into the text each window received. Time is virtual
+ * unless SetRealTime() is on, in which case every step also sleeps.
+ * Random numbers come from a seeded generator, so runs repeat.
+ */
+
+class CSimWindowSystem : public CWindowSystem
+{
+public:
+
+   CSimWindowSystem( unsigned int uiSeed = 1 );
+   virtual ~CSimWindowSystem();
+
+   void SetLatency( const SIMLATENCY& latency );
+   bool SetLatency( WINDOWID id, const SIMLATENCY& latency );
+   const SIMLATENCY& GetLatency();
+
+   void SetRealTime( bool bRealTime );
+   void SetCapsLock( bool bCapsLock );
+
+   WINDOWID AddWindow( const std::string& sTitle, int iClass = WINDOWCLASS_PUTTY );
+   void AddWindows( int iCount, const char* pszFormat = "host%05d" );
+
+   bool RemoveWindow( WINDOWID id );
+   void Clear();
+
+   size_t GetWindowCount();
+
+   std::string GetTyped( WINDOWID id );
+   size_t GetKeystrokes( WINDOWID id );
+
+   double GetElapsedMs();
+   void ResetTyped();
+
+   virtual void EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows );
+
+   virtual double Activate( WINDOWID id );
+   virtual bool IsForeground( WINDOWID id );
+
+   virtual double WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                     int* piOutcome );
+
+   virtual double SendKeys( WINDOWID id, const std::string& sKeys );
+
+   virtual double WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                    int* piOutcome );
+
+   virtual bool GetCapsLock();
+
+   virtual bool GetWindowState( WINDOWID id, WINDOWSTATE& state );
+   virtual double SetWindowStates( const std::vector<WINDOWSTATE>& vecStates );
+
+protected:
+
+   struct SIMWINDOW
+   {
+      WINDOWINFO info;
+
+      bool bOwnLatency;
+      SIMLATENCY latency;
+
+      std::string sTyped;
+      size_t iKeystrokes;
+
+      WINDOWSTATE state;
+   };
+
+   typedef std::map<WINDOWID, SIMWINDOW> SimWindowMap;
+
+   SIMWINDOW* GetWindow( WINDOWID id );
+   const SIMLATENCY& GetLatency( WINDOWID id );
+
+   double Sample( double dMs, double dJitter );
+   double Elapse( double dMs );
+
+   void Type( SIMWINDOW* pWindow, unsigned int uiChar, bool bControl, bool bShift );
+
+   SimWindowMap m_mapWindows;
+
+   SIMLATENCY m_latency;
+
+   WINDOWID m_idNext;
+   WINDOWID m_idForeground;
+
+   bool m_bRealTime;
+   bool m_bCapsLock;
+
+   double m_dElapsedMs;
+
+   std::mt19937 m_rng;
+};
+
+#endif // !defined(SIMWINDOWSYSTEM_H__INCLUDED_)
@@ -0,0 +1,232 @@
+/**
+ * StartupProfile.cpp - PuTTYCS startup phase timing
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "StartupProfile.h"
+#include "SendTrace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * CStartupProfile::CStartupProfile()
+ */
+
+CStartupProfile::CStartupProfile()
+{
+   m_tpStart = std::chrono::steady_clock::now();
+
+   m_dProcessStartMs = GetProcessAgeMs();
+
+   m_llLastMarkUs = 0;
+   m_bFinished = false;
+
+   m_pTrace = NULL;
+}
+
+/**
+ * CStartupProfile::SetTrace()
+ */
+
+void CStartupProfile::SetTrace( CSendTrace* pTrace )
+{
+   m_pTrace = pTrace;
+}
+
+/**
+ * CStartupProfile::Now()
+ */
+
+long long CStartupProfile::Now() const
+{
+   return (long long) std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - m_tpStart).count();
+}
+
+/**
+ * CStartupProfile::Mark()
+ */
+
+void CStartupProfile::Mark( const char* pszPhase )
+{
+   if ( m_bFinished )
+   {
+      return;
+   }
+
+   STARTUPPHASE phase;
+   phase.pszName = pszPhase;
+   phase.llStartUs = m_llLastMarkUs;
+   phase.llEndUs = Now();
+
+   m_vecPhases.push_back( phase );
+
+   m_llLastMarkUs = phase.llEndUs;
+
+   if ( m_pTrace )
+   {
+      /**
+       * The trace has its own epoch, shift the span onto it
+       */
+
+      long long llOffset = m_pTrace->Now() - phase.llEndUs;
+
+      m_pTrace->Record( pszPhase, 0, 
+         phase.llStartUs + llOffset, phase.llEndUs + llOffset );
+   }
+}
+
+/**
+ * CStartupProfile::Finish()
+ */
+
+void CStartupProfile::Finish()
+{
+   m_bFinished = true;
+}
+
+/**
+ * CStartupProfile::IsFinished()
+ */
+
+bool CStartupProfile::IsFinished() const
+{
+   return m_bFinished;
+}
+
+/**
+ * CStartupProfile::GetPhaseMs()
+ */
+
+double CStartupProfile::GetPhaseMs( const char* pszPhase ) const
+{
+   for ( size_t iLoop = 0; iLoop < m_vecPhases.size(); iLoop++ )
+   {
+      if ( strcmp(m_vecPhases[iLoop].pszName, pszPhase) == 0 )
+      {
+         return (m_vecPhases[iLoop].llEndUs - m_vecPhases[iLoop].llStartUs) / 1000.0;
+      }
+   }
+
+   return 0.0;
+}
+
+/**
+ * CStartupProfile::GetTotalMs()
+ *
+ * From process creation to the last mark
+ */
+
+double CStartupProfile::GetTotalMs() const
+{
+   return m_dProcessStartMs + (m_llLastMarkUs / 1000.0);
+}
+
+/**
+ * CStartupProfile::GetProcessStartMs()
+ *
+ * Time spent before the profile was created (loader, CRT and MFC
+ * start up, InitInstance)
+ */
+
+double CStartupProfile::GetProcessStartMs() const
+{
+   return m_dProcessStartMs;
+}
+
+/**
+ * CStartupProfile::GetSummary()
+ */
+
+std::string CStartupProfile::GetSummary() const
+{
+   char szLine[128];
+
+   snprintf( szLine, sizeof(szLine), "Startup %.1f ms: process %.1f", 
+      GetTotalMs(), m_dProcessStartMs );
+
+   std::string sSummary = szLine;
+
+   for ( size_t iLoop = 0; iLoop < m_vecPhases.size(); iLoop++ )
+   {
+      const STARTUPPHASE& phase = m_vecPhases[iLoop];
+
+      snprintf( szLine, sizeof(szLine), ", %s %.1f", 
+         phase.pszName, (phase.llEndUs - phase.llStartUs) / 1000.0 );
+
+      sSummary += szLine;
+   }
+
+   return sSummary;
+}
+
+/**
+ * CStartupProfile::GetProcessAgeMs()
+ */
+
+double CStartupProfile::GetProcessAgeMs()
+{
+#ifdef _WIN32
+   FILETIME ftCreation, ftExit, ftKernel, ftUser, ftNow;
+
+   if ( !::GetProcessTimes(::GetCurrentProcess(), &ftCreation, &ftExit, &ftKernel, &ftUser) )
+   {
+      return 0.0;
+   }
+
+   ::GetSystemTimeAsFileTime( &ftNow );
+
+   ULARGE_INTEGER uliCreation, uliNow;
+
+   uliCreation.LowPart = ftCreation.dwLowDateTime;
+   uliCreation.HighPart = ftCreation.dwHighDateTime;
+
+   uliNow.LowPart = ftNow.dwLowDateTime;
+   uliNow.HighPart = ftNow.dwHighDateTime;
+
+   if ( uliNow.QuadPart < uliCreation.QuadPart )
+   {
+      return 0.0;
+   }
+
+   /**
+    * FILETIME is in 100 ns units
+    */
+
+   return (uliNow.QuadPart - uliCreation.QuadPart) / 10000.0;
+#else
+   return 0.0;
+#endif
+}
@@ -0,0 +1,103 @@
+/**
+ * StartupProfile.h - PuTTYCS startup phase timing
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(STARTUPPROFILE_H__INCLUDED_)
+#define STARTUPPROFILE_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class CSendTrace;
+
+/**
+ * One timed startup phase
+ */
+
+struct STARTUPPHASE
+{
+   const char* pszName;
+
+   long long llStartUs;
+   long long llEndUs;
+};
+
+/**
+ * CStartupProfile
+ *
+ * Times consecutive startup phases: each Mark() ends the phase
+ * running since the previous Mark(). Phases are also recorded as
+ * spans of the send trace, so they appear in an exported trace.
+ */
+
+class CStartupProfile
+{
+public:
+
+   CStartupProfile();
+
+   void SetTrace( CSendTrace* pTrace );
+
+   void Mark( const char* pszPhase );
+   void Finish();
+
+   bool IsFinished() const;
+
+   double GetPhaseMs( const char* pszPhase ) const;
+   double GetTotalMs() const;
+   double GetProcessStartMs() const;
+
+   std::string GetSummary() const;
+
+protected:
+
+   long long Now() const;
+
+   static double GetProcessAgeMs();
+
+   std::chrono::steady_clock::time_point m_tpStart;
+
+   double m_dProcessStartMs;
+
+   long long m_llLastMarkUs;
+   bool m_bFinished;
+
+   CSendTrace* m_pTrace;
+
+   std::vector<STARTUPPHASE> m_vecPhases;
+};
+
+#endif // !defined(STARTUPPROFILE_H__INCLUDED_)
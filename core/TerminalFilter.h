@@ -0,0 +1,124 @@
+/**
+ * TerminalFilter.h - PuTTYCS terminal output filter
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(TERMINALFILTER_H__INCLUDED_)
+#define TERMINALFILTER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string.h>
+
+/**
+ * CTerminalFilter
+ *
+ * Reduces terminal output to its text as it streams by: escape
+ * sequences (CSI, OSC and the other string sequences, and two byte
+ * escapes), carriage returns, bells and NULs are dropped. Put() is
+ * given one byte at a time and keeps its state between chunks.
+ */
+
+class CTerminalFilter
+{
+public:
+
+   CTerminalFilter()
+   {
+      m_iState = STATE_TEXT;
+   }
+
+   void Reset()
+   {
+      m_iState = STATE_TEXT;
+   }
+
+   /**
+    * True if chChar is text
+    */
+
+   bool Put( unsigned char chChar )
+   {
+      switch ( m_iState )
+      {
+      case STATE_ESCAPE:
+         m_iState = (chChar == '[') ? STATE_CSI : 
+            (chChar && strchr("]P_^X", chChar)) ? STATE_STRING : STATE_TEXT;
+         return false;
+
+      case STATE_CSI:
+         if ( (chChar >= 0x40) && (chChar <= 0x7e) )
+         {
+            m_iState = STATE_TEXT;
+         }
+         return false;
+
+      case STATE_STRING:
+         if ( chChar == 0x07 )
+         {
+            m_iState = STATE_TEXT;
+         }
+         else if ( chChar == 0x1b )
+         {
+            m_iState = STATE_STRING_END;
+         }
+         return false;
+
+      case STATE_STRING_END:
+         m_iState = (chChar == '\\') ? STATE_TEXT : STATE_STRING;
+         return false;
+      }
+
+      if ( chChar == 0x1b )
+      {
+         m_iState = STATE_ESCAPE;
+         return false;
+      }
+
+      return (chChar != '\r') && (chChar != 0x07) && (chChar != 0);
+   }
+
+protected:
+
+   enum
+   {
+      STATE_TEXT,
+      STATE_ESCAPE,
+      STATE_CSI,
+      STATE_STRING,
+      STATE_STRING_END
+   };
+
+   int m_iState;
+};
+
+#endif // !defined(TERMINALFILTER_H__INCLUDED_)
@@ -0,0 +1,406 @@
+/**
+ * TileLayout.cpp - PuTTYCS terminal aware tile layout
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "TileLayout.h"
+
+/**
+ * CTileLayout::CTileLayout()
+ */
+
+CTileLayout::CTileLayout()
+{
+   m_iLeft = 0;
+   m_iTop = 0;
+   m_iWidth = 0;
+   m_iHeight = 0;
+
+   m_iCellWidth = 1;
+   m_iCellHeight = 1;
+
+   m_iFrameWidth = 0;
+   m_iFrameHeight = 0;
+
+   m_iBands = 0;
+   m_bColumnMajor = false;
+
+   m_iMinColumns = 0;
+   m_iMinRows = 0;
+}
+
+/**
+ * CTileLayout::~CTileLayout()
+ */
+
+CTileLayout::~CTileLayout()
+{
+}
+
+/**
+ * CTileLayout::SetWorkArea()
+ */
+
+void CTileLayout::SetWorkArea( int iLeft, int iTop, int iWidth, int iHeight )
+{
+   m_iLeft = iLeft;
+   m_iTop = iTop;
+   m_iWidth = (iWidth > 0) ? iWidth : 0;
+   m_iHeight = (iHeight > 0) ? iHeight : 0;
+}
+
+/**
+ * CTileLayout::SetCellSize()
+ */
+
+void CTileLayout::SetCellSize( int iCellWidth, int iCellHeight )
+{
+   m_iCellWidth = (iCellWidth > 0) ? iCellWidth : 1;
+   m_iCellHeight = (iCellHeight > 0) ? iCellHeight : 1;
+}
+
+/**
+ * CTileLayout::SetFrameSize()
+ *
+ * Pixels of every window that do not show terminal cells
+ * (borders, caption, scroll bar).
+ */
+
+void CTileLayout::SetFrameSize( int iFrameWidth, int iFrameHeight )
+{
+   m_iFrameWidth = (iFrameWidth > 0) ? iFrameWidth : 0;
+   m_iFrameHeight = (iFrameHeight > 0) ? iFrameHeight : 0;
+}
+
+/**
+ * CTileLayout::CellsAcross()
+ */
+
+int CTileLayout::CellsAcross( int iPixels ) const
+{
+   int iCells = (iPixels - m_iFrameWidth) / m_iCellWidth;
+
+   return (iCells > 0) ? iCells : 0;
+}
+
+/**
+ * CTileLayout::CellsDown()
+ */
+
+int CTileLayout::CellsDown( int iPixels ) const
+{
+   int iCells = (iPixels - m_iFrameHeight) / m_iCellHeight;
+
+   return (iCells > 0) ? iCells : 0;
+}
+
+/**
+ * CTileLayout::Score()
+ *
+ * Evaluates iTotal windows split over iBands bands. The first
+ * (iTotal % iBands) bands hold one window more than the others,
+ * so the smallest window is always found in the first band.
+ */
+
+void CTileLayout::Score( int iTotal, int iBands, bool bColumnMajor,
+                         int& iMinCells, int& iTotalCells,
+                         int& iMinColumns, int& iMinRows ) const
+{
+   int iPerBand = iTotal / iBands;
+   int iExtra = iTotal % iBands;
+   int iMaxPerBand = iPerBand + ((iExtra > 0) ? 1 : 0);
+
+   int iAcrossBand = (bColumnMajor ? m_iWidth : m_iHeight) / iBands;
+   int iAlongBand = bColumnMajor ? m_iHeight : m_iWidth;
+
+   int iColumns;
+   int iRows;
+   int iSmallColumns;
+   int iSmallRows;
+
+   if ( bColumnMajor )
+   {
+      iColumns = CellsAcross( iAcrossBand );
+      iRows = CellsDown( iAlongBand / iPerBand );
+      iSmallColumns = iColumns;
+      iSmallRows = CellsDown( iAlongBand / iMaxPerBand );
+   }
+   else
+   {
+      iColumns = CellsAcross( iAlongBand / iPerBand );
+      iRows = CellsDown( iAcrossBand );
+      iSmallColumns = CellsAcross( iAlongBand / iMaxPerBand );
+      iSmallRows = iRows;
+   }
+
+   iMinColumns = iSmallColumns;
+   iMinRows = iSmallRows;
+   iMinCells = iSmallColumns * iSmallRows;
+
+   iTotalCells =
+      (iExtra * iMaxPerBand * iMinCells) +
+      ((iBands - iExtra) * iPerBand * iColumns * iRows);
+}
+
+/**
+ * CTileLayout::Optimize()
+ *
+ * Tries every band count in both orientations. Each candidate is
+ * scored in constant time, so a full search is O(iTotal).
+ */
+
+bool CTileLayout::Optimize( int iTotal )
+{
+   m_vecRects.clear();
+
+   m_iBands = 0;
+   m_bColumnMajor = false;
+
+   m_iMinColumns = 0;
+   m_iMinRows = 0;
+
+   if ( (iTotal <= 0) || (m_iWidth <= 0) || (m_iHeight <= 0) )
+   {
+      return false;
+   }
+
+   int iBestMinCells = -1;
+   int iBestTotalCells = -1;
+   int iBestBandSize = -1;
+
+   for ( int iOrientation = 0; iOrientation < 2; iOrientation++ )
+   {
+      bool bColumnMajor = (iOrientation == 1);
+
+      for ( int iBands = 1; iBands <= iTotal; iBands++ )
+      {
+         int iMinCells;
+         int iTotalCells;
+         int iMinColumns;
+         int iMinRows;
+
+         Score( iTotal, iBands, bColumnMajor,
+                iMinCells, iTotalCells, iMinColumns, iMinRows );
+
+         /**
+          * Band size only breaks ties when no split leaves any
+          * visible cells, e.g. too many windows for the screen
+          */
+
+         int iBandSize =
+            ((bColumnMajor ? m_iWidth : m_iHeight) / iBands) *
+            ((bColumnMajor ? m_iHeight : m_iWidth) / ((iTotal + iBands - 1) / iBands));
+
+         if ( (iMinCells > iBestMinCells) ||
+              ((iMinCells == iBestMinCells) && (iTotalCells > iBestTotalCells)) ||
+              ((iMinCells == iBestMinCells) && (iTotalCells == iBestTotalCells) &&
+               (iBandSize > iBestBandSize)) )
+         {
+            iBestMinCells = iMinCells;
+            iBestTotalCells = iTotalCells;
+            iBestBandSize = iBandSize;
+
+            m_iBands = iBands;
+            m_bColumnMajor = bColumnMajor;
+
+            m_iMinColumns = iMinColumns;
+            m_iMinRows = iMinRows;
+         }
+      }
+   }
+
+   Place( iTotal );
+
+   return true;
+}
+
+/**
+ * CTileLayout::Place()
+ *
+ * Pixel boundaries are computed from the band/slot index so rounding
+ * never leaves a gap at the right or bottom of the work area.
+ */
+
+void CTileLayout::Place( int iTotal )
+{
+   m_vecRects.resize( iTotal );
+
+   int iPerBand = iTotal / m_iBands;
+   int iExtra = iTotal % m_iBands;
+
+   int iAcross = m_bColumnMajor ? m_iWidth : m_iHeight;
+   int iAlong = m_bColumnMajor ? m_iHeight : m_iWidth;
+
+   int iIndex = 0;
+
+   for ( int iBand = 0; iBand < m_iBands; iBand++ )
+   {
+      int iCount = iPerBand + ((iBand < iExtra) ? 1 : 0);
+
+      int iBandStart = (int) (((long long) iBand * iAcross) / m_iBands);
+      int iBandEnd = (int) (((long long) (iBand + 1) * iAcross) / m_iBands);
+
+      for ( int iSlot = 0; iSlot < iCount; iSlot++, iIndex++ )
+      {
+         int iSlotStart = (int) (((long long) iSlot * iAlong) / iCount);
+         int iSlotEnd = (int) (((long long) (iSlot + 1) * iAlong) / iCount);
+
+         TILERECT& rect = m_vecRects[iIndex];
+
+         if ( m_bColumnMajor )
+         {
+            rect.iX = m_iLeft + iBandStart;
+            rect.iY = m_iTop + iSlotStart;
+            rect.iWidth = iBandEnd - iBandStart;
+            rect.iHeight = iSlotEnd - iSlotStart;
+         }
+         else
+         {
+            rect.iX = m_iLeft + iSlotStart;
+            rect.iY = m_iTop + iBandStart;
+            rect.iWidth = iSlotEnd - iSlotStart;
+            rect.iHeight = iBandEnd - iBandStart;
+         }
+      }
+   }
+}
+
+/**
+ * CTileLayout::Cascade()
+ *
+ * Windows of a fixed size, each one step right and down from the
+ * last, starting over at the top left when the next one would not
+ * fit (iCaption is kept free below the bottom window)
+ */
+
+bool CTileLayout::Cascade( int iTotal, int iWindowWidth, int iWindowHeight,
+                           int iStepX, int iStepY, int iCaption )
+{
+   m_vecRects.clear();
+
+   m_iBands = 0;
+   m_bColumnMajor = false;
+
+   m_iMinColumns = 0;
+   m_iMinRows = 0;
+
+   if ( iTotal <= 0 )
+   {
+      return false;
+   }
+
+   m_vecRects.resize( iTotal );
+
+   int iX = m_iLeft;
+   int iY = m_iTop;
+
+   for ( int iLoop = 0; iLoop < iTotal; iLoop++ )
+   {
+      TILERECT& rect = m_vecRects[iLoop];
+
+      rect.iX = iX;
+      rect.iY = iY;
+      rect.iWidth = iWindowWidth;
+      rect.iHeight = iWindowHeight;
+
+      iX += iStepX;
+      iY += iStepY;
+
+      if ( ((iX + iWindowWidth) >= (m_iLeft + m_iWidth)) ||
+           ((iY + iWindowHeight + iCaption) >= (m_iTop + m_iHeight)) ) 
+      {
+         iX = m_iLeft;
+         iY = m_iTop;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * CTileLayout::GetTotal()
+ */
+
+int CTileLayout::GetTotal() const
+{
+   return (int) m_vecRects.size();
+}
+
+/**
+ * CTileLayout::GetRect()
+ */
+
+bool CTileLayout::GetRect( int iIndex, TILERECT& rect ) const
+{
+   if ( (iIndex < 0) || (iIndex >= (int) m_vecRects.size()) )
+   {
+      return false;
+   }
+
+   rect = m_vecRects[iIndex];
+
+   return true;
+}
+
+/**
+ * CTileLayout::GetBands()
+ */
+
+int CTileLayout::GetBands() const
+{
+   return m_iBands;
+}
+
+/**
+ * CTileLayout::IsColumnMajor()
+ */
+
+bool CTileLayout::IsColumnMajor() const
+{
+   return m_bColumnMajor;
+}
+
+/**
+ * CTileLayout::GetMinColumns()
+ */
+
+int CTileLayout::GetMinColumns() const
+{
+   return m_iMinColumns;
+}
+
+/**
+ * CTileLayout::GetMinRows()
+ */
+
+int CTileLayout::GetMinRows() const
+{
+   return m_iMinRows;
+}
@@ -0,0 +1,117 @@
+/**
+ * TileLayout.h - PuTTYCS terminal aware tile layout header
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(TILELAYOUT_H__INCLUDED_)
+#define TILELAYOUT_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+
+/**
+ * Window placement produced by CTileLayout
+ */
+
+struct TILERECT
+{
+   int iX;
+   int iY;
+   int iWidth;
+   int iHeight;
+};
+
+/**
+ * CTileLayout
+ *
+ * Splits a work area into bands (rows or columns) of windows and picks
+ * the split that maximizes the smallest terminal, measured in visible
+ * character cells (columns x rows). Bands may hold an uneven number of
+ * windows, in which case the last bands hold one window less and those
+ * windows get the extra space.
+ */
+
+class CTileLayout
+{
+public:
+   CTileLayout();
+   virtual ~CTileLayout();
+
+   void SetWorkArea( int iLeft, int iTop, int iWidth, int iHeight );
+   void SetCellSize( int iCellWidth, int iCellHeight );
+   void SetFrameSize( int iFrameWidth, int iFrameHeight );
+
+   bool Optimize( int iTotal );
+   bool Cascade( int iTotal, int iWindowWidth, int iWindowHeight,
+                 int iStepX, int iStepY, int iCaption );
+
+   int GetTotal() const;
+   bool GetRect( int iIndex, TILERECT& rect ) const;
+
+   int GetBands() const;
+   bool IsColumnMajor() const;
+
+   int GetMinColumns() const;
+   int GetMinRows() const;
+
+protected:
+   int m_iLeft;
+   int m_iTop;
+   int m_iWidth;
+   int m_iHeight;
+
+   int m_iCellWidth;
+   int m_iCellHeight;
+
+   int m_iFrameWidth;
+   int m_iFrameHeight;
+
+   int m_iBands;
+   bool m_bColumnMajor;
+
+   int m_iMinColumns;
+   int m_iMinRows;
+
+   std::vector<TILERECT> m_vecRects;
+
+   int CellsAcross( int iPixels ) const;
+   int CellsDown( int iPixels ) const;
+
+   void Score( int iTotal, int iBands, bool bColumnMajor,
+               int& iMinCells, int& iTotalCells,
+               int& iMinColumns, int& iMinRows ) const;
+
+   void Place( int iTotal );
+};
+
+#endif // !defined(TILELAYOUT_H__INCLUDED_)
@@ -0,0 +1,73 @@
+/**
+ * UpdateFetcher.h - PuTTYCS version list download interface
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(UPDATEFETCHER_H__INCLUDED_)
+#define UPDATEFETCHER_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+
+/**
+ * CUpdateFetcher
+ *
+ * What the version check needs to download the version list: WinINet
+ * in PuTTYCS, a stand-in server in the tests. Strings are UTF-8.
+ */
+
+class CUpdateFetcher
+{
+public:
+
+   virtual ~CUpdateFetcher() {}
+
+   /**
+    * Downloads sUrl into sDocument. Fails on an error status, a
+    * document over iMaxSize bytes, or after ulTimeoutMs without
+    * progress.
+    */
+
+   virtual bool Fetch( const std::string& sUrl, unsigned long ulTimeoutMs, 
+                       size_t iMaxSize, std::string& sDocument ) = 0;
+
+   /**
+    * Called from another thread: a running Fetch() returns false as
+    * soon as it can, and so does every later one until Reset()
+    */
+
+   virtual void Abort() = 0;
+   virtual void Reset() = 0;
+};
+
+#endif // !defined(UPDATEFETCHER_H__INCLUDED_)
@@ -0,0 +1,428 @@
+/**
+ * VersionCheck.cpp - PuTTYCS update check
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "VersionCheck.h"
+
+#include <chrono>
+
+/**
+ * Largest version list accepted, in bytes
+ */
+
+static const size_t VERSION_CHECK_MAX_SIZE = 65536;
+
+/**
+ * CVersionCheck::CVersionCheck()
+ */
+
+CVersionCheck::CVersionCheck( CUpdateFetcher* pFetcher )
+{
+   m_pFetcher = pFetcher;
+
+   m_iMaxSize = VERSION_CHECK_MAX_SIZE;
+   m_ulDeadline = 0;
+
+   m_bStarted = false;
+   m_bFinished = false;
+   m_bCancelled = false;
+
+   m_bSucceeded = false;
+}
+
+/**
+ * CVersionCheck::~CVersionCheck()
+ */
+
+CVersionCheck::~CVersionCheck()
+{
+   Stop();
+}
+
+/**
+ * CVersionCheck::SetFetcher()
+ */
+
+void CVersionCheck::SetFetcher( CUpdateFetcher* pFetcher )
+{
+   m_pFetcher = pFetcher;
+}
+
+/**
+ * CVersionCheck::SetApplication()
+ *
+ * The name of the application's line in the version list and the
+ * internal version of this build
+ */
+
+void CVersionCheck::SetApplication( const std::string& sName, const std::string& sIntVersion )
+{
+   m_sName = sName;
+   m_sIntVersion = sIntVersion;
+}
+
+/**
+ * CVersionCheck::SetMaxSize()
+ */
+
+void CVersionCheck::SetMaxSize( size_t iMaxSize )
+{
+   m_iMaxSize = iMaxSize;
+}
+
+/**
+ * CVersionCheck::Start()
+ *
+ * Returns false while a check is running or without a fetcher
+ */
+
+bool CVersionCheck::Start( const std::string& sUrl, unsigned long ulDeadlineMs, DoneFunction fnDone )
+{
+   if ( !m_pFetcher || IsRunning() )
+   {
+      return false;
+   }
+
+   Stop();
+
+   m_sUrl = sUrl;
+   m_ulDeadline = ulDeadlineMs;
+   m_fnDone = fnDone;
+
+   m_bStarted = true;
+   m_bFinished = false;
+   m_bCancelled = false;
+
+   m_bSucceeded = false;
+   m_sNewVersion.clear();
+   m_sNewIntVersion.clear();
+
+   m_pFetcher->Reset();
+
+   m_thCheck = std::thread( &CVersionCheck::CheckThread, this );
+   m_thDeadline = std::thread( &CVersionCheck::DeadlineThread, this );
+
+   return true;
+}
+
+/**
+ * CVersionCheck::Cancel()
+ *
+ * Ends the check as failed, without waiting for the fetch
+ */
+
+void CVersionCheck::Cancel()
+{
+   {
+      std::lock_guard<std::mutex> lock( m_mtxLock );
+
+      if ( !m_bStarted || m_bFinished )
+      {
+         return;
+      }
+
+      m_bCancelled = true;
+   }
+
+   m_cvChanged.notify_all();
+
+   m_pFetcher->Abort();
+}
+
+/**
+ * CVersionCheck::Stop()
+ *
+ * Cancels a running check and waits for both threads
+ */
+
+void CVersionCheck::Stop()
+{
+   Cancel();
+
+   if ( m_thDeadline.joinable() )
+   {
+      m_thDeadline.join();
+   }
+
+   if ( m_thCheck.joinable() )
+   {
+      m_thCheck.join();
+   }
+}
+
+/**
+ * CVersionCheck::IsRunning()
+ */
+
+bool CVersionCheck::IsRunning()
+{
+   std::lock_guard<std::mutex> lock( m_mtxLock );
+
+   return m_bStarted && !m_bFinished;
+}
+
+/**
+ * CVersionCheck::GetResult()
+ *
+ * Returns false if the check failed, timed out, was cancelled or is
+ * still running. sVersion is empty if there is no newer version.
+ */
+
+bool CVersionCheck::GetResult( std::string& sVersion, std::string& sIntVersion )
+{
+   std::lock_guard<std::mutex> lock( m_mtxLock );
+
+   if ( !m_bFinished )
+   {
+      return false;
+   }
+
+   sVersion = m_sNewVersion;
+   sIntVersion = m_sNewIntVersion;
+
+   return m_bSucceeded;
+}
+
+/**
+ * CVersionCheck::IsDue()
+ *
+ * A clock set back makes the check due at once
+ */
+
+bool CVersionCheck::IsDue( long long llLastCheck, long long llNow, long long llInterval )
+{
+   return (llLastCheck > llNow) || ((llNow - llLastCheck) >= llInterval);
+}
+
+/**
+ * CVersionCheck::CheckThread()
+ */
+
+void CVersionCheck::CheckThread()
+{
+   std::string sDocument;
+
+   bool bFetched = m_pFetcher->Fetch( m_sUrl, m_ulDeadline, m_iMaxSize, sDocument );
+
+   std::string sVersion;
+   std::string sIntVersion;
+
+   bool bSucceeded = bFetched && 
+      ParseVersion( sDocument, m_sName, m_sIntVersion, sVersion, sIntVersion );
+
+   Finish( bSucceeded, sVersion, sIntVersion );
+}
+
+/**
+ * CVersionCheck::DeadlineThread()
+ *
+ * Waits until the check finishes, is cancelled or runs out of time;
+ * in the last two cases the fetch is aborted and the check failed
+ */
+
+void CVersionCheck::DeadlineThread()
+{
+   bool bEnded = false;
+
+   {
+      std::unique_lock<std::mutex> lock( m_mtxLock );
+
+      bEnded = m_cvChanged.wait_for( lock, std::chrono::milliseconds(m_ulDeadline), 
+         [this]() { return m_bFinished || m_bCancelled; } );
+
+      if ( bEnded && m_bFinished )
+      {
+         return;
+      }
+   }
+
+   m_pFetcher->Abort();
+
+   Finish( false, std::string(), std::string() );
+}
+
+/**
+ * CVersionCheck::Finish()
+ *
+ * The first of the two threads to get here decides the result and
+ * calls the done function; a cancelled check can not succeed
+ */
+
+void CVersionCheck::Finish( bool bSucceeded, const std::string& sVersion, 
+                            const std::string& sIntVersion )
+{
+   {
+      std::lock_guard<std::mutex> lock( m_mtxLock );
+
+      if ( m_bFinished )
+      {
+         return;
+      }
+
+      m_bFinished = true;
+
+      m_bSucceeded = bSucceeded && !m_bCancelled;
+
+      if ( m_bSucceeded )
+      {
+         m_sNewVersion = sVersion;
+         m_sNewIntVersion = sIntVersion;
+      }
+   }
+
+   m_cvChanged.notify_all();
+
+   if ( m_fnDone )
+   {
+      m_fnDone();
+   }
+}
+
+/**
+ * CVersionCheck::ParseVersion()
+ *
+ * Finds the line of sName in the version list. Returns false if
+ * there is none with an intVersion. sNewVersion and sNewIntVersion
+ * are the display and internal version of that line if it is newer
+ * than sIntVersion, empty otherwise.
+ */
+
+bool CVersionCheck::ParseVersion( const std::string& sDocument, const std::string& sName,
+                                  const std::string& sIntVersion, std::string& sNewVersion, 
+                                  std::string& sNewIntVersion )
+{
+   sNewVersion.clear();
+   sNewIntVersion.clear();
+
+   size_t iStart = 0;
+
+   while ( iStart < sDocument.size() )
+   {
+      size_t iEnd = sDocument.find( '\n', iStart );
+
+      if ( iEnd == std::string::npos )
+      {
+         iEnd = sDocument.size();
+      }
+
+      std::string sLine = sDocument.substr( iStart, iEnd - iStart );
+
+      iStart = iEnd + 1;
+
+      if ( GetAttributeValue(sLine, "name") != sName )
+      {
+         continue;
+      }
+
+      std::string sLineIntVersion = GetAttributeValue( sLine, "intVersion" );
+
+      if ( sLineIntVersion.empty() )
+      {
+         continue;
+      }
+
+      if ( CompareVersions(sLineIntVersion, sIntVersion) > 0 )
+      {
+         sNewVersion = GetAttributeValue( sLine, "version" );
+         sNewIntVersion = sLineIntVersion;
+      }
+
+      return true;
+   }
+
+   return false;
+}
+
+/**
+ * CVersionCheck::CompareVersions()
+ *
+ * Internal versions are numbers such as 202305230, compared by value
+ * so a longer one is newer; anything else is compared as text
+ */
+
+int CVersionCheck::CompareVersions( const std::string& sIntVersion1, const std::string& sIntVersion2 )
+{
+   bool bNumbers = !sIntVersion1.empty() && !sIntVersion2.empty() &&
+      (sIntVersion1.find_first_not_of("0123456789") == std::string::npos) &&
+      (sIntVersion2.find_first_not_of("0123456789") == std::string::npos);
+
+   if ( bNumbers )
+   {
+      size_t iZeros1 = sIntVersion1.find_first_not_of( '0' );
+      size_t iZeros2 = sIntVersion2.find_first_not_of( '0' );
+
+      std::string sDigits1 = (iZeros1 == std::string::npos) ? std::string() : sIntVersion1.substr( iZeros1 );
+      std::string sDigits2 = (iZeros2 == std::string::npos) ? std::string() : sIntVersion2.substr( iZeros2 );
+
+      if ( sDigits1.size() != sDigits2.size() )
+      {
+         return (sDigits1.size() < sDigits2.size()) ? -1 : 1;
+      }
+
+      int iResult = sDigits1.compare( sDigits2 );
+
+      return (iResult < 0) ? -1 : ((iResult > 0) ? 1 : 0);
+   }
+
+   int iResult = sIntVersion1.compare( sIntVersion2 );
+
+   return (iResult < 0) ? -1 : ((iResult > 0) ? 1 : 0);
+}
+
+/**
+ * CVersionCheck::GetAttributeValue()
+ *
+ * The text between attribute=" and the next ", empty if the line
+ * has no such attribute
+ */
+
+std::string CVersionCheck::GetAttributeValue( const std::string& sLine, const std::string& sAttribute )
+{
+   std::string sSearch = sAttribute + "=\"";
+
+   size_t iIndex = sLine.find( sSearch );
+
+   if ( iIndex == std::string::npos )
+   {
+      return std::string();
+   }
+
+   iIndex += sSearch.size();
+
+   size_t iIndex2 = sLine.find( '"', iIndex );
+
+   if ( iIndex2 == std::string::npos )
+   {
+      return std::string();
+   }
+
+   return sLine.substr( iIndex, iIndex2 - iIndex );
+}
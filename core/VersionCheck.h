@@ -0,0 +1,130 @@
+/**
+ * VersionCheck.h - PuTTYCS update check
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(VERSIONCHECK_H__INCLUDED_)
+#define VERSIONCHECK_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "UpdateFetcher.h"
+
+/**
+ * CVersionCheck
+ *
+ * Downloads the version list through a CUpdateFetcher on a worker
+ * thread and looks for a newer version of the application in it. A
+ * second thread ends the check at the deadline: it aborts the fetch
+ * and reports the check as failed, whether or not the fetch has
+ * returned by then. The done function is called once per check, on
+ * either thread, when it succeeded, failed, timed out or was
+ * cancelled.
+ *
+ * The version list has a line per application with name="...",
+ * version="..." and intVersion="..." attributes. A list without a
+ * line for the application is taken as a failed check.
+ */
+
+class CVersionCheck
+{
+public:
+
+   typedef std::function<void()> DoneFunction;
+
+   CVersionCheck( CUpdateFetcher* pFetcher = NULL );
+   virtual ~CVersionCheck();
+
+   void SetFetcher( CUpdateFetcher* pFetcher );
+   void SetApplication( const std::string& sName, const std::string& sIntVersion );
+   void SetMaxSize( size_t iMaxSize );
+
+   bool Start( const std::string& sUrl, unsigned long ulDeadlineMs, DoneFunction fnDone );
+   void Cancel();
+   void Stop();
+
+   bool IsRunning();
+
+   bool GetResult( std::string& sVersion, std::string& sIntVersion );
+
+   static bool IsDue( long long llLastCheck, long long llNow, long long llInterval );
+
+   static bool ParseVersion( const std::string& sDocument, const std::string& sName,
+                             const std::string& sIntVersion, std::string& sNewVersion, 
+                             std::string& sNewIntVersion );
+
+   static int CompareVersions( const std::string& sIntVersion1, const std::string& sIntVersion2 );
+
+   static std::string GetAttributeValue( const std::string& sLine, const std::string& sAttribute );
+
+protected:
+
+   CVersionCheck( const CVersionCheck& ) = delete;
+   CVersionCheck& operator=( const CVersionCheck& ) = delete;
+
+   void CheckThread();
+   void DeadlineThread();
+
+   void Finish( bool bSucceeded, const std::string& sVersion, const std::string& sIntVersion );
+
+   CUpdateFetcher* m_pFetcher;
+
+   std::string m_sName;
+   std::string m_sIntVersion;
+   size_t m_iMaxSize;
+
+   std::string m_sUrl;
+   unsigned long m_ulDeadline;
+   DoneFunction m_fnDone;
+
+   std::thread m_thCheck;
+   std::thread m_thDeadline;
+
+   std::mutex m_mtxLock;
+   std::condition_variable m_cvChanged;
+
+   bool m_bStarted;
+   bool m_bFinished;
+   bool m_bCancelled;
+
+   bool m_bSucceeded;
+   std::string m_sNewVersion;
+   std::string m_sNewIntVersion;
+};
+
+#endif // !defined(VERSIONCHECK_H__INCLUDED_)
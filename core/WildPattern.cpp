@@ -0,0 +1,470 @@
+/**
+ * WildPattern.cpp - PuTTYCS compiled wildcard pattern
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "WildPattern.h"
+
+#include <string.h>
+
+static const char WILDCMP_WILDCARD = '*';
+static const char WILDCMP_ANYCHAR = '?';
+
+static const size_t WILDCMP_NONE = (size_t) -1;
+
+/**
+ * Words of the shift-and state kept on the stack, longer parts
+ * between two * use the heap
+ */
+
+static const size_t WILDCMP_STACK_WORDS = 4;
+
+/**
+ * CWildPattern::CWildPattern()
+ */
+
+CWildPattern::CWildPattern()
+{
+   Compile( "" );
+}
+
+/**
+ * CWildPattern::CWildPattern()
+ */
+
+CWildPattern::CWildPattern( const char* pszWild )
+{
+   Compile( pszWild );
+}
+
+/**
+ * CWildPattern::GetPattern()
+ */
+
+const std::string& CWildPattern::GetPattern() const
+{
+   return m_sPattern;
+}
+
+/**
+ * CWildPattern::GetCharLength()
+ *
+ * Bytes of the UTF-8 character at psz: the byte and the
+ * continuation bytes after it, so ? matches a character rather than
+ * a byte
+ */
+
+size_t CWildPattern::GetCharLength( const char* psz )
+{
+   size_t iLength = 1;
+
+   while ( (psz[iLength] & 0xC0) == 0x80 )
+   {
+      iLength++;
+   }
+
+   return iLength;
+}
+
+/**
+ * CWildPattern::Compile()
+ *
+ * Splits the pattern at each * into segments of tokens. The first
+ * and the last are always there, even empty, the empty ones in
+ * between match anywhere and are dropped.
+ */
+
+void CWildPattern::Compile( const char* pszWild )
+{
+   m_sPattern = pszWild;
+
+   m_vecTokens.clear();
+   m_vecSegments.clear();
+   m_vecClasses.clear();
+   m_vecMasks.clear();
+   m_vecWide.clear();
+
+   m_vecTokens.reserve( m_sPattern.size() );
+
+   m_bWildcard = false;
+
+   WILDSEGMENT segment;
+   memset( &segment, 0, sizeof(segment) );
+
+   for ( size_t iPos = 0; ; )
+   {
+      char ch = m_sPattern.c_str()[iPos];
+
+      if ( (ch == WILDCMP_WILDCARD) || (ch == '\0') )
+      {
+         segment.iTokens = m_vecTokens.size() - segment.iToken;
+
+         if ( m_vecSegments.empty() || (ch == '\0') || (segment.iTokens > 0) )
+         {
+            m_vecSegments.push_back( segment );
+         }
+
+         if ( ch == '\0' )
+         {
+            break;
+         }
+
+         m_bWildcard = true;
+
+         segment.iToken = m_vecTokens.size();
+
+         iPos++;
+
+         continue;
+      }
+
+      WILDTOKEN token;
+      token.iOffset = iPos;
+      token.iLength = GetCharLength( m_sPattern.c_str() + iPos );
+      token.bAnyChar = (ch == WILDCMP_ANYCHAR);
+
+      m_vecTokens.push_back( token );
+
+      iPos += token.iLength;
+   }
+
+   /**
+    * Shift-and masks of the segments between two *. A character of
+    * the string matches a token if it is the start of it, so a
+    * single byte one only needs the lead byte of the token.
+    */
+
+   for ( size_t iSegment = 1; iSegment + 1 < m_vecSegments.size(); iSegment++ )
+   {
+      WILDSEGMENT& middle = m_vecSegments[iSegment];
+
+      middle.iWords = (middle.iTokens + 63) / 64;
+      middle.iClass = m_vecClasses.size();
+      middle.iMask = m_vecMasks.size();
+      middle.iWide = m_vecWide.size();
+
+      m_vecClasses.resize( middle.iClass + 256, 0 );
+      m_vecMasks.resize( middle.iMask + middle.iWords, 0 );
+
+      for ( size_t iLoop = 0; iLoop < middle.iTokens; iLoop++ )
+      {
+         const WILDTOKEN& token = m_vecTokens[middle.iToken + iLoop];
+
+         size_t iRow = 0;
+
+         if ( !token.bAnyChar )
+         {
+            unsigned char ucLead = (unsigned char) m_sPattern[token.iOffset];
+            unsigned char& ucClass = m_vecClasses[middle.iClass + ucLead];
+
+            // Lead bytes are never NUL, so there are at most 255 classes besides 0
+
+            if ( ucClass == 0 )
+            {
+               ucClass = (unsigned char) ((m_vecMasks.size() - middle.iMask) / middle.iWords);
+
+               m_vecMasks.resize( m_vecMasks.size() + middle.iWords, 0 );
+            }
+
+            iRow = ucClass;
+
+            if ( token.iLength > 1 )
+            {
+               m_vecWide.push_back( iLoop );
+            }
+         }
+
+         m_vecMasks[middle.iMask + iRow * middle.iWords + (iLoop >> 6)] |= 1ULL << (iLoop & 63);
+      }
+
+      // ? matches whatever the byte
+
+      size_t iRows = (m_vecMasks.size() - middle.iMask) / middle.iWords;
+
+      for ( size_t iRow = 1; iRow < iRows; iRow++ )
+      {
+         for ( size_t iWord = 0; iWord < middle.iWords; iWord++ )
+         {
+            m_vecMasks[middle.iMask + iRow * middle.iWords + iWord] |= m_vecMasks[middle.iMask + iWord];
+         }
+      }
+
+      middle.iWides = m_vecWide.size() - middle.iWide;
+   }
+}
+
+/**
+ * CWildPattern::MatchToken()
+ *
+ * A character of the string matches a character of the pattern if
+ * it is the same or, on invalid UTF-8, the start of it
+ */
+
+bool CWildPattern::MatchToken( const WILDTOKEN& token, const char* pszChar, size_t iLength ) const
+{
+   if ( token.bAnyChar )
+   {
+      return true;
+   }
+
+   if ( iLength > token.iLength )
+   {
+      return false;
+   }
+
+   const char* pszToken = m_sPattern.data() + token.iOffset;
+
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      if ( pszToken[iLoop] != pszChar[iLoop] )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * CWildPattern::MatchSegment()
+ *
+ * Compares the segment with the string at iStart, returns where it
+ * ends or WILDCMP_NONE
+ */
+
+size_t CWildPattern::MatchSegment( const WILDSEGMENT& segment, const char* pszString, 
+                                   size_t iStart, size_t iEnd ) const
+{
+   size_t iPos = iStart;
+
+   for ( size_t iLoop = 0; iLoop < segment.iTokens; iLoop++ )
+   {
+      if ( iPos >= iEnd )
+      {
+         return WILDCMP_NONE;
+      }
+
+      size_t iLength = GetCharLength( pszString + iPos );
+
+      if ( !MatchToken(m_vecTokens[segment.iToken + iLoop], pszString + iPos, iLength) )
+      {
+         return WILDCMP_NONE;
+      }
+
+      iPos += iLength;
+   }
+
+   return iPos;
+}
+
+/**
+ * CWildPattern::GetMask()
+ *
+ * The tokens of the segment the character matches
+ */
+
+void CWildPattern::GetMask( const WILDSEGMENT& segment, const char* pszChar, size_t iLength, 
+                            unsigned long long* pullMask ) const
+{
+   const unsigned long long* pullRow = &m_vecMasks[segment.iMask];
+
+   if ( iLength == 1 )
+   {
+      pullRow += m_vecClasses[segment.iClass + (unsigned char) *pszChar] * segment.iWords;
+   }
+
+   for ( size_t iWord = 0; iWord < segment.iWords; iWord++ )
+   {
+      pullMask[iWord] = pullRow[iWord];
+   }
+
+   if ( iLength == 1 )
+   {
+      return;
+   }
+
+   for ( size_t iLoop = 0; iLoop < segment.iWides; iLoop++ )
+   {
+      size_t iToken = m_vecWide[segment.iWide + iLoop];
+
+      if ( MatchToken(m_vecTokens[segment.iToken + iToken], pszChar, iLength) )
+      {
+         pullMask[iToken >> 6] |= 1ULL << (iToken & 63);
+      }
+   }
+}
+
+/**
+ * CWildPattern::FindSegment()
+ *
+ * The first place from iStart on where the segment matches, returns
+ * where it ends or WILDCMP_NONE. Every character is looked at once:
+ * bit n of the state is set while the last n + 1 characters match
+ * the first n + 1 tokens.
+ */
+
+size_t CWildPattern::FindSegment( const WILDSEGMENT& segment, const char* pszString, 
+                                  size_t iStart, size_t iEnd ) const
+{
+   unsigned long long aullState[WILDCMP_STACK_WORDS] = { 0 };
+   unsigned long long aullMask[WILDCMP_STACK_WORDS];
+
+   std::vector<unsigned long long> vecBuffer;
+
+   unsigned long long* pullState = aullState;
+   unsigned long long* pullMask = aullMask;
+
+   if ( segment.iWords > WILDCMP_STACK_WORDS )
+   {
+      vecBuffer.resize( segment.iWords * 2, 0 );
+
+      pullState = &vecBuffer[0];
+      pullMask = &vecBuffer[segment.iWords];
+   }
+
+   size_t iLastWord = segment.iWords - 1;
+
+   unsigned long long ullLastBit = 1ULL << ((segment.iTokens - 1) & 63);
+
+   // While no match is under way, memchr() jumps to the lead byte of
+   // the first token. A continuation byte only leads the first
+   // character of a string, so those are stepped through.
+
+   const WILDTOKEN& first = m_vecTokens[segment.iToken];
+
+   int iLead = (unsigned char) m_sPattern[first.iOffset];
+
+   if ( first.bAnyChar || ((iLead & 0xC0) == 0x80) )
+   {
+      iLead = -1;
+   }
+
+   bool bActive = false;
+
+   for ( size_t iPos = iStart; iPos < iEnd; )
+   {
+      if ( !bActive && (iLead >= 0) )
+      {
+         const char* pFound = (const char*) memchr( pszString + iPos, iLead, iEnd - iPos );
+
+         if ( !pFound )
+         {
+            return WILDCMP_NONE;
+         }
+
+         iPos = pFound - pszString;
+      }
+
+      size_t iLength = GetCharLength( pszString + iPos );
+
+      GetMask( segment, pszString + iPos, iLength, pullMask );
+
+      unsigned long long ullCarry = 1;
+
+      bActive = false;
+
+      for ( size_t iWord = 0; iWord < segment.iWords; iWord++ )
+      {
+         unsigned long long ullNext = ((pullState[iWord] << 1) | ullCarry) & pullMask[iWord];
+
+         ullCarry = pullState[iWord] >> 63;
+
+         pullState[iWord] = ullNext;
+
+         bActive = bActive || (ullNext != 0);
+      }
+
+      iPos += iLength;
+
+      if ( pullState[iLastWord] & ullLastBit )
+      {
+         return iPos;
+      }
+   }
+
+   return WILDCMP_NONE;
+}
+
+/**
+ * CWildPattern::Match()
+ *
+ * The first segment has to match at the start and the last one at
+ * the end. The ones in between are taken at the first place they
+ * match after the one before, which leaves the most room for the
+ * rest, so no choice is ever undone.
+ */
+
+bool CWildPattern::Match( const char* pszString ) const
+{
+   size_t iEnd = strlen( pszString );
+
+   size_t iPos = MatchSegment( m_vecSegments.front(), pszString, 0, iEnd );
+
+   if ( iPos == WILDCMP_NONE )
+   {
+      return false;
+   }
+
+   if ( !m_bWildcard )
+   {
+      return iPos == iEnd;
+   }
+
+   for ( size_t iSegment = 1; iSegment + 1 < m_vecSegments.size(); iSegment++ )
+   {
+      iPos = FindSegment( m_vecSegments[iSegment], pszString, iPos, iEnd );
+
+      if ( iPos == WILDCMP_NONE )
+      {
+         return false;
+      }
+   }
+
+   // Steps back over as many characters as the last segment has
+
+   const WILDSEGMENT& last = m_vecSegments.back();
+
+   size_t iStart = iEnd;
+
+   for ( size_t iLoop = 0; iLoop < last.iTokens; iLoop++ )
+   {
+      if ( iStart <= iPos )
+      {
+         return false;
+      }
+
+      do
+      {
+         iStart--;
+      } while ( (iStart > 0) && ((pszString[iStart] & 0xC0) == 0x80) );
+   }
+
+   return MatchSegment( last, pszString, iStart, iEnd ) != WILDCMP_NONE;
+}
@@ -0,0 +1,128 @@
+/**
+ * WildPattern.h - PuTTYCS compiled wildcard pattern
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WILDPATTERN_H__INCLUDED_)
+#define WILDPATTERN_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * CWildPattern
+ *
+ * A * and ? pattern compiled once and matched in time linear in the
+ * length of the string, whatever the pattern. The text before the
+ * first * and after the last * is compared in place; each part in
+ * between is found at its first place with a bit parallel
+ * (shift-and) scan, which jumps with memchr() to the next
+ * character that can start it. It matches what the backtracking
+ * CFilterMatch::WildCompare() did, including on invalid UTF-8.
+ */
+
+class CWildPattern
+{
+public:
+
+   CWildPattern();
+   CWildPattern( const char* pszWild );
+
+   void Compile( const char* pszWild );
+
+   bool Match( const char* pszString ) const;
+
+   const std::string& GetPattern() const;
+
+protected:
+
+   /**
+    * ? or one character of the pattern, in m_sPattern
+    */
+
+   struct WILDTOKEN
+   {
+      size_t iOffset;
+      size_t iLength;
+
+      bool bAnyChar;
+   };
+
+   /**
+    * The tokens between two *. A part in the middle maps each byte to
+    * a class from iClass on and each class to a row of iWords masks
+    * from iMask on, a bit per token the byte can start. Row 0 is the
+    * bytes no token starts with, so only ?. Its multibyte characters
+    * are listed from iWide on.
+    */
+
+   struct WILDSEGMENT
+   {
+      size_t iToken;
+      size_t iTokens;
+
+      size_t iClass;
+      size_t iMask;
+      size_t iWords;
+
+      size_t iWide;
+      size_t iWides;
+   };
+
+   bool MatchToken( const WILDTOKEN& token, const char* pszChar, size_t iLength ) const;
+
+   size_t MatchSegment( const WILDSEGMENT& segment, const char* pszString, size_t iStart, 
+                        size_t iEnd ) const;
+   size_t FindSegment( const WILDSEGMENT& segment, const char* pszString, size_t iStart, 
+                       size_t iEnd ) const;
+
+   void GetMask( const WILDSEGMENT& segment, const char* pszChar, size_t iLength, 
+                 unsigned long long* pullMask ) const;
+
+   static size_t GetCharLength( const char* psz );
+
+   std::string m_sPattern;
+
+   std::vector<WILDTOKEN> m_vecTokens;
+   std::vector<WILDSEGMENT> m_vecSegments;
+   std::vector<unsigned char> m_vecClasses;
+   std::vector<unsigned long long> m_vecMasks;
+   std::vector<size_t> m_vecWide;
+
+   bool m_bWildcard;
+};
+
+#endif // !defined(WILDPATTERN_H__INCLUDED_)
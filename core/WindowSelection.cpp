@@ -0,0 +1,652 @@
+/**
+ * WindowSelection.cpp - PuTTYCS window sets
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "WindowSelection.h"
+#include "FilterMatch.h"
+#include "WildPattern.h"
+
+#include <algorithm>
+
+static const char FILTER_INCLUDE = '+';
+static const char FILTER_EXCLUDE = '-';
+static const char FILTER_INTERSECT = '&';
+
+static const size_t SELECTION_WORD_BITS = 64;
+
+/**
+ * CWindowSelection::CWindowSelection()
+ */
+
+CWindowSelection::CWindowSelection( size_t iSize )
+{
+   m_iSize = 0;
+
+   Resize( iSize );
+}
+
+/**
+ * CWindowSelection::Resize()
+ *
+ * New slots are not selected
+ */
+
+void CWindowSelection::Resize( size_t iSize )
+{
+   m_vecWords.resize( (iSize + SELECTION_WORD_BITS - 1) / SELECTION_WORD_BITS, 0 );
+
+   if ( (iSize < m_iSize) && (iSize % SELECTION_WORD_BITS) )
+   {
+      m_vecWords.back() &= (1ULL << (iSize % SELECTION_WORD_BITS)) - 1;
+   }
+
+   m_iSize = iSize;
+}
+
+/**
+ * CWindowSelection::GetSize()
+ */
+
+size_t CWindowSelection::GetSize() const
+{
+   return m_iSize;
+}
+
+/**
+ * CWindowSelection::Set()
+ */
+
+void CWindowSelection::Set( size_t iSlot )
+{
+   if ( iSlot >= m_iSize )
+   {
+      Resize( iSlot + 1 );
+   }
+
+   m_vecWords[iSlot / SELECTION_WORD_BITS] |= 1ULL << (iSlot % SELECTION_WORD_BITS);
+}
+
+/**
+ * CWindowSelection::Reset()
+ */
+
+void CWindowSelection::Reset( size_t iSlot )
+{
+   if ( iSlot < m_iSize )
+   {
+      m_vecWords[iSlot / SELECTION_WORD_BITS] &= ~(1ULL << (iSlot % SELECTION_WORD_BITS));
+   }
+}
+
+/**
+ * CWindowSelection::Test()
+ */
+
+bool CWindowSelection::Test( size_t iSlot ) const
+{
+   return (iSlot < m_iSize) && 
+      ((m_vecWords[iSlot / SELECTION_WORD_BITS] >> (iSlot % SELECTION_WORD_BITS)) & 1);
+}
+
+/**
+ * CWindowSelection::Clear()
+ */
+
+void CWindowSelection::Clear()
+{
+   std::fill( m_vecWords.begin(), m_vecWords.end(), 0 );
+}
+
+/**
+ * CWindowSelection::IsEmpty()
+ */
+
+bool CWindowSelection::IsEmpty() const
+{
+   for ( size_t iWord = 0; iWord < m_vecWords.size(); iWord++ )
+   {
+      if ( m_vecWords[iWord] )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * CWindowSelection::Count()
+ */
+
+size_t CWindowSelection::Count() const
+{
+   size_t iCount = 0;
+
+   for ( size_t iWord = 0; iWord < m_vecWords.size(); iWord++ )
+   {
+      iCount += CountBits( m_vecWords[iWord] );
+   }
+
+   return iCount;
+}
+
+/**
+ * CWindowSelection::Union()
+ *
+ * The binary operations grow this selection to the larger size,
+ * the missing slots of the smaller one count as not selected
+ */
+
+void CWindowSelection::Union( const CWindowSelection& selection )
+{
+   if ( selection.m_iSize > m_iSize )
+   {
+      Resize( selection.m_iSize );
+   }
+
+   for ( size_t iWord = 0; iWord < selection.m_vecWords.size(); iWord++ )
+   {
+      m_vecWords[iWord] |= selection.m_vecWords[iWord];
+   }
+}
+
+/**
+ * CWindowSelection::Intersect()
+ */
+
+void CWindowSelection::Intersect( const CWindowSelection& selection )
+{
+   if ( selection.m_iSize > m_iSize )
+   {
+      Resize( selection.m_iSize );
+   }
+
+   for ( size_t iWord = 0; iWord < m_vecWords.size(); iWord++ )
+   {
+      m_vecWords[iWord] &= (iWord < selection.m_vecWords.size()) ? selection.m_vecWords[iWord] : 0;
+   }
+}
+
+/**
+ * CWindowSelection::Subtract()
+ */
+
+void CWindowSelection::Subtract( const CWindowSelection& selection )
+{
+   if ( selection.m_iSize > m_iSize )
+   {
+      Resize( selection.m_iSize );
+   }
+
+   for ( size_t iWord = 0; iWord < selection.m_vecWords.size(); iWord++ )
+   {
+      m_vecWords[iWord] &= ~selection.m_vecWords[iWord];
+   }
+}
+
+/**
+ * CWindowSelection::GetSlots()
+ *
+ * The selected slots in ascending order
+ */
+
+void CWindowSelection::GetSlots( std::vector<size_t>& vecSlots ) const
+{
+   vecSlots.clear();
+
+   for ( size_t iWord = 0; iWord < m_vecWords.size(); iWord++ )
+   {
+      for ( uint64_t ullWord = m_vecWords[iWord]; ullWord; ullWord &= ullWord - 1 )
+      {
+         vecSlots.push_back( iWord * SELECTION_WORD_BITS + LowestBit(ullWord) );
+      }
+   }
+}
+
+/**
+ * CWindowSelection::CountBits()
+ */
+
+int CWindowSelection::CountBits( uint64_t ullWord )
+{
+#if defined(__GNUC__)
+   return __builtin_popcountll( ullWord );
+#else
+   ullWord = ullWord - ((ullWord >> 1) & 0x5555555555555555ULL);
+   ullWord = (ullWord & 0x3333333333333333ULL) + ((ullWord >> 2) & 0x3333333333333333ULL);
+   ullWord = (ullWord + (ullWord >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+   return (int) ((ullWord * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * CWindowSelection::LowestBit()
+ *
+ * ullWord must not be 0
+ */
+
+int CWindowSelection::LowestBit( uint64_t ullWord )
+{
+#if defined(__GNUC__)
+   return __builtin_ctzll( ullWord );
+#else
+   return CountBits( (ullWord & (0 - ullWord)) - 1 );
+#endif
+}
+
+/**
+ * CWindowIndex::CWindowIndex()
+ */
+
+CWindowIndex::CWindowIndex()
+{
+}
+
+/**
+ * CWindowIndex::Update()
+ *
+ * Takes a new enumeration of the terminal windows. Slots of closed
+ * windows are reused, so selections made before an update must not
+ * be used after it. Returns true if anything changed.
+ */
+
+bool CWindowIndex::Update( const std::vector<WINDOWINFO>& vecWindows )
+{
+   bool bChanged = false;
+
+   CWindowSelection wsSeen( m_vecSlots.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      const WINDOWINFO& window = vecWindows[iLoop];
+
+      std::unordered_map<WINDOWID, size_t>::iterator it = m_mapSlots.find( window.id );
+
+      if ( it != m_mapSlots.end() )
+      {
+         WINDOWINFO& slot = m_vecSlots[it->second];
+
+         slot.iFlags = window.iFlags;
+
+         if ( slot.sTitle != window.sTitle )
+         {
+            slot.sTitle = window.sTitle;
+
+            bChanged = true;
+         }
+
+         wsSeen.Set( it->second );
+
+         continue;
+      }
+
+      size_t iSlot = m_vecSlots.size();
+
+      if ( !m_vecFree.empty() )
+      {
+         iSlot = m_vecFree.back();
+         m_vecFree.pop_back();
+
+         m_vecSlots[iSlot] = window;
+      }
+      else
+      {
+         m_vecSlots.push_back( window );
+      }
+
+      m_mapSlots[window.id] = iSlot;
+
+      m_wsAlive.Set( iSlot );
+      wsSeen.Set( iSlot );
+
+      bChanged = true;
+   }
+
+   CWindowSelection wsClosed = m_wsAlive;
+   wsClosed.Subtract( wsSeen );
+
+   std::vector<size_t> vecClosed;
+   wsClosed.GetSlots( vecClosed );
+
+   for ( size_t iLoop = 0; iLoop < vecClosed.size(); iLoop++ )
+   {
+      size_t iSlot = vecClosed[iLoop];
+
+      m_mapSlots.erase( m_vecSlots[iSlot].id );
+      m_mapHosts.erase( m_vecSlots[iSlot].id );
+      m_vecSlots[iSlot] = WINDOWINFO();
+
+      m_vecFree.push_back( iSlot );
+
+      bChanged = true;
+   }
+
+   m_wsAlive.Subtract( wsClosed );
+   m_wsPinned.Subtract( wsClosed );
+   m_wsUnpinned.Subtract( wsClosed );
+
+   m_wsAlive.Resize( m_vecSlots.size() );
+   m_wsPinned.Resize( m_vecSlots.size() );
+   m_wsUnpinned.Resize( m_vecSlots.size() );
+
+   if ( bChanged )
+   {
+      m_mapCache.clear();
+   }
+
+   return bChanged;
+}
+
+/**
+ * CWindowIndex::SetFilters()
+ *
+ * The saved filters @name references resolve to
+ */
+
+void CWindowIndex::SetFilters( const std::vector<std::string>& vecFilters )
+{
+   if ( vecFilters != m_vecFilters )
+   {
+      m_vecFilters = vecFilters;
+
+      m_mapCache.clear();
+   }
+}
+
+/**
+ * CWindowIndex::SetHost()
+ *
+ * The window may not have been enumerated yet; its host name is
+ * dropped when it closes. An empty name removes it.
+ */
+
+void CWindowIndex::SetHost( WINDOWID id, const std::string& sHost )
+{
+   if ( sHost.empty() )
+   {
+      m_mapHosts.erase( id );
+   }
+   else
+   {
+      m_mapHosts[id] = sHost;
+   }
+
+   m_mapCache.clear();
+}
+
+/**
+ * CWindowIndex::GetHost()
+ */
+
+const std::string& CWindowIndex::GetHost( WINDOWID id ) const
+{
+   static const std::string s_sNone;
+
+   std::unordered_map<WINDOWID, std::string>::const_iterator it = m_mapHosts.find( id );
+
+   return (it != m_mapHosts.end()) ? it->second : s_sNone;
+}
+
+/**
+ * CWindowIndex::Select()
+ *
+ * The windows of a filter, with the pins applied
+ */
+
+void CWindowIndex::Select( const std::string& sEntry, CWindowSelection& selection )
+{
+   Evaluate( sEntry, selection );
+
+   selection.Union( m_wsPinned );
+   selection.Subtract( m_wsUnpinned );
+}
+
+/**
+ * CWindowIndex::Evaluate()
+ *
+ * The windows of a filter, without the pins
+ */
+
+void CWindowIndex::Evaluate( const std::string& sEntry, CWindowSelection& selection )
+{
+   Evaluate( sEntry, selection, 0 );
+}
+
+/**
+ * CWindowIndex::Evaluate()
+ *
+ * Includes are united, then cut down by every intersection and the
+ * excludes taken out. A reference nested too deep, which is how a
+ * cycle ends, and a reference to an unknown filter select nothing.
+ */
+
+void CWindowIndex::Evaluate( const std::string& sEntry, CWindowSelection& selection, int iDepth )
+{
+   std::unordered_map<std::string, CWindowSelection>::const_iterator it = m_mapCache.find( sEntry );
+
+   if ( it != m_mapCache.end() )
+   {
+      selection = it->second;
+
+      return;
+   }
+
+   std::vector<FILTERITEM> vecItems;
+   CFilterMatch::GetFilterItems( sEntry, vecItems );
+
+   CWindowSelection wsInclude( m_vecSlots.size() );
+   CWindowSelection wsExclude( m_vecSlots.size() );
+   CWindowSelection wsWithin = m_wsAlive;
+
+   CWindowSelection wsItem( m_vecSlots.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecItems.size(); iLoop++ )
+   {
+      const FILTERITEM& item = vecItems[iLoop];
+
+      if ( item.bReference )
+      {
+         std::string sReference;
+
+         wsItem.Clear();
+
+         if ( (iDepth < MAX_REFERENCE_DEPTH) && FindFilter(item.sPattern, sReference) )
+         {
+            Evaluate( sReference, wsItem, iDepth + 1 );
+         }
+      }
+      else
+      {
+         SelectPattern( item.sPattern, wsItem );
+      }
+
+      switch ( item.chOperator )
+      {
+         case FILTER_EXCLUDE:
+            wsExclude.Union( wsItem );
+            break;
+
+         case FILTER_INTERSECT:
+            wsWithin.Intersect( wsItem );
+            break;
+
+         default:
+            wsInclude.Union( wsItem );
+            break;
+      }
+   }
+
+   wsInclude.Intersect( wsWithin );
+   wsInclude.Subtract( wsExclude );
+
+   m_mapCache[sEntry] = wsInclude;
+
+   selection = wsInclude;
+}
+
+/**
+ * CWindowIndex::SelectPattern()
+ */
+
+void CWindowIndex::SelectPattern( const std::string& sPattern, CWindowSelection& selection ) const
+{
+   selection.Resize( m_vecSlots.size() );
+   selection.Clear();
+
+   std::vector<size_t> vecSlots;
+   m_wsAlive.GetSlots( vecSlots );
+
+   CWildPattern wpPattern( sPattern.c_str() );
+
+   for ( size_t iLoop = 0; iLoop < vecSlots.size(); iLoop++ )
+   {
+      const WINDOWINFO& window = m_vecSlots[vecSlots[iLoop]];
+      const std::string& sHost = GetHost( window.id );
+
+      if ( wpPattern.Match(window.sTitle.c_str()) ||
+           (!sHost.empty() && wpPattern.Match(sHost.c_str())) )
+      {
+         selection.Set( vecSlots[iLoop] );
+      }
+   }
+}
+
+/**
+ * CWindowIndex::FindFilter()
+ */
+
+bool CWindowIndex::FindFilter( const std::string& sName, std::string& sEntry ) const
+{
+   if ( sName.empty() || (sName[0] == FILTER_INCLUDE) || (sName[0] == FILTER_EXCLUDE) || 
+        (sName[0] == FILTER_INTERSECT) )
+   {
+      return false;
+   }
+
+   return CFilterMatch::ResolveFilter( m_vecFilters, sName, sEntry );
+}
+
+/**
+ * CWindowIndex::Pin()
+ *
+ * PIN_ADD pins the windows into every selection, PIN_REMOVE keeps
+ * them out of every selection, PIN_RELEASE lets their filters decide
+ * again
+ */
+
+void CWindowIndex::Pin( const CWindowSelection& selection, int iPin )
+{
+   CWindowSelection wsWindows = selection;
+   wsWindows.Intersect( m_wsAlive );
+
+   m_wsPinned.Subtract( wsWindows );
+   m_wsUnpinned.Subtract( wsWindows );
+
+   if ( iPin == PIN_ADD )
+   {
+      m_wsPinned.Union( wsWindows );
+   }
+   else if ( iPin == PIN_REMOVE )
+   {
+      m_wsUnpinned.Union( wsWindows );
+   }
+}
+
+/**
+ * CWindowIndex::GetPinned()
+ */
+
+const CWindowSelection& CWindowIndex::GetPinned() const
+{
+   return m_wsPinned;
+}
+
+/**
+ * CWindowIndex::GetUnpinned()
+ */
+
+const CWindowSelection& CWindowIndex::GetUnpinned() const
+{
+   return m_wsUnpinned;
+}
+
+/**
+ * CWindowIndex::GetAlive()
+ */
+
+const CWindowSelection& CWindowIndex::GetAlive() const
+{
+   return m_wsAlive;
+}
+
+/**
+ * CWindowIndex::GetWindow()
+ */
+
+const WINDOWINFO& CWindowIndex::GetWindow( size_t iSlot ) const
+{
+   return m_vecSlots[iSlot];
+}
+
+/**
+ * CWindowIndex::GetWindows()
+ *
+ * The windows of a selection in slot order, assigned over the
+ * elements already in vecWindows
+ */
+
+void CWindowIndex::GetWindows( const CWindowSelection& selection, std::vector<WINDOWINFO>& vecWindows ) const
+{
+   size_t iWindow = 0;
+   size_t iSlots = (selection.GetSize() < m_vecSlots.size()) ? selection.GetSize() : m_vecSlots.size();
+
+   for ( size_t iSlot = 0; iSlot < iSlots; iSlot++ )
+   {
+      if ( !selection.Test(iSlot) || !m_wsAlive.Test(iSlot) )
+      {
+         continue;
+      }
+
+      if ( iWindow < vecWindows.size() )
+      {
+         vecWindows[iWindow] = m_vecSlots[iSlot];
+      }
+      else
+      {
+         vecWindows.push_back( m_vecSlots[iSlot] );
+      }
+
+      iWindow++;
+   }
+
+   vecWindows.resize( iWindow );
+}
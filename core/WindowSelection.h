@@ -0,0 +1,163 @@
+/**
+ * WindowSelection.h - PuTTYCS window sets header
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WINDOWSELECTION_H__INCLUDED_)
+#define WINDOWSELECTION_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "WindowSystem.h"
+
+/**
+ * CWindowSelection
+ *
+ * A set of windows as a bitset over the slots of a CWindowIndex, so
+ * union, intersection and difference cost one word operation per
+ * 64 windows
+ */
+
+class CWindowSelection
+{
+public:
+
+   CWindowSelection( size_t iSize = 0 );
+
+   void Resize( size_t iSize );
+   size_t GetSize() const;
+
+   void Set( size_t iSlot );
+   void Reset( size_t iSlot );
+   bool Test( size_t iSlot ) const;
+
+   void Clear();
+   bool IsEmpty() const;
+   size_t Count() const;
+
+   void Union( const CWindowSelection& selection );
+   void Intersect( const CWindowSelection& selection );
+   void Subtract( const CWindowSelection& selection );
+
+   void GetSlots( std::vector<size_t>& vecSlots ) const;
+
+protected:
+
+   static int CountBits( uint64_t ullWord );
+   static int LowestBit( uint64_t ullWord );
+
+   size_t m_iSize;
+
+   std::vector<uint64_t> m_vecWords;
+};
+
+/**
+ * CWindowIndex
+ *
+ * Gives every terminal window a slot that stays the same while the
+ * window lives, so selections can be kept and combined between
+ * enumerations. Evaluates filters into selections, resolving @name
+ * references to the saved filters, and caches the result of each
+ * filter until a window opens, closes or changes its title. Pinned
+ * windows are added to, unpinned windows taken out of, every
+ * selection made by Select(). A window may also have a host name,
+ * such as the host it was launched for, which patterns match as
+ * well as its title.
+ */
+
+class CWindowIndex
+{
+public:
+
+   enum
+   {
+      PIN_ADD = 0,
+      PIN_REMOVE,
+      PIN_RELEASE
+   };
+
+   CWindowIndex();
+
+   bool Update( const std::vector<WINDOWINFO>& vecWindows );
+
+   void SetFilters( const std::vector<std::string>& vecFilters );
+
+   void SetHost( WINDOWID id, const std::string& sHost );
+   const std::string& GetHost( WINDOWID id ) const;
+
+   void Select( const std::string& sEntry, CWindowSelection& selection );
+   void Evaluate( const std::string& sEntry, CWindowSelection& selection );
+
+   void Pin( const CWindowSelection& selection, int iPin );
+   const CWindowSelection& GetPinned() const;
+   const CWindowSelection& GetUnpinned() const;
+
+   const CWindowSelection& GetAlive() const;
+   const WINDOWINFO& GetWindow( size_t iSlot ) const;
+
+   void GetWindows( const CWindowSelection& selection, std::vector<WINDOWINFO>& vecWindows ) const;
+
+protected:
+
+   enum
+   {
+      MAX_REFERENCE_DEPTH = 8
+   };
+
+   void Evaluate( const std::string& sEntry, CWindowSelection& selection, int iDepth );
+   void SelectPattern( const std::string& sPattern, CWindowSelection& selection ) const;
+
+   bool FindFilter( const std::string& sName, std::string& sEntry ) const;
+
+   std::vector<WINDOWINFO> m_vecSlots;
+   std::vector<size_t> m_vecFree;
+
+   std::unordered_map<WINDOWID, size_t> m_mapSlots;
+
+   CWindowSelection m_wsAlive;
+   CWindowSelection m_wsPinned;
+   CWindowSelection m_wsUnpinned;
+
+   std::vector<std::string> m_vecFilters;
+
+   std::unordered_map<std::string, CWindowSelection> m_mapCache;
+
+   std::unordered_map<WINDOWID, std::string> m_mapHosts;
+};
+
+#endif // !defined(WINDOWSELECTION_H__INCLUDED_)
@@ -0,0 +1,437 @@
+/**
+ * WindowSnapshot.cpp - PuTTYCS window layout snapshot
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include "WindowSnapshot.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <unordered_map>
+
+/**
+ * Format version, first field of Save()
+ */
+
+#define SNAPSHOT_VERSION   "1"
+
+/**
+ * CWindowSnapshot::CWindowSnapshot()
+ */
+
+CWindowSnapshot::CWindowSnapshot()
+{
+}
+
+/**
+ * CWindowSnapshot::~CWindowSnapshot()
+ */
+
+CWindowSnapshot::~CWindowSnapshot()
+{
+}
+
+/**
+ * CWindowSnapshot::SetName()
+ */
+
+void CWindowSnapshot::SetName( const std::string& sName )
+{
+   m_sName = sName;
+}
+
+/**
+ * CWindowSnapshot::GetName()
+ */
+
+const std::string& CWindowSnapshot::GetName() const
+{
+   return m_sName;
+}
+
+/**
+ * CWindowSnapshot::Capture()
+ *
+ * Records every terminal window, top of the z-order first. Returns
+ * the number of windows.
+ */
+
+size_t CWindowSnapshot::Capture( CWindowSystem* pWindowSystem )
+{
+   m_vecEntries.clear();
+
+   std::vector<WINDOWINFO> vecWindows;
+   pWindowSystem->EnumTerminalWindows( vecWindows );
+
+   m_vecEntries.reserve( vecWindows.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      SNAPSHOTENTRY entry;
+
+      if ( pWindowSystem->GetWindowState(vecWindows[iLoop].id, entry.state) )
+      {
+         entry.sTitle = vecWindows[iLoop].sTitle;
+
+         m_vecEntries.push_back( entry );
+      }
+   }
+
+   return m_vecEntries.size();
+}
+
+/**
+ * CWindowSnapshot::Restore()
+ *
+ * Puts the windows back where they were. A window is found by its
+ * handle if that still has the same title, otherwise by the title,
+ * so a saved snapshot also fits the windows of a later session.
+ * Windows that are not in the snapshot are left alone. Returns the
+ * number of windows placed.
+ */
+
+int CWindowSnapshot::Restore( CWindowSystem* pWindowSystem, double* pdMs ) const
+{
+   std::vector<WINDOWINFO> vecWindows;
+   pWindowSystem->EnumTerminalWindows( vecWindows );
+
+   std::unordered_map<WINDOWID, size_t> mapIds;
+   std::unordered_map<std::string, std::vector<size_t> > mapTitles;
+
+   mapIds.reserve( vecWindows.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      mapIds[vecWindows[iLoop].id] = iLoop;
+   }
+
+   for ( size_t iLoop = vecWindows.size(); iLoop > 0; iLoop-- )
+   {
+      mapTitles[vecWindows[iLoop - 1].sTitle].push_back( iLoop - 1 );
+   }
+
+   std::vector<bool> vecUsed( vecWindows.size(), false );
+   std::vector<size_t> vecMatch( m_vecEntries.size(), vecWindows.size() );
+
+   for ( size_t iLoop = 0; iLoop < m_vecEntries.size(); iLoop++ )
+   {
+      std::unordered_map<WINDOWID, size_t>::const_iterator it =
+         mapIds.find( m_vecEntries[iLoop].state.id );
+
+      if ( (it != mapIds.end()) && !vecUsed[it->second] &&
+           (vecWindows[it->second].sTitle == m_vecEntries[iLoop].sTitle) )
+      {
+         vecUsed[it->second] = true;
+         vecMatch[iLoop] = it->second;
+      }
+   }
+
+   /**
+    * Titles are taken in enumeration order, the lists are reversed
+    * so the next window is at the back
+    */
+
+   for ( size_t iLoop = 0; iLoop < m_vecEntries.size(); iLoop++ )
+   {
+      if ( vecMatch[iLoop] < vecWindows.size() )
+      {
+         continue;
+      }
+
+      std::unordered_map<std::string, std::vector<size_t> >::iterator it =
+         mapTitles.find( m_vecEntries[iLoop].sTitle );
+
+      while ( (it != mapTitles.end()) && !it->second.empty() )
+      {
+         size_t iWindow = it->second.back();
+         it->second.pop_back();
+
+         if ( !vecUsed[iWindow] )
+         {
+            vecUsed[iWindow] = true;
+            vecMatch[iLoop] = iWindow;
+
+            break;
+         }
+      }
+   }
+
+   std::vector<WINDOWSTATE> vecStates;
+   vecStates.reserve( m_vecEntries.size() );
+
+   for ( size_t iLoop = 0; iLoop < m_vecEntries.size(); iLoop++ )
+   {
+      if ( vecMatch[iLoop] < vecWindows.size() )
+      {
+         WINDOWSTATE state = m_vecEntries[iLoop].state;
+         state.id = vecWindows[vecMatch[iLoop]].id;
+
+         vecStates.push_back( state );
+      }
+   }
+
+   double dMs = 0.0;
+
+   if ( !vecStates.empty() )
+   {
+      dMs = pWindowSystem->SetWindowStates( vecStates );
+   }
+
+   if ( pdMs )
+   {
+      *pdMs = dMs;
+   }
+
+   return (int) vecStates.size();
+}
+
+/**
+ * CWindowSnapshot::GetCount()
+ */
+
+size_t CWindowSnapshot::GetCount() const
+{
+   return m_vecEntries.size();
+}
+
+/**
+ * CWindowSnapshot::GetEntry()
+ */
+
+bool CWindowSnapshot::GetEntry( size_t iIndex, std::string& sTitle, WINDOWSTATE& state ) const
+{
+   if ( iIndex >= m_vecEntries.size() )
+   {
+      return false;
+   }
+
+   sTitle = m_vecEntries[iIndex].sTitle;
+   state = m_vecEntries[iIndex].state;
+
+   return true;
+}
+
+/**
+ * CWindowSnapshot::Save()
+ *
+ * version;name;x,y,width,height,flags,id,title;... on one line, with
+ * '%', ';' and control characters of the texts written as %XX
+ */
+
+std::string CWindowSnapshot::Save() const
+{
+   std::string sSaved = SNAPSHOT_VERSION ";";
+
+   sSaved.reserve( 64 + (m_vecEntries.size() * 48) );
+
+   AppendEscaped( sSaved, m_sName );
+
+   for ( size_t iLoop = 0; iLoop < m_vecEntries.size(); iLoop++ )
+   {
+      const WINDOWSTATE& state = m_vecEntries[iLoop].state;
+
+      char szFields[128];
+
+      snprintf( szFields, sizeof(szFields), ";%d,%d,%d,%d,%d,%llx,",
+         state.iX, state.iY, state.iWidth, state.iHeight, state.iFlags, 
+         (unsigned long long) state.id );
+
+      sSaved += szFields;
+
+      AppendEscaped( sSaved, m_vecEntries[iLoop].sTitle );
+   }
+
+   return sSaved;
+}
+
+/**
+ * CWindowSnapshot::Load()
+ *
+ * Reads what Save() wrote. Returns false, and leaves the snapshot
+ * empty, if the text is not a snapshot.
+ */
+
+bool CWindowSnapshot::Load( const std::string& sSaved )
+{
+   Clear();
+
+   size_t iVersion = sSaved.find( ';' );
+
+   if ( (iVersion == std::string::npos) || (sSaved.compare(0, iVersion, SNAPSHOT_VERSION) != 0) )
+   {
+      return false;
+   }
+
+   size_t iStart = iVersion + 1;
+   size_t iEnd = sSaved.find( ';', iStart );
+
+   if ( iEnd == std::string::npos )
+   {
+      iEnd = sSaved.size();
+   }
+
+   m_sName = Unescape( sSaved, iStart, iEnd );
+
+   while ( iEnd < sSaved.size() )
+   {
+      iStart = iEnd + 1;
+      iEnd = sSaved.find( ';', iStart );
+
+      if ( iEnd == std::string::npos )
+      {
+         iEnd = sSaved.size();
+      }
+
+      SNAPSHOTENTRY entry;
+
+      const char* pszField = sSaved.c_str() + iStart;
+      char* pszNext = NULL;
+
+      int* pFields[] = { &entry.state.iX, &entry.state.iY, 
+                         &entry.state.iWidth, &entry.state.iHeight, &entry.state.iFlags };
+
+      bool bValid = true;
+
+      for ( size_t iField = 0; bValid && (iField < sizeof(pFields) / sizeof(pFields[0])); iField++ )
+      {
+         *pFields[iField] = (int) strtol( pszField, &pszNext, 10 );
+
+         bValid = (pszNext != pszField) && (*pszNext == ',');
+         pszField = pszNext + 1;
+      }
+
+      if ( bValid )
+      {
+         entry.state.id = (WINDOWID) strtoull( pszField, &pszNext, 16 );
+
+         bValid = (pszNext != pszField) && (*pszNext == ',');
+      }
+
+      if ( !bValid || ((size_t) (pszNext - sSaved.c_str()) >= iEnd) )
+      {
+         Clear();
+
+         return false;
+      }
+
+      entry.sTitle = Unescape( sSaved, (pszNext - sSaved.c_str()) + 1, iEnd );
+
+      m_vecEntries.push_back( entry );
+   }
+
+   return true;
+}
+
+/**
+ * CWindowSnapshot::Clear()
+ */
+
+void CWindowSnapshot::Clear()
+{
+   m_sName.clear();
+   m_vecEntries.clear();
+}
+
+/**
+ * CWindowSnapshot::GetName()
+ *
+ * Name of a saved snapshot, without loading the windows
+ */
+
+std::string CWindowSnapshot::GetName( const std::string& sSaved )
+{
+   size_t iStart = sSaved.find( ';' );
+
+   if ( (iStart == std::string::npos) || (sSaved.compare(0, iStart, SNAPSHOT_VERSION) != 0) )
+   {
+      return std::string();
+   }
+
+   iStart++;
+
+   size_t iEnd = sSaved.find( ';', iStart );
+
+   return Unescape( sSaved, iStart, (iEnd == std::string::npos) ? sSaved.size() : iEnd );
+}
+
+/**
+ * CWindowSnapshot::AppendEscaped()
+ */
+
+void CWindowSnapshot::AppendEscaped( std::string& sOut, const std::string& sText )
+{
+   static const char szHex[] = "0123456789ABCDEF";
+
+   for ( size_t iLoop = 0; iLoop < sText.size(); iLoop++ )
+   {
+      unsigned char ucChar = (unsigned char) sText[iLoop];
+
+      if ( (ucChar < 0x20) || (ucChar == 0x7F) || (ucChar == '%') || (ucChar == ';') )
+      {
+         sOut += '%';
+         sOut += szHex[ucChar >> 4];
+         sOut += szHex[ucChar & 0x0F];
+      }
+      else
+      {
+         sOut += (char) ucChar;
+      }
+   }
+}
+
+/**
+ * CWindowSnapshot::Unescape()
+ */
+
+std::string CWindowSnapshot::Unescape( const std::string& sText, size_t iStart, size_t iEnd )
+{
+   std::string sOut;
+   sOut.reserve( iEnd - iStart );
+
+   for ( size_t iLoop = iStart; iLoop < iEnd; iLoop++ )
+   {
+      if ( (sText[iLoop] == '%') && (iLoop + 2 < iEnd) && 
+           isxdigit((unsigned char) sText[iLoop + 1]) && isxdigit((unsigned char) sText[iLoop + 2]) )
+      {
+         char szHex[3] = { sText[iLoop + 1], sText[iLoop + 2], 0 };
+
+         sOut += (char) strtol( szHex, NULL, 16 );
+         iLoop += 2;
+      }
+      else
+      {
+         sOut += sText[iLoop];
+      }
+   }
+
+   return sOut;
+}
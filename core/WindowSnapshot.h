@@ -0,0 +1,94 @@
+/**
+ * WindowSnapshot.h - PuTTYCS window layout snapshot
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WINDOWSNAPSHOT_H__INCLUDED_)
+#define WINDOWSNAPSHOT_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+#include "WindowSystem.h"
+
+/**
+ * CWindowSnapshot
+ *
+ * The position, size, visibility, minimized state and z-order of
+ * every terminal window, under a name. Save() packs it into one line
+ * of text for the configuration file. Restore() finds the windows
+ * again, by handle while they live and by title after that, and
+ * hands all placements to the window system at once.
+ */
+
+class CWindowSnapshot
+{
+public:
+
+   CWindowSnapshot();
+   virtual ~CWindowSnapshot();
+
+   void SetName( const std::string& sName );
+   const std::string& GetName() const;
+
+   size_t Capture( CWindowSystem* pWindowSystem );
+   int Restore( CWindowSystem* pWindowSystem, double* pdMs = NULL ) const;
+
+   size_t GetCount() const;
+   bool GetEntry( size_t iIndex, std::string& sTitle, WINDOWSTATE& state ) const;
+
+   std::string Save() const;
+   bool Load( const std::string& sSaved );
+
+   void Clear();
+
+   static std::string GetName( const std::string& sSaved );
+
+protected:
+
+   struct SNAPSHOTENTRY
+   {
+      std::string sTitle;
+      WINDOWSTATE state;
+   };
+
+   static void AppendEscaped( std::string& sOut, const std::string& sText );
+   static std::string Unescape( const std::string& sText, size_t iStart, size_t iEnd );
+
+   std::string m_sName;
+
+   std::vector<SNAPSHOTENTRY> m_vecEntries;
+};
+
+#endif // !defined(WINDOWSNAPSHOT_H__INCLUDED_)
@@ -0,0 +1,182 @@
+/**
+ * WindowSystem.h - PuTTYCS window system interface
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#if !defined(WINDOWSYSTEM_H__INCLUDED_)
+#define WINDOWSYSTEM_H__INCLUDED_
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include <vector>
+
+/**
+ * Opaque window handle of a window system (an HWND on Win32)
+ */
+
+typedef unsigned long long WINDOWID;
+
+/**
+ * Kind of terminal window
+ */
+
+enum
+{
+   WINDOWCLASS_PUTTY = 0,
+   WINDOWCLASS_PUTTYTEL,
+   WINDOWCLASS_TUTTY,
+   WINDOWCLASS_PIETTY,
+   WINDOWCLASS_PTY
+};
+
+/**
+ * Show state of a terminal window
+ */
+
+#define WINDOWSTATE_VISIBLE      0x01
+#define WINDOWSTATE_MINIMIZED    0x02
+#define WINDOWSTATE_MAXIMIZED    0x04
+
+/**
+ * How a wait ended: on its condition, on its timeout, or after the
+ * fixed delay of a window it can not watch
+ */
+
+enum
+{
+   WAITOUTCOME_MET = 0,
+   WAITOUTCOME_TIMEOUT,
+   WAITOUTCOME_FIXED
+};
+
+/**
+ * A top level terminal window, with the show state it had when it
+ * was enumerated
+ */
+
+struct WINDOWINFO
+{
+   WINDOWID id;
+
+   std::string sTitle;
+
+   int iClass;
+   int iFlags;
+};
+
+/**
+ * Placement of a terminal window. The rectangle is the restored
+ * (normal) position in screen coordinates, also while minimized,
+ * maximized or hidden.
+ */
+
+struct WINDOWSTATE
+{
+   WINDOWID id;
+
+   int iX;
+   int iY;
+   int iWidth;
+   int iHeight;
+
+   int iFlags;
+};
+
+/**
+ * CWindowSystem
+ *
+ * What the broadcast engine needs from the desktop. Every step that
+ * takes time returns how long it took in ms, so a simulated backend
+ * can run on a virtual clock. Strings are UTF-8, keys use the
+ * CSendKeys syntax.
+ */
+
+class CWindowSystem
+{
+public:
+
+   virtual ~CWindowSystem() {}
+
+   /**
+    * vecWindows may still hold an earlier enumeration; backends
+    * assign over its elements, so the titles keep their buffers
+    */
+
+   virtual void EnumTerminalWindows( std::vector<WINDOWINFO>& vecWindows ) = 0;
+
+   virtual double Activate( WINDOWID id ) = 0;
+   virtual bool IsForeground( WINDOWID id ) = 0;
+
+   /**
+    * The waits set *piOutcome to a WAITOUTCOME_ value. A timed out
+    * wait returns its timeout, so the window took at least that long.
+    */
+
+   virtual double WaitForForeground( WINDOWID id, unsigned long ulFixedMs, 
+                                     int* piOutcome ) = 0;
+
+   virtual double SendKeys( WINDOWID id, const std::string& sKeys ) = 0;
+
+   virtual double WaitForInputIdle( WINDOWID id, unsigned long ulFixedMs, 
+                                    int* piOutcome ) = 0;
+
+   virtual bool GetCapsLock() = 0;
+
+   /**
+    * Called once the keys went to every window of a send, for
+    * backends that queue them. Returns the ms it took.
+    */
+
+   virtual double Flush() 
+   { 
+      return 0.0; 
+   }
+
+   /**
+    * Window placement, for backends that can move windows.
+    * SetWindowStates() applies all states in one go; they are
+    * ordered top of the z-order first. Returns the ms it took.
+    */
+
+   virtual bool GetWindowState( WINDOWID /*id*/, WINDOWSTATE& /*state*/ )
+   {
+      return false;
+   }
+
+   virtual double SetWindowStates( const std::vector<WINDOWSTATE>& /*vecStates*/ )
+   {
+      return 0.0;
+   }
+};
+
+#endif // !defined(WINDOWSYSTEM_H__INCLUDED_)
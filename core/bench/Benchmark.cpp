@@ -0,0 +1,1479 @@
+/**
+ * Benchmark.cpp - PuTTYCS core benchmarks
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Base64Codec.h"
+#include "BroadcastEngine.h"
+#include "CommandHistory.h"
+#include "FilterMatch.h"
+#include "HostInventory.h"
+#include "KeyProgram.h"
+#include "KeyProgramCache.h"
+#include "KeyTokenizer.h"
+#include "SendTemplate.h"
+#include "SendTrace.h"
+#include "SessionLauncher.h"
+#include "SimProcessSpawner.h"
+#include "SimWindowSystem.h"
+#include "TileLayout.h"
+#include "WildPattern.h"
+#include "WindowSelection.h"
+#include "WindowSnapshot.h"
+
+/**
+ * Output format version, bumped when a field changes meaning
+ */
+
+static const int BENCH_SCHEMA = 1;
+
+static const int BENCH_SAMPLES = 5;
+
+/**
+ * One benchmark. Run() does llIterations operations and returns a
+ * checksum of their results, which keeps the work from being
+ * optimized away. The reported checksum is that of llCheckOps
+ * operations, so it also catches behavior changes.
+ */
+
+struct BENCHMARK
+{
+   std::string sName;
+   std::string sParams;       // JSON object
+
+   double dBytesPerOp;
+   long long llCheckOps;
+
+   std::function<unsigned long long( long long llIterations )> fnRun;
+};
+
+struct BENCHRESULT
+{
+   long long llIterations;
+
+   double dNsPerOp;
+   double dMinNsPerOp;
+
+   unsigned long long ullChecksum;
+};
+
+/**
+ * Inputs come from a fixed seed and only use raw mt19937 output,
+ * which is the same on every standard library
+ */
+
+static std::mt19937 g_rng;
+
+static unsigned int Random( unsigned int uiRange )
+{
+   return (unsigned int) (g_rng() % uiRange);
+}
+
+static unsigned long long Hash( const std::string& sText )
+{
+   unsigned long long ullHash = 14695981039346656037ULL;
+
+   for ( size_t iLoop = 0; iLoop < sText.size(); iLoop++ )
+   {
+      ullHash = (ullHash ^ (unsigned char) sText[iLoop]) * 1099511628211ULL;
+   }
+
+   return ullHash;
+}
+
+/**
+ * The compiled script cache of the sendkeys_cached benchmark: written
+ * to a private directory the first time it runs, removed with it when
+ * the benchmark lets go of it
+ */
+
+struct BENCHCACHE
+{
+   std::string sScript;
+   std::string sDirectory;
+   std::string sSource;
+   std::string sPath;
+
+   bool Create()
+   {
+      if ( !sDirectory.empty() )
+      {
+         return true;
+      }
+
+      const char* pszTemp = getenv( "TMPDIR" );
+
+      std::string sTemplate = std::string( (pszTemp && *pszTemp) ? pszTemp : "/tmp" ) + 
+         "/puttycs_bench.XXXXXX";
+
+      if ( !mkdtemp(&sTemplate[0]) )
+      {
+         return false;
+      }
+
+      sDirectory = sTemplate;
+      sSource = sDirectory + "/script.txt";
+
+      FILE* pFile = fopen( sSource.c_str(), "wb" );
+
+      if ( pFile )
+      {
+         fwrite( sScript.data(), 1, sScript.size(), pFile );
+         fclose( pFile );
+      }
+
+      CKeyProgramCache kpcCache;
+      kpcCache.Open( sDirectory, sSource, 0 );
+      kpcCache.Find( sScript );
+      kpcCache.Save();
+
+      sPath = kpcCache.GetPath();
+
+      return true;
+   }
+
+   ~BENCHCACHE()
+   {
+      if ( !sPath.empty() )
+      {
+         remove( sPath.c_str() );
+      }
+
+      if ( !sSource.empty() )
+      {
+         remove( sSource.c_str() );
+      }
+
+      if ( !sDirectory.empty() )
+      {
+         rmdir( sDirectory.c_str() );
+      }
+   }
+};
+
+/**
+ * Cheap checksum of a large result: its size and every 61st byte
+ */
+
+static unsigned long long Digest( const std::string& sText )
+{
+   unsigned long long ullHash = sText.size();
+
+   for ( size_t iLoop = 0; iLoop < sText.size(); iLoop += 61 )
+   {
+      ullHash = (ullHash ^ (unsigned char) sText[iLoop]) * 1099511628211ULL;
+   }
+
+   return ullHash & 0xffff;
+}
+
+static std::string Format( const char* pszFormat, ... )
+{
+   char szBuffer[512];
+
+   va_list args;
+   va_start( args, pszFormat );
+   vsnprintf( szBuffer, sizeof(szBuffer), pszFormat, args );
+   va_end( args );
+
+   return szBuffer;
+}
+
+/**
+ * PuTTY style titles: user@host.role.env.example.com - PuTTY
+ */
+
+static std::vector<std::string> MakeTitles( int iCount )
+{
+   static const char* s_apszRoles[] = { "web", "db", "cache", "queue", "batch", "api" };
+   static const char* s_apszEnvs[] = { "prod", "stage", "dev" };
+
+   std::vector<std::string> vecTitles;
+   vecTitles.reserve( iCount );
+
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      vecTitles.push_back( Format( "admin@%s%04u.%s.example.com - PuTTY",
+         s_apszRoles[Random(6)], Random(10000), s_apszEnvs[Random(3)] ) );
+   }
+
+   return vecTitles;
+}
+
+/**
+ * The backtracking wildcmp CFilterMatch::WildCompare() used before
+ * CWildPattern, to time against it
+ */
+
+static const char* BacktrackNextChar( const char* psz )
+{
+   psz++;
+
+   while ( (*psz & 0xC0) == 0x80 )
+   {
+      psz++;
+   }
+
+   return psz;
+}
+
+static bool BacktrackEqualChar( const char* psz1, const char* psz2 )
+{
+   const char* pszEnd = BacktrackNextChar( psz1 );
+
+   for ( ; psz1 < pszEnd; psz1++, psz2++ )
+   {
+      if ( *psz1 != *psz2 )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+static bool BacktrackCompare( const char* s1, const char* wild )
+{
+   const char* cp = NULL;
+   const char* mp = NULL;
+
+   while ( (*s1) && (*wild != '*') )
+   {
+      if ( (*wild != '?') && !BacktrackEqualChar(s1, wild) )
+      {
+         return false;
+      }
+
+      wild = BacktrackNextChar( wild );
+      s1 = BacktrackNextChar( s1 );
+   }
+
+   while ( *s1 )
+   {
+      if ( *wild == '*' )
+      {
+         if ( !*++wild )
+         {
+            return true;
+         }
+
+         mp = wild;
+         cp = BacktrackNextChar( s1 );
+      }
+      else if ( (*wild) && ((*wild == '?') || BacktrackEqualChar(s1, wild)) )
+      {
+         wild = BacktrackNextChar( wild );
+         s1 = BacktrackNextChar( s1 );
+      }
+      else
+      {
+         wild = mp;
+         s1 = cp;
+         cp = BacktrackNextChar( cp );
+      }
+   }
+
+   while ( *wild == '*' )
+   {
+      wild++;
+   }
+
+   return !*wild;
+}
+
+/**
+ * A shell script in the CSendKeys syntax: commands with escaped
+ * specials, {ENTER}s and the odd control key
+ */
+
+static std::string MakeScript( size_t iBytes )
+{
+   static const char* s_apszLines[] =
+   {
+      "cd /var/log{ENTER}",
+      "tail -n 100 messages | grep -i error{ENTER}",
+      "ps -ef | grep {PLUS}java{ENTER}",
+      "echo {LEFTPAREN}done{RIGHTPAREN} {PERCENT}d{ENTER}",
+      "top~",
+      "^c",
+      "sudo systemctl restart httpd{ENTER}{DELAY 100}",
+      "export PS1=\"\\u@\\h \\w {CARET} \"{ENTER}"
+   };
+
+   std::string sScript;
+   sScript.reserve( iBytes + 64 );
+
+   while ( sScript.size() < iBytes )
+   {
+      sScript += s_apszLines[Random(8)];
+   }
+
+   sScript.resize( iBytes );
+
+   // Do not end inside a {NAME}
+
+   size_t iBrace = sScript.rfind( '{' );
+
+   if ( (iBrace != std::string::npos) && (sScript.find('}', iBrace) == std::string::npos) )
+   {
+      sScript.resize( iBrace );
+   }
+
+   return sScript;
+}
+
+/**
+ * The keys of a script the way CSendKeys::SendKeys() read them
+ * before CKeyTokenizer: every {...} copied into a fixed buffer,
+ * which is NUL terminated for atoi(), and a key name lookup. The
+ * checksum covers the special keys found, in order, and how many
+ * other characters are between them.
+ */
+
+static unsigned long long TokenizeCopy( const std::string& sScript )
+{
+   unsigned long long ullChecksum = 0;
+
+   char szKeyString[300] = { 0 };
+
+   const char* pKey = sScript.c_str();
+
+   for ( ; *pKey; pKey++ )
+   {
+      if ( *pKey != '{' )
+      {
+         ullChecksum++;
+         continue;
+      }
+
+      const char* p = pKey + 1;
+
+      while ( *p && (*p != '}') )
+      {
+         p++;
+      }
+
+      size_t t = p - pKey;
+
+      if ( !*p || (t > sizeof(szKeyString)) )
+      {
+         break;
+      }
+
+      strncpy( szKeyString, pKey + 1, t );
+      szKeyString[t - 1] = '\0';
+
+      pKey += t;
+
+      KEYSPAN<char> spKeyString;
+      spKeyString.pText = szKeyString;
+      spKeyString.iLength = strlen( szKeyString );
+
+      bool bNormalKey = false;
+
+      if ( spKeyString.StartsWithNoCase("VKEY") )
+      {
+         ullChecksum = ullChecksum * 31 + (unsigned int) atoi( szKeyString + 4 );
+      }
+      else if ( spKeyString.StartsWithNoCase("DELAY") )
+      {
+         ullChecksum = ullChecksum * 31 + (unsigned int) atoi( szKeyString + 5 );
+      }
+      else
+      {
+         ullChecksum = ullChecksum * 31 + CKeyProgram::LookupKeyName( spKeyString, bNormalKey );
+      }
+   }
+
+   return ullChecksum;
+}
+
+/**
+ * The same keys from the spans of CKeyTokenizer
+ */
+
+static unsigned long long TokenizeSpan( const std::string& sScript )
+{
+   unsigned long long ullChecksum = 0;
+
+   CKeyTokenizer<char> ktTokens( sScript.data(), sScript.size() );
+
+   KEYTOKEN<char> token;
+
+   while ( ktTokens.Next(token) )
+   {
+      const KEYSPAN<char>& spText = token.spText;
+
+      bool bNormalKey = false;
+
+      if ( token.iType != KEYTOKEN_SPECIAL )
+      {
+         ullChecksum += spText.iLength;
+      }
+      else if ( spText.StartsWithNoCase("VKEY") )
+      {
+         ullChecksum = ullChecksum * 31 + spText.ToNumber( 4 );
+      }
+      else if ( spText.StartsWithNoCase("DELAY") )
+      {
+         ullChecksum = ullChecksum * 31 + spText.ToNumber( 5 );
+      }
+      else
+      {
+         ullChecksum = ullChecksum * 31 + CKeyProgram::LookupKeyName( spText, bNormalKey );
+      }
+   }
+
+   return ullChecksum;
+}
+
+/**
+ * A command line as typed in the dialog, with characters that need
+ * escaping and {%INC%} tokens
+ */
+
+static std::string MakeCommand( size_t iBytes )
+{
+   static const char* s_apszWords[] =
+   {
+      "echo ", "host{%INC%} ", "a+b ", "(x) ", "{y} ", "100% ", "~/bin ", "^M ", "ls -l ", "node{%INC%}.cfg "
+   };
+
+   std::string sCommand;
+
+   while ( sCommand.size() < iBytes )
+   {
+      sCommand += s_apszWords[Random(10)];
+   }
+
+   return sCommand;
+}
+
+static std::string MakeBytes( size_t iBytes )
+{
+   std::string sBytes( iBytes, '\0' );
+
+   for ( size_t iLoop = 0; iLoop < iBytes; iLoop++ )
+   {
+      sBytes[iLoop] = (char) Random( 256 );
+   }
+
+   return sBytes;
+}
+
+static void AddBenchmarks( std::vector<BENCHMARK>& vecBenchmarks )
+{
+   g_rng.seed( 174 );
+
+   /**
+    * Wildcard compare and filter evaluation
+    */
+
+   {
+      std::vector<std::string> vecTitles = MakeTitles( 10000 );
+
+      static const char* s_apszPatterns[] = 
+      { 
+         "*web*", "admin@db????.prod.*", "*.stage.example.com - PuTTY", "*a*b*c*d*" 
+      };
+
+      for ( int iPattern = 0; iPattern < 4; iPattern++ )
+      {
+         std::string sPattern = s_apszPatterns[iPattern];
+
+         BENCHMARK bench;
+         bench.sName = "wildcmp";
+         bench.sParams = "{\"pattern\":\"" + sPattern + "\",\"titles\":10000}";
+         bench.dBytesPerOp = 0;
+         bench.llCheckOps = (long long) vecTitles.size();
+         bench.fnRun = [vecTitles, sPattern]( long long llIterations )
+         {
+            unsigned long long ullMatches = 0;
+
+            for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+            {
+               const std::string& sTitle = vecTitles[llLoop % vecTitles.size()];
+
+               ullMatches += CFilterMatch::WildCompare( sTitle.c_str(), sPattern.c_str() ) ? 1 : 0;
+            }
+
+            return ullMatches;
+         };
+
+         vecBenchmarks.push_back( bench );
+      }
+
+      BENCHMARK bench;
+      bench.sName = "filter";
+      bench.sParams = "{\"includes\":3,\"excludes\":2,\"titles\":10000}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = (long long) vecTitles.size();
+      bench.fnRun = [vecTitles]( long long llIterations )
+      {
+         std::string sEntry = "fleet||+*web*;+*api*;+*cache*;-*.dev.*;-*9 - PuTTY";
+
+         unsigned long long ullMatches = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            ullMatches += CFilterMatch::MatchFilter( 
+               vecTitles[llLoop % vecTitles.size()], sEntry ) ? 1 : 0;
+         }
+
+         return ullMatches;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Patterns that make wildcmp backtrack, on a long title of a's
+    * that none of them match: the old wildcmp against CWildPattern
+    * compiled once. Both give the same checksum.
+    */
+
+   {
+      static const char* s_apszPatterns[] = 
+      { 
+         "*a*a*a*a*b", "*aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "*a?a?a?a?a?a?a?a?b*" 
+      };
+
+      static const char* s_apszMethods[] = { "backtrack", "linear" };
+
+      std::string sTitle( 4096, 'a' );
+
+      for ( int iPattern = 0; iPattern < 3; iPattern++ )
+      {
+         for ( int iMethod = 0; iMethod < 2; iMethod++ )
+         {
+            std::string sPattern = s_apszPatterns[iPattern];
+
+            BENCHMARK bench;
+            bench.sName = "wildcmp_worst";
+            bench.sParams = Format( "{\"pattern\":\"%s\",\"bytes\":%u,\"method\":\"%s\"}", 
+               sPattern.c_str(), (unsigned int) sTitle.size(), s_apszMethods[iMethod] );
+            bench.dBytesPerOp = (double) sTitle.size();
+            bench.llCheckOps = 1;
+            bench.fnRun = [sTitle, sPattern, iMethod]( long long llIterations )
+            {
+               CWildPattern wpPattern( sPattern.c_str() );
+
+               unsigned long long ullMatches = 0;
+
+               for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+               {
+                  bool bMatch = (iMethod == 0) ? 
+                     BacktrackCompare( sTitle.c_str(), sPattern.c_str() ) : 
+                     wpPattern.Match( sTitle.c_str() );
+
+                  ullMatches += bMatch ? 1 : 2;
+               }
+
+               return ullMatches;
+            };
+
+            vecBenchmarks.push_back( bench );
+         }
+      }
+   }
+
+   /**
+    * Window sorting, one op sorts a fresh unsorted copy
+    */
+
+   for ( int iCount = 10; iCount <= 10000; iCount *= 10 )
+   {
+      std::vector<std::string> vecTitles = MakeTitles( iCount );
+
+      std::vector<WINDOWINFO> vecWindows( iCount );
+
+      for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+      {
+         vecWindows[iLoop].id = iLoop + 1;
+         vecWindows[iLoop].sTitle = vecTitles[iLoop];
+      }
+
+      BENCHMARK bench;
+      bench.sName = "sort_windows";
+      bench.sParams = Format( "{\"windows\":%d}", iCount );
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [vecWindows]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            std::vector<WINDOWINFO> vecSorted( vecWindows );
+
+            CBroadcastEngine::SortWindows( vecSorted );
+
+            ullChecksum += vecSorted.front().id * 31 + vecSorted.back().id;
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * CSendKeys tokenizing
+    */
+
+   static const size_t s_aiScriptSizes[] = { 1024, 64 * 1024, 1024 * 1024, 10 * 1024 * 1024 };
+
+   std::vector<std::string> vecScripts;
+
+   for ( int iSize = 0; iSize < 4; iSize++ )
+   {
+      vecScripts.push_back( MakeScript(s_aiScriptSizes[iSize]) );
+   }
+
+   for ( int iSize = 0; iSize < 4; iSize++ )
+   {
+      const std::string& sScript = vecScripts[iSize];
+
+      BENCHMARK bench;
+      bench.sName = "sendkeys_compile";
+      bench.sParams = Format( "{\"bytes\":%u}", (unsigned int) s_aiScriptSizes[iSize] );
+      bench.dBytesPerOp = (double) sScript.size();
+      bench.llCheckOps = 1;
+      bench.fnRun = [sScript]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         CKeyProgram kpProgram;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            kpProgram.Compile( sScript );
+
+            ullChecksum += kpProgram.GetOps().size() * 31 + kpProgram.GetKeystrokes();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Tokenizing alone, on the larger scripts: copying each {...} as
+    * CSendKeys did against the spans of CKeyTokenizer. Both give the
+    * same checksum.
+    */
+
+   for ( int iSize = 2; iSize < 4; iSize++ )
+   {
+      static const char* s_apszMethods[] = { "copy", "span" };
+
+      for ( int iMethod = 0; iMethod < 2; iMethod++ )
+      {
+         const std::string& sScript = vecScripts[iSize];
+
+         BENCHMARK bench;
+         bench.sName = "sendkeys_tokenize";
+         bench.sParams = Format( "{\"bytes\":%u,\"method\":\"%s\"}", 
+            (unsigned int) s_aiScriptSizes[iSize], s_apszMethods[iMethod] );
+         bench.dBytesPerOp = (double) sScript.size();
+         bench.llCheckOps = 1;
+         bench.fnRun = [sScript, iMethod]( long long llIterations )
+         {
+            unsigned long long ullChecksum = 0;
+
+            for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+            {
+               ullChecksum += (iMethod == 0) ? TokenizeCopy( sScript ) : TokenizeSpan( sScript );
+            }
+
+            return ullChecksum;
+         };
+
+         vecBenchmarks.push_back( bench );
+      }
+   }
+
+   /**
+    * The same scripts replayed from the compiled script cache: one
+    * op hashes the script, maps and checks the file and loads the
+    * program
+    */
+
+   for ( int iSize = 0; iSize < 4; iSize++ )
+   {
+      const std::string& sScript = vecScripts[iSize];
+
+      std::shared_ptr<BENCHCACHE> pCache = std::make_shared<BENCHCACHE>();
+      pCache->sScript = sScript;
+
+      BENCHMARK bench;
+      bench.sName = "sendkeys_cached";
+      bench.sParams = Format( "{\"bytes\":%u}", (unsigned int) s_aiScriptSizes[iSize] );
+      bench.dBytesPerOp = (double) sScript.size();
+      bench.llCheckOps = 1;
+      bench.fnRun = [pCache]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         if ( !pCache->Create() )
+         {
+            return ullChecksum;
+         }
+
+         CKeyProgramCache kpcCache;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            kpcCache.Open( pCache->sDirectory, pCache->sSource, 0 );
+
+            const CKeyProgram& kpProgram = kpcCache.Find( pCache->sScript );
+
+            ullChecksum += kpProgram.GetOps().size() * 31 + kpProgram.GetKeystrokes();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Command escaping (once per send) and {%INC%} expansion (once
+    * per window)
+    */
+
+   static const size_t s_aiCommandSizes[] = { 80, 1024, 64 * 1024 };
+
+   for ( int iSize = 0; iSize < 3; iSize++ )
+   {
+      std::string sCommand = MakeCommand( s_aiCommandSizes[iSize] );
+
+      BENCHMARK bench;
+      bench.sName = "escape";
+      bench.sParams = Format( "{\"bytes\":%u}", (unsigned int) sCommand.size() );
+      bench.dBytesPerOp = (double) sCommand.size();
+      bench.llCheckOps = 1;
+      bench.fnRun = [sCommand]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            ullChecksum += CSendTemplate::Escape( sCommand, true ).size();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+
+      std::string sEscaped = CSendTemplate::Escape( sCommand, true );
+
+      bench.sName = "expand";
+      bench.fnRun = [sEscaped]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            ullChecksum += Hash( CSendTemplate::Expand( 
+               sEscaped, (int) (llLoop % 10000), false, true, true, false ) ) & 0xffff;
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Tile and cascade layout of a 2560x1400 work area
+    */
+
+   static const int s_aiTileCounts[] = { 4, 64, 1024 };
+
+   for ( int iCount = 0; iCount < 3; iCount++ )
+   {
+      int iTotal = s_aiTileCounts[iCount];
+
+      BENCHMARK bench;
+      bench.sName = "tile";
+      bench.sParams = Format( "{\"windows\":%d}", iTotal );
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [iTotal]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         CTileLayout layout;
+         layout.SetWorkArea( 0, 0, 2560, 1400 );
+         layout.SetCellSize( 8, 16 );
+         layout.SetFrameSize( 34, 46 );
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            layout.Optimize( iTotal );
+
+            ullChecksum += layout.GetBands() * 31 + layout.GetMinColumns() * layout.GetMinRows();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+
+      bench.sName = "cascade";
+      bench.fnRun = [iTotal]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         CTileLayout layout;
+         layout.SetWorkArea( 0, 0, 2560, 1400 );
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            layout.Cascade( iTotal, 800, 500, 18, 26, 23 );
+
+            TILERECT rect;
+            layout.GetRect( iTotal - 1, rect );
+
+            ullChecksum += rect.iX + rect.iY;
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * BASE64 as used for the stored passwords and scripts
+    */
+
+   static const size_t s_aiBase64Sizes[] = { 16, 1024, 1024 * 1024 };
+
+   static const char* s_apszKernels[] = { "scalar", "ssse3", "avx2", "auto" };
+
+   for ( int iSize = 0; iSize < 3; iSize++ )
+   {
+      std::string sBytes = MakeBytes( s_aiBase64Sizes[iSize] );
+      std::string sText = CBase64Codec::Encode( sBytes );
+
+      for ( int iKernel = CBase64Codec::KERNEL_SCALAR; iKernel <= CBase64Codec::KERNEL_AUTO; iKernel++ )
+      {
+         // The explicit vector kernels only where the CPU has them, 
+         // auto is always there to compare releases
+
+         if ( (iKernel != CBase64Codec::KERNEL_AUTO) && !CBase64Codec::IsKernelSupported(iKernel) )
+         {
+            continue;
+         }
+
+         BENCHMARK bench;
+         bench.sName = "base64_encode";
+         bench.sParams = Format( "{\"bytes\":%u,\"kernel\":\"%s\"}", 
+            (unsigned int) sBytes.size(), s_apszKernels[iKernel] );
+         bench.dBytesPerOp = (double) sBytes.size();
+         bench.llCheckOps = 1;
+         bench.fnRun = [sBytes, iKernel]( long long llIterations )
+         {
+            unsigned long long ullChecksum = 0;
+
+            CBase64Codec::SetKernel( iKernel );
+
+            for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+            {
+               ullChecksum += Digest( CBase64Codec::Encode(sBytes) );
+            }
+
+            CBase64Codec::SetKernel( CBase64Codec::KERNEL_AUTO );
+
+            return ullChecksum;
+         };
+
+         vecBenchmarks.push_back( bench );
+
+         bench.sName = "base64_decode";
+         bench.fnRun = [sText, iKernel]( long long llIterations )
+         {
+            unsigned long long ullChecksum = 0;
+
+            CBase64Codec::SetKernel( iKernel );
+
+            for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+            {
+               ullChecksum += Digest( CBase64Codec::Decode(sText) );
+            }
+
+            CBase64Codec::SetKernel( CBase64Codec::KERNEL_AUTO );
+
+            return ullChecksum;
+         };
+
+         vecBenchmarks.push_back( bench );
+      }
+   }
+
+   /**
+    * Command history, full at the default size of 100
+    */
+
+   {
+      std::vector<std::string> vecCommands;
+
+      for ( int iLoop = 0; iLoop < 1000; iLoop++ )
+      {
+         vecCommands.push_back( MakeCommand(20 + Random(60)) );
+      }
+
+      BENCHMARK bench;
+      bench.sName = "history_add";
+      bench.sParams = "{\"size\":100}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1000;
+      bench.fnRun = [vecCommands]( long long llIterations )
+      {
+         CCommandHistory history( 100 );
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            history.Add( vecCommands[llLoop % vecCommands.size()] );
+         }
+
+         return history.GetSize() + (Hash( history.GetAt(0) ) & 0xffff);
+      };
+
+      vecBenchmarks.push_back( bench );
+
+      bench.sName = "history_find";
+      bench.fnRun = [vecCommands]( long long llIterations )
+      {
+         static const char* s_apszNeedles[] = { "node", "(x)", "~/bin", "not there" };
+
+         CCommandHistory history( 100 );
+
+         for ( size_t iLoop = 0; iLoop < vecCommands.size(); iLoop++ )
+         {
+            history.Add( vecCommands[iLoop] );
+         }
+
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            ullChecksum += history.Find( s_apszNeedles[llLoop % 4] ) + 1;
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Engine overhead of one broadcast on the simulated desktop
+    */
+
+   for ( int iCount = 100; iCount <= 10000; iCount *= 10 )
+   {
+      std::shared_ptr<CSimWindowSystem> pSim( new CSimWindowSystem );
+      pSim->AddWindows( iCount );
+
+      std::shared_ptr<CBroadcastEngine> pEngine( new CBroadcastEngine(pSim.get()) );
+
+      BENCHMARK bench;
+      bench.sName = "broadcast_sim";
+      bench.sParams = Format( "{\"windows\":%d}", iCount );
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [pSim, pEngine]( long long llIterations )
+      {
+         std::vector<std::string> vecBuffers( 1, "uptime; echo host{%INC%}" );
+
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            ullChecksum += pEngine->Send( vecBuffers, "all||+host*", false, true );
+
+            pSim->ResetTyped();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Window set algebra, one op combines ten saved filters already
+    * evaluated by the index: six unions, an intersection and three
+    * differences
+    */
+
+   {
+      std::vector<std::string> vecTitles = MakeTitles( 5000 );
+
+      std::vector<WINDOWINFO> vecWindows( vecTitles.size() );
+
+      for ( size_t iLoop = 0; iLoop < vecTitles.size(); iLoop++ )
+      {
+         vecWindows[iLoop].id = iLoop + 1;
+         vecWindows[iLoop].sTitle = vecTitles[iLoop];
+      }
+
+      static const char* s_apszFilters[] =
+      {
+         "web||+*@web*", "db||+*@db*", "cache||+*@cache*", "queue||+*@queue*",
+         "batch||+*@batch*", "api||+*@api*", "prod||+*.prod.*", "stage||+*.stage.*",
+         "dev||+*.dev.*", "nines||+*9.*"
+      };
+
+      CWindowIndex wiIndex;
+      wiIndex.Update( vecWindows );
+
+      std::vector<CWindowSelection> vecSelections( 10 );
+
+      for ( int iFilter = 0; iFilter < 10; iFilter++ )
+      {
+         wiIndex.Evaluate( s_apszFilters[iFilter], vecSelections[iFilter] );
+      }
+
+      BENCHMARK bench;
+      bench.sName = "selection_combine";
+      bench.sParams = "{\"filters\":10,\"windows\":5000}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [vecSelections]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         CWindowSelection wsCombined;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            wsCombined = vecSelections[0];
+
+            for ( int iFilter = 1; iFilter < 6; iFilter++ )
+            {
+               wsCombined.Union( vecSelections[iFilter] );
+            }
+
+            wsCombined.Intersect( vecSelections[6] );
+
+            for ( int iFilter = 7; iFilter < 10; iFilter++ )
+            {
+               wsCombined.Subtract( vecSelections[iFilter] );
+            }
+
+            ullChecksum += wsCombined.Count();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Per-host variables: parsing a 10000 host inventory, and finding
+    * the row of a window and expanding two {%VAR:name%} tokens, once
+    * per window
+    */
+
+   {
+      static const char* s_apszRoles[] = { "web", "db", "cache", "queue", "batch", "api" };
+      static const char* s_apszEnvs[] = { "prod", "stage", "dev" };
+
+      std::string sInventory = "host,role,dc,rack\n";
+
+      for ( int iLoop = 0; iLoop < 10000; iLoop++ )
+      {
+         sInventory += Format( "%s%04u.%s.example.com,%s,dc%u,\"r%u, u%u\"\n",
+            s_apszRoles[Random(6)], Random(10000), s_apszEnvs[Random(3)],
+            s_apszRoles[Random(6)], Random(4), Random(40), Random(42) );
+      }
+
+      BENCHMARK bench;
+      bench.sName = "inventory_load";
+      bench.sParams = "{\"hosts\":10000}";
+      bench.dBytesPerOp = (double) sInventory.size();
+      bench.llCheckOps = 1;
+      bench.fnRun = [sInventory]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         CHostInventory hiInventory;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            hiInventory.Load( sInventory );
+
+            ullChecksum += hiInventory.GetRows() * hiInventory.GetColumns();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+
+      std::vector<std::string> vecTitles = MakeTitles( 1000 );
+
+      std::shared_ptr<CHostInventory> pInventory( new CHostInventory() );
+      pInventory->Load( sInventory );
+
+      std::string sEscaped = CSendTemplate::Escape( "echo {%VAR:role%} {%VAR:rack%}", true );
+
+      bench.sName = "inventory_expand";
+      bench.sParams = "{\"hosts\":10000,\"windows\":1000}";
+      bench.dBytesPerOp = 0;
+      bench.fnRun = [vecTitles, pInventory, sEscaped]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            int iIndex = (int) (llLoop % vecTitles.size());
+            int iRow = pInventory->Find( vecTitles[iIndex] );
+
+            ullChecksum += CSendTemplate::Expand( sEscaped, iIndex, 
+               false, true, true, false, pInventory.get(), iRow ).size();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Launching sessions on a simulated spawner, the scheduling alone:
+    * the clock is virtual, so one op is the launcher's own work for
+    * a thousand hosts, eight starting at a time
+    */
+
+   {
+      std::vector<std::string> vecHosts;
+
+      for ( int iLoop = 0; iLoop < 1000; iLoop++ )
+      {
+         vecHosts.push_back( Format("host%04d", iLoop) );
+      }
+
+      BENCHMARK bench;
+      bench.sName = "launch_sim";
+      bench.sParams = "{\"hosts\":1000,\"concurrency\":8}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [vecHosts]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            CSimWindowSystem swsSystem;
+            CBroadcastEngine beEngine( &swsSystem );
+            CSimProcessSpawner spsSpawner( &swsSystem );
+
+            CSessionLauncher slLauncher( &spsSpawner, &beEngine );
+            slLauncher.SetCommand( "putty -load \"{%HOST%}\"" );
+            slLauncher.SetRate( 0 );
+
+            slLauncher.Start( vecHosts );
+            slLauncher.Run();
+
+            ullChecksum += slLauncher.GetCount( CSessionLauncher::LAUNCH_WINDOW ) + 
+               (unsigned long long) spsSpawner.GetTime();
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Enumerating, selecting and listing 1000 windows into the same
+    * vector, as every button does
+    */
+
+   {
+      std::shared_ptr<CSimWindowSystem> pSystem( new CSimWindowSystem );
+      pSystem->AddWindows( 1000, "admin@web%05d.prod.example.com: ~" );
+
+      std::shared_ptr<CBroadcastEngine> pEngine( new CBroadcastEngine(pSystem.get()) );
+
+      BENCHMARK bench;
+      bench.sName = "find_windows";
+      bench.sParams = "{\"windows\":1000}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [pSystem, pEngine]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         std::vector<WINDOWINFO> vecWindows;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            CWindowSelection selection;
+            pEngine->SelectWindows( "web||*web0*", selection, true );
+
+            ullChecksum += pEngine->FindWindows( selection, vecWindows );
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+
+   /**
+    * Capturing, saving, loading and restoring the layout of 1000
+    * windows
+    */
+
+   {
+      std::shared_ptr<CSimWindowSystem> pSystem( new CSimWindowSystem );
+      pSystem->AddWindows( 1000 );
+
+      BENCHMARK bench;
+      bench.sName = "snapshot_roundtrip";
+      bench.sParams = "{\"windows\":1000}";
+      bench.dBytesPerOp = 0;
+      bench.llCheckOps = 1;
+      bench.fnRun = [pSystem]( long long llIterations )
+      {
+         unsigned long long ullChecksum = 0;
+
+         for ( long long llLoop = 0; llLoop < llIterations; llLoop++ )
+         {
+            CWindowSnapshot wsCaptured;
+            wsCaptured.SetName( "layout" );
+            wsCaptured.Capture( pSystem.get() );
+
+            std::string sSaved = wsCaptured.Save();
+
+            CWindowSnapshot wsLoaded;
+            wsLoaded.Load( sSaved );
+
+            ullChecksum += sSaved.size() + wsLoaded.Restore( pSystem.get() );
+         }
+
+         return ullChecksum;
+      };
+
+      vecBenchmarks.push_back( bench );
+   }
+}
+
+/**
+ * Runs a benchmark in BENCH_SAMPLES batches of about dMinMs / 
+ * BENCH_SAMPLES each and keeps the median and the best batch
+ */
+
+static BENCHRESULT RunBenchmark( const BENCHMARK& bench, double dMinMs )
+{
+   typedef std::chrono::steady_clock Clock;
+
+   BENCHRESULT result;
+   result.ullChecksum = bench.fnRun( bench.llCheckOps );
+
+   double dBatchNs = dMinMs * 1e6 / BENCH_SAMPLES;
+
+   long long llIterations = 1;
+
+   while ( true )
+   {
+      Clock::time_point tpStart = Clock::now();
+      bench.fnRun( llIterations );
+      double dNs = std::chrono::duration<double, std::nano>( Clock::now() - tpStart ).count();
+
+      if ( (dNs >= dBatchNs) || (llIterations >= (1LL << 40)) )
+      {
+         break;
+      }
+
+      long long llNext = (dNs > 0) ? (long long) (llIterations * 1.2 * dBatchNs / dNs) : llIterations * 10;
+
+      llIterations = std::max( llIterations + 1, std::min(llNext, llIterations * 10) );
+   }
+
+   std::vector<double> vecSamples;
+
+   for ( int iSample = 0; iSample < BENCH_SAMPLES; iSample++ )
+   {
+      Clock::time_point tpStart = Clock::now();
+      bench.fnRun( llIterations );
+      double dNs = std::chrono::duration<double, std::nano>( Clock::now() - tpStart ).count();
+
+      vecSamples.push_back( dNs / llIterations );
+   }
+
+   std::sort( vecSamples.begin(), vecSamples.end() );
+
+   result.llIterations = llIterations;
+   result.dNsPerOp = vecSamples[BENCH_SAMPLES / 2];
+   result.dMinNsPerOp = vecSamples[0];
+
+   return result;
+}
+
+static void Usage()
+{
+   fprintf( stderr, 
+      "usage: puttycs_bench [--filter text] [--min-time ms] [--output file] [--list]\n" );
+}
+
+int main( int argc, char* argv[] )
+{
+   const char* pszFilter = NULL;
+   const char* pszOutput = NULL;
+
+   double dMinMs = 250;
+   bool bList = false;
+
+   for ( int iArg = 1; iArg < argc; iArg++ )
+   {
+      if ( !strcmp(argv[iArg], "--filter") && (iArg + 1 < argc) )
+      {
+         pszFilter = argv[++iArg];
+      }
+      else if ( !strcmp(argv[iArg], "--min-time") && (iArg + 1 < argc) )
+      {
+         dMinMs = atof( argv[++iArg] );
+      }
+      else if ( !strcmp(argv[iArg], "--output") && (iArg + 1 < argc) )
+      {
+         pszOutput = argv[++iArg];
+      }
+      else if ( !strcmp(argv[iArg], "--list") )
+      {
+         bList = true;
+      }
+      else
+      {
+         Usage();
+         return 2;
+      }
+   }
+
+   std::vector<BENCHMARK> vecBenchmarks;
+   AddBenchmarks( vecBenchmarks );
+
+   std::string sJson = Format( "{\"schema\":%d,\"suite\":\"puttycs_core\",\"benchmarks\":[", BENCH_SCHEMA );
+
+   bool bFirst = true;
+
+   for ( size_t iLoop = 0; iLoop < vecBenchmarks.size(); iLoop++ )
+   {
+      const BENCHMARK& bench = vecBenchmarks[iLoop];
+
+      std::string sId = bench.sName + bench.sParams;
+
+      if ( pszFilter && (sId.find(pszFilter) == std::string::npos) )
+      {
+         continue;
+      }
+
+      if ( bList )
+      {
+         printf( "%s\n", sId.c_str() );
+         continue;
+      }
+
+      BENCHRESULT result = RunBenchmark( bench, dMinMs );
+
+      fprintf( stderr, "%-18s %-60s %14.1f ns/op\n", 
+         bench.sName.c_str(), bench.sParams.c_str(), result.dNsPerOp );
+
+      sJson += bFirst ? "\n" : ",\n";
+      bFirst = false;
+
+      sJson += "{\"name\":";
+      CSendTrace::AppendJsonString( sJson, bench.sName );
+      sJson += ",\"params\":" + bench.sParams;
+      sJson += Format( ",\"iterations\":%lld,\"ns_per_op\":%.1f,\"ns_per_op_min\":%.1f",
+         result.llIterations, result.dNsPerOp, result.dMinNsPerOp );
+
+      if ( bench.dBytesPerOp > 0 )
+      {
+         sJson += Format( ",\"mb_per_s\":%.1f", bench.dBytesPerOp * 1e3 / result.dNsPerOp );
+      }
+
+      sJson += Format( ",\"checksum\":%llu}", result.ullChecksum );
+
+      // Whatever the benchmark holds, like a cache directory, goes now
+
+      vecBenchmarks[iLoop].fnRun = nullptr;
+   }
+
+   if ( bList )
+   {
+      return 0;
+   }
+
+   sJson += "\n]}\n";
+
+   if ( pszOutput )
+   {
+      FILE* pFile = fopen( pszOutput, "wb" );
+
+      if ( !pFile )
+      {
+         fprintf( stderr, "puttycs_bench: can not write %s\n", pszOutput );
+         return 1;
+      }
+
+      fwrite( sJson.data(), 1, sJson.size(), pFile );
+      fclose( pFile );
+   }
+   else
+   {
+      fwrite( sJson.data(), 1, sJson.size(), stdout );
+   }
+
+   return 0;
+}
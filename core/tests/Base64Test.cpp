@@ -0,0 +1,170 @@
+/**
+ * Base64Test.cpp - PuTTYCS BASE64 codec test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <random>
+#include <string>
+
+#include "Base64Codec.h"
+
+/**
+ * Checks every BASE64 kernel the CPU supports, scalar and SIMD: the
+ * RFC 4648 test vectors, round trips of random bytes of every length
+ * up to a few blocks and some long ones, and decoding of random text
+ * cut by a character outside the alphabet, which must stop where the
+ * scalar code stops. Kernels the CPU lacks are reported as skipped.
+ */
+
+static const char* s_apszKernels[] = { "scalar", "ssse3", "avx2" };
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszKernel, const char* pszWhat, size_t iLength )
+{
+   if ( !bResult )
+   {
+      printf( "%s: %s failed (%u bytes)\n", pszKernel, pszWhat, (unsigned int) iLength );
+
+      g_iFailures++;
+   }
+}
+
+static std::string RandomBytes( std::mt19937& rng, size_t iLength )
+{
+   std::string sBytes( iLength, '\0' );
+
+   for ( size_t iLoop = 0; iLoop < iLength; iLoop++ )
+   {
+      sBytes[iLoop] = (char) (rng() & 0xFF);
+   }
+
+   return sBytes;
+}
+
+static void TestKernel( int iKernel )
+{
+   const char* pszKernel = s_apszKernels[iKernel];
+
+   static const char* s_apszVectors[][2] =
+   {
+      { "", "" },
+      { "f", "Zg==" },
+      { "fo", "Zm8=" },
+      { "foo", "Zm9v" },
+      { "foob", "Zm9vYg==" },
+      { "fooba", "Zm9vYmE=" },
+      { "foobar", "Zm9vYmFy" }
+   };
+
+   for ( size_t iVector = 0; iVector < sizeof(s_apszVectors) / sizeof(s_apszVectors[0]); iVector++ )
+   {
+      std::string sBytes = s_apszVectors[iVector][0];
+      std::string sText = s_apszVectors[iVector][1];
+
+      Check( CBase64Codec::Encode(sBytes) == sText, pszKernel, "RFC 4648 encode", sBytes.size() );
+      Check( CBase64Codec::Decode(sText) == sBytes, pszKernel, "RFC 4648 decode", sBytes.size() );
+   }
+
+   std::mt19937 rng( 4648 );
+
+   for ( size_t iLength = 0; iLength < 4096 + 64; iLength++ )
+   {
+      if ( (iLength > 256) && (iLength % 61 != 0) && (iLength < 4096) )
+      {
+         continue;
+      }
+
+      std::string sBytes = RandomBytes( rng, iLength );
+
+      std::string sText = CBase64Codec::Encode( sBytes );
+
+      Check( sText.size() == CBase64Codec::GetEncodedLength(iLength), pszKernel, "encoded length", iLength );
+      Check( CBase64Codec::Decode(sText) == sBytes, pszKernel, "round trip", iLength );
+
+      // The scalar code is the reference for the SIMD kernels
+
+      int iCurrent = CBase64Codec::GetKernel();
+
+      CBase64Codec::SetKernel( CBase64Codec::KERNEL_SCALAR );
+
+      std::string sScalarText = CBase64Codec::Encode( sBytes );
+
+      std::string sCut = sText;
+
+      if ( !sCut.empty() )
+      {
+         sCut[rng() % sCut.size()] = "!=\n-_ \x80"[rng() % 7];
+      }
+
+      std::string sScalarCut = CBase64Codec::Decode( sCut );
+
+      CBase64Codec::SetKernel( iCurrent );
+
+      Check( sText == sScalarText, pszKernel, "encode against scalar", iLength );
+      Check( CBase64Codec::Decode(sCut) == sScalarCut, pszKernel, "cut decode against scalar", iLength );
+   }
+
+   std::string sLarge = RandomBytes( rng, 1024 * 1024 + 7 );
+
+   Check( CBase64Codec::Decode(CBase64Codec::Encode(sLarge)) == sLarge, pszKernel, 
+      "round trip", sLarge.size() );
+}
+
+int main()
+{
+   for ( int iKernel = CBase64Codec::KERNEL_SCALAR; iKernel <= CBase64Codec::KERNEL_AVX2; iKernel++ )
+   {
+      if ( !CBase64Codec::IsKernelSupported(iKernel) )
+      {
+         printf( "%s: skipped, not supported by this CPU\n", s_apszKernels[iKernel] );
+         continue;
+      }
+
+      if ( CBase64Codec::SetKernel(iKernel) != iKernel )
+      {
+         printf( "%s: could not be selected\n", s_apszKernels[iKernel] );
+
+         g_iFailures++;
+         continue;
+      }
+
+      int iFailures = g_iFailures;
+
+      TestKernel( iKernel );
+
+      printf( "%s: %s\n", s_apszKernels[iKernel], (g_iFailures == iFailures) ? "ok" : "FAILED" );
+   }
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
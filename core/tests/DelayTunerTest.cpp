@@ -0,0 +1,178 @@
+/**
+ * DelayTunerTest.cpp - PuTTYCS delay tuning test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "SimWindowSystem.h"
+
+/**
+ * Broadcasts to a simulated window whose input handling slows from
+ * 5 ms to 200 ms, far past the timeout of the tuned post send wait,
+ * and checks that the tuned delay follows it up instead of staying
+ * at the old value while every wait times out. Also checks that a
+ * window the tuner can not watch leaves the estimate alone.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat, int iDelay )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed (delay %d ms)\n", pszWhat, iDelay );
+
+      g_iFailures++;
+   }
+}
+
+static SIMLATENCY MakeLatency( double dIdleMs )
+{
+   SIMLATENCY latency;
+   latency.dActivateMs = 0.5;
+   latency.dForegroundMs = 2.0;
+   latency.dKeyMs = 0.05;
+   latency.dIdleMs = dIdleMs;
+   latency.dJitter = 0.1;
+   latency.dFocusFailure = 0.0;
+
+   return latency;
+}
+
+static void TestSlowdown()
+{
+   CSimWindowSystem swsSystem;
+   swsSystem.SetLatency( MakeLatency(5.0) );
+
+   WINDOWID id = swsSystem.AddWindow( "host00001" );
+
+   CBroadcastEngine beEngine( &swsSystem );
+   beEngine.SetPostSendDelay( 50 );
+
+   CDelayTuner& dtTuner = beEngine.GetDelayTuner();
+   dtTuner.SetEnabled( true );
+   dtTuner.SetBounds( 1, 5000 );
+
+   const void* pKey = (const void*) (uintptr_t) id;
+
+   std::vector<std::string> vecBuffers( 1, "uptime" );
+
+   for ( int iLoop = 0; iLoop < 30; iLoop++ )
+   {
+      beEngine.Send( vecBuffers, "all||+host*", false, true );
+   }
+
+   int iDelay = dtTuner.GetDelay( pKey, CDelayTuner::DELAY_POST_SEND, 50 );
+
+   Check( (iDelay >= 5) && (iDelay < 20), "tuned to 5 ms", iDelay );
+
+   swsSystem.SetLatency( id, MakeLatency(200.0) );
+
+   int iSends = 0;
+
+   while ( (iSends < 10) && (dtTuner.GetDelay(pKey, CDelayTuner::DELAY_POST_SEND, 50) < 220) )
+   {
+      beEngine.Send( vecBuffers, "all||+host*", false, true );
+      iSends++;
+   }
+
+   iDelay = dtTuner.GetDelay( pKey, CDelayTuner::DELAY_POST_SEND, 50 );
+
+   Check( iDelay >= 220, "followed the slowdown within 10 sends", iDelay );
+
+   // Once caught up, every wait must end on the window again
+
+   int iTimeouts = 0;
+
+   for ( int iLoop = 0; iLoop < 50; iLoop++ )
+   {
+      std::vector<BROADCASTRESULT> vecResults;
+      beEngine.Send( vecBuffers, "all||+host*", false, true, &vecResults );
+
+      iDelay = dtTuner.GetDelay( pKey, CDelayTuner::DELAY_POST_SEND, 50 );
+
+      if ( vecResults.empty() || (vecResults[0].dPostSendMs >= iDelay * 4.0) || (iDelay < 200) )
+      {
+         iTimeouts++;
+      }
+   }
+
+   Check( iTimeouts == 0, "no timeouts at 200 ms", iDelay );
+   Check( iDelay < 400, "settled near 200 ms", iDelay );
+
+   printf( "slowdown: %d sends to catch up, delay %d ms\n", iSends, iDelay );
+}
+
+static void TestCensoring()
+{
+   CDelayTuner dtTuner;
+   dtTuner.SetEnabled( true );
+
+   int iKey = 0;
+
+   for ( int iLoop = 0; iLoop < 10; iLoop++ )
+   {
+      dtTuner.AddSample( &iKey, CDelayTuner::DELAY_TRANSITION, 40.0 );
+   }
+
+   int iDelay = dtTuner.GetDelay( &iKey, CDelayTuner::DELAY_TRANSITION, 100 );
+
+   Check( iDelay == 40, "steady 40 ms", iDelay );
+
+   // A timeout below the mean bounds nothing
+
+   dtTuner.AddTimeout( &iKey, CDelayTuner::DELAY_TRANSITION, 10.0 );
+
+   iDelay = dtTuner.GetDelay( &iKey, CDelayTuner::DELAY_TRANSITION, 100 );
+
+   Check( iDelay == 40, "timeout below the mean ignored", iDelay );
+
+   dtTuner.AddTimeout( &iKey, CDelayTuner::DELAY_TRANSITION, 160.0 );
+
+   iDelay = dtTuner.GetDelay( &iKey, CDelayTuner::DELAY_TRANSITION, 100 );
+
+   Check( iDelay > 160, "timeout raises the delay past it", iDelay );
+}
+
+int main()
+{
+   TestSlowdown();
+   TestCensoring();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+/**
+ * HostInventoryTest.cpp - PuTTYCS host inventory test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "HostInventory.h"
+#include "SimWindowSystem.h"
+
+/**
+ * Reloads an inventory file as it is edited: a new size or a new
+ * modification time is read again, an unchanged stamp is not, a
+ * removed file empties the inventory and a new path replaces it.
+ * Then broadcasts {%VAR:name%} to a simulated window and checks the
+ * next send after an edit types the new value. POSIX only, for
+ * mkdtemp() and utimensat().
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static bool WriteFile( const std::string& sPath, const std::string& sBytes )
+{
+   FILE* pFile = fopen( sPath.c_str(), "wb" );
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   bool bWritten = fwrite( sBytes.data(), 1, sBytes.size(), pFile ) == sBytes.size();
+
+   return (fclose(pFile) == 0) && bWritten;
+}
+
+/**
+ * Sets the modification time of a file, in seconds
+ */
+
+static void SetTime( const std::string& sPath, time_t tTime )
+{
+   struct timespec atsTimes[2];
+   atsTimes[0].tv_sec = tTime;
+   atsTimes[0].tv_nsec = 0;
+   atsTimes[1] = atsTimes[0];
+
+   utimensat( AT_FDCWD, sPath.c_str(), atsTimes, 0 );
+}
+
+static std::string GetValue( CHostInventory& hiInventory, const std::string& sTitle, const char* pszName )
+{
+   std::string sValue;
+
+   if ( !hiInventory.GetValue(hiInventory.Find(sTitle), pszName, sValue) )
+   {
+      return "(none)";
+   }
+
+   return sValue;
+}
+
+static void TestReload( const std::string& sDirectory )
+{
+   std::string sPath = sDirectory + "/hosts.csv";
+
+   WriteFile( sPath, "host,role\nweb01,web\ndb01,db\n" );
+   SetTime( sPath, 1000000000 );
+
+   CHostInventory hiInventory;
+   hiInventory.SetPath( sPath );
+
+   Check( hiInventory.Refresh(), "reload: read" );
+   Check( GetValue(hiInventory, "admin@web01: ~", "role") == "web", "reload: first value" );
+   Check( hiInventory.GetRows() == 2, "reload: first rows" );
+
+   // Edited: a row changed, one removed, one added
+
+   WriteFile( sPath, "host,role\nweb01,frontend\ncache01,cache\n" );
+   SetTime( sPath, 1000000001 );
+
+   Check( hiInventory.Refresh(), "reload: edited" );
+   Check( GetValue(hiInventory, "web01", "role") == "frontend", "reload: changed value" );
+   Check( hiInventory.Find("db01") == -1, "reload: removed host" );
+   Check( GetValue(hiInventory, "cache01", "role") == "cache", "reload: added host" );
+
+   // Same size, new time
+
+   WriteFile( sPath, "host,role\nweb01,FRONTEND\ncache01,cache\n" );
+   SetTime( sPath, 1000000002 );
+
+   Check( hiInventory.Refresh(), "reload: same size" );
+   Check( GetValue(hiInventory, "web01", "role") == "FRONTEND", "reload: same size read again" );
+
+   // Same size and time put back: the stamp says unchanged, so no read
+
+   WriteFile( sPath, "host,role\nweb01,frontenD\ncache01,cache\n" );
+   SetTime( sPath, 1000000002 );
+
+   Check( hiInventory.Refresh(), "reload: unchanged" );
+   Check( GetValue(hiInventory, "web01", "role") == "FRONTEND", "reload: unchanged not read" );
+
+   // A new size, even with the old time
+
+   WriteFile( sPath, "host,role,rack\nweb01,web,r1\n" );
+   SetTime( sPath, 1000000002 );
+
+   Check( hiInventory.Refresh(), "reload: new size" );
+   Check( (GetValue(hiInventory, "web01", "rack") == "r1") && (hiInventory.GetColumns() == 3), 
+      "reload: new column" );
+
+   // Removed, then written again
+
+   remove( sPath.c_str() );
+
+   Check( !hiInventory.Refresh(), "reload: removed file" );
+   Check( (hiInventory.GetRows() == 0) && (hiInventory.Find("web01") == -1), "reload: removed file empties" );
+
+   WriteFile( sPath, "host,role\nweb01,web\n" );
+   SetTime( sPath, 1000000002 );
+
+   Check( hiInventory.Refresh(), "reload: file back" );
+   Check( GetValue(hiInventory, "web01", "role") == "web", "reload: file back read" );
+
+   // Another path, then none
+
+   std::string sOtherPath = sDirectory + "/other.tsv";
+
+   WriteFile( sOtherPath, "host\trole\nweb01\tstaging\n" );
+
+   hiInventory.SetPath( sOtherPath );
+
+   Check( hiInventory.GetRows() == 0, "reload: new path clears" );
+   Check( hiInventory.Refresh() && (GetValue(hiInventory, "web01", "role") == "staging"), "reload: new path read" );
+
+   hiInventory.SetPath( "" );
+
+   Check( !hiInventory.Refresh() && (hiInventory.GetRows() == 0), "reload: no path" );
+
+   remove( sPath.c_str() );
+   remove( sOtherPath.c_str() );
+}
+
+static void TestBroadcast( const std::string& sDirectory )
+{
+   std::string sPath = sDirectory + "/hosts.csv";
+
+   WriteFile( sPath, "host,role\nweb01,web\n" );
+   SetTime( sPath, 1000000000 );
+
+   SIMLATENCY latency;
+   latency.dActivateMs = 0.0;
+   latency.dForegroundMs = 0.0;
+   latency.dKeyMs = 0.0;
+   latency.dIdleMs = 0.0;
+   latency.dJitter = 0.0;
+   latency.dFocusFailure = 0.0;
+
+   CSimWindowSystem swsSystem;
+   swsSystem.SetLatency( latency );
+
+   WINDOWID id = swsSystem.AddWindow( "admin@web01: ~" );
+
+   CBroadcastEngine beEngine( &swsSystem );
+   beEngine.SetPostSendDelay( 0 );
+   beEngine.SetInventory( sPath );
+
+   std::vector<std::string> vecBuffers( 1, "echo {%VAR:role%}" );
+
+   beEngine.Send( vecBuffers, "all||+*web01*", false, true );
+
+   Check( swsSystem.GetTyped(id).find("echo web") != std::string::npos, "broadcast: value typed" );
+
+   WriteFile( sPath, "host,role\nweb01,database\n" );
+   SetTime( sPath, 1000000001 );
+
+   swsSystem.ResetTyped();
+
+   beEngine.Send( vecBuffers, "all||+*web01*", false, true );
+
+   Check( swsSystem.GetTyped(id).find("echo database") != std::string::npos, "broadcast: edited value typed" );
+
+   remove( sPath.c_str() );
+}
+
+int main()
+{
+   const char* pszTemp = getenv( "TMPDIR" );
+
+   std::string sDirectory = std::string( (pszTemp && *pszTemp) ? pszTemp : "/tmp" ) + 
+      "/puttycs_test.XXXXXX";
+
+   if ( !mkdtemp(&sDirectory[0]) )
+   {
+      printf( "cannot create a temporary directory\n" );
+      return 1;
+   }
+
+   TestReload( sDirectory );
+   TestBroadcast( sDirectory );
+
+   rmdir( sDirectory.c_str() );
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
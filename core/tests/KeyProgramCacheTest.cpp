@@ -0,0 +1,342 @@
+/**
+ * KeyProgramCacheTest.cpp - PuTTYCS compiled script cache test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "KeyProgramCache.h"
+
+/**
+ * Runs the script cache against files in a temporary directory: a
+ * script rewritten to the same size and time must not replay its
+ * old keys, an edited script replaces its own file, the directory
+ * is held to MAX_FILES, and corrupt, truncated and other version
+ * files are ignored and rewritten. POSIX only, for mkdtemp() and
+ * utimensat().
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static bool WriteFile( const std::string& sPath, const std::string& sBytes )
+{
+   FILE* pFile = fopen( sPath.c_str(), "wb" );
+
+   if ( !pFile )
+   {
+      return false;
+   }
+
+   bool bWritten = (fwrite(sBytes.data(), 1, sBytes.size(), pFile) == sBytes.size());
+
+   return (fclose(pFile) == 0) && bWritten;
+}
+
+static std::string ReadFile( const std::string& sPath )
+{
+   std::string sBytes;
+
+   FILE* pFile = fopen( sPath.c_str(), "rb" );
+
+   if ( pFile )
+   {
+      char szBlock[4096];
+      size_t iRead = 0;
+
+      while ( (iRead = fread(szBlock, 1, sizeof(szBlock), pFile)) > 0 )
+      {
+         sBytes.append( szBlock, iRead );
+      }
+
+      fclose( pFile );
+   }
+
+   return sBytes;
+}
+
+static std::vector<std::string> ListCacheFiles( const std::string& sDirectory )
+{
+   std::vector<std::string> vecFiles;
+
+   DIR* pDir = opendir( sDirectory.c_str() );
+
+   if ( pDir )
+   {
+      while ( struct dirent* pEntry = readdir(pDir) )
+      {
+         size_t iLength = strlen( pEntry->d_name );
+
+         if ( (iLength > 4) && !strcmp(pEntry->d_name + iLength - 4, ".pkc") )
+         {
+            vecFiles.push_back( sDirectory + "/" + pEntry->d_name );
+         }
+      }
+
+      closedir( pDir );
+   }
+
+   return vecFiles;
+}
+
+/**
+ * Runs a script through the cache the way puttycs_fanout does and
+ * returns whether it came from the cache
+ */
+
+static bool Run( const std::string& sDirectory, const std::string& sScript, 
+                 std::vector<std::string>& vecLines )
+{
+   CKeyProgramCache kpcCache;
+
+   bool bHit = kpcCache.Open( sDirectory, sScript, CKeyProgramCache::FLAG_SENDCR );
+
+   if ( bHit )
+   {
+      vecLines = kpcCache.GetLines();
+   }
+   else
+   {
+      vecLines.clear();
+
+      std::string sBytes = ReadFile( sScript );
+
+      size_t iStart = 0;
+
+      while ( iStart < sBytes.size() )
+      {
+         size_t iEnd = sBytes.find( '\n', iStart );
+
+         if ( iEnd == std::string::npos )
+         {
+            iEnd = sBytes.size();
+         }
+
+         vecLines.push_back( sBytes.substr(iStart, iEnd - iStart) );
+         iStart = iEnd + 1;
+      }
+
+      kpcCache.SetLines( vecLines );
+   }
+
+   for ( size_t iLine = 0; iLine < vecLines.size(); iLine++ )
+   {
+      kpcCache.Find( vecLines[iLine] );
+   }
+
+   Check( kpcCache.Save(), "save" );
+
+   return bHit;
+}
+
+static void TestStale( const std::string& sDirectory )
+{
+   std::string sScript = sDirectory + "/job.txt";
+   std::vector<std::string> vecLines;
+
+   WriteFile( sScript, "uptime\necho one\n" );
+
+   Check( !Run(sDirectory, sScript, vecLines), "first run compiles" );
+   Check( Run(sDirectory, sScript, vecLines), "second run is cached" );
+   Check( (vecLines.size() == 2) && (vecLines[1] == "echo one"), "cached lines" );
+
+   // Same size, time put back: only the bytes tell them apart
+
+   struct stat st;
+   stat( sScript.c_str(), &st );
+
+   WriteFile( sScript, "uptime\necho two\n" );
+
+   struct timespec atsTimes[2] = { st.st_atim, st.st_mtim };
+   utimensat( AT_FDCWD, sScript.c_str(), atsTimes, 0 );
+
+   Check( !Run(sDirectory, sScript, vecLines), "rewrite with the same size and time compiles" );
+   Check( (vecLines.size() == 2) && (vecLines[1] == "echo two"), "rewritten lines" );
+   Check( Run(sDirectory, sScript, vecLines), "rewrite is cached" );
+   Check( (vecLines.size() == 2) && (vecLines[1] == "echo two"), "rewrite cached lines" );
+
+   Check( ListCacheFiles(sDirectory).size() == 1, "rewrite replaced the old file" );
+
+   remove( sScript.c_str() );
+}
+
+static void TestDamaged( const std::string& sDirectory )
+{
+   std::string sScript = sDirectory + "/damaged.txt";
+   std::vector<std::string> vecLines;
+
+   WriteFile( sScript, "ls -l\n{ENTER}pwd\n" );
+
+   Run( sDirectory, sScript, vecLines );
+
+   CKeyProgramCache kpcCache;
+   kpcCache.Open( sDirectory, sScript, CKeyProgramCache::FLAG_SENDCR );
+
+   std::string sCache = kpcCache.GetPath();
+   kpcCache.Close();
+
+   std::string sGood = ReadFile( sCache );
+
+   Check( sGood.size() > 64, "cache file written" );
+
+   // A flipped byte in the body fails the checksum
+
+   std::string sBytes = sGood;
+   sBytes[sBytes.size() - 3] ^= 0x20;
+   WriteFile( sCache, sBytes );
+
+   Check( !Run(sDirectory, sScript, vecLines), "corrupt file ignored" );
+   Check( ReadFile(sCache) == sGood, "corrupt file rewritten" );
+
+   // Cut short, inside the body and inside the header
+
+   WriteFile( sCache, sGood.substr(0, sGood.size() / 2) );
+
+   Check( !Run(sDirectory, sScript, vecLines), "truncated file ignored" );
+
+   WriteFile( sCache, sGood.substr(0, 10) );
+
+   Check( !Run(sDirectory, sScript, vecLines), "truncated header ignored" );
+
+   WriteFile( sCache, std::string() );
+
+   Check( !Run(sDirectory, sScript, vecLines), "empty file ignored" );
+
+   // The version follows the magic number
+
+   sBytes = sGood;
+   sBytes[4] ^= 0x01;
+   WriteFile( sCache, sBytes );
+
+   Check( !Run(sDirectory, sScript, vecLines), "other version ignored" );
+   Check( Run(sDirectory, sScript, vecLines), "rewritten after the other version" );
+
+   remove( sCache.c_str() );
+   remove( sScript.c_str() );
+}
+
+static void TestChangedWhileRunning( const std::string& sDirectory )
+{
+   std::string sScript = sDirectory + "/changing.txt";
+
+   WriteFile( sScript, "echo old\n" );
+
+   size_t iFiles = ListCacheFiles( sDirectory ).size();
+
+   CKeyProgramCache kpcCache;
+
+   Check( !kpcCache.Open(sDirectory, sScript, 0), "changing script not cached" );
+
+   kpcCache.SetLines( std::vector<std::string>(1, "echo old") );
+   kpcCache.Find( "echo old" );
+
+   WriteFile( sScript, "echo new\n" );
+
+   Check( kpcCache.Save(), "save of a changed script" );
+   Check( ListCacheFiles(sDirectory).size() == iFiles, "changed script not saved" );
+
+   remove( sScript.c_str() );
+}
+
+static void TestPrune( const std::string& sDirectory )
+{
+   std::vector<std::string> vecLines;
+
+   for ( int iScript = 0; iScript < CKeyProgramCache::MAX_FILES + 10; iScript++ )
+   {
+      char szName[64];
+      snprintf( szName, sizeof(szName), "/renamed%03d.txt", iScript );
+
+      std::string sScript = sDirectory + szName;
+
+      WriteFile( sScript, "hostname\n" );
+      Run( sDirectory, sScript, vecLines );
+      remove( sScript.c_str() );
+   }
+
+   std::vector<std::string> vecFiles = ListCacheFiles( sDirectory );
+
+   Check( vecFiles.size() == CKeyProgramCache::MAX_FILES, "directory held to MAX_FILES" );
+
+   for ( size_t iLoop = 0; iLoop < vecFiles.size(); iLoop++ )
+   {
+      remove( vecFiles[iLoop].c_str() );
+   }
+}
+
+int main()
+{
+   const char* pszTemp = getenv( "TMPDIR" );
+
+   std::string sDirectory = std::string( (pszTemp && *pszTemp) ? pszTemp : "/tmp" ) + 
+      "/puttycs_test.XXXXXX";
+
+   if ( !mkdtemp(&sDirectory[0]) )
+   {
+      printf( "cannot create a temporary directory\n" );
+      return 1;
+   }
+
+   TestStale( sDirectory );
+   TestDamaged( sDirectory );
+   TestChangedWhileRunning( sDirectory );
+   TestPrune( sDirectory );
+
+   std::vector<std::string> vecFiles = ListCacheFiles( sDirectory );
+
+   for ( size_t iLoop = 0; iLoop < vecFiles.size(); iLoop++ )
+   {
+      remove( vecFiles[iLoop].c_str() );
+   }
+
+   rmdir( sDirectory.c_str() );
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/**
+ * KeyTokenizerTest.cpp - PuTTYCS SendKeys tokenizer test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "KeyProgram.h"
+#include "KeyTokenizer.h"
+
+/**
+ * Tokenizes SendKeys strings as char and as wchar_t, the TCHAR of a
+ * Unicode build: the tokens must cover the whole string, and a {
+ * without its } must stop with KEYERROR_UNTERMINATED at the offset
+ * of that {, however long the text after it. Then checks that
+ * CKeyProgram reports the same position and keeps the keys before
+ * it.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+/**
+ * The tokens of sKeys written back as SendKeys text, with the error
+ * and the position where tokenizing stopped
+ */
+
+template <class CHAR>
+static std::basic_string<CHAR> Retokenize( const std::basic_string<CHAR>& sKeys, int& iError, size_t& iPosition )
+{
+   CKeyTokenizer<CHAR> ktTokens( sKeys.data(), sKeys.size() );
+
+   KEYTOKEN<CHAR> token;
+
+   std::basic_string<CHAR> sText;
+
+   while ( ktTokens.Next(token) )
+   {
+      if ( token.iType == KEYTOKEN_SPECIAL )
+      {
+         sText += (CHAR) '{';
+         sText.append( token.spText.pText, token.spText.iLength );
+         sText += (CHAR) '}';
+      }
+      else
+      {
+         sText.append( token.spText.pText, token.spText.iLength );
+      }
+   }
+
+   // Next() stays false once it stopped
+
+   Check( !ktTokens.Next(token), "tokens: stopped" );
+
+   iError = ktTokens.GetError();
+   iPosition = ktTokens.GetPosition();
+
+   return sText;
+}
+
+template <class CHAR>
+static std::basic_string<CHAR> Widen( const std::string& sText )
+{
+   return std::basic_string<CHAR>( sText.begin(), sText.end() );
+}
+
+/**
+ * Checks sKeys as CHAR: size_t(-1) for iErrorAt means no error
+ */
+
+template <class CHAR>
+static void CheckKeys( const std::string& sKeys, size_t iErrorAt, const char* pszWhat )
+{
+   std::basic_string<CHAR> sWide = Widen<CHAR>( sKeys );
+
+   int iError = KEYERROR_NONE;
+   size_t iPosition = 0;
+
+   std::basic_string<CHAR> sText = Retokenize( sWide, iError, iPosition );
+
+   bool bResult;
+
+   if ( iErrorAt == (size_t) -1 )
+   {
+      bResult = (iError == KEYERROR_NONE) && (iPosition == sWide.size()) && (sText == sWide);
+   }
+   else
+   {
+      bResult = (iError == KEYERROR_UNTERMINATED) && (iPosition == iErrorAt) && 
+         (sText == sWide.substr(0, iErrorAt));
+   }
+
+   if ( !bResult )
+   {
+      printf( "%s (%u byte chars) failed: error %d at %u\n", pszWhat, (unsigned int) sizeof(CHAR), 
+         iError, (unsigned int) iPosition );
+
+      g_iFailures++;
+   }
+}
+
+static void TestTokenizer()
+{
+   struct KEYSCASE
+   {
+      const char* pszKeys;
+      size_t iErrorAt;
+   };
+
+   const size_t KEYS_NO_ERROR = (size_t) -1;
+
+   const KEYSCASE aCases[] =
+   {
+      { "", KEYS_NO_ERROR },
+      { "ls -l~", KEYS_NO_ERROR },
+      { "+(ab)^c%{F4}@r{UP 3}{DELAY=10}", KEYS_NO_ERROR },
+      { "{}", KEYS_NO_ERROR },
+      { "{{}", KEYS_NO_ERROR },
+      { "{", 0 },
+      { "abc{", 3 },
+      { "abc{UP", 3 },
+      { "{UP}{DOWN", 4 },
+      { "echo {%VAR", 5 },
+      { "(^a{ENTER)", 3 },
+      { "{UP}}{", 5 },
+      { "ab{LEFTBRACE}{{", 13 }
+   };
+
+   for ( size_t iCase = 0; iCase < sizeof(aCases) / sizeof(aCases[0]); iCase++ )
+   {
+      CheckKeys<char>( aCases[iCase].pszKeys, aCases[iCase].iErrorAt, aCases[iCase].pszKeys );
+      CheckKeys<wchar_t>( aCases[iCase].pszKeys, aCases[iCase].iErrorAt, aCases[iCase].pszKeys );
+   }
+
+   // No limit on the length of a {...}, and the error is still at the {
+
+   std::string sLong = "{APPACTIVATE " + std::string( 100000, 'x' ) + "}";
+
+   CheckKeys<char>( sLong, KEYS_NO_ERROR, "long {...}" );
+   CheckKeys<wchar_t>( sLong, KEYS_NO_ERROR, "long {...}" );
+   CheckKeys<char>( "ok" + sLong.substr(0, sLong.size() - 1), 2, "long unterminated {...}" );
+   CheckKeys<wchar_t>( "ok" + sLong.substr(0, sLong.size() - 1), 2, "long unterminated {...}" );
+
+   // The end is the length given, a NUL is text like any other
+
+   std::string sNul( "a\0{b}", 5 );
+
+   CheckKeys<char>( sNul, KEYS_NO_ERROR, "NUL in the keys" );
+   CheckKeys<char>( sNul.substr(0, 4), 2, "NUL before the {" );
+
+   // The string constructor stops at the NUL
+
+   CKeyTokenizer<char> ktTokens( "ab{" );
+
+   KEYTOKEN<char> token;
+
+   while ( ktTokens.Next(token) )
+   {
+   }
+
+   Check( (ktTokens.GetError() == KEYERROR_UNTERMINATED) && (ktTokens.GetPosition() == 2), 
+      "string constructor" );
+
+   // Positions are in CHARs: bytes of UTF-8
+
+   CheckKeys<char>( "\xc3\xa9t\xc3\xa9{", 5, "UTF-8 before the {" );
+}
+
+static void TestProgram()
+{
+   CKeyProgram kpProgram;
+
+   Check( kpProgram.Compile("ls{ENTER}"), "program: compiles" );
+   Check( (kpProgram.GetError() == KEYERROR_NONE) && (kpProgram.GetKeystrokes() == 3), "program: no error" );
+
+   Check( !kpProgram.Compile("ls -l{ENTER"), "program: unterminated" );
+   Check( kpProgram.GetError() == KEYERROR_UNTERMINATED, "program: error" );
+   Check( kpProgram.GetErrorPosition() == 5, "program: error position" );
+   Check( kpProgram.GetKeystrokes() == 5, "program: keys before the error kept" );
+
+   // A group open at the error releases its modifiers
+
+   Check( !kpProgram.Compile("^(ab{"), "program: unterminated in a group" );
+   Check( kpProgram.GetErrorPosition() == 4, "program: group error position" );
+   Check( kpProgram.GetOps().back().iType == KEYOP::KEYOP_RELEASE, "program: modifiers released" );
+
+   // The next Compile() starts clean
+
+   Check( kpProgram.Compile("x") && (kpProgram.GetError() == KEYERROR_NONE), "program: error cleared" );
+}
+
+int main()
+{
+   TestTokenizer();
+   TestProgram();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
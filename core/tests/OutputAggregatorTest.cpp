@@ -0,0 +1,275 @@
+/**
+ * OutputAggregatorTest.cpp - PuTTYCS output aggregator test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "OutputAggregator.h"
+
+/**
+ * Groups the output of simulated targets: output split anywhere,
+ * inside escape sequences too, groups as if it came in one piece;
+ * colours, carriage returns and the echoed command lines are not
+ * part of the output; outputs that differ past the sample are still
+ * told apart; exited targets are grouped apart. Also the dshbak
+ * style formatting and the name ranges.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static void CheckText( const std::string& sText, const char* pszExpected, const char* pszWhat )
+{
+   if ( sText != pszExpected )
+   {
+      printf( "%s failed: '%s'\n", pszWhat, sText.c_str() );
+
+      g_iFailures++;
+   }
+}
+
+static void Append( COutputAggregator& oaAggregator, WINDOWID id, const std::string& sOutput )
+{
+   oaAggregator.Append( id, sOutput.data(), sOutput.size() );
+}
+
+static void TestGroups()
+{
+   COutputAggregator oaAggregator;
+
+   for ( WINDOWID id = 1; id <= 80; id++ )
+   {
+      char szName[32];
+      snprintf( szName, sizeof(szName), "web%02d", (int) id );
+
+      oaAggregator.Begin( id, szName, 1 );
+
+      // The echo differs from host to host and is skipped
+
+      Append( oaAggregator, id, std::string("admin@") + szName + ":~$ systemctl is-active nginx\r\n" );
+
+      if ( id % 10 == 3 )
+      {
+         Append( oaAggregator, id, "\x1b[31merror X\x1b[0m\r\n" );
+      }
+      else if ( id % 2 )
+      {
+         Append( oaAggregator, id, "\x1b[32mOK\x1b[0m\r\n" );
+      }
+      else
+      {
+         Append( oaAggregator, id, "O" );
+         Append( oaAggregator, id, "K\n" );
+      }
+   }
+
+   Append( oaAggregator, 999, "not captured\n" );
+
+   std::vector<OUTPUTGROUP> vecGroups;
+   oaAggregator.GetGroups( vecGroups );
+
+   Check( oaAggregator.GetTargetCount() == 80, "groups: targets" );
+   Check( vecGroups.size() == 2, "groups: two outputs" );
+   Check( (vecGroups[0].vecNames.size() == 72) && (vecGroups[0].sSample == "OK\n"), "groups: largest first" );
+   Check( (vecGroups[1].vecNames.size() == 8) && (vecGroups[1].vecNames[0] == "web03"), "groups: names in order" );
+
+   CheckText( oaAggregator.FormatSummary(), "72 hosts: OK / 8 hosts: error X", "groups: summary" );
+   CheckText( COutputAggregator::CompressNames(vecGroups[1].vecNames), 
+      "web[03,13,23,33,43,53,63,73]", "groups: names" );
+
+   // Begin() again starts over
+
+   oaAggregator.Begin( 3, "web03" );
+   Append( oaAggregator, 3, "OK\n" );
+
+   oaAggregator.GetGroups( vecGroups );
+
+   Check( (vecGroups[0].vecNames.size() == 73) && (oaAggregator.GetTargetCount() == 80), "groups: begun again" );
+
+   oaAggregator.Clear();
+
+   Check( (oaAggregator.GetTargetCount() == 0) && oaAggregator.FormatSummary().empty(), "groups: clear" );
+}
+
+static void TestChunks()
+{
+   const std::string sOutput = 
+      "\x1b]0;admin@web01: ~\x07" "Filesystem  Size\r\n" "\x1b[1;34m/dev/sda1\x1b[0m   20G\r\n" 
+      "\x1b" "7done\x1b]2;title\x1b\\\n";
+
+   COutputAggregator oaAggregator;
+
+   oaAggregator.Begin( 1, "whole" );
+   Append( oaAggregator, 1, sOutput );
+
+   for ( size_t iSplit = 1; iSplit < sOutput.size(); iSplit++ )
+   {
+      oaAggregator.Begin( 1 + iSplit, "split" );
+      Append( oaAggregator, 1 + iSplit, sOutput.substr(0, iSplit) );
+      Append( oaAggregator, 1 + iSplit, sOutput.substr(iSplit) );
+   }
+
+   // A byte at a time
+
+   oaAggregator.Begin( 1000, "bytes" );
+
+   for ( size_t iLoop = 0; iLoop < sOutput.size(); iLoop++ )
+   {
+      oaAggregator.Append( 1000, &sOutput[iLoop], 1 );
+   }
+
+   std::vector<OUTPUTGROUP> vecGroups;
+   oaAggregator.GetGroups( vecGroups );
+
+   Check( vecGroups.size() == 1, "chunks: one group" );
+   Check( vecGroups[0].sSample == "Filesystem  Size\n/dev/sda1   20G\ndone\n", "chunks: text only" );
+}
+
+static void TestSample()
+{
+   COutputAggregator oaAggregator( 16 );
+
+   std::string sLong( 1000, 'x' );
+
+   oaAggregator.Begin( 1, "a1" );
+   oaAggregator.Begin( 2, "a2" );
+   oaAggregator.Begin( 3, "a3" );
+   oaAggregator.Begin( 4, "a4" );
+   oaAggregator.Begin( 5, "gone" );
+   oaAggregator.SetExited( 5 );
+
+   Append( oaAggregator, 1, sLong + "1\n" );
+   Append( oaAggregator, 2, sLong + "1\n" );
+   Append( oaAggregator, 3, sLong + "2\n" );
+
+   std::vector<OUTPUTGROUP> vecGroups;
+   oaAggregator.GetGroups( vecGroups );
+
+   Check( vecGroups.size() == 4, "sample: differences past the sample" );
+   Check( (vecGroups[0].vecNames.size() == 2) && vecGroups[0].bTruncated && 
+          (vecGroups[0].iBytes == 1002) && (vecGroups[0].sSample == std::string(16, 'x')), "sample: truncated" );
+   Check( !vecGroups[2].bExited && vecGroups[2].sSample.empty(), "sample: no output" );
+   Check( vecGroups[3].bExited && (vecGroups[3].vecNames[0] == "gone"), "sample: exited apart" );
+
+   CheckText( oaAggregator.FormatSummary(), 
+      "2 hosts: xxxxxxxxxxxxxxxx / 1 host: xxxxxxxxxxxxxxxx / 1 host: (no output) / 1 host: (exited)",
+      "sample: summary" );
+   CheckText( oaAggregator.FormatSummary(1), "2 hosts: xxxxxxxxxxxxxxxx / 3 more outputs from 3 hosts",
+      "sample: summary cut" );
+   CheckText( oaAggregator.FormatGroups(),
+      "----------------\na[1-2] (2)\n----------------\nxxxxxxxxxxxxxxxx\n... (1002 bytes)\n"
+      "----------------\na3 (1)\n----------------\nxxxxxxxxxxxxxxxx\n... (1002 bytes)\n"
+      "----------------\na4 (1)\n----------------\n"
+      "----------------\ngone (1)\n----------------\n(exited)\n",
+      "sample: groups" );
+
+   // A long first line is cut in the summary
+
+   oaAggregator.Clear();
+   oaAggregator.SetSampleLimit( 4096 );
+
+   oaAggregator.Begin( 1, "web1" );
+   Append( oaAggregator, 1, "\n   " + std::string(100, 'y') + "  \nsecond\n" );
+
+   CheckText( oaAggregator.FormatSummary(), 
+      "1 host: yyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy...", "sample: long line" );
+}
+
+static void TestNames()
+{
+   struct NAMECASE
+   {
+      const char* pszNames;
+      const char* pszExpected;
+   };
+
+   const NAMECASE aCases[] =
+   {
+      { "web1 web2 web3 web7 db01 db02", "db[01-02],web[1-3,7]" },
+      { "web3 web1 web2 web2", "web[1-3]" },
+      { "node9 node10 node11", "node[9-11]" },
+      { "node09 node10", "node[09-10]" },
+      { "web01 web1", "web1,web01" },
+      { "router gateway router", "gateway,router" },
+      { "web1", "web1" },
+      { "host12345678901234567890", "host12345678901234567890" },
+      { "", "" }
+   };
+
+   for ( size_t iCase = 0; iCase < sizeof(aCases) / sizeof(aCases[0]); iCase++ )
+   {
+      std::vector<std::string> vecNames;
+
+      std::string sNames = aCases[iCase].pszNames;
+
+      for ( size_t iStart = 0; iStart < sNames.size(); )
+      {
+         size_t iEnd = sNames.find( ' ', iStart );
+
+         if ( iEnd == std::string::npos )
+         {
+            iEnd = sNames.size();
+         }
+
+         vecNames.push_back( sNames.substr(iStart, iEnd - iStart) );
+
+         iStart = iEnd + 1;
+      }
+
+      CheckText( COutputAggregator::CompressNames(vecNames), aCases[iCase].pszExpected, aCases[iCase].pszNames );
+   }
+}
+
+int main()
+{
+   TestGroups();
+   TestChunks();
+   TestSample();
+   TestNames();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,397 @@
+/**
+ * ScriptPacerTest.cpp - PuTTYCS script pacer test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "ScriptPacer.h"
+#include "SimWindowSystem.h"
+
+/**
+ * Paces scripts into simulated shells that take their time for each
+ * command and then print a coloured prompt. Checks that no shell is
+ * typed into while it runs a command, that a fast shell gets through
+ * the script without waiting for a slow one, that a shell without a
+ * prompt gets its lines at the line timeout, that an unwatched one
+ * gets them at once, and what the prompt is matched against.
+ */
+
+static const char* PACER_TEST_PROMPT = "\\$ $";
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static double GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * A shell in a simulated window: each line typed into it runs for
+ * dCommandMs, then it prints a line of output and, if bPrompts, the
+ * prompt. A line typed while a command runs is counted.
+ */
+
+struct SIMSHELL
+{
+   WINDOWID id;
+
+   double dCommandMs;
+   bool bPrompts;
+
+   size_t iTypedSeen;
+   double dBusyUntil;
+
+   int iOverruns;
+   std::vector<double> vecLineMs;
+};
+
+class CShellDesktop
+{
+public:
+
+   CShellDesktop()
+   {
+      SIMLATENCY latency;
+      latency.dActivateMs = 0.0;
+      latency.dForegroundMs = 0.0;
+      latency.dKeyMs = 0.0;
+      latency.dIdleMs = 0.0;
+      latency.dJitter = 0.0;
+      latency.dFocusFailure = 0.0;
+
+      m_swsSystem.SetLatency( latency );
+
+      m_pEngine.reset( new CBroadcastEngine(&m_swsSystem) );
+      m_pEngine->SetPostSendDelay( 0 );
+
+      m_dStartMs = GetMilliseconds();
+   }
+
+   size_t AddShell( const std::string& sTitle, double dCommandMs, bool bPrompts )
+   {
+      SIMSHELL shell;
+      shell.id = m_swsSystem.AddWindow( sTitle );
+      shell.dCommandMs = dCommandMs;
+      shell.bPrompts = bPrompts;
+      shell.iTypedSeen = 0;
+      shell.dBusyUntil = -1.0;
+      shell.iOverruns = 0;
+
+      m_vecShells.push_back( shell );
+
+      return m_vecShells.size() - 1;
+   }
+
+   /**
+    * The poll function of CScriptPacer::Run(): runs the shells until
+    * one prints or iTimeoutMs passes
+    */
+
+   void Poll( CScriptPacer& spPacer, int iTimeoutMs )
+   {
+      double dEndMs = GetMilliseconds() + iTimeoutMs;
+
+      for ( ;; )
+      {
+         double dNowMs = GetMilliseconds();
+
+         bool bPrinted = false;
+
+         for ( size_t iLoop = 0; iLoop < m_vecShells.size(); iLoop++ )
+         {
+            SIMSHELL& shell = m_vecShells[iLoop];
+
+            std::string sTyped = m_swsSystem.GetTyped( shell.id );
+
+            for ( size_t iChar = shell.iTypedSeen; iChar < sTyped.size(); iChar++ )
+            {
+               if ( sTyped[iChar] != '\r' )
+               {
+                  continue;
+               }
+
+               if ( shell.dBusyUntil >= 0.0 )
+               {
+                  shell.iOverruns++;
+               }
+
+               shell.vecLineMs.push_back( dNowMs - m_dStartMs );
+               shell.dBusyUntil = dNowMs + shell.dCommandMs;
+            }
+
+            shell.iTypedSeen = sTyped.size();
+
+            if ( (shell.dBusyUntil >= 0.0) && (dNowMs >= shell.dBusyUntil) )
+            {
+               shell.dBusyUntil = -1.0;
+
+               // The prompt comes in two pieces, split inside an escape sequence
+
+               const std::string sOutput = "done\r\n\x1b[01;32madmin@web01\x1b[00m:~$ ";
+               const std::string sPrompt = shell.bPrompts ? sOutput : "done\r\n";
+
+               spPacer.Output( shell.id, sPrompt.data(), sPrompt.size() / 2 );
+               spPacer.Output( shell.id, sPrompt.data() + sPrompt.size() / 2, 
+                  sPrompt.size() - sPrompt.size() / 2 );
+
+               bPrinted = true;
+            }
+         }
+
+         if ( bPrinted || (dNowMs >= dEndMs) )
+         {
+            return;
+         }
+
+         std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+      }
+   }
+
+   std::string GetTyped( size_t iShell )
+   {
+      return m_swsSystem.GetTyped( m_vecShells[iShell].id );
+   }
+
+   CBroadcastEngine* GetEngine()
+   {
+      return m_pEngine.get();
+   }
+
+   SIMSHELL& GetShell( size_t iShell )
+   {
+      return m_vecShells[iShell];
+   }
+
+   double GetTime()
+   {
+      return GetMilliseconds() - m_dStartMs;
+   }
+
+protected:
+
+   CSimWindowSystem m_swsSystem;
+   std::unique_ptr<CBroadcastEngine> m_pEngine;
+
+   std::vector<SIMSHELL> m_vecShells;
+
+   double m_dStartMs;
+};
+
+static std::vector<std::string> MakeLines( int iCount )
+{
+   std::vector<std::string> vecLines;
+
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      char szLine[32];
+      snprintf( szLine, sizeof(szLine), "echo %d", iLoop );
+
+      vecLines.push_back( szLine );
+   }
+
+   return vecLines;
+}
+
+static std::string JoinLines( const std::vector<std::string>& vecLines )
+{
+   std::string sText;
+
+   for ( size_t iLoop = 0; iLoop < vecLines.size(); iLoop++ )
+   {
+      sText += vecLines[iLoop] + "\r";
+   }
+
+   return sText;
+}
+
+static void RunPacer( CShellDesktop& sdDesktop, CScriptPacer& spPacer )
+{
+   spPacer.Run( [&sdDesktop, &spPacer]( int iTimeoutMs ) { sdDesktop.Poll(spPacer, iTimeoutMs); } );
+
+   // Let the last commands finish
+
+   sdDesktop.Poll( spPacer, 100 );
+}
+
+static void TestPacing()
+{
+   CShellDesktop sdDesktop;
+
+   size_t iFast = sdDesktop.AddShell( "fast", 2.0, true );
+   size_t iMedium = sdDesktop.AddShell( "medium", 20.0, true );
+   size_t iSlow = sdDesktop.AddShell( "slow", 100.0, true );
+
+   std::vector<std::string> vecLines = MakeLines( 5 );
+
+   CScriptPacer spPacer( sdDesktop.GetEngine() );
+   spPacer.SetLineTimeout( 5000 );
+
+   Check( spPacer.SetPrompt(PACER_TEST_PROMPT), "pacing: prompt" );
+   Check( spPacer.Start(vecLines, "all||+*", false, true) == 3, "pacing: targets" );
+
+   double dStartMs = sdDesktop.GetTime();
+
+   RunPacer( sdDesktop, spPacer );
+
+   double dElapsedMs = sdDesktop.GetTime() - dStartMs;
+
+   for ( size_t iShell = 0; iShell < 3; iShell++ )
+   {
+      Check( sdDesktop.GetTyped(iShell) == JoinLines(vecLines), "pacing: lines in order" );
+      Check( sdDesktop.GetShell(iShell).iOverruns == 0, "pacing: no line while busy" );
+   }
+
+   Check( spPacer.IsFinished() && (spPacer.GetTimeouts() == 0), "pacing: no timeouts" );
+
+   // The fast shell is through before the slow one gets its second line
+
+   Check( sdDesktop.GetShell(iFast).vecLineMs.back() < sdDesktop.GetShell(iSlow).vecLineMs[1], 
+      "pacing: fast shell not held up" );
+   Check( sdDesktop.GetShell(iMedium).vecLineMs.back() < sdDesktop.GetShell(iSlow).vecLineMs.back(), 
+      "pacing: medium shell before slow" );
+
+   // Lines follow the prompt, not the timeout
+
+   Check( dElapsedMs < 2000.0, "pacing: no waiting for the timeout" );
+}
+
+static void TestTimeout()
+{
+   CShellDesktop sdDesktop;
+
+   size_t iSilent = sdDesktop.AddShell( "silent", 5.0, false );
+   size_t iUnwatched = sdDesktop.AddShell( "unwatched", 5.0, false );
+
+   std::vector<std::string> vecLines = MakeLines( 3 );
+
+   CScriptPacer spPacer( sdDesktop.GetEngine() );
+   spPacer.SetLineTimeout( 100 );
+   spPacer.SetPrompt( PACER_TEST_PROMPT );
+   spPacer.Start( vecLines, "all||+*", false, true );
+
+   spPacer.SetWatched( sdDesktop.GetShell(iUnwatched).id, false );
+
+   double dStartMs = sdDesktop.GetTime();
+
+   RunPacer( sdDesktop, spPacer );
+
+   const std::vector<double>& vecSilent = sdDesktop.GetShell( iSilent ).vecLineMs;
+   const std::vector<double>& vecUnwatched = sdDesktop.GetShell( iUnwatched ).vecLineMs;
+
+   Check( sdDesktop.GetTyped(iSilent) == JoinLines(vecLines), "timeout: lines in order" );
+   Check( spPacer.GetTimeouts() == 2, "timeout: timeouts counted" );
+   Check( (vecSilent.size() == 3) && (vecSilent[1] - vecSilent[0] >= 95.0) && (vecSilent[2] - vecSilent[1] >= 95.0), 
+      "timeout: a line per timeout" );
+   Check( sdDesktop.GetTime() - dStartMs < 1000.0, "timeout: not much longer" );
+
+   Check( sdDesktop.GetTyped(iUnwatched) == JoinLines(vecLines), "unwatched: lines in order" );
+   Check( (vecUnwatched.size() == 3) && (vecUnwatched[2] - dStartMs < 50.0), "unwatched: lines at once" );
+}
+
+static void TestPrompt()
+{
+   CShellDesktop sdDesktop;
+
+   WINDOWID id = sdDesktop.GetShell( sdDesktop.AddShell("host", 0.0, true) ).id;
+
+   CScriptPacer spPacer( sdDesktop.GetEngine() );
+   spPacer.SetLineTimeout( 60000 );
+
+   Check( !spPacer.SetPrompt("(unclosed"), "prompt: invalid pattern" );
+   Check( !CScriptPacer::IsValidPrompt("[a-"), "prompt: invalid pattern checked" );
+   Check( CScriptPacer::IsValidPrompt(PACER_TEST_PROMPT), "prompt: valid pattern checked" );
+
+   spPacer.SetPrompt( PACER_TEST_PROMPT );
+   spPacer.Start( MakeLines(4), "all||+*", false, true );
+
+   Check( spPacer.Step() == 1, "prompt: first line at once" );
+   Check( spPacer.Step() == 0, "prompt: second line waits" );
+
+   // A prompt followed by more output is not one
+
+   const char szOutput[] = "$ \x1b[1mmore\x1b[0m\r\n$";
+   spPacer.Output( id, szOutput, sizeof(szOutput) - 1 );
+
+   Check( spPacer.Step() == 0, "prompt: not at the end" );
+
+   const char szPrompt[] = " ";
+   spPacer.Output( id, szPrompt, 1 );
+
+   Check( spPacer.Step() == 1, "prompt: completed" );
+
+   // Output from before the line was sent does not count
+
+   Check( spPacer.Step() == 0, "prompt: reset by the send" );
+
+   // A prompt at the end of a very long line
+
+   std::string sLong = std::string( 5000, 'x' ) + "$ ";
+   spPacer.Output( id, sLong.data(), sLong.size() );
+
+   Check( spPacer.Step() == 1, "prompt: end of a long line" );
+
+   // Without a prompt lines go out back to back
+
+   CScriptPacer spUnpaced( sdDesktop.GetEngine() );
+   spUnpaced.Start( MakeLines(2), "all||+*", false, true );
+
+   Check( (spUnpaced.Step() == 1) && (spUnpaced.Step() == 1) && spUnpaced.IsFinished(), 
+      "prompt: none set" );
+}
+
+int main()
+{
+   TestPacing();
+   TestTimeout();
+   TestPrompt();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
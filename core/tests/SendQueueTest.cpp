@@ -0,0 +1,224 @@
+/**
+ * SendQueueTest.cpp - PuTTYCS send queue test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "KeyProgram.h"
+#include "SendQueue.h"
+
+/**
+ * Checks which requests the send queue folds into the waiting job,
+ * that a folded repeat types the same keys as the requests it
+ * replaces, and that a saturated queue drops requests until the
+ * sender pops.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+/**
+ * The keystrokes sKeys types, one op per keystroke
+ */
+
+static std::string GetKeys( const std::string& sKeys )
+{
+   CKeyProgram kpProgram;
+
+   if ( !kpProgram.Compile(sKeys) )
+   {
+      return "error";
+   }
+
+   std::string sTyped;
+
+   const std::vector<KEYOP>& vecOps = kpProgram.GetOps();
+
+   for ( size_t iLoop = 0; iLoop < vecOps.size(); iLoop++ )
+   {
+      char szOp[32];
+      snprintf( szOp, sizeof(szOp), "%d:%u;", vecOps[iLoop].iType, vecOps[iLoop].uiValue );
+
+      for ( unsigned int uiCount = 0; uiCount < vecOps[iLoop].uiCount; uiCount++ )
+      {
+         sTyped += szOp;
+      }
+   }
+
+   return sTyped;
+}
+
+static void TestCoalescing()
+{
+   CSendQueue sqQueue( 16 );
+
+   Check( sqQueue.Push("{UP}", "all", false, false, 0), "coalesce: first push" );
+   Check( sqQueue.Push("{UP}", "all", false, false, 0), "coalesce: second push" );
+   Check( sqQueue.Push("{UP 2}", "all", false, false, 0), "coalesce: counted push" );
+   Check( sqQueue.Push("ls", "all", false, false, 0), "coalesce: text push" );
+
+   Check( sqQueue.GetJobs() == 1, "coalesce: one job" );
+   Check( sqQueue.GetPending() == 4, "coalesce: four requests pending" );
+   Check( sqQueue.GetCoalesced() == 3, "coalesce: three coalesced" );
+
+   // A different filter or flag starts a new job
+
+   sqQueue.Push( "{UP}", "web*", false, false, 0 );
+   sqQueue.Push( "{UP}", "web*", true, false, 0 );
+   sqQueue.Push( "{UP}", "web*", true, true, 0 );
+   sqQueue.Push( "{UP}", "web*", true, true, 1 );
+
+   Check( sqQueue.GetJobs() == 5, "coalesce: new job per filter and flags" );
+
+   // Parsed buffers are kept apart, since each ends in Enter or Tab
+
+   sqQueue.Push( "{UP}", "web*", true, true, 1 );
+
+   SENDJOB job;
+
+   Check( sqQueue.Pop(job), "coalesce: pop" );
+   Check( job.sEntry == "all", "coalesce: job in push order" );
+   Check( job.iRequests == 4, "coalesce: requests in the job" );
+   Check( (job.vecBuffers.size() == 2) && (job.vecBuffers[0] == "{UP 4}") && (job.vecBuffers[1] == "ls"), 
+      "coalesce: repeats folded, text kept" );
+   Check( GetKeys(job.vecBuffers[0]) == GetKeys("{UP}{UP}{UP}{UP}"), "coalesce: same keys typed" );
+   Check( sqQueue.GetPending() == 5, "coalesce: pending after pop" );
+
+   for ( int iLoop = 0; iLoop < 4; iLoop++ )
+   {
+      sqQueue.Pop( job );
+   }
+
+   Check( (job.vecBuffers.size() == 2) && (job.vecBuffers[1] == "{UP}"), "coalesce: parsed kept apart" );
+   Check( sqQueue.IsEmpty() && (sqQueue.GetPending() == 0), "coalesce: empty" );
+
+   // A large buffer, or one that would pass the job size, gets a job of its own
+
+   sqQueue.Push( "x", "all", false, false, 0 );
+   sqQueue.Push( std::string(CSendQueue::SMALL_BUFFER + 1, 'y'), "all", false, false, 0 );
+
+   Check( sqQueue.GetJobs() == 2, "coalesce: large buffer not joined" );
+
+   sqQueue.Clear();
+   sqQueue.SetCapacity( 100 );
+
+   for ( int iLoop = 0; iLoop < 40; iLoop++ )
+   {
+      sqQueue.Push( std::string(CSendQueue::SMALL_BUFFER, 'z'), "all", false, false, 0 );
+   }
+
+   Check( sqQueue.GetJobs() == 3, "coalesce: full job closed" );
+
+   while ( sqQueue.Pop(job) )
+   {
+      size_t iBytes = 0;
+
+      for ( size_t iLoop = 0; iLoop < job.vecBuffers.size(); iLoop++ )
+      {
+         iBytes += job.vecBuffers[iLoop].size();
+      }
+
+      Check( iBytes <= CSendQueue::MAX_JOB_BYTES, "coalesce: job size bounded" );
+   }
+
+   // Only a whole named key repeats
+
+   std::string sKeys = "{UP}";
+
+   Check( !CSendQueue::MergeRepeat(sKeys, "{DOWN}"), "merge: other key" );
+   Check( !CSendQueue::MergeRepeat(sKeys, "{UP}{UP}"), "merge: two keys" );
+   Check( !CSendQueue::MergeRepeat(sKeys, "{NOSUCHKEY}"), "merge: unknown key" );
+   Check( !CSendQueue::MergeRepeat(sKeys, "{UP 0}"), "merge: zero count" );
+   Check( !CSendQueue::MergeRepeat(sKeys, "{UP x}"), "merge: bad count" );
+   Check( sKeys == "{UP}", "merge: keys left alone" );
+   Check( CSendQueue::MergeRepeat(sKeys, "{UP 9}") && (sKeys == "{UP 10}"), "merge: counts added" );
+}
+
+static void TestSaturation()
+{
+   CSendQueue sqQueue( 4 );
+
+   for ( int iLoop = 0; iLoop < 4; iLoop++ )
+   {
+      Check( sqQueue.Push("{UP}", "all", false, false, 0), "saturate: push under capacity" );
+   }
+
+   // Coalesced requests count too: one job, but four requests
+
+   Check( sqQueue.GetJobs() == 1, "saturate: one job" );
+   Check( sqQueue.IsSaturated(), "saturate: saturated" );
+   Check( !sqQueue.Push("{UP}", "all", false, false, 0), "saturate: push dropped" );
+   Check( !sqQueue.Push("ls", "web*", false, false, 0), "saturate: other filter dropped" );
+   Check( sqQueue.GetRejected() == 2, "saturate: drops counted" );
+   Check( sqQueue.GetPending() == 4, "saturate: drops not pending" );
+
+   SENDJOB job;
+   sqQueue.Pop( job );
+
+   Check( (job.vecBuffers.size() == 1) && (job.vecBuffers[0] == "{UP 4}"), "saturate: dropped key not typed" );
+   Check( !sqQueue.IsSaturated(), "saturate: free after pop" );
+   Check( sqQueue.Push("{UP}", "all", false, false, 0), "saturate: push after pop" );
+
+   sqQueue.Clear();
+
+   Check( sqQueue.IsEmpty() && (sqQueue.GetPending() == 0), "saturate: clear" );
+
+   // A smaller capacity takes effect at the next push
+
+   sqQueue.SetCapacity( 0 );
+
+   Check( sqQueue.GetCapacity() == 1, "saturate: capacity at least 1" );
+   Check( sqQueue.Push("a", "all", false, false, 0), "saturate: one request" );
+   Check( !sqQueue.Push("b", "all", false, false, 0), "saturate: second dropped" );
+}
+
+int main()
+{
+   TestCoalescing();
+   TestSaturation();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
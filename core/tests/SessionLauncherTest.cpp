@@ -0,0 +1,313 @@
+/**
+ * SessionLauncherTest.cpp - PuTTYCS session launcher test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SessionLauncher.h"
+#include "SimProcessSpawner.h"
+
+/**
+ * Launches sessions through a simulated process spawner and checks
+ * that hosts are spawned in list order, that no more processes than
+ * the concurrency are starting and no more than the rate are
+ * spawned a second, and that spawns that fail, processes that exit
+ * and windows that never show each end their host without holding
+ * up the others.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static SIMSTARTUP MakeStartup( double dWindowMs, double dJitter )
+{
+   SIMSTARTUP startup;
+   startup.dSpawnMs = 5.0;
+   startup.dWindowMs = dWindowMs;
+   startup.dJitter = dJitter;
+   startup.dFailure = 0.0;
+
+   return startup;
+}
+
+static std::vector<std::string> MakeHosts( int iCount )
+{
+   std::vector<std::string> vecHosts;
+
+   for ( int iLoop = 0; iLoop < iCount; iLoop++ )
+   {
+      char szHost[32];
+      snprintf( szHost, sizeof(szHost), "host%02d", iLoop );
+
+      vecHosts.push_back( szHost );
+   }
+
+   return vecHosts;
+}
+
+/**
+ * Fails to spawn the command of any host named unreachable*
+ */
+
+class CFailingSpawner : public CSimProcessSpawner
+{
+public:
+
+   virtual bool Spawn( const std::string& sCommand, PROCESSID& pid )
+   {
+      if ( sCommand.find("unreachable") != std::string::npos )
+      {
+         return false;
+      }
+
+      return CSimProcessSpawner::Spawn( sCommand, pid );
+   }
+};
+
+static void TestOrder()
+{
+   CSimProcessSpawner spSpawner;
+   spSpawner.SetStartup( MakeStartup(300.0, 0.5) );
+
+   CSessionLauncher slLauncher( &spSpawner );
+   slLauncher.SetCommand( "putty -load \"{%HOST%}\"" );
+   slLauncher.SetConcurrency( 4 );
+   slLauncher.SetRate( 0.0 );
+
+   slLauncher.Start( MakeHosts(12) );
+   slLauncher.Run();
+
+   const std::vector<LAUNCHRESULT>& vecResults = slLauncher.GetResults();
+
+   Check( vecResults.size() == 12, "order: one result per host" );
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_WINDOW) == 12, "order: every host has a window" );
+
+   for ( size_t iLoop = 0; iLoop < vecResults.size(); iLoop++ )
+   {
+      const LAUNCHRESULT& result = vecResults[iLoop];
+
+      Check( result.sCommand == "putty -load \"" + result.sHost + "\"", "order: host put in the command" );
+      Check( spSpawner.GetCommand(result.pid) == result.sCommand, "order: pid runs the host's command" );
+      Check( result.id != 0, "order: window id kept" );
+
+      if ( iLoop > 0 )
+      {
+         Check( result.pid > vecResults[iLoop - 1].pid, "order: spawned in list order" );
+         Check( result.dSpawnMs >= vecResults[iLoop - 1].dSpawnMs, "order: spawn times in list order" );
+      }
+   }
+
+   Check( slLauncher.IsFinished(), "order: finished" );
+}
+
+static void TestConcurrency()
+{
+   CSimProcessSpawner spSpawner;
+   spSpawner.SetStartup( MakeStartup(500.0, 0.5) );
+
+   CSessionLauncher slLauncher( &spSpawner );
+   slLauncher.SetConcurrency( 5 );
+   slLauncher.SetRate( 0.0 );
+
+   slLauncher.Start( MakeHosts(40) );
+
+   size_t iMaxStarting = 0;
+
+   while ( !slLauncher.IsFinished() )
+   {
+      slLauncher.Step();
+
+      size_t iStarting = slLauncher.GetCount( CSessionLauncher::LAUNCH_STARTING );
+
+      if ( iStarting > iMaxStarting )
+      {
+         iMaxStarting = iStarting;
+      }
+
+      spSpawner.Wait( slLauncher.GetWait() );
+   }
+
+   Check( iMaxStarting == 5, "concurrency: five starting at most" );
+   Check( spSpawner.GetMaxStarting() == 5, "concurrency: five processes without a window at most" );
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_WINDOW) == 40, "concurrency: every host has a window" );
+
+   // A limit of 1 starts the sessions one after another
+
+   spSpawner.SetStartup( MakeStartup(100.0, 0.0) );
+
+   slLauncher.SetConcurrency( 1 );
+   slLauncher.Start( MakeHosts(4) );
+   slLauncher.Run();
+
+   const std::vector<LAUNCHRESULT>& vecResults = slLauncher.GetResults();
+
+   for ( size_t iLoop = 1; iLoop < vecResults.size(); iLoop++ )
+   {
+      const LAUNCHRESULT& previous = vecResults[iLoop - 1];
+
+      Check( vecResults[iLoop].dSpawnMs >= previous.dSpawnMs + previous.dStartupMs, 
+         "concurrency: one at a time" );
+   }
+}
+
+static void TestRate()
+{
+   CSimProcessSpawner spSpawner;
+   spSpawner.SetStartup( MakeStartup(10.0, 0.0) );
+
+   CSessionLauncher slLauncher( &spSpawner );
+   slLauncher.SetConcurrency( 100 );
+   slLauncher.SetRate( 20.0 );
+
+   slLauncher.Start( MakeHosts(10) );
+   slLauncher.Run();
+
+   const std::vector<LAUNCHRESULT>& vecResults = slLauncher.GetResults();
+
+   for ( size_t iLoop = 1; iLoop < vecResults.size(); iLoop++ )
+   {
+      Check( vecResults[iLoop].dSpawnMs - vecResults[iLoop - 1].dSpawnMs >= 50.0 - 1e-6, 
+         "rate: 50 ms between spawns" );
+   }
+
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_WINDOW) == 10, "rate: every host has a window" );
+}
+
+static void TestFailures()
+{
+   CFailingSpawner spSpawner;
+   spSpawner.SetStartup( MakeStartup(200.0, 0.0) );
+
+   std::vector<std::string> vecHosts = MakeHosts( 6 );
+   vecHosts.insert( vecHosts.begin() + 1, 3, "unreachable" );
+
+   CSessionLauncher slLauncher( &spSpawner );
+   slLauncher.SetConcurrency( 2 );
+   slLauncher.SetRate( 0.0 );
+
+   slLauncher.Start( vecHosts );
+   slLauncher.Run();
+
+   const std::vector<LAUNCHRESULT>& vecResults = slLauncher.GetResults();
+
+   for ( size_t iLoop = 0; iLoop < vecResults.size(); iLoop++ )
+   {
+      bool bUnreachable = (vecResults[iLoop].sHost == "unreachable");
+
+      Check( vecResults[iLoop].iState == (bUnreachable ? 
+         CSessionLauncher::LAUNCH_FAILED : CSessionLauncher::LAUNCH_WINDOW), "failures: state per host" );
+   }
+
+   // Failed spawns take no slot: hosts 0 and 1 of the list start together
+
+   Check( vecResults[4].dSpawnMs < vecResults[0].dSpawnMs + 200.0, "failures: slot not taken" );
+   Check( spSpawner.GetSpawned() == 6, "failures: failed spawns not counted" );
+
+   // Processes that exit without a window
+
+   SIMSTARTUP startup = MakeStartup( 200.0, 0.0 );
+   startup.dFailure = 1.0;
+
+   spSpawner.SetStartup( startup );
+
+   slLauncher.Start( MakeHosts(4) );
+   slLauncher.Run();
+
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_EXITED) == 4, "failures: exited" );
+   Check( slLauncher.IsFinished(), "failures: finished" );
+}
+
+static void TestTimeout()
+{
+   CSimProcessSpawner spSpawner;
+   spSpawner.SetStartup( MakeStartup(5000.0, 0.0) );
+
+   CSessionLauncher slLauncher( &spSpawner );
+   slLauncher.SetConcurrency( 3 );
+   slLauncher.SetRate( 0.0 );
+   slLauncher.SetWindowTimeout( 1000 );
+
+   double dStartMs = spSpawner.GetTime();
+
+   slLauncher.Start( MakeHosts(6) );
+   slLauncher.Run();
+
+   double dElapsedMs = spSpawner.GetTime() - dStartMs;
+
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_NO_WINDOW) == 6, "timeout: no window" );
+   Check( (dElapsedMs >= 2000.0) && (dElapsedMs < 2200.0), "timeout: two rounds of 1 s" );
+
+   // Timed out processes are released, so their late windows are not looked for
+
+   spSpawner.Wait( 10000.0 );
+
+   std::unordered_map<PROCESSID, WINDOWID> mapWindows;
+   spSpawner.FindWindows( mapWindows );
+
+   Check( mapWindows.empty(), "timeout: processes released" );
+
+   // Cancel ends the starting processes and spawns no more
+
+   slLauncher.Start( MakeHosts(10) );
+   slLauncher.Step();
+   slLauncher.Cancel();
+
+   Check( slLauncher.IsFinished(), "cancel: finished" );
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_NO_WINDOW) == 3, "cancel: starting ended" );
+   Check( slLauncher.GetCount(CSessionLauncher::LAUNCH_PENDING) == 7, "cancel: rest not spawned" );
+}
+
+int main()
+{
+   TestOrder();
+   TestConcurrency();
+   TestRate();
+   TestFailures();
+   TestTimeout();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
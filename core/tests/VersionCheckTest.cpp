@@ -0,0 +1,333 @@
+/**
+ * VersionCheckTest.cpp - PuTTYCS update check test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "VersionCheck.h"
+
+/**
+ * Runs the update check against a stand-in for the web server: a
+ * server slower than the deadline, one that ignores the abort, an
+ * error status, an oversized and a malformed version list, and lists
+ * with a newer, the same and an older version. Also the version
+ * comparison and when a check is due.
+ */
+
+static const char* VERSION_TEST_APP = "PuTTYCS";
+static const char* VERSION_TEST_CURRENT = "202305230";
+
+static const unsigned long VERSION_TEST_DEADLINE = 200;
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static double GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * Answers every fetch with sBody after dDelayMs, or fails it. An
+ * abort ends the wait unless bIgnoreAbort is set, like a request
+ * stuck where closing the session does not reach it.
+ */
+
+class CStandInFetcher : public CUpdateFetcher
+{
+public:
+
+   CStandInFetcher()
+   {
+      m_dDelayMs = 0;
+      m_bStatusOk = true;
+      m_bIgnoreAbort = false;
+      m_bAborted = false;
+   }
+
+   virtual bool Fetch( const std::string&, unsigned long, size_t iMaxSize, std::string& sDocument )
+   {
+      std::unique_lock<std::mutex> lock( m_mtxLock );
+
+      if ( m_bIgnoreAbort )
+      {
+         lock.unlock();
+         std::this_thread::sleep_for( std::chrono::duration<double, std::milli>(m_dDelayMs) );
+         lock.lock();
+      }
+      else
+      {
+         m_cvAborted.wait_for( lock, std::chrono::duration<double, std::milli>(m_dDelayMs), 
+            [this]() { return m_bAborted; } );
+
+         if ( m_bAborted )
+         {
+            return false;
+         }
+      }
+
+      if ( !m_bStatusOk || (m_sBody.size() > iMaxSize) )
+      {
+         return false;
+      }
+
+      sDocument = m_sBody;
+
+      return true;
+   }
+
+   virtual void Abort()
+   {
+      {
+         std::lock_guard<std::mutex> lock( m_mtxLock );
+         m_bAborted = true;
+      }
+
+      m_cvAborted.notify_all();
+   }
+
+   virtual void Reset()
+   {
+      std::lock_guard<std::mutex> lock( m_mtxLock );
+      m_bAborted = false;
+   }
+
+   std::string m_sBody;
+   double m_dDelayMs;
+   bool m_bStatusOk;
+   bool m_bIgnoreAbort;
+
+protected:
+
+   std::mutex m_mtxLock;
+   std::condition_variable m_cvAborted;
+   bool m_bAborted;
+};
+
+/**
+ * The outcome of one check, and how long until it reported done
+ */
+
+struct CHECKRESULT
+{
+   bool bSucceeded;
+   std::string sVersion;
+   std::string sIntVersion;
+
+   int iDone;
+   double dDoneMs;
+};
+
+static CHECKRESULT RunCheck( CStandInFetcher& sfFetcher, bool bCancel = false )
+{
+   CVersionCheck vcCheck( &sfFetcher );
+   vcCheck.SetApplication( VERSION_TEST_APP, VERSION_TEST_CURRENT );
+   vcCheck.SetMaxSize( 4096 );
+
+   CHECKRESULT result;
+   result.iDone = 0;
+   result.dDoneMs = 0;
+
+   std::mutex mtxDone;
+   std::condition_variable cvDone;
+
+   double dStart = GetMilliseconds();
+
+   vcCheck.Start( "http://localhost/software.php", VERSION_TEST_DEADLINE, 
+      [&result, &mtxDone, &cvDone, dStart]()
+      {
+         std::lock_guard<std::mutex> lock( mtxDone );
+
+         if ( result.iDone++ == 0 )
+         {
+            result.dDoneMs = GetMilliseconds() - dStart;
+         }
+
+         cvDone.notify_all();
+      } );
+
+   if ( bCancel )
+   {
+      vcCheck.Cancel();
+   }
+
+   {
+      std::unique_lock<std::mutex> lock( mtxDone );
+      cvDone.wait( lock, [&result]() { return result.iDone > 0; } );
+   }
+
+   Check( !vcCheck.IsRunning(), "not running once done" );
+
+   result.bSucceeded = vcCheck.GetResult( result.sVersion, result.sIntVersion );
+
+   vcCheck.Stop();
+
+   // A late fetch must not change what was reported
+
+   std::string sVersion;
+   std::string sIntVersion;
+
+   Check( vcCheck.GetResult(sVersion, sIntVersion) == result.bSucceeded, "result kept after Stop()" );
+   Check( result.iDone == 1, "done reported once" );
+
+   return result;
+}
+
+static std::string MakeList( const char* pszVersion, const char* pszIntVersion )
+{
+   return std::string( "<app name=\"PuTTY\" version=\"0.78\" intVersion=\"999999999\" />\n" ) +
+      "<app name=\"PuTTYCS\" version=\"" + pszVersion + "\" intVersion=\"" + pszIntVersion + "\" />\n";
+}
+
+static void TestDeadline()
+{
+   CStandInFetcher sfFetcher;
+   sfFetcher.m_sBody = MakeList( "2.0", "202401010" );
+   sfFetcher.m_dDelayMs = 3000;
+
+   CHECKRESULT result = RunCheck( sfFetcher );
+
+   Check( !result.bSucceeded, "slow server fails" );
+   Check( result.dDoneMs < VERSION_TEST_DEADLINE + 150, "slow server ends at the deadline" );
+
+   // Done at the deadline even when the fetch keeps going
+
+   sfFetcher.m_dDelayMs = 600;
+   sfFetcher.m_bIgnoreAbort = true;
+
+   result = RunCheck( sfFetcher );
+
+   Check( !result.bSucceeded, "stuck fetch fails" );
+   Check( result.dDoneMs < VERSION_TEST_DEADLINE + 150, "stuck fetch ends at the deadline" );
+
+   sfFetcher.m_dDelayMs = 50;
+   sfFetcher.m_bIgnoreAbort = false;
+
+   result = RunCheck( sfFetcher );
+
+   Check( result.bSucceeded && (result.sVersion == "2.0"), "fast server succeeds" );
+   Check( result.dDoneMs < VERSION_TEST_DEADLINE, "fast server ends before the deadline" );
+
+   sfFetcher.m_dDelayMs = 3000;
+
+   result = RunCheck( sfFetcher, true );
+
+   Check( !result.bSucceeded, "cancelled check fails" );
+   Check( result.dDoneMs < 100, "cancelled check ends at once" );
+}
+
+static void TestDocuments()
+{
+   CStandInFetcher sfFetcher;
+
+   struct DOCUMENTCASE
+   {
+      const char* pszWhat;
+      std::string sBody;
+      bool bStatusOk;
+      bool bSucceeded;
+      const char* pszVersion;
+   };
+
+   const DOCUMENTCASE aCases[] =
+   {
+      { "newer version", MakeList("2.0", "202401010"), true, true, "2.0" },
+      { "same version", MakeList("1.9", VERSION_TEST_CURRENT), true, true, "" },
+      { "older version", MakeList("1.8", "202101010"), true, true, "" },
+      { "longer version number", MakeList("10.0", "1000000000"), true, true, "10.0" },
+      { "error status", MakeList("2.0", "202401010"), false, false, "" },
+      { "oversized list", MakeList("2.0", "202401010") + std::string(5000, ' '), true, false, "" },
+      { "empty list", "", true, false, "" },
+      { "HTML error page", "<html><body>502 Bad Gateway</body></html>\n", true, false, "" },
+      { "no intVersion", "<app name=\"PuTTYCS\" version=\"2.0\" />\n", true, false, "" },
+      { "unterminated quote", "<app name=\"PuTTYCS\" intVersion=\"202401010\n", true, false, "" },
+      { "binary", std::string("\0\xff\"name=\"\x01", 10), true, false, "" }
+   };
+
+   for ( size_t iCase = 0; iCase < sizeof(aCases) / sizeof(aCases[0]); iCase++ )
+   {
+      const DOCUMENTCASE& test = aCases[iCase];
+
+      sfFetcher.m_sBody = test.sBody;
+      sfFetcher.m_bStatusOk = test.bStatusOk;
+
+      CHECKRESULT result = RunCheck( sfFetcher );
+
+      if ( (result.bSucceeded != test.bSucceeded) || (result.sVersion != test.pszVersion) )
+      {
+         printf( "%s: succeeded %d, version '%s'\n", test.pszWhat, 
+            result.bSucceeded ? 1 : 0, result.sVersion.c_str() );
+
+         g_iFailures++;
+      }
+   }
+}
+
+static void TestVersions()
+{
+   Check( CVersionCheck::CompareVersions("202305230", "202305230") == 0, "equal versions" );
+   Check( CVersionCheck::CompareVersions("202305231", "202305230") > 0, "newer version" );
+   Check( CVersionCheck::CompareVersions("202305229", "202305230") < 0, "older version" );
+   Check( CVersionCheck::CompareVersions("1000000000", "999999999") > 0, "longer number" );
+   Check( CVersionCheck::CompareVersions("0202305230", "202305230") == 0, "leading zero" );
+
+   Check( CVersionCheck::IsDue(0, 86400, 86400), "due after the interval" );
+   Check( !CVersionCheck::IsDue(1000, 1000 + 86399, 86400), "not due within the interval" );
+   Check( CVersionCheck::IsDue(2000, 1000, 86400), "due when the clock went back" );
+}
+
+int main()
+{
+   TestDeadline();
+   TestDocuments();
+   TestVersions();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * WildPatternFuzz.cpp - PuTTYCS wildcard matcher differential test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <random>
+#include <string>
+
+#include "FilterMatch.h"
+#include "WildPattern.h"
+
+/**
+ * Matches random patterns and titles with CWildPattern, and through
+ * CFilterMatch::WildCompare(), against the backtracking wildcmp they
+ * replaced. Titles and patterns mix ASCII, whole and cut UTF-8
+ * sequences and stray continuation bytes; every 7th case is a long
+ * middle segment over a long title. Usage:
+ *
+ *    puttycs_test_wildpattern [seed] [cases]
+ */
+
+static const int FUZZ_DEFAULT_CASES = 200000;
+
+static const char* BacktrackNextChar( const char* psz )
+{
+   psz++;
+
+   while ( (*psz & 0xC0) == 0x80 )
+   {
+      psz++;
+   }
+
+   return psz;
+}
+
+static bool BacktrackEqualChar( const char* psz1, const char* psz2 )
+{
+   const char* pszEnd = BacktrackNextChar( psz1 );
+
+   for ( ; psz1 < pszEnd; psz1++, psz2++ )
+   {
+      if ( *psz1 != *psz2 )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+static bool BacktrackCompare( const char* s1, const char* wild )
+{
+   const char* cp = NULL;
+   const char* mp = NULL;
+
+   while ( (*s1) && (*wild != '*') )
+   {
+      if ( (*wild != '?') && !BacktrackEqualChar(s1, wild) )
+      {
+         return false;
+      }
+
+      wild = BacktrackNextChar( wild );
+      s1 = BacktrackNextChar( s1 );
+   }
+
+   while ( *s1 )
+   {
+      if ( *wild == '*' )
+      {
+         if ( !*++wild )
+         {
+            return true;
+         }
+
+         mp = wild;
+         cp = BacktrackNextChar( s1 );
+      }
+      else if ( (*wild) && ((*wild == '?') || BacktrackEqualChar(s1, wild)) )
+      {
+         wild = BacktrackNextChar( wild );
+         s1 = BacktrackNextChar( s1 );
+      }
+      else
+      {
+         wild = mp;
+         s1 = cp;
+         cp = BacktrackNextChar( cp );
+      }
+   }
+
+   while ( *wild == '*' )
+   {
+      wild++;
+   }
+
+   return !*wild;
+}
+
+static void PrintBytes( const char* pszLabel, const std::string& sText )
+{
+   printf( " %s=", pszLabel );
+
+   for ( size_t iLoop = 0; iLoop < sText.size(); iLoop++ )
+   {
+      printf( "%02x", (unsigned char) sText[iLoop] );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   unsigned int uiSeed = (argc > 1) ? (unsigned int) strtoul( argv[1], NULL, 10 ) : 1;
+   long lCases = (argc > 2) ? strtol( argv[2], NULL, 10 ) : FUZZ_DEFAULT_CASES;
+
+   std::mt19937 rng( uiSeed );
+
+   static const char s_achPattern[] = 
+      { 'a', 'b', 'c', '*', '?', '\xC3', '\xA9', '\x80', '\xBF', '\xE2', '\x82', '\xAC', 'a', 'b' };
+   static const char s_achTitle[] = 
+      { 'a', 'b', 'c', '*', '?', '\xC3', '\xA9', '\x80', '\xE2', '\x82', '\xAC', 'a', 'b', 'a' };
+
+   CWildPattern wpPattern;
+
+   long lMatches = 0;
+
+   for ( long lCase = 0; lCase < lCases; lCase++ )
+   {
+      std::string sPattern;
+      std::string sTitle;
+
+      if ( lCase % 7 == 6 )
+      {
+         sPattern = "*";
+
+         int iLength = 60 + (int) (rng() % 80);
+
+         for ( int iLoop = 0; iLoop < iLength; iLoop++ )
+         {
+            sPattern += (rng() % 5 == 0) ? '?' : "ab"[rng() % 2];
+         }
+
+         sPattern += "*";
+
+         iLength = (int) (rng() % 400);
+
+         for ( int iLoop = 0; iLoop < iLength; iLoop++ )
+         {
+            sTitle += "ab"[rng() % 2];
+         }
+      }
+      else
+      {
+         int iPattern = (int) (rng() % 10);
+         int iTitle = (int) (rng() % ((lCase % 50 == 0) ? 200 : 14));
+
+         unsigned int uiPatternChars = (rng() % 2) ? sizeof(s_achPattern) : 5;
+         unsigned int uiTitleChars = (rng() % 2) ? sizeof(s_achTitle) : 3;
+
+         for ( int iLoop = 0; iLoop < iPattern; iLoop++ )
+         {
+            sPattern += s_achPattern[rng() % uiPatternChars];
+         }
+
+         for ( int iLoop = 0; iLoop < iTitle; iLoop++ )
+         {
+            sTitle += s_achTitle[rng() % uiTitleChars];
+         }
+      }
+
+      bool bExpected = BacktrackCompare( sTitle.c_str(), sPattern.c_str() );
+
+      wpPattern.Compile( sPattern.c_str() );
+
+      bool bPattern = wpPattern.Match( sTitle.c_str() );
+      bool bFilter = CFilterMatch::WildCompare( sTitle.c_str(), sPattern.c_str() );
+
+      if ( (bPattern != bExpected) || (bFilter != bExpected) )
+      {
+         printf( "case %ld: expected %d, CWildPattern %d, WildCompare %d", 
+            lCase, bExpected, bPattern, bFilter );
+
+         PrintBytes( "pattern", sPattern );
+         PrintBytes( "title", sTitle );
+
+         printf( "\n" );
+
+         return 1;
+      }
+
+      lMatches += bExpected ? 1 : 0;
+   }
+
+   printf( "seed %u: %ld cases, %ld matches\n", uiSeed, lCases, lMatches );
+
+   return 0;
+}
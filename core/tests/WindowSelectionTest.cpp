@@ -0,0 +1,445 @@
+/**
+ * WindowSelectionTest.cpp - PuTTYCS window selection test
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FilterMatch.h"
+#include "WindowSelection.h"
+
+/**
+ * Checks the selection bitset against a vector of bools on random
+ * sets of sizes around the word boundaries, then the window index:
+ * filters select the windows CFilterMatch matches, @name references
+ * resolve and end on cycles, host names match, slots and pins
+ * follow windows as they open and close.
+ */
+
+static int g_iFailures = 0;
+
+static void Check( bool bResult, const char* pszWhat )
+{
+   if ( !bResult )
+   {
+      printf( "%s failed\n", pszWhat );
+
+      g_iFailures++;
+   }
+}
+
+static CWindowSelection MakeSelection( const std::vector<bool>& vecBits )
+{
+   CWindowSelection selection( vecBits.size() );
+
+   for ( size_t iSlot = 0; iSlot < vecBits.size(); iSlot++ )
+   {
+      if ( vecBits[iSlot] )
+      {
+         selection.Set( iSlot );
+      }
+   }
+
+   return selection;
+}
+
+static bool IsSame( const CWindowSelection& selection, const std::vector<bool>& vecBits )
+{
+   if ( selection.GetSize() != vecBits.size() )
+   {
+      return false;
+   }
+
+   std::vector<size_t> vecExpected;
+
+   for ( size_t iSlot = 0; iSlot < vecBits.size(); iSlot++ )
+   {
+      if ( vecBits[iSlot] != selection.Test(iSlot) )
+      {
+         return false;
+      }
+
+      if ( vecBits[iSlot] )
+      {
+         vecExpected.push_back( iSlot );
+      }
+   }
+
+   std::vector<size_t> vecSlots;
+   selection.GetSlots( vecSlots );
+
+   return (vecSlots == vecExpected) && (selection.Count() == vecExpected.size()) &&
+      (selection.IsEmpty() == vecExpected.empty()) && !selection.Test( vecBits.size() );
+}
+
+static void TestAlgebra()
+{
+   static const size_t aSizes[] = { 0, 1, 63, 64, 65, 127, 128, 130, 200 };
+   static const size_t iSizes = sizeof(aSizes) / sizeof(aSizes[0]);
+
+   std::mt19937 rng( 1 );
+
+   for ( int iRound = 0; iRound < 200; iRound++ )
+   {
+      std::vector<bool> vecBits1( aSizes[rng() % iSizes] );
+      std::vector<bool> vecBits2( aSizes[rng() % iSizes] );
+
+      // Sparse, dense and half full sets
+
+      unsigned int uiDensity = 1 + rng() % 3;
+
+      for ( size_t iSlot = 0; iSlot < vecBits1.size(); iSlot++ )
+      {
+         vecBits1[iSlot] = (rng() % 4) < uiDensity;
+      }
+
+      for ( size_t iSlot = 0; iSlot < vecBits2.size(); iSlot++ )
+      {
+         vecBits2[iSlot] = (rng() % 4) < uiDensity;
+      }
+
+      size_t iSize = std::max( vecBits1.size(), vecBits2.size() );
+
+      std::vector<bool> vecUnion( iSize );
+      std::vector<bool> vecIntersection( iSize );
+      std::vector<bool> vecDifference( iSize );
+
+      for ( size_t iSlot = 0; iSlot < iSize; iSlot++ )
+      {
+         bool b1 = (iSlot < vecBits1.size()) && vecBits1[iSlot];
+         bool b2 = (iSlot < vecBits2.size()) && vecBits2[iSlot];
+
+         vecUnion[iSlot] = b1 || b2;
+         vecIntersection[iSlot] = b1 && b2;
+         vecDifference[iSlot] = b1 && !b2;
+      }
+
+      CWindowSelection wsSelection1 = MakeSelection( vecBits1 );
+      CWindowSelection wsSelection2 = MakeSelection( vecBits2 );
+
+      Check( IsSame(wsSelection1, vecBits1), "algebra: set and test" );
+
+      CWindowSelection wsResult = wsSelection1;
+      wsResult.Union( wsSelection2 );
+
+      Check( IsSame(wsResult, vecUnion), "algebra: union" );
+
+      wsResult = wsSelection1;
+      wsResult.Intersect( wsSelection2 );
+
+      Check( IsSame(wsResult, vecIntersection), "algebra: intersection" );
+
+      wsResult = wsSelection1;
+      wsResult.Subtract( wsSelection2 );
+
+      Check( IsSame(wsResult, vecDifference), "algebra: difference" );
+
+      // Shrinking drops the slots past the new size, growing adds unselected ones
+
+      size_t iNewSize = aSizes[rng() % iSizes];
+
+      std::vector<bool> vecResized( iNewSize );
+
+      for ( size_t iSlot = 0; iSlot < iNewSize; iSlot++ )
+      {
+         vecResized[iSlot] = (iSlot < vecBits1.size()) && vecBits1[iSlot];
+      }
+
+      wsResult = wsSelection1;
+      wsResult.Resize( iNewSize );
+
+      Check( IsSame(wsResult, vecResized), "algebra: resize" );
+
+      wsResult.Resize( iSize );
+      vecResized.resize( iSize, false );
+
+      Check( IsSame(wsResult, vecResized), "algebra: shrink and grow" );
+
+      if ( !vecBits1.empty() )
+      {
+         size_t iSlot = rng() % vecBits1.size();
+
+         wsSelection1.Reset( iSlot );
+         vecBits1[iSlot] = false;
+
+         Check( IsSame(wsSelection1, vecBits1), "algebra: reset" );
+      }
+   }
+
+   CWindowSelection wsSelection( 10 );
+   wsSelection.Set( 100 );
+
+   Check( (wsSelection.GetSize() == 101) && wsSelection.Test(100) && (wsSelection.Count() == 1), 
+      "algebra: set grows" );
+
+   wsSelection.Reset( 500 );
+   wsSelection.Clear();
+
+   Check( wsSelection.IsEmpty() && (wsSelection.GetSize() == 101), "algebra: clear keeps size" );
+}
+
+static WINDOWINFO MakeWindow( WINDOWID id, const char* pszTitle )
+{
+   WINDOWINFO window;
+   window.id = id;
+   window.sTitle = pszTitle;
+   window.iClass = 0;
+   window.iFlags = 0;
+
+   return window;
+}
+
+/**
+ * The ids of the windows of a selection, in slot order
+ */
+
+static std::vector<WINDOWID> GetIds( const CWindowIndex& wiIndex, const CWindowSelection& selection )
+{
+   std::vector<WINDOWINFO> vecWindows;
+   wiIndex.GetWindows( selection, vecWindows );
+
+   std::vector<WINDOWID> vecIds;
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      vecIds.push_back( vecWindows[iLoop].id );
+   }
+
+   return vecIds;
+}
+
+static void TestFilters()
+{
+   std::vector<WINDOWINFO> vecWindows;
+   vecWindows.push_back( MakeWindow(1, "root@web01: ~") );
+   vecWindows.push_back( MakeWindow(2, "admin@web02: /var/log") );
+   vecWindows.push_back( MakeWindow(3, "root@db01: ~") );
+   vecWindows.push_back( MakeWindow(4, "admin@db02: ~") );
+   vecWindows.push_back( MakeWindow(5, "cache01 - PuTTY") );
+
+   CWindowIndex wiIndex;
+   wiIndex.Update( vecWindows );
+
+   std::vector<std::string> vecFilters;
+   vecFilters.push_back( "web||+*web*" );
+   vecFilters.push_back( "db||+*db*" );
+   vecFilters.push_back( "root||+root@*" );
+   vecFilters.push_back( "servers||+@web;+@db;-@cache" );
+   vecFilters.push_back( "cycle||+@loop;+*cache*" );
+   vecFilters.push_back( "loop||+@cycle" );
+
+   wiIndex.SetFilters( vecFilters );
+
+   // Plain filters select what CFilterMatch matches, whatever the order of the items
+
+   static const char* aEntries[] =
+   {
+      "||+*", "||+*web*", "||+*;-*db*", "||+*;&root@*", "||+*web*;+*db*;&*~", 
+      "||-*web*;+*", "||&*01*;+*", "||+*;-*", "||+nothing"
+   };
+
+   for ( size_t iEntry = 0; iEntry < sizeof(aEntries) / sizeof(aEntries[0]); iEntry++ )
+   {
+      CWindowSelection selection;
+      wiIndex.Evaluate( aEntries[iEntry], selection );
+
+      std::vector<WINDOWID> vecExpected;
+
+      for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+      {
+         if ( CFilterMatch::MatchFilter(vecWindows[iLoop].sTitle, aEntries[iEntry]) )
+         {
+            vecExpected.push_back( vecWindows[iLoop].id );
+         }
+      }
+
+      if ( GetIds(wiIndex, selection) != vecExpected )
+      {
+         printf( "filter %s failed\n", aEntries[iEntry] );
+
+         g_iFailures++;
+      }
+   }
+
+   // References
+
+   CWindowSelection selection;
+
+   wiIndex.Evaluate( "||+@servers;&@root", selection );
+   Check( GetIds(wiIndex, selection) == std::vector<WINDOWID>({1, 3}), "filters: references combined" );
+
+   wiIndex.Evaluate( "||+@SERVERS", selection );
+   Check( selection.Count() == 4, "filters: reference without case" );
+
+   wiIndex.Evaluate( "||+@cycle", selection );
+   Check( GetIds(wiIndex, selection) == std::vector<WINDOWID>({5}), "filters: cycle ends" );
+
+   wiIndex.Evaluate( "||+@missing;+*db01*", selection );
+   Check( GetIds(wiIndex, selection) == std::vector<WINDOWID>({3}), "filters: unknown reference selects nothing" );
+
+   // A host name matches as well as the title
+
+   wiIndex.SetHost( 5, "cache01.example.com" );
+
+   wiIndex.Evaluate( "||+*.example.com", selection );
+   Check( GetIds(wiIndex, selection) == std::vector<WINDOWID>({5}), "filters: host name" );
+
+   wiIndex.SetHost( 5, "" );
+
+   wiIndex.Evaluate( "||+*.example.com", selection );
+   Check( selection.IsEmpty(), "filters: host name removed" );
+
+   // A new title is seen by a cached filter
+
+   vecWindows[4].sTitle = "root@cache01: ~";
+
+   Check( wiIndex.Update(vecWindows), "filters: title change" );
+
+   wiIndex.Evaluate( "||+root@*", selection );
+   Check( GetIds(wiIndex, selection) == std::vector<WINDOWID>({1, 3, 5}), "filters: cache dropped" );
+
+   Check( !wiIndex.Update(vecWindows), "filters: no change" );
+}
+
+static void TestPins()
+{
+   std::vector<WINDOWINFO> vecWindows;
+
+   for ( WINDOWID id = 1; id <= 70; id++ )
+   {
+      char szTitle[32];
+      snprintf( szTitle, sizeof(szTitle), "%s%02d", (id % 2) ? "web" : "db", (int) id );
+
+      vecWindows.push_back( MakeWindow(id, szTitle) );
+   }
+
+   CWindowIndex wiIndex;
+   wiIndex.Update( vecWindows );
+
+   CWindowSelection wsWeb;
+   wiIndex.Evaluate( "||+web*", wsWeb );
+
+   Check( wsWeb.Count() == 35, "pins: filter" );
+
+   // Pin db02 in and web01 out
+
+   CWindowSelection wsPin;
+   wiIndex.Evaluate( "||+db02", wsPin );
+   wiIndex.Pin( wsPin, CWindowIndex::PIN_ADD );
+
+   wiIndex.Evaluate( "||+web01", wsPin );
+   wiIndex.Pin( wsPin, CWindowIndex::PIN_REMOVE );
+
+   CWindowSelection selection;
+   wiIndex.Select( "||+web*", selection );
+
+   std::vector<WINDOWID> vecIds = GetIds( wiIndex, selection );
+
+   Check( (selection.Count() == 35) && (vecIds[0] == 2) && (vecIds[1] == 3), "pins: applied by Select()" );
+
+   wiIndex.Evaluate( "||+web*", selection );
+
+   Check( (selection.Count() == 35) && selection.Test(0), "pins: not applied by Evaluate()" );
+
+   // Pinning out wins over a filter naming the window itself
+
+   wiIndex.Select( "||+web01", selection );
+
+   Check( selection.Count() == 1, "pins: unpinned kept out" );
+
+   // A window pinned in then out moves from one set to the other
+
+   wiIndex.Evaluate( "||+db02", wsPin );
+   wiIndex.Pin( wsPin, CWindowIndex::PIN_REMOVE );
+
+   Check( wiIndex.GetPinned().IsEmpty() && (wiIndex.GetUnpinned().Count() == 2), "pins: moved" );
+
+   wiIndex.Pin( wsPin, CWindowIndex::PIN_RELEASE );
+
+   Check( wiIndex.GetUnpinned().Count() == 1, "pins: released" );
+
+   // Closing a window drops its pin, and its slot goes to the next new window
+
+   wiIndex.Evaluate( "||+db70", wsPin );
+   wiIndex.Pin( wsPin, CWindowIndex::PIN_ADD );
+
+   std::vector<size_t> vecSlots;
+   wsPin.GetSlots( vecSlots );
+
+   size_t iSlot = vecSlots[0];
+
+   vecWindows.pop_back();
+
+   wiIndex.Update( vecWindows );
+
+   Check( wiIndex.GetPinned().IsEmpty() && !wiIndex.GetAlive().Test(iSlot), "pins: closed window" );
+
+   vecWindows.push_back( MakeWindow(100, "web100") );
+
+   wiIndex.Update( vecWindows );
+
+   Check( wiIndex.GetAlive().Test(iSlot) && (wiIndex.GetWindow(iSlot).id == 100), "pins: slot reused" );
+
+   wiIndex.Select( "||+db*", selection );
+
+   Check( !selection.Test(iSlot), "pins: new window not pinned" );
+
+   // Slots stay put for windows that stay open
+
+   wiIndex.Evaluate( "||+web03", wsPin );
+   wsPin.GetSlots( vecSlots );
+
+   Check( (vecSlots.size() == 1) && (vecSlots[0] == 2), "pins: slot kept" );
+
+   vecWindows.erase( vecWindows.begin() );
+
+   wiIndex.Update( vecWindows );
+   wiIndex.Select( "||+web*", selection );
+
+   Check( !selection.Test(0) && selection.Test(2), "pins: slots after close" );
+   Check( wiIndex.GetUnpinned().IsEmpty(), "pins: unpinned closed" );
+}
+
+int main()
+{
+   TestAlgebra();
+   TestFilters();
+   TestPins();
+
+   printf( "%s\n", (g_iFailures == 0) ? "ok" : "FAILED" );
+
+   return (g_iFailures == 0) ? 0 : 1;
+}
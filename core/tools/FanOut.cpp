@@ -0,0 +1,567 @@
+/**
+ * FanOut.cpp - PuTTYCS pseudo-terminal fan-out driver
+ *
+ * Copyright (c) 2005 - 2008 Jason Millard (jsm174@gmail.com)
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * REVISION HISTORY:
+ *
+ * 10/19/2026: Initial version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "BroadcastEngine.h"
+#include "KeyProgramCache.h"
+#include "LogTail.h"
+#include "OutputAggregator.h"
+#include "PtySessionSystem.h"
+#include "ScriptPacer.h"
+
+/**
+ * CFanOutSystem
+ *
+ * Counts the output of each session and hands it to the aggregator
+ * and to the script pacer, if a script runs
+ */
+
+class CFanOutSystem : public CPtySessionSystem
+{
+public:
+
+   CFanOutSystem()
+   {
+      m_iOutputBytes = 0;
+      m_iExited = 0;
+
+      m_pPacer = NULL;
+   }
+
+   size_t m_iOutputBytes;
+   size_t m_iExited;
+
+   COutputAggregator m_oaAggregator;
+   CScriptPacer* m_pPacer;
+
+protected:
+
+   virtual void OnOutput( WINDOWID id, const char* pData, size_t iLength )
+   {
+      m_iOutputBytes += iLength;
+
+      m_oaAggregator.Append( id, pData, iLength );
+
+      if ( m_pPacer )
+      {
+         m_pPacer->Output( id, pData, iLength );
+      }
+   }
+
+   virtual void OnExit( WINDOWID )
+   {
+      m_iExited++;
+   }
+};
+
+static double GetMilliseconds()
+{
+   return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/**
+ * Adds a NAME=COMMAND session, the command run by /bin/sh -c
+ */
+
+static bool AddSession( CPtySessionSystem& pssSystem, const std::string& sSpec )
+{
+   size_t iEquals = sSpec.find( '=' );
+
+   if ( (iEquals == std::string::npos) || (iEquals == 0) )
+   {
+      fprintf( stderr, "puttycs_fanout: bad session '%s', expected NAME=COMMAND\n", sSpec.c_str() );
+      return false;
+   }
+
+   std::vector<std::string> vecArgv;
+   vecArgv.push_back( "/bin/sh" );
+   vecArgv.push_back( "-c" );
+   vecArgv.push_back( sSpec.substr(iEquals + 1) );
+
+   if ( !pssSystem.AddSession(sSpec.substr(0, iEquals), vecArgv) )
+   {
+      fprintf( stderr, "puttycs_fanout: cannot start '%s'\n", sSpec.c_str() );
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Adds a session for every NAME=COMMAND line of a file, skipping
+ * blank lines and # comments
+ */
+
+static bool AddSessions( CPtySessionSystem& pssSystem, const char* pszFile )
+{
+   FILE* pFile = fopen( pszFile, "r" );
+
+   if ( !pFile )
+   {
+      fprintf( stderr, "puttycs_fanout: cannot open '%s'\n", pszFile );
+      return false;
+   }
+
+   bool bResult = true;
+
+   char szLine[4096];
+
+   while ( bResult && fgets(szLine, sizeof(szLine), pFile) )
+   {
+      std::string sLine( szLine );
+
+      while ( !sLine.empty() && strchr("\r\n \t", sLine[sLine.size() - 1]) )
+      {
+         sLine.erase( sLine.size() - 1 );
+      }
+
+      if ( !sLine.empty() && (sLine[0] != '#') )
+      {
+         bResult = AddSession( pssSystem, sLine );
+      }
+   }
+
+   fclose( pFile );
+
+   return bResult;
+}
+
+/**
+ * A log file followed as one more target, for sessions that are
+ * not ours, such as PuTTY windows logging to disk
+ */
+
+struct TAILTARGET
+{
+   std::string sName;
+   std::string sPath;
+};
+
+/**
+ * Where compiled scripts are kept: $XDG_CACHE_HOME/puttycs or
+ * ~/.cache/puttycs
+ */
+
+static std::string GetCacheDirectory()
+{
+   const char* pszCache = getenv( "XDG_CACHE_HOME" );
+
+   std::string sCache;
+
+   if ( pszCache && *pszCache )
+   {
+      sCache = pszCache;
+   }
+   else
+   {
+      const char* pszHome = getenv( "HOME" );
+
+      if ( !pszHome || !*pszHome )
+      {
+         return std::string();
+      }
+
+      sCache = std::string( pszHome ) + "/.cache";
+   }
+
+   mkdir( sCache.c_str(), 0700 );
+
+   return sCache + "/puttycs";
+}
+
+/**
+ * Reads a script, one line per line sent
+ */
+
+static bool LoadScript( const char* pszFile, std::vector<std::string>& vecLines )
+{
+   FILE* pFile = fopen( pszFile, "r" );
+
+   if ( !pFile )
+   {
+      fprintf( stderr, "puttycs_fanout: cannot open '%s'\n", pszFile );
+      return false;
+   }
+
+   char szLine[65536];
+
+   while ( fgets(szLine, sizeof(szLine), pFile) )
+   {
+      std::string sLine( szLine );
+
+      while ( !sLine.empty() && strchr("\r\n", sLine[sLine.size() - 1]) )
+      {
+         sLine.erase( sLine.size() - 1 );
+      }
+
+      vecLines.push_back( sLine );
+   }
+
+   fclose( pFile );
+
+   return true;
+}
+
+static void Usage()
+{
+   fprintf( stderr, 
+      "usage: puttycs_fanout [--shells n] [--session name=command] [--sessions file]\n"
+      "                      [--tail name=logfile] [--filter expr] [--send text]...\n"
+      "                      [--settle ms] [--wait ms] [--skip-lines n] [--sample bytes]\n"
+      "                      [--groups] [--script file] [--prompt regex]\n"
+      "                      [--line-timeout ms] [--cache dir] [--no-cache]\n"
+      "                      [--inventory file]\n" );
+}
+
+int main( int argc, char* argv[] )
+{
+   CFanOutSystem fosSystem;
+   CBroadcastEngine beEngine( &fosSystem );
+
+   std::vector<std::string> vecBuffers;
+   std::vector<TAILTARGET> vecTails;
+   std::string sFilter = "*";
+
+   int iSettleMs = 200;
+   int iWaitMs = 1000;
+   int iSkipLines = -1;
+   bool bGroups = false;
+
+   std::vector<std::string> vecScript;
+   const char* pszScript = NULL;
+   bool bScript = false;
+   bool bCache = true;
+   std::string sCacheDirectory;
+   std::string sPrompt = "[$#>] ?$";
+   unsigned long ulLineTimeout = 30000;
+
+   for ( int iArg = 1; iArg < argc; iArg++ )
+   {
+      bool bValue = iArg + 1 < argc;
+
+      if ( !strcmp(argv[iArg], "--shells") && bValue )
+      {
+         int iShells = atoi( argv[++iArg] );
+
+         for ( int iLoop = 0; iLoop < iShells; iLoop++ )
+         {
+            char szName[32];
+            snprintf( szName, sizeof(szName), "shell%d", iLoop + 1 );
+
+            if ( !fosSystem.AddShell(szName) )
+            {
+               fprintf( stderr, "puttycs_fanout: cannot start %s\n", szName );
+               return 1;
+            }
+         }
+      }
+      else if ( !strcmp(argv[iArg], "--session") && bValue )
+      {
+         if ( !AddSession(fosSystem, argv[++iArg]) )
+         {
+            return 1;
+         }
+      }
+      else if ( !strcmp(argv[iArg], "--sessions") && bValue )
+      {
+         if ( !AddSessions(fosSystem, argv[++iArg]) )
+         {
+            return 1;
+         }
+      }
+      else if ( !strcmp(argv[iArg], "--filter") && bValue )
+      {
+         sFilter = argv[++iArg];
+      }
+      else if ( !strcmp(argv[iArg], "--send") && bValue )
+      {
+         vecBuffers.push_back( argv[++iArg] );
+      }
+      else if ( !strcmp(argv[iArg], "--tail") && bValue )
+      {
+         std::string sSpec = argv[++iArg];
+
+         size_t iEquals = sSpec.find( '=' );
+
+         if ( (iEquals == std::string::npos) || (iEquals == 0) )
+         {
+            fprintf( stderr, "puttycs_fanout: bad tail '%s', expected NAME=LOGFILE\n", sSpec.c_str() );
+            return 1;
+         }
+
+         TAILTARGET target;
+         target.sName = sSpec.substr( 0, iEquals );
+         target.sPath = sSpec.substr( iEquals + 1 );
+
+         vecTails.push_back( target );
+      }
+      else if ( !strcmp(argv[iArg], "--settle") && bValue )
+      {
+         iSettleMs = atoi( argv[++iArg] );
+      }
+      else if ( !strcmp(argv[iArg], "--wait") && bValue )
+      {
+         iWaitMs = atoi( argv[++iArg] );
+      }
+      else if ( !strcmp(argv[iArg], "--skip-lines") && bValue )
+      {
+         iSkipLines = atoi( argv[++iArg] );
+      }
+      else if ( !strcmp(argv[iArg], "--sample") && bValue )
+      {
+         fosSystem.m_oaAggregator.SetSampleLimit( strtoul(argv[++iArg], NULL, 10) );
+      }
+      else if ( !strcmp(argv[iArg], "--groups") )
+      {
+         bGroups = true;
+      }
+      else if ( !strcmp(argv[iArg], "--script") && bValue )
+      {
+         pszScript = argv[++iArg];
+         bScript = true;
+      }
+      else if ( !strcmp(argv[iArg], "--prompt") && bValue )
+      {
+         sPrompt = argv[++iArg];
+      }
+      else if ( !strcmp(argv[iArg], "--line-timeout") && bValue )
+      {
+         ulLineTimeout = strtoul( argv[++iArg], NULL, 10 );
+      }
+      else if ( !strcmp(argv[iArg], "--cache") && bValue )
+      {
+         sCacheDirectory = argv[++iArg];
+      }
+      else if ( !strcmp(argv[iArg], "--no-cache") )
+      {
+         bCache = false;
+      }
+      else if ( !strcmp(argv[iArg], "--inventory") && bValue )
+      {
+         beEngine.SetInventory( argv[++iArg] );
+      }
+      else
+      {
+         Usage();
+         return 2;
+      }
+   }
+
+   if ( (fosSystem.GetSessionCount() == 0) && vecTails.empty() )
+   {
+      Usage();
+      return 2;
+   }
+
+   CScriptPacer spPacer( &beEngine );
+
+   if ( !spPacer.SetPrompt(sPrompt) )
+   {
+      fprintf( stderr, "puttycs_fanout: bad prompt pattern '%s'\n", sPrompt.c_str() );
+      return 1;
+   }
+
+   spPacer.SetLineTimeout( ulLineTimeout );
+
+   // A script that ran before comes from its compiled keys, kept for
+   // its next run otherwise
+
+   CKeyProgramCache kpcCache;
+
+   if ( bScript )
+   {
+      if ( bCache && sCacheDirectory.empty() )
+      {
+         sCacheDirectory = GetCacheDirectory();
+      }
+
+      if ( bCache && kpcCache.Open(sCacheDirectory, pszScript, 
+              CKeyProgramCache::FLAG_SENDCR | CKeyProgramCache::FLAG_PARSE) )
+      {
+         vecScript = kpcCache.GetLines();
+      }
+      else if ( LoadScript(pszScript, vecScript) )
+      {
+         kpcCache.SetLines( vecScript );
+      }
+      else
+      {
+         return 1;
+      }
+   }
+
+   // Shells echo each line sent, which is not part of the output;
+   // a script's output is taken whole
+
+   if ( bScript && (iSkipLines < 0) )
+   {
+      iSkipLines = 0;
+   }
+
+   if ( iSkipLines < 0 )
+   {
+      iSkipLines = 0;
+
+      for ( size_t iBuffer = 0; iBuffer < vecBuffers.size(); iBuffer++ )
+      {
+         iSkipLines += 1 + (int) std::count( vecBuffers[iBuffer].begin(), vecBuffers[iBuffer].end(), '\n' );
+      }
+   }
+
+   // Nothing to wait for between sessions, the ptys queue the input
+
+   beEngine.SetTransition( 0 );
+   beEngine.SetPostSendDelay( 0 );
+   beEngine.SetSendCR( 1 );
+
+   // The targets are taken before the first Poll(), while none has
+   // been reaped yet, so a session that exits while settling is still
+   // one of them
+
+   std::vector<WINDOWINFO> vecWindows;
+   beEngine.FindWindows( sFilter, vecWindows );
+
+   // Let the sessions print their banners and prompts first
+
+   double dStart = GetMilliseconds();
+
+   while ( GetMilliseconds() - dStart < iSettleMs )
+   {
+      fosSystem.Poll( 10 );
+   }
+
+   COutputAggregator& oaAggregator = fosSystem.m_oaAggregator;
+
+   for ( size_t iLoop = 0; iLoop < vecWindows.size(); iLoop++ )
+   {
+      oaAggregator.Begin( vecWindows[iLoop].id, vecWindows[iLoop].sTitle, (size_t) iSkipLines );
+
+      if ( !fosSystem.IsRunning(vecWindows[iLoop].id) )
+      {
+         oaAggregator.SetExited( vecWindows[iLoop].id );
+      }
+   }
+
+   // Log targets get ids past the sessions'
+
+   std::vector<CLogTail> vecLogTails( vecTails.size() );
+
+   for ( size_t iLoop = 0; iLoop < vecTails.size(); iLoop++ )
+   {
+      if ( !vecLogTails[iLoop].Open(vecTails[iLoop].sPath) )
+      {
+         fprintf( stderr, "puttycs_fanout: cannot open '%s'\n", vecTails[iLoop].sPath.c_str() );
+         return 1;
+      }
+
+      oaAggregator.Begin( ~(WINDOWID) iLoop, vecTails[iLoop].sName );
+   }
+
+   dStart = GetMilliseconds();
+
+   int iSent = 0;
+
+   if ( bScript )
+   {
+      fosSystem.SetProgramCache( &kpcCache );
+      fosSystem.m_pPacer = &spPacer;
+
+      iSent = spPacer.Start( vecScript, sFilter, false, true );
+
+      spPacer.Run( [&fosSystem]( int iTimeoutMs )
+      {
+         fosSystem.Poll( iTimeoutMs );
+      } );
+
+      fosSystem.m_pPacer = NULL;
+      fosSystem.SetProgramCache( NULL );
+
+      if ( bCache && !kpcCache.Save() )
+      {
+         fprintf( stderr, "puttycs_fanout: cannot write '%s'\n", kpcCache.GetPath().c_str() );
+      }
+   }
+   else if ( !vecBuffers.empty() )
+   {
+      iSent = beEngine.Send( vecBuffers, sFilter, false, true );
+   }
+
+   double dSent = GetMilliseconds();
+
+   while ( GetMilliseconds() - dSent < iWaitMs )
+   {
+      fosSystem.Poll( 10 );
+
+      for ( size_t iLoop = 0; iLoop < vecLogTails.size(); iLoop++ )
+      {
+         WINDOWID id = ~(WINDOWID) iLoop;
+
+         vecLogTails[iLoop].Read( [&oaAggregator, id]( const char* pData, size_t iLength )
+         {
+            oaAggregator.Append( id, pData, iLength );
+         } );
+      }
+   }
+
+   printf( "sessions %zu, sent to %d in %.1f ms, %zu bytes of output, %zu exited\n",
+      fosSystem.GetSessionCount(), iSent, dSent - dStart, 
+      fosSystem.m_iOutputBytes, fosSystem.m_iExited );
+
+   if ( bScript )
+   {
+      printf( "script of %zu lines, %zu lines sent on timeout, %zu of %zu keys compiled\n", 
+         vecScript.size(), spPacer.GetTimeouts(), kpcCache.GetMisses(),
+         kpcCache.GetHits() + kpcCache.GetMisses() );
+   }
+
+   if ( oaAggregator.GetTargetCount() > 0 )
+   {
+      printf( "%s\n", oaAggregator.FormatSummary().c_str() );
+
+      if ( bGroups )
+      {
+         printf( "%s", oaAggregator.FormatGroups().c_str() );
+      }
+   }
+
+   return 0;
+}
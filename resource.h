@@ -3,6 +3,11 @@
 // Used by PuTTYCS.rc
 //
 #define IDM_ABOUT_PUTTYCS               0x0010
+#define IDM_EXPORT_TRACE                0x0020
+#define IDM_LAUNCH_SESSIONS             0x0030
+#define IDM_SAVE_LAYOUT                 0x0040
+#define IDM_WAIT_STATS                  0x0050
+#define IDM_RESTORE_LAYOUT              0x0100
 #define IDR_MAINFRAME                   100
 #define IDD_PUTTYCS_DIALOG              110
 #define IDD_ABOUT_DIALOG                111
@@ -42,6 +47,7 @@
 #define IDC_CTRLR_BUTTON                1028
 #define IDC_BACKSPACE_BUTTON            1030
 #define IDC_DELETE_BUTTON               1035
+#define IDC_LIVE_PUSHBUTTON             1036
 #define IDC_SAVEPASSWORD_CHECKBOX       1100
 #define IDC_AUTOARRANGE_OFF_RADIO       1101
 #define IDC_AUTOARRANGE_TILE_RADIO      1102
@@ -64,6 +70,12 @@
 #define IDC_TILEMETHOD_HORIZONTAL_RADIO 1123
 #define IDC_TILEMETHOD_CLASSIC_RADIO    1124
 #define IDC_POST_SEND_DELAY_EDIT        1125
+#define IDC_TILEMETHOD_TERMINAL_RADIO   1126
+#define IDC_TILE_CELL_WIDTH_EDIT        1127
+#define IDC_TILE_CELL_HEIGHT_EDIT       1128
+#define IDC_AUTOTUNE_CHECKBOX           1129
+#define IDC_AUTOTUNE_MIN_EDIT           1130
+#define IDC_AUTOTUNE_MAX_EDIT           1131
 #define IDC_FILTERS_LISTBOX             1200
 #define IDC_ADD_BUTTON                  1201
 #define IDC_COPY_BUTTON                 1202
@@ -79,11 +91,13 @@
 #define IDC_APPLY_BUTTON                1212
 #define IDC_FILTERNAME_EDIT             1300
 #define IDC_FILTERLIST_EDIT             1301
+#define IDC_FILTERPROMPT_EDIT           1302
 #define IDC_PASSWORD_CEDIT              1400
 #define IDC_ABOUT_TEXT_LINE1            1501
 #define IDC_ABOUT_TEXT_LINE2            1502
 #define IDC_VISITWEBSITE_BUTTON         1503
 #define IDC_ABOUT_TEXT_LINE3            1504
+#define IDC_ABOUT_STARTUP_TEXT          1505
 #define IDC_OPACITY_SLIDER              1601
 #define IDC_OPACITY2_STATIC             1602
 #define IDC_OPACITY1_STATIC             1603